@@ -6,7 +6,8 @@
     ],
     "permutations": [
         "PASS_DEPTH",
-        "MATERIAL_INSTANCE"
+        "MATERIAL_INSTANCE",
+        "VERTEX_PACKED"
     ],
     "stages": [
         {
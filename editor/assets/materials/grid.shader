@@ -4,7 +4,7 @@
     "defines": [
         "MATERIAL_MASK"
     ],
-    "permutations": [ "PASS_DEPTH" ],
+    "permutations": [ "PASS_DEPTH", "VERTEX_PACKED" ],
     "stages": [
         {
             "stage": "VertexShader",
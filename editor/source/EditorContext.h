@@ -17,6 +17,7 @@
 
 #include <gfxapi/Types.h>
 
+#include <ugine/DerivedDataCache.h>
 #include <ugine/File.h>
 #include <ugine/Memory.h>
 #include <ugine/StringUtils.h>
@@ -129,6 +130,9 @@ public:
 
     DirectoryTree& DirectorySelector() { return dirTree_; }
 
+    // Importer outputs shared with command line tools.
+    DerivedDataCache& DerivedData() { return derivedData_; }
+
     Path NewFilePath(const Path& targetPath, StringView fileName, StringView extension) {
         String file{ fileName };
         file.Append(extension);
@@ -246,6 +250,7 @@ private:
     Path editorSettingsPath_{};
 
     ResourceThumbnails resourceThumbnails_;
+    DerivedDataCache derivedData_;
     ImVec2 thumbnailSize_{ 128, 128 };
 
     ed::DragAndDrop dragAndDrop_;
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <ugine/EventEmittor.h>
 #include <ugine/Path.h>
 #include <ugine/Span.h>
 #include <ugine/String.h>
@@ -12,6 +12,7 @@
 #include <MaterialImporter.h>
 
 #include <ugine/File.h>
+#include <ugine/Log.h>
 #include <ugine/StringUtils.h>
 #include <ugine/engine/engine/Engine.h>
 #include <ugine/engine/gfx/ImGui.h>
@@ -19,6 +20,7 @@
 
 #include <glm/gtx/transform.hpp>
 
+#include <chrono>
 #include <filesystem>
 #include <future>
 #include <map>
@@ -113,9 +115,17 @@ void ImportModelWindow::ShowImportSettings() {
 
             table.EditProperty("Scale:", scale_);
 
-            //table.BeginProperty("Lod levels:");
-            //ImGui::InputInt("##lod", &settings_.lodLevels);
-            //table.EndProperty();
+            table.EditProperty("LOD levels:", settings_.lodLevels, 1u, 8u);
+            if (settings_.lodLevels > 1) {
+                table.EditProperty("LOD ratio:", settings_.lodRatio, 0.1f, 0.9f);
+                table.EditProperty("LOD max error:", settings_.lodError, 0.001f, 0.2f);
+            }
+
+            table.EditProperty("Optimize vertex cache:", settings_.optimizeVertexCache);
+            table.EditProperty("Optimize overdraw:", settings_.optimizeOverdraw);
+            table.EditProperty("Optimize vertex fetch:", settings_.optimizeVertexFetch);
+            table.EditProperty("Build meshlets:", settings_.buildMeshlets);
+            table.EditProperty("Pack vertices:", settings_.packVertices);
 
             table.EditProperty("Single mesh:", settings_.singleMesh);
 
@@ -203,6 +213,12 @@ void ImportModelWindow::ViewModel(const SerializedModel& model) {
     if (ImGui::TreeNode(" - Meshes")) {
         for (const auto& mesh : model.meshes) {
             ImGui::Text(mesh.name.c_str());
+            for (size_t i{}; i < mesh.lods.size(); ++i) {
+                ImGui::Text("   LOD %u: %u triangles (error %f)", u32(i + 1), mesh.lods[i].indexCount / 3, mesh.lods[i].error);
+            }
+            if (!mesh.meshlets.empty()) {
+                ImGui::Text("   %u meshlets", u32(mesh.meshlets.size()));
+            }
         }
         ImGui::TreePop();
     }
@@ -427,9 +443,18 @@ void ImportModelWindow::LoadMesh() {
     }
     settings_.transformation *= glm::scale(glm::vec3{ scale_ });
 
-    MeshImporter importer{ sourcePath_, settings_ };
+    const auto start{ std::chrono::high_resolution_clock::now() };
+
+    auto& cache{ context_.DerivedData() };
+    const auto hits{ cache.GetStats().hits };
+
+    MeshImporter importer{ sourcePath_, settings_, &cache };
     models_ = importer.LoadMeshes();
     animations_ = importer.LoadAnimations();
+
+    const auto ms{ std::chrono::duration<f32, std::milli>(std::chrono::high_resolution_clock::now() - start).count() };
+    UGINE_INFO("Model '{}' loaded in {:.1f} ms, {}/{} meshes cached, derived data cache hit rate {:.0f}%", sourcePath_.Data(), ms,
+        cache.GetStats().hits - hits, models_.Size(), cache.GetStats().HitRate() * 100.0f);
 }
 
 void ImportModelWindow::GenerateMesh() {
@@ -0,0 +1,74 @@
+#include "LodGenerator.h"
+
+#include <ugine/Log.h>
+
+#include <meshoptimizer.h>
+
+#include <algorithm>
+#include <format>
+
+namespace ugine::ed {
+
+void LodGenerator::Generate(SerializedModel& model) const {
+    if (settings_.levels <= 1) {
+        return;
+    }
+
+    for (auto& mesh : model.meshes) {
+        GenerateMesh(model, mesh);
+    }
+}
+
+void LodGenerator::GenerateMesh(SerializedModel& model, SerializedModel::Mesh& mesh) const {
+    mesh.lods.clear();
+
+    if (mesh.indexCount < 3) {
+        return;
+    }
+
+    // Copy, model indices grow while generating.
+    const std::vector<u32> source(model.indices.begin() + mesh.indexOffset, model.indices.begin() + mesh.indexOffset + mesh.indexCount);
+    const size_t vertexCount{ *std::max_element(source.begin(), source.end()) + size_t(1) };
+
+    UGINE_ASSERT(mesh.vertexOffset + vertexCount <= model.vertices.size());
+
+    const auto positions{ &model.vertices[mesh.vertexOffset].pos.x };
+
+    std::vector<u32> lodIndices(source.size());
+    std::string report{ std::format("{}", source.size() / 3) };
+
+    size_t previousCount{ source.size() };
+    f32 ratio{ 1.0f };
+    f32 maxError{ settings_.maxError };
+
+    for (u32 level{ 1 }; level < settings_.levels; ++level) {
+        ratio *= settings_.ratio;
+
+        const size_t targetCount{ size_t(f32(source.size()) * ratio) / 3 * 3 };
+
+        f32 error{};
+        const auto count{ meshopt_simplify(lodIndices.data(), source.data(), source.size(), positions, vertexCount, sizeof(SerializedModel::Vertex),
+            targetCount, maxError, 0, &error) };
+
+        // Error limit or topology doesn't allow further simplification, next levels would be the same.
+        if (count == 0 || f32(count) >= f32(previousCount) * 0.95f) {
+            break;
+        }
+
+        mesh.lods.push_back(SerializedModel::MeshLod{
+            .indexOffset = u32(model.indices.size()),
+            .indexCount = u32(count),
+            .error = error,
+        });
+        model.indices.insert(model.indices.end(), lodIndices.begin(), lodIndices.begin() + count);
+
+        report += std::format(" -> {}", count / 3);
+
+        previousCount = count;
+        maxError *= 2.0f;
+    }
+
+    UGINE_INFO("Mesh '{}' LOD triangles: {}", mesh.name, report);
+}
+
+} // namespace ugine::ed
@@ -1,32 +1,28 @@
 #pragma once
 
+#include <ugine/engine/gfx/asset/SerializedModel.h>
+
 namespace ugine::ed {
 
+// Generates simplified index buffers (quadric error metric) for each mesh of a model.
+// LOD indices are appended to model indices and share vertices with LOD 0.
 class LodGenerator {
 public:
-    // TODO:
-
-    // Generate lods.
-    //for (auto& mesh : result.meshes) {
-    //    std::vector<IndexType> indices(result.indices.begin() + mesh.lod[0].baseIndex, result.indices.begin() + mesh.lod[0].baseIndex + mesh.lod[0].numIndices);
-    //    MeshOptimizer optimizer{ result.vertices, indices };
-    //    float lod{ 0.5f };
-    //    for (int i = 0; i < lodLevels - 1; ++i) {
-    //        std::vector<IndexType> newIndices;
-    //        optimizer.CreateLod(lod, newIndices);
+    struct Settings {
+        u32 levels{ 1 };       // Including LOD 0.
+        f32 ratio{ 0.5f };     // Triangle ratio of each level compared to previous one.
+        f32 maxError{ 0.02f }; // Max error of LOD 1 relative to mesh extent, doubled for each next level.
+    };
 
-    //        if (newIndices.size() == mesh.lod[i].numIndices) {
-    //            break;
-    //        }
+    explicit LodGenerator(const Settings& settings)
+        : settings_{ settings } {}
 
-    //        ugine::SerializedModel::MeshLod meshLod{ static_cast<uint32_t>(result.indices.size()), static_cast<uint32_t>(newIndices.size()) };
-    //        mesh.lod.push_back(meshLod);
+    void Generate(SerializedModel& model) const;
 
-    //        std::copy(newIndices.begin(), newIndices.end(), std::back_inserter(result.indices));
+private:
+    void GenerateMesh(SerializedModel& model, SerializedModel::Mesh& mesh) const;
 
-    //        lod *= 0.5f;
-    //    }
-    //}
+    Settings settings_;
 };
 
-} // namespace ugine::ed
\ No newline at end of file
+} // namespace ugine::ed
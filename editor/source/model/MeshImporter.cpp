@@ -1,6 +1,9 @@
 ﻿#include "MeshImporter.h"
 
 #include "AssimpHelper.h"
+#include "LodGenerator.h"
+#include "MeshOptimizer.h"
+#include "MeshletBuilder.h"
 
 #include <ugine/Error.h>
 #include <ugine/Log.h>
@@ -10,19 +13,24 @@
 namespace ugine::ed {
 
 namespace {
+    // Bump when LOD generation, optimization or meshlet building changes its output, cached meshes are rebuilt.
+    constexpr u32 MESH_PROCESSING_VERSION{ 2 };
+
     inline float CalcTime(double time, const aiAnimation* anim) {
         return static_cast<float>(time / static_cast<float>(anim->mTicksPerSecond ? anim->mTicksPerSecond : 25.0f));
     }
 } // namespace
 
-MeshImporter::MeshImporter(const Path& file, const Settings& settings)
+MeshImporter::MeshImporter(const Path& file, const Settings& settings, DerivedDataCache* cache)
     : file_{ file }
-    , settings_{ settings } {
+    , settings_{ settings }
+    , cache_{ cache } {
     UGINE_TRACE("Loading mesh '{}'", file_.String());
 
     unsigned int flags{};
     flags |= aiProcess_CalcTangentSpace;
     flags |= aiProcess_Triangulate;
+    flags |= aiProcess_JoinIdenticalVertices;
     flags |= aiProcess_SortByPType;
     flags |= aiProcess_GenUVCoords;
     //flags |= aiProcess_OptimizeMeshes;
@@ -59,6 +67,20 @@ Vector<SerializedModel> MeshImporter::LoadMeshes() const {
     result.nodes.push_back({});
     result.nodes[0] = PopulateScene(result.nodes, scene_->mRootNode, glm::mat4{ 1.0f });
 
+    const LodGenerator lodGenerator{ LodGenerator::Settings{
+        .levels = settings_.lodLevels,
+        .ratio = settings_.lodRatio,
+        .maxError = settings_.lodError,
+    } };
+
+    const MeshOptimizer meshOptimizer{ MeshOptimizer::Settings{
+        .vertexCache = settings_.optimizeVertexCache,
+        .overdraw = settings_.optimizeOverdraw,
+        .vertexFetch = settings_.optimizeVertexFetch,
+    } };
+
+    const MeshletBuilder meshletBuilder{ MeshletBuilder::Settings{} };
+
     const auto dir{ file_.ParentPath() };
     if (settings_.singleMesh) {
         uint32_t numVertices{};
@@ -89,7 +111,7 @@ Vector<SerializedModel> MeshImporter::LoadMeshes() const {
             LoadMesh(dir, scene_->mMeshes[i], result, i);
         }
 
-        CalcAabb(result);
+        ProcessMesh(result, lodGenerator, meshOptimizer, meshletBuilder);
 
         resultList.PushBack(result);
     } else {
@@ -109,7 +131,7 @@ Vector<SerializedModel> MeshImporter::LoadMeshes() const {
             LoadMesh(dir, scene_->mMeshes[i], importMesh, 0);
             materialMap_.clear();
 
-            CalcAabb(importMesh);
+            ProcessMesh(importMesh, lodGenerator, meshOptimizer, meshletBuilder);
 
             resultList.PushBack(importMesh);
         }
@@ -124,6 +146,52 @@ Vector<SerializedAnimation> MeshImporter::LoadAnimations() const {
     return result;
 }
 
+void MeshImporter::ProcessMesh(
+    SerializedModel& model, const LodGenerator& lodGenerator, const MeshOptimizer& meshOptimizer, const MeshletBuilder& meshletBuilder) const {
+    model.packVertices = settings_.packVertices;
+
+    // Keyed by the raw imported geometry, so changes of the source file or of the import transformation rebuild it.
+    DerivedDataCache::Key key{};
+    if (cache_) {
+        Vector<u8> source;
+        SaveModel(model, source);
+
+        DerivedDataCache::KeyBuilder builder{ "mesh", MESH_PROCESSING_VERSION };
+        builder.AddBytes(source.ToSpan())
+            .AddValue(settings_.lodLevels)
+            .AddValue(settings_.lodRatio)
+            .AddValue(settings_.lodError)
+            .AddValue(settings_.optimizeVertexCache)
+            .AddValue(settings_.optimizeOverdraw)
+            .AddValue(settings_.optimizeVertexFetch)
+            .AddValue(settings_.buildMeshlets);
+        key = builder.Finish();
+
+        Vector<u8> cached;
+        SerializedModel processed{};
+        if (cache_->Get(key, cached) && LoadModel(cached.ToSpan(), processed)) {
+            // Materials aren't serialized, images come from the current import.
+            processed.materials = std::move(model.materials);
+            model = std::move(processed);
+            return;
+        }
+    }
+
+    lodGenerator.Generate(model);
+    meshOptimizer.Optimize(model);
+    if (settings_.buildMeshlets) {
+        meshletBuilder.Build(model);
+    }
+    CalcAabb(model);
+
+    if (cache_) {
+        Vector<u8> out;
+        if (SaveModel(model, out)) {
+            cache_->Put(key, out.ToSpan());
+        }
+    }
+}
+
 void MeshImporter::CalcAabb(SerializedModel& model) const {
     model.aabbMin = model.aabbMax = glm::vec3{};
 
@@ -4,6 +4,7 @@
 #include <ugine/engine/gfx/asset/SerializedModel.h>
 #include <ugine/engine/math/Math.h>
 
+#include <ugine/DerivedDataCache.h>
 #include <ugine/Path.h>
 #include <ugine/Vector.h>
 
@@ -20,6 +21,10 @@ class Importer;
 
 namespace ugine::ed {
 
+class LodGenerator;
+class MeshletBuilder;
+class MeshOptimizer;
+
 class MeshImporter {
 public:
     struct Settings {
@@ -27,15 +32,33 @@ public:
         bool fixPaths{ true };
         bool singleMesh{ false };
         uint32_t textureMask{ 0xffffffff };
+
+        // LOD generation, see LodGenerator.
+        uint32_t lodLevels{ 1 };
+        float lodRatio{ 0.5f };
+        float lodError{ 0.02f };
+
+        // Index/vertex reordering, see MeshOptimizer.
+        bool optimizeVertexCache{ true };
+        bool optimizeOverdraw{ false };
+        bool optimizeVertexFetch{ true };
+
+        // Clusters for cluster culling, see MeshletBuilder.
+        bool buildMeshlets{ true };
+
+        // Quantized static vertices, see SerializedModel::packVertices.
+        bool packVertices{ true };
     };
 
-    MeshImporter(const Path& file, const Settings& settings = {});
+    // Processed meshes (LODs, optimization, meshlets) are reused from cache when given.
+    MeshImporter(const Path& file, const Settings& settings = {}, DerivedDataCache* cache = nullptr);
     ~MeshImporter();
 
     Vector<SerializedModel> LoadMeshes() const;
     Vector<SerializedAnimation> LoadAnimations() const;
 
 private:
+    void ProcessMesh(SerializedModel& model, const LodGenerator& lodGenerator, const MeshOptimizer& meshOptimizer, const MeshletBuilder& meshletBuilder) const;
     void CalcAabb(SerializedModel& model) const;
     void LoadMesh(const Path& dir, const aiMesh* sourceMesh, SerializedModel& mesh, uint32_t index) const;
     void LoadAnimations(Vector<SerializedAnimation>& animations) const;
@@ -48,6 +71,7 @@ private:
 
     Path file_;
     mutable Settings settings_;
+    DerivedDataCache* cache_{};
 
     std::unique_ptr<Assimp::Importer> importer_;
     const aiScene* scene_{};
@@ -0,0 +1,142 @@
+#include "MeshOptimizer.h"
+
+#include <ugine/Log.h>
+
+#include <meshoptimizer.h>
+
+#include <algorithm>
+
+namespace ugine::ed {
+
+namespace {
+    u32 MeshVertexCount(const SerializedModel& model, const SerializedModel::Mesh& mesh) {
+        u32 maxIndex{};
+        for (u32 i{}; i < mesh.indexCount; ++i) {
+            maxIndex = std::max(maxIndex, model.indices[mesh.indexOffset + i]);
+        }
+        for (const auto& lod : mesh.lods) {
+            for (u32 i{}; i < lod.indexCount; ++i) {
+                maxIndex = std::max(maxIndex, model.indices[lod.indexOffset + i]);
+            }
+        }
+        return mesh.indexCount > 0 ? maxIndex + 1 : 0;
+    }
+
+    template <typename F> void ForEachIndexRange(SerializedModel& model, const SerializedModel::Mesh& mesh, F&& func) {
+        func(model.indices.data() + mesh.indexOffset, mesh.indexCount);
+        for (const auto& lod : mesh.lods) {
+            func(model.indices.data() + lod.indexOffset, lod.indexCount);
+        }
+    }
+
+    template <typename T> void RemapVertices(std::vector<T>& vertices, u32 offset, const std::vector<u32>& remap) {
+        std::vector<T> remapped(remap.size());
+        for (size_t i{}; i < remap.size(); ++i) {
+            remapped[remap[i]] = vertices[offset + i];
+        }
+        std::copy(remapped.begin(), remapped.end(), vertices.begin() + offset);
+    }
+} // namespace
+
+void MeshOptimizer::Optimize(SerializedModel& model) const {
+    std::vector<u32> vertexCounts;
+    vertexCounts.reserve(model.meshes.size());
+    for (const auto& mesh : model.meshes) {
+        vertexCounts.push_back(MeshVertexCount(model, mesh));
+    }
+
+    for (u32 i{}; i < model.meshes.size(); ++i) {
+        const auto& mesh{ model.meshes[i] };
+
+        // Vertices can be reordered only if no other mesh references them.
+        bool sharedVertices{};
+        for (u32 j{}; j < model.meshes.size(); ++j) {
+            const auto& other{ model.meshes[j] };
+            if (i != j && other.vertexOffset < mesh.vertexOffset + vertexCounts[i] && mesh.vertexOffset < other.vertexOffset + vertexCounts[j]) {
+                sharedVertices = true;
+                break;
+            }
+        }
+
+        const auto before{ Analyze(model, mesh) };
+
+        OptimizeMesh(model, model.meshes[i], vertexCounts[i], settings_.vertexFetch && !sharedVertices);
+
+        const auto after{ Analyze(model, mesh) };
+
+        UGINE_INFO("Mesh '{}' optimized: ACMR {:.3f} -> {:.3f}, ATVR {:.3f} -> {:.3f}, overdraw {:.3f} -> {:.3f}, overfetch {:.3f} -> {:.3f}", mesh.name,
+            before.acmr, after.acmr, before.atvr, after.atvr, before.overdraw, after.overdraw, before.overfetch, after.overfetch);
+    }
+}
+
+void MeshOptimizer::OptimizeMesh(SerializedModel& model, SerializedModel::Mesh& mesh, u32 vertexCount, bool remapVertices) const {
+    if (vertexCount == 0) {
+        return;
+    }
+
+    const auto positions{ &model.vertices[mesh.vertexOffset].pos.x };
+
+    std::vector<u32> scratch;
+
+    // Triangle order.
+    ForEachIndexRange(model, mesh, [&](u32* indices, u32 count) {
+        scratch.assign(indices, indices + count);
+
+        if (settings_.vertexCache) {
+            meshopt_optimizeVertexCache(indices, scratch.data(), count, vertexCount);
+        }
+
+        if (settings_.overdraw) {
+            scratch.assign(indices, indices + count);
+            meshopt_optimizeOverdraw(
+                indices, scratch.data(), count, positions, vertexCount, sizeof(SerializedModel::Vertex), settings_.overdrawThreshold);
+        }
+    });
+
+    if (!remapVertices) {
+        return;
+    }
+
+    // Vertex order, follows LOD 0 triangle order. Unreferenced vertices are kept at the end.
+    std::vector<u32> remap(vertexCount);
+    auto next{ u32(meshopt_optimizeVertexFetchRemap(remap.data(), model.indices.data() + mesh.indexOffset, mesh.indexCount, vertexCount)) };
+    for (auto& index : remap) {
+        if (index == ~0u) {
+            index = next++;
+        }
+    }
+
+    RemapVertices(model.vertices, mesh.vertexOffset, remap);
+    if (model.verticesSkinned.size() == model.vertices.size()) {
+        RemapVertices(model.verticesSkinned, mesh.vertexOffset, remap);
+    }
+
+    ForEachIndexRange(model, mesh, [&](u32* indices, u32 count) {
+        for (u32 i{}; i < count; ++i) {
+            indices[i] = remap[indices[i]];
+        }
+    });
+}
+
+MeshOptimizer::Stats MeshOptimizer::Analyze(const SerializedModel& model, const SerializedModel::Mesh& mesh) {
+    const auto vertexCount{ MeshVertexCount(model, mesh) };
+    if (vertexCount == 0) {
+        return {};
+    }
+
+    const auto indices{ model.indices.data() + mesh.indexOffset };
+    const auto positions{ &model.vertices[mesh.vertexOffset].pos.x };
+
+    const auto cache{ meshopt_analyzeVertexCache(indices, mesh.indexCount, vertexCount, CACHE_SIZE, 0, 0) };
+    const auto overdraw{ meshopt_analyzeOverdraw(indices, mesh.indexCount, positions, vertexCount, sizeof(SerializedModel::Vertex)) };
+    const auto fetch{ meshopt_analyzeVertexFetch(indices, mesh.indexCount, vertexCount, sizeof(SerializedModel::Vertex)) };
+
+    return Stats{
+        .acmr = cache.acmr,
+        .atvr = cache.atvr,
+        .overdraw = overdraw.overdraw,
+        .overfetch = fetch.overfetch,
+    };
+}
+
+} // namespace ugine::ed
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <ugine/engine/gfx/asset/SerializedModel.h>
+
+namespace ugine::ed {
+
+// Reorders mesh indices and vertices for GPU efficiency:
+// post-transform vertex cache (+ optional overdraw) for each LOD and vertex fetch locality for LOD 0.
+class MeshOptimizer {
+public:
+    struct Settings {
+        bool vertexCache{ true };
+        bool overdraw{ false };
+        f32 overdrawThreshold{ 1.05f }; // Max allowed ACMR degradation when optimizing for overdraw.
+        bool vertexFetch{ true };
+    };
+
+    struct Stats {
+        f32 acmr{};      // Average cache miss ratio, transformed vertices per triangle.
+        f32 atvr{};      // Average transformed vertex ratio, transformed vertices per vertex.
+        f32 overdraw{};  // Shaded pixels per covered pixel.
+        f32 overfetch{}; // Fetched bytes per vertex buffer byte.
+    };
+
+    static constexpr u32 CACHE_SIZE{ 16 };
+
+    explicit MeshOptimizer(const Settings& settings)
+        : settings_{ settings } {}
+
+    void Optimize(SerializedModel& model) const;
+
+    static Stats Analyze(const SerializedModel& model, const SerializedModel::Mesh& mesh);
+
+private:
+    void OptimizeMesh(SerializedModel& model, SerializedModel::Mesh& mesh, u32 vertexCount, bool remapVertices) const;
+
+    Settings settings_;
+};
+
+} // namespace ugine::ed
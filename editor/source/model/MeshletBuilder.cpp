@@ -0,0 +1,78 @@
+#include "MeshletBuilder.h"
+
+#include <ugine/Log.h>
+
+#include <meshoptimizer.h>
+
+#include <algorithm>
+
+namespace ugine::ed {
+
+void MeshletBuilder::Build(SerializedModel& model) const {
+    for (auto& mesh : model.meshes) {
+        BuildMesh(model, mesh);
+    }
+}
+
+void MeshletBuilder::BuildMesh(SerializedModel& model, SerializedModel::Mesh& mesh) const {
+    mesh.meshlets.clear();
+
+    if (mesh.indexCount < 3) {
+        return;
+    }
+
+    const auto indices{ model.indices.data() + mesh.indexOffset };
+    const size_t vertexCount{ *std::max_element(indices, indices + mesh.indexCount) + size_t(1) };
+
+    UGINE_ASSERT(mesh.vertexOffset + vertexCount <= model.vertices.size());
+
+    const auto positions{ &model.vertices[mesh.vertexOffset].pos.x };
+    constexpr auto stride{ sizeof(SerializedModel::Vertex) };
+
+    const auto maxMeshlets{ meshopt_buildMeshletsBound(mesh.indexCount, SerializedModel::MAX_MESHLET_VERTICES, SerializedModel::MAX_MESHLET_TRIANGLES) };
+
+    std::vector<meshopt_Meshlet> meshlets(maxMeshlets);
+    std::vector<u32> meshletVertices(maxMeshlets * SerializedModel::MAX_MESHLET_VERTICES);
+    std::vector<u8> meshletTriangles(maxMeshlets * SerializedModel::MAX_MESHLET_TRIANGLES * 3);
+
+    const auto meshletCount{ meshopt_buildMeshlets(meshlets.data(), meshletVertices.data(), meshletTriangles.data(), indices, mesh.indexCount, positions,
+        vertexCount, stride, SerializedModel::MAX_MESHLET_VERTICES, SerializedModel::MAX_MESHLET_TRIANGLES, settings_.coneWeight) };
+
+    // Rewrite LOD 0 in meshlet order.
+    std::vector<u32> reordered;
+    reordered.reserve(mesh.indexCount);
+
+    mesh.meshlets.reserve(meshletCount);
+    for (size_t i{}; i < meshletCount; ++i) {
+        const auto& meshlet{ meshlets[i] };
+        const auto vertices{ meshletVertices.data() + meshlet.vertex_offset };
+        const auto triangles{ meshletTriangles.data() + meshlet.triangle_offset };
+
+        const auto start{ reordered.size() };
+        for (u32 t{}; t < meshlet.triangle_count * 3; ++t) {
+            reordered.push_back(vertices[triangles[t]]);
+        }
+
+        // Restore post-transform cache order within the cluster.
+        meshopt_optimizeVertexCache(reordered.data() + start, reordered.data() + start, meshlet.triangle_count * 3, vertexCount);
+
+        const auto bounds{ meshopt_computeMeshletBounds(vertices, triangles, meshlet.triangle_count, positions, vertexCount, stride) };
+
+        mesh.meshlets.push_back(SerializedModel::Meshlet{
+            .indexOffset = mesh.indexOffset + u32(start),
+            .indexCount = meshlet.triangle_count * 3,
+            .center = glm::vec3{ bounds.center[0], bounds.center[1], bounds.center[2] },
+            .radius = bounds.radius,
+            .coneApex = glm::vec3{ bounds.cone_apex[0], bounds.cone_apex[1], bounds.cone_apex[2] },
+            .coneAxis = glm::vec3{ bounds.cone_axis[0], bounds.cone_axis[1], bounds.cone_axis[2] },
+            .coneCutoff = bounds.cone_cutoff,
+        });
+    }
+
+    UGINE_ASSERT(reordered.size() == mesh.indexCount);
+    std::copy(reordered.begin(), reordered.end(), model.indices.begin() + mesh.indexOffset);
+
+    UGINE_DEBUG("Mesh '{}': {} triangles in {} meshlets", mesh.name, mesh.indexCount / 3, mesh.meshlets.size());
+}
+
+} // namespace ugine::ed
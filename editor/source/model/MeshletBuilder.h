@@ -0,0 +1,26 @@
+#pragma once
+
+#include <ugine/engine/gfx/asset/SerializedModel.h>
+
+namespace ugine::ed {
+
+// Splits LOD 0 of each mesh into clusters (meshlets) with bounding spheres and normal cones used for cluster culling.
+// LOD 0 indices are reordered so each meshlet is a contiguous index range.
+class MeshletBuilder {
+public:
+    struct Settings {
+        f32 coneWeight{ 0.25f }; // Tighter normal cones (better backface culling) vs. tighter spheres, 0 - 1.
+    };
+
+    explicit MeshletBuilder(const Settings& settings)
+        : settings_{ settings } {}
+
+    void Build(SerializedModel& model) const;
+
+private:
+    void BuildMesh(SerializedModel& model, SerializedModel::Mesh& mesh) const;
+
+    Settings settings_;
+};
+
+} // namespace ugine::ed
@@ -69,7 +69,7 @@ void ModelEditorWindow::RenderBoneTree(int& id, uint32_t i) {
     ImScope::Id _id{ &id };
 
     const auto& node{ model_->Nodes()[i] };
-    const auto title{ std::format("{} {}", node.boneIndex == Model::INVALID_INDEX ? "" : ICON_FA_BONE, node.name.Data()) };
+    const auto title{ std::format("{} {}", node.boneIndex == Model::INVALID_INDEX ? "" : ICON_FA_BONE, node.id.Name().Data()) };
 
     int flags{ ImGuiTreeNodeFlags_DefaultOpen | ImGuiTreeNodeFlags_OpenOnArrow };
     if (node.children.Empty()) {
@@ -112,7 +112,7 @@ void ModelEditorWindow::RenderBoneTree(int& id, uint32_t i) {
             flags |= ImGuiTreeNodeFlags_Selected;
         }
 
-        if (ImGui::TreeNodeEx(std::format("{} {}", ICON_FA_LINK, socket.name.Data()).c_str(), flags)) {
+        if (ImGui::TreeNodeEx(std::format("{} {}", ICON_FA_LINK, socket.id.Name().Data()).c_str(), flags)) {
             ImGui::TreePop();
         }
 
@@ -203,8 +203,7 @@ void ModelEditorWindow::RenderPopups() {
 
             auto socketName{ std::format("Socket #{}", model_->Sockets().Size()) };
             model_->AddSocket(Model::Socket{
-                .name = socketName.c_str(),
-                .id = StringID{ socketName },
+                .id = StringID::Intern(socketName),
                 .boneIndex = preview_.GetSelectedBone(),
             });
         }
@@ -268,11 +267,11 @@ void ModelEditorWindow::RenderPreviewTab() {
 
     const auto selectedSocket{ model_->Sockets().FindIf([&](const auto& socket) { return socket.id == testSocketName_; }) };
 
-    const char* preview{ selectedSocket >= 0 ? model_->Sockets()[selectedSocket].name.Data() : "<none>" };
+    const char* preview{ selectedSocket >= 0 ? model_->Sockets()[selectedSocket].id.Name().Data() : "<none>" };
     if (ImGui::BeginCombo("##testsocketname", preview)) {
         for (auto& socket : model_->Sockets()) {
             bool selected{ socket.id == testSocketName_ };
-            if (ImGui::Selectable(socket.name.Data(), &selected)) {
+            if (ImGui::Selectable(socket.id.Name().Data(), &selected)) {
                 testSocketName_ = socket.id;
             }
         }
@@ -269,7 +269,7 @@ void WorldPreviewRenderer::InitBones(ResourceHandle<Model> model) {
         boneGO_.Resize(model->Bones().Size());
 
         for (size_t i{ size }; i < boneGO_.Size(); ++i) {
-            boneGO_[i] = previewWorld_->CreateObject(model->Bones()[i].name.Data());
+            boneGO_[i] = previewWorld_->CreateObject(model->Bones()[i].id.Name().Data());
             boneGO_[i].CreateComponent<MeshComponent>(context_.Assets().BoneModel);
             bonesGO_.AddChild(boneGO_[i]);
         }
@@ -10,9 +10,14 @@
 
 #include "../platform/FileDialog.h"
 
+#include <ugine/File.h>
+#include <ugine/Log.h>
+
 #include <ugine/engine/engine/Engine.h>
 #include <ugine/engine/gfx/ImGui.h>
 
+#include <chrono>
+
 namespace ugine::ed {
 
 namespace {
@@ -68,6 +73,8 @@ void ImportTextureWindow::Show() {
         ImGuiEx::ToolTipText("Needs exactly 6 textures to create cubemap.");
     }
 
+    BuildSettings();
+
     context_.DirectorySelector().SelectDirectory("Destination:", targetPath_);
     EndContent();
 
@@ -77,6 +84,7 @@ void ImportTextureWindow::Show() {
 }
 
 bool ImportTextureWindow::ImportTextures() {
+    const auto start{ std::chrono::high_resolution_clock::now() };
     bool error{};
 
     nlohmann::json meta{};
@@ -85,55 +93,132 @@ bool ImportTextureWindow::ImportTextures() {
         sources.push_back(path.Data());
     }
     meta["cubeMap"] = isCubeMap_;
+    meta["format"] = ToString(settings_.format);
+    meta["mips"] = settings_.mips;
+    meta["srgb"] = settings_.srgb;
+    meta["normalMap"] = settings_.normalMap;
 
     if (isCubeMap_) {
         const auto name{ std::format("{}_cubemap", sourcePaths_[0].Stem()) };
         auto [resource, path] = context_.CreateResource<Texture>(targetPath_, name.c_str(), sourcePaths_[0], meta);
 
-        Image cubeMap{};
-        if (!Image::FromFile(sourcePaths_[0], cubeMap)) {
-            Emit(ErrorEvent{ "Failed to load cubemap image" });
+        if (!SaveTexture(sourcePaths_.ToSpan(), path)) {
             return false;
         }
 
-        cubeMap.SetCubemap(true);
+    } else {
+        for (const auto& file : sourcePaths_) {
+            const auto name{ file.Stem() };
+            auto [resource, path] = context_.CreateResource<Texture>(targetPath_, name, file, meta);
 
-        for (int i{ 1 }; i < sourcePaths_.Size(); ++i) {
-            if (!cubeMap.AddLayerFromFile(i, sourcePaths_[i])) {
-                Emit(ErrorEvent{ "Failed to load cubemap layer" });
-                return false;
+            if (!SaveTexture(Span<const Path>{ &file, 1 }, path)) {
+                error = true;
+                continue;
             }
         }
+    }
 
-        if (!cubeMap.Save(path)) {
-            Emit(ErrorEvent{ std::format("Failed to save image: {}", path.String()).c_str() });
+    const auto ms{ std::chrono::duration<f32, std::milli>(std::chrono::high_resolution_clock::now() - start).count() };
+    UGINE_INFO("Imported {} texture file(s) in {:.1f} ms, derived data cache hit rate {:.0f}%", sourcePaths_.Size(), ms,
+        context_.DerivedData().GetStats().HitRate() * 100.0f);
+
+    if (!error) {
+        context_.Events().CloseModal(this);
+    }
+
+    return error;
+}
+
+bool ImportTextureWindow::SaveTexture(Span<const Path> sources, const Path& path) {
+    const auto start{ std::chrono::high_resolution_clock::now() };
+
+    auto& cache{ context_.DerivedData() };
+
+    auto key{ TextureCacheKey(settings_) };
+    key.AddValue(isCubeMap_);
+    for (const auto& source : sources) {
+        if (!key.AddFile(source)) {
+            Emit(ErrorEvent{ std::format("Failed to load image: {}", source.String()).c_str() });
             return false;
         }
+    }
 
+    Vector<u8> data;
+    const auto cached{ cache.Get(key.Finish(), data) };
+    if (cached) {
+        if (!WriteFileBinary(path, data)) {
+            Emit(ErrorEvent{ std::format("Failed to save image: {}", path.String()).c_str() });
+            return false;
+        }
     } else {
-        for (const auto& file : sourcePaths_) {
-            const auto name{ file.Stem() };
-            auto [resource, path] = context_.CreateResource<Texture>(targetPath_, name, file, meta);
+        Image image;
+        if (!LoadImage(sources, image)) {
+            return false;
+        }
 
-            Image image;
-            if (!Image::FromFile(file, image)) {
-                Emit(ErrorEvent{ "Failed to load image" });
-                error = true;
-                continue;
+        if (!BuildTexture(image, settings_, &context_.Engine().GetScheduler())) {
+            Emit(ErrorEvent{ std::format("Failed to build texture: {}", path.String()).c_str() });
+            return false;
+        }
+
+        if (!image.Save(path)) {
+            Emit(ErrorEvent{ std::format("Failed to save image: {}", path.String()).c_str() });
+            return false;
+        }
+
+        cache.Put(key.Finish(), ReadFileBinary(path).ToSpan());
+    }
+
+    const auto ms{ std::chrono::duration<f32, std::milli>(std::chrono::high_resolution_clock::now() - start).count() };
+    UGINE_INFO("Texture '{}' {} in {:.1f} ms ({})", path.Data(), cached ? "cached" : "built", ms, ToString(settings_.format));
+    return true;
+}
+
+bool ImportTextureWindow::LoadImage(Span<const Path> sources, Image& image) {
+    if (!Image::FromFile(sources[0], image)) {
+        Emit(ErrorEvent{ "Failed to load image" });
+        return false;
+    }
+
+    if (isCubeMap_) {
+        image.SetCubemap(true);
+
+        for (u32 i{ 1 }; i < sources.Size(); ++i) {
+            if (!image.AddLayerFromFile(i, sources[i])) {
+                Emit(ErrorEvent{ "Failed to load cubemap layer" });
+                return false;
             }
+        }
+    }
 
-            if (!image.Save(path)) {
-                Emit(ErrorEvent{ std::format("Failed to save image: {}", path.String()).c_str() });
-                continue;
+    return true;
+}
+
+void ImportTextureWindow::BuildSettings() {
+    static constexpr Image::Format FORMATS[]{ Image::Format::RGBA8, Image::Format::BC1, Image::Format::BC3, Image::Format::BC5, Image::Format::BC7 };
+
+    if (ImGui::BeginCombo("Format", ToString(settings_.format))) {
+        for (const auto format : FORMATS) {
+            if (ImGui::Selectable(ToString(format), format == settings_.format)) {
+                settings_.format = format;
             }
         }
+        ImGui::EndCombo();
     }
+    ImGuiEx::ToolTipText("BC1: opaque color, BC3: color with alpha, BC5: normal maps, BC7: high quality color.");
 
-    if (!error) {
-        context_.Events().CloseModal(this);
+    ImGui::Checkbox("Generate mips", &settings_.mips);
+
+    if (ImGui::Checkbox("Normal map", &settings_.normalMap) && settings_.normalMap) {
+        settings_.format = Image::Format::BC5;
+        settings_.srgb = false;
     }
 
-    return error;
+    {
+        ImScope::Disabled disabled{ settings_.normalMap };
+        ImGui::Checkbox("Color data (sRGB)", &settings_.srgb);
+    }
+    ImGuiEx::ToolTipText("Mips of color data are filtered in linear space.");
 }
 
 void ImportTextureWindow::CubeMapOrdering() {
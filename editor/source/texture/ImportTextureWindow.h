@@ -3,6 +3,8 @@
 #include "../EditorTool.h"
 #include "../window/Window.h"
 
+#include <ugine/TextureBuilder.h>
+
 #include <ugine/engine/core/Resource.h>
 
 namespace ugine::ed {
@@ -20,6 +22,9 @@ public:
 
 private:
     bool ImportTextures();
+    bool SaveTexture(Span<const Path> sources, const Path& path);
+    bool LoadImage(Span<const Path> sources, Image& image);
+    void BuildSettings();
     void CubeMapOrdering();
     void ReorderCubeMap();
 
@@ -28,6 +33,7 @@ private:
 
     EditorContext& context_;
     bool isCubeMap_{};
+    TextureBuildSettings settings_{ .format = Image::Format::BC7 };
     Vector<Path> sourcePaths_;
     Path targetPath_;
 };
@@ -3,6 +3,8 @@
 #include "../EditorContext.h"
 #include "../widgets/PropertyTable.h"
 
+#include <ugine/Metrics.h>
+
 #include <ugine/engine/engine/Engine.h>
 #include <ugine/engine/gfx/GraphicsScene.h>
 #include <ugine/engine/gfx/GraphicsState.h>
@@ -49,6 +51,12 @@ void StatsWidget::Render() {
             PropertyTable table{ "Memory", &context_ };
 
             table.ConstPropertyUnformatted("Frame allocations", std::format("{}", context_.Engine().GetFrameAllocations()).c_str());
+
+            const auto& stats{ context_.Engine().GetFrameStats() };
+            table.ConstPropertyUnformatted("Frame memory",
+                std::format("{:.2f} MB (peak {:.2f} MB, reserved {:.0f} MB)", stats.frameMemoryUsed / 1e6, stats.frameMemoryHighWater / 1e6,
+                    stats.frameMemoryReserved / 1e6)
+                    .c_str());
         }
 
         if (ImGui::CollapsingHeader(ICON_FA_PALETTE " Graphics", flags)) {
@@ -69,6 +77,12 @@ void StatsWidget::Render() {
 
             table.ConstPropertyUnformatted("Draw calls", std::format("{}", gfxStats.drawCalls).c_str());
             table.ConstPropertyUnformatted("Compute dispatches", std::format("{}", gfxStats.computeDispatches).c_str());
+            table.ConstPropertyUnformatted("Triangles", std::format("{}", gfxStats.triangles).c_str());
+            table.ConstPropertyUnformatted("Triangles (no LOD)", std::format("{}", gfxStats.trianglesNoLod).c_str());
+            table.ConstPropertyUnformatted(
+                "Clusters", std::format("{} / {}", gfxStats.clustersVisible, gfxStats.clustersVisible + gfxStats.clustersCulled).c_str());
+            table.ConstPropertyUnformatted("Occlusion culled",
+                std::format("{} / {} ({:.2f} ms)", gfxStats.occlusionCulled, gfxStats.occlusionTested, gfxStats.occlusionMs).c_str());
 
             drawMs(table, "Shadows", gpuStats.shadowsMS, gpuTime);
             drawMs(table, "Depth", gpuStats.depthMS, gpuTime);
@@ -79,6 +93,26 @@ void StatsWidget::Render() {
 
             table.ConstPropertyUnformatted("Frame", std::format("{:0.4f} ms", gpuTime).c_str());
         }
+
+        if (ImGui::CollapsingHeader(ICON_FA_CHART_HISTOGRAM " Metrics")) {
+            PropertyTable table{ "Metrics", &context_ };
+
+            for (const auto& metric : Metrics::Values()) {
+                switch (metric.type) {
+                case MetricType::Counter:
+                    table.ConstPropertyUnformatted(metric.name, std::format("{} (+{})", metric.value, metric.frame).c_str());
+                    break;
+                case MetricType::Gauge:
+                    table.ConstPropertyUnformatted(metric.name, std::format("{}", metric.value).c_str());
+                    break;
+                case MetricType::Histogram:
+                    table.ConstPropertyUnformatted(metric.name,
+                        std::format("{} x, mean {:.1f} {}, p50 {}, p99 {}, max {}", metric.count, metric.mean, metric.unit, metric.p50, metric.p99, metric.max)
+                            .c_str());
+                    break;
+                }
+            }
+        }
     }
 
     ImGui::End();
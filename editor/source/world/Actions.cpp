@@ -41,7 +41,7 @@ bool WorldShortcuts(EditorContext& context) {
 
 void DuplicateGO(EditorContext& context, GameObject go) {
     context.SelectGO(go.Clone());
-    context.SelectedGO().SetName(go.Name() + " Copy");
+    context.SelectedGO().SetName(std::format("{} Copy", go.Name()));
 }
 
 void AddResource(EditorContext& context, GameObject& go, const ResourceID& id, const ResourceType& type) {
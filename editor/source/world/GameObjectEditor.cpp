@@ -176,9 +176,16 @@ void GameObjectEditor::Populate(GameObject& go, const TagComponent& tag) const {
     PropertyTable table("Tag");
 
     {
-        auto name{ go.Name() };
-        if (table.EditProperty("Name", name)) {
-            go.SetName(name);
+        // Names are interned for good, so the text is kept here while edited and set once the edit is committed.
+        if (nameObject_ != go.Entity() || !nameActive_) {
+            nameObject_ = go.Entity();
+            name_ = go.Name();
+        }
+
+        table.EditProperty("Name", name_);
+        nameActive_ = ImGui::IsItemActive();
+        if (ImGui::IsItemDeactivatedAfterEdit()) {
+            go.SetName(name_);
         }
     }
 
@@ -49,6 +49,11 @@ private:
     void Populate(GameObject& go, const LightComponent& light) const;
     void Populate(GameObject& go, const AnimationControllerComponent& animator) const;
     void Populate(GameObject& go, const SkyComponent& sky) const;
+
+    // Name being edited.
+    mutable std::string name_;
+    mutable GameObjectHandle nameObject_{ GameObjectNull };
+    mutable bool nameActive_{};
 };
 
 } // namespace ugine::ed
\ No newline at end of file
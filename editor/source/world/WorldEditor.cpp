@@ -30,6 +30,7 @@ WorldEditor::WorldEditor(EditorContext& context)
     auto& file{ context_.MainMenu().Get("File") };
     file.AddAction(WORLD_RESOURCE_ICON " New world", [this] { NewWorld(); });
     file.AddAction(WORLD_RESOURCE_ICON " Save world", [this] { SaveWorld(); });
+    file.AddAction(WORLD_RESOURCE_ICON " Export world (JSON)", [this] { ExportWorld(); });
     file.AddSeparator();
 
     context_.Events().Connect<OpenProjectEvent, &WorldEditor::OnOpenProject>(this);
@@ -130,6 +131,20 @@ void WorldEditor::SaveWorld() {
     context_.Events().ShowModal(&saveWindow_);
 }
 
+void WorldEditor::ExportWorld() {
+    saveWindow_.SetSaveAction("World", [this](const Path& targetPath, StringView fileName) {
+        String name{ fileName };
+        name.Append(".json");
+        const auto path{ targetPath / StringView{ name } };
+
+        WorldSerializer serializer{};
+        serializer.Serialize(*context_.ActiveWorld(), path, WorldSerializer::Format::Json);
+        UGINE_INFO("World exported: {}", path.String());
+    });
+
+    context_.Events().ShowModal(&saveWindow_);
+}
+
 void WorldEditor::PopulateGameObject(GameObject& go, int& id) {
     if (go.Flags() & TagComponent::Flags::Editor) {
         return;
@@ -170,7 +185,7 @@ void WorldEditor::PopulateGameObject(GameObject& go, int& id) {
     ImGui::SetCursorPos(ImVec2{ pos.x + 32, pos.y });
 
     PopulateIcons(go);
-    auto open{ ImGui::TreeNodeEx(go.Name().c_str(), flags, go.Name().c_str()) };
+    auto open{ ImGui::TreeNodeEx(go.Name().data(), flags, go.Name().data()) };
     context_.DragAndDrop().BeginDrag(go, "Game object");
 
     GameObject drop;
@@ -23,6 +23,8 @@ public:
     void NewWorld();
     void OpenWorld(ResourceHandle<WorldDescriptor> handle, bool clear = true);
     void SaveWorld();
+    // Readable interchange copy, saved worlds are binary.
+    void ExportWorld();
 
 private:
     void OnOpenWorldResource(const OpenResourceEvent<WorldDescriptor>& event);
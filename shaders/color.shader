@@ -1,7 +1,7 @@
 {
   "name": "Color shader",
   "category": "material",
-  "permutations": [ "PASS_DEPTH", "MATERIAL_INSTANCE" ],
+  "permutations": [ "PASS_DEPTH", "MATERIAL_INSTANCE", "VERTEX_PACKED" ],
   "stages": [
     {
       "stage": "VertexShader",
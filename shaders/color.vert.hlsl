@@ -1,7 +1,7 @@
 #include "color.hlsli"
 
-VSOutput main(float3 position : POSITION0) {
+VSOutput main(VSInput input) {
     VSOutput vout;
-    vout.pos = mul(g_camera.viewProj, float4(position, 1.0));
+    vout.pos = mul(g_camera.viewProj, float4(vertex_position(input), 1.0));
     return vout;
 }
@@ -2,7 +2,7 @@
     "name": "Null",
     "category": "material",
     "defines": [],
-    "permutations": [ "MATERIAL_INSTANCE", "PASS_DEPTH" ],
+    "permutations": [ "MATERIAL_INSTANCE", "PASS_DEPTH", "VERTEX_PACKED" ],
     "stages": [
         {
             "stage": "VertexShader",
@@ -41,6 +41,8 @@ void material_bp_fragment(inout MaterialBpFragment material, float2 uv) {
     material.hasNormal = normalTexture > 0;
     if (normalTexture >= 0) {
         // TODO: Sampler.
-        material.normal = 2.0f * g_texture2d[normalTexture].Sample(g_sampler[0], uv).rgb - 1.0f;
+        // Z is reconstructed, BC5 normal maps store only xy.
+        const float2 xy = 2.0f * g_texture2d[normalTexture].Sample(g_sampler[0], uv).rg - 1.0f;
+        material.normal = float3(xy, sqrt(saturate(1.0f - dot(xy, xy))));
     }
 }
\ No newline at end of file
@@ -2,7 +2,7 @@
     "name": "Standard",
     "category": "material",
     "defines": [],
-    "permutations": [ "MATERIAL_MASKED", "MATERIAL_OPACITY", "MATERIAL_INSTANCE", "PASS_DEPTH" ],
+    "permutations": [ "MATERIAL_MASKED", "MATERIAL_OPACITY", "MATERIAL_INSTANCE", "PASS_DEPTH", "VERTEX_PACKED" ],
     "stages": [
         {
             "stage": "VertexShader",
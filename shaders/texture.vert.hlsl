@@ -2,7 +2,7 @@
 
 VSOutput main(VSInput input) {
     VSOutput vout;
-    vout.pos = mul(g_camera.viewProj, float4(input.position, 1.0));
-    vout.inUV = input.texcoord;
+    vout.pos = mul(g_camera.viewProj, float4(vertex_position(input), 1.0));
+    vout.inUV = vertex_uv(input);
     return vout;
 }
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <ugine/Ugine.h>
+
+#include <ugine/engine/world/Component.h>
+#include <ugine/engine/world/GameObject.h>
+
+#include <chrono>
+#include <format>
+#include <iostream>
+#include <string_view>
+
+namespace ugine::bench {
+
+// Runs func `iterations` times, returns average time in milliseconds.
+template <typename F> f64 Measure(u32 iterations, F&& func) {
+    using Clock = std::chrono::high_resolution_clock;
+
+    const auto start{ Clock::now() };
+    for (u32 i{}; i < iterations; ++i) {
+        func();
+    }
+    const auto end{ Clock::now() };
+
+    return std::chrono::duration<f64, std::milli>(end - start).count() / f64(iterations);
+}
+
+inline void Report(std::string_view name, f64 ms, std::string_view note = {}) {
+    std::cout << std::format("  {:<40} {:>10.4f} ms  {}\n", name, ms, note);
+}
+
+inline void Section(std::string_view name) {
+    std::cout << std::format("\n[{}]\n", name);
+}
+
+// Links child as last child of parent the way GameObject::AddChild does. Bench registries have no world, transformations
+// are left as set.
+inline void AttachChild(GameObjectRegistry& registry, GameObjectHandle parent, GameObjectHandle child) {
+    registry.emplace<ParentComponent>(child, parent);
+
+    auto& rel{ registry.get<RelationshipComponent>(parent) };
+    if (rel.children++ == 0) {
+        rel.firstChild = child;
+    } else {
+        registry.get<RelationshipComponent>(rel.lastChild).nextSibling = child;
+        registry.get<RelationshipComponent>(child).prevSibling = rel.lastChild;
+    }
+    rel.lastChild = child;
+}
+
+} // namespace ugine::bench
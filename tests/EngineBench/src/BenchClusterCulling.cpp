@@ -0,0 +1,193 @@
+#include "Bench.h"
+
+#include <ugine/engine/gfx/ClusterCulling.h>
+#include <ugine/engine/math/Culling.h>
+
+#include <glm/gtc/constants.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <numeric>
+#include <vector>
+
+using namespace ugine;
+
+namespace {
+
+// Synthetic city block: buildings of flat wall/roof patches, each patch is one cluster
+// (7x7 quads = 98 triangles, 64 vertices) like produced by MeshletBuilder for planar geometry.
+struct Building {
+    glm::vec3 center{};
+    f32 radius{};
+    Vector<Model::Mesh::Meshlet> meshlets;
+    u32 indexCount{};
+};
+
+constexpr u32 PATCH_INDICES{ 7 * 7 * 6 };
+constexpr f32 PATCH_SIZE{ 2.5f };
+
+void AddWall(Building& building, const glm::vec3& origin, const glm::vec3& u, const glm::vec3& v, u32 uCount, u32 vCount) {
+    const auto normal{ glm::normalize(glm::cross(u, v)) };
+    const auto radius{ glm::length(u + v) * PATCH_SIZE * 0.5f };
+
+    for (u32 y{}; y < vCount; ++y) {
+        for (u32 x{}; x < uCount; ++x) {
+            const auto center{ origin + (u * (f32(x) + 0.5f) + v * (f32(y) + 0.5f)) * PATCH_SIZE };
+
+            building.meshlets.PushBack(Model::Mesh::Meshlet{
+                .indexStart = building.indexCount,
+                .indexCount = PATCH_INDICES,
+                .center = center,
+                .radius = radius,
+                .coneApex = center,
+                .coneAxis = normal,
+                .coneCutoff = 0.0f, // Flat cluster.
+            });
+            building.indexCount += PATCH_INDICES;
+        }
+    }
+}
+
+Building MakeBuilding(const glm::vec3& position, u32 width, u32 depth, u32 floors) {
+    Building building{};
+
+    const glm::vec3 x{ 1, 0, 0 };
+    const glm::vec3 y{ 0, 1, 0 };
+    const glm::vec3 z{ 0, 0, 1 };
+
+    const auto w{ f32(width) * PATCH_SIZE };
+    const auto d{ f32(depth) * PATCH_SIZE };
+    const auto h{ f32(floors) * PATCH_SIZE };
+
+    AddWall(building, position + glm::vec3{ 0, 0, d }, x, y, width, floors); // +Z
+    AddWall(building, position + glm::vec3{ w, 0, 0 }, -x, y, width, floors); // -Z
+    AddWall(building, position + glm::vec3{ w, 0, d }, -z, y, depth, floors); // +X
+    AddWall(building, position, z, y, depth, floors); // -X
+    AddWall(building, position + glm::vec3{ 0, h, d }, x, -z, width, depth); // Roof
+
+    building.center = position + glm::vec3{ w, h, d } * 0.5f;
+    building.radius = glm::length(glm::vec3{ w, h, d }) * 0.5f;
+
+    return building;
+}
+
+struct CameraPath {
+    const char* name{};
+    std::vector<glm::mat4> views;
+    std::vector<glm::vec3> positions;
+};
+
+struct PathResult {
+    u64 meshTriangles{};
+    u64 clusterTriangles{};
+    u64 clusterTrianglesUnbounded{};
+    u64 meshDraws{};
+    u64 clusterDraws{};
+};
+
+} // namespace
+
+void BenchClusterCulling() {
+    bench::Section("Cluster culling");
+
+    // 16x16 blocks, 40 m apart, 4 - 15 floors.
+    constexpr u32 BLOCKS{ 16 };
+    constexpr f32 BLOCK_SPACING{ 40.0f };
+
+    std::vector<Building> buildings;
+    u64 totalTriangles{};
+    u64 totalClusters{};
+    for (u32 i{}; i < BLOCKS; ++i) {
+        for (u32 j{}; j < BLOCKS; ++j) {
+            const auto floors{ 4 + (i * 7 + j * 13) % 12 };
+            buildings.push_back(MakeBuilding(glm::vec3{ f32(i) * BLOCK_SPACING, 0.0f, f32(j) * BLOCK_SPACING }, 10, 10, floors));
+            totalTriangles += buildings.back().indexCount / 3;
+            totalClusters += buildings.back().meshlets.Size();
+        }
+    }
+
+    std::cout << std::format("  scene: {} buildings, {} clusters, {} triangles\n", buildings.size(), totalClusters, totalTriangles);
+
+    const auto cityCenter{ glm::vec3{ BLOCKS * BLOCK_SPACING * 0.5f, 0.0f, BLOCKS * BLOCK_SPACING * 0.5f } };
+    const auto projection{ glm::perspectiveRH_ZO(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 2000.0f) };
+
+    constexpr u32 SAMPLES{ 100 };
+
+    std::vector<CameraPath> paths(3);
+    paths[0].name = "street walk";
+    paths[1].name = "flyover";
+    paths[2].name = "orbit";
+    for (u32 s{}; s < SAMPLES; ++s) {
+        const auto t{ f32(s) / f32(SAMPLES - 1) };
+
+        // Eye height along a street between two block rows.
+        const glm::vec3 street{ 5.0f + t * BLOCK_SPACING * (BLOCKS - 1), 1.7f, BLOCK_SPACING * 3.0f - 7.5f };
+        paths[0].positions.push_back(street);
+        paths[0].views.push_back(glm::lookAtRH(street, street + glm::vec3{ 1.0f, 0.0f, 0.1f * glm::sin(t * 20.0f) }, glm::vec3{ 0, 1, 0 }));
+
+        // Diagonal flight over the roofs looking down.
+        const glm::vec3 flight{ t * BLOCKS * BLOCK_SPACING, 120.0f, t * BLOCKS * BLOCK_SPACING };
+        paths[1].positions.push_back(flight);
+        paths[1].views.push_back(glm::lookAtRH(flight, flight + glm::vec3{ 1.0f, -1.0f, 1.0f }, glm::vec3{ 0, 1, 0 }));
+
+        // Orbit around the whole city.
+        const auto angle{ t * glm::two_pi<f32>() };
+        const glm::vec3 orbit{ cityCenter + glm::vec3{ glm::cos(angle), 0.4f, glm::sin(angle) } * 500.0f };
+        paths[2].positions.push_back(orbit);
+        paths[2].views.push_back(glm::lookAtRH(orbit, cityCenter, glm::vec3{ 0, 1, 0 }));
+    }
+
+    constexpr u32 MAX_RANGES{ 8 };
+    const glm::mat4 transformation{ 1.0f };
+    Vector<IndexRange> ranges;
+
+    for (const auto& path : paths) {
+        PathResult result{};
+
+        auto run = [&](u32 maxRanges, bool collect) {
+            for (u32 s{}; s < SAMPLES; ++s) {
+                const ClusterView view{
+                    .frustum = FrustumFromMatrix(projection * path.views[s]),
+                    .position = path.positions[s],
+                    .enabled = true,
+                };
+
+                for (const auto& building : buildings) {
+                    // Whole mesh culling.
+                    if (!SphereInFrustum(view.frustum, building.center, building.radius)) {
+                        continue;
+                    }
+
+                    if (collect && maxRanges == MAX_RANGES) {
+                        result.meshTriangles += building.indexCount / 3;
+                        ++result.meshDraws;
+                    }
+
+                    CullClusters(building.meshlets.ToSpan(), transformation, view, maxRanges, ranges);
+
+                    if (collect) {
+                        const auto triangles{ std::accumulate(
+                            ranges.begin(), ranges.end(), u64{}, [](u64 sum, const IndexRange& range) { return sum + range.indexCount / 3; }) };
+
+                        if (maxRanges == MAX_RANGES) {
+                            result.clusterTriangles += triangles;
+                            result.clusterDraws += ranges.Size();
+                        } else {
+                            result.clusterTrianglesUnbounded += triangles;
+                        }
+                    }
+                }
+            }
+        };
+
+        run(MAX_RANGES, true);
+        run(0, true);
+
+        const auto ms{ bench::Measure(10, [&] { run(MAX_RANGES, false); }) / SAMPLES };
+
+        bench::Report(std::format("{} (per frame)", path.name), ms,
+            std::format("triangles {} -> {} ({:.0f}%, unbounded draws {:.0f}%), draws {} -> {}", result.meshTriangles / SAMPLES,
+                result.clusterTriangles / SAMPLES, 100.0 * result.clusterTriangles / std::max<u64>(result.meshTriangles, 1),
+                100.0 * result.clusterTrianglesUnbounded / std::max<u64>(result.meshTriangles, 1), result.meshDraws / SAMPLES,
+                result.clusterDraws / SAMPLES));
+    }
+}
@@ -0,0 +1,94 @@
+#include "Bench.h"
+
+#include <ugine/Memory.h>
+#include <ugine/Vector.h>
+
+#include <algorithm>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace ugine;
+
+namespace {
+
+constexpr u32 ALLOCATIONS_PER_THREAD{ 200'000 };
+
+// Typical frame workload: small command structs and a growing list.
+void FrameWork(IAllocator& allocator) {
+    for (u32 i{}; i < ALLOCATIONS_PER_THREAD; ++i) {
+        auto memory{ static_cast<u32*>(allocator.AlignedAlloc(16 + (i % 8) * 16, 16)) };
+        memory[0] = i;
+    }
+}
+
+void FrameWorkVector(IAllocator& allocator) {
+    Vector<u32> list{ allocator };
+    for (u32 i{}; i < ALLOCATIONS_PER_THREAD; ++i) {
+        list.PushBack(i);
+    }
+}
+
+// Runs fn(thread) on all threads, then resets allocators as at frame end.
+template <typename Fn, typename Reset> f64 RunThreads(u32 threads, Fn&& fn, Reset&& reset) {
+    return bench::Measure(5, [&] {
+        std::vector<std::thread> workers;
+        for (u32 t{}; t < threads; ++t) {
+            workers.emplace_back([&, t] { fn(t); });
+        }
+
+        for (auto& worker : workers) {
+            worker.join();
+        }
+
+        reset();
+    });
+}
+
+} // namespace
+
+void BenchFrameAllocator() {
+    bench::Section("Frame allocator");
+
+    const auto maxThreads{ std::max(1u, std::thread::hardware_concurrency()) };
+
+    for (u32 threads{ 1 }; threads <= maxThreads; threads *= 2) {
+        const size_t frameSize{ size_t(threads) * ALLOCATIONS_PER_THREAD * 160 };
+
+        // Single linear allocator shared by all threads (previous setup).
+        LinearAllocator linear{ frameSize };
+        const auto linearMs{ RunThreads(
+            threads, [&](u32) { FrameWork(linear); }, [&] { linear.Reset(); }) };
+
+        // Single arena shared by all threads.
+        ArenaAllocator sharedArena{ 1024 * 1024 };
+        const auto sharedMs{ RunThreads(
+            threads, [&](u32) { FrameWork(sharedArena); }, [&] { sharedArena.Reset(); }) };
+
+        // Arena per thread.
+        std::vector<std::unique_ptr<ArenaAllocator>> arenas;
+        for (u32 t{}; t < threads; ++t) {
+            arenas.push_back(std::make_unique<ArenaAllocator>(1024 * 1024));
+        }
+
+        const auto resetArenas = [&] {
+            for (auto& arena : arenas) {
+                arena->Reset();
+            }
+        };
+
+        const auto perThreadMs{ RunThreads(
+            threads, [&](u32 t) { FrameWork(*arenas[t]); }, resetArenas) };
+        const auto vectorMs{ RunThreads(
+            threads, [&](u32 t) { FrameWorkVector(*arenas[t]); }, resetArenas) };
+
+        const auto allocations{ f64(threads) * ALLOCATIONS_PER_THREAD };
+        bench::Report(std::format("Shared linear ({} threads)", threads), linearMs, std::format("{:.1f} Malloc/s", allocations / linearMs / 1000.0));
+        bench::Report(std::format("Shared arena ({} threads)", threads), sharedMs, std::format("{:.1f} Malloc/s", allocations / sharedMs / 1000.0));
+        bench::Report(std::format("Per-thread arena ({} threads)", threads), perThreadMs, std::format("{:.1f} Malloc/s", allocations / perThreadMs / 1000.0));
+        bench::Report(std::format("Per-thread arena vector ({} threads)", threads), vectorMs);
+
+        std::cout << std::format("  arena high water {:.1f} MB, reserved {:.1f} MB, blocks {}\n", arenas[0]->GetStats().highWater / 1e6,
+            arenas[0]->GetStats().reserved / 1e6, arenas[0]->GetStats().blocks);
+    }
+}
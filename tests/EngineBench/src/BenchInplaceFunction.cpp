@@ -0,0 +1,127 @@
+#include "Bench.h"
+
+#include <ugine/InplaceFunction.h>
+#include <ugine/Scheduler.h>
+#include <ugine/Vector.h>
+
+#include <array>
+#include <atomic>
+#include <functional>
+#include <memory>
+
+using namespace ugine;
+
+namespace {
+
+// Stand-in for gfxapi::CommandList, bench doesn't need a device.
+struct CommandList {
+    u64 draws{};
+};
+
+// Captures larger than small buffer of std::function (16 B libstdc++, 48 B MSVC).
+struct DrawParams {
+    u64 sortKey{};
+    u64 pipeline{};
+    u64 material{};
+    u64 vertexBuffer{};
+    u64 indexBuffer{};
+    u32 firstIndex{};
+    u32 indexCount{};
+    u32 vertexOffset{};
+    u32 instanceCount{ 1 };
+};
+
+constexpr u32 FRAMES{ 100 };
+constexpr u32 RENDER_WORK_COUNT{ 2000 };
+constexpr u32 TASK_COUNT{ 512 };
+
+// Same frame as RenderThread: submit queue is filled, executed and cleared.
+template <typename Work> u32 RenderFrame(Vector<Work>& queue, CommandList& cmd) {
+    const auto allocs{ IAllocator::NumAllocs() };
+
+    for (u32 i{}; i < RENDER_WORK_COUNT; ++i) {
+        const DrawParams params{ .firstIndex = i * 3, .indexCount = 3 };
+        queue.EmplaceBack([params](CommandList& list) { list.draws += params.indexCount * params.instanceCount; });
+    }
+
+    for (auto& work : queue) {
+        work(cmd);
+    }
+    queue.Clear();
+
+    return IAllocator::NumAllocs() - allocs;
+}
+
+template <typename Work> void BenchRenderWork(std::string_view name) {
+    Vector<Work> queue;
+    CommandList cmd;
+
+    u32 allocs{};
+    RenderFrame(queue, cmd); // Queue capacity.
+
+    const auto ms{ bench::Measure(FRAMES, [&] { allocs = RenderFrame(queue, cmd); }) };
+    bench::Report(name, ms, std::format("{} allocs/frame", allocs));
+}
+
+} // namespace
+
+void BenchInplaceFunction() {
+    bench::Section("Inplace function");
+
+    std::cout << std::format("  sizeof: std::function {} B, RenderWork {} B, Scheduler::StaticTask {} B, enki::TaskSet {} B\n",
+        sizeof(std::function<void(CommandList&)>), sizeof(InplaceFunction<void(CommandList&), 64>), sizeof(Scheduler::StaticTask),
+        sizeof(enki::TaskSet));
+
+    BenchRenderWork<std::function<void(CommandList&)>>("Render work std::function (2k)");
+    BenchRenderWork<InplaceFunction<void(CommandList&), 64>>("Render work InplaceFunction (2k)");
+
+    Scheduler scheduler{ 4 };
+    auto group{ std::make_unique<Scheduler::Group>() };
+    std::atomic_uint64_t sum{};
+
+    // Previous ScheduleStatic: std::function wrapped by enki::TaskSet.
+    {
+        u32 allocs{};
+        const auto ms{ bench::Measure(FRAMES, [&] {
+            const auto start{ IAllocator::NumAllocs() };
+
+            alignas(enki::TaskSet) static u8 storage[sizeof(enki::TaskSet) * TASK_COUNT];
+            auto tasks{ reinterpret_cast<enki::TaskSet*>(storage) };
+
+            for (u32 i{}; i < TASK_COUNT; ++i) {
+                const DrawParams params{ .firstIndex = i };
+                std::function<void(u32, u32, u32)> func{ [&sum, params](u32 start, u32 end, u32) { sum += params.firstIndex + end - start; } };
+
+                auto task{ new (&tasks[i]) enki::TaskSet{ 64, [func](enki::TaskSetPartition t, u32 num) { func(t.start, t.end, num); } } };
+                scheduler.Schedule(task);
+            }
+
+            for (u32 i{}; i < TASK_COUNT; ++i) {
+                scheduler.WaitFor(&tasks[i]);
+                tasks[i].~TaskSet();
+            }
+
+            allocs = IAllocator::NumAllocs() - start;
+        }) };
+        bench::Report("ScheduleStatic std::function (512)", ms, std::format("{} allocs/frame", allocs));
+    }
+
+    {
+        u32 allocs{};
+        const auto ms{ bench::Measure(FRAMES, [&] {
+            const auto start{ IAllocator::NumAllocs() };
+
+            group->Reset();
+            for (u32 i{}; i < TASK_COUNT; ++i) {
+                const DrawParams params{ .firstIndex = i };
+                scheduler.ScheduleStatic(*group, 64, [&sum, params](u32 start, u32 end, u32) { sum += params.firstIndex + end - start; });
+            }
+            scheduler.Wait(*group);
+
+            allocs = IAllocator::NumAllocs() - start;
+        }) };
+        bench::Report("ScheduleStatic InplaceFunction (512)", ms, std::format("{} allocs/frame", allocs));
+    }
+
+    std::cout << std::format("  checksum {}\n", sum.load());
+}
@@ -0,0 +1,107 @@
+#include "Bench.h"
+
+#include <ugine/IoQueue.h>
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace ugine;
+
+namespace {
+
+constexpr u32 REQUESTS{ 2000 };
+constexpr auto READ_LATENCY{ std::chrono::microseconds(200) };
+
+// Simulated device, each read blocks for fixed latency like queued SSD request.
+struct Device {
+    bool Read(const Path& path, Vector<u8>& data) {
+        std::this_thread::sleep_for(READ_LATENCY);
+        data.Resize(256);
+        return true;
+    }
+};
+
+struct Latencies {
+    using Clock = std::chrono::high_resolution_clock;
+
+    struct Request {
+        Latencies* latencies{};
+        Clock::time_point submitted{};
+        IoPriority priority{};
+    };
+
+    void Record(const Request& request) {
+        const auto ms{ std::chrono::duration<f64, std::milli>(Clock::now() - request.submitted).count() };
+
+        std::lock_guard lock{ mutex };
+        samples[u32(request.priority)].push_back(ms);
+        ++done;
+    }
+
+    std::string Summary() {
+        static constexpr const char* NAMES[]{ "critical", "normal", "background" };
+
+        std::string result;
+        for (u32 i{}; i < IoQueue::PRIORITY_COUNT; ++i) {
+            auto& s{ samples[i] };
+            std::sort(s.begin(), s.end());
+            result += std::format("{} p50 {:.1f} p99 {:.1f}  ", NAMES[i], s[s.size() / 2], s[s.size() * 99 / 100]);
+        }
+        return result;
+    }
+
+    std::mutex mutex;
+    std::vector<f64> samples[IoQueue::PRIORITY_COUNT];
+    std::atomic_uint32_t done{};
+};
+
+// Saturated burst, mostly streaming reads with few urgent ones mixed in. Latency is bucketed by intended priority
+// even when queue ignores it.
+void Run(const char* name, u32 workers, bool prioritized, const std::vector<Path>& paths, const std::vector<IoPriority>& priorities) {
+    Device device;
+    Latencies latencies;
+    std::vector<Latencies::Request> requests(paths.size());
+
+    const auto ms{ bench::Measure(1, [&] {
+        IoQueue queue{ [device = &device](const Path& path, Vector<u8>& data, Span<const u8>&) { return device->Read(path, data); }, workers };
+
+        for (size_t i{}; i < paths.size(); ++i) {
+            requests[i] = Latencies::Request{ &latencies, Latencies::Clock::now(), priorities[i] };
+
+            queue.Submit(
+                paths[i], [request = &requests[i]](IoData&, bool) { request->latencies->Record(*request); }, true,
+                prioritized ? priorities[i] : IoPriority::Normal);
+        }
+
+        while (latencies.done < paths.size()) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }) };
+
+    bench::Report(name, ms, latencies.Summary());
+}
+
+} // namespace
+
+void BenchIoQueue() {
+    bench::Section("IoQueue (latency in ms)");
+
+    std::mt19937 rng{ 42 };
+    std::vector<Path> paths;
+    std::vector<IoPriority> priorities;
+
+    for (u32 i{}; i < REQUESTS; ++i) {
+        paths.emplace_back(std::format("assets/asset{}.bin", i));
+
+        const auto roll{ rng() % 100 };
+        priorities.push_back(roll < 5 ? IoPriority::Critical : roll < 20 ? IoPriority::Normal : IoPriority::Background);
+    }
+
+    Run("FIFO, 1 worker", 1, false, paths, priorities);
+    Run("Prioritized, 1 worker", 1, true, paths, priorities);
+    Run("Prioritized, 4 workers", 4, true, paths, priorities);
+}
@@ -0,0 +1,111 @@
+#include "Bench.h"
+
+#include <ugine/Log.h>
+
+#include <spdlog/sinks/basic_file_sink.h>
+
+#include <algorithm>
+#include <chrono>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+using namespace ugine;
+
+namespace {
+
+constexpr u32 CALLS{ 50'000 };
+constexpr u32 THREADS{ 8 };
+constexpr auto LOG_FILE{ "bench_log.txt" };
+
+using Clock = std::chrono::high_resolution_clock;
+
+// Per call latency in nanoseconds.
+template <typename F> std::vector<f64> MeasureCalls(F&& log) {
+    std::vector<f64> latencies(CALLS);
+    for (u32 i{}; i < CALLS; ++i) {
+        const auto start{ Clock::now() };
+        log(i);
+        latencies[i] = std::chrono::duration<f64, std::nano>(Clock::now() - start).count();
+    }
+    return latencies;
+}
+
+void ReportLatency(std::string_view name, std::vector<f64> latencies, std::string_view note = {}) {
+    std::sort(latencies.begin(), latencies.end());
+
+    const auto average{ std::accumulate(latencies.begin(), latencies.end(), 0.0) / f64(latencies.size()) };
+    const auto percentile{ [&](f64 p) { return latencies[size_t(p * f64(latencies.size() - 1))]; } };
+
+    std::cout << std::format("  {:<40} avg {:>8.1f} ns  p50 {:>8.1f} ns  p99 {:>8.1f} ns  max {:>10.1f} ns  {}\n", name, average, percentile(0.5),
+        percentile(0.99), latencies.back(), note);
+}
+
+// All threads log at once like workers during burst of resource loads, returns milliseconds until all are done.
+template <typename F> f64 MeasureBurst(F&& log) {
+    const auto start{ Clock::now() };
+
+    std::vector<std::thread> threads;
+    for (u32 t{}; t < THREADS; ++t) {
+        threads.emplace_back([&] {
+            for (u32 i{}; i < CALLS; ++i) {
+                log(i);
+            }
+        });
+    }
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    return std::chrono::duration<f64, std::milli>(Clock::now() - start).count();
+}
+
+} // namespace
+
+void BenchLogging() {
+    bench::Section("Logging");
+
+    auto sink{ std::make_shared<spdlog::sinks::basic_file_sink_mt>(LOG_FILE, true) };
+
+    // Previous UGINE_INFO: formatting and file write on calling thread.
+    {
+        auto logger{ std::make_shared<spdlog::logger>("bench", sink) };
+
+        const auto log{ [&](u32 i) {
+            logger->info("RayCast ended in {}ms, with {} tasks and {} tested objects (mesh index = {})", f32(i) * 0.001f, THREADS, i, i % 100);
+        } };
+
+        ReportLatency("spdlog synchronous (50k)", MeasureCalls(log));
+        bench::Report("spdlog synchronous burst (8x50k)", MeasureBurst(log));
+    }
+
+    // Same file written by logger thread, sinks are replaced before first record.
+    InitLogger();
+    spdlog::default_logger()->sinks() = { sink };
+
+    const auto log{ [](u32 i) {
+        UGINE_INFO("RayCast ended in {}ms, with {} tasks and {} tested objects (mesh index = {})", f32(i) * 0.001f, THREADS, i, i % 100);
+    } };
+
+    {
+        const auto before{ GetLogStats() };
+        const auto latencies{ MeasureCalls(log) };
+        const auto flushMs{ bench::Measure(1, [] { FlushLogger(); }) };
+        const auto stats{ GetLogStats() };
+
+        ReportLatency("UGINE_INFO async (50k)", latencies, std::format("{} dropped", stats.dropped - before.dropped));
+        bench::Report("FlushLogger after 50k", flushMs);
+    }
+
+    {
+        const auto before{ GetLogStats() };
+        const auto ms{ MeasureBurst(log) };
+        FlushLogger();
+        const auto stats{ GetLogStats() };
+
+        bench::Report("UGINE_INFO async burst (8x50k)", ms, std::format("{} written, {} dropped", stats.written - before.written, stats.dropped - before.dropped));
+    }
+
+    ShutdownLogger();
+}
@@ -0,0 +1,157 @@
+#include "Bench.h"
+
+#include <ugine/engine/math/Aabb.h>
+#include <ugine/engine/math/Culling.h>
+#include <ugine/engine/math/Frustum.h>
+#include <ugine/engine/math/OcclusionBuffer.h>
+
+#include <glm/gtc/constants.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <random>
+#include <vector>
+
+using namespace ugine;
+
+namespace {
+
+// Box occluder mesh, 12 triangles.
+struct BoxMesh {
+    Vector<glm::vec3> vertices;
+    Vector<u32> indices;
+};
+
+BoxMesh MakeUnitBox() {
+    BoxMesh box{};
+    for (u32 i{}; i < 8; ++i) {
+        box.vertices.PushBack(glm::vec3{ f32(i & 1), f32((i >> 1) & 1), f32((i >> 2) & 1) });
+    }
+
+    const u32 faces[6][4]{
+        { 0, 2, 3, 1 },
+        { 4, 5, 7, 6 },
+        { 0, 1, 5, 4 },
+        { 2, 6, 7, 3 },
+        { 0, 4, 6, 2 },
+        { 1, 3, 7, 5 },
+    };
+
+    for (const auto& face : faces) {
+        for (const auto index : { face[0], face[1], face[2], face[0], face[2], face[3] }) {
+            box.indices.PushBack(index);
+        }
+    }
+
+    return box;
+}
+
+glm::mat4 BoxTransform(const AABB& aabb) {
+    return glm::scale(glm::translate(glm::mat4{ 1.0f }, aabb.Min()), aabb.Max() - aabb.Min());
+}
+
+} // namespace
+
+void BenchOcclusion() {
+    bench::Section("Occlusion culling");
+
+    // Office floor: 12x12 rooms of 8 m with 4 m high walls, doors in the middle of each wall, furniture inside.
+    constexpr u32 ROOMS{ 12 };
+    constexpr f32 ROOM_SIZE{ 8.0f };
+    constexpr f32 WALL{ 0.2f };
+    constexpr f32 HEIGHT{ 4.0f };
+    constexpr f32 DOOR{ 1.2f };
+    constexpr u32 FURNITURE_PER_ROOM{ 40 };
+
+    std::vector<AABB> walls;
+    std::vector<AABB> objects;
+
+    std::mt19937 rng{ 7 };
+    std::uniform_real_distribution<f32> dist{ 0.0f, 1.0f };
+
+    const auto halfSpan{ (ROOM_SIZE - DOOR) * 0.5f };
+    for (u32 i{}; i <= ROOMS; ++i) {
+        for (u32 j{}; j < ROOMS; ++j) {
+            const auto a{ f32(i) * ROOM_SIZE };
+            const auto b{ f32(j) * ROOM_SIZE };
+
+            // Wall along Z and along X, each split by a door.
+            walls.push_back(AABB{ glm::vec3{ a, 0, b }, glm::vec3{ a + WALL, HEIGHT, b + halfSpan } });
+            walls.push_back(AABB{ glm::vec3{ a, 0, b + halfSpan + DOOR }, glm::vec3{ a + WALL, HEIGHT, b + ROOM_SIZE } });
+            walls.push_back(AABB{ glm::vec3{ b, 0, a }, glm::vec3{ b + halfSpan, HEIGHT, a + WALL } });
+            walls.push_back(AABB{ glm::vec3{ b + halfSpan + DOOR, 0, a }, glm::vec3{ b + ROOM_SIZE, HEIGHT, a + WALL } });
+        }
+    }
+
+    for (u32 i{}; i < ROOMS; ++i) {
+        for (u32 j{}; j < ROOMS; ++j) {
+            for (u32 k{}; k < FURNITURE_PER_ROOM; ++k) {
+                const glm::vec3 position{ f32(i) * ROOM_SIZE + 0.5f + dist(rng) * (ROOM_SIZE - 2.0f), 0.0f,
+                    f32(j) * ROOM_SIZE + 0.5f + dist(rng) * (ROOM_SIZE - 2.0f) };
+                const glm::vec3 size{ 0.3f + dist(rng), 0.3f + dist(rng) * 1.5f, 0.3f + dist(rng) };
+                objects.push_back(AABB{ position, position + size });
+            }
+        }
+    }
+
+    std::cout << std::format("  scene: {} walls, {} objects\n", walls.size(), objects.size());
+
+    const auto box{ MakeUnitBox() };
+    const auto projection{ glm::perspectiveRH_ZO(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 500.0f) };
+
+    // Walk through the rooms along the doors, turning around.
+    constexpr u32 SAMPLES{ 100 };
+    std::vector<glm::mat4> views;
+    for (u32 s{}; s < SAMPLES; ++s) {
+        const auto t{ f32(s) / f32(SAMPLES - 1) };
+        const glm::vec3 eye{ ROOM_SIZE * 0.5f + t * ROOM_SIZE * (ROOMS - 1), 1.7f, ROOM_SIZE * (ROOMS / 2 + 0.5f) };
+        const auto angle{ t * 6.0f * glm::pi<f32>() };
+        views.push_back(glm::lookAtRH(eye, eye + glm::vec3{ glm::cos(angle), -0.1f, glm::sin(angle) }, glm::vec3{ 0, 1, 0 }));
+    }
+
+    for (const auto resolution : { glm::uvec2{ 128, 64 }, glm::uvec2{ 256, 128 }, glm::uvec2{ 512, 256 } }) {
+        OcclusionBuffer occlusion{ resolution.x, resolution.y };
+
+        u64 frustumVisible{};
+        u64 occlusionVisible{};
+
+        auto frame = [&](const glm::mat4& view, bool collect) {
+            const auto viewProj{ projection * view };
+            const auto frustum{ FrustumFromMatrix(viewProj) };
+
+            occlusion.Clear(viewProj);
+            for (const auto& wall : walls) {
+                const auto center{ wall.CenterPoint() };
+                if (SphereInFrustum(frustum, center, glm::length(wall.HalfSize()))) {
+                    occlusion.RasterizeTriangles(box.vertices.ToSpan(), box.indices.ToSpan(), BoxTransform(wall));
+                }
+            }
+            occlusion.BuildHiZ();
+
+            for (const auto& object : objects) {
+                if (!SphereInFrustum(frustum, object.CenterPoint(), glm::length(object.HalfSize()))) {
+                    continue;
+                }
+
+                const auto visible{ occlusion.IsVisible(object) };
+                if (collect) {
+                    ++frustumVisible;
+                    occlusionVisible += visible ? 1 : 0;
+                }
+            }
+        };
+
+        for (const auto& view : views) {
+            frame(view, true);
+        }
+
+        const auto ms{ bench::Measure(5, [&] {
+            for (const auto& view : views) {
+                frame(view, false);
+            }
+        }) / SAMPLES };
+
+        bench::Report(std::format("{}x{} (per frame)", resolution.x, resolution.y), ms,
+            std::format("frustum visible {}, occlusion visible {} ({:.1f}% culled)", frustumVisible / SAMPLES, occlusionVisible / SAMPLES,
+                100.0 * (frustumVisible - occlusionVisible) / std::max<u64>(frustumVisible, 1)));
+    }
+}
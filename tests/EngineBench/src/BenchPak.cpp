@@ -0,0 +1,120 @@
+#include "Bench.h"
+
+#include <ugine/File.h>
+#include <ugine/FileSystem.h>
+#include <ugine/Pak.h>
+
+#include <filesystem>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace ugine;
+
+namespace {
+
+constexpr u32 FILES{ 2000 };
+constexpr u32 ITERATIONS{ 5 };
+
+// Small assets like materials, scripts and shader variants, text-like so compression has something to do.
+Vector<u8> AssetData(std::mt19937& rng) {
+    static constexpr char WORDS[]{ "material shader texture albedo normal roughness metallic emissive vertex index " };
+
+    const auto size{ std::uniform_int_distribution<size_t>{ 512, 64 * 1024 }(rng) };
+    const auto shift{ rng() };
+
+    Vector<u8> data(size);
+    for (size_t i{}; i < size; ++i) {
+        data[i] = u8(WORDS[(i * 3 + shift) % (sizeof(WORDS) - 1)]);
+    }
+    return data;
+}
+
+} // namespace
+
+void BenchPak() {
+    bench::Section("Pak");
+
+    const auto root{ std::filesystem::temp_directory_path() / "ugine_bench_pak" };
+    std::filesystem::remove_all(root);
+    std::filesystem::create_directories(root / "assets");
+
+    std::mt19937 rng{ 42 };
+    std::vector<std::string> names;
+    u64 totalSize{};
+
+    {
+        PakWriter stored{ Path{ (root / "stored.pak").string() } };
+        PakWriter compressed{ Path{ (root / "compressed.pak").string() } };
+
+        for (u32 i{}; i < FILES; ++i) {
+            auto name{ std::format("dir{}/asset{}.bin", i % 16, i) };
+            const auto data{ AssetData(rng) };
+
+            std::filesystem::create_directories((root / "assets" / name).parent_path());
+            WriteFileBinary(Path{ (root / "assets" / name).string() }, data.ToSpan());
+
+            stored.Add(name, data.ToSpan(), false);
+            compressed.Add(name, data.ToSpan(), true);
+
+            totalSize += data.Size();
+            names.push_back(std::move(name));
+        }
+
+        stored.Finish();
+        compressed.Finish();
+
+        std::cout << std::format("  {} files, {:.2f} MB, compressed pak {:.2f} MB (warm file cache)\n", FILES, totalSize / 1e6,
+            std::filesystem::file_size(root / "compressed.pak") / 1e6);
+    }
+
+    std::vector<Path> paths;
+    for (const auto& name : names) {
+        paths.emplace_back(name);
+    }
+
+    u64 checksum{};
+    Vector<u8> data;
+
+    // Mount and read every file once, as startup does.
+    const auto looseMs{ bench::Measure(ITERATIONS, [&] {
+        auto fs{ FileSystem::Create(Path{ (root / "assets").string() }) };
+        for (const auto& path : paths) {
+            fs->Read(path, data);
+            checksum += data.Size();
+        }
+    }) };
+    bench::Report("Loose files read (2k)", looseMs);
+
+    const auto storedMs{ bench::Measure(ITERATIONS, [&] {
+        auto fs{ FileSystem::CreatePak(Path{ (root / "stored.pak").string() }) };
+        for (const auto& path : paths) {
+            fs->Read(path, data);
+            checksum += data.Size();
+        }
+    }) };
+    bench::Report("Pak read (2k)", storedMs, std::format("{:.2f}x", looseMs / storedMs));
+
+    const auto viewMs{ bench::Measure(ITERATIONS, [&] {
+        auto fs{ FileSystem::CreatePak(Path{ (root / "stored.pak").string() }) };
+        for (const auto& path : paths) {
+            Span<const u8> view;
+            fs->ReadView(path, view);
+            checksum += view.Size() + view[view.Size() - 1];
+        }
+    }) };
+    bench::Report("Pak zero-copy view (2k)", viewMs, std::format("{:.2f}x", looseMs / viewMs));
+
+    const auto compressedMs{ bench::Measure(ITERATIONS, [&] {
+        auto fs{ FileSystem::CreatePak(Path{ (root / "compressed.pak").string() }) };
+        for (const auto& path : paths) {
+            fs->Read(path, data);
+            checksum += data.Size();
+        }
+    }) };
+    bench::Report("Compressed pak read (2k)", compressedMs, std::format("{:.2f}x", looseMs / compressedMs));
+
+    std::cout << std::format("  checksum {}\n", checksum);
+
+    std::filesystem::remove_all(root);
+}
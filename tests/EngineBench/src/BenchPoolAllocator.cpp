@@ -0,0 +1,175 @@
+#include "Bench.h"
+
+#include <ugine/Memory.h>
+#include <ugine/String.h>
+#include <ugine/Vector.h>
+
+#include <glm/glm.hpp>
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace ugine;
+
+namespace {
+
+constexpr u32 SIZE_COUNT{ 1'000'000 };
+constexpr u32 LIVE_SET{ 16 * 1024 };
+
+// Container heavy workload, allocation sizes are recorded by CountedAllocator.
+void CaptureWorkload(IAllocator& allocator) {
+    struct Node {
+        Node* next{};
+        glm::mat4 transform{};
+    };
+
+    for (u32 frame{}; frame < 100; ++frame) {
+        Vector<u32> indices{ allocator };
+        Vector<glm::vec4> positions{ allocator };
+        for (u32 i{}; i < 1000; ++i) {
+            indices.PushBack(i);
+            positions.PushBack(glm::vec4{ f32(i) });
+        }
+
+        Vector<String> names{ allocator };
+        for (u32 i{}; i < 100; ++i) {
+            String name{ "entity_with_a_long_enough_name_", allocator };
+            name += std::to_string(i).c_str();
+            names.PushBack(std::move(name));
+        }
+
+        Node* head{};
+        for (u32 i{}; i < 200; ++i) {
+            head = allocator.AlignedNew<Node>(head);
+        }
+        while (head) {
+            auto next{ head->next };
+            allocator.AlignedFree(head);
+            head = next;
+        }
+    }
+}
+
+std::vector<u32> SampleSizes(const CountedAllocator& counted) {
+    std::vector<f64> weights(CountedAllocator::HISTOGRAM_BUCKETS);
+    for (u32 i{}; i < CountedAllocator::HISTOGRAM_BUCKETS; ++i) {
+        weights[i] = f64(counted.Histogram(i));
+    }
+
+    std::mt19937 rng{ 42 };
+    std::discrete_distribution<u32> bucket{ weights.begin(), weights.end() };
+
+    std::vector<u32> sizes(SIZE_COUNT);
+    for (auto& size : sizes) {
+        const auto b{ bucket(rng) };
+        const auto max{ 1u << b };
+        size = std::uniform_int_distribution<u32>{ max / 2 + 1, max }(rng);
+    }
+    return sizes;
+}
+
+// Random replacement in a fixed live set.
+void Churn(IAllocator& allocator, const std::vector<u32>& sizes, u32 offset) {
+    std::vector<void*> live(LIVE_SET);
+    for (u32 i{}; i < sizes.size(); ++i) {
+        auto& slot{ live[(i * 2654435761u + offset) % LIVE_SET] };
+        allocator.Free(slot);
+        slot = allocator.Alloc(sizes[i]);
+    }
+
+    for (auto ptr : live) {
+        allocator.Free(ptr);
+    }
+}
+
+void BenchAllocator(std::string_view name, IAllocator& allocator, const std::vector<u32>& sizes, u32 threads) {
+    std::vector<void*> memory(sizes.size());
+
+    const auto batchMs{ bench::Measure(3, [&] {
+        for (u32 i{}; i < sizes.size(); ++i) {
+            memory[i] = allocator.Alloc(sizes[i]);
+        }
+        for (u32 i{ u32(sizes.size()) }; i > 0; --i) {
+            allocator.Free(memory[i - 1]);
+        }
+    }) };
+    bench::Report(std::format("{} batch", name), batchMs, std::format("{:.1f} Mop/s", 2.0 * sizes.size() / batchMs / 1000.0));
+
+    const auto churnMs{ bench::Measure(3, [&] { Churn(allocator, sizes, 0); }) };
+    bench::Report(std::format("{} churn", name), churnMs, std::format("{:.1f} Mop/s", 2.0 * sizes.size() / churnMs / 1000.0));
+
+    const auto threadedMs{ bench::Measure(3, [&] {
+        std::vector<std::thread> workers;
+        for (u32 t{}; t < threads; ++t) {
+            workers.emplace_back([&, t] { Churn(allocator, sizes, t); });
+        }
+        for (auto& worker : workers) {
+            worker.join();
+        }
+    }) };
+    bench::Report(std::format("{} churn ({} threads)", name, threads), threadedMs,
+        std::format("{:.1f} Mop/s", 2.0 * threads * sizes.size() / threadedMs / 1000.0));
+
+    // Producer allocates, neighbour thread frees.
+    const auto crossMs{ bench::Measure(3, [&] {
+        std::vector<std::vector<void*>> produced(threads);
+        std::vector<std::thread> workers;
+        for (u32 t{}; t < threads; ++t) {
+            workers.emplace_back([&, t] {
+                produced[t].resize(sizes.size() / threads);
+                for (u32 i{}; i < produced[t].size(); ++i) {
+                    produced[t][i] = allocator.Alloc(sizes[i]);
+                }
+            });
+        }
+        for (auto& worker : workers) {
+            worker.join();
+        }
+
+        workers.clear();
+        for (u32 t{}; t < threads; ++t) {
+            workers.emplace_back([&, t] {
+                for (auto ptr : produced[(t + 1) % threads]) {
+                    allocator.Free(ptr);
+                }
+            });
+        }
+        for (auto& worker : workers) {
+            worker.join();
+        }
+    }) };
+    bench::Report(std::format("{} cross thread free ({} threads)", name, threads), crossMs);
+}
+
+} // namespace
+
+void BenchPoolAllocator() {
+    bench::Section("Pool allocator");
+
+    CountedAllocator counted{ IAllocator::Default() };
+    CaptureWorkload(counted);
+
+    std::cout << "  size histogram:";
+    for (u32 i{}; i < CountedAllocator::HISTOGRAM_BUCKETS; ++i) {
+        if (counted.Histogram(i) > 0) {
+            std::cout << std::format(" <={}B:{}", 1ull << i, counted.Histogram(i));
+        }
+    }
+    std::cout << "\n";
+
+    const auto sizes{ SampleSizes(counted) };
+    const auto threads{ std::clamp(std::thread::hardware_concurrency(), 2u, 16u) };
+
+    HeapAllocator heap;
+    BenchAllocator("malloc", heap, sizes, threads);
+    BenchAllocator("default", IAllocator::Default(), sizes, threads);
+
+    PoolAllocator pool{ heap };
+    BenchAllocator("pool", pool, sizes, threads);
+
+    const auto stats{ pool.GetStats() };
+    std::cout << std::format("  pool: {:.1f} MB committed, {} slabs, {} thread caches\n", stats.committed / 1e6, stats.slabs, stats.threadCaches);
+}
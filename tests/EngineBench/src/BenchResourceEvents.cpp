@@ -0,0 +1,84 @@
+#include "Bench.h"
+
+#include <ugine/EventEmittor.h>
+
+#include <ugine/engine/core/ResourceEvents.h>
+
+#include <vector>
+
+using namespace ugine;
+
+namespace {
+
+struct Counter {
+    void OnChanged(const ResourceStateChangedEvent& event) { sum += u64(event.newState); }
+
+    u64 sum{};
+};
+
+// Previous per resource dispatcher.
+struct EmittorResource : public EventEmittorMT {
+    void SetState(ResourceState state) { Emit(ResourceStateChangedEvent{ .newState = state }); }
+};
+
+} // namespace
+
+void BenchResourceEvents() {
+    bench::Section("Resource events");
+
+    constexpr u32 COUNT{ 100'000 };
+
+    std::cout << std::format("  per resource: EventEmittorMT {} B (+ heap per event type), listener list {} B, listener node {} B (pooled)\n",
+        sizeof(EventEmittorMT), sizeof(ResourceListenerList), sizeof(ResourceListenerNode));
+
+    Counter counter;
+
+    // Immediate dispatch, each resource owns a dispatcher.
+    std::vector<EmittorResource> emittors(COUNT);
+    const auto connectEmittorMs{ bench::Measure(1, [&] {
+        for (auto& emittor : emittors) {
+            emittor.Connect<ResourceStateChangedEvent, &Counter::OnChanged>(counter);
+        }
+    }) };
+    bench::Report("EventEmittorMT connect (100k)", connectEmittorMs);
+
+    const auto emitMs{ bench::Measure(10, [&] {
+        for (auto& emittor : emittors) {
+            emittor.SetState(ResourceState::Loaded);
+        }
+    }) };
+    bench::Report("EventEmittorMT emit (100k)", emitMs, std::format("{:.1f} Mevent/s", COUNT / emitMs / 1000.0));
+
+    // Central bus, batched delivery.
+    ResourceEvents events{ IAllocator::Default() };
+    std::vector<ResourceListenerList> lists(COUNT);
+    std::vector<ResourceListenerNode*> nodes(COUNT);
+
+    ResourceEvents::Callback callback;
+    callback.Connect<&Counter::OnChanged>(&counter);
+
+    const auto connectMs{ bench::Measure(1, [&] {
+        for (u32 i{}; i < COUNT; ++i) {
+            nodes[i] = events.Connect(lists[i], callback);
+        }
+    }) };
+    bench::Report("ResourceEvents connect (100k)", connectMs);
+
+    const auto dispatchMs{ bench::Measure(10, [&] {
+        for (auto& list : lists) {
+            events.Enqueue(list, ResourceStateChangedEvent{ .newState = ResourceState::Loaded });
+        }
+        events.Dispatch();
+    }) };
+    bench::Report("ResourceEvents enqueue + dispatch (100k)", dispatchMs, std::format("{:.1f} Mevent/s", COUNT / dispatchMs / 1000.0));
+
+    const auto stats{ events.GetStats() };
+    std::cout << std::format("  queued {}, delivered {}, overflowed {}, {} nodes for {} listeners\n", stats.queued, stats.delivered, stats.overflowed,
+        stats.nodes, stats.listeners);
+
+    for (auto node : nodes) {
+        events.Disconnect(node);
+    }
+
+    std::cout << std::format("  checksum {}\n", counter.sum);
+}
@@ -0,0 +1,175 @@
+#include "Bench.h"
+
+#include <ugine/engine/math/Aabb.h>
+#include <ugine/engine/math/Simd.h>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+#include <glm/gtx/transform.hpp>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace ugine;
+
+namespace {
+
+constexpr u32 COUNT{ 100'000 };
+constexpr u32 ITERATIONS{ 20 };
+
+// Previous AABB::Transform.
+AABB TransformCorners(const AABB& box, const glm::mat4& mat) {
+    const auto& min{ box.Min() };
+    const auto& max{ box.Max() };
+    glm::vec3 v[] = {
+        mat * glm::vec4(min.x, min.y, min.z, 1.0f),
+        mat * glm::vec4(min.x, min.y, max.z, 1.0f),
+        mat * glm::vec4(min.x, max.y, min.z, 1.0f),
+        mat * glm::vec4(min.x, max.y, max.z, 1.0f),
+        mat * glm::vec4(max.x, min.y, min.z, 1.0f),
+        mat * glm::vec4(max.x, min.y, max.z, 1.0f),
+        mat * glm::vec4(max.x, max.y, min.z, 1.0f),
+        mat * glm::vec4(max.x, max.y, max.z, 1.0f),
+    };
+    return AABB{ v, 8 };
+}
+
+f32 MaxError(const glm::vec3& a, const glm::vec3& b) {
+    const auto d{ glm::abs(a - b) };
+    return std::max(std::max(d.x, d.y), d.z);
+}
+
+f32 MaxError(const std::vector<AABB>& a, const std::vector<AABB>& b) {
+    f32 error{};
+    for (size_t i{}; i < a.size(); ++i) {
+        error = std::max(error, std::max(MaxError(a[i].Min(), b[i].Min()), MaxError(a[i].Max(), b[i].Max())));
+    }
+    return error;
+}
+
+f32 MaxError(const std::vector<glm::mat4>& a, const std::vector<glm::mat4>& b) {
+    f32 error{};
+    for (size_t i{}; i < a.size(); ++i) {
+        for (int c{}; c < 4; ++c) {
+            for (int r{}; r < 4; ++r) {
+                error = std::max(error, std::abs(a[i][c][r] - b[i][c][r]));
+            }
+        }
+    }
+    return error;
+}
+
+// Runs kernel at every level supported by CPU, reports speedup against the scalar glm path.
+template <typename F, typename E> void RunLevels(std::string_view name, f64 baselineMs, F&& kernel, E&& error) {
+    for (const auto level : { simd::Level::Scalar, simd::Level::SSE2, simd::Level::AVX2 }) {
+        if (level > simd::SupportedLevel()) {
+            continue;
+        }
+
+        simd::SetLevel(level);
+        const auto ms{ bench::Measure(ITERATIONS, kernel) };
+        bench::Report(std::format("{} {}", name, simd::LevelName(level)), ms, std::format("{:.2f}x, max error {:.2e}", baselineMs / ms, error()));
+    }
+
+    simd::SetLevel(simd::SupportedLevel());
+}
+
+} // namespace
+
+void BenchSimdMath() {
+    bench::Section("SIMD math");
+
+    std::cout << std::format("  supported level {}\n", simd::LevelName(simd::SupportedLevel()));
+
+    std::mt19937 rng{ 42 };
+    std::uniform_real_distribution<f32> position{ -100.0f, 100.0f };
+    std::uniform_real_distribution<f32> unit{ -1.0f, 1.0f };
+    std::uniform_real_distribution<f32> scale{ 0.1f, 4.0f };
+
+    std::vector<glm::vec3> positions(COUNT);
+    std::vector<glm::quat> rotations(COUNT);
+    std::vector<glm::vec3> scales(COUNT);
+    std::vector<glm::mat4> matrices(COUNT);
+    std::vector<AABB> boxes(COUNT);
+
+    for (u32 i{}; i < COUNT; ++i) {
+        positions[i] = glm::vec3{ position(rng), position(rng), position(rng) };
+        rotations[i] = glm::normalize(glm::quat{ unit(rng), unit(rng), unit(rng), unit(rng) });
+        scales[i] = glm::vec3{ scale(rng), scale(rng), scale(rng) };
+        matrices[i] = glm::translate(positions[i]) * glm::mat4(rotations[i]) * glm::scale(scales[i]);
+
+        const glm::vec3 center{ position(rng), position(rng), position(rng) };
+        const glm::vec3 extent{ scale(rng), scale(rng), scale(rng) };
+        boxes[i] = AABB{ center - extent, center + extent };
+    }
+
+    // AABB transformation.
+    {
+        std::vector<AABB> expected(COUNT);
+        std::vector<AABB> out(COUNT);
+
+        const auto baselineMs{ bench::Measure(ITERATIONS, [&] {
+            for (u32 i{}; i < COUNT; ++i) {
+                expected[i] = TransformCorners(boxes[i], matrices[i]);
+            }
+        }) };
+        bench::Report("AABB transform glm 8 corners (100k)", baselineMs);
+
+        RunLevels(
+            "AABB transform", baselineMs, [&] { simd::TransformAabbs(Span<const glm::mat4>{ matrices.data(), COUNT }, { boxes.data(), COUNT }, { out.data(), COUNT }); },
+            [&] { return MaxError(expected, out); });
+    }
+
+    // Matrix multiplication.
+    {
+        std::vector<glm::mat4> expected(COUNT);
+        std::vector<glm::mat4> out(COUNT);
+        const auto& parent{ matrices[0] };
+
+        const auto baselineMs{ bench::Measure(ITERATIONS, [&] {
+            for (u32 i{}; i < COUNT; ++i) {
+                expected[i] = parent * matrices[i];
+            }
+        }) };
+        bench::Report("mat4 multiply glm (100k)", baselineMs);
+
+        RunLevels(
+            "mat4 multiply", baselineMs, [&] { simd::MultiplyMatrices(parent, { matrices.data(), COUNT }, { out.data(), COUNT }); },
+            [&] { return MaxError(expected, out); });
+    }
+
+    // Inverse.
+    {
+        std::vector<glm::mat4> expected(COUNT);
+        std::vector<glm::mat4> out(COUNT);
+
+        const auto baselineMs{ bench::Measure(ITERATIONS, [&] {
+            for (u32 i{}; i < COUNT; ++i) {
+                expected[i] = glm::inverse(matrices[i]);
+            }
+        }) };
+        bench::Report("mat4 inverse glm (100k)", baselineMs);
+
+        RunLevels(
+            "Affine inverse", baselineMs, [&] { simd::InverseAffine({ matrices.data(), COUNT }, { out.data(), COUNT }); },
+            [&] { return MaxError(expected, out); });
+    }
+
+    // Bone composition.
+    {
+        std::vector<glm::mat4> out(COUNT);
+
+        const auto baselineMs{ bench::Measure(ITERATIONS, [&] {
+            for (u32 i{}; i < COUNT; ++i) {
+                out[i] = glm::translate(positions[i]) * glm::mat4(rotations[i]) * glm::scale(scales[i]);
+            }
+        }) };
+        bench::Report("TRS compose glm (100k)", baselineMs);
+
+        RunLevels(
+            "TRS compose", baselineMs,
+            [&] { simd::ComposeTransforms({ positions.data(), COUNT }, { rotations.data(), COUNT }, { scales.data(), COUNT }, { out.data(), COUNT }); },
+            [&] { return MaxError(matrices, out); });
+    }
+}
@@ -0,0 +1,94 @@
+#include "Bench.h"
+
+#include <ugine/SlotMap.h>
+#include <ugine/Vector.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace ugine;
+
+namespace {
+
+// Typical resource sized value.
+struct Value {
+    u64 id{};
+    u8 payload[56]{};
+};
+
+} // namespace
+
+void BenchSlotMap() {
+    bench::Section("SlotMap");
+
+    constexpr u32 COUNT{ 100'000 };
+
+    std::mt19937 rng{ 42 };
+
+    SlotMap<Value> map;
+    std::vector<u64> keys(COUNT);
+
+    const auto insertMs{ bench::Measure(10, [&] {
+        map.Clear();
+        for (u32 i{}; i < COUNT; ++i) {
+            keys[i] = map.Emplace(Value{ .id = i });
+        }
+    }) };
+    bench::Report("Emplace (100k)", insertMs, std::format("{:.1f} Mop/s", COUNT / insertMs / 1000.0));
+
+    std::vector<Value> values(COUNT);
+    const auto batchMs{ bench::Measure(10, [&] {
+        map.Clear();
+        map.EmplaceBatch(Span<Value>{ values.data(), values.size() }, Span<u64>{ keys.data(), keys.size() });
+    }) };
+    bench::Report("EmplaceBatch (100k)", batchMs, std::format("{:.1f} Mop/s", COUNT / batchMs / 1000.0));
+
+    auto lookupKeys{ keys };
+    std::shuffle(lookupKeys.begin(), lookupKeys.end(), rng);
+
+    u64 sum{};
+    const auto lookupMs{ bench::Measure(10, [&] {
+        for (const auto key : lookupKeys) {
+            sum += map.Get(key)->id;
+        }
+    }) };
+    bench::Report("Get random (100k)", lookupMs, std::format("{:.1f} Mop/s", COUNT / lookupMs / 1000.0));
+
+    const auto iterateMs{ bench::Measure(10, [&] { map.ForEach([&](u64, Value& value) { sum += value.id; }); }) };
+    bench::Report("ForEach (100k)", iterateMs, std::format("{:.1f} Mop/s", COUNT / iterateMs / 1000.0));
+
+    const auto eraseMs{ bench::Measure(1, [&] {
+        for (const auto key : lookupKeys) {
+            map.Erase(key);
+        }
+    }) };
+    bench::Report("Erase random (100k)", eraseMs, std::format("{:.1f} Mop/s", COUNT / eraseMs / 1000.0));
+
+    // Half full map, ForEach skips holes via dense array.
+    map.EmplaceBatch(Span<Value>{ values.data(), values.size() }, Span<u64>{ keys.data(), keys.size() });
+    for (u32 i{}; i < COUNT; i += 2) {
+        map.Erase(keys[i]);
+    }
+    const auto sparseMs{ bench::Measure(10, [&] { map.ForEach([&](u64, Value& value) { sum += value.id; }); }) };
+    bench::Report("ForEach half erased (50k)", sparseMs);
+
+    const auto eraseBatchMs{ bench::Measure(1, [&] { map.EraseBatch(Span<const u64>{ keys.data(), keys.size() }); }) };
+    bench::Report("EraseBatch (100k keys, 50k live)", eraseBatchMs);
+
+    // Alloc/free ping-pong on an empty map, retained page avoids page churn.
+    for (const u32 retained : { 0u, 1u }) {
+        SlotMap<Value> pingPong;
+        pingPong.SetRetainedPages(retained);
+
+        const auto pingPongMs{ bench::Measure(1, [&] {
+            for (u32 i{}; i < COUNT; ++i) {
+                pingPong.Erase(pingPong.Emplace(Value{ .id = i }));
+            }
+        }) };
+        bench::Report(std::format("Ping-pong, retained pages {} (100k)", retained), pingPongMs,
+            std::format("{} page allocations", pingPong.GetStats().pageAllocations));
+    }
+
+    std::cout << std::format("  checksum {}\n", sum);
+}
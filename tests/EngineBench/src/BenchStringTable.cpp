@@ -0,0 +1,63 @@
+#include "Bench.h"
+
+#include <ugine/StringTable.h>
+
+#include <string>
+#include <vector>
+
+using namespace ugine;
+
+void BenchStringTable() {
+    bench::Section("String table");
+
+    // Large world: every fifth object has unique name, the rest are instances of few hundred prefabs.
+    constexpr u32 OBJECT_COUNT{ 500'000 };
+    constexpr u32 PREFAB_COUNT{ 300 };
+
+    std::vector<std::string> names(OBJECT_COUNT);
+    for (u32 i{}; i < OBJECT_COUNT; ++i) {
+        names[i] = i % 5 == 0 ? std::format("Environment/Props/Unique_Object_{}", i) : std::format("Environment/Foliage/Prefab_{}", i % PREFAB_COUNT);
+    }
+
+    // Previous TagComponent layout keeps std::string per object.
+    size_t stringBytes{ sizeof(std::string) * OBJECT_COUNT };
+    for (const auto& name : names) {
+        if (name.capacity() > std::string{}.capacity()) {
+            stringBytes += name.capacity() + 1;
+        }
+    }
+
+    StringTable table;
+    std::vector<StringID> ids(OBJECT_COUNT);
+
+    const auto internMs{ bench::Measure(1, [&] {
+        for (u32 i{}; i < OBJECT_COUNT; ++i) {
+            ids[i] = table.Intern(names[i]);
+        }
+    }) };
+    bench::Report("Intern (500k, first)", internMs, std::format("{:.1f} Mop/s", OBJECT_COUNT / internMs / 1000.0));
+
+    const auto reinternMs{ bench::Measure(5, [&] {
+        for (u32 i{}; i < OBJECT_COUNT; ++i) {
+            ids[i] = table.Intern(names[i]);
+        }
+    }) };
+    bench::Report("Intern (500k, existing)", reinternMs, std::format("{:.1f} Mop/s", OBJECT_COUNT / reinternMs / 1000.0));
+
+    size_t length{};
+    const auto lookupMs{ bench::Measure(5, [&] {
+        for (const auto id : ids) {
+            length += table.Lookup(id).Size();
+        }
+    }) };
+    bench::Report("Lookup (500k)", lookupMs, std::format("{:.1f} Mop/s", OBJECT_COUNT / lookupMs / 1000.0));
+
+    const auto stats{ table.GetStats() };
+    const auto internedBytes{ sizeof(StringID) * OBJECT_COUNT + stats.committed };
+
+    std::cout << std::format("  {} strings, capacity {}, text {:.1f} KB, tables {:.1f} KB, arena {:.1f} KB\n", stats.strings, stats.capacity,
+        stats.textBytes / 1e3, stats.tableBytes / 1e3, stats.committed / 1e3);
+    std::cout << std::format("  names of {} objects: std::string {:.1f} MB -> StringID + table {:.1f} MB ({:.0f}%)\n", OBJECT_COUNT, stringBytes / 1e6,
+        internedBytes / 1e6, 100.0 * internedBytes / stringBytes);
+    std::cout << std::format("  checksum {}\n", length);
+}
@@ -0,0 +1,89 @@
+#include "Bench.h"
+
+#include <ugine/engine/gfx/VertexPacking.h>
+#include <ugine/engine/gfx/asset/SerializedModel.h>
+
+#include <glm/gtc/constants.hpp>
+
+#include <algorithm>
+#include <limits>
+#include <random>
+#include <vector>
+
+using namespace ugine;
+
+void BenchVertexPacking() {
+    bench::Section("Vertex packing");
+
+    constexpr u32 VERTEX_COUNT{ 1'000'000 };
+
+    std::mt19937 rng{ 42 };
+    std::uniform_real_distribution<f32> dist{ -1.0f, 1.0f };
+
+    auto randomDirection = [&]() {
+        glm::vec3 dir{ dist(rng), dist(rng), dist(rng) };
+        return glm::length(dir) > 0.001f ? glm::normalize(dir) : glm::vec3{ 0, 0, 1 };
+    };
+
+    std::vector<MaterialVertex> vertices(VERTEX_COUNT);
+    std::vector<SerializedSkin> skin(VERTEX_COUNT);
+
+    glm::vec3 min{ std::numeric_limits<f32>::max() };
+    glm::vec3 max{ std::numeric_limits<f32>::lowest() };
+
+    for (u32 i{}; i < VERTEX_COUNT; ++i) {
+        auto& v{ vertices[i] };
+        v.position = glm::vec3{ dist(rng), dist(rng), dist(rng) } * 50.0f;
+        v.normal = randomDirection();
+        v.tangent = randomDirection();
+        v.uv = glm::vec2{ dist(rng), dist(rng) } * 4.0f;
+
+        min = glm::min(min, v.position);
+        max = glm::max(max, v.position);
+
+        skin[i].jointIndices = glm::vec4{ u32(i % 64), u32((i + 1) % 64), u32((i + 2) % 64), u32((i + 3) % 64) };
+        skin[i].jointWeights = glm::vec4{ 0.5f, 0.25f, 0.15f, 0.1f };
+    }
+
+    const auto quantization{ VertexQuantization::FromBounds(min, max) };
+
+    std::vector<MaterialVertexPacked> packed(VERTEX_COUNT);
+    const auto packMs{ bench::Measure(10, [&] {
+        PackVertices(Span<const MaterialVertex>{ vertices.data(), vertices.size() }, quantization, Span<MaterialVertexPacked>{ packed.data(), packed.size() });
+    }) };
+    bench::Report("PackVertices (1M)", packMs, std::format("{:.1f} Mvert/s", VERTEX_COUNT / packMs / 1000.0));
+
+    std::vector<SkinVertexPacked> packedSkin(VERTEX_COUNT);
+    const auto skinMs{ bench::Measure(10, [&] {
+        for (u32 i{}; i < VERTEX_COUNT; ++i) {
+            packedSkin[i] = PackSkin(skin[i]);
+        }
+    }) };
+    bench::Report("PackSkin (1M)", skinMs);
+
+    // Precision.
+    f32 maxPositionError{};
+    f32 maxNormalError{};
+    f32 maxUvError{};
+    for (u32 i{}; i < VERTEX_COUNT; ++i) {
+        const auto unpacked{ UnpackVertex(packed[i], quantization) };
+
+        maxPositionError = std::max(maxPositionError, glm::length(unpacked.position - vertices[i].position));
+        maxNormalError = std::max(maxNormalError, glm::acos(glm::clamp(glm::dot(unpacked.normal, vertices[i].normal), -1.0f, 1.0f)));
+        maxUvError = std::max(maxUvError, glm::length(unpacked.uv - vertices[i].uv));
+    }
+
+    std::cout << std::format("  max error: position {:.5f} (extent {:.1f}), normal {:.4f} deg, uv {:.5f}\n", maxPositionError,
+        glm::length(max - min), glm::degrees(maxNormalError), maxUvError);
+
+    // Memory.
+    const auto floatBytes{ sizeof(MaterialVertex) * VERTEX_COUNT };
+    const auto packedBytes{ sizeof(MaterialVertexPacked) * VERTEX_COUNT };
+    const auto floatSkinBytes{ sizeof(SerializedSkin) * VERTEX_COUNT };
+    const auto packedSkinBytes{ sizeof(SkinVertexPacked) * VERTEX_COUNT };
+
+    std::cout << std::format("  vertex: {} B -> {} B per vertex, {:.1f} MB -> {:.1f} MB ({:.0f}%)\n", sizeof(MaterialVertex), sizeof(MaterialVertexPacked),
+        floatBytes / 1e6, packedBytes / 1e6, 100.0 * packedBytes / floatBytes);
+    std::cout << std::format("  skin:   {} B -> {} B per vertex, {:.1f} MB -> {:.1f} MB ({:.0f}%)\n", sizeof(SerializedSkin), sizeof(SkinVertexPacked),
+        floatSkinBytes / 1e6, packedSkinBytes / 1e6, 100.0 * packedSkinBytes / floatSkinBytes);
+}
@@ -0,0 +1,127 @@
+#include "Bench.h"
+
+#include <ugine/FileSystem.h>
+#include <ugine/Scheduler.h>
+#include <ugine/Thread.h>
+
+#include <ugine/engine/world/Component.h>
+#include <ugine/engine/world/GameObject.h>
+#include <ugine/engine/world/WorldPartition.h>
+#include <ugine/engine/world/WorldSerializer.h>
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <thread>
+#include <vector>
+
+using namespace ugine;
+
+namespace {
+
+constexpr u32 CELLS{ 32 }; // Per side.
+constexpr f32 CELL_SIZE{ 64.0f };
+constexpr u32 ROOTS_PER_CELL{ 64 }; // Each with one child.
+constexpr u32 FRAMES{ 1500 };
+
+void Populate(GameObjectRegistry& registry) {
+    for (u32 cz{}; cz < CELLS; ++cz) {
+        for (u32 cx{}; cx < CELLS; ++cx) {
+            for (u32 i{}; i < ROOTS_PER_CELL; ++i) {
+                const glm::vec3 position{ (f32(cx) + f32(i % 8) / 8.0f) * CELL_SIZE, 0.0f, (f32(cz) + f32(i / 8) / 8.0f) * CELL_SIZE };
+
+                const auto root{ GameObject::Create(registry, "Prop").Entity() };
+                const auto child{ GameObject::Create(registry, "Detail").Entity() };
+
+                auto& transformation{ registry.get<TransformationComponent>(root) };
+                transformation.localTransformation = Transformation{ position, glm::fquat{ 1, 0, 0, 0 }, glm::vec3{ 1 } };
+                transformation.globalTransformation = transformation.localTransformation;
+                registry.get<TransformationComponent>(child).globalTransformation = transformation.globalTransformation;
+
+                bench::AttachChild(registry, root, child);
+            }
+        }
+    }
+}
+
+// Camera flies diagonally across the world, frame time is the partition update and delivery of reads.
+void Stream(std::string_view name, FileSystem& fileSystem, Scheduler& scheduler, u32 objectsPerFrame) {
+    using Clock = std::chrono::high_resolution_clock;
+
+    GameObjectRegistry registry;
+    WorldPartition partition{ registry, fileSystem, nullptr, &scheduler };
+    partition.SetSettings(WorldPartition::Settings{ .loadRadius = 160.0f, .unloadRadius = 224.0f, .objectsPerFrame = objectsPerFrame });
+    if (!partition.Open(Path{ "partition" })) {
+        bench::Report(name, 0.0, "FAILED to open");
+        return;
+    }
+
+    const auto extent{ f32(CELLS) * CELL_SIZE };
+
+    std::vector<f64> frames;
+    frames.reserve(FRAMES);
+    u32 peakObjects{};
+
+    for (u32 frame{}; frame < FRAMES; ++frame) {
+        const auto t{ f32(frame) / f32(FRAMES - 1) };
+        const glm::vec3 camera{ t * extent, 0.0f, t * extent };
+
+        const auto start{ Clock::now() };
+        fileSystem.SyncPoint();
+        partition.Update(Span<const glm::vec3>{ &camera, 1 });
+        frames.push_back(std::chrono::duration<f64, std::milli>(Clock::now() - start).count());
+
+        peakObjects = std::max(peakObjects, partition.GetStats().activeObjects);
+
+        // Reads progress between frames as they would during rendering.
+        std::this_thread::sleep_for(std::chrono::milliseconds{ 1 });
+    }
+
+    std::sort(frames.begin(), frames.end());
+    f64 total{};
+    for (const auto ms : frames) {
+        total += ms;
+    }
+
+    bench::Report(name, total / f64(frames.size()),
+        std::format("p99 {:.3f} ms, max {:.3f} ms, peak {} objects", frames[frames.size() * 99 / 100], frames.back(), peakObjects));
+}
+
+} // namespace
+
+void BenchWorldPartition() {
+    bench::Section("World partition");
+
+    const auto root{ std::filesystem::temp_directory_path() / "ugine_world_partition_bench" };
+    std::filesystem::remove_all(root);
+    std::filesystem::create_directories(root);
+
+    GameObjectRegistry source;
+    Populate(source);
+
+    const auto buildMs{ bench::Measure(1, [&] { WorldPartition::Build(source, Path{ (root / "partition").string().c_str() }, CELL_SIZE); }) };
+    bench::Report("Build (32x32 cells)", buildMs, std::format("{} objects", u32(source.alive())));
+
+    // Whole world at once, the spike streaming avoids.
+    {
+        std::vector<GameObjectHandle> objects;
+        source.each([&](auto entity) { objects.push_back(entity); });
+
+        Vector<u8> data;
+        WorldSerializer::Save(source, Span<const GameObjectHandle>{ objects.data(), objects.size() }, WorldSerializer::Format::Binary, data);
+
+        GameObjectRegistry registry;
+        const auto loadMs{ bench::Measure(1, [&] { WorldSerializer::Load(registry, data.ToSpan()); }) };
+        bench::Report("Load whole world", loadMs, std::format("{} objects", u32(registry.alive())));
+    }
+
+    Scheduler scheduler{ Thread::HardwareConcurency() };
+    auto fileSystem{ FileSystem::Create(Path{ root.string().c_str() }) };
+
+    Stream("Stream, unlimited activation (frame)", *fileSystem, scheduler, 0);
+    Stream("Stream, 1024 objects/frame (frame)", *fileSystem, scheduler, 1024);
+    Stream("Stream, 256 objects/frame (frame)", *fileSystem, scheduler, 256);
+
+    fileSystem = nullptr;
+    std::filesystem::remove_all(root);
+}
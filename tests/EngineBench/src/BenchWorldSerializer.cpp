@@ -0,0 +1,101 @@
+#include "Bench.h"
+
+#include <ugine/Memory.h>
+#include <ugine/Scheduler.h>
+#include <ugine/Thread.h>
+
+#include <ugine/engine/gfx/Component.h>
+#include <ugine/engine/world/Component.h>
+#include <ugine/engine/world/GameObject.h>
+#include <ugine/engine/world/WorldSerializer.h>
+
+#include <string>
+#include <vector>
+
+using namespace ugine;
+
+namespace {
+
+constexpr u32 OBJECTS{ 100'000 };
+constexpr u32 CHILDREN{ 9 };
+
+// Roots with CHILDREN children each, some lights and a camera.
+std::vector<GameObjectHandle> Populate(GameObjectRegistry& registry) {
+    std::vector<GameObjectHandle> objects;
+    objects.reserve(OBJECTS);
+
+    GameObjectHandle root{ GameObjectNull };
+    for (u32 i{}; i < OBJECTS; ++i) {
+        const auto go{ GameObject::Create(registry, std::format("Object {}", i)).Entity() };
+        objects.push_back(go);
+
+        auto& transformation{ registry.get<TransformationComponent>(go) };
+        transformation.localTransformation = Transformation{ glm::vec3{ f32(i % 100), 0.0f, f32(i / 100) }, glm::fquat{ 1, 0, 0, 0 }, glm::vec3{ 1 } };
+        transformation.globalTransformation = transformation.localTransformation;
+
+        if (i % (CHILDREN + 1) == 0) {
+            root = go;
+        } else {
+            bench::AttachChild(registry, root, go);
+        }
+
+        if (i % 100 == 1) {
+            registry.emplace<LightComponent>(go, LightComponent{ .type = LightComponent::Type::Point, .range = 5.0f });
+        }
+    }
+
+    registry.emplace<CameraComponent>(objects.front(), CameraComponent{ .isMain = true });
+
+    return objects;
+}
+
+// Allocator bytes held when a phase starts, its peak is measured from here.
+u64 StartPhase() {
+    IAllocator::ResetPeakBytes();
+    return IAllocator::LiveBytes();
+}
+
+std::string MemoryNote(u64 before) {
+#ifdef UGINE_ALLOCATION_STATS
+    return std::format("peak +{:.1f} MB", f64(IAllocator::PeakBytes() - before) / 1e6);
+#else
+    return "peak needs UGINE_ALLOCATION_STATS";
+#endif
+}
+
+void Load(std::string_view name, Span<const u8> data, Scheduler* scheduler) {
+    GameObjectRegistry registry;
+
+    const auto before{ StartPhase() };
+    bool loaded{};
+    const auto ms{ bench::Measure(1, [&] { loaded = WorldSerializer::Load(registry, data, nullptr, scheduler); }) };
+
+    bench::Report(name, ms, std::format("{} objects{}, {}", u32(registry.alive()), loaded ? "" : " FAILED", MemoryNote(before)));
+}
+
+} // namespace
+
+void BenchWorldSerializer() {
+    bench::Section("World serializer");
+
+    GameObjectRegistry source;
+    const auto objects{ Populate(source) };
+    const Span<const GameObjectHandle> span{ objects.data(), objects.size() };
+
+    Scheduler scheduler{ Thread::HardwareConcurency() };
+
+    Vector<u8> binary;
+    auto before{ StartPhase() };
+    const auto saveBinaryMs{ bench::Measure(1, [&] { WorldSerializer::Save(source, span, WorldSerializer::Format::Binary, binary); }) };
+    bench::Report("Save binary (100k)", saveBinaryMs, std::format("{:.1f} MB, {}", f64(binary.Size()) / 1e6, MemoryNote(before)));
+
+    Load("Load binary (100k)", binary.ToSpan(), nullptr);
+    Load("Load binary parallel (100k)", binary.ToSpan(), &scheduler);
+
+    Vector<u8> json;
+    before = StartPhase();
+    const auto saveJsonMs{ bench::Measure(1, [&] { WorldSerializer::Save(source, span, WorldSerializer::Format::Json, json); }) };
+    bench::Report("Save JSON (100k)", saveJsonMs, std::format("{:.1f} MB, {}", f64(json.Size()) / 1e6, MemoryNote(before)));
+
+    Load("Load JSON (100k)", json.ToSpan(), nullptr);
+}
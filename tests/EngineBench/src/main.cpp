@@ -0,0 +1,35 @@
+void BenchClusterCulling();
+void BenchFrameAllocator();
+void BenchInplaceFunction();
+void BenchIoQueue();
+void BenchLogging();
+void BenchOcclusion();
+void BenchPak();
+void BenchPoolAllocator();
+void BenchResourceEvents();
+void BenchSimdMath();
+void BenchSlotMap();
+void BenchStringTable();
+void BenchVertexPacking();
+void BenchWorldPartition();
+void BenchWorldSerializer();
+
+int main(int argc, char* argv[]) {
+    BenchVertexPacking();
+    BenchClusterCulling();
+    BenchOcclusion();
+    BenchFrameAllocator();
+    BenchPoolAllocator();
+    BenchSlotMap();
+    BenchResourceEvents();
+    BenchStringTable();
+    BenchInplaceFunction();
+    BenchSimdMath();
+    BenchLogging();
+    BenchPak();
+    BenchIoQueue();
+    BenchWorldSerializer();
+    BenchWorldPartition();
+
+    return 0;
+}
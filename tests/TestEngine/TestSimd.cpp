@@ -0,0 +1,217 @@
+#include <gtest/gtest.h>
+
+#include <ugine/engine/math/Aabb.h>
+#include <ugine/engine/math/Simd.h>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+#include <glm/gtx/transform.hpp>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace ugine;
+
+namespace {
+
+constexpr f32 EPSILON{ 1e-4f };
+
+// Counts around SIMD widths (4 for SSE2, 8 for AVX2) to cover the scalar tails.
+constexpr u32 COUNTS[]{ 0, 1, 2, 3, 4, 5, 7, 8, 9, 15, 16, 17, 31, 33 };
+
+struct Random {
+    std::mt19937 rng{ 1234 };
+
+    f32 Float(f32 min, f32 max) { return std::uniform_real_distribution<f32>{ min, max }(rng); }
+    glm::vec3 Vec3(f32 min, f32 max) { return glm::vec3{ Float(min, max), Float(min, max), Float(min, max) }; }
+
+    glm::quat Rotation() { return glm::normalize(glm::quat{ Float(-1, 1), Float(-1, 1), Float(-1, 1), Float(-1, 1) }); }
+
+    glm::mat4 Affine() { return glm::translate(Vec3(-100, 100)) * glm::mat4_cast(Rotation()) * glm::scale(Vec3(0.1f, 10.0f)); }
+
+    AABB Box() {
+        const auto center{ Vec3(-50, 50) };
+        const auto extent{ Vec3(0.01f, 20) };
+        return AABB{ center - extent, center + extent };
+    }
+
+    std::vector<glm::mat4> Matrices(u32 count) {
+        std::vector<glm::mat4> result(count);
+        std::generate(result.begin(), result.end(), [&] { return Affine(); });
+        return result;
+    }
+};
+
+// Relative to magnitude, results of large translations differ in the last bits only.
+void ExpectNear(f32 expected, f32 actual) {
+    EXPECT_NEAR(expected, actual, EPSILON * std::max(1.0f, std::abs(expected)));
+}
+
+void ExpectNear(const glm::vec3& expected, const glm::vec3& actual) {
+    for (int i{}; i < 3; ++i) {
+        ExpectNear(expected[i], actual[i]);
+    }
+}
+
+void ExpectNear(const std::vector<glm::mat4>& expected, const std::vector<glm::mat4>& actual) {
+    ASSERT_EQ(expected.size(), actual.size());
+    for (size_t i{}; i < expected.size(); ++i) {
+        for (int c{}; c < 4; ++c) {
+            for (int r{}; r < 4; ++r) {
+                ExpectNear(expected[i][c][r], actual[i][c][r]);
+            }
+        }
+    }
+}
+
+void ExpectNear(const std::vector<AABB>& expected, const std::vector<AABB>& actual) {
+    ASSERT_EQ(expected.size(), actual.size());
+    for (size_t i{}; i < expected.size(); ++i) {
+        ExpectNear(expected[i].Min(), actual[i].Min());
+        ExpectNear(expected[i].Max(), actual[i].Max());
+    }
+}
+
+template <typename T> Span<const T> ToSpan(const std::vector<T>& v) {
+    return Span<const T>{ v.data(), v.size() };
+}
+
+template <typename T> Span<T> ToSpan(std::vector<T>& v) {
+    return Span<T>{ v.data(), v.size() };
+}
+
+// Runs each test for every SIMD level, results are compared against scalar path.
+class Simd : public ::testing::TestWithParam<simd::Level> {
+protected:
+    void SetUp() override {
+        previous_ = simd::ActiveLevel();
+        if (GetParam() > simd::SupportedLevel()) {
+            GTEST_SKIP() << simd::LevelName(GetParam()) << " not supported";
+        }
+    }
+
+    void TearDown() override { simd::SetLevel(previous_); }
+
+    // Result of `func` at scalar level and at tested level.
+    template <typename F> auto Run(F&& func) {
+        simd::SetLevel(simd::Level::Scalar);
+        auto expected{ func() };
+
+        simd::SetLevel(GetParam());
+        EXPECT_EQ(GetParam(), simd::ActiveLevel());
+        auto actual{ func() };
+
+        return std::make_pair(std::move(expected), std::move(actual));
+    }
+
+    simd::Level previous_{};
+};
+
+} // namespace
+
+TEST_P(Simd, TransformAabbs) {
+    for (const auto count : COUNTS) {
+        SCOPED_TRACE(count);
+
+        Random random;
+        const auto matrix{ random.Affine() };
+        const auto matrices{ random.Matrices(count) };
+        std::vector<AABB> boxes(count);
+        std::generate(boxes.begin(), boxes.end(), [&] { return random.Box(); });
+
+        const auto [expected, actual] = Run([&] {
+            std::vector<AABB> out(count);
+            simd::TransformAabbs(matrix, ToSpan(boxes), ToSpan(out));
+            return out;
+        });
+        ExpectNear(expected, actual);
+
+        const auto [expectedEach, actualEach] = Run([&] {
+            std::vector<AABB> out(count);
+            simd::TransformAabbs(ToSpan(matrices), ToSpan(boxes), ToSpan(out));
+            return out;
+        });
+        ExpectNear(expectedEach, actualEach);
+    }
+}
+
+TEST_P(Simd, MultiplyMatrices) {
+    for (const auto count : COUNTS) {
+        SCOPED_TRACE(count);
+
+        Random random;
+        const auto a{ random.Affine() };
+        const auto as{ random.Matrices(count) };
+        const auto bs{ random.Matrices(count) };
+
+        const auto [expected, actual] = Run([&] {
+            std::vector<glm::mat4> out(count);
+            simd::MultiplyMatrices(a, ToSpan(bs), ToSpan(out));
+            return out;
+        });
+        ExpectNear(expected, actual);
+
+        const auto [expectedEach, actualEach] = Run([&] {
+            std::vector<glm::mat4> out(count);
+            simd::MultiplyMatrices(ToSpan(as), ToSpan(bs), ToSpan(out));
+            return out;
+        });
+        ExpectNear(expectedEach, actualEach);
+
+        // Output aliasing input.
+        const auto [expectedAlias, actualAlias] = Run([&] {
+            auto out{ bs };
+            simd::MultiplyMatrices(ToSpan(as), ToSpan(out), ToSpan(out));
+            return out;
+        });
+        ExpectNear(expectedAlias, actualAlias);
+    }
+}
+
+TEST_P(Simd, InverseAffine) {
+    for (const auto count : COUNTS) {
+        SCOPED_TRACE(count);
+
+        Random random;
+        const auto matrices{ random.Matrices(count) };
+
+        const auto [expected, actual] = Run([&] {
+            std::vector<glm::mat4> out(count);
+            simd::InverseAffine(ToSpan(matrices), ToSpan(out));
+            return out;
+        });
+        ExpectNear(expected, actual);
+
+        // Scalar path is the reference, check it against glm::inverse as well.
+        for (size_t i{}; i < matrices.size(); ++i) {
+            ExpectNear(std::vector<glm::mat4>{ glm::inverse(matrices[i]) }, std::vector<glm::mat4>{ expected[i] });
+        }
+    }
+}
+
+TEST_P(Simd, ComposeTransforms) {
+    for (const auto count : COUNTS) {
+        SCOPED_TRACE(count);
+
+        Random random;
+        std::vector<glm::vec3> positions(count);
+        std::vector<glm::quat> rotations(count);
+        std::vector<glm::vec3> scales(count);
+        for (u32 i{}; i < count; ++i) {
+            positions[i] = random.Vec3(-100, 100);
+            rotations[i] = random.Rotation();
+            scales[i] = random.Vec3(0.1f, 10.0f);
+        }
+
+        const auto [expected, actual] = Run([&] {
+            std::vector<glm::mat4> out(count);
+            simd::ComposeTransforms(ToSpan(positions), ToSpan(rotations), ToSpan(scales), ToSpan(out));
+            return out;
+        });
+        ExpectNear(expected, actual);
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(Levels, Simd, ::testing::Values(simd::Level::SSE2, simd::Level::AVX2),
+    [](const ::testing::TestParamInfo<simd::Level>& info) { return std::string{ simd::LevelName(info.param) }; });
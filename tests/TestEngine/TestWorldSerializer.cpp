@@ -0,0 +1,380 @@
+#include <gtest/gtest.h>
+
+#include <ugine/engine/gfx/Component.h>
+#include <ugine/engine/world/Component.h>
+#include <ugine/engine/world/GameObject.h>
+#include <ugine/engine/world/WorldSerializer.h>
+
+#include <ugine/Scheduler.h>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <utility>
+
+using namespace ugine;
+
+namespace {
+
+constexpr f32 EPSILON{ 1e-4f };
+
+// Binary world layout, see WorldSerializer.cpp.
+constexpr size_t HEADER_SIZE{ 24 };
+constexpr size_t HEADER_CHUNKS_OFFSET{ 16 };
+
+struct ChunkHeader {
+    u32 type;
+    u32 count;
+    u64 size;
+};
+
+enum ChunkType : u32 {
+    Objects = 0,
+    Parent = 2,
+    Mesh = 4,
+};
+
+// Root with camera, child a (static, with child c holding instanced mesh) and child b with light.
+struct Hierarchy {
+    GameObjectHandle root{};
+    GameObjectHandle a{};
+    GameObjectHandle b{};
+    GameObjectHandle c{};
+
+    Vector<GameObjectHandle> Objects() const { return Vector<GameObjectHandle>{ root, a, b, c }; }
+};
+
+GameObjectHandle CreateObject(GameObjectRegistry& registry, std::string_view name, GameObjectHandle parent, const Transformation& local) {
+    const auto object{ GameObject::Create(registry, name).Entity() };
+
+    auto& transformation{ registry.get<TransformationComponent>(object) };
+    transformation.localTransformation = local;
+    transformation.globalTransformation = local;
+
+    if (parent != GameObjectNull) {
+        registry.emplace<ParentComponent>(object, parent);
+        transformation.globalTransformation = registry.get<TransformationComponent>(parent).globalTransformation * local;
+
+        auto& rel{ registry.get<RelationshipComponent>(parent) };
+        if (rel.children++ == 0) {
+            rel.firstChild = object;
+        } else {
+            registry.get<RelationshipComponent>(rel.lastChild).nextSibling = object;
+            registry.get<RelationshipComponent>(object).prevSibling = rel.lastChild;
+        }
+        rel.lastChild = object;
+    }
+
+    return object;
+}
+
+Hierarchy CreateHierarchy(GameObjectRegistry& registry) {
+    const glm::fquat IDENTITY{ 1, 0, 0, 0 };
+    const glm::fquat rotation{ glm::vec3{ 0.1f, 0.2f, 0.3f } };
+
+    Hierarchy h;
+    h.root = CreateObject(registry, "root", GameObjectNull, Transformation{ glm::vec3{ 1, 2, 3 }, rotation, glm::vec3{ 2 } });
+    h.a = CreateObject(registry, "a", h.root, Transformation{ glm::vec3{ 0, 5, 0 }, IDENTITY, glm::vec3{ 1 } });
+    h.b = CreateObject(registry, "b", h.root, Transformation{ glm::vec3{ -4, 0, 1 }, rotation, glm::vec3{ 0.5f } });
+    h.c = CreateObject(registry, "c", h.a, Transformation{ glm::vec3{ 0, 0, 7 }, IDENTITY, glm::vec3{ 3 } });
+
+    registry.emplace<StaticFlagComponent>(h.a);
+
+    auto& tag{ registry.get<TagComponent>(h.b) };
+    tag.flags = TagComponent::Disabled;
+    tag.layers = 0x5;
+    tag.stencil = 3;
+
+    registry.emplace<CameraComponent>(h.root, CameraComponent{
+                                                  .isMain = true,
+                                                  .projection = Camera::ProjectionType::Ortho,
+                                                  .vFovDeg = 60.0f,
+                                                  .zNear = 0.5f,
+                                                  .zFar = 500.0f,
+                                                  .width = 640,
+                                                  .height = 480,
+                                              });
+
+    auto& light{ registry.emplace<LightComponent>(h.b) };
+    light.type = LightComponent::Type::Spot;
+    light.intensity = 4.0f;
+    light.color = ColorRGB{ 1.0f, 0.5f, 0.25f };
+    light.range = 20.0f;
+    light.spotAngleDeg = 30.0f;
+    light.generatesShadows = true;
+
+    auto& mesh{ registry.emplace<MeshComponent>(h.c) };
+    mesh.instanced = true;
+    for (u32 i{}; i < 3; ++i) {
+        MaterialVertexInstance instance;
+        instance.instance0.w = f32(i);
+        instance.instance1.w = f32(i * 2);
+        instance.instance2.w = f32(i * 3);
+        mesh.instanceTransformations.push_back(instance);
+    }
+
+    return h;
+}
+
+Vector<u8> Save(GameObjectRegistry& registry, const Vector<GameObjectHandle>& objects, WorldSerializer::Format format = WorldSerializer::Format::Binary) {
+    Vector<u8> data;
+    WorldSerializer::Save(registry, objects.ToSpan(), format, data);
+    return data;
+}
+
+std::string_view Name(GameObjectRegistry& registry, GameObjectHandle object) {
+    return GameObject{ registry, object }.Name();
+}
+
+void ExpectNear(const Transformation& a, const Transformation& b) {
+    for (int i{}; i < 3; ++i) {
+        EXPECT_NEAR(a.position[i], b.position[i], EPSILON);
+        EXPECT_NEAR(a.scale[i], b.scale[i], EPSILON);
+    }
+    EXPECT_NEAR(std::abs(glm::dot(a.rotation, b.rotation)), 1.0f, EPSILON);
+}
+
+// Offset of first chunk of given type.
+size_t FindChunk(const Vector<u8>& data, u32 type) {
+    for (size_t offset{ HEADER_SIZE }; offset + sizeof(ChunkHeader) <= data.Size();) {
+        ChunkHeader chunk;
+        memcpy(&chunk, data.Data() + offset, sizeof(chunk));
+        if (chunk.type == type) {
+            return offset;
+        }
+        offset += sizeof(ChunkHeader) + chunk.size;
+    }
+
+    ADD_FAILURE() << "Missing chunk " << type;
+    return 0;
+}
+
+template <typename T> void Patch(Vector<u8>& data, size_t offset, T value) {
+    ASSERT_LE(offset + sizeof(T), data.Size());
+    memcpy(data.Data() + offset, &value, sizeof(T));
+}
+
+} // namespace
+
+TEST(WorldSerializer, BinaryRoundTrip) {
+    GameObjectRegistry source;
+    const auto h{ CreateHierarchy(source) };
+    const auto data{ Save(source, h.Objects()) };
+
+    Scheduler scheduler{ 4 };
+    GameObjectRegistry registry;
+    Vector<GameObjectHandle> loaded;
+    ASSERT_TRUE(WorldSerializer::Load(registry, data.ToSpan(), nullptr, &scheduler, &loaded));
+    ASSERT_EQ(loaded.Size(), 4u);
+    EXPECT_EQ(registry.alive(), 4u);
+
+    const auto root{ loaded[0] };
+    const auto a{ loaded[1] };
+    const auto b{ loaded[2] };
+    const auto c{ loaded[3] };
+
+    EXPECT_EQ(Name(registry, root), "root");
+    EXPECT_EQ(Name(registry, a), "a");
+    EXPECT_EQ(Name(registry, b), "b");
+    EXPECT_EQ(Name(registry, c), "c");
+
+    EXPECT_FALSE(registry.all_of<StaticFlagComponent>(root));
+    EXPECT_TRUE(registry.all_of<StaticFlagComponent>(a));
+
+    const auto& tag{ registry.get<TagComponent>(b) };
+    EXPECT_EQ(tag.flags, u32(TagComponent::Disabled));
+    EXPECT_EQ(tag.layers, 0x5u);
+    EXPECT_EQ(tag.stencil, 3);
+
+    // Transformations are stored as they are, not recomputed.
+    for (const auto [from, to] : { std::pair{ h.root, root }, std::pair{ h.a, a }, std::pair{ h.b, b }, std::pair{ h.c, c } }) {
+        const auto& expected{ source.get<TransformationComponent>(from) };
+        const auto& actual{ registry.get<TransformationComponent>(to) };
+        EXPECT_TRUE(actual.localTransformation == expected.localTransformation);
+        EXPECT_TRUE(actual.globalTransformation == expected.globalTransformation);
+    }
+
+    EXPECT_FALSE(registry.all_of<ParentComponent>(root));
+    EXPECT_EQ(registry.get<ParentComponent>(a).parent, root);
+    EXPECT_EQ(registry.get<ParentComponent>(b).parent, root);
+    EXPECT_EQ(registry.get<ParentComponent>(c).parent, a);
+
+    const auto& rootRel{ registry.get<RelationshipComponent>(root) };
+    EXPECT_EQ(rootRel.children, 2u);
+    EXPECT_EQ(rootRel.firstChild, a);
+    EXPECT_EQ(rootRel.lastChild, b);
+    EXPECT_EQ(registry.get<RelationshipComponent>(a).nextSibling, b);
+    EXPECT_EQ(registry.get<RelationshipComponent>(b).prevSibling, a);
+    EXPECT_EQ(registry.get<RelationshipComponent>(a).firstChild, c);
+    EXPECT_EQ(registry.get<RelationshipComponent>(c).children, 0u);
+
+    ASSERT_TRUE(registry.all_of<CameraComponent>(root));
+    const auto& camera{ registry.get<CameraComponent>(root) };
+    EXPECT_TRUE(camera.isMain);
+    EXPECT_EQ(camera.projection, Camera::ProjectionType::Ortho);
+    EXPECT_EQ(camera.vFovDeg, 60.0f);
+    EXPECT_EQ(camera.zNear, 0.5f);
+    EXPECT_EQ(camera.zFar, 500.0f);
+    EXPECT_EQ(camera.width, 640u);
+    EXPECT_EQ(camera.height, 480u);
+
+    ASSERT_TRUE(registry.all_of<LightComponent>(b));
+    const auto& light{ registry.get<LightComponent>(b) };
+    EXPECT_EQ(light.type, LightComponent::Type::Spot);
+    EXPECT_EQ(light.intensity, 4.0f);
+    EXPECT_EQ(light.color.g, 0.5f);
+    EXPECT_EQ(light.range, 20.0f);
+    EXPECT_EQ(light.spotAngleDeg, 30.0f);
+    EXPECT_TRUE(light.generatesShadows);
+    EXPECT_FALSE(registry.all_of<LightComponent>(root));
+
+    // Resource references stay empty without resource manager.
+    ASSERT_TRUE(registry.all_of<MeshComponent>(c));
+    const auto& mesh{ registry.get<MeshComponent>(c) };
+    const auto& expectedMesh{ source.get<MeshComponent>(h.c) };
+    EXPECT_TRUE(mesh.instanced);
+    EXPECT_FALSE(mesh.modelInstance.GetModel());
+    ASSERT_EQ(mesh.instanceTransformations.size(), 3u);
+    EXPECT_EQ(memcmp(mesh.instanceTransformations.data(), expectedMesh.instanceTransformations.data(), sizeof(MaterialVertexInstance) * 3), 0);
+
+    // Loads again next to existing objects.
+    ASSERT_TRUE(WorldSerializer::Load(registry, data.ToSpan()));
+    EXPECT_EQ(registry.alive(), 8u);
+}
+
+TEST(WorldSerializer, ReferencesOutsideListAreNull) {
+    GameObjectRegistry source;
+    const auto h{ CreateHierarchy(source) };
+
+    // Root alone, its children aren't saved.
+    {
+        GameObjectRegistry registry;
+        Vector<GameObjectHandle> loaded;
+        ASSERT_TRUE(WorldSerializer::Load(registry, Save(source, Vector<GameObjectHandle>{ h.root }).ToSpan(), nullptr, nullptr, &loaded));
+        ASSERT_EQ(loaded.Size(), 1u);
+
+        const auto& rel{ registry.get<RelationshipComponent>(loaded[0]) };
+        EXPECT_EQ(rel.firstChild, GameObjectNull);
+        EXPECT_EQ(rel.lastChild, GameObjectNull);
+    }
+
+    // Subtrees without root load as roots where they were.
+    {
+        GameObjectRegistry registry;
+        Vector<GameObjectHandle> loaded;
+        ASSERT_TRUE(WorldSerializer::Load(registry, Save(source, Vector<GameObjectHandle>{ h.a, h.b, h.c }).ToSpan(), nullptr, nullptr, &loaded));
+        ASSERT_EQ(loaded.Size(), 3u);
+
+        const auto a{ loaded[0] };
+        const auto b{ loaded[1] };
+        const auto c{ loaded[2] };
+
+        for (const auto [from, to] : { std::pair{ h.a, a }, std::pair{ h.b, b } }) {
+            EXPECT_FALSE(registry.all_of<ParentComponent>(to));
+
+            const auto& rel{ registry.get<RelationshipComponent>(to) };
+            EXPECT_EQ(rel.prevSibling, GameObjectNull);
+            EXPECT_EQ(rel.nextSibling, GameObjectNull);
+
+            const auto& expected{ source.get<TransformationComponent>(from).globalTransformation };
+            const auto& actual{ registry.get<TransformationComponent>(to) };
+            EXPECT_TRUE(actual.localTransformation == expected);
+            EXPECT_TRUE(actual.globalTransformation == expected);
+        }
+
+        // Links inside the list are kept.
+        EXPECT_EQ(registry.get<ParentComponent>(c).parent, a);
+        EXPECT_EQ(registry.get<RelationshipComponent>(a).firstChild, c);
+        EXPECT_TRUE(registry.get<TransformationComponent>(c).localTransformation == source.get<TransformationComponent>(h.c).localTransformation);
+    }
+
+    // Source is untouched.
+    EXPECT_EQ(source.get<ParentComponent>(h.a).parent, h.root);
+    EXPECT_EQ(source.get<RelationshipComponent>(h.a).nextSibling, h.b);
+}
+
+TEST(WorldSerializer, JsonLoads) {
+    GameObjectRegistry source;
+    const auto h{ CreateHierarchy(source) };
+    const auto data{ Save(source, h.Objects(), WorldSerializer::Format::Json) };
+    ASSERT_FALSE(data.Empty());
+    EXPECT_EQ(data[0], '[');
+
+    GameObjectRegistry registry;
+    Vector<GameObjectHandle> loaded;
+    ASSERT_TRUE(WorldSerializer::Load(registry, data.ToSpan(), nullptr, nullptr, &loaded));
+    ASSERT_EQ(loaded.Size(), 4u);
+
+    const auto root{ loaded[0] };
+    const auto a{ loaded[1] };
+    const auto b{ loaded[2] };
+    const auto c{ loaded[3] };
+
+    EXPECT_EQ(Name(registry, b), "b");
+    EXPECT_TRUE(registry.all_of<StaticFlagComponent>(a));
+    EXPECT_EQ(registry.get<TagComponent>(b).layers, 0x5u);
+
+    EXPECT_EQ(registry.get<ParentComponent>(c).parent, a);
+    EXPECT_EQ(registry.get<RelationshipComponent>(root).firstChild, a);
+    EXPECT_EQ(registry.get<RelationshipComponent>(a).nextSibling, b);
+
+    // Global transformations are recomputed from local ones.
+    for (const auto [from, to] : { std::pair{ h.root, root }, std::pair{ h.a, a }, std::pair{ h.b, b }, std::pair{ h.c, c } }) {
+        const auto& expected{ source.get<TransformationComponent>(from) };
+        const auto& actual{ registry.get<TransformationComponent>(to) };
+        ExpectNear(actual.localTransformation, expected.localTransformation);
+        ExpectNear(actual.globalTransformation, expected.globalTransformation);
+    }
+
+    EXPECT_EQ(registry.get<CameraComponent>(root).width, 640u);
+    EXPECT_EQ(registry.get<LightComponent>(b).type, LightComponent::Type::Spot);
+}
+
+TEST(WorldSerializer, TruncatedDataFails) {
+    GameObjectRegistry source;
+    const auto h{ CreateHierarchy(source) };
+    const auto data{ Save(source, h.Objects()) };
+
+    GameObjectRegistry registry;
+    for (size_t size{ 1 }; size < data.Size(); ++size) {
+        SCOPED_TRACE(size);
+        EXPECT_FALSE(WorldSerializer::Load(registry, Span<const u8>{ data.Data(), size }));
+        EXPECT_EQ(registry.alive(), 0u);
+    }
+}
+
+TEST(WorldSerializer, CorruptedDataFails) {
+    GameObjectRegistry source;
+    const auto h{ CreateHierarchy(source) };
+    const auto data{ Save(source, h.Objects()) };
+
+    const auto objects{ FindChunk(data, Objects) };
+    const auto parent{ FindChunk(data, Parent) };
+    const auto mesh{ FindChunk(data, Mesh) };
+
+    const auto expectFail{ [&](auto patch) {
+        auto corrupted{ data.Clone() };
+        patch(corrupted);
+
+        GameObjectRegistry registry;
+        EXPECT_FALSE(WorldSerializer::Load(registry, corrupted.ToSpan()));
+        EXPECT_EQ(registry.alive(), 0u);
+    } };
+
+    // Chunk counts above object count or payload size are rejected before decoding.
+    expectFail([&](Vector<u8>& d) { Patch(d, objects + offsetof(ChunkHeader, count), ~0u); });
+    expectFail([&](Vector<u8>& d) { Patch(d, mesh + offsetof(ChunkHeader, count), 5u); });
+    expectFail([&](Vector<u8>& d) { Patch(d, HEADER_CHUNKS_OFFSET, ~0u); });
+
+    // Object index out of range, fails once objects exist.
+    expectFail([&](Vector<u8>& d) { Patch(d, parent + sizeof(ChunkHeader), 100u); });
+
+    // Instance count of single mesh: object index, model, material count, instanced flag.
+    expectFail([&](Vector<u8>& d) { Patch(d, mesh + sizeof(ChunkHeader) + 13, 0x7fffffffu); });
+
+    // Neither binary world nor JSON.
+    expectFail([&](Vector<u8>& d) { Patch(d, 0, 0x12345678u); });
+}
@@ -4,6 +4,10 @@
 #include <ugine/String.h>
 #include <ugine/Vector.h>
 
+#include <cstring>
+#include <thread>
+#include <vector>
+
 using namespace ugine;
 
 TEST(Allocator, StackTrace) {
@@ -86,4 +90,243 @@ TEST(Allocator, UniquePtr) {
     }
 
     ASSERT_EQ(0, allocator.ActiveAllocs());
-}
\ No newline at end of file
+}
+
+TEST(Allocator, ArenaAlignment) {
+    ArenaAllocator arena{ 64 * 1024 };
+
+    for (size_t alignment : { 1, 2, 4, 8, 16, 64, 256, 4096 }) {
+        auto ptr{ arena.AlignedAlloc(3, alignment) };
+        ASSERT_NE(nullptr, ptr);
+        ASSERT_EQ(0, reinterpret_cast<uintptr_t>(ptr) % alignment);
+    }
+}
+
+TEST(Allocator, ArenaGrows) {
+    ArenaAllocator arena{ 64 * 1024 };
+
+    // Much more than one block, all allocations stay valid.
+    std::vector<u32*> allocations;
+    for (u32 i{}; i < 1000; ++i) {
+        auto ptr{ static_cast<u32*>(arena.AlignedAlloc(1024, alignof(u32))) };
+        ptr[0] = i;
+        ptr[255] = i;
+        allocations.push_back(ptr);
+    }
+
+    for (u32 i{}; i < allocations.size(); ++i) {
+        ASSERT_EQ(i, allocations[i][0]);
+        ASSERT_EQ(i, allocations[i][255]);
+    }
+
+    const auto stats{ arena.GetStats() };
+    ASSERT_GT(stats.blocks, 1);
+    ASSERT_GE(stats.used, 1000 * 1024);
+
+    // Single allocation larger than block size.
+    auto large{ static_cast<u8*>(arena.AlignedAlloc(1024 * 1024, 16)) };
+    large[1024 * 1024 - 1] = 1;
+    ASSERT_EQ(1, large[1024 * 1024 - 1]);
+}
+
+TEST(Allocator, ArenaReset) {
+    ArenaAllocator arena{ 64 * 1024 };
+
+    for (u32 i{}; i < 100; ++i) {
+        arena.Alloc(4096);
+    }
+
+    const auto blocks{ arena.GetStats().blocks };
+    const auto used{ arena.GetStats().used };
+
+    arena.Reset();
+
+    auto stats{ arena.GetStats() };
+    ASSERT_EQ(0, stats.used);
+    ASSERT_EQ(used, stats.lastFrame);
+    ASSERT_EQ(used, stats.highWater);
+
+    // Same workload reuses existing blocks.
+    for (u32 i{}; i < 100; ++i) {
+        arena.Alloc(4096);
+    }
+
+    stats = arena.GetStats();
+    ASSERT_EQ(blocks, stats.blocks);
+    ASSERT_EQ(used, stats.used);
+}
+
+TEST(Allocator, ArenaVector) {
+    ArenaAllocator arena{ 64 * 1024 };
+
+    // Grows through realloc (trivially copyable) and alloc + move.
+    Vector<u32> ints{ arena };
+    Vector<String> strings{ arena };
+    for (u32 i{}; i < 10000; ++i) {
+        ints.PushBack(i);
+        if (i % 100 == 0) {
+            strings.PushBack(String{ "test" });
+        }
+    }
+
+    for (u32 i{}; i < 10000; ++i) {
+        ASSERT_EQ(i, ints[i]);
+    }
+    ASSERT_EQ(100, strings.Size());
+}
+
+TEST(Allocator, ArenaThreads) {
+    ArenaAllocator arena{ 64 * 1024 };
+
+    constexpr u32 THREADS{ 8 };
+    constexpr u32 ALLOCATIONS{ 10000 };
+
+    std::vector<std::vector<u64*>> allocations(THREADS);
+    std::vector<std::thread> threads;
+    for (u32 t{}; t < THREADS; ++t) {
+        threads.emplace_back([&, t] {
+            for (u32 i{}; i < ALLOCATIONS; ++i) {
+                auto ptr{ static_cast<u64*>(arena.AlignedAlloc(sizeof(u64) * 4, alignof(u64))) };
+                ptr[0] = u64(t) << 32 | i;
+                ptr[3] = ptr[0];
+                allocations[t].push_back(ptr);
+            }
+        });
+    }
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    for (u32 t{}; t < THREADS; ++t) {
+        for (u32 i{}; i < ALLOCATIONS; ++i) {
+            ASSERT_EQ(u64(t) << 32 | i, allocations[t][i][0]);
+            ASSERT_EQ(u64(t) << 32 | i, allocations[t][i][3]);
+        }
+    }
+}
+
+TEST(Allocator, PoolSizeClasses) {
+    for (size_t size{ 1 }; size <= PoolAllocator::MAX_SMALL_SIZE; ++size) {
+        const auto sizeClass{ PoolAllocator::SizeClass(size) };
+        ASSERT_LT(sizeClass, PoolAllocator::NUM_SIZE_CLASSES);
+        ASSERT_GE(PoolAllocator::ClassSize(sizeClass), size);
+        if (sizeClass > 0) {
+            ASSERT_LT(PoolAllocator::ClassSize(sizeClass - 1), size);
+        }
+    }
+}
+
+TEST(Allocator, Pool) {
+    PoolAllocator pool{ IAllocator::Default(), 64 * 1024 * 1024 };
+
+    std::vector<std::pair<u8*, size_t>> allocations;
+    for (size_t size{ 1 }; size < 2 * PoolAllocator::MAX_SMALL_SIZE; size += 7) {
+        auto ptr{ static_cast<u8*>(pool.Alloc(size)) };
+        ASSERT_EQ(0, reinterpret_cast<uintptr_t>(ptr) % PoolAllocator::MIN_ALIGNMENT);
+        ASSERT_EQ(size <= PoolAllocator::MAX_SMALL_SIZE, pool.Owns(ptr));
+        memset(ptr, u8(size), size);
+        allocations.emplace_back(ptr, size);
+    }
+
+    for (const auto& [ptr, size] : allocations) {
+        for (size_t i{}; i < size; ++i) {
+            ASSERT_EQ(u8(size), ptr[i]);
+        }
+        pool.Free(ptr);
+    }
+
+    // Freed blocks are reused.
+    const auto slabs{ pool.GetStats().slabs };
+    for (u32 i{}; i < 1000; ++i) {
+        pool.Free(pool.Alloc(64));
+    }
+    ASSERT_EQ(slabs, pool.GetStats().slabs);
+
+    // Over-aligned goes to fallback.
+    auto aligned{ pool.AlignedAlloc(64, 256) };
+    ASSERT_EQ(0, reinterpret_cast<uintptr_t>(aligned) % 256);
+    ASSERT_FALSE(pool.Owns(aligned));
+    pool.AlignedFree(aligned);
+}
+
+TEST(Allocator, PoolRealloc) {
+    PoolAllocator pool{ IAllocator::Default(), 64 * 1024 * 1024 };
+
+    auto ptr{ static_cast<u8*>(pool.Realloc(nullptr, 10)) };
+    memset(ptr, 7, 10);
+
+    // Small -> small -> fallback.
+    for (size_t size : { 100, 3000, 10000 }) {
+        ptr = static_cast<u8*>(pool.Realloc(ptr, size));
+        for (u32 i{}; i < 10; ++i) {
+            ASSERT_EQ(7, ptr[i]);
+        }
+    }
+    pool.Free(ptr);
+
+    Vector<u32> ints{ pool };
+    for (u32 i{}; i < 10000; ++i) {
+        ints.PushBack(i);
+    }
+    for (u32 i{}; i < 10000; ++i) {
+        ASSERT_EQ(i, ints[i]);
+    }
+}
+
+TEST(Allocator, PoolCrossThreadFree) {
+    PoolAllocator pool{ IAllocator::Default(), 256 * 1024 * 1024 };
+
+    constexpr u32 THREADS{ 8 };
+    constexpr u32 ALLOCATIONS{ 10000 };
+
+    std::vector<std::vector<u32*>> allocations(THREADS);
+    std::vector<std::thread> threads;
+    for (u32 t{}; t < THREADS; ++t) {
+        threads.emplace_back([&, t] {
+            for (u32 i{}; i < ALLOCATIONS; ++i) {
+                auto ptr{ static_cast<u32*>(pool.Alloc(8 + i % 200)) };
+                *ptr = t;
+                allocations[t].push_back(ptr);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    threads.clear();
+
+    // Each thread frees memory allocated by its neighbour.
+    for (u32 t{}; t < THREADS; ++t) {
+        threads.emplace_back([&, t] {
+            const auto owner{ (t + 1) % THREADS };
+            for (auto ptr : allocations[owner]) {
+                ASSERT_EQ(owner, *ptr);
+                pool.Free(ptr);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    // Blocks freed on other threads are reused.
+    const auto slabs{ pool.GetStats().slabs };
+    threads.clear();
+    for (u32 t{}; t < THREADS; ++t) {
+        threads.emplace_back([&] {
+            std::vector<void*> memory;
+            for (u32 i{}; i < ALLOCATIONS; ++i) {
+                memory.push_back(pool.Alloc(8 + i % 200));
+            }
+            for (auto ptr : memory) {
+                pool.Free(ptr);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    ASSERT_EQ(slabs, pool.GetStats().slabs);
+}
@@ -1,5 +1,7 @@
 #include <gtest/gtest.h>
 
+#include <ugine/SlotMap.h>
+#include <ugine/String.h>
 #include <ugine/Vector.h>
 
 using namespace ugine;
@@ -165,3 +167,112 @@ TEST(Vector, CopyVector) {
 
     //v2 = v1;
 }
+
+TEST(SlotMap, Basic) {
+    HeapAllocator heap;
+    CountedAllocator allocator{ heap };
+
+    {
+        SlotMap<String> map{ allocator };
+
+        const auto a{ map.Emplace("a") };
+        const auto b{ map.Emplace("b") };
+        ASSERT_EQ(2, map.Size());
+        ASSERT_EQ(String{ "a" }, *map.Get(a));
+        ASSERT_EQ(String{ "b" }, *map.Get(b));
+
+        map.Erase(a);
+        ASSERT_EQ(1, map.Size());
+        ASSERT_EQ(nullptr, map.Get(a));
+        ASSERT_FALSE(map.Contains(a));
+
+        // Slot is reused with new generation, old key stays invalid.
+        const auto c{ map.Emplace("c") };
+        ASSERT_NE(a, c);
+        ASSERT_EQ(nullptr, map.Get(a));
+        ASSERT_EQ(String{ "c" }, *map.Get(c));
+
+        // Erasing stale key does nothing.
+        map.Erase(a);
+        ASSERT_EQ(2, map.Size());
+
+        ASSERT_EQ(nullptr, map.Get(0));
+        ASSERT_EQ(nullptr, map.Get(~0ull));
+
+        map.Clear();
+        ASSERT_TRUE(map.Empty());
+    }
+
+    ASSERT_EQ(0, allocator.Count());
+}
+
+TEST(SlotMap, ForEach) {
+    SlotMap<u32> map;
+
+    Vector<u64> keys;
+    for (u32 i{}; i < 10000; ++i) {
+        keys.PushBack(map.Emplace(i));
+    }
+
+    for (u32 i{}; i < 10000; i += 2) {
+        map.Erase(keys[i]);
+    }
+
+    u64 sum{};
+    u32 count{};
+    map.ForEach([&](u64 key, u32& value) {
+        ASSERT_EQ(&value, map.Get(key));
+        ASSERT_EQ(1, value % 2);
+        sum += value;
+        ++count;
+    });
+
+    ASSERT_EQ(5000, count);
+    ASSERT_EQ(25'000'000, sum);
+}
+
+TEST(SlotMap, Batch) {
+    SlotMap<String> map;
+
+    Vector<String> values;
+    for (u32 i{}; i < 1000; ++i) {
+        values.PushBack(String{ "value" });
+    }
+
+    Vector<u64> keys;
+    keys.Resize(values.Size());
+    map.EmplaceBatch(values.ToSpan(), keys.ToSpan());
+
+    ASSERT_EQ(1000, map.Size());
+    for (const auto key : keys) {
+        ASSERT_EQ(String{ "value" }, *map.Get(key));
+    }
+
+    map.EraseBatch(Span<const u64>{ keys.Data(), 500 });
+    ASSERT_EQ(500, map.Size());
+    ASSERT_EQ(nullptr, map.Get(keys[0]));
+    ASSERT_NE(nullptr, map.Get(keys[500]));
+
+    // Already erased keys are skipped.
+    map.EraseBatch(keys.ToSpan());
+    ASSERT_TRUE(map.Empty());
+}
+
+TEST(SlotMap, PageRetention) {
+    SlotMap<u64, u64, 4096> map;
+
+    // Ping-pong on an empty map keeps its page.
+    for (u32 i{}; i < 100; ++i) {
+        map.Erase(map.Emplace(i));
+    }
+    ASSERT_EQ(1, map.GetStats().pageAllocations);
+    ASSERT_EQ(0, map.GetStats().pageDeallocations);
+
+    map.SetRetainedPages(0);
+    ASSERT_EQ(1, map.GetStats().pageDeallocations);
+
+    for (u32 i{}; i < 100; ++i) {
+        map.Erase(map.Emplace(i));
+    }
+    ASSERT_EQ(101, map.GetStats().pageAllocations);
+}
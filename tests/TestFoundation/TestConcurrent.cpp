@@ -0,0 +1,291 @@
+#include <gtest/gtest.h>
+
+#include <ugine/Concurrent.h>
+#include <ugine/String.h>
+
+#include <array>
+#include <chrono>
+#include <format>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace ugine;
+
+namespace {
+
+// Spin locked ring, baseline for throughput.
+class LockedQueue {
+public:
+    static constexpr u32 Capacity{ 4096 };
+
+    bool PushBack(u64 item) {
+        Lock lock{ mutex_ };
+        const auto next{ (head_ + 1) % Capacity };
+        if (next == tail_) {
+            return false;
+        }
+        data_[head_] = item;
+        head_ = next;
+        return true;
+    }
+
+    bool PopFront(u64& item) {
+        Lock lock{ mutex_ };
+        if (tail_ == head_) {
+            return false;
+        }
+        item = data_[tail_];
+        tail_ = (tail_ + 1) % Capacity;
+        return true;
+    }
+
+private:
+    std::array<u64, Capacity> data_{};
+    u32 head_{};
+    u32 tail_{};
+    AtomicSpinLock mutex_;
+};
+
+// Pushes `count` values per producer, consumers sum popped values.
+template <typename Queue> u64 RunProducersConsumers(Queue& queue, u32 producers, u32 consumers, u32 count) {
+    std::atomic_uint64_t sum{};
+    std::atomic_uint32_t consumed{};
+    const auto total{ producers * count };
+
+    std::vector<std::thread> threads;
+    for (u32 p{}; p < producers; ++p) {
+        threads.emplace_back([&] {
+            for (u32 i{ 1 }; i <= count; ++i) {
+                while (!queue.PushBack(u64(i))) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    for (u32 c{}; c < consumers; ++c) {
+        threads.emplace_back([&] {
+            u64 localSum{};
+            u64 value{};
+            while (consumed.load(std::memory_order_relaxed) < total) {
+                if (queue.PopFront(value)) {
+                    localSum += value;
+                    consumed.fetch_add(1, std::memory_order_relaxed);
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+            sum += localSum;
+        });
+    }
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    return sum;
+}
+
+} // namespace
+
+TEST(Concurrent, MPMCQueue) {
+    MPMCQueue<u32, 4> queue;
+
+    u32 value{};
+    ASSERT_FALSE(queue.PopFront(value));
+
+    for (u32 i{}; i < 4; ++i) {
+        ASSERT_TRUE(queue.PushBack(i));
+    }
+    ASSERT_FALSE(queue.PushBack(4u));
+    ASSERT_EQ(4, queue.SizeApprox());
+
+    // FIFO, wraps around.
+    for (u32 round{}; round < 10; ++round) {
+        ASSERT_TRUE(queue.PopFront(value));
+        ASSERT_EQ(round, value);
+        ASSERT_TRUE(queue.PushBack(round + 4));
+    }
+}
+
+TEST(Concurrent, MPMCQueueNonTrivial) {
+    auto queue{ std::make_unique<MPMCQueue<String, 16>>() };
+
+    ASSERT_TRUE(queue->PushBack(String{ "first" }));
+    ASSERT_TRUE(queue->PushBack(String{ "second" }));
+
+    String value;
+    ASSERT_TRUE(queue->PopFront(value));
+    ASSERT_EQ(String{ "first" }, value);
+
+    // Remaining values are destroyed with the queue.
+    queue = nullptr;
+}
+
+TEST(Concurrent, MPMCQueueThreads) {
+    constexpr u32 COUNT{ 100'000 };
+
+    for (auto [producers, consumers] : { std::pair{ 1u, 1u }, std::pair{ 4u, 1u }, std::pair{ 1u, 4u }, std::pair{ 4u, 4u } }) {
+        auto queue{ std::make_unique<MPMCQueue<u64, 1024>>() };
+        const auto sum{ RunProducersConsumers(*queue, producers, consumers, COUNT) };
+        ASSERT_EQ(u64(producers) * COUNT * (COUNT + 1) / 2, sum);
+        ASSERT_TRUE(queue->Empty());
+    }
+}
+
+TEST(Concurrent, SPSCRing) {
+    SPSCRing<u32, 4> ring;
+
+    u32 value{};
+    ASSERT_FALSE(ring.PopFront(value));
+
+    for (u32 i{}; i < 4; ++i) {
+        ASSERT_TRUE(ring.PushBack(i));
+    }
+    ASSERT_FALSE(ring.PushBack(4u));
+
+    for (u32 round{}; round < 10; ++round) {
+        ASSERT_TRUE(ring.PopFront(value));
+        ASSERT_EQ(round, value);
+        ASSERT_TRUE(ring.PushBack(round + 4));
+    }
+}
+
+TEST(Concurrent, SPSCRingThreads) {
+    constexpr u32 COUNT{ 100'000 };
+
+    auto ring{ std::make_unique<SPSCRing<u64, 256>>() };
+
+    std::thread producer{ [&] {
+        for (u32 i{}; i < COUNT; ++i) {
+            while (!ring->PushBack(u64(i))) {
+                std::this_thread::yield();
+            }
+        }
+    } };
+
+    // Values arrive in order.
+    u64 expected{};
+    u64 value{};
+    while (expected < COUNT) {
+        if (ring->PopFront(value)) {
+            ASSERT_EQ(expected, value);
+            ++expected;
+        }
+    }
+
+    producer.join();
+    ASSERT_TRUE(ring->Empty());
+}
+
+TEST(Concurrent, SPSCByteRing) {
+    SPSCByteRing<64> ring;
+    ASSERT_EQ(nullptr, ring.Front());
+
+    // 8 B header + 16 B data, third block doesn't fit.
+    for (u8 i{}; i < 2; ++i) {
+        auto data{ ring.Reserve(16) };
+        ASSERT_NE(nullptr, data);
+        memset(data, i, 16);
+        ring.Commit();
+    }
+    ASSERT_EQ(nullptr, ring.Reserve(16));
+
+    // Block which doesn't fit before end of storage wraps around.
+    ASSERT_EQ(0, *ring.Front());
+    ring.PopFront();
+
+    auto data{ ring.Reserve(16) };
+    ASSERT_NE(nullptr, data);
+    memset(data, 2, 16);
+
+    const auto end{ ring.CommittedEnd() };
+    ring.Commit();
+
+    ASSERT_EQ(1, *ring.Front(end));
+    ring.PopFront();
+    ASSERT_EQ(nullptr, ring.Front(end));
+
+    ASSERT_EQ(2, *ring.Front());
+    ring.PopFront();
+    ASSERT_TRUE(ring.Empty());
+}
+
+TEST(Concurrent, SPSCByteRingThreads) {
+    constexpr u32 COUNT{ 100'000 };
+
+    auto ring{ std::make_unique<SPSCByteRing<1024>>() };
+
+    // Block sizes vary so padding lands on different positions.
+    const auto blockValues{ [](u32 i) { return 1 + i % 7; } };
+
+    std::thread producer{ [&] {
+        for (u32 i{}; i < COUNT; ++i) {
+            const auto size{ u32(sizeof(u32)) * blockValues(i) };
+
+            u8* data{};
+            while (!(data = ring->Reserve(size))) {
+                std::this_thread::yield();
+            }
+
+            for (u32 j{}; j < blockValues(i); ++j) {
+                memcpy(data + j * sizeof(u32), &i, sizeof(u32));
+            }
+            ring->Commit();
+        }
+    } };
+
+    // Blocks arrive in order and intact.
+    u32 expected{};
+    while (expected < COUNT) {
+        if (const auto data{ ring->Front() }) {
+            for (u32 j{}; j < blockValues(expected); ++j) {
+                u32 value{};
+                memcpy(&value, data + j * sizeof(u32), sizeof(u32));
+                ASSERT_EQ(expected, value);
+            }
+
+            ring->PopFront();
+            ++expected;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+
+    producer.join();
+    ASSERT_TRUE(ring->Empty());
+}
+
+// Throughput report, run with --gtest_also_run_disabled_tests.
+TEST(Concurrent, DISABLED_QueueThroughput) {
+    using Clock = std::chrono::high_resolution_clock;
+
+    constexpr u32 COUNT{ 1'000'000 };
+
+    const auto report = [](std::string_view name, u32 threads, u32 items, Clock::duration duration) {
+        const auto ms{ std::chrono::duration<f64, std::milli>(duration).count() };
+        std::cout << std::format("{:<8} {:>2}P/{:>2}C {:>10.2f} ms {:>8.2f} Mops/s\n", name, threads, threads, ms, items / ms / 1000.0);
+    };
+
+    for (u32 threads{ 1 }; threads <= 32; threads *= 2) {
+        const auto count{ COUNT / threads };
+
+        auto queue{ std::make_unique<MPMCQueue<u64, 4096>>() };
+        auto start{ Clock::now() };
+        RunProducersConsumers(*queue, threads, threads, count);
+        report("MPMC", threads, threads * count, Clock::now() - start);
+
+        // Previous spin locked ring for comparison.
+        auto locked{ std::make_unique<LockedQueue>() };
+        start = Clock::now();
+        RunProducersConsumers(*locked, threads, threads, count);
+        report("Locked", threads, threads * count, Clock::now() - start);
+    }
+
+    auto ring{ std::make_unique<SPSCRing<u64, 4096>>() };
+    const auto start{ Clock::now() };
+    RunProducersConsumers(*ring, 1, 1, COUNT);
+    report("SPSC", 1, COUNT, Clock::now() - start);
+}
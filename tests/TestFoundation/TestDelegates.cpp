@@ -1,6 +1,11 @@
 #include <gtest/gtest.h>
 
 #include <ugine/Delegate.h>
+#include <ugine/InplaceFunction.h>
+#include <ugine/Memory.h>
+
+#include <array>
+#include <memory>
 
 using namespace ugine;
 
@@ -69,4 +74,69 @@ TEST(DelegateTest, Basic) {
 
     //    passDelegate([v1, v2, v3, v4](int param) { std::cout << "Multi-capture lambda\n"; });
     //}
-}
\ No newline at end of file
+}
+
+TEST(InplaceFunctionTest, Basic) {
+    InplaceFunction<int(int)> f;
+    EXPECT_FALSE(f);
+
+    f = [](int a) { return a * 2; };
+    EXPECT_TRUE(f);
+    EXPECT_EQ(f(21), 42);
+
+    std::array<u64, 4> values{ 1, 2, 3, 4 };
+    InplaceFunction<u64(u64), 32> sum{ [values](u64 a) { return a + values[0] + values[1] + values[2] + values[3]; } };
+    EXPECT_EQ(sum(10), 20);
+
+    int counter{};
+    InplaceFunction<void()> increment{ [&counter, step = 2]() mutable { counter += step++; } };
+    increment();
+    increment();
+    EXPECT_EQ(counter, 5);
+
+    f = nullptr;
+    EXPECT_FALSE(f);
+}
+
+TEST(InplaceFunctionTest, MoveOnly) {
+    auto value{ std::make_shared<int>(7) };
+
+    InplaceFunction<int()> f{ [value, owned = std::make_unique<int>(3)] { return *value + *owned; } };
+    EXPECT_EQ(value.use_count(), 2);
+    EXPECT_EQ(f(), 10);
+
+    InplaceFunction<int()> g{ std::move(f) };
+    EXPECT_FALSE(f);
+    EXPECT_EQ(g(), 10);
+    EXPECT_EQ(value.use_count(), 2);
+
+    f = std::move(g);
+    EXPECT_FALSE(g);
+    EXPECT_EQ(f(), 10);
+
+    f.Reset();
+    EXPECT_EQ(value.use_count(), 1);
+
+    {
+        InplaceFunction<int()> scoped{ [value] { return *value; } };
+        EXPECT_EQ(value.use_count(), 2);
+    }
+    EXPECT_EQ(value.use_count(), 1);
+}
+
+TEST(InplaceFunctionTest, NoAllocations) {
+    struct Large {
+        std::array<u64, 6> data{};
+    };
+
+    Large large{};
+    large.data[5] = 5;
+
+    const auto allocs{ IAllocator::NumAllocs() };
+
+    InplaceFunction<u64(), sizeof(Large)> f{ [large] { return large.data[5]; } };
+    auto g{ std::move(f) };
+    EXPECT_EQ(g(), 5);
+
+    EXPECT_EQ(IAllocator::NumAllocs(), allocs);
+}
@@ -0,0 +1,210 @@
+#include <gtest/gtest.h>
+
+#include <ugine/DerivedDataCache.h>
+
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+using namespace ugine;
+
+namespace {
+
+constexpr u64 HEADER_SIZE{ 24 };
+
+// Fresh cache directory, removed with the fixture.
+class DerivedDataCacheTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        root_ = std::filesystem::temp_directory_path() / "ugine_test_ddc";
+        std::filesystem::remove_all(root_);
+    }
+
+    void TearDown() override { std::filesystem::remove_all(root_); }
+
+    Path Root() const { return Path{ root_.string() }; }
+
+    std::filesystem::path EntryFile(const DerivedDataCache::Key& key) const {
+        const auto name{ key.ToString() };
+        return root_ / std::string{ name.Data(), 2 } / (std::string{ name.Data() } + ".ddc");
+    }
+
+    std::vector<std::filesystem::path> Entries() const {
+        std::vector<std::filesystem::path> entries;
+        for (const auto& entry : std::filesystem::recursive_directory_iterator{ root_ }) {
+            if (entry.is_regular_file() && entry.path().extension() == ".ddc") {
+                entries.push_back(entry.path());
+            }
+        }
+        return entries;
+    }
+
+    u64 EntriesSize() const {
+        u64 size{};
+        for (const auto& entry : Entries()) {
+            size += std::filesystem::file_size(entry);
+        }
+        return size;
+    }
+
+    u64 SizeFile() const {
+        u64 size{};
+        std::ifstream file{ root_ / "size" };
+        file >> size;
+        return file ? size : ~0ull;
+    }
+
+    std::filesystem::path root_;
+};
+
+DerivedDataCache::Key MakeKey(u32 value) {
+    return DerivedDataCache::KeyBuilder{ "test", 1 }.AddValue(value).Finish();
+}
+
+bool Equal(const Vector<u8>& a, const Vector<u8>& b) {
+    return a.Size() == b.Size() && (a.Empty() || memcmp(a.Data(), b.Data(), a.Size()) == 0);
+}
+
+Vector<u8> Payload(size_t size, u8 value) {
+    Vector<u8> data(size);
+    for (size_t i{}; i < size; ++i) {
+        data[i] = u8(value + i);
+    }
+    return data;
+}
+
+} // namespace
+
+TEST(DerivedDataCache, KeyFieldsAreSeparated) {
+    const auto a{ DerivedDataCache::KeyBuilder{ "test", 1 }.AddString("ab").AddString("c").Finish() };
+    const auto b{ DerivedDataCache::KeyBuilder{ "test", 1 }.AddString("a").AddString("bc").Finish() };
+    const auto c{ DerivedDataCache::KeyBuilder{ "test", 1 }.AddString("abc").Finish() };
+    EXPECT_NE(a, b);
+    EXPECT_NE(a, c);
+    EXPECT_NE(b, c);
+
+    // Same fields, same key. Importer name and version are part of it.
+    EXPECT_EQ(a, DerivedDataCache::KeyBuilder{ "test", 1 }.AddString("ab").AddString("c").Finish());
+    EXPECT_NE(a, DerivedDataCache::KeyBuilder{ "test", 2 }.AddString("ab").AddString("c").Finish());
+    EXPECT_NE(a, DerivedDataCache::KeyBuilder{ "other", 1 }.AddString("ab").AddString("c").Finish());
+
+    EXPECT_EQ(a.ToString().Size(), 32u);
+}
+
+TEST_F(DerivedDataCacheTest, RoundTrip) {
+    DerivedDataCache cache{ Root() };
+
+    Vector<u8> data;
+    EXPECT_FALSE(cache.Get(MakeKey(1), data));
+
+    const auto payload{ Payload(1000, 3) };
+    ASSERT_TRUE(cache.Put(MakeKey(1), payload.ToSpan()));
+    ASSERT_TRUE(cache.Put(MakeKey(2), Span<const u8>{}));
+
+    ASSERT_TRUE(cache.Get(MakeKey(1), data));
+    EXPECT_TRUE(Equal(data, payload));
+    ASSERT_TRUE(cache.Get(MakeKey(2), data));
+    EXPECT_TRUE(data.Empty());
+    EXPECT_FALSE(cache.Get(MakeKey(3), data));
+
+    const auto stats{ cache.GetStats() };
+    EXPECT_EQ(stats.hits, 2u);
+    EXPECT_EQ(stats.misses, 2u);
+    EXPECT_EQ(stats.writes, 2u);
+    EXPECT_EQ(stats.evictions, 0u);
+    EXPECT_FLOAT_EQ(stats.HitRate(), 0.5f);
+
+    // Entries are shared with other instances on the same root.
+    DerivedDataCache other{ Root() };
+    ASSERT_TRUE(other.Get(MakeKey(1), data));
+    EXPECT_TRUE(Equal(data, payload));
+
+    EXPECT_EQ(SizeFile(), EntriesSize());
+}
+
+TEST_F(DerivedDataCacheTest, CorruptedEntryIsMiss) {
+    DerivedDataCache cache{ Root() };
+    ASSERT_TRUE(cache.Put(MakeKey(1), Payload(1000, 1).ToSpan()));
+    ASSERT_TRUE(cache.Put(MakeKey(2), Payload(1000, 2).ToSpan()));
+
+    const auto entries{ Entries() };
+    ASSERT_EQ(entries.size(), 2u);
+
+    // One entry truncated, the other with a flipped payload byte.
+    std::filesystem::resize_file(entries[0], 500);
+    {
+        std::fstream file{ entries[1], std::ios::binary | std::ios::in | std::ios::out };
+        file.seekp(HEADER_SIZE + 10);
+        file.put(char(0x55));
+    }
+
+    Vector<u8> data;
+    EXPECT_FALSE(cache.Get(MakeKey(1), data));
+    EXPECT_FALSE(cache.Get(MakeKey(2), data));
+    EXPECT_EQ(cache.GetStats().misses, 2u);
+    EXPECT_EQ(cache.GetStats().hits, 0u);
+
+    EXPECT_TRUE(Entries().empty());
+
+    // Rebuilt by the caller.
+    ASSERT_TRUE(cache.Put(MakeKey(1), Payload(1000, 1).ToSpan()));
+    EXPECT_TRUE(cache.Get(MakeKey(1), data));
+}
+
+TEST_F(DerivedDataCacheTest, EvictsLeastRecentlyUsed) {
+    // Three entries fit, a fourth trims to 90% of the limit.
+    constexpr u64 ENTRY_SIZE{ HEADER_SIZE + 1000 };
+    DerivedDataCache cache{ Root(), 3500 };
+
+    for (u32 i{}; i < 3; ++i) {
+        ASSERT_TRUE(cache.Put(MakeKey(i), Payload(1000, u8(i)).ToSpan()));
+    }
+    EXPECT_EQ(SizeFile(), 3 * ENTRY_SIZE);
+
+    // Modification time is the LRU order, spread it explicitly so file time resolution doesn't matter.
+    const auto now{ std::filesystem::file_time_type::clock::now() };
+    for (u32 i{}; i < 3; ++i) {
+        std::filesystem::last_write_time(EntryFile(MakeKey(i)), now - std::chrono::hours{ 3 - i });
+    }
+
+    // Key 0 is used again, key 1 becomes oldest.
+    Vector<u8> data;
+    ASSERT_TRUE(cache.Get(MakeKey(0), data));
+
+    ASSERT_TRUE(cache.Put(MakeKey(3), Payload(1000, 3).ToSpan()));
+    EXPECT_EQ(cache.GetStats().evictions, 1u);
+
+    EXPECT_FALSE(std::filesystem::exists(EntryFile(MakeKey(1))));
+    EXPECT_TRUE(cache.Get(MakeKey(0), data));
+    EXPECT_TRUE(cache.Get(MakeKey(2), data));
+    EXPECT_TRUE(cache.Get(MakeKey(3), data));
+
+    EXPECT_EQ(Entries().size(), 3u);
+    EXPECT_LE(EntriesSize(), u64(3500 * 0.9));
+    EXPECT_EQ(SizeFile(), EntriesSize());
+}
+
+TEST_F(DerivedDataCacheTest, SizeFileIsRebuilt) {
+    {
+        DerivedDataCache cache{ Root() };
+        for (u32 i{}; i < 4; ++i) {
+            ASSERT_TRUE(cache.Put(MakeKey(i), Payload(100 * (i + 1), u8(i)).ToSpan()));
+        }
+    }
+    EXPECT_EQ(SizeFile(), EntriesSize());
+
+    // Cache written by an older version or size file lost.
+    std::filesystem::remove(root_ / "size");
+
+    DerivedDataCache cache{ Root() };
+    ASSERT_TRUE(cache.Put(MakeKey(10), Payload(100, 10).ToSpan()));
+    EXPECT_EQ(SizeFile(), EntriesSize());
+    EXPECT_EQ(Entries().size(), 5u);
+
+    // Replacing an entry doesn't count it twice.
+    ASSERT_TRUE(cache.Put(MakeKey(10), Payload(200, 10).ToSpan()));
+    EXPECT_EQ(SizeFile(), EntriesSize());
+    EXPECT_EQ(Entries().size(), 5u);
+}
@@ -1,21 +1,111 @@
+#include <gtest/gtest.h>
+
+#include <ugine/File.h>
 #include <ugine/Image.h>
 
+#include <cstring>
+#include <filesystem>
+
 using namespace ugine;
 
-void TestImage() {
+namespace {
+
+Path TempImage(const char* name) {
+    return Path{ (std::filesystem::temp_directory_path() / name).string() };
+}
+
+// RGBA8 image with full mip chain, every byte of a mip holds its level.
+Image MippedImage(u32 width, u32 height, u32 mips) {
+    Image image{ width, height, 4, 1 };
+    image.Allocate(Image::Format::RGBA8, mips);
+    for (u32 mip{}; mip < mips; ++mip) {
+        auto data{ image.GetMip(0, mip) };
+        memset(data.Data(), int(mip), data.Size());
+    }
+    return image;
+}
+
+Vector<u8> Encode(const Image& image, const char* name) {
+    const auto path{ TempImage(name) };
+    EXPECT_TRUE(image.Save(path));
+
+    auto data{ ReadFileBinary(path) };
+    std::filesystem::remove(path.Data());
+    return data;
+}
+
+} // namespace
+
+TEST(Image, CopyAndMove) {
     HeapAllocator heap;
-    CountedAllocator callocator{ heap };
-    StackTraceAllocator allocator{ callocator };
+    CountedAllocator allocator{ heap };
+
+    {
+        Image image{ allocator };
+        image = Image{ 100, 200, 4, 1, allocator };
+
+        Image image2{ std::move(image) };
+
+        Vector<Image> images{ allocator };
+        images.PushBack(image2);
+
+        Vector<Image> copy{ images.Clone() };
+        EXPECT_EQ(copy[0].Width(), 100u);
+        EXPECT_EQ(copy[0].Height(), 200u);
+        EXPECT_EQ(copy[0].GetLayer().Size(), 100u * 200u * 4u);
+    }
+
+    EXPECT_EQ(allocator.Count(), 0u);
+}
+
+TEST(Image, PartialMipChain) {
+    // 64x32 down to 1x1, 7 levels.
+    const auto data{ Encode(MippedImage(64, 32, 7), "ugine_test_mips.ktx") };
+    ASSERT_FALSE(data.Empty());
+
+    struct Case {
+        u32 maxExtent;
+        u32 baseMip;
+    };
+
+    const Case cases[]{
+        { 1000, 0 }, // Whole chain fits.
+        { 64, 0 },   // Equal to base level.
+        { 16, 2 },   // Equal to a level.
+        { 20, 2 },   // Between 32 and 16.
+        { 3, 5 },    // Between 4 and 2.
+        { 1, 6 },    // Equal to last level.
+        { 0, 6 },    // Smaller than last level, last level is loaded.
+    };
+
+    for (const auto& c : cases) {
+        SCOPED_TRACE(c.maxExtent);
+
+        Image image;
+        ASSERT_TRUE(Image::FromMemoryEncoded(data.ToSpan(), image, c.maxExtent));
 
-    Image image{ allocator };
-    image = Image{ 100, 200, 4, 1, allocator };
+        EXPECT_EQ(image.BaseMip(), c.baseMip);
+        EXPECT_EQ(image.Mips(), 7 - c.baseMip);
+        EXPECT_EQ(image.Width(), std::max(64u >> c.baseMip, 1u));
+        EXPECT_EQ(image.Height(), std::max(32u >> c.baseMip, 1u));
+        EXPECT_EQ(image.GetFormat(), Image::Format::RGBA8);
 
-    Image image2{ std::move(image) };
+        for (u32 mip{}; mip < image.Mips(); ++mip) {
+            const auto level{ image.GetMip(0, mip) };
+            ASSERT_EQ(level.Size(), image.MipSize(mip));
+            EXPECT_EQ(level[0], c.baseMip + mip);
+            EXPECT_EQ(level[level.Size() - 1], c.baseMip + mip);
+        }
+    }
+}
 
-    Vector<Image> images{ allocator };
-    images.PushBack(image2);
+TEST(Image, SingleMipLoad) {
+    const auto data{ Encode(MippedImage(16, 16, 5), "ugine_test_single.ktx") };
 
-    Vector<Image> copy{ images.Clone() };
-    UGINE_ASSERT(copy[0].Width() == 100);
-    UGINE_ASSERT(copy[0].Height() == 200);
-}
\ No newline at end of file
+    Image image;
+    ASSERT_TRUE(Image::FromMemoryEncoded(data.ToSpan(), image));
+    EXPECT_EQ(image.BaseMip(), 0u);
+    EXPECT_EQ(image.Mips(), 1u);
+    EXPECT_EQ(image.Width(), 16u);
+    EXPECT_EQ(image.GetMip(0, 0)[0], 0);
+}
@@ -0,0 +1,277 @@
+#include <gtest/gtest.h>
+
+#include <ugine/IoQueue.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace ugine;
+
+namespace {
+
+// In-memory files, reads block until Open so tests can queue requests behind busy worker.
+struct Files {
+    bool Read(const Path& path, Vector<u8>& data) {
+        const std::string name{ path.Data() };
+
+        std::unique_lock lock{ mutex };
+        ++entered;
+        cv.notify_all();
+        cv.wait(lock, [this] { return open; });
+
+        order.push_back(name);
+
+        const auto it{ files.find(name) };
+        if (it == files.end()) {
+            return false;
+        }
+        data = Vector<u8>{ reinterpret_cast<const u8*>(it->second.data()), it->second.size() };
+        return true;
+    }
+
+    void Open() {
+        std::lock_guard lock{ mutex };
+        open = true;
+        cv.notify_all();
+    }
+
+    void WaitEntered(u32 count) {
+        std::unique_lock lock{ mutex };
+        cv.wait(lock, [&] { return entered >= count; });
+    }
+
+    std::vector<std::string> Order() {
+        std::lock_guard lock{ mutex };
+        return order;
+    }
+
+    IoQueue::Reader Reader() {
+        return [files = this](const Path& path, Vector<u8>& data, Span<const u8>&) { return files->Read(path, data); };
+    }
+
+    std::map<std::string, std::string> files;
+    std::vector<std::string> order;
+    std::mutex mutex;
+    std::condition_variable cv;
+    u32 entered{};
+    bool open{};
+};
+
+// Some callbacks run on worker, calls are published last.
+struct Result {
+    std::string data;
+    bool success{};
+    std::atomic_int calls{};
+};
+
+IoQueue::Callback Store(Result& result) {
+    return [result = &result](IoData& data, bool success) {
+        result->success = success;
+        result->data.assign(reinterpret_cast<const char*>(data.Data().Data()), data.Size());
+        ++result->calls;
+    };
+}
+
+template <typename Pred> bool WaitFor(IoQueue& queue, Pred pred) {
+    for (int i{}; i < 2000; ++i) {
+        queue.SyncPoint();
+        if (pred()) {
+            return true;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return false;
+}
+
+} // namespace
+
+TEST(IoQueue, Read) {
+    Files files;
+    files.files = { { "a", "alpha" }, { "b", "beta" } };
+    files.Open();
+
+    IoQueue queue{ files.Reader(), 2 };
+
+    Result results[3];
+    queue.Submit(Path{ "a" }, Store(results[0]), false, IoPriority::Normal);
+    queue.Submit(Path{ "b" }, Store(results[1]), true, IoPriority::Critical);
+    queue.Submit(Path{ "missing" }, Store(results[2]), false, IoPriority::Background);
+
+    ASSERT_TRUE(WaitFor(queue, [&] { return results[0].calls + results[1].calls + results[2].calls == 3; }));
+
+    EXPECT_TRUE(results[0].success);
+    EXPECT_EQ("alpha", results[0].data);
+    EXPECT_TRUE(results[1].success);
+    EXPECT_EQ("beta", results[1].data);
+    EXPECT_FALSE(results[2].success);
+
+    const auto stats{ queue.GetStats() };
+    EXPECT_EQ(3u, stats.requests);
+    EXPECT_EQ(3u, stats.reads);
+}
+
+TEST(IoQueue, Priority) {
+    Files files;
+    IoQueue queue{ files.Reader(), 1 };
+
+    Result results[5];
+    queue.Submit(Path{ "busy" }, Store(results[0]), false, IoPriority::Normal);
+    files.WaitEntered(1);
+
+    queue.Submit(Path{ "background" }, Store(results[1]), false, IoPriority::Background);
+    queue.Submit(Path{ "normal" }, Store(results[2]), false, IoPriority::Normal);
+    queue.Submit(Path{ "critical" }, Store(results[3]), false, IoPriority::Critical);
+    // Duplicate of queued background read moves it behind other critical reads.
+    queue.Submit(Path{ "background" }, Store(results[4]), false, IoPriority::Critical);
+
+    const auto stats{ queue.GetStats() };
+    EXPECT_EQ(2u, stats.pending[u32(IoPriority::Critical)]);
+    EXPECT_EQ(1u, stats.pending[u32(IoPriority::Normal)]);
+    EXPECT_EQ(0u, stats.pending[u32(IoPriority::Background)]);
+    EXPECT_EQ(1u, stats.active);
+
+    files.Open();
+    ASSERT_TRUE(WaitFor(queue, [&] { return results[2].calls == 1; }));
+
+    const std::vector<std::string> expected{ "busy", "critical", "background", "normal" };
+    EXPECT_EQ(expected, files.Order());
+}
+
+TEST(IoQueue, Coalesce) {
+    Files files;
+    files.files = { { "shared", "data" } };
+    IoQueue queue{ files.Reader(), 1 };
+
+    Result busy;
+    queue.Submit(Path{ "busy" }, Store(busy), false, IoPriority::Normal);
+    files.WaitEntered(1);
+
+    Result results[3];
+    queue.Submit(Path{ "shared" }, Store(results[0]), false, IoPriority::Background);
+    queue.Submit(Path{ "shared" }, Store(results[1]), true, IoPriority::Normal);
+    queue.Submit(Path{ "shared" }, Store(results[2]), false, IoPriority::Normal);
+
+    files.Open();
+    ASSERT_TRUE(WaitFor(queue, [&] { return results[0].calls + results[1].calls + results[2].calls == 3; }));
+
+    for (const auto& result : results) {
+        EXPECT_TRUE(result.success);
+        EXPECT_EQ("data", result.data);
+    }
+
+    const auto stats{ queue.GetStats() };
+    EXPECT_EQ(4u, stats.requests);
+    EXPECT_EQ(2u, stats.reads);
+    EXPECT_EQ(2u, stats.coalesced);
+}
+
+TEST(IoQueue, Take) {
+    Files files;
+    files.files = { { "shared", "data" } };
+    IoQueue queue{ files.Reader(), 1 };
+
+    Result busy;
+    queue.Submit(Path{ "busy" }, Store(busy), false, IoPriority::Normal);
+    files.WaitEntered(1);
+
+    struct Taken {
+        IoData data;
+        bool moved{};
+        std::atomic_int calls{};
+    };
+
+    const auto take{ [](Taken& taken) {
+        return IoQueue::Callback{ [taken = &taken](IoData& data, bool) {
+            const auto buffer{ data.Data().Data() };
+            taken->data = data.Take();
+            taken->moved = taken->data.Data().Data() == buffer;
+            ++taken->calls;
+        } };
+    } };
+
+    // Worker callback runs first, then the others in submit order.
+    Taken taken[3];
+    queue.Submit(Path{ "shared" }, take(taken[0]), false, IoPriority::Normal);
+    queue.Submit(Path{ "shared" }, take(taken[1]), true, IoPriority::Normal);
+    queue.Submit(Path{ "shared" }, take(taken[2]), false, IoPriority::Normal);
+
+    files.Open();
+    ASSERT_TRUE(WaitFor(queue, [&] { return taken[0].calls + taken[1].calls + taken[2].calls == 3; }));
+
+    for (const auto& t : taken) {
+        EXPECT_EQ("data", std::string(reinterpret_cast<const char*>(t.data.Data().Data()), t.data.Size()));
+    }
+
+    // Only the last delivery gets the buffer without copy.
+    EXPECT_FALSE(taken[1].moved);
+    EXPECT_FALSE(taken[0].moved);
+    EXPECT_TRUE(taken[2].moved);
+}
+
+TEST(IoQueue, Cancel) {
+    Files files;
+    files.files = { { "a", "alpha" }, { "b", "beta" } };
+    IoQueue queue{ files.Reader(), 1 };
+
+    Result busy;
+    const auto busyRequest{ queue.Submit(Path{ "busy" }, Store(busy), false, IoPriority::Normal) };
+    files.WaitEntered(1);
+
+    Result results[3];
+    queue.Submit(Path{ "a" }, Store(results[0]), false, IoPriority::Normal);
+    const auto a{ queue.Submit(Path{ "a" }, Store(results[1]), false, IoPriority::Normal) };
+    const auto b{ queue.Submit(Path{ "b" }, Store(results[2]), false, IoPriority::Normal) };
+
+    queue.Cancel(a);
+    queue.Cancel(b);
+    queue.Cancel(busyRequest);
+    EXPECT_EQ(1u, queue.GetStats().pending[u32(IoPriority::Normal)]);
+
+    files.Open();
+    ASSERT_TRUE(WaitFor(queue, [&] { return results[0].calls == 1; }));
+    queue.SyncPoint();
+
+    EXPECT_EQ(0, busy.calls);
+    EXPECT_EQ(0, results[1].calls);
+    EXPECT_EQ(0, results[2].calls);
+
+    // Cancelled after read, before delivery.
+    Result late;
+    queue.Submit(Path{ "b" }, Store(late), false, IoPriority::Normal);
+    while (queue.GetStats().reads < 3) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    queue.CancelAll();
+    queue.SyncPoint();
+    EXPECT_EQ(0, late.calls);
+
+    const std::vector<std::string> expected{ "busy", "a", "b" };
+    EXPECT_EQ(expected, files.Order());
+}
+
+TEST(IoQueue, Promotion) {
+    Files files;
+    IoQueue queue{ files.Reader(), 1 };
+
+    Result results[3];
+    queue.Submit(Path{ "busy" }, Store(results[0]), false, IoPriority::Normal);
+    files.WaitEntered(1);
+
+    queue.Submit(Path{ "old" }, Store(results[1]), false, IoPriority::Background);
+    std::this_thread::sleep_for(IoQueue::PROMOTE_AFTER[u32(IoPriority::Background)] + IoQueue::PROMOTE_AFTER[u32(IoPriority::Normal)]
+        + std::chrono::milliseconds(50));
+    queue.Submit(Path{ "new" }, Store(results[2]), false, IoPriority::Normal);
+
+    files.Open();
+    ASSERT_TRUE(WaitFor(queue, [&] { return results[1].calls + results[2].calls == 2; }));
+
+    const std::vector<std::string> expected{ "busy", "old", "new" };
+    EXPECT_EQ(expected, files.Order());
+    EXPECT_EQ(2u, queue.GetStats().promoted);
+}
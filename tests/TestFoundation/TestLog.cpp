@@ -0,0 +1,126 @@
+#include <gtest/gtest.h>
+
+#include <ugine/Log.h>
+#include <ugine/String.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace ugine;
+
+namespace {
+
+std::mutex messagesMutex;
+std::vector<std::string> messages;
+
+void OnLog(LogLevel level, u64 millis, Span<const char> message) {
+    std::lock_guard lock{ messagesMutex };
+    messages.emplace_back(message.Data(), message.Size());
+}
+
+void Init() {
+    LoggerCallback callback;
+    callback.Connect<&OnLog>();
+    InitLogger(callback);
+}
+
+std::vector<std::string> TakeMessages() {
+    FlushLogger();
+
+    std::lock_guard lock{ messagesMutex };
+    return std::exchange(messages, {});
+}
+
+} // namespace
+
+TEST(Log, Arguments) {
+    Init();
+
+    std::string str{ "string" };
+    const String ugineStr{ "ugine" };
+    UGINE_INFO("{} {} {} {} {}", 42, 1.5f, str, ugineStr, "literal");
+
+    // Strings are copied by call site.
+    str = "changed";
+
+    // Single argument isn't format string.
+    UGINE_INFO("Not a {} format");
+
+    const auto logged{ TakeMessages() };
+    ASSERT_EQ(2, logged.size());
+    EXPECT_EQ("42 1.5 string ugine literal", logged[0]);
+    EXPECT_EQ("Not a {} format", logged[1]);
+}
+
+TEST(Log, Threads) {
+    constexpr u32 THREADS{ 4 };
+    constexpr u32 COUNT{ 10'000 };
+
+    Init();
+    const auto before{ GetLogStats() };
+
+    std::vector<std::thread> threads;
+    for (u32 t{}; t < THREADS; ++t) {
+        threads.emplace_back([t] {
+            for (u32 i{}; i < COUNT; ++i) {
+                UGINE_INFO("{} {}", t, i);
+            }
+        });
+    }
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    auto logged{ TakeMessages() };
+    const auto stats{ GetLogStats() };
+
+    // Drop reports.
+    std::erase_if(logged, [](const auto& message) { return message.starts_with("Log buffer full"); });
+
+    // Full buffers drop records, all others are written in order per thread.
+    EXPECT_EQ(THREADS * COUNT, stats.written + stats.dropped - before.written - before.dropped);
+    EXPECT_EQ(stats.written - before.written, logged.size());
+
+    std::vector<i64> last(THREADS, -1);
+    for (const auto& message : logged) {
+        u32 t{};
+        u32 i{};
+        ASSERT_EQ(2, sscanf(message.c_str(), "%u %u", &t, &i));
+        ASSERT_LT(t, THREADS);
+        ASSERT_LT(last[t], i64(i));
+        last[t] = i;
+    }
+}
+
+TEST(Log, FlushOnCrash) {
+    Init();
+    UGINE_INFO("before crash {}", 1);
+
+    // Crash handlers don't wait on logger thread indefinitely, records are written well within the timeout.
+    FlushLoggerOnCrash();
+
+    std::lock_guard lock{ messagesMutex };
+    ASSERT_EQ(1, messages.size());
+    EXPECT_EQ("before crash 1", messages[0]);
+    messages.clear();
+}
+
+TEST(Log, Shutdown) {
+    Init();
+    UGINE_INFO("async");
+
+    ShutdownLogger();
+    UGINE_INFO("sync {}", 1);
+
+    // Pending records are written by shutdown, later ones immediately.
+    std::lock_guard lock{ messagesMutex };
+    ASSERT_EQ(2, messages.size());
+    EXPECT_EQ("async", messages[0]);
+    EXPECT_EQ("sync 1", messages[1]);
+    messages.clear();
+}
@@ -0,0 +1,97 @@
+#include <gtest/gtest.h>
+
+#include <ugine/Metrics.h>
+
+#include <sstream>
+#include <thread>
+#include <vector>
+
+using namespace ugine;
+
+TEST(Metrics, Counter) {
+    constexpr u32 THREADS{ 4 };
+    constexpr u32 COUNT{ 10'000 };
+
+    const MetricCounter counter{ "test.counter" };
+    Metrics::Collect();
+
+    // Shards of exited threads are kept.
+    std::vector<std::thread> threads;
+    for (u32 t{}; t < THREADS; ++t) {
+        threads.emplace_back([] {
+            for (u32 i{}; i < COUNT; ++i) {
+                UGINE_COUNTER_INC("test.counter");
+            }
+        });
+    }
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    counter.Add(5);
+    Metrics::Collect();
+
+    const auto value{ Metrics::Find("test.counter") };
+    ASSERT_NE(nullptr, value);
+    EXPECT_EQ(MetricType::Counter, value->type);
+    EXPECT_EQ(THREADS * COUNT + 5, value->value);
+    EXPECT_EQ(THREADS * COUNT + 5, value->frame);
+
+    Metrics::Collect();
+    EXPECT_EQ(THREADS * COUNT + 5, Metrics::Find("test.counter")->value);
+    EXPECT_EQ(0, Metrics::Find("test.counter")->frame);
+}
+
+TEST(Metrics, Gauge) {
+    UGINE_GAUGE_SET("test.gauge", 42);
+    UGINE_GAUGE_SET("test.gauge", -7);
+    Metrics::Collect();
+
+    EXPECT_EQ(-7, Metrics::Find("test.gauge")->value);
+}
+
+TEST(Metrics, Histogram) {
+    for (u32 i{ 1 }; i <= 1000; ++i) {
+        UGINE_HISTOGRAM_RECORD("test.histogram", i);
+    }
+    Metrics::Collect();
+
+    const auto value{ Metrics::Find("test.histogram") };
+    ASSERT_NE(nullptr, value);
+    EXPECT_EQ(1000u, value->count);
+    EXPECT_EQ(1000, value->frame);
+    EXPECT_DOUBLE_EQ(500.5, value->mean);
+    EXPECT_EQ(1000u, value->max);
+
+    // Upper bounds of log2 buckets.
+    EXPECT_EQ(511u, value->p50);
+    EXPECT_EQ(1000u, value->p90);
+    EXPECT_EQ(1000u, value->p99);
+}
+
+TEST(Metrics, Disabled) {
+    const MetricCounter counter{ "test.disabled" };
+
+    Metrics::SetEnabled(false);
+    counter.Add();
+    Metrics::SetEnabled(true);
+    counter.Add();
+
+    Metrics::Collect();
+    EXPECT_EQ(1, Metrics::Find("test.disabled")->value);
+}
+
+TEST(Metrics, Dump) {
+    UGINE_COUNTER_ADD("test.dump", 3);
+    Metrics::Collect();
+
+    std::ostringstream csv;
+    Metrics::WriteCsvHeader(csv);
+    Metrics::WriteCsv(csv, 1.0);
+    EXPECT_NE(std::string::npos, csv.str().find("1.000,test.dump,counter,,3,3"));
+
+    std::ostringstream json;
+    Metrics::WriteJson(json, 1.0);
+    EXPECT_NE(std::string::npos, json.str().find("{\"name\":\"test.dump\",\"type\":\"counter\",\"value\":3,\"frame\":3}"));
+}
@@ -0,0 +1,260 @@
+#include <gtest/gtest.h>
+
+#include <ugine/FileSystem.h>
+#include <ugine/Lz.h>
+#include <ugine/Pak.h>
+
+#include <cstddef>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+#include <thread>
+
+using namespace ugine;
+
+namespace {
+
+Vector<u8> RandomBytes(size_t size, u32 seed) {
+    std::mt19937 rng{ seed };
+    Vector<u8> data(size);
+    for (auto& b : data) {
+        b = u8(rng());
+    }
+    return data;
+}
+
+Vector<u8> Text(size_t size) {
+    static constexpr char WORDS[]{ "lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor " };
+
+    Vector<u8> data(size);
+    for (size_t i{}; i < size; ++i) {
+        data[i] = u8(WORDS[(i * 7 / 5) % (sizeof(WORDS) - 1)]);
+    }
+    return data;
+}
+
+Vector<u8> RoundTrip(const Vector<u8>& data, size_t& compressedSize) {
+    Vector<u8> compressed(lz::CompressBound(data.Size()));
+    compressedSize = lz::Compress(data.ToSpan(), compressed.ToSpan());
+
+    Vector<u8> result(data.Size());
+    EXPECT_TRUE(lz::Decompress(Span<const u8>{ compressed.Data(), compressedSize }, result.ToSpan()));
+    return result;
+}
+
+bool Equal(Span<const u8> a, Span<const u8> b) {
+    return a.Size() == b.Size() && (a.Empty() || memcmp(a.Data(), b.Data(), a.Size()) == 0);
+}
+
+Path TempPak(const char* name) {
+    return Path{ (std::filesystem::temp_directory_path() / name).string() };
+}
+
+} // namespace
+
+TEST(Lz, RoundTrip) {
+    for (const auto size : { 0u, 1u, 5u, 12u, 13u, 100u, 4096u, 200'000u }) {
+        size_t compressedSize{};
+
+        const auto text{ Text(size) };
+        EXPECT_TRUE(Equal(text.ToSpan(), RoundTrip(text, compressedSize).ToSpan())) << size;
+        if (size >= 4096) {
+            EXPECT_LT(compressedSize, size / 4);
+        }
+
+        const auto random{ RandomBytes(size, size) };
+        EXPECT_TRUE(Equal(random.ToSpan(), RoundTrip(random, compressedSize).ToSpan())) << size;
+        EXPECT_LE(compressedSize, lz::CompressBound(size));
+
+        // Overlapping matches.
+        Vector<u8> zeros(size);
+        EXPECT_TRUE(Equal(zeros.ToSpan(), RoundTrip(zeros, compressedSize).ToSpan())) << size;
+    }
+}
+
+TEST(Lz, Malformed) {
+    const auto text{ Text(10'000) };
+
+    Vector<u8> compressed(lz::CompressBound(text.Size()));
+    const auto size{ lz::Compress(text.ToSpan(), compressed.ToSpan()) };
+    ASSERT_GT(size, 0u);
+
+    // Too small output.
+    Vector<u8> small(100);
+    EXPECT_EQ(0u, lz::Compress(text.ToSpan(), small.ToSpan()));
+
+    Vector<u8> result(text.Size());
+    EXPECT_FALSE(lz::Decompress(Span<const u8>{ compressed.Data(), size - 1 }, result.ToSpan()));
+    EXPECT_FALSE(lz::Decompress(Span<const u8>{ compressed.Data(), size }, Span<u8>{ result.Data(), result.Size() - 1 }));
+
+    // Offset pointing before output.
+    const u8 invalid[]{ 0x10, 'a', 0x10, 0x00, 0x00 };
+    EXPECT_FALSE(lz::Decompress(Span<const u8>{ invalid, sizeof(invalid) }, result.ToSpan()));
+}
+
+TEST(Pak, WriteRead) {
+    const auto path{ TempPak("ugine_test.pak") };
+
+    const auto text{ Text(50'000) };
+    const auto random{ RandomBytes(10'000, 1) };
+
+    {
+        PakWriter writer{ path };
+        ASSERT_TRUE(writer.Good());
+        EXPECT_TRUE(writer.Add("textures/Text.txt", text.ToSpan(), true));
+        EXPECT_TRUE(writer.Add("random.bin", random.ToSpan(), true));
+        EXPECT_TRUE(writer.Add("empty", Span<const u8>{}, false));
+        EXPECT_FALSE(writer.Add("./Random.bin", random.ToSpan(), false));
+        EXPECT_TRUE(writer.Finish());
+    }
+
+    auto pak{ PakArchive::Open(path) };
+    ASSERT_TRUE(pak);
+    EXPECT_EQ(3u, pak->Entries().Size());
+
+    const auto textEntry{ pak->Find("Textures\\text.TXT") };
+    ASSERT_NE(nullptr, textEntry);
+    EXPECT_EQ(PakCompression::Lz4, textEntry->compression);
+    EXPECT_LT(textEntry->storedSize, textEntry->size);
+    const auto name{ pak->Name(*textEntry) };
+    EXPECT_EQ("textures/text.txt", std::string(name.Data(), name.Size()));
+
+    Vector<u8> data;
+    EXPECT_TRUE(pak->Read(*textEntry, data));
+    EXPECT_TRUE(Equal(text.ToSpan(), data.ToSpan()));
+
+    // Incompressible data is stored.
+    const auto randomEntry{ pak->Find("/random.bin") };
+    ASSERT_NE(nullptr, randomEntry);
+    EXPECT_EQ(PakCompression::None, randomEntry->compression);
+    EXPECT_EQ(0u, randomEntry->offset % PakHeader::ALIGNMENT);
+    EXPECT_TRUE(Equal(random.ToSpan(), pak->Stored(*randomEntry)));
+
+    const auto emptyEntry{ pak->Find("empty") };
+    ASSERT_NE(nullptr, emptyEntry);
+    EXPECT_TRUE(pak->Read(*emptyEntry, data));
+    EXPECT_TRUE(data.Empty());
+
+    EXPECT_EQ(nullptr, pak->Find("missing"));
+    EXPECT_EQ(nullptr, pak->Find("textures"));
+
+    pak = nullptr;
+    std::filesystem::remove(path.Data());
+}
+
+TEST(Pak, Invalid) {
+    const auto path{ TempPak("ugine_test_invalid.pak") };
+
+    {
+        PakWriter writer{ path };
+        writer.Add("a", Text(1000).ToSpan(), false);
+        writer.Finish();
+    }
+
+    // Truncated index.
+    std::filesystem::resize_file(path.Data(), std::filesystem::file_size(path.Data()) - 8);
+    EXPECT_FALSE(PakArchive::Open(path));
+
+    EXPECT_FALSE(PakArchive::Open(TempPak("ugine_missing.pak")));
+
+    std::filesystem::remove(path.Data());
+}
+
+TEST(Pak, OversizedEntry) {
+    const auto path{ TempPak("ugine_test_oversized.pak") };
+
+    {
+        PakWriter writer{ path };
+        writer.Add("a", Text(10'000).ToSpan(), true);
+        writer.Finish();
+    }
+
+    PakHeader header{};
+    {
+        std::ifstream file{ path.Data(), std::ios::binary };
+        file.read(reinterpret_cast<char*>(&header), sizeof(header));
+    }
+
+    const auto patchSize{ [&](u64 size) {
+        std::fstream file{ path.Data(), std::ios::binary | std::ios::in | std::ios::out };
+        file.seekp(header.indexOffset + offsetof(PakEntry, size));
+        file.write(reinterpret_cast<const char*>(&size), sizeof(size));
+    } };
+
+    // Rejected on open, decode would allocate uncompressed size first.
+    patchSize(PakHeader::MAX_ENTRY_SIZE + 1);
+    EXPECT_FALSE(PakArchive::Open(path));
+
+    patchSize(1'000'000'000);
+    EXPECT_FALSE(PakArchive::Open(path));
+
+    patchSize(10'000);
+    EXPECT_TRUE(PakArchive::Open(path));
+
+    std::filesystem::remove(path.Data());
+}
+
+TEST(Pak, FileSystem) {
+    const auto path{ TempPak("ugine_test_fs.pak") };
+
+    const auto text{ Text(100'000) };
+    const auto random{ RandomBytes(100'000, 2) };
+
+    {
+        PakWriter writer{ path };
+        writer.Add("text", text.ToSpan(), true);
+        writer.Add("random", random.ToSpan(), true);
+        writer.Finish();
+    }
+
+    auto fs{ FileSystem::CreatePak(path) };
+    ASSERT_TRUE(fs);
+    EXPECT_TRUE(fs->ReadOnly());
+    EXPECT_FALSE(fs->Write(Path{ "text" }, text.ToSpan()));
+
+    Vector<u8> data;
+    EXPECT_TRUE(fs->Read(Path{ "text" }, data));
+    EXPECT_TRUE(Equal(text.ToSpan(), data.ToSpan()));
+    EXPECT_FALSE(fs->Read(Path{ "missing" }, data));
+
+    // Only stored entries are mapped directly.
+    Span<const u8> view;
+    EXPECT_FALSE(fs->ReadView(Path{ "text" }, view));
+    EXPECT_TRUE(fs->ReadView(Path{ "random" }, view));
+    EXPECT_TRUE(Equal(random.ToSpan(), view));
+
+    struct Result {
+        Span<const u8> expected;
+        int calls{};
+        bool success{};
+        bool equal{};
+    };
+
+    Result results[3]{ { text.ToSpan() }, { random.ToSpan() }, {} };
+    const char* names[3]{ "text", "random", "missing" };
+
+    for (int i{}; i < 3; ++i) {
+        fs->ReadAsync(Path{ names[i] }, [result = &results[i]](IoData& data, bool success) {
+            ++result->calls;
+            result->success = success;
+            result->equal = Equal(result->expected, data.Data());
+        });
+    }
+
+    for (int i{}; i < 1000 && results[0].calls + results[1].calls + results[2].calls < 3; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        fs->SyncPoint();
+    }
+
+    EXPECT_EQ(1, results[0].calls);
+    EXPECT_TRUE(results[0].success && results[0].equal);
+    EXPECT_EQ(1, results[1].calls);
+    EXPECT_TRUE(results[1].success && results[1].equal);
+    EXPECT_EQ(1, results[2].calls);
+    EXPECT_FALSE(results[2].success);
+
+    fs = nullptr;
+    std::filesystem::remove(path.Data());
+}
@@ -1,6 +1,11 @@
 #include <gtest/gtest.h>
 
 #include <ugine/String.h>
+#include <ugine/StringTable.h>
+
+#include <string>
+#include <thread>
+#include <vector>
 
 using namespace ugine;
 
@@ -110,3 +115,71 @@ TEST(String, StringView) {
     StringView sv3{ text1, 2 };
     ASSERT_EQ(2, sv3.Size());
 }
+
+TEST(StringTable, Intern) {
+    StringTable table;
+
+    const std::string name{ "Armature" };
+    const auto id{ table.Intern(name) };
+    ASSERT_EQ(StringID{ name.c_str() }, id);
+    ASSERT_TRUE(table.Contains(id));
+    ASSERT_EQ(name.size(), table.Lookup(id).Size());
+    ASSERT_STREQ(name.c_str(), table.Lookup(id).Data());
+
+    // Interning again doesn't store the string twice.
+    ASSERT_EQ(id, table.Intern(std::string{ "Armature" }));
+    ASSERT_EQ(1, table.GetStats().strings);
+
+    const StringID hashed{ "NotInterned" };
+    ASSERT_FALSE(table.Contains(hashed));
+    ASSERT_TRUE(table.Lookup(hashed).Empty());
+}
+
+TEST(StringTable, Grow) {
+    StringTable table;
+
+    constexpr u32 COUNT{ StringTable::INITIAL_CAPACITY * 8 };
+    for (u32 i{}; i < COUNT; ++i) {
+        table.Intern("Bone_" + std::to_string(i));
+    }
+
+    const auto stats{ table.GetStats() };
+    ASSERT_EQ(COUNT, stats.strings);
+    ASSERT_GE(stats.capacity, COUNT * 2);
+
+    for (u32 i{}; i < COUNT; ++i) {
+        const auto name{ "Bone_" + std::to_string(i) };
+        ASSERT_STREQ(name.c_str(), table.Lookup(StringID{ name.c_str() }).Data());
+    }
+}
+
+TEST(StringTable, Concurrent) {
+    StringTable table;
+
+    constexpr u32 THREADS{ 4 };
+    constexpr u32 COUNT{ 10'000 };
+
+    // All threads intern the same names while others look them up.
+    std::vector<std::thread> threads;
+    for (u32 t{}; t < THREADS; ++t) {
+        threads.emplace_back([&] {
+            for (u32 i{}; i < COUNT; ++i) {
+                const auto name{ "Node_" + std::to_string(i) };
+                const auto id{ table.Intern(name) };
+                ASSERT_STREQ(name.c_str(), table.Lookup(id).Data());
+            }
+        });
+    }
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    ASSERT_EQ(COUNT, table.GetStats().strings);
+}
+
+TEST(StringTable, Global) {
+    const auto id{ StringID::Intern("GlobalName") };
+    ASSERT_STREQ("GlobalName", id.Name().Data());
+    ASSERT_TRUE(StringID{ "OnlyHashed" }.Name().Empty());
+}
@@ -0,0 +1,178 @@
+#include <gtest/gtest.h>
+
+#include <ugine/File.h>
+#include <ugine/Image.h>
+#include <ugine/Scheduler.h>
+#include <ugine/TextureBuilder.h>
+
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <random>
+
+using namespace ugine;
+
+namespace {
+
+Image RandomImage(u32 width, u32 height, u32 seed) {
+    std::mt19937 rng{ seed };
+
+    Image image{ width, height, 4, 1 };
+    auto data{ image.GetMip(0, 0) };
+    for (auto& b : data) {
+        b = u8(rng());
+    }
+    return image;
+}
+
+bool Equal(Span<const u8> a, Span<const u8> b) {
+    return a.Size() == b.Size() && memcmp(a.Data(), b.Data(), a.Size()) == 0;
+}
+
+} // namespace
+
+TEST(TextureBuilder, FullMipCount) {
+    EXPECT_EQ(FullMipCount(1, 1), 1u);
+    EXPECT_EQ(FullMipCount(2, 1), 2u);
+    EXPECT_EQ(FullMipCount(256, 256), 9u);
+    EXPECT_EQ(FullMipCount(255, 256), 9u);
+    EXPECT_EQ(FullMipCount(257, 3), 9u);
+    EXPECT_EQ(FullMipCount(300, 200), 9u);
+    EXPECT_EQ(FullMipCount(1, 64), 7u);
+    EXPECT_EQ(FullMipCount(5, 3), 3u);
+}
+
+TEST(TextureBuilder, MipExtents) {
+    auto image{ RandomImage(300, 200, 1) };
+    ASSERT_TRUE(GenerateMips(image, TextureBuildSettings{}));
+    ASSERT_EQ(image.Mips(), 9u);
+
+    const u32 widths[]{ 300, 150, 75, 37, 18, 9, 4, 2, 1 };
+    const u32 heights[]{ 200, 100, 50, 25, 12, 6, 3, 1, 1 };
+    for (u32 mip{}; mip < image.Mips(); ++mip) {
+        SCOPED_TRACE(mip);
+        EXPECT_EQ(image.MipWidth(mip), widths[mip]);
+        EXPECT_EQ(image.MipHeight(mip), heights[mip]);
+        EXPECT_EQ(image.GetMip(0, mip).Size(), widths[mip] * heights[mip] * 4);
+    }
+
+    auto tall{ RandomImage(3, 17, 2) };
+    ASSERT_TRUE(GenerateMips(tall, TextureBuildSettings{}));
+    ASSERT_EQ(tall.Mips(), 5u);
+    EXPECT_EQ(tall.MipWidth(4), 1u);
+    EXPECT_EQ(tall.MipHeight(4), 1u);
+    EXPECT_EQ(tall.MipWidth(1), 1u);
+    EXPECT_EQ(tall.MipHeight(1), 8u);
+
+    auto single{ RandomImage(8, 8, 3) };
+    ASSERT_TRUE(GenerateMips(single, TextureBuildSettings{ .mips = false }));
+    EXPECT_EQ(single.Mips(), 1u);
+}
+
+TEST(TextureBuilder, SrgbMipsAverageInLinearSpace) {
+    // Black and white checker, alpha opaque.
+    Image image{ 2, 2, 4, 1 };
+    const u8 texels[]{
+        0, 0, 0, 255, 255, 255, 255, 255, //
+        255, 255, 255, 255, 0, 0, 0, 255, //
+    };
+    image.CopyData(0, Span<const u8>{ texels, sizeof(texels) });
+
+    auto srgb{ image };
+    ASSERT_TRUE(GenerateMips(srgb, TextureBuildSettings{ .srgb = true }));
+    ASSERT_EQ(srgb.Mips(), 2u);
+    for (u32 c{}; c < 3; ++c) {
+        EXPECT_EQ(srgb.GetMip(0, 1)[c], 188);
+    }
+    EXPECT_EQ(srgb.GetMip(0, 1)[3], 255);
+
+    auto linear{ image };
+    ASSERT_TRUE(GenerateMips(linear, TextureBuildSettings{ .srgb = false }));
+    for (u32 c{}; c < 3; ++c) {
+        EXPECT_EQ(linear.GetMip(0, 1)[c], 128);
+    }
+}
+
+TEST(TextureBuilder, NormalMapMipsAreUnitLength) {
+    auto image{ RandomImage(64, 32, 4) };
+    ASSERT_TRUE(GenerateMips(image, TextureBuildSettings{ .srgb = false, .normalMap = true }));
+
+    for (u32 mip{ 1 }; mip < image.Mips(); ++mip) {
+        const auto data{ image.GetMip(0, mip) };
+        for (size_t i{}; i < data.Size(); i += 4) {
+            f32 length{};
+            for (u32 c{}; c < 3; ++c) {
+                const auto v{ data[i + c] / 255.0f * 2.0f - 1.0f };
+                length += v * v;
+            }
+
+            // Quantization to 8 bits per channel.
+            EXPECT_NEAR(std::sqrt(length), 1.0f, 0.02f);
+        }
+    }
+}
+
+TEST(TextureBuilder, GenerateMipsWithScheduler) {
+    Scheduler scheduler{ 4 };
+
+    auto serial{ RandomImage(123, 77, 5) };
+    auto parallel{ serial };
+    ASSERT_TRUE(GenerateMips(serial, TextureBuildSettings{}));
+    ASSERT_TRUE(GenerateMips(parallel, TextureBuildSettings{}, &scheduler));
+
+    ASSERT_EQ(serial.Mips(), parallel.Mips());
+    for (u32 mip{}; mip < serial.Mips(); ++mip) {
+        EXPECT_TRUE(Equal(serial.GetMip(0, mip), parallel.GetMip(0, mip)));
+    }
+}
+
+TEST(TextureBuilder, CompressBlockSizes) {
+    for (const auto format : { Image::Format::BC1, Image::Format::BC3, Image::Format::BC5 }) {
+        SCOPED_TRACE(ToString(format));
+
+        // Odd extents, the last mips are smaller than a block.
+        auto image{ RandomImage(13, 7, 6) };
+        ASSERT_TRUE(GenerateMips(image, TextureBuildSettings{}));
+        const auto mips{ image.Mips() };
+
+        ASSERT_TRUE(CompressImage(image, format));
+        EXPECT_EQ(image.GetFormat(), format);
+        EXPECT_TRUE(image.IsCompressed());
+        ASSERT_EQ(image.Mips(), mips);
+
+        for (u32 mip{}; mip < mips; ++mip) {
+            SCOPED_TRACE(mip);
+            const auto size{ Image::DataSize(format, image.MipWidth(mip), image.MipHeight(mip)) };
+            EXPECT_EQ(image.GetMip(0, mip).Size(), size);
+            if (image.MipWidth(mip) < 4 && image.MipHeight(mip) < 4) {
+                EXPECT_EQ(size, Image::BlockBytes(format));
+            }
+        }
+
+        // Already compressed.
+        EXPECT_FALSE(CompressImage(image, format));
+        EXPECT_FALSE(GenerateMips(image, TextureBuildSettings{}));
+    }
+}
+
+TEST(TextureBuilder, KtxRoundTrip) {
+    auto image{ RandomImage(20, 12, 7) };
+    ASSERT_TRUE(BuildTexture(image, TextureBuildSettings{ .format = Image::Format::BC3 }));
+
+    const Path path{ (std::filesystem::temp_directory_path() / "ugine_test_builder.ktx").string() };
+    ASSERT_TRUE(image.Save(path));
+    const auto data{ ReadFileBinary(path) };
+    std::filesystem::remove(path.Data());
+
+    Image loaded;
+    ASSERT_TRUE(Image::FromMemoryEncoded(data.ToSpan(), loaded, 1024));
+    EXPECT_EQ(loaded.GetFormat(), Image::Format::BC3);
+    EXPECT_EQ(loaded.Width(), 20u);
+    EXPECT_EQ(loaded.Height(), 12u);
+    EXPECT_EQ(loaded.BaseMip(), 0u);
+    ASSERT_EQ(loaded.Mips(), image.Mips());
+
+    for (u32 mip{}; mip < image.Mips(); ++mip) {
+        EXPECT_TRUE(Equal(loaded.GetMip(0, mip), image.GetMip(0, mip)));
+    }
+}
@@ -0,0 +1,91 @@
+#include <ugine/File.h>
+#include <ugine/Pak.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <format>
+#include <iostream>
+#include <string>
+#include <vector>
+
+inline void Usage(const char* name) {
+    std::cerr << "Usage " << name << " <input_dir> <output_pak> [-c] [-V]\n";
+    std::cerr << "\t-c \t\tCompress entries (kept stored if it doesn't pay off).\n";
+    std::cerr << "\t-V \t\tVerbose.\n";
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 3) {
+        ::Usage(argv[0]);
+        return -1;
+    }
+
+    const std::filesystem::path inputDir{ argv[1] };
+    const ugine::Path outputFile{ argv[2] };
+
+    bool compress{};
+    bool verbose{};
+    for (int i{ 3 }; i < argc; ++i) {
+        if (strcmp(argv[i], "-c") == 0) {
+            compress = true;
+        } else if (strcmp(argv[i], "-V") == 0) {
+            verbose = true;
+        } else {
+            std::cerr << std::format("Unknown argument '{}'\n", argv[i]);
+            ::Usage(argv[0]);
+            return -1;
+        }
+    }
+
+    const auto start{ std::chrono::high_resolution_clock::now() };
+
+    try {
+        // Sorted for reproducible archives.
+        std::vector<std::filesystem::path> files;
+        for (const auto& entry : std::filesystem::recursive_directory_iterator{ inputDir }) {
+            if (entry.is_regular_file()) {
+                files.push_back(entry.path());
+            }
+        }
+        std::sort(files.begin(), files.end());
+
+        ugine::PakWriter writer{ outputFile };
+        if (!writer.Good()) {
+            std::cerr << std::format("Failed to create '{}'\n", outputFile.Data());
+            return -1;
+        }
+
+        u64 inputSize{};
+        for (const auto& file : files) {
+            const auto name{ std::filesystem::relative(file, inputDir).generic_string() };
+            const auto data{ ugine::ReadFileBinary(ugine::Path{ file.string() }) };
+
+            if (!writer.Add(name, data.ToSpan(), compress)) {
+                std::cerr << std::format("Failed to add '{}'\n", name);
+                return -1;
+            }
+
+            inputSize += data.Size();
+
+            if (verbose) {
+                std::cout << std::format("  {} ({} B)\n", name, data.Size());
+            }
+        }
+
+        const auto dataSize{ writer.DataSize() };
+        if (!writer.Finish()) {
+            std::cerr << std::format("Failed to write '{}'\n", outputFile.Data());
+            return -1;
+        }
+
+        const auto seconds{ std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count() };
+        std::cout << std::format("Packed {} files, {:.2f} MB => {:.2f} MB in {:.2f} s\n", files.size(), inputSize / 1e6, dataSize / 1e6, seconds);
+    } catch (const std::exception& ex) {
+        std::cerr << ex.what() << "\n";
+        return -1;
+    }
+
+    return 0;
+}
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <filesystem>
 #include <map>
 #include <string>
@@ -19,6 +20,21 @@ public:
         bool generateDebugInfo{};
         bool verbose{};
         bool saveSteps{};
+
+        // Derived data cache, default location if empty. Saving steps always compiles.
+        bool useCache{ true };
+        std::filesystem::path cacheDir;
+
+        // Variant compilation workers, hardware concurrency if 0.
+        uint32_t threads{};
+    };
+
+    // Counts of the last build, zero when the whole shader came from cache.
+    struct Stats {
+        size_t variants{};
+        size_t stages{};
+        size_t compiles{};       // Unique preprocessed stage sources (with and without debug info).
+        size_t cachedCompiles{};
     };
 
     struct ShaderError {
@@ -34,8 +50,12 @@ public:
 
     const std::string& Error() const { return error_; }
     const std::vector<ShaderError>& ShaderErrors() const { return shaderErrors_; }
+    bool CacheHit() const { return cacheHit_; }
+    const Stats& GetStats() const { return stats_; }
 
 private:
     std::string error_;
+    bool cacheHit_{};
+    Stats stats_{};
     std::vector<ShaderError> shaderErrors_;
 };
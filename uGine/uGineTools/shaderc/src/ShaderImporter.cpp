@@ -10,21 +10,31 @@
 
 #include <ugine/engine/gfx/asset/SerializedShader.h>
 
+#include <ugine/DerivedDataCache.h>
 #include <ugine/File.h>
 #include <ugine/Hash.h>
 #include <ugine/Permutations.h>
+#include <ugine/Scheduler.h>
 #include <ugine/StringUtils.h>
+#include <ugine/Thread.h>
 
+#include <algorithm>
 #include <filesystem>
 #include <format>
 #include <iostream>
+#include <map>
 #include <optional>
+#include <set>
+#include <sstream>
 
 using namespace ugine;
 using namespace ugine::gfxapi;
 
 using VertexAttributes = std::vector<SerializedVertexAttribute>;
 
+// Bump when compiled output changes for the same sources, invalidates cached shaders.
+constexpr u32 SHADERC_VERSION{ 1 };
+
 bool ParseShaderStageParams(const std::vector<u8>& shader, ShaderStage stage, SerializedShaderStage& params, VertexAttributes& vertexAttributes) {
     SpirvParser parser{};
     parser.Parse(shader.data(), shader.size(), ugine::gfxapi::ToVulkan(stage));
@@ -88,8 +98,7 @@ bool ParseShaderStageParams(const std::vector<u8>& shader, ShaderStage stage, Se
 }
 
 bool CompileShaderStage(
-    const SpirvCompiler::Options& compileOptions, const ShaderImporter::Options& importOptions, std::vector<u8>& output, ShaderImporter::ShaderError& error) {
-    SpirvHlslCompiler compiler{};
+    const SpirvCompiler::Options& compileOptions, const ShaderImporter::Options& importOptions, SpirvHlslCompiler& compiler, ShaderImporter::ShaderError& error) {
     const auto result{ compiler.Compile(compileOptions) };
 
     if (!result) {
@@ -101,45 +110,54 @@ bool CompileShaderStage(
         error.shaderProcessedSource = compiler.Preprocessed();
 
         if (importOptions.verbose) {
-            std::cerr << std::format("Compilation error: {} on line {}\n", compiler.Error(), compiler.ErrorLine());
+            std::ostringstream out;
+            out << std::format("Compilation error: {} on line {}\n", compiler.Error(), compiler.ErrorLine());
             std::istringstream iss{ compileOptions.source };
             int lineNo{ 1 };
             for (std::string line; std::getline(iss, line); ++lineNo) {
                 if (lineNo >= compiler.ErrorLine() - 5 && lineNo <= compiler.ErrorLine() + 5) {
-                    std::cerr << std::format("{}[{:04}] {}", compiler.ErrorLine() == lineNo ? ">" : " ", lineNo, line);
+                    out << std::format("{}[{:04}] {}", compiler.ErrorLine() == lineNo ? ">" : " ", lineNo, line);
                 }
             }
+            // Stages compile on several threads, whole report at once.
+            std::cerr << out.str();
         }
         return false;
     }
 
-    output = compiler.Compiled();
-
     return true;
 }
 
-bool ParseShaderStageParams(const SpirvCompiler::Options& compilerOptions, const ShaderImporter::Options& importOptions, SerializedShaderStage& variantStage,
-    VertexAttributes& vertexAttributes, ShaderImporter::ShaderError& error) {
-    auto debugCompilerOptions{ compilerOptions };
-    debugCompilerOptions.debugInfo = true;
-
-    std::vector<u8> withDebug;
-    if (!CompileShaderStage(debugCompilerOptions, importOptions, withDebug, error)) {
-        return false;
-    }
-
-    return ParseShaderStageParams(withDebug, compilerOptions.stage, variantStage, vertexAttributes);
-}
-
-bool CompileVariantStage(const ShaderImporter::Options& options, gfxapi::ShaderStage shaderStage, const std::filesystem::path& inputFile,
-    std::string_view entryPoint, SerializedShaderVariant& variant, ShaderImporter::ShaderError& error) {
+// Stage of a single variant, stages with equal preprocessed source share their compilations.
+struct VariantStage {
+    size_t variant{};
+    SpirvCompiler::Options options;
+    std::string preprocessed;
+    bool preprocessFailed{};
+    ShaderImporter::ShaderError error;
+
+    size_t reflectCompile{}; // With debug info, reflection needs names.
+    size_t compile{};
+};
+
+struct StageCompile {
+    SpirvCompiler::Options options;
+    DerivedDataCache::Key key;
+    std::vector<u8> spirv;
+    bool cached{};
+    bool failed{};
+    ShaderImporter::ShaderError error;
+};
+
+bool StageCompilerOptions(const ShaderImporter::Options& options, gfxapi::ShaderStage shaderStage, const std::filesystem::path& inputFile,
+    std::string_view entryPoint, const std::vector<std::string>& defines, std::map<std::string, std::string>& sources, SpirvCompiler::Options& compilerOptions,
+    ShaderImporter::ShaderError& error) {
 
     Path input{ inputFile.string() };
     if (input.IsRelative()) {
         input = Path{ options.inputFile.parent_path().string() } / inputFile.string();
     }
 
-    SpirvCompiler::Options compilerOptions{};
     compilerOptions.debugInfo = true; // TODO:
     compilerOptions.entryPoint = entryPoint;
     compilerOptions.sourceFile = input.Data();
@@ -150,7 +168,13 @@ bool CompileVariantStage(const ShaderImporter::Options& options, gfxapi::ShaderS
 
     compilerOptions.includeSearchDirs.push_back(input.ParentPath().Data());
 
-    compilerOptions.source = ugine::ReadFile(input);
+    // All variants share stage sources, read once.
+    auto source{ sources.find(input.Data()) };
+    if (source == sources.end()) {
+        source = sources.emplace(input.Data(), ugine::ReadFile(input)).first;
+    }
+
+    compilerOptions.source = source->second;
     if (compilerOptions.source.empty()) {
         error.filename = input.Data();
         error.message = "File not found";
@@ -161,39 +185,23 @@ bool CompileVariantStage(const ShaderImporter::Options& options, gfxapi::ShaderS
         return false;
     }
 
-    for (const auto& v : variant.defines) {
+    for (const auto& v : defines) {
         compilerOptions.defines[v] = "";
     }
 
-    auto& stage{ variant.stages[shaderStage] };
-
-    if (!ParseShaderStageParams(compilerOptions, options, stage, variant.vertexAttributes, error)) {
-        return false;
-    }
-
-    std::vector<u8> data;
-    if (!CompileShaderStage(compilerOptions, options, data, error)) {
-        return false;
-    }
-
-    stage.compiled = data;
-    stage.entry = entryPoint.data();
-
     return true;
 }
 
-bool CompileVariant(
-    const ShaderImporter::Options& options, const ShaderFileDefinition& definition, SerializedShaderVariant& variant, ShaderImporter::ShaderError& error) {
-    for (const auto& stage : definition.stages) {
-        if (!CompileVariantStage(options, stage.stage, stage.shader, stage.entry, variant, error)) {
-            if (options.verbose) {
-                std::cerr << "Failed to compile shader stage\n";
-            }
-            return false;
-        }
-    }
-
-    return true;
+DerivedDataCache::Key SpirvCacheKey(const SpirvCompiler::Options& options, const std::string& preprocessed) {
+    // Preprocessed source already contains includes and resolved defines.
+    DerivedDataCache::KeyBuilder key{ "spirv", SHADERC_VERSION };
+    key.AddString(preprocessed);
+    key.AddString(options.entryPoint);
+    key.AddValue(options.stage);
+    key.AddValue(options.optimizationLevel);
+    key.AddValue(options.warningsAsErrors);
+    key.AddValue(options.debugInfo);
+    return key.Finish();
 }
 
 void ParseShaderDefaultValues(const ShaderImporter::Options& options, const ShaderFileDefinition& definition, SerializedShader& shader) {
@@ -265,11 +273,14 @@ void ParseShaderDefaultValues(const ShaderImporter::Options& options, const Shad
 }
 
 bool Build(const ShaderImporter::Options& options, const ShaderFileDefinition& definition, SerializedShader& shader,
-    std::vector<ShaderImporter::ShaderError>& shaderErrors) {
+    std::vector<ShaderImporter::ShaderError>& shaderErrors, DerivedDataCache* cache, ShaderImporter::Stats& stats) {
     shader.name = definition.name;
     shader.category = definition.category;
     shader.defines = definition.defines;
 
+    std::map<std::string, std::string> sources;
+    std::vector<VariantStage> stages;
+
     Permutations<std::string> permutations{ Span<const std::string>{ definition.permutations.data(), definition.permutations.size() } };
 
     while (!permutations.End()) {
@@ -285,21 +296,126 @@ bool Build(const ShaderImporter::Options& options, const ShaderFileDefinition& d
             variant.defines.push_back(define);
         }
 
-        ShaderImporter::ShaderError error;
-        if (!CompileVariant(options, definition, variant, error)) {
-            shaderErrors.push_back(error);
+        for (const auto& stage : definition.stages) {
+            VariantStage variantStage{ .variant = shader.variants.size() };
+            if (!StageCompilerOptions(options, stage.stage, stage.shader, stage.entry, variant.defines, sources, variantStage.options, variantStage.error)) {
+                shaderErrors.push_back(variantStage.error);
+                return false;
+            }
 
-            return false;
+            stages.push_back(std::move(variantStage));
         }
 
         shader.variants.push_back(variant);
+    }
+
+    Scheduler scheduler{ options.threads > 0 ? options.threads : Thread::HardwareConcurency() };
+
+    // Preprocessing is cheap compared to compilation and tells which variants differ for each stage.
+    scheduler.ParallelFor(u32(stages.size()), [&](u32 start, u32 end) {
+        for (auto i{ start }; i < end; ++i) {
+            auto& stage{ stages[i] };
+
+            auto preprocessOptions{ stage.options };
+            preprocessOptions.preprocess = true;
+            preprocessOptions.preprocessOnly = true;
+
+            SpirvHlslCompiler compiler{};
+            if (CompileShaderStage(preprocessOptions, options, compiler, stage.error)) {
+                stage.preprocessed = compiler.Preprocessed();
+            } else {
+                stage.preprocessFailed = true;
+            }
+        }
+    });
+
+    std::vector<StageCompile> compiles;
+    std::map<std::pair<u64, u64>, size_t> compileIndices;
+
+    const auto addCompile{ [&](const SpirvCompiler::Options& compileOptions, const std::string& preprocessed) {
+        const auto key{ SpirvCacheKey(compileOptions, preprocessed) };
+        const auto [it, inserted] = compileIndices.try_emplace(std::make_pair(key.a, key.b), compiles.size());
+        if (inserted) {
+            compiles.push_back(StageCompile{ .options = compileOptions, .key = key });
+        }
+        return it->second;
+    } };
+
+    for (auto& stage : stages) {
+        if (stage.preprocessFailed) {
+            shaderErrors.push_back(stage.error);
+            return false;
+        }
+
+        auto reflectOptions{ stage.options };
+        reflectOptions.debugInfo = true;
+
+        stage.reflectCompile = addCompile(reflectOptions, stage.preprocessed);
+        stage.compile = addCompile(stage.options, stage.preprocessed);
+    }
+
+    // Cache isn't thread safe, lookups and stores run on this thread.
+    std::vector<size_t> pending;
+    for (size_t i{}; i < compiles.size(); ++i) {
+        Vector<u8> data;
+        if (cache && cache->Get(compiles[i].key, data)) {
+            compiles[i].spirv.assign(data.Data(), data.Data() + data.Size());
+            compiles[i].cached = true;
+        } else {
+            pending.push_back(i);
+        }
+    }
+
+    scheduler.ParallelFor(u32(pending.size()), [&](u32 start, u32 end) {
+        for (auto i{ start }; i < end; ++i) {
+            auto& compile{ compiles[pending[i]] };
 
-        if (options.saveSteps) {
-            const auto dir{ options.outputFile.parent_path() };
+            SpirvHlslCompiler compiler{};
+            if (CompileShaderStage(compile.options, options, compiler, compile.error)) {
+                compile.spirv = compiler.Compiled();
+            } else {
+                compile.failed = true;
+            }
+        }
+    });
+
+    bool failed{};
+    for (const auto i : pending) {
+        const auto& compile{ compiles[i] };
+        if (compile.failed) {
+            shaderErrors.push_back(compile.error);
+            failed = true;
+        } else if (cache) {
+            cache->Put(compile.key, Span<const u8>{ compile.spirv.data(), compile.spirv.size() });
+        }
+    }
+
+    if (failed) {
+        return false;
+    }
+
+    for (const auto& stage : stages) {
+        auto& variant{ shader.variants[stage.variant] };
+        auto& variantStage{ variant.stages[stage.options.stage] };
+
+        ParseShaderStageParams(compiles[stage.reflectCompile].spirv, stage.options.stage, variantStage, variant.vertexAttributes);
+
+        variantStage.compiled = compiles[stage.compile].spirv;
+        variantStage.entry = stage.options.entryPoint;
+    }
+
+    stats.variants = shader.variants.size();
+    stats.stages = stages.size();
+    stats.compiles = compiles.size();
+    stats.cachedCompiles = compiles.size() - pending.size();
 
-            for (const auto& stage : variant.stages) {
+    if (options.saveSteps) {
+        const auto dir{ options.outputFile.parent_path() };
+
+        for (size_t i{}; i < shader.variants.size(); ++i) {
+            for (const auto& stage : shader.variants[i].stages) {
                 auto fileName{ options.outputFile.filename() };
-                fileName.replace_extension(std::to_string(shader.variants.size()) + "." + GetTarget(stage.first, "6_0"));
+                fileName.replace_extension(std::to_string(i + 1) + "." + GetTarget(stage.first, "6_0"));
 
                 const auto outFile{ dir / fileName };
                 WriteFileBinary(Path{ outFile.string() }, Span<const u8>{ stage.second.compiled.data(), stage.second.compiled.size() });
@@ -312,11 +428,64 @@ bool Build(const ShaderImporter::Options& options, const ShaderFileDefinition& d
     return true;
 }
 
-bool SaveShader(const SerializedShader& shader, const ShaderImporter::Options& options) {
-    Vector<u8> out;
-    SaveShader(shader, out);
-    WriteFileBinary(Path{ options.outputFile.string() }, out);
-    return true;
+void AddSourceWithIncludes(DerivedDataCache::KeyBuilder& key, const std::filesystem::path& file, const ShaderImporter::Options& options,
+    std::set<std::filesystem::path>& visited) {
+    if (!visited.insert(file).second) {
+        return;
+    }
+
+    const auto source{ ugine::ReadFile(Path{ file.string() }) };
+    key.AddString(source);
+
+    // Same lookup as the compiler: including file directory first, then include dirs.
+    std::istringstream iss{ source };
+    for (std::string line; std::getline(iss, line);) {
+        const auto directive{ line.find("#include") };
+        if (directive == std::string::npos || line.find_first_not_of(" \t") != directive) {
+            continue;
+        }
+
+        const auto begin{ line.find_first_of("\"<", directive) };
+        const auto end{ begin == std::string::npos ? begin : line.find_first_of("\">", begin + 1) };
+        if (end == std::string::npos) {
+            continue;
+        }
+
+        const std::filesystem::path include{ line.substr(begin + 1, end - begin - 1) };
+
+        std::vector<std::filesystem::path> candidates{ file.parent_path() / include };
+        for (const auto& dir : options.includeDirs) {
+            candidates.push_back(dir / include);
+        }
+
+        const auto found{ std::find_if(candidates.begin(), candidates.end(), [](const auto& path) { return std::filesystem::exists(path); }) };
+        if (found != candidates.end()) {
+            AddSourceWithIncludes(key, std::filesystem::weakly_canonical(*found), options, visited);
+        } else {
+            key.AddString(include.string());
+        }
+    }
+}
+
+DerivedDataCache::Key ShaderCacheKey(const ShaderImporter::Options& options, const ShaderFileDefinition& definition) {
+    DerivedDataCache::KeyBuilder key{ "shaderc", SHADERC_VERSION };
+    key.AddValue(options.optimizeForPerf);
+    key.AddValue(options.generateDebugInfo);
+    key.AddValue(options.warningsAsErrors);
+    key.AddFile(Path{ options.inputFile.string() });
+
+    std::set<std::filesystem::path> visited;
+    for (const auto& stage : definition.stages) {
+        std::filesystem::path input{ stage.shader };
+        if (input.is_relative()) {
+            input = options.inputFile.parent_path() / input;
+        }
+
+        key.AddString(stage.shader);
+        AddSourceWithIncludes(key, std::filesystem::weakly_canonical(input), options, visited);
+    }
+
+    return key.Finish();
 }
 
 bool ShaderImporter::Import(const ShaderImporter::Options& options) {
@@ -326,12 +495,6 @@ bool ShaderImporter::Import(const ShaderImporter::Options& options) {
         return false;
     }
 
-    SerializedShader shader{};
-    if (!Build(options, definition, shader, shaderErrors_)) {
-        error_ = "Shader build failed.";
-        return false;
-    }
-
     const auto outputDir{ options.outputFile.parent_path() };
     if (!std::filesystem::exists(outputDir)) {
         std::error_code ec{};
@@ -340,7 +503,28 @@ bool ShaderImporter::Import(const ShaderImporter::Options& options) {
         // TODO: Error handling.
     }
 
-    if (!SaveShader(shader, options)) {
+    const auto useCache{ options.useCache && !options.saveSteps };
+    DerivedDataCache cache{ options.cacheDir.empty() ? DerivedDataCache::DefaultRoot() : Path{ options.cacheDir.string() } };
+    const auto key{ useCache ? ShaderCacheKey(options, definition) : DerivedDataCache::Key{} };
+
+    Vector<u8> out;
+    if (useCache && cache.Get(key, out)) {
+        cacheHit_ = true;
+    } else {
+        SerializedShader shader{};
+        if (!Build(options, definition, shader, shaderErrors_, options.useCache ? &cache : nullptr, stats_)) {
+            error_ = "Shader build failed.";
+            return false;
+        }
+
+        SaveShader(shader, out);
+
+        if (useCache && !cache.Put(key, out.ToSpan()) && options.verbose) {
+            std::cerr << std::format("Failed to store shader in cache '{}'\n", cache.Root().Data());
+        }
+    }
+
+    if (!WriteFileBinary(Path{ options.outputFile.string() }, out)) {
         error_ = "Failed to save shader";
         return false;
     }
@@ -1,5 +1,6 @@
 #include <ShaderImporter.h>
 
+#include <chrono>
 #include <filesystem>
 #include <format>
 #include <iostream>
@@ -22,6 +23,10 @@ template <> std::string ParseArg(const char* str) {
     return str;
 }
 
+template <> uint32_t ParseArg(const char* str) {
+    return uint32_t(std::stoul(str));
+}
+
 template <typename T> std::optional<T> ReadArgument(std::string_view name, ArgContext& context) {
     if (strcmp(context.argv[context.position], name.data()) == 0) {
         if (context.position < context.argc - 1) {
@@ -80,6 +85,21 @@ bool ParseOptions(int argc, char* argv[], ShaderImporter::Options& options) {
             continue;
         }
 
+        if (auto noCache = ReadArgument<bool>("-N", context)) {
+            options.useCache = false;
+            continue;
+        }
+
+        if (auto cacheDir = ReadArgument<std::string>("-C", context)) {
+            options.cacheDir = *cacheDir;
+            continue;
+        }
+
+        if (auto threads = ReadArgument<uint32_t>("-j", context)) {
+            options.threads = *threads;
+            continue;
+        }
+
         std::cerr << std::format("Unknown argument '{}'\n", context.Arg());
         return false;
     }
@@ -98,6 +118,9 @@ inline void Usage(const char* name) {
     std::cerr << "\t-G \t\tAdd debug info.\n";
     std::cerr << "\t-V \t\tVerbose.\n";
     std::cerr << "\t-S \t\tSave steps.\n";
+    std::cerr << "\t-N \t\tDon't use derived data cache.\n";
+    std::cerr << "\t-C cache_dir\tDerived data cache directory.\n";
+    std::cerr << "\t-j threads\tVariant compilation threads.\n";
 }
 
 int main(int argc, char* argv[]) {
@@ -120,6 +143,8 @@ int main(int argc, char* argv[]) {
             std::cout << std::format("Compiling shader '{}' => '{}'...\n", options.inputFile.string(), options.outputFile.string());
         }
 
+        const auto start{ std::chrono::high_resolution_clock::now() };
+
         ShaderImporter importer{};
         if (!importer.Import(options)) {
             if (options.verbose) {
@@ -131,6 +156,14 @@ int main(int argc, char* argv[]) {
             return -1;
         }
 
+        const auto ms{ std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count() };
+        if (importer.CacheHit()) {
+            std::cout << std::format("Shader '{}' cached in {:.1f} ms\n", options.inputFile.filename().string(), ms);
+        } else {
+            const auto& stats{ importer.GetStats() };
+            std::cout << std::format("Shader '{}' compiled in {:.1f} ms: {} variants, {} stages, {} unique compilations ({} cached)\n",
+                options.inputFile.filename().string(), ms, stats.variants, stats.stages, stats.compiles, stats.cachedCompiles);
+        }
     } catch (const std::exception& ex) {
         std::cerr << ex.what() << "\n";
         return -1;
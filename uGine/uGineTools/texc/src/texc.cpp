@@ -0,0 +1,252 @@
+#include <ugine/DerivedDataCache.h>
+#include <ugine/File.h>
+#include <ugine/Image.h>
+#include <ugine/Scheduler.h>
+#include <ugine/TextureBuilder.h>
+#include <ugine/Thread.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <format>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::high_resolution_clock;
+
+double Seconds(Clock::time_point start, Clock::time_point end) {
+    return std::chrono::duration<double>(end - start).count();
+}
+
+bool IsImage(const std::filesystem::path& path) {
+    const auto ext{ path.extension().string() };
+    return ext == ".png" || ext == ".jpg" || ext == ".jpeg" || ext == ".tga" || ext == ".bmp" || ext == ".ktx";
+}
+
+} // namespace
+
+inline void Usage(const char* name) {
+    std::cerr << "Usage " << name << " <input> <output> [-f format] [-n] [-l] [-s] [-j threads] [-N] [-C cache_dir] [-V]\n";
+    std::cerr << "\tinput \t\tImage file or directory converted recursively, output is then directory.\n";
+    std::cerr << "\t\t\tCompressed KTX is copied as is, failed files are listed at the end.\n";
+    std::cerr << "\t-f \t\tRGBA8, BC1, BC3, BC5 or BC7 (default).\n";
+    std::cerr << "\t-n \t\tNormal map (renormalized mips, BC5 unless format is given).\n";
+    std::cerr << "\t-l \t\tLinear (non-color) data.\n";
+    std::cerr << "\t-s \t\tSingle mip.\n";
+    std::cerr << "\t-j \t\tWorker threads.\n";
+    std::cerr << "\t-N \t\tDon't use derived data cache.\n";
+    std::cerr << "\t-C cache_dir\tDerived data cache directory.\n";
+    std::cerr << "\t-V \t\tVerbose, per file timing.\n";
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 3) {
+        ::Usage(argv[0]);
+        return -1;
+    }
+
+    const std::filesystem::path input{ argv[1] };
+    const std::filesystem::path output{ argv[2] };
+
+    ugine::TextureBuildSettings settings{ .format = ugine::Image::Format::BC7 };
+    bool formatSet{};
+    bool verbose{};
+    bool useCache{ true };
+    std::string cacheDir;
+    u32 threads{ ugine::Thread::HardwareConcurency() };
+
+    for (int i{ 3 }; i < argc; ++i) {
+        if (strcmp(argv[i], "-f") == 0 && i + 1 < argc) {
+            if (!ugine::FormatFromString(argv[++i], settings.format)) {
+                std::cerr << std::format("Unknown format '{}'\n", argv[i]);
+                return -1;
+            }
+            formatSet = true;
+        } else if (strcmp(argv[i], "-n") == 0) {
+            settings.normalMap = true;
+            settings.srgb = false;
+        } else if (strcmp(argv[i], "-l") == 0) {
+            settings.srgb = false;
+        } else if (strcmp(argv[i], "-s") == 0) {
+            settings.mips = false;
+        } else if (strcmp(argv[i], "-j") == 0 && i + 1 < argc) {
+            threads = std::max(u32(std::stoul(argv[++i])), 1u);
+        } else if (strcmp(argv[i], "-N") == 0) {
+            useCache = false;
+        } else if (strcmp(argv[i], "-C") == 0 && i + 1 < argc) {
+            cacheDir = argv[++i];
+        } else if (strcmp(argv[i], "-V") == 0) {
+            verbose = true;
+        } else {
+            std::cerr << std::format("Unknown argument '{}'\n", argv[i]);
+            ::Usage(argv[0]);
+            return -1;
+        }
+    }
+
+    if (settings.normalMap && !formatSet) {
+        settings.format = ugine::Image::Format::BC5;
+    }
+
+    const auto start{ Clock::now() };
+
+    try {
+        // Sorted for stable output order.
+        std::vector<std::pair<std::filesystem::path, std::filesystem::path>> files;
+        if (std::filesystem::is_directory(input)) {
+            for (const auto& entry : std::filesystem::recursive_directory_iterator{ input }) {
+                if (entry.is_regular_file() && IsImage(entry.path())) {
+                    auto target{ output / std::filesystem::relative(entry.path(), input) };
+                    files.emplace_back(entry.path(), target.replace_extension(".ktx"));
+                }
+            }
+            std::sort(files.begin(), files.end());
+        } else {
+            files.emplace_back(input, output);
+        }
+
+        ugine::Scheduler scheduler{ threads };
+        ugine::DerivedDataCache cache{ cacheDir.empty() ? ugine::DerivedDataCache::DefaultRoot() : ugine::Path{ cacheDir } };
+
+        double loadTime{};
+        double mipsTime{};
+        double compressTime{};
+        double saveTime{};
+        u64 inputSize{};
+        u64 outputSize{};
+        u32 copied{};
+        std::vector<std::filesystem::path> failed;
+
+        // Errors are reported per file, the batch goes on.
+        const auto convert{ [&](const std::filesystem::path& source, const std::filesystem::path& target) {
+            const auto t0{ Clock::now() };
+
+            if (target.has_parent_path()) {
+                std::filesystem::create_directories(target.parent_path());
+            }
+
+            auto key{ ugine::TextureCacheKey(settings) };
+            if (useCache && !key.AddFile(ugine::Path{ source.string() })) {
+                std::cerr << std::format("Failed to read '{}'\n", source.string());
+                return false;
+            }
+
+            ugine::Vector<u8> cached;
+            if (useCache && cache.Get(key.Finish(), cached)) {
+                if (!ugine::WriteFileBinary(ugine::Path{ target.string() }, cached)) {
+                    std::cerr << std::format("Failed to write '{}'\n", target.string());
+                    return false;
+                }
+
+                saveTime += Seconds(t0, Clock::now());
+                inputSize += std::filesystem::file_size(source);
+                outputSize += cached.Size();
+
+                if (verbose) {
+                    std::cout << std::format("  {} cached {:.1f} ms\n", source.string(), Seconds(t0, Clock::now()) * 1e3);
+                }
+                return true;
+            }
+
+            ugine::Image image;
+            if (!ugine::Image::FromFile(ugine::Path{ source.string() }, image)) {
+                std::cerr << std::format("Failed to load '{}'\n", source.string());
+                return false;
+            }
+
+            // Compressed KTX was built already, mips can't be generated from it.
+            if (image.IsCompressed()) {
+                if (!std::filesystem::exists(target) || !std::filesystem::equivalent(source, target)) {
+                    std::filesystem::copy_file(source, target, std::filesystem::copy_options::overwrite_existing);
+                }
+
+                saveTime += Seconds(t0, Clock::now());
+                inputSize += std::filesystem::file_size(source);
+                outputSize += std::filesystem::file_size(target);
+                ++copied;
+
+                if (verbose) {
+                    std::cout << std::format("  {} already built ({}), copied\n", source.string(), ugine::ToString(image.GetFormat()));
+                }
+                return true;
+            }
+
+            const auto t1{ Clock::now() };
+            if (!ugine::GenerateMips(image, settings, &scheduler)) {
+                std::cerr << std::format("Failed to generate mips of '{}'\n", source.string());
+                return false;
+            }
+
+            const auto t2{ Clock::now() };
+            if (!ugine::CompressImage(image, settings.format, &scheduler)) {
+                std::cerr << std::format("Failed to compress '{}'\n", source.string());
+                return false;
+            }
+
+            const auto t3{ Clock::now() };
+            if (!image.Save(ugine::Path{ target.string() })) {
+                std::cerr << std::format("Failed to write '{}'\n", target.string());
+                return false;
+            }
+
+            if (useCache) {
+                cache.Put(key.Finish(), ugine::ReadFileBinary(ugine::Path{ target.string() }).ToSpan());
+            }
+
+            const auto t4{ Clock::now() };
+
+            loadTime += Seconds(t0, t1);
+            mipsTime += Seconds(t1, t2);
+            compressTime += Seconds(t2, t3);
+            saveTime += Seconds(t3, t4);
+            inputSize += std::filesystem::file_size(source);
+            outputSize += std::filesystem::file_size(target);
+
+            if (verbose) {
+                std::cout << std::format("  {} {}x{} {} mips: load {:.1f} ms, mips {:.1f} ms, compress {:.1f} ms, save {:.1f} ms\n", source.string(),
+                    image.Width(), image.Height(), image.Mips(), Seconds(t0, t1) * 1e3, Seconds(t1, t2) * 1e3, Seconds(t2, t3) * 1e3, Seconds(t3, t4) * 1e3);
+            }
+            return true;
+        } };
+
+        for (const auto& [source, target] : files) {
+            bool converted{};
+            try {
+                converted = convert(source, target);
+            } catch (const std::exception& ex) {
+                std::cerr << std::format("Failed to convert '{}': {}\n", source.string(), ex.what());
+            }
+
+            if (!converted) {
+                failed.push_back(source);
+            }
+        }
+
+        std::cout << std::format("Converted {} textures to {} ({} copied), {:.2f} MB => {:.2f} MB in {:.2f} s (load {:.2f} s, mips {:.2f} s, compress {:.2f} s, save {:.2f} s)\n",
+            files.size() - failed.size(), ugine::ToString(settings.format), copied, inputSize / 1e6, outputSize / 1e6, Seconds(start, Clock::now()), loadTime, mipsTime, compressTime,
+            saveTime);
+
+        if (useCache) {
+            const auto stats{ cache.GetStats() };
+            std::cout << std::format("Derived data cache: {} hits, {} misses ({:.0f}% hit rate), {} evictions\n", stats.hits, stats.misses,
+                stats.HitRate() * 100.0f, stats.evictions);
+        }
+
+        if (!failed.empty()) {
+            std::cerr << std::format("{} of {} textures failed:\n", failed.size(), files.size());
+            for (const auto& source : failed) {
+                std::cerr << std::format("  {}\n", source.string());
+            }
+            return -1;
+        }
+    } catch (const std::exception& ex) {
+        std::cerr << ex.what() << "\n";
+        return -1;
+    }
+
+    return 0;
+}
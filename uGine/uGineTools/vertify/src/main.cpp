@@ -6,12 +6,77 @@
 #include <assimp/postprocess.h>
 #include <assimp/scene.h>
 
+#include <meshoptimizer.h>
+
+#include <cstring>
+#include <vector>
+
+namespace {
+void PrintStats(const char* label, const std::vector<unsigned int>& indices, const aiMesh* mesh) {
+    const auto positions{ &mesh->mVertices[0].x };
+    const auto vertexCount{ size_t(mesh->mNumVertices) };
+
+    const auto cache16{ meshopt_analyzeVertexCache(indices.data(), indices.size(), vertexCount, 16, 0, 0) };
+    const auto cache32{ meshopt_analyzeVertexCache(indices.data(), indices.size(), vertexCount, 32, 0, 0) };
+    const auto overdraw{ meshopt_analyzeOverdraw(indices.data(), indices.size(), positions, vertexCount, sizeof(aiVector3D)) };
+    const auto fetch{ meshopt_analyzeVertexFetch(indices.data(), indices.size(), vertexCount, sizeof(aiVector3D)) };
+
+    std::cout << std::format("  {:<10} ACMR {:.3f} / {:.3f}, ATVR {:.3f} / {:.3f}, overdraw {:.3f}, overfetch {:.3f}\n", label, cache16.acmr,
+        cache32.acmr, cache16.atvr, cache32.atvr, overdraw.overdraw, fetch.overfetch);
+}
+
+// Prints vertex cache (16 / 32 entries), overdraw and vertex fetch statistics of each mesh, as imported and optimized.
+int Stats(const char* file) {
+    Assimp::Importer importer{};
+    auto scene{ importer.ReadFile(file, aiProcess_Triangulate | aiProcess_JoinIdenticalVertices | aiProcess_SortByPType) };
+
+    if (!scene || scene->mNumMeshes < 1) {
+        std::cerr << "No meshes found\n";
+        return -1;
+    }
+
+    for (uint32_t m{}; m < scene->mNumMeshes; ++m) {
+        const auto mesh{ scene->mMeshes[m] };
+
+        std::vector<unsigned int> indices;
+        indices.reserve(mesh->mNumFaces * 3);
+        for (uint32_t i{}; i < mesh->mNumFaces; ++i) {
+            const auto face{ mesh->mFaces[i] };
+            if (face.mNumIndices == 3) {
+                indices.insert(indices.end(), face.mIndices, face.mIndices + 3);
+            }
+        }
+
+        if (indices.empty()) {
+            continue;
+        }
+
+        std::cout << std::format("{} ({} vertices, {} triangles)\n", mesh->mName.C_Str(), mesh->mNumVertices, indices.size() / 3);
+        PrintStats("imported", indices, mesh);
+
+        std::vector<unsigned int> optimized(indices.size());
+        meshopt_optimizeVertexCache(optimized.data(), indices.data(), indices.size(), mesh->mNumVertices);
+        PrintStats("optimized", optimized, mesh);
+    }
+
+    return 0;
+}
+} // namespace
+
 int main(int argc, char* argv[]) {
     if (argc < 2) {
         std::cerr << "Missing input file\n";
         return -1;
     }
 
+    if (std::strcmp(argv[1], "--stats") == 0) {
+        if (argc < 3) {
+            std::cerr << "Missing input file\n";
+            return -1;
+        }
+        return Stats(argv[2]);
+    }
+
     std::ostream* out{ &std::cout };
     std::ofstream fout;
     if (argc > 2) {
@@ -1,6 +1,7 @@
 #include "Resource.h"
 #include "ResourceManager.h"
 
+#include <ugine/Metrics.h>
 #include <ugine/Profile.h>
 #include <ugine/StringUtils.h>
 
@@ -11,6 +12,8 @@ namespace ugine {
 Resource::~Resource() {
     // Can't load virtual Unload() here.
     UGINE_ASSERT(state_ == ResourceState::Unloaded);
+
+    resourceManager_.Events().Detach(listeners_);
 }
 
 u64 Resource::IncRef() {
@@ -27,6 +30,14 @@ u64 Resource::DecRef() {
     return refCnt_;
 }
 
+ResourceListenerNode* Resource::ConnectStateChanged(ResourceEvents::Callback callback) {
+    return resourceManager_.Events().Connect(listeners_, callback);
+}
+
+void Resource::DisconnectStateChanged(ResourceListenerNode* node) {
+    resourceManager_.Events().Disconnect(node);
+}
+
 void Resource::LoadAsync(StringView file) {
     if (state_ != ResourceState::Unloaded) {
         return;
@@ -35,11 +46,20 @@ void Resource::LoadAsync(StringView file) {
     UGINE_DEBUG("Async loading {} '{}' from '{}'", Type().Name(), Id().ToString(), file.Data());
     UGINE_ASSERT(!ioRequest_);
 
+    UGINE_COUNTER_INC("resources.loadRequests");
+
     SetState(ResourceState::Loading);
-    ioRequest_ = resourceManager_.GetEngine().GetFileSystem().ReadAsync(file, [this](Span<const u8> data, bool success) {
+    HandleLoadStart(file);
+
+    if (SupportsDecode()) {
+        resourceManager_.Loader().LoadAsync(this, file);
+        return;
+    }
+
+    ioRequest_ = resourceManager_.GetEngine().GetFileSystem().ReadAsync(file, [this](IoData& data, bool success) {
         ioRequest_ = {};
         if (success) {
-            Load(data);
+            Load(data.Data());
         } else {
             SetState(ResourceState::Failed);
         }
@@ -50,13 +70,32 @@ void Resource::Load(Span<const u8> data) {
     UGINE_DEBUG("Loading resource {}: {}", Type().Name(), Id().ToString());
     UGINE_ASSERT(!ioRequest_);
 
-    if (!HandleLoad(data)) {
+    bool loaded{};
+    {
+        UGINE_METRIC_SCOPE_TIME("resources.loadTime");
+        loaded = SupportsDecode() ? HandleDecode(data) && HandleFinalize() : HandleLoad(data);
+    }
+
+    if (loaded && SupportsDecode() && !PollUpload()) {
+        SetState(ResourceState::Loading);
+        resourceManager_.Loader().WaitUpload(this);
+        return;
+    }
+
+    FinishLoad(loaded);
+}
+
+void Resource::FinishLoad(bool loaded) {
+    if (!loaded) {
         UGINE_WARN("{} load failed: {}", Type().Name(), Id().ToString());
+        UGINE_COUNTER_INC("resources.loadFailures");
 
         SetState(ResourceState::Failed);
         return;
     }
 
+    UGINE_COUNTER_INC("resources.loaded");
+
     if (loadingDependencies_ == 0) {
         UGINE_DEBUG("{} loaded: {}", Type().Name(), Id().ToString());
         SetState(ResourceState::Loaded);
@@ -74,6 +113,10 @@ void Resource::Unload() {
         ioRequest_ = {};
     }
 
+    if (state_ == ResourceState::Loading) {
+        resourceManager_.Loader().Cancel(this);
+    }
+
     UGINE_DEBUG("Unloading resource {}: {}", Type().Name(), Id().ToString());
 
     if (HandleUnload()) {
@@ -94,8 +137,16 @@ void Resource::AddDependency(Resource* resource) {
     UGINE_DEBUG("Adding dependency {} {} to {} {} (deps: {}, pending: {})", resource->Type().Name(), resource->Id().ToString(), Type().Name(),
         Id().ToString(), dependencies_, loadingDependencies_);
 
-    resource->Connect<Resource::StateChangedEvent, &Resource::OnDependencyChanged>(this);
-    if (resource->State() != ResourceState::Loaded) {
+    // Single listener per dependency, state is tracked by counters.
+    auto& events{ resourceManager_.Events() };
+    if (!events.Find(resource->listeners_, this)) {
+        ResourceEvents::Callback callback;
+        callback.Connect<&Resource::OnDependencyChanged>(this);
+        events.Connect(resource->listeners_, callback, this);
+    }
+
+    // Count by state seen by listeners, changes not dispatched yet are still going to be delivered.
+    if (resource->listeners_.state != ResourceState::Loaded) {
         ++loadingDependencies_;
     }
 }
@@ -109,8 +160,12 @@ void Resource::RemoveDependency(Resource* resource) {
     UGINE_DEBUG("Removing dependency {} {} to {} {} (deps: {}, pending: {})", resource->Type().Name(), resource->Id().ToString(), Type().Name(),
         Id().ToString(), dependencies_, loadingDependencies_);
 
-    resource->Disconnect<Resource::StateChangedEvent>(this);
-    if (resource->State() != ResourceState::Loaded) {
+    auto& events{ resourceManager_.Events() };
+    if (auto node{ events.Find(resource->listeners_, this) }) {
+        events.Disconnect(node);
+    }
+
+    if (resource->listeners_.state != ResourceState::Loaded) {
         --loadingDependencies_;
     }
 }
@@ -179,7 +234,7 @@ void Resource::SetState(ResourceState newState) {
         }
 #endif
 
-        Emit(StateChangedEvent{ Id(), this, state_, prevState });
+        resourceManager_.Events().Enqueue(listeners_, StateChangedEvent{ Id(), this, state_, prevState });
     }
 }
 
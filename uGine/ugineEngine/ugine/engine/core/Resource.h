@@ -1,10 +1,10 @@
 #pragma once
 
-#include <ugine/EventEmittor.h>
 #include <ugine/FileSystem.h>
 #include <ugine/Hash.h>
 #include <ugine/SlotMap.h>
 
+#include <ugine/engine/core/ResourceEvents.h>
 #include <ugine/engine/core/ResourceID.h>
 
 #include <array>
@@ -41,38 +41,20 @@ UGINE_FORCE_INLINE bool operator<(const ResourceType& a, const ResourceType& b)
     return a.Hash() < b.Hash();
 }
 
-enum class ResourceState {
-    Unloaded,
-    Loading,
-    Loaded,
-    Failed,
-};
-
-inline static constexpr const char* ResourceStateName[] = {
-    "Unloaded",
-    "Loading",
-    "Loaded",
-    "Failed",
-};
-
-class Resource : public EventEmittorMT {
+class Resource {
 public:
-    struct StateChangedEvent {
-        ResourceID id{};
-        Resource* resource{};
-        ResourceState newState{};
-        ResourceState prevState{};
-    };
+    using StateChangedEvent = ResourceStateChangedEvent;
 
     Resource(ResourceManager& resourceManager, const ResourceType& type, const ResourceID& id)
         : resourceManager_{ resourceManager }
         , type_{ type }
         , id_{ id } {}
 
+    // Listener nodes point to the resource.
     Resource(const Resource&) = delete;
     Resource& operator=(const Resource&) = delete;
-    Resource(Resource&&) = default;
-    Resource& operator=(Resource&&) = default;
+    Resource(Resource&&) = delete;
+    Resource& operator=(Resource&&) = delete;
 
     virtual ~Resource();
 
@@ -90,9 +72,24 @@ public:
     void Load(Span<const u8> data);
     void Unload();
 
+    // State changes are delivered at ResourceManager::SyncPoint().
+    ResourceListenerNode* ConnectStateChanged(ResourceEvents::Callback callback);
+    void DisconnectStateChanged(ResourceListenerNode* node);
+
 protected:
     virtual bool HandleLoad(Span<const u8> data) { return false; }
     virtual bool HandleUnload() { return true; }
+    // Main thread, before LoadAsync reads the file. Loads from memory don't call it.
+    virtual void HandleLoadStart(StringView file) {}
+
+    // Staged loading by ResourceLoader, used instead of HandleLoad if supported. HandleDecode runs on worker job and only
+    // builds CPU side intermediate kept by the resource, HandleFinalize turns it to GPU objects and dependencies on main
+    // thread. PollUpload is called after finalize and then every frame until it returns true, resource is loaded after
+    // that. HandleUnload releases intermediate of cancelled load.
+    virtual bool SupportsDecode() const { return false; }
+    virtual bool HandleDecode(Span<const u8> data) { return false; }
+    virtual bool HandleFinalize() { return false; }
+    virtual bool PollUpload() { return true; }
     virtual void HandleDependenciesReady() {}
     virtual void HandleDependencyChanged(const ResourceID& id, ResourceState state) {}
 
@@ -106,12 +103,16 @@ protected:
     const ResourceManager& Manager() const { return resourceManager_; }
 
 private:
+    friend class ResourceLoader;
+
+    void FinishLoad(bool loaded);
     void OnDependencyChanged(const StateChangedEvent& event);
 
     ResourceManager& resourceManager_;
     ResourceType type_;
     ResourceID id_;
     ResourceState state_{ ResourceState::Unloaded };
+    ResourceListenerList listeners_;
 
     // TODO: Atomic
     u32 refCnt_{};
@@ -279,24 +280,40 @@ namespace ugine {
 
 class ResourceListener {
 public:
-    template <auto Handler, typename... Args> void Connect(Resource& resource, Args&&... args) {
-        auto& count{ connections_[resource.Id()] };
-        if (count++ == 0) {
-            resource.Connect<Resource::StateChangedEvent, Handler>(std::forward<Args>(args)...);
+    ResourceListener() = default;
+
+    ResourceListener(const ResourceListener&) = delete;
+    ResourceListener& operator=(const ResourceListener&) = delete;
+
+    ~ResourceListener() {
+        UGINE_ASSERT(connections_.empty());
+    }
+
+    template <auto Handler, typename Instance> void Connect(Resource& resource, Instance instance) {
+        auto& connection{ connections_[resource.Id()] };
+        if (connection.count++ == 0) {
+            ResourceEvents::Callback callback;
+            callback.Connect<Handler>(instance);
+            connection.node = resource.ConnectStateChanged(callback);
         }
     }
 
-    template <typename... Args> void Disconnect(Resource& resource, Args&&... args) {
-        auto& count{ connections_[resource.Id()] };
-        UGINE_ASSERT(count > 0);
-        if (--count == 0) {
-            connections_.erase(resource.Id());
-            resource.Disconnect<Resource::StateChangedEvent>(std::forward<Args>(args)...);
+    template <typename... Args> void Disconnect(Resource& resource, Args&&...) {
+        const auto it{ connections_.find(resource.Id()) };
+        UGINE_ASSERT(it != connections_.end() && it->second.count > 0);
+        if (--it->second.count == 0) {
+            resource.DisconnectStateChanged(it->second.node);
+            connections_.erase(it);
         }
     }
 
 private:
-    std::unordered_map<ResourceID, u32> connections_;
+    struct Connection {
+        u32 count{};
+        ResourceListenerNode* node{};
+    };
+
+    std::unordered_map<ResourceID, Connection> connections_;
 };
 
 } // namespace ugine
\ No newline at end of file
@@ -0,0 +1,237 @@
+#include "ResourceEvents.h"
+
+#include <ugine/Profile.h>
+
+namespace ugine {
+
+ResourceEvents::ResourceEvents(IAllocator& allocator)
+    : allocator_{ allocator }
+    , overflow_{ allocator }
+    , batch_{ allocator }
+    , detached_{ allocator }
+    , disconnected_{ allocator }
+    , chunks_{ allocator } {}
+
+ResourceEvents::~ResourceEvents() {
+    UGINE_ASSERT(!dispatching_);
+
+    for (auto chunk : chunks_) {
+        allocator_.AlignedFree(chunk);
+    }
+}
+
+ResourceListenerNode* ResourceEvents::Connect(ResourceListenerList& list, Callback callback, const void* owner) {
+    UGINE_ASSERT(callback);
+
+    auto node{ AllocNode() };
+    node->list = &list;
+    node->prev = nullptr;
+    node->next = list.head;
+    node->callback = callback;
+    node->owner = owner;
+
+    if (list.head) {
+        list.head->prev = node;
+    }
+    list.head = node;
+
+    ++listeners_;
+    return node;
+}
+
+void ResourceEvents::Disconnect(ResourceListenerNode* node) {
+    UGINE_ASSERT(node);
+
+    if (node->list) {
+        Unlink(node);
+    }
+    node->callback = Callback{};
+
+    UGINE_ASSERT(listeners_ > 0);
+    --listeners_;
+
+    // Dispatch may still walk through the node, keep it alive until it finishes.
+    if (dispatching_) {
+        disconnected_.PushBack(node);
+    } else {
+        FreeNode(node);
+    }
+}
+
+ResourceListenerNode* ResourceEvents::Find(const ResourceListenerList& list, const void* owner) const {
+    for (auto node{ list.head }; node; node = node->next) {
+        if (node->owner == owner) {
+            return node;
+        }
+    }
+    return nullptr;
+}
+
+void ResourceEvents::Detach(ResourceListenerList& list) {
+    // Nodes stay allocated until their owners disconnect them. They keep their next pointers, so dispatch in
+    // progress can walk past them.
+    for (auto node{ list.head }; node; node = node->next) {
+        node->list = nullptr;
+    }
+    list.head = nullptr;
+
+    if (!Idle()) {
+        detached_.PushBack(Detached{ .list = &list, .sequence = sequence_.load(std::memory_order_acquire) });
+    }
+}
+
+void ResourceEvents::Enqueue(ResourceListenerList& list, const ResourceStateChangedEvent& event) {
+    const Pending pending{
+        .list = &list,
+        .event = event,
+        .sequence = sequence_.fetch_add(1, std::memory_order_acq_rel),
+    };
+
+    queued_.fetch_add(1, std::memory_order_relaxed);
+
+    if (!overflowing_.load(std::memory_order_acquire) && queue_.PushBack(pending)) {
+        return;
+    }
+
+    Lock lock{ overflowMutex_ };
+    overflowing_.store(true, std::memory_order_release);
+    overflow_.PushBack(pending);
+    overflowed_.fetch_add(1, std::memory_order_relaxed);
+}
+
+u32 ResourceEvents::Dispatch() {
+    PROFILE_EVENT();
+
+    UGINE_ASSERT(!dispatching_);
+    dispatching_ = true;
+
+    u32 delivered{};
+    for (;;) {
+        batch_.Clear();
+
+        Pending pending;
+        while (queue_.PopFront(pending)) {
+            batch_.PushBack(pending);
+        }
+
+        // Overflowed events were queued after all events remaining in the queue.
+        if (overflowing_.load(std::memory_order_acquire)) {
+            Lock lock{ overflowMutex_ };
+            for (const auto& event : overflow_) {
+                batch_.PushBack(event);
+            }
+            overflow_.Clear();
+            overflowing_.store(false, std::memory_order_release);
+        }
+
+        if (batch_.Empty()) {
+            break;
+        }
+
+        // Handlers may queue further events, they are picked by the next iteration.
+        for (const auto& event : batch_) {
+            if (!IsDetached(event)) {
+                Deliver(event);
+                ++delivered;
+            }
+        }
+    }
+
+    dispatching_ = false;
+
+    for (auto node : disconnected_) {
+        FreeNode(node);
+    }
+    disconnected_.Clear();
+    detached_.Clear();
+
+    delivered_ += delivered;
+    return delivered;
+}
+
+bool ResourceEvents::Idle() const {
+    return !dispatching_ && queue_.Empty() && !overflowing_.load(std::memory_order_acquire);
+}
+
+ResourceEvents::Stats ResourceEvents::GetStats() const {
+    return Stats{
+        .queued = queued_.load(std::memory_order_relaxed),
+        .delivered = delivered_,
+        .overflowed = overflowed_.load(std::memory_order_relaxed),
+        .listeners = listeners_,
+        .nodes = u32(chunks_.Size()) * NODES_PER_CHUNK,
+    };
+}
+
+bool ResourceEvents::IsDetached(const Pending& pending) const {
+    for (const auto& detached : detached_) {
+        if (detached.list == pending.list && pending.sequence < detached.sequence) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void ResourceEvents::Deliver(const Pending& pending) {
+    pending.list->state = pending.event.newState;
+
+    // Nodes connected by handlers are inserted to head, they don't receive the event being delivered.
+    auto node{ pending.list->head };
+    while (node) {
+        // Handler may disconnect the node or detach whole list.
+        const auto next{ node->next };
+        if (node->list == pending.list && node->callback) {
+            node->callback(pending.event);
+        }
+        node = next;
+    }
+}
+
+ResourceListenerNode* ResourceEvents::AllocNode() {
+    if (!freeNodes_) {
+        auto chunk{ static_cast<ResourceListenerNode*>(
+            allocator_.AlignedAlloc(sizeof(ResourceListenerNode) * NODES_PER_CHUNK, alignof(ResourceListenerNode))) };
+        chunks_.PushBack(chunk);
+
+        for (u32 i{}; i < NODES_PER_CHUNK; ++i) {
+            auto node{ new (&chunk[i]) ResourceListenerNode{} };
+            node->next = freeNodes_;
+            freeNodes_ = node;
+        }
+    }
+
+    auto node{ freeNodes_ };
+    freeNodes_ = node->next;
+    return node;
+}
+
+void ResourceEvents::FreeNode(ResourceListenerNode* node) {
+    node->list = nullptr;
+    node->prev = nullptr;
+    node->callback = Callback{};
+    node->owner = nullptr;
+    node->next = freeNodes_;
+    freeNodes_ = node;
+}
+
+void ResourceEvents::Unlink(ResourceListenerNode* node) {
+    auto list{ node->list };
+    UGINE_ASSERT(list);
+
+    if (node->prev) {
+        node->prev->next = node->next;
+    } else {
+        UGINE_ASSERT(list->head == node);
+        list->head = node->next;
+    }
+
+    if (node->next) {
+        node->next->prev = node->prev;
+    }
+
+    // Next is kept, dispatch in progress may continue from the node.
+    node->list = nullptr;
+    node->prev = nullptr;
+}
+
+} // namespace ugine
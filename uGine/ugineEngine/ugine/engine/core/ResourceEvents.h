@@ -0,0 +1,142 @@
+#pragma once
+
+#include <ugine/Concurrent.h>
+#include <ugine/Delegate.h>
+#include <ugine/Locking.h>
+#include <ugine/Memory.h>
+#include <ugine/Vector.h>
+
+#include <ugine/engine/core/ResourceID.h>
+
+#include <atomic>
+
+namespace ugine {
+
+class Resource;
+
+enum class ResourceState {
+    Unloaded,
+    Loading,
+    Loaded,
+    Failed,
+};
+
+inline static constexpr const char* ResourceStateName[] = {
+    "Unloaded",
+    "Loading",
+    "Loaded",
+    "Failed",
+};
+
+struct ResourceStateChangedEvent {
+    ResourceID id{};
+    Resource* resource{};
+    ResourceState newState{};
+    ResourceState prevState{};
+};
+
+struct ResourceListenerList;
+
+struct ResourceListenerNode {
+    using Callback = Delegate<void(const ResourceStateChangedEvent&)>;
+
+    ResourceListenerList* list{};
+    ResourceListenerNode* prev{};
+    ResourceListenerNode* next{};
+    Callback callback;
+    const void* owner{};
+};
+
+// Listeners of single resource, embedded in the resource.
+struct ResourceListenerList {
+    ResourceListenerNode* head{};
+    // State seen by listeners, lags behind the resource state until queued changes are dispatched. Listener connected
+    // to the list receives all changes from this state on.
+    ResourceState state{ ResourceState::Unloaded };
+};
+
+// Resource state change bus, replaces per resource event dispatchers.
+// Events are queued lock free from any thread and delivered in queue order in Dispatch(), including events queued by
+// handlers during the dispatch. Listener nodes are pooled and linked into intrusive lists embedded in resources.
+// Connect, Disconnect, Find, Detach and Dispatch are main thread only.
+class ResourceEvents {
+public:
+    using Callback = ResourceListenerNode::Callback;
+
+    struct Stats {
+        u64 queued{};
+        u64 delivered{};
+        u64 overflowed{};
+        u32 listeners{};
+        u32 nodes{};
+    };
+
+    explicit ResourceEvents(IAllocator& allocator);
+    ~ResourceEvents();
+
+    ResourceEvents(const ResourceEvents&) = delete;
+    ResourceEvents& operator=(const ResourceEvents&) = delete;
+
+    ResourceListenerNode* Connect(ResourceListenerList& list, Callback callback, const void* owner = nullptr);
+    void Disconnect(ResourceListenerNode* node);
+    ResourceListenerNode* Find(const ResourceListenerList& list, const void* owner) const;
+
+    // Must be called before the list owner is destroyed. Detaches listeners and drops its queued events.
+    void Detach(ResourceListenerList& list);
+
+    void Enqueue(ResourceListenerList& list, const ResourceStateChangedEvent& event);
+
+    // Returns number of delivered events.
+    u32 Dispatch();
+
+    bool Idle() const;
+
+    Stats GetStats() const;
+
+private:
+    static constexpr u32 QUEUE_CAPACITY{ 4096 };
+    static constexpr u32 NODES_PER_CHUNK{ 256 };
+
+    struct Pending {
+        ResourceListenerList* list{};
+        ResourceStateChangedEvent event;
+        u64 sequence{};
+    };
+
+    struct Detached {
+        ResourceListenerList* list{};
+        u64 sequence{};
+    };
+
+    bool IsDetached(const Pending& pending) const;
+    void Deliver(const Pending& pending);
+
+    ResourceListenerNode* AllocNode();
+    void FreeNode(ResourceListenerNode* node);
+    void Unlink(ResourceListenerNode* node);
+
+    IAllocator& allocator_;
+
+    MPMCQueue<Pending, QUEUE_CAPACITY> queue_;
+    std::atomic_uint64_t sequence_{};
+
+    // Used once the queue is full, until next dispatch, so events of one producer stay ordered.
+    AtomicSpinLock overflowMutex_;
+    Vector<Pending> overflow_;
+    std::atomic_bool overflowing_{};
+
+    Vector<Pending> batch_;
+    Vector<Detached> detached_;
+    Vector<ResourceListenerNode*> disconnected_;
+    bool dispatching_{};
+
+    Vector<ResourceListenerNode*> chunks_;
+    ResourceListenerNode* freeNodes_{};
+
+    u64 delivered_{};
+    u32 listeners_{};
+    std::atomic_uint64_t queued_{};
+    std::atomic_uint64_t overflowed_{};
+};
+
+} // namespace ugine
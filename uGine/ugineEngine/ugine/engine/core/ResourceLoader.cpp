@@ -0,0 +1,240 @@
+#include "ResourceLoader.h"
+#include "Resource.h"
+
+#include <ugine/Metrics.h>
+#include <ugine/Profile.h>
+
+#include <ugine/engine/engine/CVars.h>
+#include <ugine/engine/engine/Engine.h>
+
+namespace ugine {
+
+namespace {
+    auto& FinalizeBudget{ CVars::Register(
+        "Resource finalize budget", "Main thread milliseconds per frame spent finalizing decoded resources", "resources", CVar::Type::Float, 2.0f, 0.1f, 100.0f) };
+
+    template <typename Duration> u64 Micros(Duration duration) {
+        return u64(std::chrono::duration_cast<std::chrono::microseconds>(duration).count());
+    }
+} // namespace
+
+void ResourceLoader::Job::ExecuteRange(TaskSetPartition range, u32 threadnum) {
+    loader->Decode(this);
+}
+
+ResourceLoader::ResourceLoader(Engine& engine, IAllocator& allocator)
+    : engine_{ engine }
+    , allocator_{ allocator }
+    , decoding_{ allocator }
+    , finalizing_{ allocator }
+    , uploading_{ allocator }
+    , pool_{ allocator }
+    , free_{ allocator } {
+}
+
+ResourceLoader::~ResourceLoader() {
+    for (auto& [resource, job] : jobs_) {
+        if (job->stage == Stage::Reading) {
+            engine_.GetFileSystem().Cancel(job->request);
+        } else if (job->stage == Stage::Decoding) {
+            engine_.GetScheduler().WaitFor(job);
+        }
+    }
+}
+
+void ResourceLoader::LoadAsync(Resource* resource, const Path& file) {
+    UGINE_ASSERT(!jobs_.contains(resource));
+
+    auto job{ Acquire() };
+    job->resource = resource;
+    job->stage = Stage::Reading;
+    job->submitted = Clock::now();
+
+    jobs_[resource] = job;
+    ++stats_.reading;
+
+    job->request = engine_.GetFileSystem().ReadAsync(file, [job](IoData& data, bool success) { job->loader->OnRead(job, data, success); });
+}
+
+void ResourceLoader::WaitUpload(Resource* resource) {
+    UGINE_ASSERT(!jobs_.contains(resource));
+
+    auto job{ Acquire() };
+    job->resource = resource;
+    job->submitted = Clock::now();
+
+    jobs_[resource] = job;
+    Upload(job);
+}
+
+void ResourceLoader::Cancel(Resource* resource) {
+    const auto it{ jobs_.find(resource) };
+    if (it == jobs_.end()) {
+        return;
+    }
+
+    auto job{ it->second };
+    switch (job->stage) {
+    case Stage::Reading:
+        engine_.GetFileSystem().Cancel(job->request);
+        --stats_.reading;
+        break;
+    case Stage::Decoding:
+        engine_.GetScheduler().WaitFor(job);
+        decoding_.Erase(job);
+        --stats_.decoding;
+        break;
+    case Stage::Finalizing:
+        finalizing_.Erase(job);
+        --stats_.finalizing;
+        break;
+    case Stage::Uploading:
+        uploading_.Erase(job);
+        --stats_.uploading;
+        break;
+    }
+
+    jobs_.erase(it);
+    Release(job);
+}
+
+void ResourceLoader::Update() {
+    PROFILE_EVENT_N("Resource finalize");
+
+    // Finished decodes in submission order, keeps loads of a level roughly in request order.
+    for (size_t i{}; i < decoding_.Size();) {
+        auto job{ decoding_[i] };
+        if (job->GetIsComplete()) {
+            job->stage = Stage::Finalizing;
+            finalizing_.PushBack(job);
+            decoding_.EraseAt(i);
+            --stats_.decoding;
+            ++stats_.finalizing;
+        } else {
+            ++i;
+        }
+    }
+
+    // Uploads are submitted by graphics, here only polled.
+    for (size_t i{}; i < uploading_.Size();) {
+        auto job{ uploading_[i] };
+        if (job->resource->PollUpload()) {
+            uploading_.EraseAt(i);
+            --stats_.uploading;
+
+            UGINE_HISTOGRAM_RECORD("resources.uploadTime", Micros(Clock::now() - job->ready));
+            Finish(job, true);
+        } else {
+            ++i;
+        }
+    }
+
+    const auto start{ Clock::now() };
+    const auto budget{ std::chrono::duration<f32, std::milli>(FinalizeBudget.GetFloat()) };
+
+    // Finalize may load or cancel other resources, job is taken out of the queue first.
+    u32 finalized{};
+    while (!finalizing_.Empty() && (finalized == 0 || Clock::now() - start < budget)) {
+        auto job{ finalizing_[0] };
+        finalizing_.EraseAt(0);
+        --stats_.finalizing;
+
+        Finalize(job);
+        ++finalized;
+    }
+
+    stats_.finalizedLastFrame = finalized;
+    stats_.finalizeLastFrameMS = std::chrono::duration<f32, std::milli>(Clock::now() - start).count();
+
+    UGINE_GAUGE_SET("resources.decoding", stats_.decoding);
+    UGINE_GAUGE_SET("resources.finalizePending", stats_.finalizing);
+    UGINE_GAUGE_SET("resources.uploading", stats_.uploading);
+}
+
+void ResourceLoader::OnRead(Job* job, IoData& data, bool success) {
+    job->request = {};
+    job->ready = Clock::now();
+    --stats_.reading;
+
+    UGINE_HISTOGRAM_RECORD("resources.ioTime", Micros(job->ready - job->submitted));
+
+    if (!success) {
+        jobs_.erase(job->resource);
+        job->resource->FinishLoad(false);
+        Release(job);
+        return;
+    }
+
+    job->data = data.Take();
+    job->stage = Stage::Decoding;
+    decoding_.PushBack(job);
+    ++stats_.decoding;
+
+    engine_.GetScheduler().Schedule(job);
+}
+
+void ResourceLoader::Finalize(Job* job) {
+    UGINE_HISTOGRAM_RECORD("resources.finalizeWait", Micros(Clock::now() - job->ready));
+
+    bool loaded{};
+    {
+        UGINE_METRIC_SCOPE_TIME("resources.finalizeTime");
+        loaded = job->decoded && job->resource->HandleFinalize();
+    }
+
+    if (loaded && !job->resource->PollUpload()) {
+        Upload(job);
+        return;
+    }
+
+    Finish(job, loaded);
+}
+
+void ResourceLoader::Upload(Job* job) {
+    job->stage = Stage::Uploading;
+    job->ready = Clock::now();
+    uploading_.PushBack(job);
+    ++stats_.uploading;
+}
+
+void ResourceLoader::Finish(Job* job, bool loaded) {
+    jobs_.erase(job->resource);
+    job->resource->FinishLoad(loaded);
+
+    UGINE_HISTOGRAM_RECORD("resources.pipelineTime", Micros(Clock::now() - job->submitted));
+
+    Release(job);
+}
+
+void ResourceLoader::Decode(Job* job) {
+    PROFILE_EVENT_N("Resource decode");
+
+    const auto start{ Clock::now() };
+    job->decoded = job->resource->HandleDecode(job->data.Data());
+    job->ready = Clock::now();
+
+    UGINE_HISTOGRAM_RECORD("resources.decodeTime", Micros(job->ready - start));
+}
+
+ResourceLoader::Job* ResourceLoader::Acquire() {
+    if (!free_.Empty()) {
+        auto job{ free_.Back() };
+        free_.PopBack();
+        return job;
+    }
+
+    pool_.PushBack(MakeUnique<Job>(allocator_));
+    pool_.Back()->loader = this;
+    return pool_.Back().Get();
+}
+
+void ResourceLoader::Release(Job* job) {
+    job->resource = nullptr;
+    job->decoded = false;
+    job->request = {};
+    job->data = {};
+
+    free_.PushBack(job);
+}
+
+} // namespace ugine
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <ugine/FileSystem.h>
+#include <ugine/Memory.h>
+#include <ugine/Scheduler.h>
+#include <ugine/Vector.h>
+
+#include <chrono>
+#include <unordered_map>
+
+namespace ugine {
+
+class Engine;
+class Resource;
+
+// Staged loading of resources with HandleDecode: IO thread reads, worker job decodes into CPU intermediate, main
+// thread finalizes (GPU objects, dependencies) in completion order, limited by per-frame budget. Resources with GPU
+// uploads in flight after finalize are polled each frame and become loaded once the data is on GPU.
+class ResourceLoader {
+public:
+    struct Stats {
+        u32 reading{};
+        u32 decoding{};
+        u32 finalizing{};
+        u32 uploading{};
+        u32 finalizedLastFrame{};
+        f32 finalizeLastFrameMS{};
+    };
+
+    ResourceLoader(Engine& engine, IAllocator& allocator);
+    ~ResourceLoader();
+
+    ResourceLoader(const ResourceLoader&) = delete;
+    ResourceLoader& operator=(const ResourceLoader&) = delete;
+
+    void LoadAsync(Resource* resource, const Path& file);
+
+    // Finishes synchronously finalized resource once its uploads complete.
+    void WaitUpload(Resource* resource);
+
+    // Drops staged load, waits if decode job is running so resource can release the intermediate.
+    void Cancel(Resource* resource);
+
+    // Moves decoded resources to finalize queue and finalizes them until budget runs out, at least one per frame.
+    void Update();
+
+    Stats GetStats() const { return stats_; }
+
+private:
+    using Clock = std::chrono::high_resolution_clock;
+
+    enum class Stage : u8 {
+        Reading,
+        Decoding,
+        Finalizing,
+        Uploading,
+    };
+
+    struct Job : TaskSet {
+        void ExecuteRange(TaskSetPartition range, u32 threadnum) override;
+
+        ResourceLoader* loader{};
+        Resource* resource{};
+        Stage stage{};
+        bool decoded{};
+        FileSystem::RequestHandle request{};
+        IoData data; // Taken from IO queue.
+        Clock::time_point submitted{};
+        Clock::time_point ready{}; // End of previous stage.
+    };
+
+    void OnRead(Job* job, IoData& data, bool success);
+    void Decode(Job* job); // Worker thread.
+    void Finalize(Job* job);
+    void Upload(Job* job);
+    void Finish(Job* job, bool loaded);
+
+    Job* Acquire();
+    void Release(Job* job);
+
+    Engine& engine_;
+    AllocatorRef allocator_;
+
+    std::unordered_map<Resource*, Job*> jobs_;
+    Vector<Job*> decoding_;
+    Vector<Job*> finalizing_;
+    Vector<Job*> uploading_;
+
+    Vector<UniquePtr<Job>> pool_;
+    Vector<Job*> free_;
+
+    Stats stats_{};
+};
+
+} // namespace ugine
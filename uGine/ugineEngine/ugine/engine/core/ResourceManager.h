@@ -1,6 +1,7 @@
 #pragma once
 
 #include <ugine/engine/core/Resource.h>
+#include <ugine/engine/core/ResourceLoader.h>
 #include <ugine/engine/core/ResourceStorage.h>
 
 #include <ugine/Path.h>
@@ -22,7 +23,9 @@ public:
 
     explicit ResourceManager(Engine& engine, IAllocator& allocator)
         : engine_{ engine }
-        , allocator_{ allocator } {}
+        , allocator_{ allocator }
+        , events_{ allocator }
+        , loader_{ engine, allocator } {}
 
     ~ResourceManager() {}
 
@@ -30,6 +33,18 @@ public:
     Engine& GetEngine() const { return engine_; }
     //FileSystem& GetFileSystem() const { return engine_.GetFileSystem(); }
 
+    ResourceEvents& Events() { return events_; }
+    ResourceLoader& Loader() { return loader_; }
+
+    // Finalizes decoded resources and delivers queued resource state changes.
+    void SyncPoint() {
+        loader_.Update();
+        events_.Dispatch();
+    }
+
+    // Creates storage of the type up front, so registered resources of it are found by GetTypeless.
+    template <typename T> void RegisterType() { GetStorage<T>(); }
+
     template <typename T> ResourceHandle<T> Create() {
         // TODO: Locking.
 
@@ -128,6 +143,32 @@ public:
         return handle;
     }
 
+    // Get of registered resource whose type isn't known statically (dependency lists). Empty for types not registered
+    // by RegisterType or typed Get.
+    ResourceHandleTypeless GetTypeless(const ResourceID& id) {
+        // TODO: Locking.
+
+        const auto ref{ resourcesById_.find(id) };
+        if (ref == resourcesById_.end()) {
+            return {};
+        }
+
+        auto storage{ GetStorage(ref->second.type) };
+        if (!storage) {
+            return {};
+        }
+
+        auto handle{ storage->Get(id) };
+        if (!handle) {
+            handle = storage->Create(*this, id);
+        }
+
+        if (handle->State() == ResourceState::Unloaded && !ref->second.path.Empty()) {
+            handle->LoadAsync(ref->second.path.String());
+        }
+        return handle;
+    }
+
     template <typename T> const std::unordered_map<ResourceID, u64>& All() const {
         // TODO: Locking.
 
@@ -257,6 +298,10 @@ private:
     Engine& engine_;
     IAllocator& allocator_;
 
+    // Outlive storages, resources detach from them on destruction.
+    ResourceEvents events_;
+    ResourceLoader loader_;
+
     std::unordered_map<ResourceID, ResourceRef> resourcesById_;
     std::unordered_map<Path, ResourceID> resourcesByPath_;
 
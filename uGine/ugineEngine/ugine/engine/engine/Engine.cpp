@@ -3,12 +3,14 @@
 #include <ugine/FileSystem.h>
 #include <ugine/Log.h>
 #include <ugine/Memory.h>
+#include <ugine/Metrics.h>
 #include <ugine/Profile.h>
 #include <ugine/String.h>
 #include <ugine/Thread.h>
 
 // Systems
 #include <ugine/engine/core/CoreSystem.h>
+#include <ugine/engine/engine/CVars.h>
 #include <ugine/engine/engine/System.h>
 #include <ugine/engine/gfx/GraphicsSystem.h>
 #include <ugine/engine/gfx/ImGuiSystem.h>
@@ -21,9 +23,17 @@
 
 #include <algorithm>
 #include <chrono>
+#include <fstream>
 
 namespace ugine {
 
+namespace {
+    auto& MetricsEnabled{ CVars::Register("Metrics", "Collect hot path counters and histograms", "engine", CVar::Type::Bool, true) };
+    auto& MetricsDumpInterval{ CVars::Register(
+        "Metrics dump interval", "Seconds between metric dumps to metrics.csv (0 = off)", "engine", CVar::Type::Float, 0.0f, 0.0f, 600.0f) };
+    auto& MetricsDumpJson{ CVars::Register("Metrics dump JSON", "Dump metrics to metrics.json lines instead of CSV", "engine", CVar::Type::Bool, false) };
+} // namespace
+
 Engine::Engine(const EngineParams& params, IAllocator& allocator)
     : params_{ params }
     , mainThreadId_{ std::this_thread::get_id() }
@@ -38,6 +48,9 @@ Engine::Engine(const EngineParams& params, IAllocator& allocator)
 Engine::~Engine() {
     PROFILE_SHUTDOWN();
 
+    // Pending records reach logger callbacks while systems are alive, teardown logs synchronously.
+    ShutdownLogger();
+
     worldManager_->DestroyWorlds();
 
     DestroySystems();
@@ -66,7 +79,13 @@ void Engine::Init() {
     resourceManager_ = MakeUnique<ResourceManager>(allocator_, *this, allocator_);
     worldManager_ = MakeUnique<WorldManager>(allocator_, *this);
 
-    fileSystem_ = FileSystem::Create(params_.rootPath, *scheduler_, THREAD_IO, allocator_);
+    if (!params_.archivePath.Empty()) {
+        fileSystem_ = FileSystem::CreatePak(params_.archivePath, allocator_);
+    }
+
+    if (!fileSystem_) {
+        fileSystem_ = FileSystem::Create(params_.rootPath, *scheduler_, THREAD_IO, allocator_);
+    }
 
     InitSystems(params_.systems);
 }
@@ -86,9 +105,10 @@ void Engine::InitScheduler() {
     scheduler_ = MakeUnique<Scheduler>(allocator_, tasks, names.ToSpan(), allocator_);
     frameAllocators_.Resize(scheduler_->NumThreads());
 
+    // Initial block size, arenas grow when needed.
     const auto size{ GetConfig().GetParam<u32>("engine.frameAllocationSize"_hs, 16 * 1024 * 1024) };
     for (u32 i{}; i < scheduler_->NumThreads(); ++i) {
-        frameAllocators_[i].Init(size, allocator_);
+        frameAllocators_[i] = MakeUnique<ArenaAllocator>(allocator_, size);
     }
 }
 
@@ -192,9 +212,54 @@ void Engine::InitPlatform() {
     platform_ = Platform::Create(params_, allocator_);
 }
 
-void Engine::ResetFrameAllocators() {
+void Engine::ResetFrameAllocators(FrameStats& stats) {
+    stats.frameMemoryUsed = 0;
+    stats.frameMemoryReserved = 0;
+
     for (auto& allocator : frameAllocators_) {
-        allocator.Reset();
+        const auto allocatorStats{ allocator->GetStats() };
+        stats.frameMemoryUsed += allocatorStats.used;
+        stats.frameMemoryReserved += allocatorStats.reserved;
+
+        allocator->Reset();
+    }
+
+    stats.frameMemoryHighWater = std::max(GetFrameStats().frameMemoryHighWater, stats.frameMemoryUsed);
+}
+
+void Engine::UpdateMetrics(const FrameStats& stats) {
+    Metrics::SetEnabled(MetricsEnabled.GetBool());
+    if (!Metrics::Enabled()) {
+        return;
+    }
+
+    UGINE_HISTOGRAM_RECORD("engine.frameTime", stats.frameTimeMS * 1000.0f);
+    UGINE_GAUGE_SET("engine.frameAllocations", frameAllocations_);
+    UGINE_GAUGE_SET("engine.frameMemoryUsed", stats.frameMemoryUsed);
+
+    Metrics::Collect();
+
+    const auto interval{ MetricsDumpInterval.GetFloat() };
+    const auto now{ Seconds() };
+    if (interval <= 0.0f || now < nextMetricsDump_) {
+        return;
+    }
+
+    PROFILE_EVENT_NC("Metrics dump", COLOR_PROFILE_ENGINE);
+
+    // File is truncated by the first dump of the session.
+    const auto mode{ nextMetricsDump_ > 0.0 ? std::ios::app : std::ios::trunc };
+    nextMetricsDump_ = now + interval;
+
+    if (MetricsDumpJson.GetBool()) {
+        std::ofstream out{ "metrics.json", std::ios::out | mode };
+        Metrics::WriteJson(out, now);
+    } else {
+        std::ofstream out{ "metrics.csv", std::ios::out | mode };
+        if (mode == std::ios::trunc) {
+            Metrics::WriteCsvHeader(out);
+        }
+        Metrics::WriteCsv(out, now);
     }
 }
 
@@ -280,6 +345,7 @@ int Engine::Run() {
                 const auto start{ Clock::now() };
 
                 fileSystem_->SyncPoint();
+                resourceManager_->SyncPoint();
 
                 stats.filesystemMS = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start).count() / 1000.0f;
             }
@@ -288,7 +354,7 @@ int Engine::Run() {
 
             fpsCounter_.Fps(fps_);
 
-            ResetFrameAllocators();
+            ResetFrameAllocators(stats);
 
             // TODO: [multithread] Reset on sync point.
             frameAllocations_ = IAllocator::NumAllocs();
@@ -296,6 +362,8 @@ int Engine::Run() {
 
             stats.frameTimeMS = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - frameStart).count() / 1000.0f;
 
+            UpdateMetrics(stats);
+
             ++frameNumber_;
         }
     } catch (const std::exception& ex) {
@@ -34,6 +34,9 @@ public:
         float syncMS{};
         float filesystemMS{};
         float frameTimeMS{};
+        u64 frameMemoryUsed{};      // Frame allocators of all threads.
+        u64 frameMemoryHighWater{}; // Max of frameMemoryUsed.
+        u64 frameMemoryReserved{};
     };
 
     Engine(const EngineParams& params, IAllocator& allocator = IAllocator::Default());
@@ -83,7 +86,7 @@ public:
     void RemoveSystem(System* system);
 
     // Memory
-    IAllocator& FrameAllocator(u32 threadNum = Scheduler::ThreadNum()) { return frameAllocators_[threadNum]; }
+    IAllocator& FrameAllocator(u32 threadNum = Scheduler::ThreadNum()) { return *frameAllocators_[threadNum]; }
 
     // States.
 
@@ -119,7 +122,8 @@ private:
     void DestroySystems();
     void AddRemoveSystems();
 
-    void ResetFrameAllocators();
+    void ResetFrameAllocators(FrameStats& stats);
+    void UpdateMetrics(const FrameStats& stats);
 
     const EngineParams params_{};
     const std::thread::id mainThreadId_{};
@@ -151,9 +155,11 @@ private:
     // Attached states.
     entt::registry states_;
 
-    Vector<LinearAllocator> frameAllocators_;
+    Vector<UniquePtr<ArenaAllocator>> frameAllocators_;
 
     FrameStats frameStats_[2];
+
+    f64 nextMetricsDump_{};
 };
 
 } // namespace ugine
@@ -40,6 +40,7 @@ struct EngineParams {
 
     bool imgui{};
     Path rootPath{};
+    Path archivePath{}; // Pak mounted instead of rootPath if set.
 
     // TODO:
     // custom hwnd / android surface
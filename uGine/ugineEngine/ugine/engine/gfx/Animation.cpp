@@ -9,13 +9,14 @@
 #include <ugine/engine/core/ResourceManager.h>
 #include <ugine/engine/gfx/Model.h>
 #include <ugine/engine/math/Math.h>
+#include <ugine/engine/math/Simd.h>
 
 #include <glm/glm.hpp>
 #include <glm/gtx/transform.hpp>
 
 namespace ugine {
 
-bool Animation::HandleLoad(Span<const u8> data) {
+bool Animation::HandleDecode(Span<const u8> data) {
     PROFILE_EVENT();
 
     SerializedAnimation serialized{};
@@ -23,17 +24,30 @@ bool Animation::HandleLoad(Span<const u8> data) {
         return false;
     }
 
-    lengthSeconds = serialized.lengthSeconds;
-    name = serialized.name;
-    for (const auto& [name, channel] : serialized.channels) {
-        channels.insert(std::make_pair(StringID{ name.c_str() },
+    auto decoded{ MakeUnique<Decoded>(Manager().GetAllocator()) };
+    decoded->lengthSeconds = serialized.lengthSeconds;
+    decoded->name = std::move(serialized.name);
+    for (auto& [name, channel] : serialized.channels) {
+        decoded->channels.insert(std::make_pair(StringID{ name.c_str() },
             Animation::Channel{
-                .positions = channel.positions,
-                .rotations = channel.rotations,
-                .scales = channel.scales,
+                .positions = std::move(channel.positions),
+                .rotations = std::move(channel.rotations),
+                .scales = std::move(channel.scales),
             }));
     }
 
+    decoded_ = std::move(decoded);
+    return true;
+}
+
+bool Animation::HandleFinalize() {
+    UGINE_ASSERT(decoded_);
+
+    lengthSeconds = decoded_->lengthSeconds;
+    name = std::move(decoded_->name);
+    channels = std::move(decoded_->channels);
+
+    decoded_ = nullptr;
     return true;
 }
 
@@ -43,6 +57,7 @@ bool Animation::HandleUnload() {
     name.clear();
     lengthSeconds = 0;
     channels.clear();
+    decoded_ = nullptr;
     return true;
 }
 
@@ -97,96 +112,131 @@ glm::mat4 InterpolateChannels(f32 time1, const Animation::Channel& channel1, f32
     return glm::translate(position) * glm::mat4(rotation) * glm::scale(scale);
 }
 
-void UpdateAnimation(IAllocator& allocator, const Model& model, const Animation& animation, f32 time, Span<glm::mat4> outMatrices) {
-    UGINE_ASSERT(!model.Nodes().Empty());
-    UGINE_ASSERT(!model.Bones().Empty());
+namespace {
+
+    // Animated nodes are sampled first and composed in one batch, skinning matrices are combined in batches as well.
+    // Only the hierarchy walk stays sequential.
+    template <typename Sample> void UpdatePose(IAllocator& allocator, const Model& model, Sample&& sample, Span<glm::mat4> outMatrices) {
+        const auto& nodes{ model.Nodes() };
+        const auto& bones{ model.Bones() };
+
+        Vector<glm::mat4> locals{ nodes.Size(), allocator };
+        Vector<u32> animated{ allocator };
+        Vector<glm::vec3> positions{ allocator };
+        Vector<glm::fquat> rotations{ allocator };
+        Vector<glm::vec3> scales{ allocator };
+        animated.Reserve(nodes.Size());
+        positions.Reserve(nodes.Size());
+        rotations.Reserve(nodes.Size());
+        scales.Reserve(nodes.Size());
+
+        for (u32 i{}; i < nodes.Size(); ++i) {
+            glm::vec3 position{};
+            glm::fquat rotation{};
+            glm::vec3 scale{};
+
+            if (sample(nodes[i], position, rotation, scale)) {
+                animated.PushBack(i);
+                positions.PushBack(position);
+                rotations.PushBack(rotation);
+                scales.PushBack(scale);
+            } else {
+                locals[i] = nodes[i].transform;
+            }
+        }
 
-    //for (u32 i{}; i < outMatricesCount; ++i) {
-    //    outMatrices[i] = glm::mat4{ 1.0f };
-    //}
-    //return;
+        Vector<glm::mat4> composed{ animated.Size(), allocator };
+        simd::ComposeTransforms(positions.ToSpan(), rotations.ToSpan(), scales.ToSpan(), composed.ToSpan());
+        for (size_t i{}; i < animated.Size(); ++i) {
+            locals[animated[i]] = composed[i];
+        }
 
-    struct Entry {
-        u32 nodeIndex;
-        glm::mat4 parentTransform{ 1.0f };
-    };
+        Vector<glm::mat4> globals{ nodes.Size(), allocator };
+        Vector<u32> boneNodes{ allocator };
+        boneNodes.Reserve(bones.Size());
 
-    Vector<Entry> nodeStack{ model.Nodes().Size(), allocator };
-    u32 stackTop{};
+        Vector<u32> nodeStack{ nodes.Size(), allocator };
+        u32 stackTop{};
 
-    nodeStack[stackTop++] = Entry{ 0, glm::mat4{ 1.0f } };
+        globals[0] = locals[0];
+        nodeStack[stackTop++] = 0;
 
-    while (stackTop > 0) {
-        Entry entry{ nodeStack[--stackTop] };
+        while (stackTop > 0) {
+            const auto index{ nodeStack[--stackTop] };
+            const auto& node{ nodes[index] };
 
-        const auto& node{ model.Nodes()[entry.nodeIndex] };
+            if (node.boneIndex != Model::INVALID_INDEX) {
+                UGINE_ASSERT(node.boneIndex < outMatrices.Size());
+                boneNodes.PushBack(index);
+            }
 
-        const auto channelIt{ animation.channels.find(node.id) };
-        const glm::mat4 nodeTransform{ channelIt != animation.channels.end() ? InterpolateChannel(time, channelIt->second) : node.transform };
-        const auto globalTransform{ entry.parentTransform * nodeTransform };
+            for (const auto child : node.children) {
+                globals[child] = globals[index] * locals[child];
+                nodeStack[stackTop++] = child;
+            }
+        }
 
-        if (node.boneIndex != Model::INVALID_INDEX) {
-            UGINE_ASSERT(node.boneIndex < outMatrices.Size());
-            const auto boneMatrix{ model.GlobalInverseTransform() * globalTransform * model.Bones()[node.boneIndex].offsetMatrix };
-            outMatrices[node.boneIndex] = boneMatrix;
+        // Bone matrix = global inverse * node global * bone offset.
+        Vector<glm::mat4> boneMatrices{ boneNodes.Size(), allocator };
+        Vector<glm::mat4> offsets{ boneNodes.Size(), allocator };
+        for (size_t i{}; i < boneNodes.Size(); ++i) {
+            boneMatrices[i] = globals[boneNodes[i]];
+            offsets[i] = bones[nodes[boneNodes[i]].boneIndex].offsetMatrix;
         }
 
-        for (const auto child : node.children) {
-            nodeStack[stackTop++] = Entry{ child, globalTransform };
+        simd::MultiplyMatrices(boneMatrices.ToSpan(), offsets.ToSpan(), boneMatrices.ToSpan());
+        simd::MultiplyMatrices(model.GlobalInverseTransform(), boneMatrices.ToSpan(), boneMatrices.ToSpan());
+
+        for (size_t i{}; i < boneNodes.Size(); ++i) {
+            outMatrices[nodes[boneNodes[i]].boneIndex] = boneMatrices[i];
         }
     }
-}
 
-void UpdateAnimation(IAllocator& allocator, const Model& model, const Animation& animation1, f32 time1, const Animation& animation2, f32 time2, f32 blend,
-    Span<glm::mat4> outMatrices) {
+} // namespace
+
+void UpdateAnimation(IAllocator& allocator, const Model& model, const Animation& animation, f32 time, Span<glm::mat4> outMatrices) {
     UGINE_ASSERT(!model.Nodes().Empty());
     UGINE_ASSERT(!model.Bones().Empty());
 
-    //for (u32 i{}; i < outMatricesCount; ++i) {
-    //    outMatrices[i] = glm::mat4{ 1.0f };
-    //}
-    //return;
-
-    struct Entry {
-        u32 nodeIndex{};
-        glm::mat4 parentTransform{ 1.0f };
-    };
-
-    Vector<Entry> nodeStack{ model.Nodes().Size(), allocator };
-    u32 stackTop{};
-
-    nodeStack[stackTop++] = Entry{ 0, glm::mat4{ 1.0f } };
-
-    while (stackTop > 0) {
-        Entry entry{ nodeStack[--stackTop] };
-
-        const auto& node{ model.Nodes()[entry.nodeIndex] };
+    UpdatePose(
+        allocator, model,
+        [&](const Model::Node& node, glm::vec3& position, glm::fquat& rotation, glm::vec3& scale) {
+            const auto channelIt{ animation.channels.find(node.id) };
+            if (channelIt == animation.channels.end()) {
+                return false;
+            }
 
-        const auto channel1It{ animation1.channels.find(node.id) };
-        const auto channel2It{ animation2.channels.find(node.id) };
+            position = Interpolate(time, channelIt->second.positions);
+            rotation = Interpolate(time, channelIt->second.rotations);
+            scale = Interpolate(time, channelIt->second.scales);
+            return true;
+        },
+        outMatrices);
+}
 
-        //const glm::mat4 nodeTransform{ channelIt != animation.channels.end() ? InterpolateChannel(time, channelIt->second) : node.transform };
+void UpdateAnimation(IAllocator& allocator, const Model& model, const Animation& animation1, f32 time1, const Animation& animation2, f32 time2, f32 blend,
+    Span<glm::mat4> outMatrices) {
+    UGINE_ASSERT(!model.Nodes().Empty());
+    UGINE_ASSERT(!model.Bones().Empty());
 
-        const auto nodeTransform{ [&] {
-            if (channel1It != animation1.channels.end() && channel2It != animation2.channels.end()) {
-                return InterpolateChannels(time1, channel1It->second, time2, channel2It->second, blend);
-            } else {
-                return node.transform;
+    UpdatePose(
+        allocator, model,
+        [&](const Model::Node& node, glm::vec3& position, glm::fquat& rotation, glm::vec3& scale) {
+            const auto channel1It{ animation1.channels.find(node.id) };
+            const auto channel2It{ animation2.channels.find(node.id) };
+            if (channel1It == animation1.channels.end() || channel2It == animation2.channels.end()) {
+                return false;
             }
-        }() };
 
-        const auto globalTransform{ entry.parentTransform * nodeTransform };
+            const auto& channel1{ channel1It->second };
+            const auto& channel2{ channel2It->second };
 
-        if (node.boneIndex != Model::INVALID_INDEX) {
-            UGINE_ASSERT(node.boneIndex < outMatrices.Size());
-            const auto boneMatrix{ model.GlobalInverseTransform() * globalTransform * model.Bones()[node.boneIndex].offsetMatrix };
-            outMatrices[node.boneIndex] = boneMatrix;
-        }
-
-        for (const auto child : node.children) {
-            nodeStack[stackTop++] = Entry{ child, globalTransform };
-        }
-    }
+            position = Interpolate(Interpolate(time1, channel1.positions), Interpolate(time2, channel2.positions), blend);
+            rotation = Interpolate(Interpolate(time1, channel1.rotations), Interpolate(time2, channel2.rotations), blend);
+            scale = Interpolate(Interpolate(time1, channel1.scales), Interpolate(time2, channel2.scales), blend);
+            return true;
+        },
+        outMatrices);
 }
 
 //
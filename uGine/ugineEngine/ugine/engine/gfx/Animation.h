@@ -34,8 +34,19 @@ public:
     std::unordered_map<StringID, Channel> channels;
 
 private:
-    bool HandleLoad(Span<const u8> data) override;
+    // Built by worker decode, moved to public members on finalize.
+    struct Decoded {
+        std::string name;
+        f32 lengthSeconds{};
+        std::unordered_map<StringID, Channel> channels;
+    };
+
+    bool SupportsDecode() const override { return true; }
+    bool HandleDecode(Span<const u8> data) override;
+    bool HandleFinalize() override;
     bool HandleUnload() override;
+
+    UniquePtr<Decoded> decoded_;
 };
 
 glm::mat4 InterpolateChannel(f32 time, const Animation::Channel& channel);
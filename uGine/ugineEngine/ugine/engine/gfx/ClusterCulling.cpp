@@ -0,0 +1,103 @@
+#include "ClusterCulling.h"
+
+#include <ugine/engine/math/Culling.h>
+
+#include <algorithm>
+
+namespace ugine {
+
+namespace {
+    void LimitRanges(Vector<IndexRange>& ranges, u32 maxRanges) {
+        if (maxRanges == 0 || ranges.Size() <= maxRanges) {
+            return;
+        }
+
+        // Find the gap size threshold so exactly (size - maxRanges) gaps get merged.
+        const auto merges{ u32(ranges.Size()) - maxRanges };
+
+        Vector<u32> gaps;
+        gaps.Reserve(ranges.Size() - 1);
+        for (size_t i{ 1 }; i < ranges.Size(); ++i) {
+            gaps.PushBack(ranges[i].indexStart - (ranges[i - 1].indexStart + ranges[i - 1].indexCount));
+        }
+
+        std::nth_element(gaps.begin(), gaps.begin() + (merges - 1), gaps.end());
+        const auto threshold{ gaps[merges - 1] };
+
+        u32 equalMerges{ merges };
+        for (const auto gap : gaps) {
+            if (gap < threshold) {
+                --equalMerges;
+            }
+        }
+
+        u32 count{ 1 };
+        for (size_t i{ 1 }; i < ranges.Size(); ++i) {
+            auto& last{ ranges[count - 1] };
+            const auto end{ last.indexStart + last.indexCount };
+            const auto gap{ ranges[i].indexStart - end };
+
+            if (gap < threshold || (gap == threshold && equalMerges > 0)) {
+                if (gap == threshold) {
+                    --equalMerges;
+                }
+                last.indexCount = ranges[i].indexStart + ranges[i].indexCount - last.indexStart;
+            } else {
+                ranges[count++] = ranges[i];
+            }
+        }
+
+        ranges.Resize(count);
+    }
+} // namespace
+
+ClusterCullResult CullClusters(
+    Span<const Model::Mesh::Meshlet> meshlets, const glm::mat4& transformation, const ClusterView& view, u32 maxRanges, Vector<IndexRange>& out) {
+    ClusterCullResult result{};
+    out.Clear();
+
+    const glm::vec3 scale{ glm::length(glm::vec3{ transformation[0] }), glm::length(glm::vec3{ transformation[1] }),
+        glm::length(glm::vec3{ transformation[2] }) };
+    const auto maxScale{ std::max(scale.x, std::max(scale.y, scale.z)) };
+    const auto minScale{ std::min(scale.x, std::min(scale.y, scale.z)) };
+
+    // Normal cones are not preserved by non-uniform scale.
+    const auto backface{ view.backface && maxScale - minScale <= maxScale * 0.01f };
+    const glm::mat3 rotation{ transformation };
+
+    for (size_t i{}; i < meshlets.Size(); ++i) {
+        const auto& meshlet{ meshlets[i] };
+
+        const glm::vec3 center{ transformation * glm::vec4{ meshlet.center, 1.0f } };
+        if (!SphereInFrustum(view.frustum, center, meshlet.radius * maxScale)) {
+            ++result.frustumCulled;
+            continue;
+        }
+
+        if (backface && meshlet.coneCutoff < 1.0f) {
+            const glm::vec3 apex{ transformation * glm::vec4{ meshlet.coneApex, 1.0f } };
+            const auto axis{ glm::normalize(rotation * meshlet.coneAxis) };
+            const auto toApex{ apex - view.position };
+            const auto distance{ glm::length(toApex) };
+
+            if (distance > 0.0f && glm::dot(toApex / distance, axis) >= meshlet.coneCutoff) {
+                ++result.backfaceCulled;
+                continue;
+            }
+        }
+
+        ++result.visible;
+
+        if (!out.Empty() && out.Back().indexStart + out.Back().indexCount == meshlet.indexStart) {
+            out.Back().indexCount += meshlet.indexCount;
+        } else {
+            out.PushBack(IndexRange{ .indexStart = meshlet.indexStart, .indexCount = meshlet.indexCount });
+        }
+    }
+
+    LimitRanges(out, maxRanges);
+
+    return result;
+}
+
+} // namespace ugine
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <ugine/Span.h>
+#include <ugine/Ugine.h>
+#include <ugine/Vector.h>
+
+#include <ugine/engine/gfx/Model.h>
+#include <ugine/engine/math/Frustum.h>
+
+#include <glm/glm.hpp>
+
+namespace ugine {
+
+// World space view for cluster culling.
+struct ClusterView {
+    Frustum frustum; // Normalized planes, see FrustumFromMatrix.
+    glm::vec3 position{};
+    bool backface{ true }; // Cone culling, disable for views rendering back faces (shadows).
+    bool enabled{};
+};
+
+struct IndexRange {
+    u32 indexStart{};
+    u32 indexCount{};
+};
+
+struct ClusterCullResult {
+    u32 visible{};
+    u32 frustumCulled{};
+    u32 backfaceCulled{};
+};
+
+// Culls mesh clusters against view frustum and backface cones, visible clusters are written to (cleared) out as index ranges.
+// Adjacent clusters are merged and at most maxRanges ranges (0 = unlimited) are written by filling the smallest gaps,
+// so the draw call count stays bounded at the cost of drawing some culled clusters.
+ClusterCullResult CullClusters(
+    Span<const Model::Mesh::Meshlet> meshlets, const glm::mat4& transformation, const ClusterView& view, u32 maxRanges, Vector<IndexRange>& out);
+
+} // namespace ugine
@@ -3,12 +3,15 @@
 #include <gfxapi/Initializers.h>
 
 #include <ugine/Hash.h>
+#include <ugine/Metrics.h>
 #include <ugine/Profile.h>
 
 #include <ugine/engine/engine/CVars.h>
 #include <ugine/engine/gfx/GraphicsState.h>
 #include <ugine/engine/math/Culling.h>
+#include <ugine/engine/math/OcclusionBuffer.h>
 #include <ugine/engine/math/Raycast.h>
+#include <ugine/engine/math/Simd.h>
 #include <ugine/engine/world/Component.h>
 #include <ugine/engine/world/World.h>
 
@@ -31,6 +34,58 @@ namespace {
         "Debug light cull", "Debug light culling (0 = off, 1 = opaque, 2 = transparent)", "graphics", CVar::Type::Int, 0, 0, 2) };
     auto& DisableSSAO{ CVars::Register("Disable SSAO", "Disable SSAO rendering", "graphics", CVar::Type::Bool, true) }; // TODO: Fix SSAO.
     auto& DisableDrawSort{ CVars::Register("Disable draw sort", "Disable draw call sorting", "graphics", CVar::Type::Bool, false) };
+
+    auto& DisableLod{ CVars::Register("Disable LOD", "Always render meshes at full detail", "graphics", CVar::Type::Bool, false) };
+    auto& LodScreenSize{ CVars::Register(
+        "LOD screen size", "Projected bounding sphere size (relative to screen height) where LOD 1 kicks in", "graphics", CVar::Type::Float, 0.5f, 0.01f, 4.0f) };
+    auto& DisableClusterCulling{ CVars::Register("Disable cluster culling", "Render whole meshes instead of visible clusters", "graphics", CVar::Type::Bool, false) };
+    auto& MaxClusterDraws{ CVars::Register(
+        "Max cluster draws", "Max draw calls per mesh after cluster culling, smallest gaps are drawn", "graphics", CVar::Type::Int, 8, 1, 64) };
+    auto& LodHysteresis{ CVars::Register("LOD hysteresis", "Relative screen size band to prevent LOD popping", "graphics", CVar::Type::Float, 0.1f, 0.0f, 0.5f) };
+
+    auto& DisableOcclusionCulling{ CVars::Register("Disable occlusion culling", "Disable software occlusion culling of meshes", "graphics", CVar::Type::Bool, false) };
+    auto& OccluderScreenSize{ CVars::Register(
+        "Occluder screen size", "Min projected bounding sphere size (relative to screen height) of occluders", "graphics", CVar::Type::Float, 0.25f, 0.01f, 4.0f) };
+    auto& MaxOccluders{ CVars::Register("Max occluders", "Max meshes rasterized to occlusion buffer per camera", "graphics", CVar::Type::Int, 32, 0, 256) };
+
+    // Projected bounding sphere size relative to screen height, max if the view is inside.
+    f32 ScreenSize(const LodView& view, const Sphere& sphere) {
+        if (view.perspective) {
+            const auto distance{ glm::distance(view.position, sphere.center) };
+            if (distance <= sphere.radius) {
+                return std::numeric_limits<f32>::max();
+            }
+            return sphere.radius * view.projectionScale / distance;
+        } else {
+            return sphere.radius * view.projectionScale;
+        }
+    }
+
+    // Each next LOD level is used at half of the previous level screen size.
+    u32 LodForScreenSize(f32 screenSize, u32 lodCount) {
+        u32 lod{};
+        f32 threshold{ LodScreenSize.GetFloat() };
+        while (lod + 1 < lodCount && screenSize < threshold) {
+            ++lod;
+            threshold *= 0.5f;
+        }
+        return lod;
+    }
+
+    u32 SelectLod(const LodView& view, const Sphere& sphere, u32 currentLod, u32 lodCount) {
+        if (lodCount <= 1 || DisableLod.GetBool()) {
+            return 0;
+        }
+
+        const auto screenSize{ ScreenSize(view, sphere) };
+
+        // Keep current LOD while screen size stays within hysteresis band around LOD thresholds.
+        const auto hysteresis{ LodHysteresis.GetFloat() };
+        const auto coarsest{ LodForScreenSize(screenSize * (1.0f - hysteresis), lodCount) };
+        const auto finest{ LodForScreenSize(screenSize * (1.0f + hysteresis), lodCount) };
+
+        return std::clamp(currentLod, finest, coarsest);
+    }
 } // namespace
 
 struct LightShaderData {
@@ -62,6 +117,7 @@ struct CameraRenderData {
 
     ParallelCull cull;
     VisibilityList visibilityList;
+    OcclusionBuffer occlusion;
 
     gfxapi::Extent2D rtvExtent{};
     gfxapi::TextureHandle renderTarget{};
@@ -316,6 +372,19 @@ void GraphicsScene::UpdateCamera(CameraRenderData& renderData, const CameraCompo
     renderData.camera = CameraShaderData(renderData.cCamera, transformation.Matrix(), transformation.position);
 
     renderData.cull.frustum = renderData.cCamera.GetFrustum();
+
+    renderData.visibilityList.lod = LodView{
+        .position = transformation.position,
+        .projectionScale = renderData.cCamera.ProjectionMatrix()[1][1],
+        .viewportHeight = f32(camera.height),
+        .perspective = renderData.cCamera.Type() == Camera::ProjectionType::Perspective,
+    };
+
+    renderData.visibilityList.cluster = ClusterView{
+        .frustum = FrustumFromMatrix(renderData.camera.viewProj),
+        .position = transformation.position,
+        .enabled = true,
+    };
 }
 
 void GraphicsScene::UpdateCameraFrustums(gfxapi::CommandList& cmd, CameraRenderData& data) const {
@@ -332,6 +401,7 @@ void GraphicsScene::UpdateCameraFrustums(gfxapi::CommandList& cmd, CameraRenderD
 
 WorldHit GraphicsScene::RayCast(const Ray& ray) const {
     PROFILE_EVENT_NC("RayCast", COLOR_PROFILE_GRAPHICS);
+    UGINE_METRIC_SCOPE_TIME("gfx.raycastTime");
 
     using Clock = std::chrono::high_resolution_clock;
     const auto start{ Clock::now() };
@@ -395,8 +465,22 @@ WorldHit GraphicsScene::RayCast(const Ray& ray) const {
 void GraphicsScene::Update() {
     PROFILE_EVENT_NC("GraphicsScene::Update", COLOR_PROFILE_GRAPHICS);
 
+    // Previous frame is complete at this point.
+    UGINE_GAUGE_SET("gfx.drawCalls", frameStats_.drawCalls);
+    UGINE_GAUGE_SET("gfx.computeDispatches", frameStats_.computeDispatches);
+    UGINE_GAUGE_SET("gfx.triangles", frameStats_.triangles);
+    UGINE_GAUGE_SET("gfx.clustersCulled", frameStats_.clustersCulled);
+    UGINE_GAUGE_SET("gfx.occlusionCulled", frameStats_.occlusionCulled);
+
     frameStats_.drawCalls = 0;
     frameStats_.computeDispatches = 0;
+    frameStats_.triangles = 0;
+    frameStats_.trianglesNoLod = 0;
+    frameStats_.clustersVisible = 0;
+    frameStats_.clustersCulled = 0;
+    frameStats_.occlusionTested = 0;
+    frameStats_.occlusionCulled = 0;
+    frameStats_.occlusionMs = 0.0f;
 
     auto& allocator{ IAllocator::Default() };
     //auto& allocator{ engine_.FrameAllocator() };
@@ -458,6 +542,7 @@ void GraphicsScene::WaitUpdate() {
 
         for (auto&& [_, renderData] : world_.Registry().view<CameraRenderData>().each()) {
             StoreCullResults(renderData.cull);
+            CullOccluded(renderData);
         }
 
         for (auto&& [_, renderData] : world_.Registry().view<LightRenderData>().each()) {
@@ -485,6 +570,90 @@ void GraphicsScene::StoreCullResults(ParallelCull& cull) const {
     }
 }
 
+void GraphicsScene::CullOccluded(CameraRenderData& renderData) {
+    PROFILE_EVENT_NC("CullOccluded", COLOR_PROFILE_GRAPHICS);
+
+    auto& visibility{ renderData.visibilityList };
+    if (DisableOcclusionCulling.GetBool() || visibility.meshes.Empty()) {
+        return;
+    }
+
+    using Clock = std::chrono::high_resolution_clock;
+    const auto start{ Clock::now() };
+
+    // Skinned and instanced meshes are not covered by their AABB.
+    auto isStatic = [](const GameObject& go) { return !go.Has<InstanceRenderData>() && !go.Has<AnimatorRenderData>(); };
+
+    // Largest meshes on screen are occluders.
+    struct Occluder {
+        GameObjectHandle handle;
+        f32 screenSize{};
+    };
+
+    Vector<Occluder> occluders(engine_.FrameAllocator());
+    const auto minScreenSize{ OccluderScreenSize.GetFloat() };
+    for (auto handle : visibility.meshes) {
+        auto go{ world_.Get(handle) };
+        if (!isStatic(go)) {
+            continue;
+        }
+
+        const auto screenSize{ ScreenSize(visibility.lod, go.Component<MeshRenderData>().boundingShpere) };
+        if (screenSize >= minScreenSize) {
+            occluders.PushBack(Occluder{ handle, screenSize });
+        }
+    }
+
+    const auto occluderCount{ std::min(occluders.Size(), size_t(MaxOccluders.GetInt())) };
+    std::partial_sort(occluders.begin(), occluders.begin() + occluderCount, occluders.end(),
+        [](const Occluder& a, const Occluder& b) { return a.screenSize > b.screenSize; });
+
+    auto& occlusion{ renderData.occlusion };
+    occlusion.Clear(renderData.camera.viewProj);
+
+    for (size_t i{}; i < occluderCount; ++i) {
+        auto go{ world_.Get(occluders[i].handle) };
+        const auto& meshRenderData{ go.Component<MeshRenderData>() };
+        const auto& model{ meshRenderData.modelInstance.GetModel() };
+
+        for (const auto& mesh : model->Meshes()) {
+            // Transparent meshes don't occlude.
+            const auto material{ meshRenderData.modelInstance.GetMaterial(mesh.materialIndex) };
+            if (!material || material->IsTransparent()) {
+                continue;
+            }
+
+            // Full detail, simplified LODs aren't contained in the mesh and could hide visible objects.
+            occlusion.RasterizeTriangles(mesh.vertices.ToSpan(), mesh.indices.ToSpan(), meshRenderData.modelMatrix * mesh.transformation);
+        }
+    }
+
+    occlusion.BuildHiZ();
+
+    // Test and compact visible meshes.
+    size_t count{};
+    for (auto handle : visibility.meshes) {
+        auto go{ world_.Get(handle) };
+        const auto& meshRenderData{ go.Component<MeshRenderData>() };
+
+        bool visible{ true };
+        if (isStatic(go)) {
+            ++frameStats_.occlusionTested;
+            visible = occlusion.IsVisible(meshRenderData.aabb);
+        }
+
+        if (visible) {
+            visibility.meshes[count++] = handle;
+        } else {
+            ++frameStats_.occlusionCulled;
+            visibility.drawCalls -= u32(meshRenderData.modelInstance.GetModel()->Meshes().Size());
+        }
+    }
+    visibility.meshes.Resize(count);
+
+    frameStats_.occlusionMs += std::chrono::duration<f32, std::milli>(Clock::now() - start).count();
+}
+
 void GraphicsScene::Cull(ParallelCull& cull, u32 flags) {
     PROFILE_EVENT_NC("Visibility", COLOR_PROFILE_GRAPHICS);
 
@@ -505,7 +674,7 @@ void GraphicsScene::Cull(ParallelCull& cull, u32 flags) {
     }
 }
 
-Vector<Draw> GraphicsScene::GetDrawList(const VisibilityList& visibility) const {
+Vector<Draw> GraphicsScene::GetDrawList(VisibilityList& visibility, FrameStats& stats) const {
     Vector<Draw> drawCalls(engine_.FrameAllocator());
     drawCalls.Reserve(visibility.drawCalls + 1);
     {
@@ -513,7 +682,7 @@ Vector<Draw> GraphicsScene::GetDrawList(const VisibilityList& visibility) const
         PROFILE_EVENT_NC("Collect draws", COLOR_PROFILE_GRAPHICS);
 
         for (auto handle : visibility.meshes) {
-            AddMeshDraw(drawCalls, handle);
+            AddMeshDraw(drawCalls, handle, visibility, stats);
         }
     }
 
@@ -525,7 +694,7 @@ Vector<Draw> GraphicsScene::GetDrawList(const VisibilityList& visibility) const
     return drawCalls;
 }
 
-void GraphicsScene::AddMeshDraw(Vector<Draw>& draws, GameObjectHandle handle) const {
+void GraphicsScene::AddMeshDraw(Vector<Draw>& draws, GameObjectHandle handle, VisibilityList& visibility, FrameStats& stats) const {
     PROFILE_EVENT_NC("AddDraw", COLOR_PROFILE_GRAPHICS);
 
     auto go{ world_.Get(handle) };
@@ -554,43 +723,97 @@ void GraphicsScene::AddMeshDraw(Vector<Draw>& draws, GameObjectHandle handle) co
         debugRenderer_.AddCircle(renderData.boundingShpere.center, renderData.boundingShpere.radius, glm::vec3{ 1, 0, 0 });
     }
 
-    const u32 flags{ instanceRenderData ? Draw::FLAG_INSTANCED : 0 };
-    const u32 variant{ instanceRenderData ? state_.SHADER_INSTANCED_MASK : 0 };
-
     gfxapi::BufferHandle vertexBuffer{};
     if (animatorRenderData && animatorRenderData->ready) {
         vertexBuffer = animatorRenderData->perFrameSkin[animatorRenderData->updateIndex].vertexBuffer;
     }
 
+    // Skinned output is always unpacked.
+    const auto packedVertices{ !vertexBuffer && model.GetModel()->PackedVertices() };
+
+    const u32 flags{ instanceRenderData ? Draw::FLAG_INSTANCED : 0 };
+    const u32 instanceVariant{ instanceRenderData ? state_.SHADER_INSTANCED_MASK : 0 };
+
     gfxapi::BufferHandle instanceBuffer{};
     if (instanceRenderData) {
         instanceBuffer = instanceRenderData->perFrameInstance[instanceRenderData->updateIndex].instanceBuffer;
     }
 
+    const auto meshVertexBuffer{ vertexBuffer ? vertexBuffer : model.GetModel()->VertexBuffer() };
+
     Draw draw{
         .instanceCount = instanceRenderData ? instanceRenderData->count : 1,
-        .vertexBuffer = vertexBuffer ? vertexBuffer : model.GetModel()->VertexBuffer(),
+        .vertexBuffer = meshVertexBuffer,
         .indexBuffer = model.GetModel()->IndexBuffer(),
         .instanceBuffer = instanceBuffer,
         .indexType = model.GetModel()->IndexType(),
         .stencil = go.GetStencil(),
     };
 
+    if (packedVertices) {
+        const auto& quantization{ model.GetModel()->Quantization() };
+        draw.positionScale = glm::vec4{ quantization.scale, 0.0f };
+        draw.positionOffset = glm::vec4{ quantization.offset, 0.0f };
+    }
+
+    // TODO: Per instance LOD, instances are rendered at full detail for now.
+    const auto lodCount{ instanceRenderData ? 1 : model.GetModel()->LodCount() };
+    const auto& lodView{ visibility.lod };
+    const auto& clusterView{ visibility.cluster };
+
+    // Entity indices are reused, a new mesh starts from previous selection clamped by SelectLod.
+    const auto index{ entt::to_entity(handle) };
+    if (index >= visibility.lods.Size()) {
+        visibility.lods.Resize(index + 1);
+    }
+
+    const auto lod{ SelectLod(lodView, renderData.boundingShpere, visibility.lods[index], lodCount) };
+    visibility.lods[index] = u8(lod);
+
+    // Bounding sphere diameter in pixels, clamped when the view is inside.
+    const auto texturePixels{ lodView.viewportHeight > 0.0f ? std::min(ScreenSize(lodView, renderData.boundingShpere), 16.0f) * lodView.viewportHeight : 0.0f };
+
+    // Clusters are built for LOD 0 rest pose only.
+    const auto clusterCulling{ clusterView.enabled && lod == 0 && !instanceRenderData && !animatorRenderData && !DisableClusterCulling.GetBool() };
+    Vector<IndexRange> ranges(engine_.FrameAllocator());
+
     for (auto& mesh : model.GetModel()->Meshes()) {
         auto material{ model.GetMaterial(mesh.materialIndex) };
         if (!material) {
             continue;
         }
 
+        // Shader without packed variant draws from unpacked copy.
+        const auto packed{ packedVertices && material->HasVariant(state_.SHADER_PACKED_VERTEX_MASK) };
+        const u32 variant{ instanceVariant | (packed ? state_.SHADER_PACKED_VERTEX_MASK : 0) };
+        draw.vertexBuffer = packedVertices && !packed ? model.GetModel()->UnpackedVertexBuffer() : meshVertexBuffer;
+
+        if (texturePixels > 0.0f) {
+            material->RequestTextureResolution(texturePixels);
+        }
+
         material->Prepare(state_, variant | (material->IsTransparent() ? state_.SHADER_OPACITY_MASK : 0));
 
         draw.flags = flags | (material->IsTransparent() ? Draw::FLAG_TRANSPARENT : 0);
         draw.model = mModel * mesh.transformation;
         draw.normal = mNormal * mesh.transformation;
-        draw.indexCount = mesh.indexCount;
-        draw.indexOffset = mesh.indexStart;
         draw.vertexOffset = mesh.vertexOffset;
 
+        const auto& meshLod{ mesh.lods[std::min<u32>(lod, u32(mesh.lods.Size()) - 1)] };
+        if (clusterCulling && !mesh.meshlets.Empty()) {
+            auto view{ clusterView };
+            view.backface = view.backface && !material->GetMaterialPipeline().doubleSided;
+
+            const auto result{ CullClusters(mesh.meshlets.ToSpan(), draw.model, view, u32(MaxClusterDraws.GetInt()), ranges) };
+            stats.clustersVisible += result.visible;
+            stats.clustersCulled += result.frustumCulled + result.backfaceCulled;
+        } else {
+            ranges.Clear();
+            ranges.PushBack(IndexRange{ .indexStart = meshLod.indexStart, .indexCount = meshLod.indexCount });
+        }
+
+        stats.trianglesNoLod += u64(mesh.indexCount / 3) * draw.instanceCount;
+
         draw.depthPipeline = material->GetPipeline(variant | state_.SHADER_DEPTH_PASS_MASK);
         draw.depthUniform = material->GetUniform(variant | state_.SHADER_DEPTH_PASS_MASK);
 
@@ -599,7 +822,13 @@ void GraphicsScene::AddMeshDraw(Vector<Draw>& draws, GameObjectHandle handle) co
 
         draw.sortKey = std::hash<ResourceID>{}(material->Id());
 
-        draws.PushBack(draw);
+        for (const auto& range : ranges) {
+            draw.indexOffset = range.indexStart;
+            draw.indexCount = range.indexCount;
+            draws.PushBack(draw);
+
+            stats.triangles += u64(range.indexCount / 3) * draw.instanceCount;
+        }
     }
 }
 
@@ -658,6 +887,7 @@ void GraphicsScene::CameraRenderDataCreated(GameObjectRegistry& reg, GameObjectH
     renderData.visibilityList = VisibilityList{
         .meshes = Vector<GameObjectHandle>{ allocator_ },
         .lights = Vector<GameObjectHandle>{ allocator_ },
+        .lods = Vector<u8>{ allocator_ },
     };
     renderData.cull.visibility = &renderData.visibilityList;
 
@@ -766,14 +996,7 @@ void GraphicsScene::UpdateMeshes() {
 
     updatedMeshes_.clear();
 
-    for (auto ent : translatedMeshes_) {
-        auto go{ world_.Get(ent) };
-        const auto& renderData{ go.Component<MeshRenderData>() };
-
-        if (renderData.modelReady) {
-            UpdateMeshAabb(go);
-        }
-    }
+    UpdateTranslatedMeshAabbs();
 
     translatedMeshes_.clear();
 }
@@ -1234,6 +1457,15 @@ void GraphicsScene::UpdateLightRenderData(LightRenderData& renderData, const Lig
 
     renderData.camera = CameraShaderData(lightCamera, invViewMatrix, transformation.position);
     renderData.cull.frustum = lightCamera.GetFrustum();
+
+    renderData.visibilityList.lod = LodView{
+        .position = transformation.position,
+        .projectionScale = lightCamera.ProjectionMatrix()[1][1],
+        .perspective = lightCamera.Type() == Camera::ProjectionType::Perspective,
+    };
+
+    // Shadow views render all clusters, single visibility list is used by all cube faces / cascades.
+    renderData.visibilityList.cluster = ClusterView{};
 }
 
 void GraphicsScene::UpdateLightTransformation(LightShaderData& l, const Transformation& transformation) const {
@@ -1312,7 +1544,7 @@ void GraphicsScene::UpdateMeshAabb(GameObject& go) const {
     UGINE_ASSERT(renderData.modelReady);
 
     renderData.modelMatrix = go.GlobalTransformation().Matrix();
-    renderData.invModelMatrix = glm::inverse(renderData.modelMatrix);
+    simd::InverseAffine({ &renderData.modelMatrix, 1 }, { &renderData.invModelMatrix, 1 });
 
     auto model{ renderData.modelInstance.GetModel().Get() };
 
@@ -1338,6 +1570,46 @@ void GraphicsScene::UpdateMeshAabb(GameObject& go) const {
     renderData.aabbReady = true;
 }
 
+void GraphicsScene::UpdateTranslatedMeshAabbs() {
+    PROFILE_EVENT_NC("UpdateTranslatedMeshAabbs", COLOR_PROFILE_GRAPHICS);
+
+    auto& allocator{ engine_.FrameAllocator() };
+
+    Vector<MeshRenderData*> meshes{ allocator };
+    Vector<glm::mat4> matrices{ allocator };
+    Vector<AABB> boxes{ allocator };
+    meshes.Reserve(translatedMeshes_.size());
+    matrices.Reserve(translatedMeshes_.size());
+    boxes.Reserve(translatedMeshes_.size());
+
+    for (auto ent : translatedMeshes_) {
+        auto go{ world_.Get(ent) };
+        auto& renderData{ go.Component<MeshRenderData>() };
+
+        if (renderData.modelReady) {
+            renderData.modelMatrix = go.GlobalTransformation().Matrix();
+
+            meshes.PushBack(&renderData);
+            matrices.PushBack(renderData.modelMatrix);
+            boxes.PushBack(renderData.modelInstance.GetModel()->BoundingBox());
+        }
+    }
+
+    // Model matrices are affine (translation, rotation, scale).
+    Vector<glm::mat4> inverses{ matrices.Size(), allocator };
+    simd::InverseAffine(matrices.ToSpan(), inverses.ToSpan());
+    simd::TransformAabbs(matrices.ToSpan(), boxes.ToSpan(), boxes.ToSpan());
+
+    for (size_t i{}; i < meshes.Size(); ++i) {
+        auto& renderData{ *meshes[i] };
+        renderData.invModelMatrix = inverses[i];
+        renderData.aabb = boxes[i];
+        renderData.boundingShpere.center = renderData.aabb.CenterPoint();
+        renderData.boundingShpere.radius = renderData.aabb.Diagonal() / 2.0f;
+        renderData.aabbReady = true;
+    }
+}
+
 void GraphicsScene::MeshRayCast(ParallelRayCast& rayCast, GameObjectHandle handle) const {
     PROFILE_EVENT_NC("MeshRayCast", COLOR_PROFILE_GRAPHICS);
 
@@ -1458,13 +1730,13 @@ void GraphicsScene::RenderCamera(gfxapi::CommandList& cmd, const GameObject& cam
     PROFILE_EVENT_NC("RenderCamera", COLOR_PROFILE_GRAPHICS);
 
     const auto& camera{ cameraGO.Component<CameraComponent>() };
-    const auto& renderData{ cameraGO.Component<CameraRenderData>() };
+    auto& renderData{ cameraGO.Component<CameraRenderData>() };
 
     // Per camera data.
     auto gpuCameraCB{ cmd.AllocateGPU(sizeof(shaders::Camera)) };
     *gpuCameraCB.As<shaders::Camera>() = renderData.camera;
 
-    auto draws{ GetDrawList(renderData.visibilityList) };
+    auto draws{ GetDrawList(renderData.visibilityList, frameStats_) };
 
     if (!DisableDrawSort.GetBool()) {
         std::sort(draws.begin(), draws.end(), [](const auto& a, const auto& b) { return a.sortKey < b.sortKey; });
@@ -1564,8 +1836,8 @@ void GraphicsScene::RenderCamera(gfxapi::CommandList& cmd, const GameObject& cam
 void GraphicsScene::RenderShadow(gfxapi::CommandList& cmd, const GameObject& go) {
     PROFILE_EVENT_NC("RenderShadow", COLOR_PROFILE_GRAPHICS);
 
-    const auto& renderData{ go.Component<LightRenderData>() };
-    auto draws{ GetDrawList(renderData.visibilityList) };
+    auto& renderData{ go.Component<LightRenderData>() };
+    auto draws{ GetDrawList(renderData.visibilityList, frameStats_) };
     frameStats_.drawCalls += u32(draws.Size());
 
     //state_.renderThread.PushRenderWork([this, draws = std::move(draws), &renderData](gfxapi::CommandList& cmd) mutable {
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <ugine/engine/engine/Engine.h>
+#include <ugine/engine/gfx/ClusterCulling.h>
 #include <ugine/engine/gfx/Component.h>
 #include <ugine/engine/gfx/GpuQuery.h>
 #include <ugine/engine/gfx/RenderContext.h>
@@ -31,6 +32,14 @@ struct AnimatorRenderData;
 struct InstanceRenderData;
 struct SkyRenderData;
 
+// View parameters for LOD selection.
+struct LodView {
+    glm::vec3 position{};
+    f32 projectionScale{}; // Projection matrix [1][1].
+    f32 viewportHeight{};  // Pixels, texture streaming requests only come from views with it set.
+    bool perspective{ true };
+};
+
 struct VisibilityList {
     enum Flags : u32 {
         FLAG_MESHES = UGINE_BIT(0),
@@ -46,6 +55,12 @@ struct VisibilityList {
     Vector<GameObjectHandle> meshes;
     Vector<GameObjectHandle> lights;
 
+    LodView lod{};
+    ClusterView cluster{};
+
+    // LOD selected by the view per mesh entity index, kept for hysteresis.
+    Vector<u8> lods;
+
     void Init() {
         drawCalls = 0;
         meshes.Clear();
@@ -81,6 +96,13 @@ public:
     struct FrameStats {
         u32 drawCalls{};
         u32 computeDispatches{};
+        u64 triangles{};
+        u64 trianglesNoLod{}; // Triangles if all meshes were rendered at LOD 0 without cluster culling.
+        u64 clustersVisible{};
+        u64 clustersCulled{};
+        u32 occlusionTested{};
+        u32 occlusionCulled{};
+        f32 occlusionMs{}; // CPU time of occluder rasterization and tests.
     };
 
     struct FrameGpuStats {
@@ -114,7 +136,7 @@ public:
     void CopyLightData(void* dst) const;
     size_t LightDataSize() const;
 
-    Vector<Draw> GetDrawList(const VisibilityList& visibility) const;
+    Vector<Draw> GetDrawList(VisibilityList& visibility, FrameStats& stats) const;
 
     gfxapi::TextureHandle GetCameraRtv(const GameObject& go) const;
     void SetCameraRtv(const GameObject& go, gfxapi::TextureHandle output, const gfxapi::Extent2D& extent);
@@ -138,6 +160,7 @@ private:
 
     void Cull(ParallelCull& cull, u32 flags) ;
     void StoreCullResults(ParallelCull& cull) const;
+    void CullOccluded(CameraRenderData& renderData);
 
     void WaitUpdate();
 
@@ -171,10 +194,11 @@ private:
     void InstancedRenderDataDestroyed(GameObjectRegistry& reg, GameObjectHandle ent);
     void UpdateMeshInstancedData(InstanceRenderData& renderData, const MeshComponent& mesh);
     void UpdateMeshAabb(GameObject& go) const;
+    void UpdateTranslatedMeshAabbs();
 
     void MeshModelReady(GameObject& go) const;
 
-    void AddMeshDraw(Vector<Draw>& draws, GameObjectHandle handle) const;
+    void AddMeshDraw(Vector<Draw>& draws, GameObjectHandle handle, VisibilityList& visibility, FrameStats& stats) const;
     void CullMeshes(ParallelCull& cull) ;
 
     void AddSkyDraw(Vector<Draw>& draws, const SkyRenderData& renderData) const;
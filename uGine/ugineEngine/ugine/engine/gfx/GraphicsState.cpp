@@ -2,6 +2,7 @@
 
 #include <ugine/engine/engine/Engine.h>
 #include <ugine/engine/gfx/Shapes.h>
+#include <ugine/engine/gfx/TextureStreamer.h>
 
 #include <ugine/engine/gfx/pass/DepthPrePass.h>
 #include <ugine/engine/gfx/pass/ForwardPass.h>
@@ -42,11 +43,13 @@ GraphicsState::GraphicsState(Engine& engine, gfxapi::Device& device, u32 framesI
     const char INSTANCED[] = "MATERIAL_INSTANCE";
     const char OPACITY[] = "MATERIAL_OPACITY";
     const char MASKED[] = "MATERIAL_MASKED";
+    const char PACKED_VERTEX[] = "VERTEX_PACKED";
 
     SHADER_DEPTH_PASS_MASK = UGINE_BIT(shaderVariants.GetVariantIndex(DEPTH_PASS));
     SHADER_INSTANCED_MASK = UGINE_BIT(shaderVariants.GetVariantIndex(INSTANCED));
     SHADER_OPACITY_MASK = UGINE_BIT(shaderVariants.GetVariantIndex(OPACITY));
     SHADER_MASKED_MASK = UGINE_BIT(shaderVariants.GetVariantIndex(MASKED));
+    SHADER_PACKED_VERTEX_MASK = UGINE_BIT(shaderVariants.GetVariantIndex(PACKED_VERTEX));
 
     // TODO:
     shadowMapResolution = Extent2D{ 512, 512 };
@@ -175,6 +178,8 @@ GraphicsState::GraphicsState(Engine& engine, gfxapi::Device& device, u32 framesI
     aoPass = MakeUnique<SsaoPass>(engine.GetAllocator(), *this);
     tonemappingPass = MakeUnique<TonemappingPass>(engine.GetAllocator(), *this);
 
+    textureStreamer = MakeUnique<TextureStreamer>(engine.GetAllocator(), engine, device, engine.GetAllocator());
+
     // Geometry.
     {
         auto [vertices, indices]{ CubeVertices(100) };
@@ -21,6 +21,7 @@ class ForwardPass;
 class LightCullingPass;
 class ShadowPass;
 class SsaoPass;
+class TextureStreamer;
 class TonemappingPass;
 
 // TODO: Basically a Renderer...
@@ -116,12 +117,15 @@ public:
     // Postprocess passes
     UniquePtr<TonemappingPass> tonemappingPass;
 
+    UniquePtr<TextureStreamer> textureStreamer;
+
     // TODO:
     ShaderVariants shaderVariants;
     u32 SHADER_DEPTH_PASS_MASK{};
     u32 SHADER_INSTANCED_MASK{};
     u32 SHADER_OPACITY_MASK{};
     u32 SHADER_MASKED_MASK{};
+    u32 SHADER_PACKED_VERTEX_MASK{};
 
     //RenderThread renderThread;
 
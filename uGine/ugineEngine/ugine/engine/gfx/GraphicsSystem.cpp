@@ -7,6 +7,7 @@
 #include "Material.h"
 #include "Model.h"
 #include "Texture.h"
+#include "TextureStreamer.h"
 
 #include <ugine/engine/core/ResourceStorage.h>
 
@@ -15,6 +16,7 @@
 #include <gfxapi/spirv/SpirvCompiler.h>
 
 #include <ugine/engine/core/ResourceManager.h>
+#include <ugine/engine/engine/CVars.h>
 #include <ugine/engine/engine/Engine.h>
 #include <ugine/engine/system/Platform.h>
 #include <ugine/engine/world/WorldManager.h>
@@ -33,6 +35,11 @@
 
 namespace ugine {
 
+namespace {
+    auto& UploadBudget{ CVars::Register(
+        "GPU upload budget", "Megabytes of streamed buffer and texture data submitted to GPU per frame", "graphics", CVar::Type::Float, 16.0f, 0.25f, 1024.0f) };
+} // namespace
+
 GraphicsSystem::GraphicsSystem(Engine& engine)
     : System{ engine }
     , swapchainFB_{ engine.GetAllocator() }
@@ -40,6 +47,13 @@ GraphicsSystem::GraphicsSystem(Engine& engine)
 
     engine.GetWorldManager().Connect<WorldManager::WorldCreatedEvent, &GraphicsSystem::OnWorldCreated>(this);
 
+    auto& resources{ engine.GetResources() };
+    resources.RegisterType<Texture>();
+    resources.RegisterType<Shader>();
+    resources.RegisterType<Animation>();
+    resources.RegisterType<Material>();
+    resources.RegisterType<Model>();
+
     const auto [appMajor, appMinor, appFile] = engine.GetParams().appVersion;
 
     gfxapi::DeviceCreateInfo deviceCI{
@@ -157,6 +171,11 @@ void GraphicsSystem::Update() {
 }
 
 void GraphicsSystem::Sync() {
+    // Residency changes requested by draws of this frame start uploading right away.
+    state_->textureStreamer->Update();
+
+    // Upload batches go to GPU queues before the frame using them.
+    device_->FlushUploads(u64(UploadBudget.GetFloat() * 1024.0f * 1024.0f));
 
     auto cmd{ device_->BeginCommandList() };
     auto clearValue{ gfxapi::ClearValue::Color(0, 0, 0, 1.0f) };
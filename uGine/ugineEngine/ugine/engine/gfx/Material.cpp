@@ -40,6 +40,13 @@ void Material::Prepare(GraphicsState& state, u32 variantMask) {
         return;
     }
 
+    // Instance params include textures of origin. Generations only grow, sum changes whenever either does.
+    const auto generation{ residencyGeneration_ + (IsInstance() && instanceOrigin_ ? instanceOrigin_->residencyGeneration_ : 0) };
+    if (generation != textureGeneration_) {
+        textureGeneration_ = generation;
+        InvalidateParams();
+    }
+
     const auto pipelineMask{ GetPipeline().VariantMask(variantMask) };
     auto& params{ paramsBuffer_.at(pipelineMask) };
 
@@ -347,10 +354,20 @@ void Material::InvalidateParams() {
     }
 }
 
+void Material::RequestTextureResolution(f32 pixels) {
+    for (auto& [_, texture] : textures_) {
+        texture->RequestResolution(pixels);
+    }
+    if (IsInstance() && instanceOrigin_) {
+        instanceOrigin_->RequestTextureResolution(pixels);
+    }
+}
+
 void Material::AddTexture(const ResourceID& id) {
     auto texture{ Manager().Get<Texture>(id) };
     if (texture) {
         AddDependency(texture.Get());
+        texture->AddUser(this);
         textures_[texture->Id()] = texture;
     }
 }
@@ -359,6 +376,7 @@ void Material::RemoveTexture(const ResourceID& id) {
     auto it{ textures_.find(id) };
     if (it != textures_.end()) {
         RemoveDependency(it->second.Get());
+        it->second->RemoveUser(this);
         textures_.erase(id);
     }
 }
@@ -366,6 +384,7 @@ void Material::RemoveTexture(const ResourceID& id) {
 void Material::RemoveTextures() {
     for (auto&& [_, texture] : textures_) {
         RemoveDependency(texture.Get());
+        texture->RemoveUser(this);
     }
     textures_.clear();
 }
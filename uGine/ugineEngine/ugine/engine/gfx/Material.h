@@ -28,6 +28,15 @@ struct MaterialVertex {
     glm::vec2 uv;
 };
 
+// Quantized MaterialVertex, decoded in ugine_material_vertex.hlsl (VERTEX_PACKED).
+// Position: unorm16 relative to model bounds (w unused), normal/tangent: octahedral snorm16, uv: half.
+struct MaterialVertexPacked {
+    u16 position[4];
+    u16 normal[2];
+    u16 tangent[2];
+    u16 uv[2];
+};
+
 // Instance 4x3 MVP.
 struct MaterialVertexInstance {
     glm::vec4 instance0{ 1, 0, 0, 0 };
@@ -160,9 +169,14 @@ public:
 
     void Prepare(GraphicsState& state, u32 variantMask);
 
+    // Streams textures for object of given projected size in pixels.
+    void RequestTextureResolution(f32 pixels);
+
     bool HasVariant(uint32_t variant) const;
 
 private:
+    friend class Texture;
+
     // Resource::*
     bool HandleLoad(Span<const u8> data) override;
     bool HandleUnload() override;
@@ -185,6 +199,8 @@ private:
     void DestroyParams();
 
     void InvalidateParams();
+    // Streamed texture changed bindless index, params of this material and its instances are rewritten.
+    void TextureResidencyChanged() { ++residencyGeneration_; }
 
     void AddTexture(const ResourceID& texture);
     void RemoveTexture(const ResourceID& texture);
@@ -216,6 +232,8 @@ private:
     std::unordered_map<u32, VariantParamBuffer> paramsBuffer_;
 
     std::unordered_map<ResourceID, ResourceHandle<Texture>> textures_;
+    u32 residencyGeneration_{}; // Bumped by textures.
+    u32 textureGeneration_{};   // Residency generations params were written with.
 }; // namespace ugine
 
 } // namespace ugine
\ No newline at end of file
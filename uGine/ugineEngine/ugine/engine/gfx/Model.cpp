@@ -14,6 +14,9 @@
 
 #include <glm/gtx/transform.hpp>
 
+#include <algorithm>
+#include <limits>
+
 namespace ugine {
 
 void Model::SetParentBone(u32 node, u32 parent) {
@@ -27,7 +30,7 @@ void Model::SetParentBone(u32 node, u32 parent) {
     }
 }
 
-bool Model::HandleLoad(Span<const u8> data) {
+bool Model::HandleDecode(Span<const u8> data) {
     PROFILE_EVENT();
 
     SerializedModel serializedModel{};
@@ -35,46 +38,54 @@ bool Model::HandleLoad(Span<const u8> data) {
         return false;
     }
 
-    aabb = AABB{ serializedModel.aabbMin, serializedModel.aabbMax };
+    const bool skinned{ !serializedModel.bones.empty() && !serializedModel.verticesSkinned.empty() };
+    if (skinned && serializedModel.bones.size() > MAX_PACKED_JOINTS) {
+        UGINE_ERROR("Model '{}' has {} bones, max {} supported.", Id().ToString().Data(), serializedModel.bones.size(), MAX_PACKED_JOINTS);
+        return false;
+    }
 
-    auto state{ Manager().GetEngine().GetState<GraphicsState>() };
-    UGINE_ASSERT(state);
+    auto& allocator{ Manager().GetAllocator() };
 
-    using namespace gfxapi;
+    auto decoded{ MakeUnique<Decoded>(allocator) };
+    decoded->aabb = AABB{ serializedModel.aabbMin, serializedModel.aabbMax };
 
     Vector<MaterialVertex> vertices;
 
     {
-        vertexCount = u32(serializedModel.vertices.size());
-        vertices.Reserve(vertexCount);
+        decoded->vertexCount = u32(serializedModel.vertices.size());
+        vertices.Reserve(decoded->vertexCount);
+
+        glm::vec3 min{ std::numeric_limits<f32>::max() };
+        glm::vec3 max{ std::numeric_limits<f32>::lowest() };
 
         for (const auto& vertex : serializedModel.vertices) {
             vertices.EmplaceBack(vertex.pos, vertex.normal, vertex.tangent, vertex.tex);
-        };
 
-        vertexBufferSize = sizeof(MaterialVertex) * vertices.Size();
-        BufferDesc desc{
-            .name = "ModelVertexData",
-            .flags = BufferFlags::Vertex | BufferFlags::Storage,
-            .size = vertexBufferSize,
+            min = glm::min(min, vertex.pos);
+            max = glm::max(max, vertex.pos);
         };
-        vertexBuffer = state->device.CreateBuffer(desc, vertices.Data(), vertexBufferSize);
+
+        // Skinned vertices are expanded by animation compute shader, which works with MaterialVertex.
+        decoded->packedVertices = serializedModel.packVertices && !skinned && !vertices.Empty();
+
+        if (decoded->packedVertices) {
+            decoded->quantization = VertexQuantization::FromBounds(min, max);
+
+            decoded->packed.Resize(vertices.Size());
+            PackVertices(vertices.ToSpan(), decoded->quantization, decoded->packed.ToSpan());
+        }
     }
 
     if (serializedModel.vertices.size() < 65536) {
-        Vector<u16> indices(serializedModel.indices.size());
+        auto& indices{ decoded->indices16 };
+        indices.Resize(serializedModel.indices.size());
         for (u32 i{}; i < indices.Size(); ++i) {
             UGINE_ASSERT(serializedModel.indices[i] < 65536);
             indices[i] = u16(serializedModel.indices[i]);
         }
-
-        indexBuffer = state->device.CreateIndexBuffer(indices);
-        indexType = gfxapi::IndexType::Uint16;
-    } else {
-        indexBuffer = state->device.CreateIndexBuffer(serializedModel.indices);
-        indexType = gfxapi::IndexType::Uint32;
     }
 
+    auto& meshes{ decoded->meshes };
     meshes.Resize(serializedModel.meshes.size());
     for (u32 i{}; i < serializedModel.meshes.size(); ++i) {
         const auto& serializedMesh{ serializedModel.meshes[i] };
@@ -84,8 +95,11 @@ bool Model::HandleLoad(Span<const u8> data) {
         meshes[i].vertexOffset = serializedMesh.vertexOffset;
         meshes[i].transformation = serializedMesh.transformation;
 
+        // CPU copies index model wide vertices.
         meshes[i].indices.Resize(meshes[i].indexCount);
-        memcpy(meshes[i].indices.Data(), serializedModel.indices.data(), meshes[i].indexCount * sizeof(u32));
+        for (u32 j{}; j < meshes[i].indexCount; ++j) {
+            meshes[i].indices[j] = serializedModel.indices[serializedMesh.indexOffset + j] + serializedMesh.vertexOffset;
+        }
         meshes[i].vertices.Resize(vertices.Size());
 
         for (u32 v{}; v < meshes[i].vertices.Size(); ++v) {
@@ -93,64 +107,190 @@ bool Model::HandleLoad(Span<const u8> data) {
         }
 
         meshes[i].materialIndex = serializedMesh.material;
-    }
 
-    materials.Resize(serializedModel.materialIds.size());
-    for (u32 i{}; i < serializedModel.materialIds.size(); ++i) {
-        const auto& materialId{ serializedModel.materialIds[i] };
+        meshes[i].lods.Reserve(1 + serializedMesh.lods.size());
+        meshes[i].lods.PushBack(Mesh::Lod{ .indexStart = serializedMesh.indexOffset, .indexCount = serializedMesh.indexCount });
+        for (const auto& lod : serializedMesh.lods) {
+            meshes[i].lods.PushBack(Mesh::Lod{ .indexStart = lod.indexOffset, .indexCount = lod.indexCount, .error = lod.error });
+        }
 
-        materials[i] = Manager().Get<Material>(materialId);
-        if (materials[i]) {
-            AddDependency(materials[i].Get());
-        } else {
-            // TODO: Null material.
-            UGINE_ASSERT("Invalid material");
+        decoded->lodCount = std::max(decoded->lodCount, u32(meshes[i].lods.Size()));
+
+        meshes[i].meshlets.Reserve(serializedMesh.meshlets.size());
+        for (const auto& meshlet : serializedMesh.meshlets) {
+            meshes[i].meshlets.PushBack(Mesh::Meshlet{
+                .indexStart = meshlet.indexOffset,
+                .indexCount = meshlet.indexCount,
+                .center = meshlet.center,
+                .radius = meshlet.radius,
+                .coneApex = meshlet.coneApex,
+                .coneAxis = meshlet.coneAxis,
+                .coneCutoff = meshlet.coneCutoff,
+            });
         }
     }
 
-    globalInverseTransform = serializedModel.globalInverseTransform;
-    rootTransform = serializedModel.rootTransform;
+    decoded->materialIds = std::move(serializedModel.materialIds);
+
+    decoded->globalInverseTransform = serializedModel.globalInverseTransform;
+    decoded->rootTransform = serializedModel.rootTransform;
 
-    nodes.Reserve(serializedModel.nodes.size());
+    decoded->nodes.Reserve(serializedModel.nodes.size());
     for (const auto& node : serializedModel.nodes) {
         const auto it{ serializedModel.boneNameToIndex.find(node.name) };
 
         const u32 boneIndex{ it == serializedModel.boneNameToIndex.end() ? INVALID_INDEX : it->second };
-        nodes.PushBack(Node{
-            .name = node.name.c_str(),
-            .id = StringID{ node.name.c_str() },
+        decoded->nodes.PushBack(Node{
+            .id = StringID::Intern(node.name),
             .transform = node.transformation,
-            .children = Vector<u32>{ node.children.data(), node.children.size(), Manager().GetAllocator() },
+            .children = Vector<u32>{ node.children.data(), node.children.size(), allocator },
             .boneIndex = boneIndex,
         });
     }
 
-    bones.Reserve(serializedModel.bones.size());
+    decoded->bones.Reserve(serializedModel.bones.size());
     for (const auto& bone : serializedModel.bones) {
-        bones.PushBack(Bone{
-            .name = bone.name.c_str(),
-            .id = StringID{ bone.name.c_str() },
+        decoded->bones.PushBack(Bone{
+            .id = StringID::Intern(bone.name),
             .offsetMatrix = bone.offsetMatrix,
         });
     }
 
+    if (skinned) {
+        decoded->skin.Resize(serializedModel.verticesSkinned.size());
+        for (u32 i{}; i < decoded->skin.Size(); ++i) {
+            decoded->skin[i] = PackSkin(serializedModel.verticesSkinned[i]);
+        }
+    }
+
+    decoded->unpackedSize = sizeof(MaterialVertex) * vertices.Size() + sizeof(SerializedSkin) * serializedModel.verticesSkinned.size();
+
+    if (!decoded->packedVertices) {
+        decoded->vertices = std::move(vertices);
+    }
+    if (decoded->indices16.Empty()) {
+        decoded->indices32 = std::move(serializedModel.indices);
+    }
+
+    decoded_ = std::move(decoded);
+    return true;
+}
+
+bool Model::HandleFinalize() {
+    PROFILE_EVENT();
+
+    UGINE_ASSERT(decoded_);
+
+    // Intermediate is released once copied for upload.
+    auto decoded{ std::move(decoded_) };
+
+    auto state{ Manager().GetEngine().GetState<GraphicsState>() };
+    UGINE_ASSERT(state);
+
+    using namespace gfxapi;
+
+    aabb = decoded->aabb;
+    vertexCount = decoded->vertexCount;
+    packedVertices = decoded->packedVertices;
+    quantization = decoded->quantization;
+
+    // Buffers are filled by upload queue, uploads complete in order so the last ticket covers all of them.
+    const auto upload{ [&](const char* name, BufferFlags flags, const void* data, u64 size) {
+        const auto buffer{ state->device.CreateBuffer(BufferDesc{ .name = name, .flags = flags, .size = size }) };
+        upload_ = state->device.UploadBuffer(buffer, data, size);
+        return buffer;
+    } };
+
+    if (packedVertices) {
+        vertexBufferSize = decoded->packed.DataSize();
+        vertexBuffer = upload("ModelVertexData", BufferFlags::Vertex | BufferFlags::Storage, decoded->packed.Data(), vertexBufferSize);
+        packedData = std::move(decoded->packed);
+    } else {
+        vertexBufferSize = decoded->vertices.DataSize();
+        vertexBuffer = upload("ModelVertexData", BufferFlags::Vertex | BufferFlags::Storage, decoded->vertices.Data(), vertexBufferSize);
+    }
+
+    if (!decoded->indices16.Empty()) {
+        indexBuffer = upload("ModelIndexData", BufferFlags::Index, decoded->indices16.Data(), decoded->indices16.DataSize());
+        indexType = gfxapi::IndexType::Uint16;
+    } else {
+        indexBuffer = upload("ModelIndexData", BufferFlags::Index, decoded->indices32.data(), sizeof(u32) * decoded->indices32.size());
+        indexType = gfxapi::IndexType::Uint32;
+    }
+
+    lodCount = decoded->lodCount;
+    meshes = std::move(decoded->meshes);
+
+    materials.Resize(decoded->materialIds.size());
+    for (u32 i{}; i < decoded->materialIds.size(); ++i) {
+        const auto& materialId{ decoded->materialIds[i] };
+
+        materials[i] = Manager().Get<Material>(materialId);
+        if (materials[i]) {
+            AddDependency(materials[i].Get());
+        } else {
+            // TODO: Null material.
+            UGINE_ASSERT("Invalid material");
+        }
+    }
+
+    globalInverseTransform = decoded->globalInverseTransform;
+    rootTransform = decoded->rootTransform;
+
+    nodes = std::move(decoded->nodes);
+    bones = std::move(decoded->bones);
+
     if (!bones.Empty()) {
         SetParentBone(0, INVALID_INDEX);
     }
 
-    if (!serializedModel.verticesSkinned.empty()) {
-        const u32 bufferSize{ u32(sizeof(SerializedSkin) * serializedModel.verticesSkinned.size()) };
-        BufferDesc desc{
-            .name = "ModelSkinData",
-            .flags = BufferFlags::Storage,
-            .size = bufferSize,
-        };
-        skinnedBuffer = state->device.CreateBuffer(desc, serializedModel.verticesSkinned.data(), bufferSize);
+    u64 skinBufferSize{};
+    if (!decoded->skin.Empty()) {
+        skinBufferSize = decoded->skin.DataSize();
+        skinnedBuffer = upload("ModelSkinData", BufferFlags::Storage, decoded->skin.Data(), skinBufferSize);
     }
 
+    UGINE_DEBUG("Model '{}' vertex data: {} B (unpacked {} B)", Id().ToString().Data(), vertexBufferSize + skinBufferSize, decoded->unpackedSize);
+
     return true;
 }
 
+gfxapi::BufferHandle Model::UnpackedVertexBuffer() {
+    if (!packedVertices || unpackedVertexBuffer) {
+        return unpackedVertexBuffer;
+    }
+
+    PROFILE_EVENT();
+
+    UGINE_WARN("Model '{}' is drawn with material without packed vertex variant, creating unpacked vertex buffer.", Id().ToString().Data());
+
+    auto state{ Manager().GetEngine().GetState<GraphicsState>() };
+    UGINE_ASSERT(state);
+
+    Vector<MaterialVertex> vertices(packedData.Size());
+    for (u32 i{}; i < packedData.Size(); ++i) {
+        vertices[i] = UnpackVertex(packedData[i], quantization);
+    }
+
+    using namespace gfxapi;
+
+    BufferDesc desc{
+        .name = "ModelVertexDataUnpacked",
+        .flags = BufferFlags::Vertex | BufferFlags::Storage,
+        .size = vertices.DataSize(),
+    };
+    unpackedVertexBuffer = state->device.CreateBuffer(desc, vertices.Data(), desc.size);
+
+    return unpackedVertexBuffer;
+}
+
+bool Model::PollUpload() {
+    auto state{ Manager().GetEngine().GetState<GraphicsState>() };
+    UGINE_ASSERT(state);
+
+    return state->device.IsUploadComplete(upload_);
+}
+
 ResourceHandle<Material> Model::GetMaterial(u32 slot) const {
     UGINE_ASSERT(slot < materials.Size());
 
@@ -182,6 +322,12 @@ bool Model::HandleUnload() {
         vertexBuffer = {};
     }
 
+    if (unpackedVertexBuffer) {
+        state->device.DestroyBuffer(unpackedVertexBuffer);
+        unpackedVertexBuffer = {};
+    }
+    packedData.Clear();
+
     if (indexBuffer) {
         state->device.DestroyBuffer(indexBuffer);
         indexBuffer = {};
@@ -192,10 +338,13 @@ bool Model::HandleUnload() {
         skinnedBuffer = {};
     }
 
+    upload_ = {};
+
     meshes.Clear();
     nodes.Clear();
     bones.Clear();
     sockets.Clear();
+    decoded_ = nullptr;
 
     for (auto& material : materials) {
         if (material) {
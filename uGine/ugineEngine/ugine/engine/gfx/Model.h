@@ -2,10 +2,12 @@
 
 #include <gfxapi/Types.h>
 
+#include <ugine/EventEmittor.h>
 #include <ugine/String.h>
 
 #include <ugine/engine/core/Resource.h>
 #include <ugine/engine/gfx/Material.h>
+#include <ugine/engine/gfx/VertexPacking.h>
 #include <ugine/engine/math/Aabb.h>
 #include <ugine/engine/math/Raycast.h>
 
@@ -30,6 +32,23 @@ public:
     void DeleteSocket(const StringID& name);
 
     struct Mesh {
+        struct Lod {
+            u32 indexStart{};
+            u32 indexCount{};
+            f32 error{};
+        };
+
+        // LOD 0 cluster, see ClusterCulling.h.
+        struct Meshlet {
+            u32 indexStart{};
+            u32 indexCount{};
+            glm::vec3 center{};
+            f32 radius{};
+            glm::vec3 coneApex{};
+            glm::vec3 coneAxis{};
+            f32 coneCutoff{ 1.0f };
+        };
+
         u32 indexStart{};
         u32 indexCount{};
         u32 vertexOffset{};
@@ -38,17 +57,19 @@ public:
 
         Vector<glm::vec3> vertices;
         Vector<u32> indices; // TODO: u32 / u16
+
+        Vector<Lod> lods; // lods[0] is full detail (indexStart/indexCount).
+        Vector<Meshlet> meshlets;
     };
 
+    // Names are interned, see StringID::Name().
     struct Bone {
-        String name;
         StringID id;
         glm::mat4 offsetMatrix;
         u32 parentBone{ INVALID_INDEX };
     };
 
     struct Node {
-        String name;
         StringID id;
         glm::mat4 transform;
         Vector<u32> children;
@@ -56,7 +77,6 @@ public:
     };
 
     struct Socket {
-        String name;
         StringID id;
         u32 boneIndex{};
         glm::mat4 offsetTransformation{ 1.0f };
@@ -72,10 +92,17 @@ public:
     u64 VertexBufferSize() const { return vertexBufferSize; }
     u32 VertexCount() const { return vertexCount; }
 
+    // Vertex buffer holds MaterialVertexPacked (skinned models are always MaterialVertex).
+    bool PackedVertices() const { return packedVertices; }
+    const VertexQuantization& Quantization() const { return quantization; }
+    // MaterialVertex copy of packed vertex buffer for materials without packed variant, created on first use.
+    gfxapi::BufferHandle UnpackedVertexBuffer();
+
     const glm::mat4& GlobalInverseTransform() const { return globalInverseTransform; }
     const glm::mat4& RootTransform() const { return rootTransform; }
 
     const Vector<Mesh>& Meshes() const { return meshes; }
+    u32 LodCount() const { return lodCount; }
     const Vector<Node>& Nodes() const { return nodes; }
     const Vector<Bone>& Bones() const { return bones; }
     const Vector<Socket>& Sockets() const { return sockets; }
@@ -98,6 +125,13 @@ private:
     u64 vertexBufferSize{};
     u32 vertexCount{};
 
+    bool packedVertices{};
+    VertexQuantization quantization{};
+    Vector<MaterialVertexPacked> packedData; // Source of unpacked buffer.
+    gfxapi::BufferHandle unpackedVertexBuffer;
+
+    u32 lodCount{ 1 }; // Max LOD count of all meshes.
+
     glm::mat4 globalInverseTransform{ 1.0f };
     glm::mat4 rootTransform{ 1.0f };
 
@@ -110,7 +144,34 @@ private:
     // AABB.
     AABB aabb{};
 
-    bool HandleLoad(Span<const u8> data) override;
+    // Built by worker decode, finalize uploads buffers and moves the rest to members.
+    struct Decoded {
+        AABB aabb{};
+        u32 vertexCount{};
+        bool packedVertices{};
+        VertexQuantization quantization{};
+        Vector<MaterialVertex> vertices;
+        Vector<MaterialVertexPacked> packed;
+        Vector<u16> indices16;
+        std::vector<u32> indices32;
+        Vector<SkinVertexPacked> skin;
+        u64 unpackedSize{};
+        u32 lodCount{ 1 };
+        glm::mat4 globalInverseTransform{ 1.0f };
+        glm::mat4 rootTransform{ 1.0f };
+        Vector<Mesh> meshes;
+        Vector<Node> nodes;
+        Vector<Bone> bones;
+        std::vector<ResourceID> materialIds;
+    };
+
+    UniquePtr<Decoded> decoded_;
+    gfxapi::UploadTicket upload_{};
+
+    bool SupportsDecode() const override { return true; }
+    bool HandleDecode(Span<const u8> data) override;
+    bool HandleFinalize() override;
+    bool PollUpload() override;
     bool HandleUnload() override;
 };
 
@@ -61,7 +61,7 @@ BlendDesc GetBlendDesc(MaterialBlending blending) {
     }
 }
 
-std::vector<VertexAttribute> ParseVertexAttributes(const Vector<Shader::VertexAttribute>& attribs) {
+std::vector<VertexAttribute> ParseVertexAttributes(const Vector<Shader::VertexAttribute>& attribs, bool packed) {
     std::vector<VertexAttribute> attributes{};
 
     for (const auto& attrib : attribs) {
@@ -71,23 +71,23 @@ std::vector<VertexAttribute> ParseVertexAttributes(const Vector<Shader::VertexAt
 
         if (attrib.name == "in.var.POSITION0" || attrib.name == "in.var.POSITION") {
             attribute.group = 0;
-            attribute.offset = offsetof(MaterialVertex, position);
-            attribute.format = gfxapi::Format::R32G32B32_Float;
+            attribute.offset = packed ? offsetof(MaterialVertexPacked, position) : offsetof(MaterialVertex, position);
+            attribute.format = packed ? gfxapi::Format::R16G16B16A16_Uint : gfxapi::Format::R32G32B32_Float;
             attribute.inputSlotClass = gfxapi::InputSlotClass::PerVertex;
         } else if (attrib.name == "in.var.NORMAL0" || attrib.name == "in.var.NORMAL") {
             attribute.group = 0;
-            attribute.offset = offsetof(MaterialVertex, normal);
-            attribute.format = gfxapi::Format::R32G32B32_Float;
+            attribute.offset = packed ? offsetof(MaterialVertexPacked, normal) : offsetof(MaterialVertex, normal);
+            attribute.format = packed ? gfxapi::Format::R16G16_Uint : gfxapi::Format::R32G32B32_Float;
             attribute.inputSlotClass = gfxapi::InputSlotClass::PerVertex;
         } else if (attrib.name == "in.var.TANGENT0" || attrib.name == "in.var.TANGENT") {
             attribute.group = 0;
-            attribute.offset = offsetof(MaterialVertex, tangent);
-            attribute.format = gfxapi::Format::R32G32B32_Float;
+            attribute.offset = packed ? offsetof(MaterialVertexPacked, tangent) : offsetof(MaterialVertex, tangent);
+            attribute.format = packed ? gfxapi::Format::R16G16_Uint : gfxapi::Format::R32G32B32_Float;
             attribute.inputSlotClass = gfxapi::InputSlotClass::PerVertex;
         } else if (attrib.name == "in.var.TEXCOORD0" || attrib.name == "in.var.TEXCOORD") {
             attribute.group = 0;
-            attribute.offset = offsetof(MaterialVertex, uv);
-            attribute.format = gfxapi::Format::R32G32_Float;
+            attribute.offset = packed ? offsetof(MaterialVertexPacked, uv) : offsetof(MaterialVertex, uv);
+            attribute.format = packed ? gfxapi::Format::R16G16_Uint : gfxapi::Format::R32G32_Float;
             attribute.inputSlotClass = gfxapi::InputSlotClass::PerVertex;
         } else if (attrib.name == "in.var.POSITION1") {
             attribute.group = 1;
@@ -134,6 +134,7 @@ Pipeline::Pipeline(GraphicsState& state, const MaterialPipeline& pipeline, Resou
         UGINE_DEBUG("-- Creating pipeline for shader {} variant {}", shader->Id().ToString().Data(), mask);
 
         const auto isDepthMask{ (mask & state.SHADER_DEPTH_PASS_MASK) != 0 };
+        const auto isPackedVertex{ (mask & state.SHADER_PACKED_VERTEX_MASK) != 0 };
 
         // TODO: Stencil.
         DepthStencilDesc depthStencil {
@@ -180,7 +181,7 @@ Pipeline::Pipeline(GraphicsState& state, const MaterialPipeline& pipeline, Resou
 
         UGINE_ASSERT(desc.renderPass);
 
-        const auto vertexAttributes{ ParseVertexAttributes(variant.vertexAttributes) };
+        const auto vertexAttributes{ ParseVertexAttributes(variant.vertexAttributes, isPackedVertex) };
 
         auto fill = [&](auto& compiled, const auto& binary) {
             compiled.name = shader->Name().Data();
@@ -225,7 +226,7 @@ Pipeline::Pipeline(GraphicsState& state, const MaterialPipeline& pipeline, Resou
 
         desc.inputAssembly.vertexBindingsCount = 1;
         desc.inputAssembly.vertexBindings[0].slot = InputSlotClass::PerVertex;
-        desc.inputAssembly.vertexBindings[0].dataStride = sizeof(MaterialVertex);
+        desc.inputAssembly.vertexBindings[0].dataStride = isPackedVertex ? sizeof(MaterialVertexPacked) : sizeof(MaterialVertex);
 
         const auto it{ std::find_if(vertexAttributes.begin(), vertexAttributes.end(), [&](const auto& attr) { return attr.group == 1; }) };
         if (it != vertexAttributes.end()) {
@@ -27,6 +27,10 @@ struct Draw {
     glm::mat4 model{};
     glm::mat4 normal{};
 
+    // Packed vertex position dequantization.
+    glm::vec4 positionScale{ 1.0f };
+    glm::vec4 positionOffset{ 0.0f };
+
     u32 indexCount{};
     u32 indexOffset{};
     u32 vertexOffset{};
@@ -1,11 +1,12 @@
 #pragma once
 
 #include <gfxapi/CommandList.h>
+#include <ugine/InplaceFunction.h>
 #include <ugine/Vector.h>
 
 #include <condition_variable>
-#include <functional>
 #include <mutex>
+#include <thread>
 
 namespace ugine {
 
@@ -17,7 +18,10 @@ public:
     void NextFrame(bool exit = false);
     void WaitSubmit();
 
-    template <typename T> void PushRenderWork(T&& work) { renderQueue_[SubmitQueue()].PushBack(std::move(work)); }
+    // Work captures are stored in the queue, queues keep their capacity so steady frames don't allocate.
+    static constexpr size_t RENDER_WORK_CAPTURE_SIZE{ 64 };
+
+    template <typename T> void PushRenderWork(T&& work) { renderQueue_[SubmitQueue()].EmplaceBack(std::forward<T>(work)); }
 
 private:
     bool WaitFrameStart();
@@ -25,7 +29,7 @@ private:
     void RenderDone();
     void RenderQueue();
 
-    using RenderWork = std::function<void(gfxapi::CommandList&)>;
+    using RenderWork = InplaceFunction<void(gfxapi::CommandList&), RENDER_WORK_CAPTURE_SIZE>;
     using RenderWorkQueue = Vector<RenderWork>;
 
     gfxapi::Device& device_;
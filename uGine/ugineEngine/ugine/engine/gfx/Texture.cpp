@@ -1,71 +1,129 @@
 #include "Texture.h"
+#include "Material.h"
+#include "TextureStreamer.h"
 
 #include <ugine/Image.h>
 #include <ugine/Profile.h>
 
 #include <ugine/engine/core/ResourceManager.h>
+#include <ugine/engine/engine/CVars.h>
 #include <ugine/engine/engine/Engine.h>
 #include <ugine/engine/gfx/GraphicsState.h>
 #include <ugine/engine/math/Math.h>
 
+#include <cmath>
+#include <limits>
+
 namespace ugine {
 
+namespace {
+    auto& DisableStreaming{ CVars::Register("Disable texture streaming", "Load whole mip chain of pre-mipped textures", "graphics", CVar::Type::Bool, false) };
+    auto& StreamingTailSize{ CVars::Register(
+        "Texture streaming tail size", "Max extent of mips loaded with texture, finer mips are streamed on demand", "graphics", CVar::Type::Int, 128, 1, 16384) };
+    auto& StreamingMipBias{ CVars::Register(
+        "Texture streaming mip bias", "Added to mip required by screen size, positive values save memory", "graphics", CVar::Type::Float, 0.0f, -4.0f, 4.0f) };
+
+    gfxapi::Format ToFormat(Image::Format format) {
+        switch (format) {
+        case Image::Format::BC1: return gfxapi::Format::BC1_Unorm;
+        case Image::Format::BC3: return gfxapi::Format::BC3_Unorm;
+        case Image::Format::BC5: return gfxapi::Format::BC5_Unorm;
+        case Image::Format::BC7: return gfxapi::Format::BC7_Unorm;
+        default: return gfxapi::Format::R8G8B8A8_Unorm; // TODO: Other uncompressed formats.
+        }
+    }
+} // namespace
+
 Texture::Texture(ResourceManager& resourceManager, const ResourceID& id)
     : Resource{ resourceManager, TYPE, id }
-    , bindlessIndex_{ resourceManager.GetAllocator() } {
+    , bindlessIndex_{ resourceManager.GetAllocator() }
+    , users_{ resourceManager.GetAllocator() } {
+}
+
+void Texture::RequestResolution(f32 pixels) {
+    if (!streamed_) {
+        return;
+    }
+
+    // Texel density matching object size on screen, texture is assumed to span the object once.
+    const auto extent{ f32(std::max(tailWidth_, tailHeight_) << tailMip_) };
+    const auto mip{ std::log2(extent / std::max(pixels, 1.0f)) + StreamingMipBias.GetFloat() };
+
+    requestedMip_ = std::min(requestedMip_, u32(std::clamp(mip, 0.0f, f32(tailMip_))));
 }
 
-bool Texture::HandleLoad(Span<const u8> data) {
+void Texture::AddUser(Material* material) {
+    if (users_.IndexOf(material) < 0) {
+        users_.PushBack(material);
+    }
+}
+
+void Texture::RemoveUser(Material* material) {
+    users_.Erase(material);
+}
+
+u64 Texture::MipChainBytes(u32 mip) const {
+    u64 bytes{};
+    for (auto m{ mip }; m < mips_; ++m) {
+        const auto width{ m < tailMip_ ? tailWidth_ << (tailMip_ - m) : std::max(tailWidth_ >> (m - tailMip_), 1u) };
+        const auto height{ m < tailMip_ ? tailHeight_ << (tailMip_ - m) : std::max(tailHeight_ >> (m - tailMip_), 1u) };
+        bytes += Image::DataSize(format_, width, height, pixelSize_) * layers_;
+    }
+    return bytes;
+}
+
+u32 Texture::MaxExtent(u32 mip) const {
+    UGINE_ASSERT(mip <= tailMip_);
+
+    // Source extent at tail mip was floor(extent >> tailMip), finer mip is below the next doubling.
+    return ((std::max(tailWidth_, tailHeight_) + 1) << (tailMip_ - mip)) - 1;
+}
+
+void Texture::HandleLoadStart(StringView file) {
+    fromFile_ = !file.Empty();
+}
+
+bool Texture::HandleDecode(Span<const u8> data) {
     PROFILE_EVENT();
 
-    Image image{ Manager().GetAllocator() };
-    if (!Image::FromMemoryEncoded(data, image)) {
+    // Streamer re-reads the file for finer mips, textures from memory and those it failed on load whole chain.
+    const auto stream{ fromFile_ && !streamingFailed_ && !DisableStreaming.GetBool() };
+    const auto maxExtent{ stream ? u32(StreamingTailSize.GetInt()) : std::numeric_limits<u32>::max() };
+
+    auto image{ MakeUnique<Image>(Manager().GetAllocator(), Manager().GetAllocator()) };
+    if (!Image::FromMemoryEncoded(data, *image, maxExtent)) {
         return false;
     }
-    using namespace gfxapi;
 
-    auto state{ Manager().GetEngine().GetState<GraphicsState>() };
-    UGINE_ASSERT(state);
+    decoded_ = std::move(image);
+    return true;
+}
 
-    Vector<SubresourceData> initialData{ image.Layers(), Manager().GetAllocator() };
-    for (u32 layer{}; layer < image.Layers(); ++layer) {
-        initialData[layer] = SubresourceData{
-            .data = image.GetLayer(layer).Data(),
-            .size = u64(image.Width() * image.Height() * image.PixelSize()),
-            .pitch = u64(image.Width() * image.PixelSize()),
-            .slicePitch = u64(image.Width() * image.Height() * image.PixelSize()),
-        };
-    }
+bool Texture::HandleFinalize() {
+    PROFILE_EVENT();
+
+    UGINE_ASSERT(decoded_);
+
+    // Intermediate is released once copied for upload.
+    auto decoded{ std::move(decoded_) };
+    auto& image{ *decoded };
 
     layers_ = image.Layers();
+    pixelSize_ = image.PixelSize();
+    format_ = image.GetFormat();
+    mips_ = image.BaseMip() + image.Mips();
+    tailMip_ = image.BaseMip();
+    tailWidth_ = image.Width();
+    tailHeight_ = image.Height();
+    residentMip_ = tailMip_;
+    wantedMip_ = tailMip_;
+    requestedMip_ = NO_REQUEST;
+    streamed_ = tailMip_ > 0;
 
     // TODO: Exceptions.
     // TODO: Depth/stencil support?
     try {
-        TextureMiscFlags miscFlags{};
-        if (image.IsCubemap()) {
-            miscFlags |= TextureMiscFlags::Cube;
-        }
-
-        texture_ = state->device.CreateTexture(
-            TextureDesc{
-                .name = "TextureResource", // TODO:
-                .extent = Extent2D{ image.Width(), image.Height() },
-                .arrayLayers = image.Layers(),
-                .format = Format::R8G8B8A8_Unorm, // TODO: Support other formats.
-                .usage = TextureUsageFlags::Sampled,
-                .misc = miscFlags,
-                .mipLevels = CalculateMipLevels(image.Width(), image.Height()),
-                .generateMips = true,
-            },
-            TextureLayout::ReadOnly, initialData);
-
-        bindlessIndex_.Resize(layers_);
-        bindlessIndex_[0] = state->device.GetTextureBindlessIndex(texture_, TextureAspectFlags::Color);
-        for (u32 i{ 1 }; i < layers_; ++i) {
-            bindlessIndex_[i] = gfxapi::BindlessInvalid;
-        }
-
+        texture_ = CreateTexture(image, upload_);
         return true;
     } catch (const std::exception& ex) {
         UGINE_ERROR("Failed to load texture: {}", ex.what());
@@ -73,20 +131,121 @@ bool Texture::HandleLoad(Span<const u8> data) {
     }
 }
 
+bool Texture::PollUpload() {
+    auto state{ Manager().GetEngine().GetState<GraphicsState>() };
+    UGINE_ASSERT(state);
+
+    if (!state->device.IsUploadComplete(upload_)) {
+        return false;
+    }
+
+    // Bindless slot is published only with valid content.
+    bindlessIndex_.Resize(layers_);
+    bindlessIndex_[0] = state->device.GetTextureBindlessIndex(texture_, gfxapi::TextureAspectFlags::Color);
+    for (u32 i{ 1 }; i < layers_; ++i) {
+        bindlessIndex_[i] = gfxapi::BindlessInvalid;
+    }
+
+    if (streamed_) {
+        state->textureStreamer->Register(this);
+    }
+
+    return true;
+}
+
 bool Texture::HandleUnload() {
     PROFILE_EVENT();
 
     auto state{ Manager().GetEngine().GetState<GraphicsState>() };
     UGINE_ASSERT(state);
 
+    if (streamed_) {
+        state->textureStreamer->Unregister(this);
+    }
+
     if (texture_) {
         state->device.DestroyTexture(texture_);
     }
     texture_ = {};
+    upload_ = {};
+    decoded_ = nullptr;
     layers_ = 0;
     bindlessIndex_.Clear();
+    fromFile_ = false;
+    streamed_ = false;
+    mips_ = 0;
+    residentMip_ = 0;
+    requestedMip_ = NO_REQUEST;
 
     return true;
 }
 
-} // namespace ugine
\ No newline at end of file
+gfxapi::TextureHandle Texture::CreateTexture(const Image& image, gfxapi::UploadTicket& upload) const {
+    using namespace gfxapi;
+
+    auto state{ Manager().GetEngine().GetState<GraphicsState>() };
+    UGINE_ASSERT(state);
+
+    // Single mip source gets mips generated, pre-mipped chain is uploaded as is. Compressed data can't be blitted.
+    const auto generateMips{ image.BaseMip() + image.Mips() == 1 && !image.IsCompressed() };
+    const auto subresourceMips{ generateMips ? 1 : image.Mips() };
+
+    Vector<SubresourceData> initialData{ Manager().GetAllocator() };
+    initialData.Reserve(subresourceMips * image.Layers());
+    for (u32 mip{}; mip < subresourceMips; ++mip) {
+        for (u32 layer{}; layer < image.Layers(); ++layer) {
+            const auto data{ image.GetMip(layer, mip) };
+            initialData.PushBack(SubresourceData{
+                .data = data.Data(),
+                .size = u64(data.Size()),
+                .pitch = image.MipWidth(mip) * image.PixelSize(),
+                .slicePitch = u32(data.Size()),
+            });
+        }
+    }
+
+    TextureMiscFlags miscFlags{};
+    if (image.IsCubemap()) {
+        miscFlags |= TextureMiscFlags::Cube;
+    }
+
+    const auto texture{ state->device.CreateTexture(
+        TextureDesc{
+            .name = "TextureResource", // TODO:
+            .extent = Extent2D{ image.Width(), image.Height() },
+            .arrayLayers = image.Layers(),
+            .format = ToFormat(image.GetFormat()),
+            .usage = TextureUsageFlags::Sampled | TextureUsageFlags::TransferDst,
+            .misc = miscFlags,
+            .mipLevels = generateMips ? CalculateMipLevels(image.Width(), image.Height()) : image.Mips(),
+            .generateMips = generateMips,
+        },
+        TextureLayout::Undefined) };
+
+    upload = state->device.UploadTexture(texture, TextureLayout::ReadOnly, initialData);
+    return texture;
+}
+
+void Texture::SetResident(gfxapi::TextureHandle texture, u32 mip) {
+    auto state{ Manager().GetEngine().GetState<GraphicsState>() };
+    UGINE_ASSERT(state);
+
+    // Frames in flight keep sampling the old texture, its destruction is deferred.
+    state->device.DestroyTexture(texture_);
+    texture_ = texture;
+    residentMip_ = mip;
+
+    bindlessIndex_[0] = state->device.GetTextureBindlessIndex(texture_, gfxapi::TextureAspectFlags::Color);
+    for (auto material : users_) {
+        material->TextureResidencyChanged();
+    }
+}
+
+void Texture::StreamingFailed() {
+    UGINE_WARN("Loading whole mip chain of texture '{}'", Manager().ResourceName(Id()).Data());
+
+    streamingFailed_ = true;
+    Manager().Reload<Texture>(Id());
+}
+
+} // namespace ugine
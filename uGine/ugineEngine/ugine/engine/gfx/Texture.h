@@ -1,5 +1,7 @@
 #pragma once
 
+#include <ugine/Image.h>
+
 #include <ugine/engine/core/Resource.h>
 #include <ugine/engine/core/ResourceManager.h>
 
@@ -8,7 +10,8 @@
 
 namespace ugine {
 
-class Image;
+class Material;
+class TextureStreamer;
 
 class Texture final : public Resource {
 public:
@@ -23,14 +26,62 @@ public:
     u32 GetBindlessIndex(u32 layer = 0) const { return layer < bindlessIndex_.Size() ? bindlessIndex_[layer] : gfxapi::BindlessInvalid; }
     u32 Layers() const { return layers_; }
 
+    // Mip streaming of pre-mipped textures loaded from file. Requests are gathered while collecting draws, TextureStreamer
+    // moves resident mips towards them within budget. Bindless index changes with residency, users are told when.
+    void RequestResolution(f32 pixels);
+    bool Streamed() const { return streamed_; }
+    u32 Mips() const { return mips_; }
+    u32 ResidentMip() const { return residentMip_; }
+    u64 MipChainBytes(u32 mip) const;
+
+    void AddUser(Material* material);
+    void RemoveUser(Material* material);
+
 protected:
-    bool HandleLoad(Span<const u8> data) override;
+    void HandleLoadStart(StringView file) override;
+    bool SupportsDecode() const override { return true; }
+    bool HandleDecode(Span<const u8> data) override;
+    bool HandleFinalize() override;
+    bool PollUpload() override;
     bool HandleUnload() override;
 
 private:
+    friend class TextureStreamer;
+
+    static constexpr u32 NO_REQUEST{ u32(-1) };
+
+    gfxapi::TextureHandle CreateTexture(const Image& image, gfxapi::UploadTicket& upload) const;
+    void SetResident(gfxapi::TextureHandle texture, u32 mip);
+
+    // Upper bound of extent of source mip, Image::FromMemoryEncoded with it loads chain from that mip.
+    u32 MaxExtent(u32 mip) const;
+
+    // Reloads whole mip chain, texture would be stuck at its tail otherwise.
+    void StreamingFailed();
+
+    UniquePtr<Image> decoded_;
+    gfxapi::UploadTicket upload_{};
+
     gfxapi::TextureHandle texture_;
     u32 layers_{};
     Vector<i32> bindlessIndex_;
+
+    // Streaming, mips are levels of source file.
+    bool fromFile_{};        // Finer mips can be re-read.
+    bool streamingFailed_{}; // Later loads take whole chain.
+    bool streamed_{};
+    u32 mips_{};
+    u32 residentMip_{};
+    u32 tailMip_{}; // Loaded with the resource, never evicted.
+    u32 tailWidth_{};
+    u32 tailHeight_{};
+    u32 pixelSize_{};
+    Image::Format format_{};
+    Vector<Material*> users_;
+
+    u32 requestedMip_{ NO_REQUEST }; // Finest mip requested since last streamer update.
+    u32 wantedMip_{};
+    u64 lastUsed_{};
 };
 
 } // namespace ugine
\ No newline at end of file
@@ -0,0 +1,322 @@
+#include "TextureStreamer.h"
+#include "Texture.h"
+
+#include <ugine/Metrics.h>
+#include <ugine/Profile.h>
+
+#include <ugine/engine/core/ResourceManager.h>
+#include <ugine/engine/engine/CVars.h>
+#include <ugine/engine/engine/Engine.h>
+
+#include <algorithm>
+
+namespace ugine {
+
+namespace {
+    auto& StreamingBudget{ CVars::Register(
+        "Texture streaming budget", "Megabytes of GPU memory for mips of streamed textures", "graphics", CVar::Type::Float, 512.0f, 16.0f, 16384.0f) };
+    auto& StreamingJobs{ CVars::Register("Texture streaming jobs", "Max texture residency changes in flight", "graphics", CVar::Type::Int, 8, 1, 64) };
+
+    // Textures not requested for this many frames don't want more than their tail.
+    constexpr u64 UNUSED_FRAMES{ 30 };
+} // namespace
+
+void TextureStreamer::Job::ExecuteRange(TaskSetPartition range, u32 threadnum) {
+    streamer->Decode(this);
+}
+
+TextureStreamer::TextureStreamer(Engine& engine, gfxapi::Device& device, IAllocator& allocator)
+    : engine_{ engine }
+    , device_{ device }
+    , allocator_{ allocator }
+    , textures_{ allocator }
+    , jobs_{ allocator }
+    , pool_{ allocator }
+    , free_{ allocator } {
+}
+
+TextureStreamer::~TextureStreamer() {
+    while (!jobs_.Empty()) {
+        Cancel(jobs_.Back());
+    }
+}
+
+void TextureStreamer::Register(Texture* texture) {
+    UGINE_ASSERT(texture->Streamed());
+
+    // Residency changes re-read the file. Textures not loaded from file have whole chain, path deregistered during load
+    // leaves nothing to re-read or reload.
+    if (engine_.GetResources().ResourcePath(texture->Id()).Empty()) {
+        UGINE_WARN("Texture '{}' has no file, mips can't be streamed", engine_.GetResources().ResourceName(texture->Id()).Data());
+        return;
+    }
+
+    texture->lastUsed_ = frame_;
+    textures_.PushBack(texture);
+}
+
+void TextureStreamer::Unregister(Texture* texture) {
+    if (auto job{ FindJob(texture) }) {
+        Cancel(job);
+    }
+    textures_.Erase(texture);
+}
+
+void TextureStreamer::Update() {
+    PROFILE_EVENT_N("Texture streaming");
+
+    ++frame_;
+    Poll();
+
+    stats_.upgradedLastFrame = 0;
+    stats_.evictedLastFrame = 0;
+
+    // Budget is checked against residency once running changes finish, old texture lives until then.
+    const auto target{ [this](const Texture* texture) {
+        const auto job{ FindJob(texture) };
+        return texture->MipChainBytes(job ? job->mip : texture->residentMip_);
+    } };
+
+    u64 committed{};
+    u64 resident{};
+    u64 requested{};
+
+    Vector<Texture*> upgrades{ engine_.FrameAllocator() };
+    Vector<Texture*> evictions{ engine_.FrameAllocator() };
+
+    for (auto texture : textures_) {
+        if (texture->requestedMip_ != Texture::NO_REQUEST) {
+            texture->wantedMip_ = texture->requestedMip_;
+            texture->requestedMip_ = Texture::NO_REQUEST;
+            texture->lastUsed_ = frame_;
+        } else if (frame_ - texture->lastUsed_ > UNUSED_FRAMES) {
+            texture->wantedMip_ = texture->tailMip_;
+        }
+
+        committed += target(texture);
+        resident += texture->MipChainBytes(texture->residentMip_);
+        requested += texture->MipChainBytes(texture->wantedMip_);
+
+        if (FindJob(texture)) {
+            continue;
+        }
+
+        if (texture->wantedMip_ < texture->residentMip_) {
+            upgrades.PushBack(texture);
+        } else if (texture->wantedMip_ > texture->residentMip_) {
+            evictions.PushBack(texture);
+        }
+    }
+
+    // Blurriest first, least recently used are evicted first.
+    std::sort(upgrades.begin(), upgrades.end(), [](const Texture* a, const Texture* b) {
+        const auto gapA{ a->residentMip_ - a->wantedMip_ };
+        const auto gapB{ b->residentMip_ - b->wantedMip_ };
+        return gapA != gapB ? gapA > gapB : a->lastUsed_ > b->lastUsed_;
+    });
+    std::sort(evictions.begin(), evictions.end(), [](const Texture* a, const Texture* b) { return a->lastUsed_ < b->lastUsed_; });
+
+    const auto budget{ u64(StreamingBudget.GetFloat() * 1024.0f * 1024.0f) };
+    auto slots{ i32(StreamingJobs.GetInt()) - i32(jobs_.Size()) };
+    size_t evicted{};
+
+    // Mips beyond what draws want are kept until something else needs the memory.
+    const auto evict{ [&](u64 needed) {
+        while (committed + needed > budget && evicted < evictions.Size() && slots > 0) {
+            auto texture{ evictions[evicted++] };
+            committed -= texture->MipChainBytes(texture->residentMip_) - texture->MipChainBytes(texture->wantedMip_);
+            Stream(texture, texture->wantedMip_);
+            --slots;
+            ++stats_.evictedLastFrame;
+        }
+    } };
+
+    for (auto texture : upgrades) {
+        if (slots <= 0) {
+            break;
+        }
+
+        const auto current{ texture->MipChainBytes(texture->residentMip_) };
+        evict(texture->MipChainBytes(texture->wantedMip_) - current);
+
+        // Finest mip that fits, possibly short of the wanted one.
+        auto mip{ texture->wantedMip_ };
+        while (mip < texture->residentMip_ && committed + texture->MipChainBytes(mip) - current > budget) {
+            ++mip;
+        }
+
+        if (mip < texture->residentMip_) {
+            committed += texture->MipChainBytes(mip) - current;
+            Stream(texture, mip);
+            --slots;
+            ++stats_.upgradedLastFrame;
+        }
+    }
+
+    // Budget may have been lowered.
+    evict(0);
+
+    stats_.textures = u32(textures_.Size());
+    stats_.streaming = u32(jobs_.Size());
+    stats_.residentBytes = resident;
+    stats_.requestedBytes = requested;
+    stats_.budgetBytes = budget;
+
+    UGINE_COUNTER_ADD("textures.upgrades", stats_.upgradedLastFrame);
+    UGINE_COUNTER_ADD("textures.evictions", stats_.evictedLastFrame);
+    UGINE_GAUGE_SET("textures.streamed", stats_.textures);
+    UGINE_GAUGE_SET("textures.streaming", stats_.streaming);
+    UGINE_GAUGE_SET("textures.residentBytes", stats_.residentBytes);
+    UGINE_GAUGE_SET("textures.requestedBytes", stats_.requestedBytes);
+}
+
+void TextureStreamer::Stream(Texture* texture, u32 mip) {
+    UGINE_ASSERT(!FindJob(texture));
+    UGINE_ASSERT(mip != texture->residentMip_ && mip <= texture->tailMip_);
+
+    auto job{ Acquire() };
+    job->texture = texture;
+    job->mip = mip;
+    job->stage = Stage::Reading;
+    jobs_.PushBack(job);
+
+    // Evictions only save memory, visible upgrades go first.
+    const auto priority{ mip < texture->residentMip_ ? IoPriority::Normal : IoPriority::Background };
+    job->request = engine_.GetFileSystem().ReadAsync(
+        engine_.GetResources().ResourcePath(texture->Id()), [job](IoData& data, bool success) { job->streamer->OnRead(job, data, success); },
+        false, priority);
+}
+
+void TextureStreamer::OnRead(Job* job, IoData& data, bool success) {
+    job->request = {};
+
+    if (!success) {
+        UGINE_WARN("Failed to stream texture '{}'", engine_.GetResources().ResourceName(job->texture->Id()).Data());
+
+        // Reload unregisters the texture, job goes first.
+        const auto texture{ job->texture };
+        jobs_.Erase(job);
+        Release(job);
+        Fallback(texture);
+        return;
+    }
+
+    job->data = data.Take();
+    job->stage = Stage::Decoding;
+
+    engine_.GetScheduler().Schedule(job);
+}
+
+void TextureStreamer::Decode(Job* job) {
+    PROFILE_EVENT_N("Texture mips decode");
+
+    // Texture doesn't change while its job runs, unload waits for decode.
+    const auto texture{ job->texture };
+
+    auto image{ MakeUnique<Image>(allocator_, allocator_) };
+    if (Image::FromMemoryEncoded(job->data.Data(), *image, texture->MaxExtent(job->mip)) && image->BaseMip() == job->mip
+        && image->Layers() == texture->layers_ && image->BaseMip() + image->Mips() == texture->mips_) {
+        job->image = std::move(image);
+        job->decoded = true;
+    }
+}
+
+void TextureStreamer::Poll() {
+    Vector<Texture*> failed{ engine_.FrameAllocator() };
+
+    for (size_t i{}; i < jobs_.Size();) {
+        auto job{ jobs_[i] };
+
+        bool done{};
+        switch (job->stage) {
+        case Stage::Reading: break;
+        case Stage::Decoding:
+            if (!job->GetIsComplete()) {
+                break;
+            }
+
+            if (job->decoded) {
+                try {
+                    job->target = job->texture->CreateTexture(*job->image, job->upload);
+                    job->stage = Stage::Uploading;
+                } catch (const std::exception& ex) {
+                    UGINE_ERROR("Failed to create streamed texture: {}", ex.what());
+                    failed.PushBack(job->texture);
+                    done = true;
+                }
+            } else {
+                UGINE_WARN("Texture '{}' changed, mips not streamed", engine_.GetResources().ResourceName(job->texture->Id()).Data());
+                failed.PushBack(job->texture);
+                done = true;
+            }
+
+            job->image = nullptr;
+            break;
+        case Stage::Uploading:
+            if (device_.IsUploadComplete(job->upload)) {
+                job->texture->SetResident(job->target, job->mip);
+                job->target = {};
+                done = true;
+            }
+            break;
+        }
+
+        if (done) {
+            jobs_.EraseAt(i);
+            Release(job);
+        } else {
+            ++i;
+        }
+    }
+
+    for (auto texture : failed) {
+        Fallback(texture);
+    }
+}
+
+void TextureStreamer::Fallback(Texture* texture) {
+    textures_.Erase(texture);
+    texture->StreamingFailed();
+}
+
+TextureStreamer::Job* TextureStreamer::FindJob(const Texture* texture) const {
+    const auto it{ std::find_if(jobs_.begin(), jobs_.end(), [texture](const Job* job) { return job->texture == texture; }) };
+    return it != jobs_.end() ? *it : nullptr;
+}
+
+void TextureStreamer::Cancel(Job* job) {
+    switch (job->stage) {
+    case Stage::Reading: engine_.GetFileSystem().Cancel(job->request); break;
+    case Stage::Decoding: engine_.GetScheduler().WaitFor(job); break;
+    case Stage::Uploading: device_.DestroyTexture(job->target); break;
+    }
+
+    jobs_.Erase(job);
+    Release(job);
+}
+
+TextureStreamer::Job* TextureStreamer::Acquire() {
+    if (!free_.Empty()) {
+        auto job{ free_.Back() };
+        free_.PopBack();
+        return job;
+    }
+
+    pool_.PushBack(MakeUnique<Job>(allocator_));
+    pool_.Back()->streamer = this;
+    return pool_.Back().Get();
+}
+
+void TextureStreamer::Release(Job* job) {
+    job->texture = nullptr;
+    job->decoded = false;
+    job->request = {};
+    job->image = nullptr;
+    job->target = {};
+    job->upload = {};
+    job->data = {};
+
+    free_.PushBack(job);
+}
+
+} // namespace ugine
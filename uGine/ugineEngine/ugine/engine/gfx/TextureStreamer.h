@@ -0,0 +1,94 @@
+#pragma once
+
+#include <gfxapi/Device.h>
+
+#include <ugine/FileSystem.h>
+#include <ugine/Image.h>
+#include <ugine/Memory.h>
+#include <ugine/Scheduler.h>
+#include <ugine/Vector.h>
+
+namespace ugine {
+
+class Engine;
+class Texture;
+
+// Moves resident mips of streamed textures towards mips requested by draws. Residency change re-reads the texture
+// file, decodes the new chain on worker job and uploads it to a new texture, which replaces the old one once the
+// upload completes. Textures not used recently are evicted to their tail mips first when the budget runs out.
+class TextureStreamer {
+public:
+    struct Stats {
+        u32 textures{};
+        u32 streaming{};
+        u32 upgradedLastFrame{};
+        u32 evictedLastFrame{};
+        u64 residentBytes{};
+        u64 requestedBytes{}; // If every texture had its requested mips.
+        u64 budgetBytes{};
+    };
+
+    TextureStreamer(Engine& engine, gfxapi::Device& device, IAllocator& allocator);
+    ~TextureStreamer();
+
+    TextureStreamer(const TextureStreamer&) = delete;
+    TextureStreamer& operator=(const TextureStreamer&) = delete;
+
+    void Register(Texture* texture);
+    void Unregister(Texture* texture);
+
+    // Collects requests of the frame, finishes residency changes and starts new ones. Runs before uploads are flushed.
+    void Update();
+
+    Stats GetStats() const { return stats_; }
+
+private:
+    enum class Stage : u8 {
+        Reading,
+        Decoding,
+        Uploading,
+    };
+
+    struct Job : TaskSet {
+        void ExecuteRange(TaskSetPartition range, u32 threadnum) override;
+
+        TextureStreamer* streamer{};
+        Texture* texture{};
+        Stage stage{};
+        u32 mip{};
+        bool decoded{};
+        FileSystem::RequestHandle request{};
+        IoData data; // Taken from IO queue.
+        UniquePtr<Image> image;
+        gfxapi::TextureHandle target{};
+        gfxapi::UploadTicket upload{};
+    };
+
+    void Stream(Texture* texture, u32 mip);
+    void OnRead(Job* job, IoData& data, bool success);
+    void Decode(Job* job); // Worker thread.
+    void Poll();
+    // Texture would stay at its tail, whole chain is loaded instead. Changed file is picked up by that too.
+    void Fallback(Texture* texture);
+
+    Job* FindJob(const Texture* texture) const;
+    void Cancel(Job* job);
+
+    Job* Acquire();
+    void Release(Job* job);
+
+    Engine& engine_;
+    gfxapi::Device& device_;
+    AllocatorRef allocator_;
+
+    u64 frame_{};
+    Vector<Texture*> textures_;
+    Vector<Job*> jobs_;
+
+    Vector<UniquePtr<Job>> pool_;
+    Vector<Job*> free_;
+
+    Stats stats_{};
+};
+
+} // namespace ugine
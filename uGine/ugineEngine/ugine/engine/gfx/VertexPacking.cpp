@@ -0,0 +1,116 @@
+#include "VertexPacking.h"
+
+#include <ugine/engine/gfx/asset/SerializedModel.h>
+
+#include <glm/gtc/packing.hpp>
+
+#include <algorithm>
+
+namespace ugine {
+
+namespace {
+    UGINE_FORCE_INLINE glm::vec2 SignNotZero(const glm::vec2& v) {
+        return glm::vec2{ v.x >= 0.0f ? 1.0f : -1.0f, v.y >= 0.0f ? 1.0f : -1.0f };
+    }
+
+    UGINE_FORCE_INLINE u16 PackUnorm16(f32 value) {
+        return u16(glm::round(glm::clamp(value, 0.0f, 1.0f) * 65535.0f));
+    }
+} // namespace
+
+VertexQuantization VertexQuantization::FromBounds(const glm::vec3& min, const glm::vec3& max) {
+    VertexQuantization result{
+        .offset = min,
+        .scale = max - min,
+    };
+
+    // Flat models, keep at least some extent so the division is defined.
+    result.scale = glm::max(result.scale, glm::vec3{ 1e-6f });
+    return result;
+}
+
+glm::u16vec2 PackOctahedral(const glm::vec3& normal) {
+    const auto sum{ glm::abs(normal.x) + glm::abs(normal.y) + glm::abs(normal.z) };
+    if (sum <= 0.0f) {
+        return glm::u16vec2{ glm::packSnorm1x16(0.0f), glm::packSnorm1x16(0.0f) };
+    }
+
+    const auto n{ normal / sum };
+    glm::vec2 p{ n.x, n.y };
+    if (n.z < 0.0f) {
+        p = (1.0f - glm::abs(glm::vec2{ n.y, n.x })) * SignNotZero(p);
+    }
+
+    return glm::u16vec2{ glm::packSnorm1x16(p.x), glm::packSnorm1x16(p.y) };
+}
+
+glm::vec3 UnpackOctahedral(const glm::u16vec2& packed) {
+    const glm::vec2 f{ glm::unpackSnorm1x16(packed.x), glm::unpackSnorm1x16(packed.y) };
+
+    glm::vec3 n{ f.x, f.y, 1.0f - glm::abs(f.x) - glm::abs(f.y) };
+    const auto t{ glm::clamp(-n.z, 0.0f, 1.0f) };
+    n.x += n.x >= 0.0f ? -t : t;
+    n.y += n.y >= 0.0f ? -t : t;
+
+    return glm::normalize(n);
+}
+
+MaterialVertexPacked PackVertex(const MaterialVertex& vertex, const VertexQuantization& quantization) {
+    const auto position{ (vertex.position - quantization.offset) / quantization.scale };
+    const auto normal{ PackOctahedral(vertex.normal) };
+    const auto tangent{ PackOctahedral(vertex.tangent) };
+
+    return MaterialVertexPacked{
+        .position = { PackUnorm16(position.x), PackUnorm16(position.y), PackUnorm16(position.z), 0 },
+        .normal = { normal.x, normal.y },
+        .tangent = { tangent.x, tangent.y },
+        .uv = { glm::packHalf1x16(vertex.uv.x), glm::packHalf1x16(vertex.uv.y) },
+    };
+}
+
+MaterialVertex UnpackVertex(const MaterialVertexPacked& vertex, const VertexQuantization& quantization) {
+    const glm::vec3 position{ vertex.position[0], vertex.position[1], vertex.position[2] };
+
+    return MaterialVertex{
+        .position = position / 65535.0f * quantization.scale + quantization.offset,
+        .normal = UnpackOctahedral(glm::u16vec2{ vertex.normal[0], vertex.normal[1] }),
+        .tangent = UnpackOctahedral(glm::u16vec2{ vertex.tangent[0], vertex.tangent[1] }),
+        .uv = glm::vec2{ glm::unpackHalf1x16(vertex.uv[0]), glm::unpackHalf1x16(vertex.uv[1]) },
+    };
+}
+
+void PackVertices(Span<const MaterialVertex> vertices, const VertexQuantization& quantization, Span<MaterialVertexPacked> out) {
+    UGINE_ASSERT(out.Size() >= vertices.Size());
+
+    for (size_t i{}; i < vertices.Size(); ++i) {
+        out[i] = PackVertex(vertices[i], quantization);
+    }
+}
+
+SkinVertexPacked PackSkin(const SerializedSkin& skin) {
+    SkinVertexPacked result{};
+
+    const auto sum{ skin.jointWeights.x + skin.jointWeights.y + skin.jointWeights.z + skin.jointWeights.w };
+    const auto weights{ sum > 0.0f ? skin.jointWeights / sum : glm::vec4{ 1, 0, 0, 0 } };
+
+    // Quantize weights and push the rounding error to the largest one, so they still sum up to 255.
+    u32 total{};
+    u32 largest{};
+    for (u32 i{}; i < 4; ++i) {
+        UGINE_ASSERT(u32(skin.jointIndices[i]) < MAX_PACKED_JOINTS);
+
+        result.joints[i] = u8(std::min(u32(skin.jointIndices[i]), MAX_PACKED_JOINTS - 1));
+        result.weights[i] = u8(glm::round(glm::clamp(weights[i], 0.0f, 1.0f) * 255.0f));
+        total += result.weights[i];
+
+        if (result.weights[i] > result.weights[largest]) {
+            largest = i;
+        }
+    }
+
+    result.weights[largest] = u8(i32(result.weights[largest]) + 255 - i32(total));
+
+    return result;
+}
+
+} // namespace ugine
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <ugine/Span.h>
+#include <ugine/Ugine.h>
+
+#include <ugine/engine/gfx/Material.h>
+
+#include <glm/glm.hpp>
+
+namespace ugine {
+
+struct SerializedSkin;
+
+// 8bit joint indices and unorm8 weights, decoded in animation.comp.hlsl.
+struct SkinVertexPacked {
+    u8 joints[4];
+    u8 weights[4];
+};
+
+// Position dequantization: position = packed * scale + offset.
+struct VertexQuantization {
+    glm::vec3 offset{ 0.0f };
+    glm::vec3 scale{ 1.0f };
+
+    static VertexQuantization FromBounds(const glm::vec3& min, const glm::vec3& max);
+};
+
+static_assert(sizeof(MaterialVertexPacked) == 20);
+static_assert(sizeof(SkinVertexPacked) == 8);
+
+// Max joint index addressable by SkinVertexPacked.
+inline constexpr u32 MAX_PACKED_JOINTS{ 256 };
+
+glm::u16vec2 PackOctahedral(const glm::vec3& normal);
+glm::vec3 UnpackOctahedral(const glm::u16vec2& packed);
+
+MaterialVertexPacked PackVertex(const MaterialVertex& vertex, const VertexQuantization& quantization);
+MaterialVertex UnpackVertex(const MaterialVertexPacked& vertex, const VertexQuantization& quantization);
+
+void PackVertices(Span<const MaterialVertex> vertices, const VertexQuantization& quantization, Span<MaterialVertexPacked> out);
+
+SkinVertexPacked PackSkin(const SerializedSkin& skin);
+
+} // namespace ugine
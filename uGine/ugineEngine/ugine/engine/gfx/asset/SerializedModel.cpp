@@ -14,8 +14,28 @@
 #include <bitsery/traits/string.h>
 #include <bitsery/traits/vector.h>
 
+#include <cstring>
+#include <limits>
+
 namespace ugine {
 
+namespace {
+    struct ModelFile {
+        static constexpr u32 MAGIC{ 0x4c444d55 }; // "UMDL"
+        // 1: Mesh LODs and meshlets, vertex packing flag.
+        static constexpr u32 VERSION{ 1 };
+
+        u32 magic{ MAGIC };
+        u32 version{ VERSION };
+        SerializedModel* model{};
+    };
+
+    // Files without header, meshes without LODs and meshlets.
+    struct LegacyModelFile {
+        SerializedModel* model{};
+    };
+} // namespace
+
 void serialize(auto& s, SerializedModel::Vertex& vertex) {
     s(vertex.pos);
     s(vertex.normal);
@@ -23,6 +43,22 @@ void serialize(auto& s, SerializedModel::Vertex& vertex) {
     s(vertex.tex);
 }
 
+void serialize(auto& s, SerializedModel::MeshLod& lod) {
+    s(lod.indexOffset);
+    s(lod.indexCount);
+    s(lod.error);
+}
+
+void serialize(auto& s, SerializedModel::Meshlet& meshlet) {
+    s(meshlet.indexOffset);
+    s(meshlet.indexCount);
+    s(meshlet.center);
+    s(meshlet.radius);
+    s(meshlet.coneApex);
+    s(meshlet.coneAxis);
+    s(meshlet.coneCutoff);
+}
+
 void serialize(auto& s, SerializedModel::Mesh& mesh) {
     s(mesh.name);
     s(mesh.transformation);
@@ -31,6 +67,8 @@ void serialize(auto& s, SerializedModel::Mesh& mesh) {
     s(mesh.indexCount);
     s(mesh.vertexOffset);
     s(mesh.transformation);
+    s(mesh.lods);
+    s(mesh.meshlets);
 }
 
 void serialize(auto& s, SerializedSkin& skin) {
@@ -65,19 +103,79 @@ void serialize(auto& s, SerializedModel& model) {
 
     s(model.aabbMin);
     s(model.aabbMax);
+
+    s(model.packVertices);
+}
+
+void serialize(auto& s, ModelFile& file) {
+    s(file.magic);
+    s(file.version);
+    s(*file.model);
+}
+
+void serialize(auto& s, LegacyModelFile& file) {
+    auto& model{ *file.model };
+
+    s(model.rootTransform);
+    s(model.globalInverseTransform);
+    s(model.vertices);
+    s(model.indices);
+    s.container(model.meshes, std::numeric_limits<size_t>::max(), [](auto& s, SerializedModel::Mesh& mesh) {
+        s(mesh.name);
+        s(mesh.transformation);
+        s(mesh.material);
+        s(mesh.indexOffset);
+        s(mesh.indexCount);
+        s(mesh.vertexOffset);
+        s(mesh.transformation);
+    });
+    s(model.materialIds);
+    s(model.verticesSkinned);
+
+    s(model.nodes);
+
+    s(model.bones);
+    s(model.boneNameToIndex);
+
+    s(model.aabbMin);
+    s(model.aabbMax);
 }
 
 bool LoadModel(Span<const u8> in, SerializedModel& out) {
     PROFILE_EVENT();
 
-    auto state{ bitsery::quickDeserialization(InputAdapter{ in.Data(), in.Size() }, out) };
+    u32 header[2]{};
+    if (in.Size() >= sizeof(header)) {
+        memcpy(header, in.Data(), sizeof(header));
+    }
+
+    if (header[0] != ModelFile::MAGIC) {
+        LegacyModelFile file{ &out };
+        auto state{ bitsery::quickDeserialization(InputAdapter{ in.Data(), in.Size() }, file) };
+        if (state.first != bitsery::ReaderError::NoError || !state.second) {
+            UGINE_ERROR("Invalid model data.");
+            return false;
+        }
+
+        UGINE_WARN("Model without LODs and meshlets loaded, reimport it to generate them.");
+        return true;
+    }
+
+    if (header[1] != ModelFile::VERSION) {
+        UGINE_ERROR("Unsupported model version {}, expected {}. Reimport the model.", header[1], ModelFile::VERSION);
+        return false;
+    }
+
+    ModelFile file{ .model = &out };
+    auto state{ bitsery::quickDeserialization(InputAdapter{ in.Data(), in.Size() }, file) };
     return state.first == bitsery::ReaderError::NoError;
 }
 
 bool SaveModel(const SerializedModel& in, Vector<u8>& out) {
     PROFILE_EVENT();
 
-    bitsery::quickSerialization(OutputAdapter{ out }, in);
+    ModelFile file{ .model = const_cast<SerializedModel*>(&in) };
+    bitsery::quickSerialization(OutputAdapter{ out }, file);
     return true;
 }
 
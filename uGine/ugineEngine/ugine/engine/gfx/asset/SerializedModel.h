@@ -65,6 +65,8 @@ struct SerializedSkin {
 struct SerializedModel {
     static const int BONES_PER_VERTEX{ 4 };
     static const u32 INVALID_INDEX{ u32(-1) };
+    static const u32 MAX_MESHLET_VERTICES{ 64 };
+    static const u32 MAX_MESHLET_TRIANGLES{ 124 };
 
     struct Vertex {
         glm::vec3 pos{};
@@ -78,6 +80,23 @@ struct SerializedModel {
         glm::mat4 offsetMatrix{ 1.0f };
     };
 
+    struct MeshLod {
+        u32 indexOffset{};
+        u32 indexCount{};
+        f32 error{}; // Simplification error relative to mesh extent.
+    };
+
+    // Cluster of LOD 0 triangles, see MAX_MESHLET_VERTICES / MAX_MESHLET_TRIANGLES.
+    struct Meshlet {
+        u32 indexOffset{};
+        u32 indexCount{};
+        glm::vec3 center{}; // Bounding sphere, mesh space.
+        f32 radius{};
+        glm::vec3 coneApex{}; // Backface cone, cluster faces away if dot(normalize(coneApex - eye), coneAxis) >= coneCutoff.
+        glm::vec3 coneAxis{};
+        f32 coneCutoff{ 1.0f };
+    };
+
     struct Mesh {
         std::string name;
         glm::mat4 transformation; // Root to mesh recursive transformation.
@@ -85,6 +104,8 @@ struct SerializedModel {
         u32 indexOffset{};
         u32 indexCount{};
         u32 vertexOffset{};
+        std::vector<MeshLod> lods; // Simplified levels, LOD 0 is indexOffset/indexCount.
+        std::vector<Meshlet> meshlets; // Partition of LOD 0 indices, empty if not built.
     };
 
     struct Node {
@@ -114,6 +135,9 @@ struct SerializedModel {
 
     glm::vec3 aabbMin{};
     glm::vec3 aabbMax{};
+
+    // Static vertices are quantized at load, see VertexPacking.h.
+    bool packVertices{ true };
 };
 
 bool LoadModel(Span<const u8> in, SerializedModel& out);
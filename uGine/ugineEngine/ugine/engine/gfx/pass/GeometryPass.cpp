@@ -93,6 +93,8 @@ void GeometryPass::RenderGeometry(gfxapi::CommandList& cmd, RenderContext& conte
         *buffer.As<shaders::Draw>() = shaders::Draw{
             .model = draw.model,
             .normal = draw.normal,
+            .positionScale = draw.positionScale,
+            .positionOffset = draw.positionOffset,
         };
         cmd.BindUniform(DATASET_DRAW, 0, buffer);
 
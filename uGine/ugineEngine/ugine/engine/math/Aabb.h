@@ -37,18 +37,13 @@ public:
         }
     }
 
+    // Center/extent form, same bounds as transforming all 8 corners for affine matrices. Batched version is
+    // simd::TransformAabbs.
     AABB Transform(const glm::mat4& mat) const {
-        glm::vec3 v[] = {
-            mat * glm::vec4(min_.x, min_.y, min_.z, 1.0f),
-            mat * glm::vec4(min_.x, min_.y, max_.z, 1.0f),
-            mat * glm::vec4(min_.x, max_.y, min_.z, 1.0f),
-            mat * glm::vec4(min_.x, max_.y, max_.z, 1.0f),
-            mat * glm::vec4(max_.x, min_.y, min_.z, 1.0f),
-            mat * glm::vec4(max_.x, min_.y, max_.z, 1.0f),
-            mat * glm::vec4(max_.x, max_.y, min_.z, 1.0f),
-            mat * glm::vec4(max_.x, max_.y, max_.z, 1.0f),
-        };
-        return AABB{ v, 8 };
+        const glm::vec3 center{ mat * glm::vec4{ CenterPoint(), 1.0f } };
+        const glm::mat3 absMat{ glm::abs(glm::vec3{ mat[0] }), glm::abs(glm::vec3{ mat[1] }), glm::abs(glm::vec3{ mat[2] }) };
+        const auto extent{ absMat * HalfSize() };
+        return AABB{ center - extent, center + extent };
     }
 
     AABB Translate(const glm::vec3& point) const { return AABB{ min_ + point, max_ + point }; }
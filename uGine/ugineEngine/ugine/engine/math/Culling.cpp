@@ -45,4 +45,37 @@ bool AabbInFrustum(const Frustum& frustum, const AABB& aabb) {
     return true;
 }
 
+Frustum FrustumFromMatrix(const glm::mat4& matrix) {
+    const auto m{ glm::transpose(matrix) };
+
+    Frustum frustum{
+        .planes = {
+            m[3] + m[0], // Left.
+            m[3] - m[0], // Right.
+            m[3] - m[1], // Top.
+            m[3] + m[1], // Bottom.
+            m[2],        // Near (far when reversed).
+            m[3] - m[2], // Far (near when reversed).
+        },
+    };
+
+    for (auto& plane : frustum.planes) {
+        const auto length{ glm::length(glm::vec3{ plane }) };
+        if (length > 0.0f) {
+            plane /= length;
+        }
+    }
+
+    return frustum;
+}
+
+bool SphereInFrustum(const Frustum& frustum, const glm::vec3& center, f32 radius) {
+    for (const auto& plane : frustum.planes) {
+        if (plane.x * center.x + plane.y * center.y + plane.z * center.z + plane.w < -radius) {
+            return false;
+        }
+    }
+    return true;
+}
+
 } // namespace ugine
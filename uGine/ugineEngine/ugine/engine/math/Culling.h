@@ -17,4 +17,10 @@ f32 PointAABBDistanceSquared(const AABB& aabb, const glm::vec3& point);
 
 bool AabbInFrustum(const Frustum& frustum, const AABB& aabb);
 
+// Normalized planes of (view) projection matrix with [0, 1] clip depth, inside is positive.
+Frustum FrustumFromMatrix(const glm::mat4& matrix);
+
+// Requires normalized planes.
+bool SphereInFrustum(const Frustum& frustum, const glm::vec3& center, f32 radius);
+
 } // namespace ugine
@@ -0,0 +1,200 @@
+#include "OcclusionBuffer.h"
+#include "Aabb.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <limits>
+
+namespace ugine {
+
+namespace {
+    constexpr f32 MIN_W{ 1e-5f };
+
+    UGINE_FORCE_INLINE f32 Edge(const glm::vec3& a, const glm::vec3& b, const glm::vec3& p) {
+        return (b.x - a.x) * (p.y - a.y) - (b.y - a.y) * (p.x - a.x);
+    }
+} // namespace
+
+OcclusionBuffer::OcclusionBuffer(u32 width, u32 height)
+    : width_{ width }
+    , height_{ height } {
+    UGINE_ASSERT(width > 0 && height > 0);
+
+    u32 size{};
+    u32 w{ width };
+    u32 h{ height };
+    while (true) {
+        levels_.PushBack(Level{ .width = w, .height = h, .offset = size });
+        size += w * h;
+
+        if (w == 1 && h == 1) {
+            break;
+        }
+
+        w = std::max(1u, (w + 1) / 2);
+        h = std::max(1u, (h + 1) / 2);
+    }
+
+    depth_.Resize(size);
+}
+
+void OcclusionBuffer::Clear(const glm::mat4& viewProj) {
+    viewProj_ = viewProj;
+    std::fill(depth_.begin(), depth_.end(), 1.0f);
+}
+
+glm::vec3 OcclusionBuffer::ToScreen(const glm::vec4& clip) const {
+    const glm::vec3 ndc{ clip / clip.w };
+    return glm::vec3{ (ndc.x * 0.5f + 0.5f) * f32(width_), (0.5f - ndc.y * 0.5f) * f32(height_), ndc.z };
+}
+
+void OcclusionBuffer::RasterizeTriangles(Span<const glm::vec3> vertices, Span<const u32> indices, const glm::mat4& model) {
+    const auto mvp{ viewProj_ * model };
+    const auto depth{ depth_.Data() };
+
+    for (size_t i{}; i + 2 < indices.Size(); i += 3) {
+        const glm::vec4 c0{ mvp * glm::vec4{ vertices[indices[i + 0]], 1.0f } };
+        const glm::vec4 c1{ mvp * glm::vec4{ vertices[indices[i + 1]], 1.0f } };
+        const glm::vec4 c2{ mvp * glm::vec4{ vertices[indices[i + 2]], 1.0f } };
+
+        if (c0.w < MIN_W || c1.w < MIN_W || c2.w < MIN_W) {
+            continue;
+        }
+
+        auto p0{ ToScreen(c0) };
+        auto p1{ ToScreen(c1) };
+        const auto p2{ ToScreen(c2) };
+
+        auto area{ Edge(p0, p1, p2) };
+        if (area == 0.0f) {
+            continue;
+        }
+
+        // Both windings are rasterized, make the edge functions positive inside.
+        if (area < 0.0f) {
+            std::swap(p0, p1);
+            area = -area;
+        }
+
+        const auto minX{ std::max(0, i32(std::floor(std::min({ p0.x, p1.x, p2.x })))) };
+        const auto maxX{ std::min(i32(width_) - 1, i32(std::floor(std::max({ p0.x, p1.x, p2.x })))) };
+        const auto minY{ std::max(0, i32(std::floor(std::min({ p0.y, p1.y, p2.y })))) };
+        const auto maxY{ std::min(i32(height_) - 1, i32(std::floor(std::max({ p0.y, p1.y, p2.y })))) };
+
+        if (minX > maxX || minY > maxY) {
+            continue;
+        }
+
+        const auto invArea{ 1.0f / area };
+
+        for (i32 y{ minY }; y <= maxY; ++y) {
+            for (i32 x{ minX }; x <= maxX; ++x) {
+                const glm::vec3 p{ f32(x) + 0.5f, f32(y) + 0.5f, 0.0f };
+
+                const auto w0{ Edge(p1, p2, p) };
+                const auto w1{ Edge(p2, p0, p) };
+                const auto w2{ Edge(p0, p1, p) };
+
+                if (w0 < 0.0f || w1 < 0.0f || w2 < 0.0f) {
+                    continue;
+                }
+
+                const auto z{ std::clamp((w0 * p0.z + w1 * p1.z + w2 * p2.z) * invArea, 0.0f, 1.0f) };
+
+                auto& d{ depth[y * width_ + x] };
+                d = std::min(d, z);
+            }
+        }
+    }
+}
+
+void OcclusionBuffer::BuildHiZ() {
+    for (size_t l{ 1 }; l < levels_.Size(); ++l) {
+        const auto& src{ levels_[l - 1] };
+        const auto& dst{ levels_[l] };
+
+        const auto srcDepth{ depth_.Data() + src.offset };
+        const auto dstDepth{ depth_.Data() + dst.offset };
+
+        for (u32 y{}; y < dst.height; ++y) {
+            const auto y0{ std::min(y * 2, src.height - 1) };
+            const auto y1{ std::min(y * 2 + 1, src.height - 1) };
+
+            for (u32 x{}; x < dst.width; ++x) {
+                const auto x0{ std::min(x * 2, src.width - 1) };
+                const auto x1{ std::min(x * 2 + 1, src.width - 1) };
+
+                dstDepth[y * dst.width + x] = std::max({
+                    srcDepth[y0 * src.width + x0],
+                    srcDepth[y0 * src.width + x1],
+                    srcDepth[y1 * src.width + x0],
+                    srcDepth[y1 * src.width + x1],
+                });
+            }
+        }
+    }
+}
+
+bool OcclusionBuffer::IsVisible(const AABB& aabb) const {
+    const auto& min{ aabb.Min() };
+    const auto& max{ aabb.Max() };
+
+    const std::array<glm::vec3, 8> corners{
+        glm::vec3{ min.x, min.y, min.z },
+        glm::vec3{ max.x, min.y, min.z },
+        glm::vec3{ min.x, max.y, min.z },
+        glm::vec3{ max.x, max.y, min.z },
+        glm::vec3{ min.x, min.y, max.z },
+        glm::vec3{ max.x, min.y, max.z },
+        glm::vec3{ min.x, max.y, max.z },
+        glm::vec3{ max.x, max.y, max.z },
+    };
+
+    glm::vec3 screenMin{ std::numeric_limits<f32>::max() };
+    glm::vec3 screenMax{ std::numeric_limits<f32>::lowest() };
+    for (const auto& corner : corners) {
+        const auto clip{ viewProj_ * glm::vec4{ corner, 1.0f } };
+
+        // Crosses near plane.
+        if (clip.w < MIN_W) {
+            return true;
+        }
+
+        const auto screen{ ToScreen(clip) };
+        screenMin = glm::min(screenMin, screen);
+        screenMax = glm::max(screenMax, screen);
+    }
+
+    // Outside of the buffer, leave it to frustum culling.
+    if (screenMax.x < 0.0f || screenMax.y < 0.0f || screenMin.x >= f32(width_) || screenMin.y >= f32(height_)) {
+        return true;
+    }
+
+    const auto x0{ u32(std::max(0.0f, screenMin.x)) };
+    const auto y0{ u32(std::max(0.0f, screenMin.y)) };
+    const auto x1{ std::min(width_ - 1, u32(std::max(0.0f, screenMax.x))) };
+    const auto y1{ std::min(height_ - 1, u32(std::max(0.0f, screenMax.y))) };
+
+    // Level where the rectangle covers at most 2x2 (3x3 when misaligned) texels.
+    const auto extent{ std::max(x1 - x0, y1 - y0) };
+    const auto level{ std::min(u32(std::bit_width(extent / 2)), LevelCount() - 1) };
+
+    f32 maxDepth{};
+    for (auto y{ y0 >> level }; y <= (y1 >> level); ++y) {
+        for (auto x{ x0 >> level }; x <= (x1 >> level); ++x) {
+            maxDepth = std::max(maxDepth, Depth(level, x, y));
+        }
+    }
+
+    return std::max(screenMin.z, 0.0f) <= maxDepth;
+}
+
+f32 OcclusionBuffer::Depth(u32 level, u32 x, u32 y) const {
+    const auto& l{ levels_[level] };
+    UGINE_ASSERT(x < l.width && y < l.height);
+    return depth_[l.offset + y * l.width + x];
+}
+
+} // namespace ugine
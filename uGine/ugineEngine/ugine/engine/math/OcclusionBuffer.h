@@ -0,0 +1,56 @@
+#pragma once
+
+#include <ugine/Span.h>
+#include <ugine/Ugine.h>
+#include <ugine/Vector.h>
+
+#include <glm/glm.hpp>
+
+namespace ugine {
+
+class AABB;
+
+// Software rasterized depth of occluder triangles with hierarchical max depth (Hi-Z) pyramid
+// for conservative bounding box occlusion tests. Depth is [0, 1] with 0 at near plane.
+class OcclusionBuffer {
+public:
+    static constexpr u32 DEFAULT_WIDTH{ 256 };
+    static constexpr u32 DEFAULT_HEIGHT{ 128 };
+
+    explicit OcclusionBuffer(u32 width = DEFAULT_WIDTH, u32 height = DEFAULT_HEIGHT);
+
+    // Starts new frame for given view.
+    void Clear(const glm::mat4& viewProj);
+
+    // Triangles crossing near plane are skipped.
+    void RasterizeTriangles(Span<const glm::vec3> vertices, Span<const u32> indices, const glm::mat4& model);
+
+    // Call after all occluders are rasterized.
+    void BuildHiZ();
+
+    // World space box, false if the box is fully behind occluders.
+    bool IsVisible(const AABB& aabb) const;
+
+    u32 Width() const { return width_; }
+    u32 Height() const { return height_; }
+    u32 LevelCount() const { return u32(levels_.Size()); }
+    f32 Depth(u32 level, u32 x, u32 y) const;
+
+private:
+    struct Level {
+        u32 width{};
+        u32 height{};
+        u32 offset{};
+    };
+
+    glm::vec3 ToScreen(const glm::vec4& clip) const;
+
+    u32 width_{};
+    u32 height_{};
+    glm::mat4 viewProj_{ 1.0f };
+
+    Vector<f32> depth_; // All levels.
+    Vector<Level> levels_;
+};
+
+} // namespace ugine
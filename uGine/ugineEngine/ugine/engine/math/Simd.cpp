@@ -0,0 +1,655 @@
+#include "Simd.h"
+
+#include <glm/gtx/transform.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+
+#if defined(_M_X64) || defined(_M_IX86)
+#define UGINE_SIMD_X86
+#include <immintrin.h>
+#include <intrin.h>
+#endif
+
+namespace ugine::simd {
+
+namespace {
+
+    static_assert(sizeof(glm::vec3) == 3 * sizeof(f32));
+    static_assert(sizeof(glm::mat4) == 16 * sizeof(f32));
+    static_assert(sizeof(glm::quat) == 4 * sizeof(f32) && offsetof(glm::quat, x) == 0 && offsetof(glm::quat, w) == 3 * sizeof(f32),
+        "SIMD kernels expect xyzw quaternion layout");
+
+    struct Kernels {
+        Level level{};
+
+        // Matrix stride is 0 for matrix shared by all items, 1 otherwise.
+        void (*transformAabbs)(const glm::mat4* matrices, size_t matrixStride, const AABB* boxes, AABB* out, size_t count){};
+        void (*multiply)(const glm::mat4* a, size_t aStride, const glm::mat4* b, glm::mat4* out, size_t count){};
+        void (*inverseAffine)(const glm::mat4* matrices, glm::mat4* out, size_t count){};
+        void (*compose)(const glm::vec3* positions, const glm::quat* rotations, const glm::vec3* scales, glm::mat4* out, size_t count){};
+    };
+
+    namespace scalar {
+
+        void TransformAabbs(const glm::mat4* matrices, size_t matrixStride, const AABB* boxes, AABB* out, size_t count) {
+            for (size_t i{}; i < count; ++i) {
+                out[i] = boxes[i].Transform(matrices[i * matrixStride]);
+            }
+        }
+
+        void Multiply(const glm::mat4* a, size_t aStride, const glm::mat4* b, glm::mat4* out, size_t count) {
+            for (size_t i{}; i < count; ++i) {
+                out[i] = a[i * aStride] * b[i];
+            }
+        }
+
+        glm::mat4 InverseAffine(const glm::mat4& matrix) {
+            const auto inv{ glm::inverse(glm::mat3{ matrix }) };
+            const auto translation{ -(inv * glm::vec3{ matrix[3] }) };
+            return glm::mat4{
+                glm::vec4{ inv[0], 0.0f },
+                glm::vec4{ inv[1], 0.0f },
+                glm::vec4{ inv[2], 0.0f },
+                glm::vec4{ translation, 1.0f },
+            };
+        }
+
+        void InverseAffine(const glm::mat4* matrices, glm::mat4* out, size_t count) {
+            for (size_t i{}; i < count; ++i) {
+                out[i] = InverseAffine(matrices[i]);
+            }
+        }
+
+        void Compose(const glm::vec3* positions, const glm::quat* rotations, const glm::vec3* scales, glm::mat4* out, size_t count) {
+            for (size_t i{}; i < count; ++i) {
+                out[i] = glm::translate(positions[i]) * glm::mat4_cast(rotations[i]) * glm::scale(scales[i]);
+            }
+        }
+
+        constexpr Kernels KERNELS{
+            .level = Level::Scalar,
+            .transformAabbs = &TransformAabbs,
+            .multiply = &Multiply,
+            .inverseAffine = &InverseAffine,
+            .compose = &Compose,
+        };
+
+    } // namespace scalar
+
+#ifdef UGINE_SIMD_X86
+    namespace sse {
+
+        template <int I> UGINE_FORCE_INLINE __m128 Splat(__m128 v) {
+            return _mm_shuffle_ps(v, v, _MM_SHUFFLE(I, I, I, I));
+        }
+
+        UGINE_FORCE_INLINE __m128 LoadVec3(const glm::vec3& v) {
+            const auto xy{ _mm_loadl_pi(_mm_setzero_ps(), reinterpret_cast<const __m64*>(&v.x)) };
+            return _mm_movelh_ps(xy, _mm_load_ss(&v.z));
+        }
+
+        UGINE_FORCE_INLINE glm::vec3 ToVec3(__m128 v) {
+            alignas(16) f32 values[4];
+            _mm_store_ps(values, v);
+            return glm::vec3{ values[0], values[1], values[2] };
+        }
+
+        UGINE_FORCE_INLINE __m128 Abs(__m128 v) {
+            return _mm_and_ps(v, _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff)));
+        }
+
+        UGINE_FORCE_INLINE __m128 Combine(__m128 c0, __m128 c1, __m128 c2, __m128 c3, __m128 v) {
+            const auto xy{ _mm_add_ps(_mm_mul_ps(c0, Splat<0>(v)), _mm_mul_ps(c1, Splat<1>(v))) };
+            const auto zw{ _mm_add_ps(_mm_mul_ps(c2, Splat<2>(v)), _mm_mul_ps(c3, Splat<3>(v))) };
+            return _mm_add_ps(xy, zw);
+        }
+
+        UGINE_FORCE_INLINE __m128 Cross(__m128 a, __m128 b) {
+            const auto aYzx{ _mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 0, 2, 1)) };
+            const auto bYzx{ _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 0, 2, 1)) };
+            const auto c{ _mm_sub_ps(_mm_mul_ps(a, bYzx), _mm_mul_ps(aYzx, b)) };
+            return _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 0, 2, 1));
+        }
+
+        // Sum of all lanes in all lanes.
+        UGINE_FORCE_INLINE __m128 HorizontalSum(__m128 v) {
+            const auto pairs{ _mm_add_ps(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1))) };
+            return _mm_add_ps(pairs, _mm_shuffle_ps(pairs, pairs, _MM_SHUFFLE(1, 0, 3, 2)));
+        }
+
+        // 4 packed vec3 (12 floats in 3 registers) to x, y, z registers.
+        UGINE_FORCE_INLINE void Deinterleave3(__m128 v0, __m128 v1, __m128 v2, __m128& x, __m128& y, __m128& z) {
+            const auto xy23{ _mm_shuffle_ps(v1, v2, _MM_SHUFFLE(2, 1, 3, 2)) };
+            const auto yz01{ _mm_shuffle_ps(v0, v1, _MM_SHUFFLE(1, 0, 2, 1)) };
+            x = _mm_shuffle_ps(v0, xy23, _MM_SHUFFLE(2, 0, 3, 0));
+            y = _mm_shuffle_ps(yz01, xy23, _MM_SHUFFLE(3, 1, 2, 0));
+            z = _mm_shuffle_ps(yz01, v2, _MM_SHUFFLE(3, 0, 3, 1));
+        }
+
+        UGINE_FORCE_INLINE void TransformAabb(__m128 c0, __m128 c1, __m128 c2, __m128 c3, __m128 a0, __m128 a1, __m128 a2, const AABB& box, AABB& out) {
+            const auto half{ _mm_set1_ps(0.5f) };
+            const auto min{ LoadVec3(box.Min()) };
+            const auto max{ LoadVec3(box.Max()) };
+            const auto center{ _mm_mul_ps(_mm_add_ps(min, max), half) };
+            const auto extent{ _mm_mul_ps(_mm_sub_ps(max, min), half) };
+
+            const auto newCenter{ _mm_add_ps(_mm_add_ps(_mm_mul_ps(c0, Splat<0>(center)), _mm_mul_ps(c1, Splat<1>(center))), _mm_add_ps(_mm_mul_ps(c2, Splat<2>(center)), c3)) };
+            const auto newExtent{ _mm_add_ps(_mm_add_ps(_mm_mul_ps(a0, Splat<0>(extent)), _mm_mul_ps(a1, Splat<1>(extent))), _mm_mul_ps(a2, Splat<2>(extent))) };
+
+            out = AABB{ ToVec3(_mm_sub_ps(newCenter, newExtent)), ToVec3(_mm_add_ps(newCenter, newExtent)) };
+        }
+
+        void TransformAabbs(const glm::mat4* matrices, size_t matrixStride, const AABB* boxes, AABB* out, size_t count) {
+            for (size_t i{}; i < count; ++i) {
+                const auto m{ &matrices[i * matrixStride][0].x };
+                const auto c0{ _mm_loadu_ps(m + 0) };
+                const auto c1{ _mm_loadu_ps(m + 4) };
+                const auto c2{ _mm_loadu_ps(m + 8) };
+                const auto c3{ _mm_loadu_ps(m + 12) };
+
+                TransformAabb(c0, c1, c2, c3, Abs(c0), Abs(c1), Abs(c2), boxes[i], out[i]);
+            }
+        }
+
+        void Multiply(const glm::mat4* a, size_t aStride, const glm::mat4* b, glm::mat4* out, size_t count) {
+            for (size_t i{}; i < count; ++i) {
+                const auto ma{ &a[i * aStride][0].x };
+                const auto a0{ _mm_loadu_ps(ma + 0) };
+                const auto a1{ _mm_loadu_ps(ma + 4) };
+                const auto a2{ _mm_loadu_ps(ma + 8) };
+                const auto a3{ _mm_loadu_ps(ma + 12) };
+
+                const auto mb{ &b[i][0].x };
+                const auto b0{ _mm_loadu_ps(mb + 0) };
+                const auto b1{ _mm_loadu_ps(mb + 4) };
+                const auto b2{ _mm_loadu_ps(mb + 8) };
+                const auto b3{ _mm_loadu_ps(mb + 12) };
+
+                const auto r0{ Combine(a0, a1, a2, a3, b0) };
+                const auto r1{ Combine(a0, a1, a2, a3, b1) };
+                const auto r2{ Combine(a0, a1, a2, a3, b2) };
+                const auto r3{ Combine(a0, a1, a2, a3, b3) };
+
+                const auto mo{ &out[i][0].x };
+                _mm_storeu_ps(mo + 0, r0);
+                _mm_storeu_ps(mo + 4, r1);
+                _mm_storeu_ps(mo + 8, r2);
+                _mm_storeu_ps(mo + 12, r3);
+            }
+        }
+
+        void InverseAffine(const glm::mat4* matrices, glm::mat4* out, size_t count) {
+            const auto xyzMask{ _mm_castsi128_ps(_mm_setr_epi32(-1, -1, -1, 0)) };
+            const auto unitW{ _mm_setr_ps(0.0f, 0.0f, 0.0f, 1.0f) };
+
+            for (size_t i{}; i < count; ++i) {
+                const auto m{ &matrices[i][0].x };
+                const auto c0{ _mm_and_ps(_mm_loadu_ps(m + 0), xyzMask) };
+                const auto c1{ _mm_and_ps(_mm_loadu_ps(m + 4), xyzMask) };
+                const auto c2{ _mm_and_ps(_mm_loadu_ps(m + 8), xyzMask) };
+                const auto t{ _mm_loadu_ps(m + 12) };
+
+                // Rows of the adjugate, inverse is adjugate / determinant.
+                auto r0{ Cross(c1, c2) };
+                auto r1{ Cross(c2, c0) };
+                auto r2{ Cross(c0, c1) };
+                auto r3{ _mm_setzero_ps() };
+
+                const auto invDet{ _mm_div_ps(_mm_set1_ps(1.0f), HorizontalSum(_mm_mul_ps(c0, r0))) };
+
+                _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+                r0 = _mm_mul_ps(r0, invDet);
+                r1 = _mm_mul_ps(r1, invDet);
+                r2 = _mm_mul_ps(r2, invDet);
+
+                const auto translation{ _mm_add_ps(_mm_add_ps(_mm_mul_ps(r0, Splat<0>(t)), _mm_mul_ps(r1, Splat<1>(t))), _mm_mul_ps(r2, Splat<2>(t))) };
+
+                const auto mo{ &out[i][0].x };
+                _mm_storeu_ps(mo + 0, r0);
+                _mm_storeu_ps(mo + 4, r1);
+                _mm_storeu_ps(mo + 8, r2);
+                _mm_storeu_ps(mo + 12, _mm_sub_ps(unitW, translation));
+            }
+        }
+
+        void Compose(const glm::vec3* positions, const glm::quat* rotations, const glm::vec3* scales, glm::mat4* out, size_t count) {
+            const auto one{ _mm_set1_ps(1.0f) };
+            const auto two{ _mm_set1_ps(2.0f) };
+
+            size_t i{};
+            for (; i + 4 <= count; i += 4) {
+                // Four bones at once in SoA form.
+                auto x{ _mm_loadu_ps(&rotations[i + 0].x) };
+                auto y{ _mm_loadu_ps(&rotations[i + 1].x) };
+                auto z{ _mm_loadu_ps(&rotations[i + 2].x) };
+                auto w{ _mm_loadu_ps(&rotations[i + 3].x) };
+                _MM_TRANSPOSE4_PS(x, y, z, w);
+
+                __m128 px, py, pz;
+                const auto p{ &positions[i].x };
+                Deinterleave3(_mm_loadu_ps(p + 0), _mm_loadu_ps(p + 4), _mm_loadu_ps(p + 8), px, py, pz);
+
+                __m128 sx, sy, sz;
+                const auto s{ &scales[i].x };
+                Deinterleave3(_mm_loadu_ps(s + 0), _mm_loadu_ps(s + 4), _mm_loadu_ps(s + 8), sx, sy, sz);
+
+                const auto x2{ _mm_mul_ps(x, two) };
+                const auto y2{ _mm_mul_ps(y, two) };
+                const auto z2{ _mm_mul_ps(z, two) };
+                const auto xx{ _mm_mul_ps(x, x2) };
+                const auto yy{ _mm_mul_ps(y, y2) };
+                const auto zz{ _mm_mul_ps(z, z2) };
+                const auto xy{ _mm_mul_ps(x, y2) };
+                const auto xz{ _mm_mul_ps(x, z2) };
+                const auto yz{ _mm_mul_ps(y, z2) };
+                const auto wx{ _mm_mul_ps(w, x2) };
+                const auto wy{ _mm_mul_ps(w, y2) };
+                const auto wz{ _mm_mul_ps(w, z2) };
+
+                auto m00{ _mm_mul_ps(_mm_sub_ps(one, _mm_add_ps(yy, zz)), sx) };
+                auto m01{ _mm_mul_ps(_mm_add_ps(xy, wz), sx) };
+                auto m02{ _mm_mul_ps(_mm_sub_ps(xz, wy), sx) };
+                auto m03{ _mm_setzero_ps() };
+
+                auto m10{ _mm_mul_ps(_mm_sub_ps(xy, wz), sy) };
+                auto m11{ _mm_mul_ps(_mm_sub_ps(one, _mm_add_ps(xx, zz)), sy) };
+                auto m12{ _mm_mul_ps(_mm_add_ps(yz, wx), sy) };
+                auto m13{ _mm_setzero_ps() };
+
+                auto m20{ _mm_mul_ps(_mm_add_ps(xz, wy), sz) };
+                auto m21{ _mm_mul_ps(_mm_sub_ps(yz, wx), sz) };
+                auto m22{ _mm_mul_ps(_mm_sub_ps(one, _mm_add_ps(xx, yy)), sz) };
+                auto m23{ _mm_setzero_ps() };
+
+                auto m33{ one };
+
+                // Back to AoS, each transpose yields one column of the four matrices.
+                _MM_TRANSPOSE4_PS(m00, m01, m02, m03);
+                _MM_TRANSPOSE4_PS(m10, m11, m12, m13);
+                _MM_TRANSPOSE4_PS(m20, m21, m22, m23);
+                _MM_TRANSPOSE4_PS(px, py, pz, m33);
+
+                const __m128 columns[4][4]{
+                    { m00, m10, m20, px },
+                    { m01, m11, m21, py },
+                    { m02, m12, m22, pz },
+                    { m03, m13, m23, m33 },
+                };
+
+                for (u32 j{}; j < 4; ++j) {
+                    const auto mo{ &out[i + j][0].x };
+                    _mm_storeu_ps(mo + 0, columns[j][0]);
+                    _mm_storeu_ps(mo + 4, columns[j][1]);
+                    _mm_storeu_ps(mo + 8, columns[j][2]);
+                    _mm_storeu_ps(mo + 12, columns[j][3]);
+                }
+            }
+
+            scalar::Compose(positions + i, rotations + i, scales + i, out + i, count - i);
+        }
+
+        constexpr Kernels KERNELS{
+            .level = Level::SSE2,
+            .transformAabbs = &TransformAabbs,
+            .multiply = &Multiply,
+            .inverseAffine = &InverseAffine,
+            .compose = &Compose,
+        };
+
+    } // namespace sse
+
+    namespace avx2 {
+
+        // Two items per register, one in each 128 bit lane. Shuffles work within lanes, so SSE algorithms apply as is.
+        template <int I> UGINE_FORCE_INLINE __m256 Splat(__m256 v) {
+            return _mm256_permute_ps(v, _MM_SHUFFLE(I, I, I, I));
+        }
+
+        UGINE_FORCE_INLINE __m256 Load2(const f32* lo, const f32* hi) {
+            return _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(lo)), _mm_loadu_ps(hi), 1);
+        }
+
+        UGINE_FORCE_INLINE void Store2(f32* lo, f32* hi, __m256 v) {
+            _mm_storeu_ps(lo, _mm256_castps256_ps128(v));
+            _mm_storeu_ps(hi, _mm256_extractf128_ps(v, 1));
+        }
+
+        UGINE_FORCE_INLINE __m256 Abs(__m256 v) {
+            return _mm256_and_ps(v, _mm256_castsi256_ps(_mm256_set1_epi32(0x7fffffff)));
+        }
+
+        UGINE_FORCE_INLINE __m256 Combine(__m256 c0, __m256 c1, __m256 c2, __m256 c3, __m256 v) {
+            const auto xy{ _mm256_fmadd_ps(c1, Splat<1>(v), _mm256_mul_ps(c0, Splat<0>(v))) };
+            const auto zw{ _mm256_fmadd_ps(c3, Splat<3>(v), _mm256_mul_ps(c2, Splat<2>(v))) };
+            return _mm256_add_ps(xy, zw);
+        }
+
+        UGINE_FORCE_INLINE __m256 Cross(__m256 a, __m256 b) {
+            const auto aYzx{ _mm256_permute_ps(a, _MM_SHUFFLE(3, 0, 2, 1)) };
+            const auto bYzx{ _mm256_permute_ps(b, _MM_SHUFFLE(3, 0, 2, 1)) };
+            const auto c{ _mm256_fmsub_ps(a, bYzx, _mm256_mul_ps(aYzx, b)) };
+            return _mm256_permute_ps(c, _MM_SHUFFLE(3, 0, 2, 1));
+        }
+
+        UGINE_FORCE_INLINE __m256 HorizontalSum(__m256 v) {
+            const auto pairs{ _mm256_add_ps(v, _mm256_permute_ps(v, _MM_SHUFFLE(2, 3, 0, 1))) };
+            return _mm256_add_ps(pairs, _mm256_permute_ps(pairs, _MM_SHUFFLE(1, 0, 3, 2)));
+        }
+
+        UGINE_FORCE_INLINE void Transpose4(__m256& r0, __m256& r1, __m256& r2, __m256& r3) {
+            const auto t0{ _mm256_unpacklo_ps(r0, r1) };
+            const auto t1{ _mm256_unpacklo_ps(r2, r3) };
+            const auto t2{ _mm256_unpackhi_ps(r0, r1) };
+            const auto t3{ _mm256_unpackhi_ps(r2, r3) };
+            r0 = _mm256_shuffle_ps(t0, t1, _MM_SHUFFLE(1, 0, 1, 0));
+            r1 = _mm256_shuffle_ps(t0, t1, _MM_SHUFFLE(3, 2, 3, 2));
+            r2 = _mm256_shuffle_ps(t2, t3, _MM_SHUFFLE(1, 0, 1, 0));
+            r3 = _mm256_shuffle_ps(t2, t3, _MM_SHUFFLE(3, 2, 3, 2));
+        }
+
+        UGINE_FORCE_INLINE void Deinterleave3(__m256 v0, __m256 v1, __m256 v2, __m256& x, __m256& y, __m256& z) {
+            const auto xy23{ _mm256_shuffle_ps(v1, v2, _MM_SHUFFLE(2, 1, 3, 2)) };
+            const auto yz01{ _mm256_shuffle_ps(v0, v1, _MM_SHUFFLE(1, 0, 2, 1)) };
+            x = _mm256_shuffle_ps(v0, xy23, _MM_SHUFFLE(2, 0, 3, 0));
+            y = _mm256_shuffle_ps(yz01, xy23, _MM_SHUFFLE(3, 1, 2, 0));
+            z = _mm256_shuffle_ps(yz01, v2, _MM_SHUFFLE(3, 0, 3, 1));
+        }
+
+        UGINE_FORCE_INLINE __m256 LoadVec3x2(const glm::vec3& lo, const glm::vec3& hi) {
+            return _mm256_insertf128_ps(_mm256_castps128_ps256(sse::LoadVec3(lo)), sse::LoadVec3(hi), 1);
+        }
+
+        void TransformAabbs(const glm::mat4* matrices, size_t matrixStride, const AABB* boxes, AABB* out, size_t count) {
+            const auto half{ _mm256_set1_ps(0.5f) };
+
+            size_t i{};
+            for (; i + 2 <= count; i += 2) {
+                const auto m0{ &matrices[i * matrixStride][0].x };
+                const auto m1{ &matrices[(i + 1) * matrixStride][0].x };
+                const auto c0{ Load2(m0 + 0, m1 + 0) };
+                const auto c1{ Load2(m0 + 4, m1 + 4) };
+                const auto c2{ Load2(m0 + 8, m1 + 8) };
+                const auto c3{ Load2(m0 + 12, m1 + 12) };
+
+                const auto min{ LoadVec3x2(boxes[i].Min(), boxes[i + 1].Min()) };
+                const auto max{ LoadVec3x2(boxes[i].Max(), boxes[i + 1].Max()) };
+                const auto center{ _mm256_mul_ps(_mm256_add_ps(min, max), half) };
+                const auto extent{ _mm256_mul_ps(_mm256_sub_ps(max, min), half) };
+
+                const auto newCenter{ _mm256_fmadd_ps(c2, Splat<2>(center), _mm256_fmadd_ps(c1, Splat<1>(center), _mm256_fmadd_ps(c0, Splat<0>(center), c3))) };
+                const auto newExtent{ _mm256_fmadd_ps(
+                    Abs(c2), Splat<2>(extent), _mm256_fmadd_ps(Abs(c1), Splat<1>(extent), _mm256_mul_ps(Abs(c0), Splat<0>(extent)))) };
+
+                const auto newMin{ _mm256_sub_ps(newCenter, newExtent) };
+                const auto newMax{ _mm256_add_ps(newCenter, newExtent) };
+
+                out[i] = AABB{ sse::ToVec3(_mm256_castps256_ps128(newMin)), sse::ToVec3(_mm256_castps256_ps128(newMax)) };
+                out[i + 1] = AABB{ sse::ToVec3(_mm256_extractf128_ps(newMin, 1)), sse::ToVec3(_mm256_extractf128_ps(newMax, 1)) };
+            }
+
+            sse::TransformAabbs(matrices + i * matrixStride, matrixStride, boxes + i, out + i, count - i);
+        }
+
+        void Multiply(const glm::mat4* a, size_t aStride, const glm::mat4* b, glm::mat4* out, size_t count) {
+            // Both lanes hold the same columns of a, b columns are processed in pairs.
+            for (size_t i{}; i < count; ++i) {
+                const auto ma{ &a[i * aStride][0].x };
+                const auto a0{ _mm256_broadcast_ps(reinterpret_cast<const __m128*>(ma + 0)) };
+                const auto a1{ _mm256_broadcast_ps(reinterpret_cast<const __m128*>(ma + 4)) };
+                const auto a2{ _mm256_broadcast_ps(reinterpret_cast<const __m128*>(ma + 8)) };
+                const auto a3{ _mm256_broadcast_ps(reinterpret_cast<const __m128*>(ma + 12)) };
+
+                const auto mb{ &b[i][0].x };
+                const auto b01{ _mm256_loadu_ps(mb + 0) };
+                const auto b23{ _mm256_loadu_ps(mb + 8) };
+
+                const auto r01{ Combine(a0, a1, a2, a3, b01) };
+                const auto r23{ Combine(a0, a1, a2, a3, b23) };
+
+                const auto mo{ &out[i][0].x };
+                _mm256_storeu_ps(mo + 0, r01);
+                _mm256_storeu_ps(mo + 8, r23);
+            }
+        }
+
+        void InverseAffine(const glm::mat4* matrices, glm::mat4* out, size_t count) {
+            const auto xyzMask{ _mm256_castsi256_ps(_mm256_setr_epi32(-1, -1, -1, 0, -1, -1, -1, 0)) };
+            const auto unitW{ _mm256_setr_ps(0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 1.0f) };
+            const auto one{ _mm256_set1_ps(1.0f) };
+
+            size_t i{};
+            for (; i + 2 <= count; i += 2) {
+                const auto m0{ &matrices[i][0].x };
+                const auto m1{ &matrices[i + 1][0].x };
+                const auto c0{ _mm256_and_ps(Load2(m0 + 0, m1 + 0), xyzMask) };
+                const auto c1{ _mm256_and_ps(Load2(m0 + 4, m1 + 4), xyzMask) };
+                const auto c2{ _mm256_and_ps(Load2(m0 + 8, m1 + 8), xyzMask) };
+                const auto t{ Load2(m0 + 12, m1 + 12) };
+
+                auto r0{ Cross(c1, c2) };
+                auto r1{ Cross(c2, c0) };
+                auto r2{ Cross(c0, c1) };
+                auto r3{ _mm256_setzero_ps() };
+
+                const auto invDet{ _mm256_div_ps(one, HorizontalSum(_mm256_mul_ps(c0, r0))) };
+
+                Transpose4(r0, r1, r2, r3);
+                r0 = _mm256_mul_ps(r0, invDet);
+                r1 = _mm256_mul_ps(r1, invDet);
+                r2 = _mm256_mul_ps(r2, invDet);
+
+                const auto translation{ _mm256_fmadd_ps(r2, Splat<2>(t), _mm256_fmadd_ps(r1, Splat<1>(t), _mm256_mul_ps(r0, Splat<0>(t)))) };
+
+                auto o0{ &out[i][0].x };
+                auto o1{ &out[i + 1][0].x };
+                Store2(o0 + 0, o1 + 0, r0);
+                Store2(o0 + 4, o1 + 4, r1);
+                Store2(o0 + 8, o1 + 8, r2);
+                Store2(o0 + 12, o1 + 12, _mm256_sub_ps(unitW, translation));
+            }
+
+            sse::InverseAffine(matrices + i, out + i, count - i);
+        }
+
+        void Compose(const glm::vec3* positions, const glm::quat* rotations, const glm::vec3* scales, glm::mat4* out, size_t count) {
+            const auto one{ _mm256_set1_ps(1.0f) };
+            const auto two{ _mm256_set1_ps(2.0f) };
+
+            size_t i{};
+            for (; i + 8 <= count; i += 8) {
+                // Bones i..i+3 in low lanes, i+4..i+7 in high lanes.
+                auto x{ Load2(&rotations[i + 0].x, &rotations[i + 4].x) };
+                auto y{ Load2(&rotations[i + 1].x, &rotations[i + 5].x) };
+                auto z{ Load2(&rotations[i + 2].x, &rotations[i + 6].x) };
+                auto w{ Load2(&rotations[i + 3].x, &rotations[i + 7].x) };
+                Transpose4(x, y, z, w);
+
+                __m256 px, py, pz;
+                const auto p{ &positions[i].x };
+                Deinterleave3(Load2(p + 0, p + 12), Load2(p + 4, p + 16), Load2(p + 8, p + 20), px, py, pz);
+
+                __m256 sx, sy, sz;
+                const auto s{ &scales[i].x };
+                Deinterleave3(Load2(s + 0, s + 12), Load2(s + 4, s + 16), Load2(s + 8, s + 20), sx, sy, sz);
+
+                const auto x2{ _mm256_mul_ps(x, two) };
+                const auto y2{ _mm256_mul_ps(y, two) };
+                const auto z2{ _mm256_mul_ps(z, two) };
+                const auto xx{ _mm256_mul_ps(x, x2) };
+                const auto yy{ _mm256_mul_ps(y, y2) };
+                const auto zz{ _mm256_mul_ps(z, z2) };
+                const auto xy{ _mm256_mul_ps(x, y2) };
+                const auto xz{ _mm256_mul_ps(x, z2) };
+                const auto yz{ _mm256_mul_ps(y, z2) };
+                const auto wx{ _mm256_mul_ps(w, x2) };
+                const auto wy{ _mm256_mul_ps(w, y2) };
+                const auto wz{ _mm256_mul_ps(w, z2) };
+
+                auto m00{ _mm256_mul_ps(_mm256_sub_ps(one, _mm256_add_ps(yy, zz)), sx) };
+                auto m01{ _mm256_mul_ps(_mm256_add_ps(xy, wz), sx) };
+                auto m02{ _mm256_mul_ps(_mm256_sub_ps(xz, wy), sx) };
+                auto m03{ _mm256_setzero_ps() };
+
+                auto m10{ _mm256_mul_ps(_mm256_sub_ps(xy, wz), sy) };
+                auto m11{ _mm256_mul_ps(_mm256_sub_ps(one, _mm256_add_ps(xx, zz)), sy) };
+                auto m12{ _mm256_mul_ps(_mm256_add_ps(yz, wx), sy) };
+                auto m13{ _mm256_setzero_ps() };
+
+                auto m20{ _mm256_mul_ps(_mm256_add_ps(xz, wy), sz) };
+                auto m21{ _mm256_mul_ps(_mm256_sub_ps(yz, wx), sz) };
+                auto m22{ _mm256_mul_ps(_mm256_sub_ps(one, _mm256_add_ps(xx, yy)), sz) };
+                auto m23{ _mm256_setzero_ps() };
+
+                auto m33{ one };
+
+                Transpose4(m00, m01, m02, m03);
+                Transpose4(m10, m11, m12, m13);
+                Transpose4(m20, m21, m22, m23);
+                Transpose4(px, py, pz, m33);
+
+                const __m256 columns[4][4]{
+                    { m00, m10, m20, px },
+                    { m01, m11, m21, py },
+                    { m02, m12, m22, pz },
+                    { m03, m13, m23, m33 },
+                };
+
+                for (u32 j{}; j < 4; ++j) {
+                    const auto lo{ &out[i + j][0].x };
+                    const auto hi{ &out[i + j + 4][0].x };
+                    Store2(lo + 0, hi + 0, columns[j][0]);
+                    Store2(lo + 4, hi + 4, columns[j][1]);
+                    Store2(lo + 8, hi + 8, columns[j][2]);
+                    Store2(lo + 12, hi + 12, columns[j][3]);
+                }
+            }
+
+            sse::Compose(positions + i, rotations + i, scales + i, out + i, count - i);
+        }
+
+        constexpr Kernels KERNELS{
+            .level = Level::AVX2,
+            .transformAabbs = &TransformAabbs,
+            .multiply = &Multiply,
+            .inverseAffine = &InverseAffine,
+            .compose = &Compose,
+        };
+
+    } // namespace avx2
+#endif
+
+    Level DetectLevel() {
+#ifdef UGINE_SIMD_X86
+        int info[4]{};
+        __cpuid(info, 0);
+        const auto maxLeaf{ info[0] };
+
+        __cpuid(info, 1);
+        const bool fma{ (info[2] & (1 << 12)) != 0 };
+        const bool osxsave{ (info[2] & (1 << 27)) != 0 };
+        const bool avx{ (info[2] & (1 << 28)) != 0 };
+
+        bool avx2{};
+        if (maxLeaf >= 7) {
+            __cpuidex(info, 7, 0);
+            avx2 = (info[1] & (1 << 5)) != 0;
+        }
+
+        // OS has to preserve YMM registers.
+        const bool ymmState{ osxsave && (_xgetbv(0) & 0x6) == 0x6 };
+
+        return avx && avx2 && fma && ymmState ? Level::AVX2 : Level::SSE2;
+#else
+        return Level::Scalar;
+#endif
+    }
+
+    const Kernels& KernelsFor(Level level) {
+        switch (level) {
+#ifdef UGINE_SIMD_X86
+        case Level::AVX2:
+            return avx2::KERNELS;
+        case Level::SSE2:
+            return sse::KERNELS;
+#endif
+        default:
+            return scalar::KERNELS;
+        }
+    }
+
+    std::atomic<const Kernels*> activeKernels{};
+
+    const Kernels& Active() {
+        auto kernels{ activeKernels.load(std::memory_order_acquire) };
+        if (!kernels) {
+            kernels = &KernelsFor(SupportedLevel());
+            activeKernels.store(kernels, std::memory_order_release);
+        }
+        return *kernels;
+    }
+
+} // namespace
+
+const char* LevelName(Level level) {
+    switch (level) {
+    case Level::SSE2:
+        return "SSE2";
+    case Level::AVX2:
+        return "AVX2";
+    default:
+        return "Scalar";
+    }
+}
+
+Level SupportedLevel() {
+    static const Level level{ DetectLevel() };
+    return level;
+}
+
+Level ActiveLevel() {
+    return Active().level;
+}
+
+void SetLevel(Level level) {
+    activeKernels.store(&KernelsFor(std::min(level, SupportedLevel())), std::memory_order_release);
+}
+
+void TransformAabbs(const glm::mat4& matrix, Span<const AABB> boxes, Span<AABB> out) {
+    UGINE_ASSERT(out.Size() >= boxes.Size());
+    Active().transformAabbs(&matrix, 0, boxes.Data(), out.Data(), boxes.Size());
+}
+
+void TransformAabbs(Span<const glm::mat4> matrices, Span<const AABB> boxes, Span<AABB> out) {
+    UGINE_ASSERT(matrices.Size() == boxes.Size());
+    UGINE_ASSERT(out.Size() >= boxes.Size());
+    Active().transformAabbs(matrices.Data(), 1, boxes.Data(), out.Data(), boxes.Size());
+}
+
+void MultiplyMatrices(const glm::mat4& a, Span<const glm::mat4> b, Span<glm::mat4> out) {
+    UGINE_ASSERT(out.Size() >= b.Size());
+
+    // Copy, a may be one of the outputs.
+    const glm::mat4 shared{ a };
+    Active().multiply(&shared, 0, b.Data(), out.Data(), b.Size());
+}
+
+void MultiplyMatrices(Span<const glm::mat4> a, Span<const glm::mat4> b, Span<glm::mat4> out) {
+    UGINE_ASSERT(a.Size() == b.Size());
+    UGINE_ASSERT(out.Size() >= b.Size());
+    Active().multiply(a.Data(), 1, b.Data(), out.Data(), b.Size());
+}
+
+void InverseAffine(Span<const glm::mat4> matrices, Span<glm::mat4> out) {
+    UGINE_ASSERT(out.Size() >= matrices.Size());
+    Active().inverseAffine(matrices.Data(), out.Data(), matrices.Size());
+}
+
+void ComposeTransforms(Span<const glm::vec3> positions, Span<const glm::quat> rotations, Span<const glm::vec3> scales, Span<glm::mat4> out) {
+    UGINE_ASSERT(positions.Size() == rotations.Size() && positions.Size() == scales.Size());
+    UGINE_ASSERT(out.Size() >= positions.Size());
+    Active().compose(positions.Data(), rotations.Data(), scales.Data(), out.Data(), positions.Size());
+}
+
+} // namespace ugine::simd
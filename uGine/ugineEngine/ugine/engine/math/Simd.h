@@ -0,0 +1,44 @@
+#pragma once
+
+#include <ugine/Span.h>
+#include <ugine/Ugine.h>
+
+#include <ugine/engine/math/Aabb.h>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+namespace ugine::simd {
+
+// Batched math kernels. Implementation is picked at runtime by CPU features (AVX2 requires FMA as well), scalar
+// path uses glm and serves as reference. Outputs may alias inputs of the same type.
+enum class Level {
+    Scalar,
+    SSE2,
+    AVX2,
+};
+
+const char* LevelName(Level level);
+
+// Best level supported by CPU.
+Level SupportedLevel();
+Level ActiveLevel();
+
+// Overrides active level for tests and benchmarks, clamped to supported level.
+void SetLevel(Level level);
+
+// Center/extent transformation: center by full matrix, extent by absolute 3x3 part. Matrices must be affine.
+void TransformAabbs(const glm::mat4& matrix, Span<const AABB> boxes, Span<AABB> out);
+void TransformAabbs(Span<const glm::mat4> matrices, Span<const AABB> boxes, Span<AABB> out);
+
+// out[i] = a * b[i] or out[i] = a[i] * b[i].
+void MultiplyMatrices(const glm::mat4& a, Span<const glm::mat4> b, Span<glm::mat4> out);
+void MultiplyMatrices(Span<const glm::mat4> a, Span<const glm::mat4> b, Span<glm::mat4> out);
+
+// Inverse of affine matrices (rotation, scale, shear and translation), last row is assumed to be (0, 0, 0, 1).
+void InverseAffine(Span<const glm::mat4> matrices, Span<glm::mat4> out);
+
+// out[i] = translate(positions[i]) * mat4(rotations[i]) * scale(scales[i]), rotations must be normalized.
+void ComposeTransforms(Span<const glm::vec3> positions, Span<const glm::quat> rotations, Span<const glm::vec3> scales, Span<glm::mat4> out);
+
+} // namespace ugine::simd
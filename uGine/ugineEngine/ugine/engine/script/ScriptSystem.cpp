@@ -13,6 +13,8 @@ ScriptSystem::ScriptSystem(Engine& engine)
     : System{ engine } {
     state_ = &GetEngine().AttachState<ScriptState>(engine);
 
+    engine.GetResources().RegisterType<LuaScript>();
+
     engine.GetWorldManager().Connect<WorldManager::WorldCreatedEvent, &ScriptSystem::OnWorldCreated>(this);
 }
 
@@ -86,6 +86,8 @@ struct STRUCT_ALIGN Global {
 struct STRUCT_ALIGN Draw {
     float4x4 model;
     float4x4 normal;
+    float4 positionScale;  // VERTEX_PACKED dequantization.
+    float4 positionOffset; //
 };
 
 UGINE_NAMESPACE_END
@@ -15,9 +15,10 @@ struct Vertex {
     float uv1;
 };
 
+// See SkinVertexPacked: 4x u8 joint index, 4x unorm8 weight.
 struct SkinVertex {
-    float4 inJointIndices;
-    float4 inJointWeights;
+    uint joints;
+    uint weights;
 };
 
 BINDING(0, 0) StructuredBuffer<Vertex> inVertex;
@@ -75,11 +76,11 @@ float4x4 inverse(float4x4 m) {
     if (index < params.vertexCount) {
         SkinVertex v = inSkin[index];
 
-        float4 weight = v.inJointWeights;
-        float4 idx = v.inJointIndices;
+        float4 weight = float4(v.weights & 0xff, (v.weights >> 8) & 0xff, (v.weights >> 16) & 0xff, v.weights >> 24) / 255.0;
+        uint4 idx = uint4(v.joints & 0xff, (v.joints >> 8) & 0xff, (v.joints >> 16) & 0xff, v.joints >> 24);
 
         float4x4 skinMat
-            = weight.x * inMatrix[uint(idx.x)] + weight.y * inMatrix[uint(idx.y)] + weight.z * inMatrix[uint(idx.z)] + weight.w * inMatrix[uint(idx.w)];
+            = weight.x * inMatrix[idx.x] + weight.y * inMatrix[idx.y] + weight.z * inMatrix[idx.z] + weight.w * inMatrix[idx.w];
 
         Vertex input = inVertex[index];
         float3 position = mul(skinMat, float4(input.position0, input.position1, input.position2, 1.0)).xyz;
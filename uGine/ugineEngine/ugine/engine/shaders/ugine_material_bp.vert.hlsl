@@ -35,12 +35,12 @@ VSOutput main(VSInput input, out float4 outPosition : SV_Position) {
     float4x4 normal = g_draw.normal;
 #endif // MATERIAL_INSTANCE
 
-    float4 position = float4(input.position + material_vertex_offset(), 1.0);
+    float4 position = float4(vertex_position(input) + material_vertex_offset(), 1.0);
     float4 modelPos = mul(model, position);
     
     outPosition = mul(g_camera.viewProj, modelPos);
 
-    output.fragUV = input.texcoord;
+    output.fragUV = vertex_uv(input);
 
     float4 viewModel = mul(g_camera.view, modelPos);
     output.positionVS = viewModel.xyz;
@@ -49,9 +49,12 @@ VSOutput main(VSInput input, out float4 outPosition : SV_Position) {
     output.positionWS = modelPos.xyz;
     output.positionM = position.xyz;
 
-    output.tangentWS = mul(model, float4(input.tangent, 0.0)).xyz;
-    output.bitangentWS = mul(model, float4(cross(input.normal, input.tangent), 0.0)).xyz;
-    output.normalWS = mul(normal, float4(input.normal, 0.0)).xyz;
+    float3 vertexNormal = vertex_normal(input);
+    float3 vertexTangent = vertex_tangent(input);
+
+    output.tangentWS = mul(model, float4(vertexTangent, 0.0)).xyz;
+    output.bitangentWS = mul(model, float4(cross(vertexNormal, vertexTangent), 0.0)).xyz;
+    output.normalWS = mul(normal, float4(vertexNormal, 0.0)).xyz;
 #endif
 
     return output;
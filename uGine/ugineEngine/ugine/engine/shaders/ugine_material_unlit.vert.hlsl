@@ -23,7 +23,7 @@ VSOutput main(VSInput input, out float4 outPosition : SV_Position) {
     model = model * instance;
 #endif // MATERIAL_INSTANCE
 
-    float4 position = float4(input.position + material_vertex_offset(), 1.0);
+    float4 position = float4(vertex_position(input) + material_vertex_offset(), 1.0);
 
     float4 modelPos = mul(model, position);
     float4 projViewModel = mul(g_camera.viewProj, modelPos);
@@ -31,6 +31,6 @@ VSOutput main(VSInput input, out float4 outPosition : SV_Position) {
     outPosition = projViewModel;
 
     VSOutput output;
-    output.fragUV = input.texcoord;
+    output.fragUV = vertex_uv(input);
     return output;
 }
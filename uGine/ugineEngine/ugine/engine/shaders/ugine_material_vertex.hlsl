@@ -1,10 +1,18 @@
 #include "Shader_Common.h"
 
 struct VSInput {
+#if defined(VERTEX_PACKED)
+    // See MaterialVertexPacked.
+    LOCATION(0) uint4 position : POSITION0;
+    LOCATION(1) uint2 normal : NORMAL0;
+    LOCATION(2) uint2 tangent : TANGENT0;
+    LOCATION(4) uint2 texcoord : TEXCOORD0;
+#else // VERTEX_PACKED
     LOCATION(0) float3 position : POSITION0;
     LOCATION(1) float3 normal : NORMAL0;
     LOCATION(2) float3 tangent : TANGENT0;
     LOCATION(4) float2 texcoord : TEXCOORD0;
+#endif // VERTEX_PACKED
 
 #if defined(MATERIAL_INSTANCE)
     LOCATION(5) float4 instance0 : POSITION1;
@@ -13,5 +21,55 @@ struct VSInput {
 #endif // MATERIAL_INSTANCE
 };
 
+#if defined(VERTEX_PACKED)
+float2 vertex_unpack_snorm16(uint2 value) {
+    int2 s = int2(value << 16) >> 16;
+    return max(float2(s) / 32767.0, -1.0);
+}
+
+float3 vertex_unpack_octahedral(uint2 value) {
+    float2 f = vertex_unpack_snorm16(value);
+
+    float3 n = float3(f.x, f.y, 1.0 - abs(f.x) - abs(f.y));
+    float t = saturate(-n.z);
+    n.x += n.x >= 0.0 ? -t : t;
+    n.y += n.y >= 0.0 ? -t : t;
+
+    return normalize(n);
+}
+#endif // VERTEX_PACKED
+
+float3 vertex_position(VSInput input) {
+#if defined(VERTEX_PACKED)
+    return float3(input.position.xyz) / 65535.0 * g_draw.positionScale.xyz + g_draw.positionOffset.xyz;
+#else
+    return input.position;
+#endif
+}
+
+float3 vertex_normal(VSInput input) {
+#if defined(VERTEX_PACKED)
+    return vertex_unpack_octahedral(input.normal);
+#else
+    return input.normal;
+#endif
+}
+
+float3 vertex_tangent(VSInput input) {
+#if defined(VERTEX_PACKED)
+    return vertex_unpack_octahedral(input.tangent);
+#else
+    return input.tangent;
+#endif
+}
+
+float2 vertex_uv(VSInput input) {
+#if defined(VERTEX_PACKED)
+    return f16tof32(input.texcoord);
+#else
+    return input.texcoord;
+#endif
+}
+
 // Implement:
 float3 material_vertex_offset();
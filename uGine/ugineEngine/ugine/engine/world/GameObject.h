@@ -30,8 +30,7 @@ struct TagComponent {
 
     static TagComponent Init(std::string_view name) {
         TagComponent tag{};
-        tag.name = name;
-        tag.id = StringID{ name.data() };
+        tag.id = StringID::Intern(StringView{ name.data(), name.size() });
         return tag;
     }
 
@@ -40,8 +39,7 @@ struct TagComponent {
         Disabled = UGINE_BIT(1),
     };
 
-    std::string name; // TODO:
-    StringID id;
+    StringID id; // Interned name.
     u32 flags{};
     u32 layers{ u32(-1) };
     u8 stencil{}; // TODO: Here for now.
@@ -98,17 +96,16 @@ public:
 
     UGINE_FORCE_INLINE bool IsStatic() const { return handle_.any_of<StaticFlagComponent>(); }
 
-    UGINE_FORCE_INLINE const std::string& Name() const {
+    // Interned, null terminated.
+    UGINE_FORCE_INLINE std::string_view Name() const {
         UGINE_ASSERT(handle_.try_get<TagComponent>() != nullptr);
-        return handle_.get<TagComponent>().name;
+        const auto name{ handle_.get<TagComponent>().id.Name() };
+        return std::string_view{ name.Data(), name.Size() };
     }
 
     UGINE_FORCE_INLINE void SetName(std::string_view name) {
         UGINE_ASSERT(handle_.try_get<TagComponent>() != nullptr);
-        handle_.patch<TagComponent>([&](auto& t) {
-            t.name = name;
-            t.id = StringID{ t.name.data() };
-        });
+        handle_.patch<TagComponent>([&](auto& t) { t.id = StringID::Intern(StringView{ name.data(), name.size() }); });
     }
 
     UGINE_FORCE_INLINE bool IsEnabled() const {
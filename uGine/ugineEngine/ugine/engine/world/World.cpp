@@ -57,7 +57,7 @@ void World::DestroyObject(const GameObject& go) {
 }
 
 std::vector<GameObject> World::Find(std::string_view name) {
-    const StringID id{ name.data() };
+    const StringID id{ StringView{ name.data(), name.size() } };
 
     std::vector<GameObject> result;
     for (auto&& [ent, tag] : registry_.view<TagComponent>().each()) {
@@ -55,13 +55,15 @@ public:
 
 WorldManager::WorldManager(Engine& engine)
     : engine_{ engine }
-    , worlds_{ engine.GetAllocator() } {
+    , worlds_{ engine.GetAllocator() }
+    , partitions_{ engine.GetAllocator() } {
 }
 
 WorldManager::~WorldManager() {
 }
 
 void WorldManager::DestroyWorlds() {
+    partitions_.Clear();
     worlds_.Clear();
 }
 
@@ -106,12 +108,40 @@ World* WorldManager::Clone(World& source) {
     return newWorld;
 }
 
+WorldPartition* WorldManager::OpenPartition(World& world, const Path& directory) {
+    auto partition{ GetPartition(world) };
+    if (!partition) {
+        partitions_.PushBack(MakeUnique<WorldPartition>(engine_.GetAllocator(), world.Registry(), engine_.GetFileSystem(), &engine_.GetResources(),
+            &engine_.GetScheduler(), engine_.GetAllocator()));
+        partition = partitions_.Back().Get();
+    }
+
+    if (!partition->Open(directory)) {
+        partitions_.EraseIf([partition](auto& p) { return p.Get() == partition; });
+        return nullptr;
+    }
+
+    return partition;
+}
+
+WorldPartition* WorldManager::GetPartition(World& world) {
+    const auto index{ partitions_.FindIf([&world](auto& p) { return &p->Registry() == &world.Registry(); }) };
+    return index >= 0 ? partitions_[index].Get() : nullptr;
+}
+
 void WorldManager::SyncPoint() {
+    // File system sync point delivered cell reads of this frame.
+    for (auto& partition : partitions_) {
+        partition->Update();
+    }
+
     for (auto world : toDestroy_) {
         if (world == defaultWorld_) {
             defaultWorld_ = nullptr;
         }
 
+        partitions_.EraseIf([world](auto& p) { return &p->Registry() == &world->Registry(); });
+
         const auto index{ worlds_.FindIf([world](auto& w) { return w.Get() == world; }) };
         if (index >= 0) {
             Emit(WorldDestroyedEvent{
@@ -2,6 +2,7 @@
 #pragma once
 
 #include "World.h"
+#include "WorldPartition.h"
 
 #include <memory>
 #include <stdint.h>
@@ -37,6 +38,10 @@ public:
 
     World* Clone(World& source);
 
+    // Streams cells of partitioned world directory into world, updated every sync point. Null if it can't be opened.
+    WorldPartition* OpenPartition(World& world, const Path& directory);
+    WorldPartition* GetPartition(World& world);
+
     const Vector<UniquePtr<World>>& Worlds() const { return worlds_; }
     u32 Size() const { return u32(worlds_.Size()); }
     World* GetWorld(u32 index) { return index < worlds_.Size() ? worlds_[index].Get() : nullptr; }
@@ -54,6 +59,7 @@ public:
 private:
     Engine& engine_;
     Vector<UniquePtr<World>> worlds_;
+    Vector<UniquePtr<WorldPartition>> partitions_;
     Vector<World*> toDestroy_;
     World* defaultWorld_{};
 };
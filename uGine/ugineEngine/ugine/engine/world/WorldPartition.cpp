@@ -0,0 +1,476 @@
+#include "WorldPartition.h"
+#include "WorldSerializer.h"
+
+#include <ugine/engine/core/Json.h>
+#include <ugine/engine/core/ResourceManager.h>
+#include <ugine/engine/gfx/Component.h>
+#include <ugine/engine/world/Component.h>
+
+#include <ugine/File.h>
+#include <ugine/Json.h>
+#include <ugine/Log.h>
+#include <ugine/Metrics.h>
+#include <ugine/Profile.h>
+
+#include <algorithm>
+#include <cmath>
+#include <format>
+#include <limits>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace ugine {
+
+namespace {
+    constexpr const char* PERSISTENT_FILE{ "persistent.uworld" };
+
+    // Objects that must stay loaded wherever the sources are.
+    bool IsPersistent(GameObjectRegistry& registry, GameObjectHandle root) {
+        if (registry.any_of<CameraComponent, SkyComponent>(root)) {
+            return true;
+        }
+
+        const auto light{ registry.try_get<LightComponent>(root) };
+        return light && light->type == LightComponent::Type::Directional;
+    }
+
+    // Root first, parents precede their children.
+    void CollectHierarchy(GameObjectRegistry& registry, GameObjectHandle root, std::vector<GameObjectHandle>& objects) {
+        std::vector<GameObjectHandle> stack{ root };
+        while (!stack.empty()) {
+            const auto object{ stack.back() };
+            stack.pop_back();
+            objects.push_back(object);
+
+            if (const auto rel{ registry.try_get<RelationshipComponent>(object) }) {
+                for (auto child{ rel->firstChild }; child != GameObjectNull; child = registry.get<RelationshipComponent>(child).nextSibling) {
+                    stack.push_back(child);
+                }
+            }
+        }
+    }
+
+    bool WriteWorld(GameObjectRegistry& registry, const std::vector<GameObjectHandle>& objects, const Path& path, Vector<u8>& data) {
+        WorldSerializer::Save(registry, Span<const GameObjectHandle>{ objects.data(), objects.size() }, WorldSerializer::Format::Binary, data);
+        if (!WriteFileBinary(path, data)) {
+            UGINE_ERROR("Failed to write world cell '{}'.", path.Data());
+            return false;
+        }
+        return true;
+    }
+} // namespace
+
+bool WorldPartition::Build(GameObjectRegistry& registry, const Path& directory, f32 cellSize) {
+    PROFILE_EVENT();
+
+    UGINE_ASSERT(cellSize > 0.0f);
+
+    if (!FileSystem::Exists(directory) && !FileSystem::CreateDirectories(directory)) {
+        UGINE_ERROR("Failed to create world partition directory '{}'.", directory.Data());
+        return false;
+    }
+
+    struct BuildCell {
+        i32 x{};
+        i32 z{};
+        std::vector<GameObjectHandle> objects;
+    };
+
+    std::map<u64, BuildCell> cells;
+    std::vector<GameObjectHandle> persistent;
+
+    registry.view<TagComponent>().each([&](GameObjectHandle object, const TagComponent& tag) {
+        if (registry.all_of<ParentComponent>(object) || (tag.flags & TagComponent::Flags::Editor)) {
+            return;
+        }
+
+        if (IsPersistent(registry, object)) {
+            CollectHierarchy(registry, object, persistent);
+            return;
+        }
+
+        const auto transformation{ registry.try_get<TransformationComponent>(object) };
+        const auto position{ transformation ? transformation->globalTransformation.position : glm::vec3{} };
+        const auto x{ i32(std::floor(position.x / cellSize)) };
+        const auto z{ i32(std::floor(position.z / cellSize)) };
+
+        auto& cell{ cells[Key(x, z)] };
+        cell.x = x;
+        cell.z = z;
+        CollectHierarchy(registry, object, cell.objects);
+    });
+
+    nlohmann::json manifest{};
+    manifest["cellSize"] = cellSize;
+    manifest["persistent"] = PERSISTENT_FILE;
+    manifest["cells"] = nlohmann::json::array();
+
+    Vector<u8> data;
+    if (!WriteWorld(registry, persistent, directory / PERSISTENT_FILE, data)) {
+        return false;
+    }
+
+    for (const auto& [key, cell] : cells) {
+        const auto file{ std::format("cell_{}_{}.uworld", cell.x, cell.z) };
+        if (!WriteWorld(registry, cell.objects, directory / file, data)) {
+            return false;
+        }
+
+        Vector<ResourceID> dependencies;
+        WorldSerializer::Dependencies(data.ToSpan(), dependencies);
+
+        nlohmann::json js{};
+        js["x"] = cell.x;
+        js["z"] = cell.z;
+        js["file"] = file;
+        js["objects"] = u32(cell.objects.size());
+        js["dependencies"] = dependencies;
+        manifest["cells"].push_back(std::move(js));
+    }
+
+    const auto text{ manifest.dump(1, '\t') };
+    if (!WriteFileBinary(directory / MANIFEST, Span<const u8>{ reinterpret_cast<const u8*>(text.data()), text.size() })) {
+        UGINE_ERROR("Failed to write world partition manifest '{}'.", directory.Data());
+        return false;
+    }
+
+    UGINE_INFO("World partition '{}' built, {} cells, {} persistent objects.", directory.Data(), cells.size(), persistent.size());
+    return true;
+}
+
+WorldPartition::WorldPartition(GameObjectRegistry& registry, FileSystem& fileSystem, ResourceManager* resources, Scheduler* scheduler, IAllocator& allocator)
+    : registry_{ registry }
+    , fileSystem_{ fileSystem }
+    , resources_{ resources }
+    , scheduler_{ scheduler }
+    , allocator_{ allocator }
+    , cells_{ allocator }
+    , live_{ allocator }
+    , persistent_{ allocator } {
+}
+
+WorldPartition::~WorldPartition() {
+    // Objects belong to the world, only reads referencing cells must stop.
+    for (auto cell : live_) {
+        Unload(*cell);
+    }
+}
+
+bool WorldPartition::Open(const Path& directory) {
+    PROFILE_EVENT();
+
+    Close();
+
+    Vector<u8> data;
+    if (!fileSystem_.Read(directory / MANIFEST, data)) {
+        UGINE_ERROR("Failed to read world partition '{}'.", directory.Data());
+        return false;
+    }
+
+    std::string persistentFile;
+    try {
+        const auto manifest{ nlohmann::json::parse(data.Data(), data.Data() + data.Size()) };
+
+        cellSize_ = manifest.at("cellSize").get<f32>();
+        if (cellSize_ <= 0.0f) {
+            throw std::runtime_error{ "Invalid cell size" };
+        }
+
+        persistentFile = manifest.value("persistent", std::string{});
+
+        const auto& cells{ manifest.at("cells") };
+        cells_.Resize(cells.size());
+        for (size_t i{}; i < cells.size(); ++i) {
+            const auto& js{ cells[i] };
+            const auto file{ js.at("file").get<std::string>() };
+
+            auto& cell{ cells_[i] };
+            cell.partition = this;
+            cell.x = js.at("x").get<i32>();
+            cell.z = js.at("z").get<i32>();
+            cell.path = directory / file;
+            cell.objects = js.value("objects", 0u);
+            cell.dependencies = js.value("dependencies", Vector<ResourceID>{});
+
+            cellIndices_[Key(cell.x, cell.z)] = u32(i);
+        }
+    } catch (const std::exception& ex) {
+        UGINE_ERROR("Failed to parse world partition '{}': {}", directory.Data(), ex.what());
+        Close();
+        return false;
+    }
+
+    if (!persistentFile.empty()) {
+        const auto path{ directory / persistentFile };
+
+        data.Clear();
+        if (!fileSystem_.Read(path, data) || !WorldSerializer::Load(registry_, data.ToSpan(), resources_, scheduler_, &persistent_)) {
+            UGINE_ERROR("Failed to load persistent objects '{}'.", path.Data());
+        }
+    }
+
+    stats_ = Stats{ .cells = u32(cells_.Size()) };
+    return true;
+}
+
+void WorldPartition::Close() {
+    for (auto cell : live_) {
+        if (cell->state == CellState::Active) {
+            Deactivate(*cell);
+        }
+        Unload(*cell);
+    }
+
+    for (const auto object : persistent_) {
+        if (registry_.valid(object)) {
+            registry_.destroy(object);
+        }
+    }
+
+    live_.Clear();
+    persistent_.Clear();
+    cellIndices_.clear();
+    cells_.Clear();
+    cellSize_ = 0.0f;
+    reads_ = 0;
+    stats_ = Stats{};
+}
+
+void WorldPartition::Update() {
+    Vector<glm::vec3> sources{ allocator_ };
+    for (auto [object, camera, transformation] : registry_.view<CameraComponent, TransformationComponent>().each()) {
+        if (camera.isMain) {
+            sources.PushBack(transformation.globalTransformation.position);
+        }
+    }
+
+    Update(sources.ToSpan());
+}
+
+void WorldPartition::Update(Span<const glm::vec3> sources) {
+    PROFILE_EVENT_N("World partition");
+
+    ++frame_;
+    stats_.activatedLastFrame = 0;
+    stats_.deactivatedLastFrame = 0;
+
+    if (cells_.Empty() || sources.Empty()) {
+        return;
+    }
+
+    // Cells around sources not loaded yet, failed cells wait for reopen.
+    Vector<Cell*> reads{ allocator_ };
+    const auto reach{ i32(std::ceil(settings_.loadRadius / cellSize_)) };
+    for (const auto& source : sources) {
+        const auto sourceX{ Coord(source.x) };
+        const auto sourceZ{ Coord(source.z) };
+
+        for (auto z{ sourceZ - reach }; z <= sourceZ + reach; ++z) {
+            for (auto x{ sourceX - reach }; x <= sourceX + reach; ++x) {
+                const auto index{ cellIndices_.find(Key(x, z)) };
+                if (index == cellIndices_.end()) {
+                    continue;
+                }
+
+                auto& cell{ cells_[index->second] };
+                if (cell.state != CellState::Unloaded || cell.failed || cell.frame == frame_) {
+                    continue;
+                }
+
+                cell.frame = frame_;
+                cell.distance = Distance(cell, sources);
+                if (cell.distance <= settings_.loadRadius) {
+                    reads.PushBack(&cell);
+                }
+            }
+        }
+    }
+
+    // Hysteresis, cells stay until they are past unload radius.
+    Vector<Cell*> deactivations{ allocator_ };
+    Vector<Cell*> activations{ allocator_ };
+    for (auto cell : live_) {
+        cell->distance = Distance(*cell, sources);
+
+        if (cell->distance > settings_.unloadRadius) {
+            if (cell->state == CellState::Active) {
+                deactivations.PushBack(cell);
+            } else {
+                Unload(*cell);
+            }
+        } else if (cell->state == CellState::Ready) {
+            activations.PushBack(cell);
+        }
+    }
+
+    std::sort(reads.begin(), reads.end(), [](const Cell* a, const Cell* b) { return a->distance < b->distance; });
+    for (auto cell : reads) {
+        if (reads_ >= settings_.maxReads) {
+            break;
+        }
+        Read(*cell);
+    }
+
+    // A cell larger than the budget is processed alone, budget can't stall streaming.
+    const auto budget{ settings_.objectsPerFrame > 0 ? settings_.objectsPerFrame : std::numeric_limits<u32>::max() };
+    u32 used{};
+    const auto fits{ [&](const Cell& cell) { return used == 0 || u64(used) + cell.objects <= budget; } };
+
+    // Farthest first frees what is least likely to come back.
+    std::sort(deactivations.begin(), deactivations.end(), [](const Cell* a, const Cell* b) { return a->distance > b->distance; });
+    for (auto cell : deactivations) {
+        if (!fits(*cell)) {
+            break;
+        }
+
+        used += cell->objects;
+        stats_.deactivatedLastFrame += u32(cell->loaded.Size());
+        Deactivate(*cell);
+        Unload(*cell);
+    }
+
+    std::sort(activations.begin(), activations.end(), [](const Cell* a, const Cell* b) { return a->distance < b->distance; });
+    for (auto cell : activations) {
+        if (!fits(*cell)) {
+            break;
+        }
+
+        used += cell->objects;
+        Activate(*cell);
+        stats_.activatedLastFrame += u32(cell->loaded.Size());
+    }
+
+    live_.EraseIf([](const Cell* cell) { return cell->state == CellState::Unloaded; });
+
+    stats_.reading = 0;
+    stats_.ready = 0;
+    stats_.active = 0;
+    stats_.activeObjects = 0;
+    stats_.readyBytes = 0;
+    for (const auto cell : live_) {
+        switch (cell->state) {
+        case CellState::Reading: ++stats_.reading; break;
+        case CellState::Ready:
+            ++stats_.ready;
+            stats_.readyBytes += cell->data.Size();
+            break;
+        case CellState::Active:
+            ++stats_.active;
+            stats_.activeObjects += u32(cell->loaded.Size());
+            break;
+        default: break;
+        }
+    }
+
+    UGINE_COUNTER_ADD("world.activatedObjects", stats_.activatedLastFrame);
+    UGINE_COUNTER_ADD("world.deactivatedObjects", stats_.deactivatedLastFrame);
+    UGINE_GAUGE_SET("world.cellsReading", stats_.reading);
+    UGINE_GAUGE_SET("world.cellsReady", stats_.ready);
+    UGINE_GAUGE_SET("world.cellsActive", stats_.active);
+}
+
+WorldPartition::CellState WorldPartition::GetCellState(i32 x, i32 z) const {
+    const auto index{ cellIndices_.find(Key(x, z)) };
+    return index != cellIndices_.end() ? cells_[index->second].state : CellState::Unloaded;
+}
+
+i32 WorldPartition::Coord(f32 position) const {
+    return i32(std::floor(position / cellSize_));
+}
+
+f32 WorldPartition::Distance(const Cell& cell, Span<const glm::vec3> sources) const {
+    const auto minX{ f32(cell.x) * cellSize_ };
+    const auto minZ{ f32(cell.z) * cellSize_ };
+
+    // To the cell rectangle, zero inside.
+    auto distance{ std::numeric_limits<f32>::max() };
+    for (const auto& source : sources) {
+        const auto dx{ std::max({ minX - source.x, 0.0f, source.x - minX - cellSize_ }) };
+        const auto dz{ std::max({ minZ - source.z, 0.0f, source.z - minZ - cellSize_ }) };
+        distance = std::min(distance, std::sqrt(dx * dx + dz * dz));
+    }
+    return distance;
+}
+
+void WorldPartition::Read(Cell& cell) {
+    UGINE_ASSERT(cell.state == CellState::Unloaded);
+
+    // Resources load alongside the cell file, objects find them loading or loaded.
+    if (resources_) {
+        for (const auto& id : cell.dependencies) {
+            if (auto resource{ resources_->GetTypeless(id) }) {
+                cell.resources.PushBack(std::move(resource));
+            } else {
+                UGINE_WARN("Dependency {} of world cell '{}' not resolved, it isn't prefetched.", id.ToString().Data(), cell.path.Data());
+            }
+        }
+    }
+
+    cell.state = CellState::Reading;
+    live_.PushBack(&cell);
+    ++reads_;
+
+    cell.request = fileSystem_.ReadAsync(
+        cell.path, [cell = &cell](IoData& data, bool success) { cell->partition->OnRead(cell, data, success); }, false, IoPriority::Background);
+}
+
+void WorldPartition::OnRead(Cell* cell, IoData& data, bool success) {
+    cell->request = {};
+    cell->state = CellState::Ready;
+    --reads_;
+
+    if (!success) {
+        UGINE_WARN("Failed to read world cell '{}'.", cell->path.Data());
+        cell->failed = true;
+        Unload(*cell);
+        return;
+    }
+
+    cell->data = data.Take();
+}
+
+void WorldPartition::Activate(Cell& cell) {
+    PROFILE_EVENT();
+
+    UGINE_ASSERT(cell.state == CellState::Ready);
+
+    if (!WorldSerializer::Load(registry_, cell.data.Data(), resources_, scheduler_, &cell.loaded)) {
+        UGINE_ERROR("Failed to load world cell '{}'.", cell.path.Data());
+        cell.failed = true;
+        Unload(cell);
+        return;
+    }
+
+    cell.data = {};
+    cell.state = CellState::Active;
+}
+
+void WorldPartition::Deactivate(Cell& cell) {
+    PROFILE_EVENT();
+
+    // Gameplay may have destroyed some objects already.
+    for (const auto object : cell.loaded) {
+        if (registry_.valid(object)) {
+            registry_.destroy(object);
+        }
+    }
+
+    cell.loaded.Clear();
+}
+
+void WorldPartition::Unload(Cell& cell) {
+    if (cell.state == CellState::Reading) {
+        fileSystem_.Cancel(cell.request);
+        cell.request = {};
+        --reads_;
+    }
+
+    cell.data = {};
+    cell.resources.Clear();
+    cell.loaded.Clear();
+    cell.state = CellState::Unloaded;
+}
+
+} // namespace ugine
@@ -0,0 +1,135 @@
+#pragma once
+
+#include <ugine/engine/core/Resource.h>
+#include <ugine/engine/world/GameObject.h>
+
+#include <ugine/FileSystem.h>
+#include <ugine/Memory.h>
+#include <ugine/Path.h>
+#include <ugine/Span.h>
+#include <ugine/Ugine.h>
+#include <ugine/Vector.h>
+
+#include <glm/vec3.hpp>
+
+#include <unordered_map>
+
+namespace ugine {
+
+class ResourceManager;
+class Scheduler;
+
+// Streams parts of a world too large to keep loaded around streaming sources (main cameras by default). Build splits
+// objects into grid cells on the XZ plane, each cell is a binary world file listed in a manifest together with the
+// resources it references. Cells within load radius of a source are read asynchronously with their resources prefetched,
+// objects are then created nearest cell first within a per frame budget. Cells farther than unload radius are unloaded,
+// the gap between radii keeps cells on the border from reloading every frame.
+class WorldPartition {
+public:
+    static constexpr const char* MANIFEST{ "partition.json" };
+
+    struct Settings {
+        f32 loadRadius{ 192.0f };
+        f32 unloadRadius{ 256.0f };
+        // Objects created and destroyed per frame, 0 is unlimited. Cells aren't split, a larger cell takes a frame alone.
+        u32 objectsPerFrame{ 2048 };
+        u32 maxReads{ 4 };
+    };
+
+    enum class CellState : u8 {
+        Unloaded,
+        Reading,
+        Ready, // Read, waiting for activation budget.
+        Active,
+    };
+
+    struct Stats {
+        u32 cells{};
+        u32 reading{};
+        u32 ready{};
+        u32 active{};
+        u32 activeObjects{};
+        u32 activatedLastFrame{}; // Objects.
+        u32 deactivatedLastFrame{};
+        u64 readyBytes{};
+    };
+
+    // Hierarchies stay whole in the cell of their root. Roots with camera, sky or directional light are saved to a
+    // persistent file loaded by Open, editor objects are skipped.
+    static bool Build(GameObjectRegistry& registry, const Path& directory, f32 cellSize);
+
+    WorldPartition(GameObjectRegistry& registry, FileSystem& fileSystem, ResourceManager* resources, Scheduler* scheduler,
+        IAllocator& allocator = IAllocator::Default());
+    ~WorldPartition();
+
+    WorldPartition(const WorldPartition&) = delete;
+    WorldPartition& operator=(const WorldPartition&) = delete;
+
+    // Reads manifest and loads persistent objects, cells stream in on Update.
+    bool Open(const Path& directory);
+    // Destroys objects of active cells and persistent objects.
+    void Close();
+
+    // Streams around main cameras, keeps current cells if there is none.
+    void Update();
+    void Update(Span<const glm::vec3> sources);
+
+    void SetSettings(const Settings& settings) { settings_ = settings; }
+    const Settings& GetSettings() const { return settings_; }
+
+    GameObjectRegistry& Registry() { return registry_; }
+    f32 CellSize() const { return cellSize_; }
+    CellState GetCellState(i32 x, i32 z) const;
+    Stats GetStats() const { return stats_; }
+
+private:
+    struct Cell {
+        WorldPartition* partition{};
+        i32 x{};
+        i32 z{};
+        Path path;
+        u32 objects{};
+        Vector<ResourceID> dependencies;
+
+        CellState state{};
+        bool failed{}; // Not retried.
+        u64 frame{};   // Frame of distance.
+        f32 distance{};
+        FileSystem::RequestHandle request{};
+        IoData data; // Taken from IO queue.
+        Vector<ResourceHandleTypeless> resources;
+        Vector<GameObjectHandle> loaded;
+    };
+
+    static u64 Key(i32 x, i32 z) { return (u64(u32(x)) << 32) | u32(z); }
+    i32 Coord(f32 position) const;
+    f32 Distance(const Cell& cell, Span<const glm::vec3> sources) const;
+
+    void Read(Cell& cell);
+    void OnRead(Cell* cell, IoData& data, bool success);
+    void Activate(Cell& cell);
+    void Deactivate(Cell& cell);
+    // Cancels read, releases data and prefetched resources.
+    void Unload(Cell& cell);
+
+    GameObjectRegistry& registry_;
+    FileSystem& fileSystem_;
+    ResourceManager* resources_{};
+    Scheduler* scheduler_{};
+    AllocatorRef allocator_;
+
+    Settings settings_{};
+    f32 cellSize_{};
+    u64 frame_{};
+    u32 reads_{};
+
+    // Not resized once open, reads keep pointers to cells.
+    Vector<Cell> cells_;
+    std::unordered_map<u64, u32> cellIndices_;
+    Vector<Cell*> live_; // Cells not unloaded.
+    Vector<GameObjectHandle> persistent_;
+
+    Stats stats_{};
+};
+
+} // namespace ugine
@@ -6,12 +6,21 @@
 #include <ugine/engine/gfx/Component.h>
 #include <ugine/engine/script/Component.h>
 
+#include <ugine/File.h>
 #include <ugine/Json.h>
+#include <ugine/Log.h>
 #include <ugine/Path.h>
-#include <ugine/Stream.h>
+#include <ugine/Profile.h>
+#include <ugine/Scheduler.h>
 #include <ugine/String.h>
 
-#include <fstream>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <unordered_map>
+#include <vector>
 
 namespace ugine {
 
@@ -21,8 +30,8 @@ NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE_WITH_DEFAULT(MaterialVertex, position, normal
 NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE_WITH_DEFAULT(MaterialVertexInstance, instance0, instance1, instance2);
 
 struct SerializationContext {
-    World& world;
-    ResourceManager& resources;
+    GameObjectRegistry& registry;
+    ResourceManager* resources{};
     std::map<GameObjectHandle, GameObjectHandle> idMap;
     Vector<GameObjectHandle> deserialized;
 };
@@ -43,7 +52,7 @@ template <typename T> nlohmann::json SerializeResource(const ResourceHandle<T>&
     return handle.Get() ? handle->Id() : ResourceID{};
 }
 
-template <typename T> ResourceHandle<T> DeserializeResource(const nlohmann::json& js, StringView name, ResourceManager& resources) {
+template <typename T> ResourceHandle<T> DeserializeResource(const nlohmann::json& js, StringView name, ResourceManager* resources) {
     auto id{ [&]() -> ResourceID {
         try {
             return js.value<ResourceID>(name.Data(), ResourceID{});
@@ -52,7 +61,7 @@ template <typename T> ResourceHandle<T> DeserializeResource(const nlohmann::json
         }
     }() };
 
-    return id.IsNull() ? ResourceHandle<T>{} : resources.Get<T>(id);
+    return id.IsNull() || !resources ? ResourceHandle<T>{} : resources->Get<T>(id);
 }
 
 template <typename T> nlohmann::json SerializeResources(Span<const ResourceHandle<T>> resources) {
@@ -67,7 +76,7 @@ template <typename T> nlohmann::json SerializeResources(Span<const ResourceHandl
 template <typename T> Vector<ResourceHandle<T>> DeserializeResources(std::span<const ResourceID> ids, SerializationContext& context) {
     Vector<ResourceHandle<T>> result(ids.size());
     for (u32 i{}; auto& id : ids) {
-        result[i] = context.resources.Get<T>(id);
+        result[i] = context.resources ? context.resources->Get<T>(id) : ResourceHandle<T>{};
         ++i;
     }
     return result;
@@ -129,7 +138,7 @@ void Deserialize(const nlohmann::json& json, SerializationContext& context, LuaS
     comp.script = DeserializeResource<LuaScript>(json, "script", context.resources);
 }
 
-COMPONENT(TagComponent, name, flags, layers, stencil)
+COMPONENT(TagComponent, flags, layers, stencil)
 COMPONENT(TransformationComponent, localTransformation, globalTransformation);
 COMPONENT(ParentComponent, parent)
 COMPONENT(RelationshipComponent, firstChild, lastChild, prevSibling, nextSibling)
@@ -150,7 +159,7 @@ COMPONENT(LightComponent, type, intensity, color, range, spotAngleDeg, generates
 nlohmann::json SerializeGO(GameObject go) {
     nlohmann::json json{};
     json["id"] = GameObjectHandle_t(go.Entity());
-    json["name"] = go.Name();
+    json["name"] = std::string{ go.Name() };
     json["static"] = go.IsStatic();
 
     SERIALIZE_COMP(json, go, TagComponent);
@@ -167,10 +176,10 @@ nlohmann::json SerializeGO(GameObject go) {
     return json;
 }
 
-void DeserializeGO(nlohmann::json json, SerializationContext& context) {
+void DeserializeGO(const nlohmann::json& json, SerializationContext& context) {
     const auto name{ json.value<std::string>("name", "") };
 
-    auto go{ context.world.CreateObject(name) };
+    auto go{ GameObject::Create(context.registry, name) };
     go.SetStatic(json.value("static", false));
 
     const GameObjectHandle localId{ json.value<GameObjectHandle_t>("id", {}) };
@@ -197,16 +206,11 @@ UGINE_FORCE_INLINE void FixId(GameObjectHandle& handle, const SerializationConte
 void FixIds(SerializationContext& context) {
     // Fix serialized world ID's with real-world ID's.
     for (auto ent : context.deserialized) {
-        auto go{ context.world.Get(ent) };
+        GameObject go{ context.registry, ent };
 
         // Sync global transformation.
         go.SetLocalTransformation(go.LocalTransformation());
 
-        if (go.Has<TagComponent>()) {
-            auto& tag{ go.Component<TagComponent>() };
-            tag.id = StringID{ tag.name.c_str() };
-        }
-
         if (go.Has<ParentComponent>()) {
             auto& parent{ go.Component<ParentComponent>() };
             FixId(parent.parent, context);
@@ -222,49 +226,775 @@ void FixIds(SerializationContext& context) {
     }
 }
 
-void WorldSerializer::Serialize(World& world, const Path& path) {
-    nlohmann::json j;
+namespace binary {
+    constexpr u32 NULL_INDEX{ ~0u };
 
-    world.Registry().each([&](auto entity) { j.push_back(SerializeGO(world.Get(entity))); });
+    // Objects per chunk, unit of parallel decoding.
+    constexpr u32 CHUNK_OBJECTS{ 4096 };
 
-    // TODO: ugine::OStream
-    //Vector<u8> test;
-    //OMemoryStream out{ test };
-    std::ofstream out{ path.Data() };
-    out << j;
-}
+    struct Header {
+        static constexpr u32 MAGIC{ 0x444c5755 }; // "UWLD"
+        static constexpr u32 VERSION{ 1 };
 
-void WorldSerializer::Deserialize(World& world, Engine& engine, const Path& path) {
-    nlohmann::json j;
+        u32 magic{ MAGIC };
+        u32 version{ VERSION };
+        u32 objects{};
+        u32 resources{};
+        u32 chunks{};
+        u32 reserved{};
+    };
 
-    try {
-        Vector<u8> data;
-        if (!engine.GetFileSystem().Read(path, data)) {
-            return;
+    enum class ChunkType : u32 {
+        Objects,
+        Transformation,
+        Parent,
+        Relationship,
+        Mesh,
+        Light,
+        Camera,
+        AnimationController,
+        Sky,
+        LuaScript,
+    };
+
+    struct ChunkHeader {
+        ChunkType type{};
+        u32 count{};
+        u64 size{}; // Payload bytes following the header.
+    };
+
+    struct PackedTransformation {
+        glm::vec3 position{};
+        glm::fquat rotation{};
+        glm::vec3 scale{};
+    };
+
+    class Writer {
+    public:
+        explicit Writer(Vector<u8>& out)
+            : out_{ out } {}
+
+        template <typename T> void Write(const T& value) {
+            static_assert(std::is_trivially_copyable_v<T>);
+            WriteBytes(&value, sizeof(T));
         }
-        data.PushBack(0);
-        j = nlohmann::json::parse(data.Data());
-    } catch (const std::exception& ex) {
-        UGINE_ERROR("Failed to deserialize world: {}", ex.what());
-        return;
+
+        void WriteBytes(const void* data, size_t size) {
+            // Vector reserves exactly, grow geometrically so writing values one by one stays linear.
+            if (out_.Size() + size > out_.Capacity()) {
+                out_.Reserve(std::max(out_.Size() + size, out_.Capacity() * 2));
+            }
+            out_.Append(static_cast<const u8*>(data), size);
+        }
+
+        size_t BeginChunk(ChunkType type, u32 count) {
+            const auto offset{ out_.Size() };
+            Write(ChunkHeader{ type, count });
+            return offset;
+        }
+
+        void EndChunk(size_t offset) {
+            const u64 size{ out_.Size() - offset - sizeof(ChunkHeader) };
+            memcpy(out_.Data() + offset + offsetof(ChunkHeader, size), &size, sizeof(size));
+        }
+
+    private:
+        Vector<u8>& out_;
+    };
+
+    class Reader {
+    public:
+        explicit Reader(Span<const u8> data)
+            : data_{ data } {}
+
+        template <typename T> bool Read(T& value) {
+            const auto bytes{ ReadBytes(sizeof(T)) };
+            if (!bytes) {
+                return false;
+            }
+            memcpy(&value, bytes, sizeof(T));
+            return true;
+        }
+
+        // Null if data ends sooner.
+        const u8* ReadBytes(size_t size) {
+            if (size > Remaining()) {
+                return nullptr;
+            }
+            const auto bytes{ data_.Data() + cursor_ };
+            cursor_ += size;
+            return bytes;
+        }
+
+        size_t Remaining() const { return data_.Size() - cursor_; }
+        bool End() const { return cursor_ == data_.Size(); }
+
+    private:
+        Span<const u8> data_;
+        size_t cursor_{};
+    };
+
+    template <typename T> bool ReadArray(Reader& in, std::vector<T>& values) {
+        if (values.size() > in.Remaining() / sizeof(T)) {
+            return false;
+        }
+        if (!values.empty()) {
+            memcpy(values.data(), in.ReadBytes(sizeof(T) * values.size()), sizeof(T) * values.size());
+        }
+        return true;
     }
 
-    SerializationContext context{
-        .world = world,
-        .resources = engine.GetResources(),
+    struct WriteContext {
+        std::unordered_map<GameObjectHandle, u32> objects;
+        std::vector<u8> detached; // Per object, parent isn't saved.
+        u32 detachedCount{};
+        std::unordered_map<ResourceID, u32> resourceIndices;
+        Vector<ResourceID> resources;
     };
 
-    for (auto& js : j) {
-        DeserializeGO(js, context);
+    struct ReadContext {
+        ResourceManager* resources{};
+        Vector<GameObjectHandle> objects;
+        Vector<ResourceID> resourceIds;
+        Vector<ResourceHandleTypeless> resolved;
+
+        // Calling thread only, handle reference counts aren't atomic.
+        template <typename T> ResourceHandle<T> Resource(u32 index) {
+            if (!resources || index >= resourceIds.Size()) {
+                return {};
+            }
+
+            auto& handle{ resolved[index] };
+            if (!handle) {
+                handle = resources->Get<T>(resourceIds[index]);
+                if (!handle) {
+                    return {};
+                }
+            }
+            return ResourceHandle<T>{ handle };
+        }
+    };
+
+    // Members are stored as returned by Encode, Decode restores them.
+    template <typename T>
+        requires std::is_trivially_copyable_v<T>
+    T Encode(const T& value, WriteContext&) {
+        return value;
     }
 
-    FixIds(context);
+    template <typename T>
+        requires std::is_trivially_copyable_v<T>
+    void Decode(const T& stored, T& value, ReadContext&) {
+        value = stored;
+    }
+
+    u8 Encode(bool value, WriteContext&) {
+        return value ? 1 : 0;
+    }
+
+    void Decode(u8 stored, bool& value, ReadContext&) {
+        value = stored != 0;
+    }
+
+    u32 Encode(GameObjectHandle handle, WriteContext& context) {
+        const auto index{ context.objects.find(handle) };
+        return index == context.objects.end() ? NULL_INDEX : index->second;
+    }
+
+    void Decode(u32 stored, GameObjectHandle& value, ReadContext& context) {
+        if (stored < context.objects.Size()) {
+            value = context.objects[stored];
+        } else {
+            value = GameObjectNull;
+        }
+    }
+
+    PackedTransformation Encode(const Transformation& value, WriteContext&) {
+        return PackedTransformation{ value.position, value.rotation, value.scale };
+    }
+
+    void Decode(const PackedTransformation& stored, Transformation& value, ReadContext&) {
+        value = Transformation{ stored.position, stored.rotation, stored.scale };
+    }
+
+    template <typename T> u32 Encode(const ResourceHandle<T>& handle, WriteContext& context) {
+        if (!handle) {
+            return NULL_INDEX;
+        }
+
+        const auto id{ handle->Id() };
+        const auto [index, inserted] = context.resourceIndices.try_emplace(id, u32(context.resources.Size()));
+        if (inserted) {
+            context.resources.PushBack(id);
+        }
+        return index->second;
+    }
+
+    template <typename T> void Decode(u32 stored, ResourceHandle<T>& value, ReadContext& context) {
+        value = context.Resource<T>(stored);
+    }
+
+    template <typename T, typename Member> void WriteColumn(Writer& out, Span<const T* const> comps, Member member, WriteContext& context) {
+        for (const auto comp : comps) {
+            out.Write(Encode(member(*comp), context));
+        }
+    }
+
+    template <typename T, typename Member> bool ReadColumn(Reader& in, Span<T> comps, Member member, ReadContext& context) {
+        using Value = std::remove_cvref_t<decltype(member(comps[0]))>;
+        using Stored = decltype(Encode(std::declval<const Value&>(), std::declval<WriteContext&>()));
+
+        if (comps.Size() > in.Remaining() / sizeof(Stored)) {
+            return false;
+        }
+
+        const auto column{ in.ReadBytes(sizeof(Stored) * comps.Size()) };
+        for (size_t i{}; i < comps.Size(); ++i) {
+            Stored stored;
+            memcpy(&stored, column + i * sizeof(Stored), sizeof(Stored));
+            Decode(stored, member(comps[i]), context);
+        }
+        return true;
+    }
+
+    template <typename T, typename... Members> void WriteColumns(Writer& out, Span<const T* const> comps, WriteContext& context, Members... members) {
+        (WriteColumn(out, comps, members, context), ...);
+    }
+
+    template <typename T, typename... Members> bool ReadColumns(Reader& in, Span<T> comps, ReadContext& context, Members... members) {
+        return (ReadColumn(in, comps, members, context) && ...);
+    }
+
+    // Column layout of component chunk payload, following object index column.
+    template <typename T> struct Chunk;
+
+#define BINARY_MEMBER(MEMBER) , [](auto& comp) -> auto& { return comp.MEMBER; }
+
+#define BINARY_COMPONENT(TYPE, CHUNK_TYPE, PARALLEL, ...)                                                                                                      \
+    template <> struct Chunk<TYPE> {                                                                                                                           \
+        static constexpr ChunkType TYPE_ID{ ChunkType::CHUNK_TYPE };                                                                                           \
+        static constexpr bool PARALLEL_DECODE{ PARALLEL };                                                                                                     \
+                                                                                                                                                               \
+        static void Write(Writer& out, Span<const TYPE* const> comps, WriteContext& context) {                                                                \
+            WriteColumns(out, comps, context NLOHMANN_JSON_EXPAND(NLOHMANN_JSON_PASTE(BINARY_MEMBER, __VA_ARGS__)));                                           \
+        }                                                                                                                                                      \
+                                                                                                                                                               \
+        static bool Read(Reader& in, Span<TYPE> comps, ReadContext& context) {                                                                                 \
+            return ReadColumns(in, comps, context NLOHMANN_JSON_EXPAND(NLOHMANN_JSON_PASTE(BINARY_MEMBER, __VA_ARGS__)));                                      \
+        }                                                                                                                                                      \
+    };
+
+    // Components holding resources decode on the calling thread.
+    BINARY_COMPONENT(TransformationComponent, Transformation, true, localTransformation, globalTransformation)
+    BINARY_COMPONENT(ParentComponent, Parent, true, parent)
+    BINARY_COMPONENT(RelationshipComponent, Relationship, true, children, firstChild, lastChild, prevSibling, nextSibling)
+    BINARY_COMPONENT(LightComponent, Light, true, type, intensity, color, range, spotAngleDeg, generatesShadows)
+    BINARY_COMPONENT(CameraComponent, Camera, true, isMain, projection, vFovDeg, zNear, zFar, width, height)
+    BINARY_COMPONENT(AnimationControllerComponent, AnimationController, false, animation, isRunning, speed, resolutionS)
+    BINARY_COMPONENT(SkyComponent, Sky, false, material)
+    BINARY_COMPONENT(LuaScriptComponent, LuaScript, false, script)
+
+    template <> struct Chunk<MeshComponent> {
+        static constexpr ChunkType TYPE_ID{ ChunkType::Mesh };
+        static constexpr bool PARALLEL_DECODE{};
+
+        // Materials and instances are variable length, counts column is followed by flattened values.
+        static void Write(Writer& out, Span<const MeshComponent* const> comps, WriteContext& context) {
+            for (const auto comp : comps) {
+                out.Write(Encode(comp->modelInstance.GetModel(), context));
+            }
+            for (const auto comp : comps) {
+                out.Write(u32(comp->modelInstance.GetMaterials().Size()));
+            }
+            for (const auto comp : comps) {
+                for (const auto& material : comp->modelInstance.GetMaterials()) {
+                    out.Write(Encode(material, context));
+                }
+            }
+
+            WriteColumns(out, comps, context BINARY_MEMBER(instanced));
+
+            for (const auto comp : comps) {
+                out.Write(u32(comp->instanceTransformations.size()));
+            }
+            for (const auto comp : comps) {
+                out.WriteBytes(comp->instanceTransformations.data(), sizeof(MaterialVertexInstance) * comp->instanceTransformations.size());
+            }
+        }
+
+        static bool Read(Reader& in, Span<MeshComponent> comps, ReadContext& context) {
+            std::vector<u32> models(comps.Size());
+            std::vector<u32> materialCounts(comps.Size());
+            if (!ReadArray(in, models) || !ReadArray(in, materialCounts)) {
+                return false;
+            }
+
+            for (size_t i{}; i < comps.Size(); ++i) {
+                if (materialCounts[i] > in.Remaining() / sizeof(u32)) {
+                    return false;
+                }
+
+                std::vector<u32> materialIndices(materialCounts[i]);
+                if (!ReadArray(in, materialIndices)) {
+                    return false;
+                }
+
+                Vector<ResourceHandle<Material>> materials(materialIndices.size());
+                for (size_t m{}; m < materialIndices.size(); ++m) {
+                    Decode(materialIndices[m], materials[m], context);
+                }
+
+                ResourceHandle<Model> model;
+                Decode(models[i], model, context);
+                comps[i].modelInstance = ModelInstance{ model, std::move(materials) };
+            }
+
+            std::vector<u32> instanceCounts(comps.Size());
+            if (!ReadColumns(in, comps, context BINARY_MEMBER(instanced)) || !ReadArray(in, instanceCounts)) {
+                return false;
+            }
+
+            for (size_t i{}; i < comps.Size(); ++i) {
+                if (instanceCounts[i] > in.Remaining() / sizeof(MaterialVertexInstance)) {
+                    return false;
+                }
+
+                comps[i].instanceTransformations.resize(instanceCounts[i]);
+                if (!ReadArray(in, comps[i].instanceTransformations)) {
+                    return false;
+                }
+            }
+            return true;
+        }
+    };
+
+    class DecodedChunk {
+    public:
+        virtual ~DecodedChunk() = default;
+
+        virtual bool Parallel() const = 0;
+        virtual bool Decode(ReadContext& context) = 0;
+        virtual void Create(GameObjectRegistry& registry, ReadContext& context) = 0;
+    };
+
+    // Object names, flags and tags, creates TagComponent for objects [first, first + count).
+    class ObjectsChunk final : public DecodedChunk {
+    public:
+        ObjectsChunk(Span<const u8> payload, u32 first, u32 count)
+            : payload_{ payload }
+            , first_{ first }
+            , count_{ count } {}
+
+        bool Parallel() const override { return true; }
+
+        bool Decode(ReadContext& context) override {
+            Reader in{ payload_ };
+
+            std::vector<u32> nameSizes(count_);
+            if (!ReadArray(in, nameSizes)) {
+                return false;
+            }
+
+            tags_.resize(count_);
+            for (u32 i{}; i < count_; ++i) {
+                const auto name{ in.ReadBytes(nameSizes[i]) };
+                if (!name) {
+                    return false;
+                }
+                tags_[i] = TagComponent::Init(std::string_view{ reinterpret_cast<const char*>(name), nameSizes[i] });
+            }
+
+            statics_.resize(count_);
+            return ReadArray(in, statics_)
+                && ReadColumns(in, Span<TagComponent>{ tags_.data(), tags_.size() },
+                    context BINARY_MEMBER(flags) BINARY_MEMBER(layers) BINARY_MEMBER(stencil))
+                && in.End();
+        }
+
+        void Create(GameObjectRegistry& registry, ReadContext& context) override {
+            const auto objects{ context.objects.Data() + first_ };
+            registry.insert<TagComponent>(objects, objects + count_, tags_.begin());
+
+            for (u32 i{}; i < count_; ++i) {
+                if (statics_[i]) {
+                    registry.emplace<StaticFlagComponent>(objects[i]);
+                }
+            }
+        }
+
+        static void Write(Writer& out, GameObjectRegistry& registry, Span<const GameObjectHandle> objects, WriteContext& context) {
+            static const TagComponent EMPTY_TAG{};
+
+            std::vector<const TagComponent*> tags(objects.Size());
+            std::vector<StringView> names(objects.Size());
+            for (size_t i{}; i < objects.Size(); ++i) {
+                const auto tag{ registry.try_get<TagComponent>(objects[i]) };
+                tags[i] = tag ? tag : &EMPTY_TAG;
+                names[i] = tags[i]->id.Name();
+            }
+
+            for (const auto& name : names) {
+                out.Write(u32(name.Size()));
+            }
+            for (const auto& name : names) {
+                out.WriteBytes(name.Data(), name.Size());
+            }
+            for (const auto object : objects) {
+                out.Write(u8(registry.all_of<StaticFlagComponent>(object) ? 1 : 0));
+            }
+
+            WriteColumns(out, Span<const TagComponent* const>{ tags.data(), tags.size() },
+                context BINARY_MEMBER(flags) BINARY_MEMBER(layers) BINARY_MEMBER(stencil));
+        }
+
+    private:
+        Span<const u8> payload_;
+        u32 first_{};
+        u32 count_{};
+        std::vector<TagComponent> tags_;
+        std::vector<u8> statics_;
+    };
+
+    template <typename T> class ComponentChunk final : public DecodedChunk {
+    public:
+        ComponentChunk(Span<const u8> payload, u32 count)
+            : payload_{ payload }
+            , count_{ count } {}
+
+        bool Parallel() const override { return Chunk<T>::PARALLEL_DECODE; }
+
+        bool Decode(ReadContext& context) override {
+            Reader in{ payload_ };
+
+            objects_.resize(count_);
+            if (!ReadArray(in, objects_)) {
+                return false;
+            }
+
+            for (auto& object : objects_) {
+                if (object >= context.objects.Size()) {
+                    return false;
+                }
+                object = GameObjectHandle_t(context.objects[object]);
+            }
+
+            components_.resize(count_);
+            return Chunk<T>::Read(in, Span<T>{ components_.data(), components_.size() }, context) && in.End();
+        }
+
+        void Create(GameObjectRegistry& registry, ReadContext&) override {
+            const auto objects{ reinterpret_cast<const GameObjectHandle*>(objects_.data()) };
+            registry.insert<T>(objects, objects + count_, std::make_move_iterator(components_.begin()));
+
+            // Same notifications as components created one by one.
+            for (u32 i{}; i < count_; ++i) {
+                registry.patch<T>(objects[i]);
+            }
+        }
+
+    private:
+        static_assert(sizeof(GameObjectHandle) == sizeof(u32));
+
+        Span<const u8> payload_;
+        u32 count_{};
+        std::vector<u32> objects_; // Object indices, replaced by handles once decoded.
+        std::vector<T> components_;
+    };
+
+    class DecodeTask final : public Task {
+    public:
+        DecodeTask(Span<DecodedChunk* const> chunks, ReadContext& context)
+            : Task{ u32(chunks.Size()), 1 }
+            , chunks_{ chunks }
+            , context_{ context } {}
+
+        void Run(u32 start, u32 end, u32 threadNum) override {
+            for (auto i{ start }; i < end; ++i) {
+                if (!chunks_[i]->Decode(context_)) {
+                    failed = true;
+                }
+            }
+        }
+
+        std::atomic_bool failed{};
+
+    private:
+        Span<DecodedChunk* const> chunks_;
+        ReadContext& context_;
+    };
+
+    // Objects whose parent isn't saved load as roots where they were: without parent and siblings, global transformation
+    // becomes the local one.
+    TransformationComponent Detached(const TransformationComponent& comp) {
+        auto result{ comp };
+        result.localTransformation = comp.globalTransformation;
+        return result;
+    }
+
+    RelationshipComponent Detached(const RelationshipComponent& comp) {
+        auto result{ comp };
+        result.prevSibling = result.nextSibling = GameObjectNull;
+        return result;
+    }
+
+    template <typename T>
+    concept Detachable = requires(const T& comp) { Detached(comp); };
+
+    template <typename T>
+    void WriteComponents(Writer& out, GameObjectRegistry& registry, Span<const GameObjectHandle> objects, WriteContext& context, u32& chunks) {
+        std::vector<u32> indices;
+        std::vector<const T*> comps;
+        std::vector<T> detached;
+        if constexpr (Detachable<T>) {
+            // Pointers to it are kept.
+            detached.reserve(context.detachedCount);
+        }
+
+        for (u32 i{}; i < objects.Size(); ++i) {
+            const T* comp{ registry.try_get<T>(objects[i]) };
+            if (!comp) {
+                continue;
+            }
+
+            if (context.detached[i]) {
+                if constexpr (std::is_same_v<T, ParentComponent>) {
+                    continue;
+                } else if constexpr (Detachable<T>) {
+                    comp = &detached.emplace_back(Detached(*comp));
+                }
+            }
+
+            indices.push_back(i);
+            comps.push_back(comp);
+        }
+
+        for (size_t first{}; first < comps.size(); first += CHUNK_OBJECTS) {
+            const auto count{ u32(std::min<size_t>(CHUNK_OBJECTS, comps.size() - first)) };
+
+            const auto chunk{ out.BeginChunk(Chunk<T>::TYPE_ID, count) };
+            out.WriteBytes(indices.data() + first, sizeof(u32) * count);
+            Chunk<T>::Write(out, Span<const T* const>{ comps.data() + first, count }, context);
+            out.EndChunk(chunk);
+
+            ++chunks;
+        }
+    }
+
+    template <typename T> std::unique_ptr<DecodedChunk> MakeChunk(Span<const u8> payload, u32 count) {
+        return std::make_unique<ComponentChunk<T>>(payload, count);
+    }
+
+    void Save(GameObjectRegistry& registry, Span<const GameObjectHandle> objects, Vector<u8>& out) {
+        WriteContext context;
+        context.objects.reserve(objects.Size());
+        for (u32 i{}; i < objects.Size(); ++i) {
+            context.objects.emplace(objects[i], i);
+        }
+
+        context.detached.resize(objects.Size());
+        for (u32 i{}; i < objects.Size(); ++i) {
+            const auto parent{ registry.try_get<ParentComponent>(objects[i]) };
+            if (parent && !context.objects.contains(parent->parent)) {
+                context.detached[i] = 1;
+                ++context.detachedCount;
+            }
+        }
+
+        // Resource table is known once all chunks are written.
+        Vector<u8> chunkData;
+        Writer chunkOut{ chunkData };
+        u32 chunks{};
+
+        for (u32 first{}; first < objects.Size(); first += CHUNK_OBJECTS) {
+            const auto count{ std::min(CHUNK_OBJECTS, u32(objects.Size()) - first) };
+
+            const auto chunk{ chunkOut.BeginChunk(ChunkType::Objects, count) };
+            ObjectsChunk::Write(chunkOut, registry, Span<const GameObjectHandle>{ objects.Data() + first, count }, context);
+            chunkOut.EndChunk(chunk);
+
+            ++chunks;
+        }
+
+        WriteComponents<TransformationComponent>(chunkOut, registry, objects, context, chunks);
+        WriteComponents<ParentComponent>(chunkOut, registry, objects, context, chunks);
+        WriteComponents<RelationshipComponent>(chunkOut, registry, objects, context, chunks);
+        WriteComponents<MeshComponent>(chunkOut, registry, objects, context, chunks);
+        WriteComponents<LightComponent>(chunkOut, registry, objects, context, chunks);
+        WriteComponents<CameraComponent>(chunkOut, registry, objects, context, chunks);
+        WriteComponents<AnimationControllerComponent>(chunkOut, registry, objects, context, chunks);
+        WriteComponents<SkyComponent>(chunkOut, registry, objects, context, chunks);
+        WriteComponents<LuaScriptComponent>(chunkOut, registry, objects, context, chunks);
+
+        const Header header{
+            .objects = u32(objects.Size()),
+            .resources = u32(context.resources.Size()),
+            .chunks = chunks,
+        };
+
+        out.Clear();
+        out.Reserve(sizeof(header) + sizeof(ResourceID) * context.resources.Size() + chunkData.Size());
+        out.Append(reinterpret_cast<const u8*>(&header), sizeof(header));
+        out.Append(reinterpret_cast<const u8*>(context.resources.Data()), sizeof(ResourceID) * context.resources.Size());
+        out.Append(chunkData.Data(), chunkData.Size());
+    }
+
+    bool Load(GameObjectRegistry& registry, Span<const u8> data, ResourceManager* resources, Scheduler* scheduler, Vector<GameObjectHandle>* loaded) {
+        Reader in{ data };
+
+        Header header{};
+        if (!in.Read(header) || header.magic != Header::MAGIC || header.version != Header::VERSION) {
+            UGINE_ERROR("Unsupported world version {}.", header.version);
+            return false;
+        }
+
+        ReadContext context{ .resources = resources };
+
+        const auto resourceIds{ in.ReadBytes(sizeof(ResourceID) * header.resources) };
+        if (!resourceIds) {
+            UGINE_ERROR("Corrupted world resource table.");
+            return false;
+        }
+        context.resourceIds.Append(reinterpret_cast<const ResourceID*>(resourceIds), header.resources);
+        context.resolved.Resize(header.resources);
+
+        std::vector<std::unique_ptr<DecodedChunk>> chunks;
+        chunks.reserve(std::min<size_t>(header.chunks, in.Remaining() / sizeof(ChunkHeader)));
+
+        u32 objects{};
+        for (u32 i{}; i < header.chunks; ++i) {
+            ChunkHeader chunk{};
+            const auto payload{ in.Read(chunk) ? in.ReadBytes(chunk.size) : nullptr };
+            if (!payload) {
+                UGINE_ERROR("Corrupted world chunk {}.", i);
+                return false;
+            }
+
+            // Counts size allocations while decoding, each object takes an index or name size at least.
+            if (chunk.count > header.objects || u64(chunk.count) * sizeof(u32) > chunk.size) {
+                UGINE_ERROR("Corrupted world chunk {}.", i);
+                return false;
+            }
+
+            const Span<const u8> chunkData{ payload, size_t(chunk.size) };
+            switch (chunk.type) {
+            case ChunkType::Objects:
+                if (chunk.count > header.objects - objects) {
+                    UGINE_ERROR("Corrupted world chunk {}.", i);
+                    return false;
+                }
+                chunks.push_back(std::make_unique<ObjectsChunk>(chunkData, objects, chunk.count));
+                objects += chunk.count;
+                break;
+            case ChunkType::Transformation: chunks.push_back(MakeChunk<TransformationComponent>(chunkData, chunk.count)); break;
+            case ChunkType::Parent: chunks.push_back(MakeChunk<ParentComponent>(chunkData, chunk.count)); break;
+            case ChunkType::Relationship: chunks.push_back(MakeChunk<RelationshipComponent>(chunkData, chunk.count)); break;
+            case ChunkType::Mesh: chunks.push_back(MakeChunk<MeshComponent>(chunkData, chunk.count)); break;
+            case ChunkType::Light: chunks.push_back(MakeChunk<LightComponent>(chunkData, chunk.count)); break;
+            case ChunkType::Camera: chunks.push_back(MakeChunk<CameraComponent>(chunkData, chunk.count)); break;
+            case ChunkType::AnimationController: chunks.push_back(MakeChunk<AnimationControllerComponent>(chunkData, chunk.count)); break;
+            case ChunkType::Sky: chunks.push_back(MakeChunk<SkyComponent>(chunkData, chunk.count)); break;
+            case ChunkType::LuaScript: chunks.push_back(MakeChunk<LuaScriptComponent>(chunkData, chunk.count)); break;
+            default: UGINE_WARN("Skipping unknown world chunk type {}.", u32(chunk.type)); break;
+            }
+        }
+
+        if (objects != header.objects) {
+            UGINE_ERROR("Corrupted world, {} of {} objects.", objects, header.objects);
+            return false;
+        }
+
+        // Object references decode to handles, so objects exist before chunks are decoded.
+        context.objects.Resize(header.objects);
+        registry.create(context.objects.Data(), context.objects.Data() + context.objects.Size());
+
+        std::vector<DecodedChunk*> parallel;
+        for (auto& chunk : chunks) {
+            if (chunk->Parallel()) {
+                parallel.push_back(chunk.get());
+            }
+        }
+
+        bool failed{};
+        {
+            DecodeTask task{ Span<DecodedChunk* const>{ parallel.data(), parallel.size() }, context };
+            if (scheduler && parallel.size() > 1) {
+                scheduler->Schedule(&task);
+            } else if (!parallel.empty()) {
+                task.Run(0, u32(parallel.size()), 0);
+            }
+
+            // Resource chunks meanwhile on the calling thread.
+            for (auto& chunk : chunks) {
+                if (!chunk->Parallel() && !chunk->Decode(context)) {
+                    failed = true;
+                }
+            }
+
+            if (scheduler && parallel.size() > 1) {
+                scheduler->WaitFor(&task);
+            }
+            failed |= task.failed;
+        }
+
+        if (failed) {
+            UGINE_ERROR("Corrupted world component data.");
+            registry.destroy(context.objects.Data(), context.objects.Data() + context.objects.Size());
+            return false;
+        }
+
+        // File order: objects and their tags first, data is freed as soon as components are created.
+        for (auto& chunk : chunks) {
+            chunk->Create(registry, context);
+            chunk.reset();
+        }
+
+        for (const auto object : context.objects) {
+            if (!registry.all_of<RelationshipComponent>(object)) {
+                registry.emplace<RelationshipComponent>(object);
+            }
+            if (!registry.all_of<TransformationComponent>(object)) {
+                registry.emplace<TransformationComponent>(object);
+            }
+        }
+
+        if (loaded) {
+            loaded->Append(context.objects.Data(), context.objects.Size());
+        }
+
+        return true;
+    }
+} // namespace binary
+
+void WorldSerializer::Serialize(World& world, const Path& path, Format format) {
+    Vector<GameObjectHandle> objects;
+    world.Registry().each([&](auto entity) { objects.PushBack(entity); });
+
+    Vector<u8> data;
+    Save(world.Registry(), objects.ToSpan(), format, data);
+
+    if (!WriteFileBinary(path, data)) {
+        UGINE_ERROR("Failed to write world '{}'.", path.Data());
+    }
 }
 
-void WorldSerializer::Serialize(World& world, const GameObject& go, const Path& path) {
-    nlohmann::json j;
+void WorldSerializer::Deserialize(World& world, Engine& engine, const Path& path) {
+    const auto start{ std::chrono::high_resolution_clock::now() };
 
-    j.push_back(SerializeGO(go));
+    Vector<u8> data;
+    if (!engine.GetFileSystem().Read(path, data)) {
+        UGINE_ERROR("Failed to read world '{}'.", path.Data());
+        return;
+    }
+
+    const auto objects{ world.Size() };
+    if (Load(world.Registry(), data.ToSpan(), &engine.GetResources(), &engine.GetScheduler())) {
+        const std::chrono::duration<f64, std::milli> time{ std::chrono::high_resolution_clock::now() - start };
+        UGINE_INFO("Loaded world '{}', {} objects in {:.1f} ms.", path.Data(), world.Size() - objects, time.count());
+    }
+}
+
+void WorldSerializer::Serialize(World& world, const GameObject& go, const Path& path, Format format) {
+    Vector<GameObjectHandle> objects{ go.Entity() };
 
     Vector<GameObject> goStack{ go };
     while (!goStack.Empty()) {
@@ -277,13 +1007,86 @@ void WorldSerializer::Serialize(World& world, const GameObject& go, const Path&
                 goStack.PushBack(child);
             }
 
-            j.push_back(SerializeGO(child));
+            objects.PushBack(child.Entity());
             child = child.NextSibling();
         }
     }
 
-    std::ofstream out{ path.Data() };
-    out << j;
+    Vector<u8> data;
+    Save(world.Registry(), objects.ToSpan(), format, data);
+
+    if (!WriteFileBinary(path, data)) {
+        UGINE_ERROR("Failed to write prefab '{}'.", path.Data());
+    }
+}
+
+void WorldSerializer::Save(GameObjectRegistry& registry, Span<const GameObjectHandle> objects, Format format, Vector<u8>& out) {
+    PROFILE_EVENT();
+
+    if (format == Format::Binary) {
+        binary::Save(registry, objects, out);
+        return;
+    }
+
+    auto j{ nlohmann::json::array() };
+    for (const auto object : objects) {
+        j.push_back(SerializeGO(GameObject{ registry, object }));
+    }
+
+    const auto text{ j.dump() };
+    out.Clear();
+    out.Append(reinterpret_cast<const u8*>(text.data()), text.size());
+}
+
+bool WorldSerializer::Load(
+    GameObjectRegistry& registry, Span<const u8> data, ResourceManager* resources, Scheduler* scheduler, Vector<GameObjectHandle>* objects) {
+    PROFILE_EVENT();
+
+    if (data.Size() >= sizeof(u32) && memcmp(data.Data(), &binary::Header::MAGIC, sizeof(u32)) == 0) {
+        return binary::Load(registry, data, resources, scheduler, objects);
+    }
+
+    nlohmann::json j;
+    try {
+        j = nlohmann::json::parse(data.Data(), data.Data() + data.Size());
+    } catch (const std::exception& ex) {
+        UGINE_ERROR("Failed to deserialize world: {}", ex.what());
+        return false;
+    }
+
+    SerializationContext context{
+        .registry = registry,
+        .resources = resources,
+    };
+
+    for (const auto& js : j) {
+        DeserializeGO(js, context);
+    }
+
+    FixIds(context);
+
+    if (objects) {
+        objects->Append(context.deserialized.Data(), context.deserialized.Size());
+    }
+
+    return true;
+}
+
+bool WorldSerializer::Dependencies(Span<const u8> data, Vector<ResourceID>& resources) {
+    binary::Reader in{ data };
+
+    binary::Header header{};
+    if (!in.Read(header) || header.magic != binary::Header::MAGIC || header.version != binary::Header::VERSION) {
+        return false;
+    }
+
+    const auto ids{ in.ReadBytes(sizeof(ResourceID) * header.resources) };
+    if (!ids) {
+        return false;
+    }
+
+    resources.Append(reinterpret_cast<const ResourceID*>(ids), header.resources);
+    return true;
 }
 
-} // namespace ugine
\ No newline at end of file
+} // namespace ugine
@@ -1,20 +1,49 @@
 #pragma once
 
+#include <ugine/engine/world/GameObject.h>
+
+#include <ugine/Span.h>
+#include <ugine/Ugine.h>
+#include <ugine/Vector.h>
+
 namespace ugine {
 
 class Engine;
 class GameObject;
-class World;
 class Path;
+class ResourceManager;
+class Scheduler;
+class World;
+struct ResourceID;
 
+// Worlds are saved in binary chunked format by default: each component type is stored as columns of its members in chunks
+// of objects, object references as indices into the saved object list and resource references as indices into a resource
+// table. Loading decodes chunks in parallel and creates components in bulk. JSON stays available for interchange, loading
+// detects the format.
 class WorldSerializer {
 public:
+    enum class Format {
+        Binary,
+        Json,
+    };
+
     WorldSerializer() = default;
 
-    void Serialize(World& world, const Path& path);
-    void Serialize(World& world, const GameObject& go, const Path& path);
+    void Serialize(World& world, const Path& path, Format format = Format::Binary);
+    void Serialize(World& world, const GameObject& go, const Path& path, Format format = Format::Binary);
 
     void Deserialize(World& world, Engine& engine, const Path& path);
+
+    // References to objects outside of the list are saved as null.
+    static void Save(GameObjectRegistry& registry, Span<const GameObjectHandle> objects, Format format, Vector<u8>& out);
+
+    // Resource references stay empty without resource manager. Chunks without resources are decoded on scheduler workers
+    // when given, components are created on the calling thread. Created objects are appended to objects.
+    static bool Load(GameObjectRegistry& registry, Span<const u8> data, ResourceManager* resources = nullptr, Scheduler* scheduler = nullptr,
+        Vector<GameObjectHandle>* objects = nullptr);
+
+    // Appends resource table of binary world, false for JSON or corrupted data.
+    static bool Dependencies(Span<const u8> data, Vector<ResourceID>& resources);
 };
 
-} // namespace ugine
\ No newline at end of file
+} // namespace ugine
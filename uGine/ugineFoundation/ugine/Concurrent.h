@@ -1,26 +1,34 @@
 #pragma once
 
-#include "Assert.h"
 #include "Locking.h"
 #include "Memory.h"
+#include "Ugine.h"
 #include "Vector.h"
 
 #include <array>
 #include <atomic>
+#include <cstring>
+#include <limits>
+#include <new>
+#include <type_traits>
 
 namespace ugine {
 
 // Based on lockfree stack from Intrinsic engine: https://github.com/begla/Intrinsic
+// Only push_back/insert may run concurrently (parallel append), reading and popping requires all writers to be done.
 template <class T> class LockFreeStack {
 public:
     LockFreeStack(IAllocator& allocator, u32 capacity)
         : allocator_{ allocator } {
-        data_ = allocator.AlignedAlloc(capacity * sizeof(T), alignof(T));
+        data_ = static_cast<T*>(allocator.AlignedAlloc(capacity * sizeof(T), alignof(T)));
         capacity_ = capacity;
         size_ = 0u;
     }
 
-    ~LockFreeStack() { allocator_.Free(data_); }
+    LockFreeStack(const LockFreeStack&) = delete;
+    LockFreeStack& operator=(const LockFreeStack&) = delete;
+
+    ~LockFreeStack() { allocator_->AlignedFree(data_); }
 
     void push_back(const T& element) {
         auto oldSize{ size_.fetch_add(1) };
@@ -51,18 +59,18 @@ public:
     u64 size() const { return size_; }
 
     T& operator[](u64 idx) { return data_[idx]; }
-    T& operator[](u64 idx) const { return data_[idx]; }
+    const T& operator[](u64 idx) const { return data_[idx]; }
 
     void insert(const Vector<T>& vals) {
-        const std::atomic_uint64_t oldSize = size_.fetch_add(vals.size());
-        UGINE_ASSERT(oldSize + vals.size() <= capacity_);
-        memcpy(&data_[oldSize], vals.data(), vals.size() * sizeof(T));
+        const auto oldSize{ size_.fetch_add(vals.Size()) };
+        UGINE_ASSERT(oldSize + vals.Size() <= capacity_);
+        memcpy(&data_[oldSize], vals.Data(), vals.Size() * sizeof(T));
     }
 
     template <typename Container> void copy(Container& vals) const {
-        const u32 startIdx = static_cast<u32>(vals.size());
-        vals.resize(vals.size() + size_);
-        memcpy(&vals.data()[startIdx], data_, size_ * sizeof(T));
+        const u32 startIdx = static_cast<u32>(vals.Size());
+        vals.Resize(vals.Size() + size_);
+        memcpy(&vals.Data()[startIdx], data_, size_ * sizeof(T));
     }
 
 private:
@@ -72,44 +80,286 @@ private:
     std::atomic_uint64_t size_;
 };
 
-template <typename _T, u32 _Capacity, typename _MutexType = AtomicSpinLock> class ConcurentRingbuffer {
+// Bounded lock free multi producer multi consumer queue (Dmitry Vyukov's design).
+// Each cell carries a sequence number, equal to the position when the cell is free for a producer and to
+// position + 1 once it holds a value for a consumer. Producers and consumers only contend on their own position.
+template <typename _T, u32 _Capacity> class MPMCQueue {
 public:
-    static const u32 Capacity{ _Capacity };
-    using MutexType = _MutexType;
+    static constexpr u32 Capacity{ _Capacity };
     using ValueType = _T;
 
-    inline bool PushBack(const ValueType& item) {
-        bool result{};
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity must be power of two");
 
-        Lock lock{ mutex_ };
-        u32 next = (head_ + 1) % Capacity;
-        if (next != tail_) {
-            data_[head_] = item;
-            head_ = next;
-            result = true;
+    MPMCQueue() {
+        for (u32 i{}; i < Capacity; ++i) {
+            cells_[i].sequence.store(i, std::memory_order_relaxed);
         }
+    }
+
+    MPMCQueue(const MPMCQueue&) = delete;
+    MPMCQueue& operator=(const MPMCQueue&) = delete;
 
-        return result;
+    ~MPMCQueue() {
+        if constexpr (!std::is_trivially_destructible_v<ValueType>) {
+            for (auto pos{ dequeuePos_.load() }; pos != enqueuePos_.load(); ++pos) {
+                cells_[pos & MASK].Value()->~ValueType();
+            }
+        }
     }
 
-    inline bool PopFront(ValueType& item) {
-        bool result{};
+    template <typename U> bool PushBack(U&& item) {
+        Cell* cell{};
+        auto pos{ enqueuePos_.load(std::memory_order_relaxed) };
+        for (;;) {
+            cell = &cells_[pos & MASK];
+            const auto sequence{ cell->sequence.load(std::memory_order_acquire) };
+            const auto diff{ i64(sequence - pos) };
+            if (diff == 0) {
+                if (enqueuePos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false; // Full.
+            } else {
+                pos = enqueuePos_.load(std::memory_order_relaxed);
+            }
+        }
+
+        new (cell->storage) ValueType(std::forward<U>(item));
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
 
-        Lock lock{ mutex_ };
-        if (tail_ != head_) {
-            item = data_[tail_];
-            tail_ = (tail_ + 1) % Capacity;
-            result = true;
+    bool PopFront(ValueType& item) {
+        Cell* cell{};
+        auto pos{ dequeuePos_.load(std::memory_order_relaxed) };
+        for (;;) {
+            cell = &cells_[pos & MASK];
+            const auto sequence{ cell->sequence.load(std::memory_order_acquire) };
+            const auto diff{ i64(sequence - (pos + 1)) };
+            if (diff == 0) {
+                if (dequeuePos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false; // Empty.
+            } else {
+                pos = dequeuePos_.load(std::memory_order_relaxed);
+            }
         }
 
-        return result;
+        auto value{ cell->Value() };
+        item = std::move(*value);
+        value->~ValueType();
+        cell->sequence.store(pos + Capacity, std::memory_order_release);
+        return true;
     }
 
+    // Exact only when no other thread is pushing or popping.
+    u32 SizeApprox() const {
+        const auto enqueue{ enqueuePos_.load(std::memory_order_relaxed) };
+        const auto dequeue{ dequeuePos_.load(std::memory_order_relaxed) };
+        return enqueue > dequeue ? u32(enqueue - dequeue) : 0;
+    }
+
+    bool Empty() const { return SizeApprox() == 0; }
+
 private:
-    std::array<ValueType, Capacity> data_;
-    u32 head_{};
-    u32 tail_{};
-    MutexType mutex_{};
+    static constexpr u64 MASK{ Capacity - 1 };
+
+    struct Cell {
+        std::atomic_uint64_t sequence{};
+        alignas(ValueType) u8 storage[sizeof(ValueType)];
+
+        ValueType* Value() { return std::launder(reinterpret_cast<ValueType*>(storage)); }
+    };
+
+    std::array<Cell, Capacity> cells_;
+    alignas(UGINE_CACHE_LINE_SIZE) std::atomic_uint64_t enqueuePos_{};
+    alignas(UGINE_CACHE_LINE_SIZE) std::atomic_uint64_t dequeuePos_{};
+};
+
+// Bounded wait free single producer single consumer ring.
+// Positions live on separate cache lines, each side caches the other one's position and re-reads it only when
+// the ring looks full (producer) or empty (consumer).
+template <typename _T, u32 _Capacity> class SPSCRing {
+public:
+    static constexpr u32 Capacity{ _Capacity };
+    using ValueType = _T;
+
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity must be power of two");
+
+    SPSCRing() = default;
+
+    SPSCRing(const SPSCRing&) = delete;
+    SPSCRing& operator=(const SPSCRing&) = delete;
+
+    ~SPSCRing() {
+        if constexpr (!std::is_trivially_destructible_v<ValueType>) {
+            for (auto pos{ head_.load() }; pos != tail_.load(); ++pos) {
+                Value(pos)->~ValueType();
+            }
+        }
+    }
+
+    // Producer only.
+    template <typename U> bool PushBack(U&& item) {
+        const auto tail{ tail_.load(std::memory_order_relaxed) };
+        if (tail - cachedHead_ == Capacity) {
+            cachedHead_ = head_.load(std::memory_order_acquire);
+            if (tail - cachedHead_ == Capacity) {
+                return false; // Full.
+            }
+        }
+
+        new (&storage_[(tail & MASK) * sizeof(ValueType)]) ValueType(std::forward<U>(item));
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer only.
+    bool PopFront(ValueType& item) {
+        const auto head{ head_.load(std::memory_order_relaxed) };
+        if (head == cachedTail_) {
+            cachedTail_ = tail_.load(std::memory_order_acquire);
+            if (head == cachedTail_) {
+                return false; // Empty.
+            }
+        }
+
+        auto value{ Value(head) };
+        item = std::move(*value);
+        value->~ValueType();
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    u32 SizeApprox() const { return u32(tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_acquire)); }
+    bool Empty() const { return SizeApprox() == 0; }
+
+private:
+    static constexpr u64 MASK{ Capacity - 1 };
+
+    ValueType* Value(u64 pos) { return std::launder(reinterpret_cast<ValueType*>(&storage_[(pos & MASK) * sizeof(ValueType)])); }
+
+    alignas(ValueType) u8 storage_[Capacity * sizeof(ValueType)];
+
+    // Consumer.
+    alignas(UGINE_CACHE_LINE_SIZE) std::atomic_uint64_t head_{};
+    u64 cachedTail_{};
+
+    // Producer.
+    alignas(UGINE_CACHE_LINE_SIZE) std::atomic_uint64_t tail_{};
+    u64 cachedHead_{};
+};
+
+
+// Single producer single consumer ring of variable sized blocks. Blocks are contiguous and 8 B aligned, block which
+// doesn't fit before end of storage is preceded by a padding block which consumer skips.
+template <u32 _Capacity> class SPSCByteRing {
+public:
+    static constexpr u32 Capacity{ _Capacity };
+    static constexpr u32 ALIGNMENT{ 8 };
+    // Larger blocks may never fit, padding can take up to half of the ring.
+    static constexpr u32 MAX_BLOCK_SIZE{ Capacity / 2 - ALIGNMENT };
+
+    static_assert(Capacity >= 64 && (Capacity & (Capacity - 1)) == 0, "Capacity must be power of two");
+
+    SPSCByteRing() = default;
+
+    SPSCByteRing(const SPSCByteRing&) = delete;
+    SPSCByteRing& operator=(const SPSCByteRing&) = delete;
+
+    // Producer only. Space for block of given size, null when ring is full. Block is visible to consumer after Commit.
+    u8* Reserve(u32 size) {
+        UGINE_ASSERT(size <= MAX_BLOCK_SIZE);
+
+        const auto blockSize{ BlockSize(size) };
+        auto tail{ tail_.load(std::memory_order_relaxed) };
+        const auto contiguous{ Capacity - u32(tail & MASK) };
+        const auto needed{ blockSize <= contiguous ? blockSize : contiguous + blockSize };
+
+        if (tail + needed - cachedHead_ > Capacity) {
+            cachedHead_ = head_.load(std::memory_order_acquire);
+            if (tail + needed - cachedHead_ > Capacity) {
+                return nullptr; // Full.
+            }
+        }
+
+        if (blockSize > contiguous) {
+            *Header(tail) = BlockHeader{ contiguous, true };
+            tail += contiguous;
+        }
+
+        *Header(tail) = BlockHeader{ blockSize, false };
+        reserved_ = tail + blockSize;
+        return reinterpret_cast<u8*>(Header(tail) + 1);
+    }
+
+    // Producer only. Publishes block returned by last Reserve.
+    void Commit() { tail_.store(reserved_, std::memory_order_release); }
+
+    // Consumer only. Position after last committed block, used as Front limit to consume only blocks committed so far.
+    u64 CommittedEnd() const { return tail_.load(std::memory_order_acquire); }
+
+    // Consumer only. Oldest committed block before end, null when there is none.
+    const u8* Front(u64 end = std::numeric_limits<u64>::max()) {
+        auto head{ head_.load(std::memory_order_relaxed) };
+        for (;;) {
+            if (head == end) {
+                return nullptr;
+            }
+
+            if (head == cachedTail_) {
+                cachedTail_ = tail_.load(std::memory_order_acquire);
+                if (head == cachedTail_) {
+                    return nullptr; // Empty.
+                }
+            }
+
+            const auto header{ Header(head) };
+            if (!header->padding) {
+                return reinterpret_cast<const u8*>(header + 1);
+            }
+
+            head += header->size;
+            head_.store(head, std::memory_order_release);
+        }
+    }
+
+    // Consumer only. Releases block returned by Front.
+    void PopFront() {
+        const auto head{ head_.load(std::memory_order_relaxed) };
+        head_.store(head + Header(head)->size, std::memory_order_release);
+    }
+
+    u32 SizeApprox() const { return u32(tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_acquire)); }
+    bool Empty() const { return SizeApprox() == 0; }
+
+private:
+    static constexpr u64 MASK{ Capacity - 1 };
+
+    struct BlockHeader {
+        u32 size; // Including header.
+        u32 padding;
+    };
+
+    static_assert(sizeof(BlockHeader) == ALIGNMENT);
+
+    static constexpr u32 BlockSize(u32 size) { return (u32(sizeof(BlockHeader)) + size + ALIGNMENT - 1) & ~(ALIGNMENT - 1); }
+
+    BlockHeader* Header(u64 pos) { return reinterpret_cast<BlockHeader*>(&storage_[pos & MASK]); }
+
+    alignas(UGINE_CACHE_LINE_SIZE) u8 storage_[Capacity];
+
+    // Consumer.
+    alignas(UGINE_CACHE_LINE_SIZE) std::atomic_uint64_t head_{};
+    u64 cachedTail_{};
+
+    // Producer.
+    alignas(UGINE_CACHE_LINE_SIZE) std::atomic_uint64_t tail_{};
+    u64 cachedHead_{};
+    u64 reserved_{};
 };
 
-} // namespace ugine
\ No newline at end of file
+} // namespace ugine
@@ -0,0 +1,288 @@
+#include "DerivedDataCache.h"
+
+#include "File.h"
+#include "FileSystem.h"
+#include "Hash.h"
+#include "Profile.h"
+
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <vector>
+
+namespace ugine {
+
+namespace {
+    struct EntryHeader {
+        static constexpr u32 MAGIC{ 0x43444455 }; // "UDDC"
+        static constexpr u32 VERSION{ 1 };
+
+        u32 magic{ MAGIC };
+        u32 version{ VERSION };
+        u64 size{};
+        u64 checksum{};
+    };
+
+    constexpr std::string_view ENTRY_EXTENSION{ ".ddc" };
+    constexpr std::string_view SIZE_FILE{ "size" };
+
+    // Entries shrink to this fraction of the limit, so trimming doesn't run on every write once full.
+    constexpr f64 TRIM_TARGET{ 0.9 };
+
+    std::filesystem::path ToStd(const Path& path) {
+        return std::filesystem::path{ path.Data() };
+    }
+
+    // Temporary file next to path, renamed over it once written.
+    std::filesystem::path TempPath(const std::filesystem::path& path) {
+        auto temp{ path };
+        temp += std::format(".{:x}.tmp", u64(std::chrono::steady_clock::now().time_since_epoch().count()));
+        return temp;
+    }
+} // namespace
+
+String DerivedDataCache::Key::ToString() const {
+    return String{ std::format("{:016x}{:016x}", a, b).c_str() };
+}
+
+DerivedDataCache::KeyBuilder::KeyBuilder(std::string_view importer, u32 version)
+    : a_{ 14695981039346656037ull }
+    , b_{ 0x6c62272e07bb0142ull } {
+    AddString(importer);
+    AddValue(version);
+}
+
+void DerivedDataCache::KeyBuilder::Mix(const u8* data, size_t size) {
+    // Two FNV-1a style lanes with different mixing, 128 bit key.
+    constexpr u64 PRIME_A{ 1099511628211ull };
+    constexpr u64 PRIME_B{ 0x9e3779b97f4a7c15ull };
+
+    for (size_t i{}; i < size; ++i) {
+        a_ = (a_ ^ data[i]) * PRIME_A;
+        b_ = (std::rotl(b_, 5) ^ data[i]) * PRIME_B;
+    }
+}
+
+DerivedDataCache::KeyBuilder& DerivedDataCache::KeyBuilder::AddBytes(Span<const u8> data) {
+    const u64 size{ data.Size() };
+    Mix(reinterpret_cast<const u8*>(&size), sizeof(size));
+    Mix(data.Data(), data.Size());
+    return *this;
+}
+
+DerivedDataCache::KeyBuilder& DerivedDataCache::KeyBuilder::AddString(std::string_view value) {
+    return AddBytes(Span<const u8>{ reinterpret_cast<const u8*>(value.data()), value.size() });
+}
+
+bool DerivedDataCache::KeyBuilder::AddFile(const Path& path) {
+    std::ifstream file{ path.Data(), std::ios::binary };
+    if (!file.good()) {
+        return false;
+    }
+
+    const auto data{ ReadFileBinary(file) };
+    AddBytes(data.ToSpan());
+    return true;
+}
+
+Path DerivedDataCache::DefaultRoot() {
+    if (const auto root{ std::getenv("UGINE_DDC_PATH") }; root && *root) {
+        return Path{ root };
+    }
+
+    const auto userData{ FileSystem::GetUserDataPath() };
+    if (userData.Empty()) {
+        return Path{ ".ugine" } / "DerivedDataCache";
+    }
+
+    return userData / "uGine" / "DerivedDataCache";
+}
+
+DerivedDataCache::DerivedDataCache(const Path& root, u64 maxSize)
+    : root_{ root }
+    , maxSize_{ maxSize } {
+}
+
+bool DerivedDataCache::Get(const Key& key, Vector<u8>& data) {
+    PROFILE_EVENT();
+
+    const auto path{ EntryPath(key) };
+
+    std::ifstream file{ path.Data(), std::ios::binary };
+    if (!file.good()) {
+        ++stats_.misses;
+        return false;
+    }
+
+    const auto content{ ReadFileBinary(file) };
+    file.close();
+
+    EntryHeader header{};
+    if (content.Size() >= sizeof(header)) {
+        memcpy(&header, content.Data(), sizeof(header));
+    }
+
+    const auto payload{ content.Data() + sizeof(header) };
+    if (header.magic != EntryHeader::MAGIC || header.version != EntryHeader::VERSION || header.size != content.Size() - sizeof(header)
+        || header.checksum != fnv1a(payload, header.size)) {
+        // Interrupted write or damaged file, rebuilt by the caller.
+        std::error_code ec{};
+        if (std::filesystem::remove(ToStd(path), ec)) {
+            UpdateSize(-i64(content.Size()));
+        }
+        ++stats_.misses;
+        return false;
+    }
+
+    data.Clear();
+    data.Append(payload, header.size);
+
+    // Modification time is the LRU order.
+    std::error_code ec{};
+    std::filesystem::last_write_time(ToStd(path), std::filesystem::file_time_type::clock::now(), ec);
+
+    ++stats_.hits;
+    return true;
+}
+
+bool DerivedDataCache::Put(const Key& key, Span<const u8> data) {
+    PROFILE_EVENT();
+
+    const auto path{ ToStd(EntryPath(key)) };
+
+    std::error_code ec{};
+    std::filesystem::create_directories(path.parent_path(), ec);
+
+    // Readers of other processes never see partial entries.
+    const auto temp{ TempPath(path) };
+
+    const EntryHeader header{
+        .size = data.Size(),
+        .checksum = fnv1a(data.Data(), data.Size()),
+    };
+
+    {
+        std::ofstream file{ temp, std::ios::binary };
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(reinterpret_cast<const char*>(data.Data()), data.Size());
+        if (!file.good()) {
+            file.close();
+            std::filesystem::remove(temp, ec);
+            return false;
+        }
+    }
+
+    // Entry of the same key written by another process is replaced.
+    const auto replaced{ std::filesystem::file_size(path, ec) };
+    const i64 added{ i64(sizeof(header) + data.Size()) - (ec ? 0 : i64(replaced)) };
+
+    std::filesystem::rename(temp, path, ec);
+    if (ec) {
+        std::filesystem::remove(temp, ec);
+        return false;
+    }
+
+    ++stats_.writes;
+
+    if (UpdateSize(added) > maxSize_) {
+        Trim();
+    }
+
+    return true;
+}
+
+void DerivedDataCache::Trim() {
+    Evict();
+}
+
+u64 DerivedDataCache::Evict() {
+    PROFILE_EVENT();
+
+    struct Entry {
+        std::filesystem::path path;
+        std::filesystem::file_time_type time;
+        u64 size{};
+    };
+
+    std::vector<Entry> entries;
+    u64 size{};
+
+    std::error_code ec{};
+    for (std::filesystem::recursive_directory_iterator it{ ToStd(root_), ec }, end{}; !ec && it != end; it.increment(ec)) {
+        if (it->is_regular_file(ec) && it->path().extension() == ENTRY_EXTENSION) {
+            entries.push_back(Entry{ it->path(), it->last_write_time(ec), it->file_size(ec) });
+            size += entries.back().size;
+        }
+    }
+
+    std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) { return a.time < b.time; });
+
+    const auto target{ u64(f64(maxSize_) * TRIM_TARGET) };
+    for (const auto& entry : entries) {
+        if (size <= target) {
+            break;
+        }
+
+        if (std::filesystem::remove(entry.path, ec)) {
+            size -= entry.size;
+            ++stats_.evictions;
+        }
+    }
+
+    WriteSize(size);
+    return size;
+}
+
+Path DerivedDataCache::EntryPath(const Key& key) const {
+    const auto name{ key.ToString() };
+    return root_ / std::format("{}/{}{}", std::string_view{ name.Data(), 2 }, name.Data(), ENTRY_EXTENSION).c_str();
+}
+
+u64 DerivedDataCache::UpdateSize(i64 delta) {
+    const auto path{ ToStd(root_) / SIZE_FILE };
+
+    u64 size{};
+    std::ifstream file{ path };
+    if (!(file >> size)) {
+        // First write to a new or older cache, the tree is walked once and the count is kept from then on. Entries
+        // written before are on disk already, delta is part of the walk.
+        return Evict();
+    }
+    file.close();
+
+    size = delta < 0 && u64(-delta) > size ? 0 : size + delta;
+    if (delta != 0) {
+        WriteSize(size);
+    }
+    return size;
+}
+
+void DerivedDataCache::WriteSize(u64 size) {
+    const auto path{ ToStd(root_) / SIZE_FILE };
+    const auto temp{ TempPath(path) };
+
+    std::error_code ec{};
+    std::filesystem::create_directories(path.parent_path(), ec);
+
+    {
+        std::ofstream file{ temp };
+        file << size;
+        if (!file.good()) {
+            file.close();
+            std::filesystem::remove(temp, ec);
+            return;
+        }
+    }
+
+    std::filesystem::rename(temp, path, ec);
+    if (ec) {
+        std::filesystem::remove(temp, ec);
+    }
+}
+
+} // namespace ugine
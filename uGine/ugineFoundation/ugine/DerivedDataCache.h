@@ -0,0 +1,92 @@
+#pragma once
+
+#include <ugine/Path.h>
+#include <ugine/Span.h>
+#include <ugine/String.h>
+#include <ugine/Ugine.h>
+#include <ugine/Vector.h>
+
+#include <string_view>
+#include <type_traits>
+
+namespace ugine {
+
+// Local store of importer outputs addressed by hash of everything that determines them: source bytes, importer version
+// and settings. Entries are plain files under root shared by tools and editor, least recently used ones are removed
+// once the cache grows over its size limit. Total size is kept in a small file in root, so writes don't walk the
+// tree. Not thread safe, writes of separate processes are atomic renames.
+class DerivedDataCache {
+public:
+    static constexpr u64 DEFAULT_MAX_SIZE{ 4ull * 1024 * 1024 * 1024 };
+
+    struct Key {
+        u64 a{};
+        u64 b{};
+
+        String ToString() const;
+
+        bool operator==(const Key&) const = default;
+    };
+
+    // Fields are length prefixed, concatenation of different fields can't produce the same key.
+    class KeyBuilder {
+    public:
+        KeyBuilder(std::string_view importer, u32 version);
+
+        KeyBuilder& AddBytes(Span<const u8> data);
+        KeyBuilder& AddString(std::string_view value);
+        template <typename T>
+            requires std::is_trivially_copyable_v<T>
+        KeyBuilder& AddValue(const T& value) {
+            return AddBytes(Span<const u8>{ reinterpret_cast<const u8*>(&value), sizeof(T) });
+        }
+
+        // Content of the file, false if it can't be read.
+        bool AddFile(const Path& path);
+
+        Key Finish() const { return Key{ a_, b_ }; }
+
+    private:
+        void Mix(const u8* data, size_t size);
+
+        u64 a_{};
+        u64 b_{};
+    };
+
+    struct Stats {
+        u32 hits{};
+        u32 misses{};
+        u32 writes{};
+        u32 evictions{};
+
+        f32 HitRate() const { return hits + misses > 0 ? f32(hits) / f32(hits + misses) : 0.0f; }
+    };
+
+    static Path DefaultRoot();
+
+    explicit DerivedDataCache(const Path& root = DefaultRoot(), u64 maxSize = DEFAULT_MAX_SIZE);
+
+    // Refreshes entry as recently used, corrupted entries are removed and reported as misses.
+    bool Get(const Key& key, Vector<u8>& data);
+    bool Put(const Key& key, Span<const u8> data);
+
+    // Removes least recently used entries until the cache fits its size limit.
+    void Trim();
+
+    const Path& Root() const { return root_; }
+    Stats GetStats() const { return stats_; }
+
+private:
+    Path EntryPath(const Key& key) const;
+    // Walks the tree, evicts down to the trim target and stores the remaining size.
+    u64 Evict();
+    // Adds to size in root, concurrent writers may lose updates, the next Trim recounts.
+    u64 UpdateSize(i64 delta);
+    void WriteSize(u64 size);
+
+    Path root_;
+    u64 maxSize_{};
+    Stats stats_{};
+};
+
+} // namespace ugine
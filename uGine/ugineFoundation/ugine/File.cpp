@@ -6,6 +6,11 @@
 
 #ifdef _WIN32
 #include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 #endif
 
 namespace ugine {
@@ -83,6 +88,89 @@ bool WriteFileBinary(const Path& path, Span<const u8> data) {
     return written == data.Size();
 }
 
+MappedFile::MappedFile(const Path& path) {
+#ifdef _WIN32
+    file_ = CreateFileA(path.Data(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file_ == INVALID_HANDLE_VALUE) {
+        file_ = nullptr;
+        return;
+    }
+
+    LARGE_INTEGER size{};
+    if (!GetFileSizeEx(file_, &size) || size.QuadPart == 0) {
+        Close();
+        return;
+    }
+
+    mapping_ = CreateFileMappingA(file_, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mapping_) {
+        Close();
+        return;
+    }
+
+    data_ = static_cast<const u8*>(MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0));
+    if (!data_) {
+        Close();
+        return;
+    }
+
+    size_ = size_t(size.QuadPart);
+#else
+    const auto fd{ open(path.Data(), O_RDONLY) };
+    if (fd < 0) {
+        return;
+    }
+
+    struct stat st {};
+    if (fstat(fd, &st) == 0 && st.st_size > 0) {
+        auto data{ mmap(nullptr, size_t(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0) };
+        if (data != MAP_FAILED) {
+            data_ = static_cast<const u8*>(data);
+            size_ = size_t(st.st_size);
+        }
+    }
+
+    // Mapping keeps its own reference to the file.
+    close(fd);
+#endif
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+        Close();
+
+        data_ = std::exchange(other.data_, nullptr);
+        size_ = std::exchange(other.size_, 0);
+#ifdef _WIN32
+        file_ = std::exchange(other.file_, nullptr);
+        mapping_ = std::exchange(other.mapping_, nullptr);
+#endif
+    }
+    return *this;
+}
+
+void MappedFile::Close() {
+#ifdef _WIN32
+    if (data_) {
+        UnmapViewOfFile(data_);
+    }
+    if (mapping_) {
+        CloseHandle(mapping_);
+    }
+    if (file_) {
+        CloseHandle(file_);
+    }
+    file_ = nullptr;
+    mapping_ = nullptr;
+#else
+    if (data_) {
+        munmap(const_cast<u8*>(data_), size_);
+    }
+#endif
+    data_ = nullptr;
+    size_ = 0;
+}
+
 //Path MakeRelative(const Path& srcPath, const Path& file) {
 //    if (file.is_absolute()) {
 //        return file;
@@ -7,6 +7,7 @@
 
 #include <fstream>
 #include <string_view>
+#include <utility>
 #include <vector>
 
 namespace ugine {
@@ -41,6 +42,36 @@ inline bool WriteFileBinary(const Path& file, const Vector<u8>& data) {
     return WriteFileBinary(file, data.ToSpan());
 }
 
+// Read only mapping of whole file, pages are loaded by OS on first access.
+class MappedFile {
+public:
+    MappedFile() = default;
+    explicit MappedFile(const Path& path);
+
+    MappedFile(MappedFile&& other) noexcept { *this = std::move(other); }
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    ~MappedFile() { Close(); }
+
+    // Empty files can't be mapped.
+    bool IsOpen() const { return data_ != nullptr; }
+    Span<const u8> Data() const { return Span<const u8>{ data_, size_ }; }
+    size_t Size() const { return size_; }
+
+    void Close();
+
+private:
+    const u8* data_{};
+    size_t size_{};
+#ifdef _WIN32
+    void* file_{};
+    void* mapping_{};
+#endif
+};
+
 // fstream utils.
 //void WriteString(std::ofstream& out, std::string_view str);
 //void WriteU16(std::ofstream& out, u16 val);
@@ -1,9 +1,7 @@
-#include "FileSystem.h"
+﻿#include "FileSystem.h"
 
-#include <ugine/Locking.h>
-#include <ugine/Profile.h>
+#include <ugine/Metrics.h>
 #include <ugine/Scheduler.h>
-#include <ugine/Thread.h>
 
 #include <fstream>
 
@@ -18,72 +16,53 @@
 
 namespace ugine {
 
-class FileSystemDir final : public FileSystem {
+QueuedFileSystem::QueuedFileSystem(u32 workers, IAllocator& allocator)
+    : queue_{ [this](const Path& path, Vector<u8>& data, Span<const u8>& view) { return Load(path, data, view); }, workers, allocator } {}
+
+class FileSystemDir final : public QueuedFileSystem {
 public:
     struct IoSchedulerTask : PinnedTask {
-        IoSchedulerTask(u32 threadId, FileSystemDir& fs)
-            : fs_{ fs } {
+        IoSchedulerTask(u32 threadId, IoQueue& queue)
+            : queue_{ queue } {
             threadNum = threadId;
         }
 
-        void Execute() { fs_.IoThread(); }
+        void Execute() { queue_.Work(); }
 
-        FileSystemDir& fs_;
+        IoQueue& queue_;
     };
 
     FileSystemDir(const Path& root, IAllocator& allocator)
-        : allocator_{ allocator }
-        , root_{ root } {
-
-        Init();
-
-        thread_ = Thread{
-            "I/O thread",
-            [this] {
-                PROFILE_THREAD("IO Thread");
-
-                IoThread();
-            },
-            Thread::Priority::Normal,
-            allocator_,
-        };
-    }
+        : QueuedFileSystem{ IO_WORKERS, allocator }
+        , allocator_{ allocator }
+        , root_{ root } {}
 
+    // Pinned scheduler thread is one of the workers.
     FileSystemDir(const Path& root, Scheduler& scheduler, u32 threadId, IAllocator& allocator)
-        : allocator_{ allocator }
+        : QueuedFileSystem{ IO_WORKERS - 1, allocator }
+        , allocator_{ allocator }
         , root_{ root }
         , scheduler_{ &scheduler } {
-        Init();
-
-        schedulerTask_ = MakeUnique<IoSchedulerTask>(allocator, threadId, *this);
+        schedulerTask_ = MakeUnique<IoSchedulerTask>(allocator, threadId, queue_);
         scheduler.SchedulePinned(schedulerTask_.Get());
     }
 
     ~FileSystemDir() {
-        running_ = false;
-        cv_.Notify();
+        queue_.Shutdown();
 
         if (schedulerTask_) {
             scheduler_->WaitFor(schedulerTask_.Get());
-        } else {
-            UGINE_ASSERT(thread_.Joinable());
-
-            thread_.Join();
         }
     }
 
-    void Init() {
-        PROFILE_PLOT_NUMBER("IO tasks", true, 0x00ff00ff);
-        PROFILE_PLOT("IO tasks", i64(0));
-
-        running_ = true;
-    }
-
     bool ReadOnly() const override { return false; }
 
     bool Read(const Path& path, Vector<u8>& data) override {
+        UGINE_METRIC_SCOPE_TIME("fs.readTime");
+
         std::ifstream file{ (root_ / path).Data(), std::ios::binary };
         if (!file.good()) {
+            UGINE_COUNTER_INC("fs.readFailures");
             return false;
         }
 
@@ -94,6 +73,9 @@ public:
         data.Resize(size);
         file.read(reinterpret_cast<char*>(data.Data()), size);
 
+        UGINE_COUNTER_INC("fs.reads");
+        UGINE_COUNTER_ADD("fs.readBytes", size);
+
         return true;
     }
 
@@ -108,184 +90,14 @@ public:
         return true;
     }
 
-    void SyncPoint() override {
-        PROFILE_EVENT_NC("IO sync", COLOR_PROFILE_FILESYSTEM);
-
-        Vector<IoTask> ready{ allocator_ };
-
-        {
-            Lock lock{ mutex_ };
-            ready.Swap(ready_);
-        }
-
-        for (auto& task : ready) {
-            if (!task.flags.cancelled) {
-                task.callback(task.data.ToSpan(), task.flags.success);
-            }
-        }
-    }
-
-    RequestHandle ReadAsync(const Path& path, Callback cb, bool anyThread) override {
-        RequestHandle req{};
-
-        {
-            Lock lock{ mutex_ };
-            req = ++counter_ == 0 ? ++counter_ : counter_;
-            pending_.PushBack(IoTask{
-                .request = req,
-                .path = path,
-                .callback = std::move(cb), 
-                .data = Vector<u8>{allocator_},
-                .flags = {
-                    .cancelled = 0,
-                    .success = 0,
-                    .anyThread = u8(anyThread ? 1 : 0),
-                },
-            });
-
-            PROFILE_PLOT("IO tasks", i64(pending_.Size()));
-        }
-
-        cv_.Notify();
-
-        return req;
-    }
-
-    void Cancel(RequestHandle request) override {
-        if (request == 0) {
-            return;
-        }
-
-        Lock lock{ mutex_ };
-        if (activeRequest_ == request) {
-            cancelActive_ = true;
-            return;
-        }
-
-        for (auto& io : pending_) {
-            if (io.request == request) {
-                io.flags.cancelled = 1;
-                return;
-            }
-        }
-
-        for (auto& io : ready_) {
-            if (io.request == request) {
-                io.flags.cancelled = 1;
-                return;
-            }
-        }
-    }
-
-    void CancelAll() override {
-        {
-            Lock lock{ mutex_ };
-            cancelActive_ = true;
-
-            for (auto& io : pending_) {
-                io.flags.cancelled = 1;
-            }
-
-            for (auto& io : ready_) {
-                io.flags.cancelled = 1;
-            }
-        }
-
-        // TODO:
-        //WaitIdle();
-    }
-
 private:
-    struct IoTask {
-        RequestHandle request{};
-        Path path;
-        Callback callback;
-        Vector<u8> data;
-        struct {
-            u8 cancelled : 1;
-            u8 success   : 1;
-            u8 anyThread : 1;
-        } flags{};
-    };
-
-    void IoThread() {
-        IoTask task;
-
-        while (running_) {
-            { // Wait on work.
-                Lock lock{ mutex_ };
-                activeRequest_ = 0;
-                if (pending_.Empty()) {
-                    cv_.Wait(lock, [this] { return !running_ || !pending_.Empty(); });
-                }
-
-                if (!running_) {
-                    break;
-                }
-
-                UGINE_ASSERT(!pending_.Empty());
-
-                task = pending_.PopFront();
-                PROFILE_PLOT("IO tasks", i64(pending_.Size()));
-
-                if (task.flags.cancelled) {
-                    continue;
-                }
-
-                activeRequest_ = task.request;
-            }
-
-            { // Do work.
-                PROFILE_EVENT_N("IO operation");
-
-                PROFILE_MESSAGE_DYN(task.path.Data(), task.path.String().Size());
-                task.flags.success = Read(task.path, task.data);
-                // TODO: Debug.
-                //std::this_thread::sleep_for(std::chrono::seconds(1));
-            }
-
-            // Handle result.
-
-            {
-                Lock lock{ mutex_ };
-                if (cancelActive_) {
-                    cancelActive_ = false;
-                    task.flags.cancelled = 1;
-                }
-            }
-
-            if (!task.flags.cancelled) {
-                if (task.flags.anyThread) {
-                    task.callback(task.data.ToSpan(), task.flags.success);
-                } else {
-                    Lock lock{ mutex_ };
-                    ready_.PushBack(std::move(task));
-                }
-            }
-        }
-    }
+    bool Load(const Path& path, Vector<u8>& data, Span<const u8>&) override { return Read(path, data); }
 
     AllocatorRef allocator_;
     Path root_;
 
-    std::atomic_bool running_{};
-
-    // Uses either this:
     Scheduler* scheduler_{};
     UniquePtr<PinnedTask> schedulerTask_;
-    // Or this:
-    Thread thread_;
-
-    Mutex mutex_;
-    CondVar cv_;
-
-    Vector<IoTask> pending_;
-    Vector<IoTask> ready_;
-
-    u32 counter_{};
-
-    RequestHandle activeRequest_{};
-    bool cancelActive_{};
 };
 
 UniquePtr<FileSystem> FileSystem::Create(const Path& root, IAllocator& allocator) {
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <ugine/Delegate.h>
+#include <ugine/IoQueue.h>
 #include <ugine/Memory.h>
 #include <ugine/Path.h>
 #include <ugine/String.h>
@@ -60,8 +61,8 @@ private:
 
 class FileSystem {
 public:
-    using Callback = Delegate<void(Span<const u8> /*data*/, bool /*success*/)>;
-    using RequestHandle = u32;
+    using Callback = IoQueue::Callback;
+    using RequestHandle = IoQueue::RequestHandle;
 
     static bool Exists(const Path& path);
     static bool CreateDirectories(const Path& path);
@@ -76,6 +77,9 @@ public:
     static UniquePtr<FileSystem> Create(const Path& root, IAllocator& allocator = IAllocator::Default());
     static UniquePtr<FileSystem> Create(const Path& root, Scheduler& scheduler, u32 threadId, IAllocator& allocator = IAllocator::Default());
 
+    // Read only archive built by pak tool, null if it can't be opened.
+    static UniquePtr<FileSystem> CreatePak(const Path& archive, IAllocator& allocator = IAllocator::Default());
+
     virtual ~FileSystem() = default;
 
     virtual bool ReadOnly() const = 0;
@@ -83,13 +87,40 @@ public:
     virtual bool Read(const Path& path, Vector<u8>& data) = 0;
     virtual bool Write(const Path& path, Span<const u8> data) = 0;
 
-    virtual RequestHandle ReadAsync(const Path& path, Callback cb, bool anyThread = false) = 0;
+    // Zero-copy view valid for file system lifetime, only uncompressed files of archives support it.
+    virtual bool ReadView(const Path& path, Span<const u8>& data) { return false; }
+
+    virtual RequestHandle ReadAsync(const Path& path, Callback cb, bool anyThread = false, IoPriority priority = IoPriority::Normal) = 0;
     virtual void Cancel(RequestHandle request) = 0;
     virtual void CancelAll() = 0;
 
     virtual void SyncPoint() = 0;
 };
 
+// Backend with asynchronous reads served by IoQueue workers, derived class provides the reader.
+class QueuedFileSystem : public FileSystem {
+public:
+    RequestHandle ReadAsync(const Path& path, Callback cb, bool anyThread, IoPriority priority) override {
+        return queue_.Submit(path, std::move(cb), anyThread, priority);
+    }
+
+    void Cancel(RequestHandle request) override { queue_.Cancel(request); }
+    void CancelAll() override { queue_.CancelAll(); }
+
+    void SyncPoint() override { queue_.SyncPoint(); }
+
+protected:
+    // Several reads in flight keep SSD queues busy, more only adds contention on HDD.
+    static constexpr u32 IO_WORKERS{ 4 };
+
+    QueuedFileSystem(u32 workers, IAllocator& allocator);
+
+    // Called by workers concurrently. Derived destructor shuts the queue down before state used here is destroyed.
+    virtual bool Load(const Path& path, Vector<u8>& data, Span<const u8>& view) = 0;
+
+    IoQueue queue_;
+};
+
 } // namespace ugine
 
 namespace std {
@@ -0,0 +1,102 @@
+#include "FileSystem.h"
+
+#include <ugine/Log.h>
+#include <ugine/Metrics.h>
+#include <ugine/Pak.h>
+
+namespace ugine {
+
+// Read only file system over memory mapped archive. Uncompressed entries are handed to callbacks without copies.
+class FileSystemPak final : public QueuedFileSystem {
+public:
+    FileSystemPak(UniquePtr<PakArchive> archive, IAllocator& allocator)
+        : QueuedFileSystem{ IO_WORKERS, allocator }
+        , allocator_{ allocator }
+        , archive_{ std::move(archive) } {}
+
+    ~FileSystemPak() { queue_.Shutdown(); }
+
+    bool ReadOnly() const override { return true; }
+
+    bool Read(const Path& path, Vector<u8>& data) override {
+        UGINE_METRIC_SCOPE_TIME("fs.readTime");
+
+        const auto entry{ archive_->Find(path.String()) };
+        if (!entry || !archive_->Read(*entry, data)) {
+            UGINE_COUNTER_INC("fs.readFailures");
+            return false;
+        }
+
+        UGINE_COUNTER_INC("fs.reads");
+        UGINE_COUNTER_ADD("fs.readBytes", entry->size);
+
+        return true;
+    }
+
+    bool ReadView(const Path& path, Span<const u8>& data) override {
+        const auto entry{ archive_->Find(path.String()) };
+        if (!entry || entry->compression != PakCompression::None) {
+            return false;
+        }
+
+        data = archive_->Stored(*entry);
+        return true;
+    }
+
+    bool Write(const Path& path, Span<const u8> data) override {
+        UGINE_WARN("Can't write '{}' to read only pak", path.Data());
+        return false;
+    }
+
+private:
+    static constexpr size_t PAGE_SIZE{ 4096 };
+
+    // Uncompressed entries are handed out as view of the mapping, pages are faulted in here so callbacks don't stall on disk.
+    bool Load(const Path& path, Vector<u8>& data, Span<const u8>& view) override {
+        UGINE_METRIC_SCOPE_TIME("fs.readTime");
+
+        const auto entry{ archive_->Find(path.String()) };
+        if (!entry) {
+            UGINE_WARN("File '{}' not found in pak", path.Data());
+            UGINE_COUNTER_INC("fs.readFailures");
+            return false;
+        }
+
+        bool success{ true };
+        if (entry->compression == PakCompression::None) {
+            view = archive_->Stored(*entry);
+
+            volatile u8 sink{};
+            for (size_t i{}; i < view.Size(); i += PAGE_SIZE) {
+                sink = view.Data()[i];
+            }
+        } else {
+            success = archive_->Read(*entry, data);
+        }
+
+        if (success) {
+            UGINE_COUNTER_INC("fs.reads");
+            UGINE_COUNTER_ADD("fs.readBytes", entry->size);
+        } else {
+            UGINE_COUNTER_INC("fs.readFailures");
+        }
+
+        return success;
+    }
+
+    AllocatorRef allocator_;
+    UniquePtr<PakArchive> archive_;
+};
+
+UniquePtr<FileSystem> FileSystem::CreatePak(const Path& archive, IAllocator& allocator) {
+    auto pak{ PakArchive::Open(archive, allocator) };
+    if (!pak) {
+        return {};
+    }
+
+    UGINE_INFO("Mounted pak '{}' with {} files", archive.Data(), pak->Entries().Size());
+
+    return MakeUnique<FileSystemPak>(allocator, std::move(pak), allocator);
+}
+
+} // namespace ugine
@@ -27,11 +27,66 @@ struct KtxCleaner {
     ktxTexture* texture{};
 };
 
+namespace {
+    bool FormatFromKtx(ktxTexture* texture, Image::Format& format) {
+        // KTX1 and unknown formats are loaded as RGBA8, as they always were.
+        const auto vkFormat{ texture->classId == ktxTexture2_c ? reinterpret_cast<ktxTexture2*>(texture)->vkFormat : VK_FORMAT_UNDEFINED };
+        switch (vkFormat) {
+        case VK_FORMAT_BC1_RGB_UNORM_BLOCK:
+        case VK_FORMAT_BC1_RGBA_UNORM_BLOCK: format = Image::Format::BC1; break;
+        case VK_FORMAT_BC3_UNORM_BLOCK: format = Image::Format::BC3; break;
+        case VK_FORMAT_BC5_UNORM_BLOCK: format = Image::Format::BC5; break;
+        case VK_FORMAT_BC7_UNORM_BLOCK: format = Image::Format::BC7; break;
+        default: format = Image::Format::RGBA8; break;
+        }
+
+        // Supercompressed (Basis) data would need transcoding first.
+        return texture->classId != ktxTexture2_c || !ktxTexture2_NeedsTranscoding(reinterpret_cast<ktxTexture2*>(texture));
+    }
+
+    VkFormat ToKtxFormat(Image::Format format) {
+        switch (format) {
+        case Image::Format::BC1: return VK_FORMAT_BC1_RGBA_UNORM_BLOCK;
+        case Image::Format::BC3: return VK_FORMAT_BC3_UNORM_BLOCK;
+        case Image::Format::BC5: return VK_FORMAT_BC5_UNORM_BLOCK;
+        case Image::Format::BC7: return VK_FORMAT_BC7_UNORM_BLOCK;
+        default: return VK_FORMAT_R8G8B8A8_UNORM;
+        }
+    }
+} // namespace
+
+u32 Image::BlockBytes(Format format) {
+    switch (format) {
+    case Format::BC1: return 8;
+    case Format::BC3:
+    case Format::BC5:
+    case Format::BC7: return 16;
+    default: return 0;
+    }
+}
+
+u64 Image::DataSize(Format format, u32 width, u32 height, u32 pixelSize) {
+    const auto blockBytes{ BlockBytes(format) };
+    if (blockBytes == 0) {
+        return u64(width) * height * pixelSize;
+    }
+
+    return u64((width + 3) / 4) * ((height + 3) / 4) * blockBytes;
+}
+
 bool Image::FromMemoryEncoded(Span<const u8> memory, Image& image) {
     return FromMemoryEncoded(memory.Data(), memory.Size(), image);
 }
 
+bool Image::FromMemoryEncoded(Span<const u8> memory, Image& image, u32 maxExtent) {
+    return FromMemoryEncoded(memory.Data(), memory.Size(), image, maxExtent, true);
+}
+
 bool Image::FromMemoryEncoded(const void* memory, size_t size, Image& image) {
+    return FromMemoryEncoded(memory, size, image, 0, false);
+}
+
+bool Image::FromMemoryEncoded(const void* memory, size_t size, Image& image, u32 maxExtent, bool mips) {
     const auto isKtx{ [&] {
         const auto data{ reinterpret_cast<const u8*>(memory) };
         return size >= 4 && data[0] == 0xab && data[1] == 0x4b && data[2] == 0x54 && data[3] == 0x58;
@@ -45,7 +100,17 @@ bool Image::FromMemoryEncoded(const void* memory, size_t size, Image& image) {
             return false;
         }
 
-        return image.Init(cleaner.texture);
+        if (!mips) {
+            return image.Init(cleaner.texture);
+        }
+
+        const auto texture{ cleaner.texture };
+        u32 baseMip{};
+        while (baseMip + 1 < texture->numLevels && std::max(texture->baseWidth >> baseMip, texture->baseHeight >> baseMip) > maxExtent) {
+            ++baseMip;
+        }
+
+        return image.Init(texture, baseMip, texture->numLevels - baseMip);
     } else {
         int width{};
         int height{};
@@ -59,6 +124,7 @@ bool Image::FromMemoryEncoded(const void* memory, size_t size, Image& image) {
         image.width_ = u32(width);
         image.height_ = u32(height);
         image.pixelSize_ = 4;
+        image.format_ = Format::RGBA8;
 
         image.SetLayers(1);
         image.CopyData(0, Span<const u8>{ data, size_t(width * height * 4) });
@@ -72,6 +138,7 @@ bool Image::FromMemoryDecoded(u32 width, u32 height, Span<const u8> memory, Imag
     image.width_ = u32(width);
     image.height_ = u32(height);
     image.pixelSize_ = 4;
+    image.format_ = Format::RGBA8;
 
     image.SetLayers(1);
     image.CopyData(0, memory);
@@ -86,62 +153,98 @@ bool Image::FromStream(std::istream& str, Image& image) {
 
 void Image::CopyData(u32 layer, Span<const u8> srcData) {
     UGINE_ASSERT(layer < layers_.Size());
-    UGINE_ASSERT(srcData.Size() >= width_ * height_ * pixelSize_);
-    memcpy(layers_[layer].Data(), srcData.Data(), width_ * height_ * pixelSize_);
+    UGINE_ASSERT(srcData.Size() >= MipSize(0));
+    memcpy(layers_[layer].Data(), srcData.Data(), MipSize(0));
 }
 
 void Image::SetLayers(u32 layers) {
     const auto prevSize{ layers_.Size() };
     layers_.Reserve(layers);
     for (auto i{ prevSize }; i < layers; ++i) {
-        layers_.PushBack(Vector<u8>{ width_ * height_ * pixelSize_, allocator_ });
+        layers_.PushBack(Vector<u8>{ MipSize(0), allocator_ });
     }
 }
 
-bool Image::Init(ktxTexture* texture) {
-    width_ = texture->baseWidth;
-    height_ = texture->baseHeight;
+void Image::Allocate(Format format, u32 mips) {
+    UGINE_ASSERT(mips > 0);
+
+    format_ = format;
+    pixelSize_ = format == Format::RGBA8 ? 4 : 0;
+    mips_ = mips;
+
+    for (auto& layer : layers_) {
+        layer.Resize(MipSize(0));
+    }
+
+    mipLevels_.Clear();
+    mipLevels_.Reserve((mips - 1) * layers_.Size());
+    for (u32 mip{ 1 }; mip < mips; ++mip) {
+        for (size_t i{}; i < layers_.Size(); ++i) {
+            mipLevels_.PushBack(Layer{ MipSize(mip), allocator_ });
+        }
+    }
+}
+
+bool Image::Init(ktxTexture* texture, u32 baseMip, u32 mips) {
+    UGINE_ASSERT(mips > 0 && baseMip + mips <= texture->numLevels);
+
+    if (!FormatFromKtx(texture, format_)) {
+        return false;
+    }
 
+    width_ = std::max(texture->baseWidth >> baseMip, 1u);
+    height_ = std::max(texture->baseHeight >> baseMip, 1u);
+    baseMip_ = baseMip;
+    mips_ = mips;
+
+    // Image size is per layer and face of the level.
     u32 numLayers{ texture->numLayers };
-    pixelSize_ = u32(texture->dataSize / width_ / height_ / texture->baseDepth);
+    pixelSize_ = IsCompressed() ? 0 : u32(ktxTexture_GetImageSize(texture, baseMip) / width_ / height_ / texture->baseDepth);
     if (texture->isArray) {
-        pixelSize_ /= texture->numLayers;
         numLayers = texture->numLayers;
     } else if (texture->isCubemap) {
         UGINE_ASSERT(texture->numFaces == 6);
 
-        pixelSize_ /= texture->numFaces;
         numLayers = texture->numFaces;
         isCubemap_ = true;
     }
 
     SetLayers(numLayers);
-
-    const auto level{ 0 };
-
-    for (u32 i{}; i < numLayers; ++i) {
-        const u32 layer{ isCubemap_ ? 0 : i };
-        const u32 face{ isCubemap_ ? i : 0 };
-
-        ktx_size_t offset{};
-        KTX_error_code ret{ ktxTexture_GetImageOffset(texture, level, layer, face, &offset) };
-        if (ret != KTX_SUCCESS) {
-            return false;
+    mipLevels_.Clear();
+
+    for (u32 mip{}; mip < mips; ++mip) {
+        const auto mipSize{ MipSize(mip) };
+
+        for (u32 i{}; i < numLayers; ++i) {
+            const u32 layer{ isCubemap_ ? 0 : i };
+            const u32 face{ isCubemap_ ? i : 0 };
+
+            ktx_size_t offset{};
+            KTX_error_code ret{ ktxTexture_GetImageOffset(texture, baseMip + mip, layer, face, &offset) };
+            if (ret != KTX_SUCCESS) {
+                return false;
+            }
+
+            const Span<const u8> data{ ktxTexture_GetData(texture) + offset, mipSize };
+            if (mip == 0) {
+                CopyData(i, data);
+            } else {
+                mipLevels_.PushBack(Layer{ data, allocator_ });
+            }
         }
-
-        CopyData(i, Span<const u8>{ ktxTexture_GetData(texture) + offset, width_ * height_ * pixelSize_ });
     }
 
     return true;
 }
 
 bool Image::Add(u32 layer, ktxTexture* texture) {
-    if (texture->isArray || texture->isCubemap) {
+    Format format{};
+    if (texture->isArray || texture->isCubemap || !FormatFromKtx(texture, format) || format != format_) {
         return false;
     }
 
     const auto pixelSize{ texture->dataSize / texture->baseWidth / texture->baseHeight / texture->baseDepth };
-    if (width_ != texture->baseWidth || height_ != texture->baseHeight || pixelSize_ != pixelSize) {
+    if (width_ != texture->baseWidth || height_ != texture->baseHeight || (!IsCompressed() && pixelSize_ != pixelSize)) {
         return false;
     }
 
@@ -153,7 +256,7 @@ bool Image::Add(u32 layer, ktxTexture* texture) {
         return false;
     }
 
-    CopyData(layer, Span<const u8>{ ktxTexture_GetData(texture) + offset, width_ * height_ * pixelSize_ });
+    CopyData(layer, Span<const u8>{ ktxTexture_GetData(texture) + offset, MipSize(0) });
 
     return true;
 }
@@ -180,6 +283,7 @@ bool Image::FromFile(const Path& path, Image& image) {
         image.width_ = u32(width);
         image.height_ = u32(height);
         image.pixelSize_ = 4;
+        image.format_ = Format::RGBA8;
         image.SetLayers(1);
         image.CopyData(0, Span<const u8>(data, width * height * 4));
 
@@ -208,7 +312,7 @@ bool Image::AddLayerFromFile(u32 layer, const Path& path) {
             return false;
         }
 
-        if (width_ != u32(width) || height_ != u32(height) || pixelSize_ != 4) {
+        if (width_ != u32(width) || height_ != u32(height) || format_ != Format::RGBA8 || pixelSize_ != 4) {
             return false;
         }
 
@@ -226,8 +330,27 @@ Span<const u8> Image::GetLayer(u32 layer) const {
     return Span{ layers_[layer].Data(), layers_[layer].Size() };
 }
 
+Span<const u8> Image::GetMip(u32 layer, u32 mip) const {
+    UGINE_ASSERT(mip < mips_);
+    if (mip == 0) {
+        return GetLayer(layer);
+    }
+
+    const auto& data{ mipLevels_[(mip - 1) * layers_.Size() + layer] };
+    return Span{ data.Data(), data.Size() };
+}
+
+Span<u8> Image::GetMip(u32 layer, u32 mip) {
+    UGINE_ASSERT(layer < layers_.Size() && mip < mips_);
+
+    auto& data{ mip == 0 ? layers_[layer] : mipLevels_[(mip - 1) * layers_.Size() + layer] };
+    return Span{ data.Data(), data.Size() };
+}
+
 Image::Image(IAllocator& allocator)
-    : allocator_{ allocator } {
+    : allocator_{ allocator }
+    , layers_{ allocator }
+    , mipLevels_{ allocator } {
 }
 
 Image::Image(u32 width, u32 height, u32 pixelSize, u32 layers, IAllocator& allocator)
@@ -235,28 +358,40 @@ Image::Image(u32 width, u32 height, u32 pixelSize, u32 layers, IAllocator& alloc
     , width_{ width }
     , height_{ height }
     , pixelSize_{ pixelSize }
-    , layers_{ allocator } {
+    , layers_{ allocator }
+    , mipLevels_{ allocator } {
     SetLayers(layers);
 }
 
 Image::~Image() {
 }
 
-bool Image::Save(const Path& path, bool compress) const {
-    UGINE_ASSERT(pixelSize_ == 4);
+bool Image::Save(const Path& path) const {
+    const auto texture{ ToKtx() };
+    if (!texture) {
+        return false;
+    }
+
+    const auto result{ ktxTexture_WriteToNamedFile(ktxTexture(texture), path.Data()) };
+    ktxTexture_Destroy(ktxTexture(texture));
+
+    return result == KTX_SUCCESS;
+}
+
+ktxTexture2* Image::ToKtx() const {
+    UGINE_ASSERT(IsCompressed() || pixelSize_ == 4);
 
     ktxTexture2* texture{};
 
     KTX_error_code result{};
 
     ktxTextureCreateInfo createInfo{};
-    // VK_FORMAT_BC1_RGBA_UNORM_BLOCK
-    createInfo.vkFormat = compress ? VK_FORMAT_BC1_RGBA_UNORM_BLOCK : VK_FORMAT_R8G8B8A8_UNORM;
+    createInfo.vkFormat = ToKtxFormat(format_);
     createInfo.baseWidth = width_;
     createInfo.baseHeight = height_;
     createInfo.baseDepth = 1;
     createInfo.numDimensions = 2; //
-    createInfo.numLevels = 1;     // Mips.
+    createInfo.numLevels = mips_;
     createInfo.numLayers = ktx_uint32_t(isCubemap_ ? 1 : layers_.Size());
     createInfo.numFaces = ktx_uint32_t(isCubemap_ ? layers_.Size() : 1);
     createInfo.isArray = (!isCubemap_ && layers_.Size() > 1) ? KTX_TRUE : KTX_FALSE;
@@ -264,30 +399,25 @@ bool Image::Save(const Path& path, bool compress) const {
 
     result = ktxTexture2_Create(&createInfo, KTX_TEXTURE_CREATE_ALLOC_STORAGE, &texture);
     if (result != KTX_SUCCESS) {
-        return false;
+        return nullptr;
     }
 
-    //
-    const ktx_uint32_t mipLevel{ 0 };
-    const ktx_uint32_t face{ 0 };
-    const ktx_uint32_t layerSize{ width_ * height_ * pixelSize_ };
-
-    for (u32 i{}; i < layers_.Size(); ++i) {
-        const u32 layer{ isCubemap_ ? 0 : i };
-        const u32 face{ isCubemap_ ? i : 0 };
+    for (u32 mip{}; mip < mips_; ++mip) {
+        for (u32 i{}; i < layers_.Size(); ++i) {
+            const u32 layer{ isCubemap_ ? 0 : i };
+            const u32 face{ isCubemap_ ? i : 0 };
+            const auto data{ GetMip(i, mip) };
 
-        result = ktxTexture_SetImageFromMemory(ktxTexture(texture), mipLevel, layer, face, reinterpret_cast<const ktx_uint8_t*>(GetLayer(i).Data()), layerSize);
+            result = ktxTexture_SetImageFromMemory(ktxTexture(texture), mip, layer, face, reinterpret_cast<const ktx_uint8_t*>(data.Data()), data.Size());
 
-        if (result != KTX_SUCCESS) {
-            ktxTexture_Destroy(ktxTexture(texture));
-            return false;
+            if (result != KTX_SUCCESS) {
+                ktxTexture_Destroy(ktxTexture(texture));
+                return nullptr;
+            }
         }
     }
 
-    result = ktxTexture_WriteToNamedFile(ktxTexture(texture), path.Data());
-    ktxTexture_Destroy(ktxTexture(texture));
-
-    return result == KTX_SUCCESS;
+    return texture;
 }
 
 } // namespace ugine
\ No newline at end of file
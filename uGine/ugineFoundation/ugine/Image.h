@@ -7,7 +7,10 @@
 #include <ugine/Vector.h>
 #include <ugine/Path.h>
 
+#include <algorithm>
+
 struct ktxTexture;
+struct ktxTexture2;
 
 namespace ugine {
 
@@ -22,8 +25,23 @@ public:
         ZNeg,
     };
 
+    // Block compressed formats store 4x4 texel blocks, mips smaller than a block still take a whole one.
+    enum class Format : u8 {
+        RGBA8,
+        BC1,
+        BC3,
+        BC5,
+        BC7,
+    };
+
+    // Bytes of 4x4 block, 0 for uncompressed format.
+    static u32 BlockBytes(Format format);
+    static u64 DataSize(Format format, u32 width, u32 height, u32 pixelSize = 4);
+
     static bool FromMemoryEncoded(const void* memory, size_t size, Image& image);
     static bool FromMemoryEncoded(Span<const u8> memory, Image& image);
+    // Loads KTX mip chain from the first level not larger than maxExtent (last level if none is). Other formats have one mip.
+    static bool FromMemoryEncoded(Span<const u8> memory, Image& image, u32 maxExtent);
     static bool FromMemoryDecoded(u32 width, u32 height, Span<const u8> memory, Image& image);
     static bool FromFile(const Path& path, Image& image);
     static bool FromStream(std::istream& str, Image& image);
@@ -41,15 +59,29 @@ public:
     u32 Width() const { return width_; }
     u32 Height() const { return height_; }
     u32 Layers() const { return u32(layers_.Size()); }
-    u32 PixelSize() const { return pixelSize_; }
+    u32 PixelSize() const { return pixelSize_; } // 0 for compressed formats.
+    Format GetFormat() const { return format_; }
+    bool IsCompressed() const { return format_ != Format::RGBA8; }
+    u32 Mips() const { return mips_; }
+    u32 BaseMip() const { return baseMip_; } // Level of source file stored as mip 0.
+    u32 MipWidth(u32 mip) const { return std::max(width_ >> mip, 1u); }
+    u32 MipHeight(u32 mip) const { return std::max(height_ >> mip, 1u); }
+    u64 MipSize(u32 mip) const { return DataSize(format_, MipWidth(mip), MipHeight(mip), pixelSize_); }
 
     void SetLayers(u32 layers);
+    // Reallocates all layers for format and full or partial mip chain from base mip, content is undefined.
+    void Allocate(Format format, u32 mips);
     void CopyData(u32 layer, Span<const u8> srcData);
     bool AddLayerFromFile(u32 layer, const Path& path);
 
     Span<const u8> GetLayer(u32 layer = 0) const;
+    Span<const u8> GetMip(u32 layer, u32 mip) const;
+    Span<u8> GetMip(u32 layer, u32 mip);
 
-    bool Save(const Path& path, bool compress = false) const;
+    // KTX2 with all mips in image format.
+    bool Save(const Path& path) const;
+    // Same texture in memory, null on failure. Caller destroys it.
+    ktxTexture2* ToKtx() const;
 
     void SetCubemap(bool isCubemap) { isCubemap_ = isCubemap; }
     bool IsCubemap() const { return isCubemap_; }
@@ -57,14 +89,20 @@ public:
 private:
     using Layer = Vector<u8>; // TODO: Vector
 
-    bool Init(ktxTexture* texture);
+    static bool FromMemoryEncoded(const void* memory, size_t size, Image& image, u32 maxExtent, bool mips);
+
+    bool Init(ktxTexture* texture, u32 baseMip = 0, u32 mips = 1);
     bool Add(u32 layer, ktxTexture* texture);
 
     AllocatorRef allocator_;
     u32 width_{};
     u32 height_{};
     u32 pixelSize_{ 4 };
+    Format format_{ Format::RGBA8 };
     Vector<Layer> layers_;
+    u32 mips_{ 1 };
+    u32 baseMip_{};
+    Vector<Layer> mipLevels_; // Mips after the first, mip major.
     bool isCubemap_{};
 };
 
@@ -0,0 +1,116 @@
+#pragma once
+
+#include <ugine/Ugine.h>
+
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+namespace ugine {
+
+template <typename Signature, size_t Capacity = 64, size_t Alignment = alignof(std::max_align_t)> class InplaceFunction;
+
+// Move only replacement of std::function which never allocates. Callable is stored in the object itself, callables
+// which don't fit Capacity (or need stricter Alignment) are rejected at compile time.
+template <typename Ret, typename... Args, size_t Capacity, size_t Alignment> class InplaceFunction<Ret(Args...), Capacity, Alignment> {
+public:
+    static constexpr size_t CAPACITY{ Capacity };
+
+    InplaceFunction() = default;
+    InplaceFunction(std::nullptr_t) noexcept {}
+
+    template <typename F>
+        requires(!std::is_same_v<std::remove_cvref_t<F>, InplaceFunction>)
+    InplaceFunction(F&& func) {
+        using Callable = std::remove_cvref_t<F>;
+
+        static_assert(std::is_invocable_r_v<Ret, Callable&, Args...>, "Callable doesn't match function signature");
+        static_assert(sizeof(Callable) <= Capacity, "Callable captures don't fit InplaceFunction capacity");
+        static_assert(alignof(Callable) <= Alignment, "Callable alignment exceeds InplaceFunction alignment");
+        static_assert(std::is_nothrow_move_constructible_v<Callable>, "Callable must be nothrow move constructible");
+
+        new (storage_) Callable{ std::forward<F>(func) };
+        ops_ = &OPS<Callable>;
+    }
+
+    InplaceFunction(InplaceFunction&& other) noexcept { MoveFrom(other); }
+
+    InplaceFunction& operator=(InplaceFunction&& other) noexcept {
+        if (this != &other) {
+            Reset();
+            MoveFrom(other);
+        }
+        return *this;
+    }
+
+    InplaceFunction& operator=(std::nullptr_t) noexcept {
+        Reset();
+        return *this;
+    }
+
+    InplaceFunction(const InplaceFunction&) = delete;
+    InplaceFunction& operator=(const InplaceFunction&) = delete;
+
+    ~InplaceFunction() { Reset(); }
+
+    // Const like std::function, callable itself may be mutable.
+    Ret operator()(Args... args) const {
+        UGINE_ASSERT(ops_);
+        return ops_->invoke(storage_, std::forward<Args>(args)...);
+    }
+
+    UGINE_FORCE_INLINE explicit operator bool() const { return ops_ != nullptr; }
+
+    void Reset() noexcept {
+        if (ops_) {
+            if (ops_->destroy) {
+                ops_->destroy(storage_);
+            }
+            ops_ = nullptr;
+        }
+    }
+
+private:
+    struct Ops {
+        Ret (*invoke)(void* storage, Args&&... args);
+        void (*move)(void* dst, void* src) noexcept; // Null for trivially copyable callables, storage is copied.
+        void (*destroy)(void* storage) noexcept;     // Null for trivially destructible callables.
+    };
+
+    template <typename F> static Ret Invoke(void* storage, Args&&... args) {
+        return std::invoke(*static_cast<F*>(storage), std::forward<Args>(args)...);
+    }
+
+    template <typename F> static void Move(void* dst, void* src) noexcept {
+        new (dst) F{ std::move(*static_cast<F*>(src)) };
+        static_cast<F*>(src)->~F();
+    }
+
+    template <typename F> static void Destroy(void* storage) noexcept { static_cast<F*>(storage)->~F(); }
+
+    template <typename F>
+    static constexpr Ops OPS{
+        .invoke = &Invoke<F>,
+        .move = std::is_trivially_copyable_v<F> ? nullptr : &Move<F>,
+        .destroy = std::is_trivially_destructible_v<F> ? nullptr : &Destroy<F>,
+    };
+
+    void MoveFrom(InplaceFunction& other) noexcept {
+        if (other.ops_) {
+            if (other.ops_->move) {
+                other.ops_->move(storage_, other.storage_);
+            } else {
+                memcpy(storage_, other.storage_, Capacity);
+            }
+            ops_ = other.ops_;
+            other.ops_ = nullptr;
+        }
+    }
+
+    alignas(Alignment) mutable std::byte storage_[Capacity];
+    const Ops* ops_{};
+};
+
+} // namespace ugine
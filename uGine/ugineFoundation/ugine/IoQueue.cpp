@@ -0,0 +1,397 @@
+#include "IoQueue.h"
+
+#include <ugine/Metrics.h>
+#include <ugine/Profile.h>
+
+#include <algorithm>
+
+namespace ugine {
+
+namespace {
+    constexpr size_t COMPACT_THRESHOLD{ 64 };
+
+    void RecordQueueTime(IoPriority priority, u64 us) {
+        switch (priority) {
+        case IoPriority::Critical: UGINE_HISTOGRAM_RECORD("fs.queueTime.critical", us); break;
+        case IoPriority::Normal: UGINE_HISTOGRAM_RECORD("fs.queueTime.normal", us); break;
+        case IoPriority::Background: UGINE_HISTOGRAM_RECORD("fs.queueTime.background", us); break;
+        }
+    }
+} // namespace
+
+IoData IoData::Take() {
+    IoData result;
+    result.view_ = view_;
+    result.buffer_ = shared_ ? buffer_.Clone() : std::move(buffer_);
+    return result;
+}
+
+void IoQueue::Queue::Insert(Request* request) {
+    items.PushBack(request);
+
+    // Promoted requests waited longer than the newest ones, keep order so deadline of head is the earliest.
+    for (auto i{ items.Size() - 1 }; i > head && items[i - 1]->deadline > request->deadline; --i) {
+        std::swap(items[i - 1], items[i]);
+    }
+}
+
+IoQueue::Request* IoQueue::Queue::PopFront() {
+    UGINE_ASSERT(!Empty());
+
+    auto request{ items[head++] };
+    if (head == items.Size()) {
+        items.Clear();
+        head = 0;
+    } else if (head >= COMPACT_THRESHOLD && head * 2 >= items.Size()) {
+        items.EraseFront(head);
+        head = 0;
+    }
+    return request;
+}
+
+void IoQueue::Queue::Remove(Request* request) {
+    for (auto i{ head }; i < items.Size(); ++i) {
+        if (items[i] == request) {
+            items.EraseAt(i);
+            return;
+        }
+    }
+    UGINE_ASSERT(false && "Request not queued");
+}
+
+IoQueue::IoQueue(Reader reader, u32 threads, IAllocator& allocator)
+    : allocator_{ allocator }
+    , reader_{ std::move(reader) }
+    , ready_{ allocator }
+    , requests_{ allocator }
+    , free_{ allocator }
+    , threads_{ allocator } {
+
+    PROFILE_PLOT_NUMBER("IO tasks", true, 0x00ff00ff);
+    PROFILE_PLOT("IO tasks", i64(0));
+
+    for (auto& queue : queues_) {
+        queue.items = Vector<Request*>{ allocator };
+    }
+
+    for (u32 i{}; i < threads; ++i) {
+        threads_.EmplaceBack(
+            "I/O thread",
+            [this] {
+                PROFILE_THREAD("IO Thread");
+
+                Work();
+            },
+            Thread::Priority::Normal, allocator_);
+    }
+}
+
+IoQueue::~IoQueue() {
+    Shutdown();
+}
+
+IoQueue::RequestHandle IoQueue::Submit(const Path& path, Callback callback, bool anyThread, IoPriority priority) {
+    const auto now{ Clock::now() };
+
+    Lock lock{ mutex_ };
+
+    const auto handle{ ++counter_ == 0 ? ++counter_ : counter_ };
+    ++stats_.requests;
+
+    Waiter waiter{
+        .handle = handle,
+        .callback = std::move(callback),
+        .anyThread = anyThread,
+    };
+
+    if (auto it{ inFlight_.find(path) }; it != inFlight_.end()) {
+        auto request{ it->second };
+        request->waiters.PushBack(std::move(waiter));
+        ++stats_.coalesced;
+
+        // Jump the queue with the most urgent waiter.
+        if (request->state == Request::State::Queued && priority < request->priority) {
+            queues_[u32(request->priority)].Remove(request);
+            Enqueue(request, priority, now + PROMOTE_AFTER[u32(priority)]);
+        }
+        return handle;
+    }
+
+    auto request{ Acquire() };
+    request->path = path;
+    request->state = Request::State::Queued;
+    request->submitted = now;
+    request->waiters.PushBack(std::move(waiter));
+
+    inFlight_[path] = request;
+    Enqueue(request, priority, now + PROMOTE_AFTER[u32(priority)]);
+    UpdatePending();
+
+    return handle;
+}
+
+void IoQueue::Cancel(RequestHandle handle) {
+    if (handle == 0) {
+        return;
+    }
+
+    Lock lock{ mutex_ };
+
+    const auto cancel{ [handle](Request* request) {
+        for (auto& waiter : request->waiters) {
+            if (waiter.handle == handle) {
+                waiter.cancelled = true;
+                return true;
+            }
+        }
+        return false;
+    } };
+
+    // Whole pool, request may be between read and delivery to SyncPoint.
+    for (auto& entry : requests_) {
+        const auto request{ entry.Get() };
+        if (!cancel(request)) {
+            continue;
+        }
+
+        // Nobody waits for queued read anymore, drop it.
+        if (request->state == Request::State::Queued
+            && std::all_of(request->waiters.begin(), request->waiters.end(), [](const Waiter& w) { return w.cancelled; })) {
+            queues_[u32(request->priority)].Remove(request);
+            inFlight_.erase(request->path);
+            Release(request);
+            UpdatePending();
+        }
+        return;
+    }
+}
+
+void IoQueue::CancelAll() {
+    Lock lock{ mutex_ };
+
+    for (auto& queue : queues_) {
+        for (auto i{ queue.head }; i < queue.items.Size(); ++i) {
+            inFlight_.erase(queue.items[i]->path);
+            Release(queue.items[i]);
+        }
+        queue.items.Clear();
+        queue.head = 0;
+    }
+
+    // Active reads finish, nobody gets the result.
+    for (auto& request : requests_) {
+        for (auto& waiter : request->waiters) {
+            waiter.cancelled = true;
+        }
+    }
+
+    UpdatePending();
+}
+
+void IoQueue::SyncPoint() {
+    PROFILE_EVENT_NC("IO sync", COLOR_PROFILE_FILESYSTEM);
+
+    Vector<Request*> ready{ allocator_ };
+
+    {
+        Lock lock{ mutex_ };
+        ready.Swap(ready_);
+    }
+
+    for (auto request : ready) {
+        auto remaining{ Deliveries(request, false) };
+        for (auto& waiter : request->waiters) {
+            if (!waiter.anyThread && !waiter.cancelled) {
+                request->data.shared_ = --remaining > 0;
+                waiter.callback(request->data, request->success);
+            }
+        }
+    }
+
+    Lock lock{ mutex_ };
+    for (auto request : ready) {
+        Release(request);
+    }
+}
+
+void IoQueue::Work() {
+    while (true) {
+        Request* request{};
+
+        { // Wait on work.
+            Lock lock{ mutex_ };
+
+            const auto hasWork{ [this] {
+                for (const auto& queue : queues_) {
+                    if (!queue.Empty()) {
+                        return true;
+                    }
+                }
+                return false;
+            } };
+
+            if (running_ && !hasWork()) {
+                cv_.Wait(lock, [&] { return !running_ || hasWork(); });
+            }
+
+            if (!running_) {
+                break;
+            }
+
+            const auto now{ Clock::now() };
+            Promote(now);
+
+            request = PopRequest();
+            request->state = Request::State::Active;
+            ++stats_.active;
+
+            RecordQueueTime(request->priority, u64(std::chrono::duration_cast<std::chrono::microseconds>(now - request->submitted).count()));
+            UpdatePending();
+        }
+
+        Read(request);
+    }
+}
+
+void IoQueue::Shutdown() {
+    {
+        Lock lock{ mutex_ };
+        if (!running_) {
+            return;
+        }
+        running_ = false;
+    }
+    cv_.NotifyAll();
+
+    for (auto& thread : threads_) {
+        thread.Join();
+    }
+    threads_.Clear();
+}
+
+IoQueue::Stats IoQueue::GetStats() const {
+    Lock lock{ mutex_ };
+
+    auto stats{ stats_ };
+    for (u32 i{}; i < PRIORITY_COUNT; ++i) {
+        stats.pending[i] = u32(queues_[i].Size());
+    }
+    return stats;
+}
+
+IoQueue::Request* IoQueue::Acquire() {
+    if (!free_.Empty()) {
+        auto request{ free_.Back() };
+        free_.PopBack();
+        return request;
+    }
+
+    requests_.PushBack(MakeUnique<Request>(allocator_, allocator_));
+    return requests_.Back().Get();
+}
+
+void IoQueue::Release(Request* request) {
+    request->waiters.Clear();
+    request->data.view_ = {};
+    request->data.shared_ = false;
+    request->success = false;
+
+    // Don't keep large buffers alive in pool.
+    Vector<u8> data{ allocator_ };
+    request->data.buffer_.Swap(data);
+
+    free_.PushBack(request);
+}
+
+void IoQueue::Enqueue(Request* request, IoPriority priority, Clock::time_point deadline) {
+    request->priority = priority;
+    request->deadline = deadline;
+    queues_[u32(priority)].Insert(request);
+
+    cv_.Notify();
+}
+
+void IoQueue::Promote(Clock::time_point now) {
+    // Queues are ordered by deadline, only heads need checking. Lowest first so long waiting request can climb more levels.
+    for (u32 i{ PRIORITY_COUNT - 1 }; i > 0; --i) {
+        auto& queue{ queues_[i] };
+        while (!queue.Empty() && queue.Front()->deadline <= now) {
+            auto request{ queue.PopFront() };
+            Enqueue(request, IoPriority(i - 1), request->deadline + PROMOTE_AFTER[i - 1]);
+            ++stats_.promoted;
+        }
+    }
+}
+
+IoQueue::Request* IoQueue::PopRequest() {
+    for (auto& queue : queues_) {
+        if (!queue.Empty()) {
+            return queue.PopFront();
+        }
+    }
+    return nullptr;
+}
+
+void IoQueue::Read(Request* request) {
+    {
+        PROFILE_EVENT_N("IO operation");
+
+        PROFILE_MESSAGE_DYN(request->path.Data(), request->path.String().Size());
+        request->success = reader_(request->path, request->data.buffer_, request->data.view_);
+    }
+
+    const auto finish{ [this, request] {
+        if (Deliveries(request, false) > 0) {
+            ready_.PushBack(request);
+        } else {
+            Release(request);
+        }
+    } };
+
+    HybridVector<Callback, 4> callbacks{ allocator_.Get() };
+    u32 remaining{};
+
+    {
+        Lock lock{ mutex_ };
+        inFlight_.erase(request->path);
+        request->state = Request::State::Ready;
+        --stats_.active;
+        ++stats_.reads;
+
+        for (auto& waiter : request->waiters) {
+            if (waiter.anyThread && !waiter.cancelled) {
+                callbacks.PushBack(waiter.callback);
+            }
+        }
+
+        if (callbacks.Empty()) {
+            finish();
+            return;
+        }
+
+        remaining = u32(callbacks.Size()) + Deliveries(request, false);
+    }
+
+    // Outside of lock, callbacks may submit further reads. Last one may take the buffer.
+    for (auto& callback : callbacks) {
+        request->data.shared_ = --remaining > 0;
+        callback(request->data, request->success);
+    }
+
+    Lock lock{ mutex_ };
+    finish();
+}
+
+u32 IoQueue::Deliveries(const Request* request, bool anyThread) const {
+    return u32(std::count_if(request->waiters.begin(), request->waiters.end(),
+        [anyThread](const Waiter& w) { return w.anyThread == anyThread && !w.cancelled; }));
+}
+
+void IoQueue::UpdatePending() {
+    const auto pending{ queues_[0].Size() + queues_[1].Size() + queues_[2].Size() };
+
+    PROFILE_PLOT("IO tasks", i64(pending));
+    UGINE_GAUGE_SET("fs.pending", pending);
+}
+
+} // namespace ugine
@@ -0,0 +1,170 @@
+#pragma once
+
+#include <ugine/Delegate.h>
+#include <ugine/Locking.h>
+#include <ugine/Memory.h>
+#include <ugine/Path.h>
+#include <ugine/Thread.h>
+#include <ugine/Vector.h>
+
+#include <chrono>
+#include <unordered_map>
+
+namespace ugine {
+
+enum class IoPriority : u8 {
+    Critical,   // Something waits for it right now (UI, blocking load).
+    Normal,
+    Background, // Streaming and prefetch.
+};
+
+// Data of finished read, either buffer filled by reader or view of memory owned by backend (mapped pak, valid for its
+// lifetime). Callbacks borrow it, Take keeps it past the callback without copying.
+class IoData {
+public:
+    IoData() = default;
+    explicit IoData(IAllocator& allocator)
+        : buffer_{ allocator } {}
+
+    Span<const u8> Data() const { return view_.Data() ? view_ : buffer_.ToSpan(); }
+    size_t Size() const { return Data().Size(); }
+    bool Empty() const { return Data().Empty(); }
+
+    // Buffer is moved out, or copied while other waiters of coalesced read still get it. Views aren't copied.
+    IoData Take();
+
+private:
+    friend class IoQueue;
+
+    Vector<u8> buffer_;
+    Span<const u8> view_;
+    bool shared_{};
+};
+
+// Read requests shared by file system backends. Several workers serve requests in priority order, waiting requests
+// are promoted one level each time their deadline passes so background reads can't starve. Reads of a path already
+// queued or in flight are coalesced into one.
+class IoQueue {
+public:
+    using Callback = Delegate<void(IoData& /*data*/, bool /*success*/)>;
+    using RequestHandle = u32;
+
+    // Fills data, or view of memory owned by backend. Called by workers concurrently.
+    using Reader = Delegate<bool(const Path& /*path*/, Vector<u8>& /*data*/, Span<const u8>& /*view*/)>;
+
+    static constexpr u32 PRIORITY_COUNT{ 3 };
+
+    // Waiting time after which request moves to higher priority, background request reaches critical after 600 ms.
+    static constexpr std::chrono::milliseconds PROMOTE_AFTER[PRIORITY_COUNT]{
+        std::chrono::milliseconds{ 0 },
+        std::chrono::milliseconds{ 100 },
+        std::chrono::milliseconds{ 500 },
+    };
+
+    struct Stats {
+        u64 requests{};
+        u64 reads{};
+        u64 coalesced{};
+        u64 promoted{};
+        u32 pending[PRIORITY_COUNT]{};
+        u32 active{};
+    };
+
+    // Workers are either own threads or callers of Work.
+    IoQueue(Reader reader, u32 threads, IAllocator& allocator = IAllocator::Default());
+    ~IoQueue();
+
+    IoQueue(const IoQueue&) = delete;
+    IoQueue& operator=(const IoQueue&) = delete;
+
+    // Callbacks run at SyncPoint, or on worker if anyThread is set.
+    RequestHandle Submit(const Path& path, Callback callback, bool anyThread, IoPriority priority);
+    void Cancel(RequestHandle request);
+    void CancelAll();
+
+    void SyncPoint();
+
+    // Worker loop for threads the queue doesn't own (pinned scheduler tasks), returns after Shutdown.
+    void Work();
+
+    // Stops workers and joins own threads, pending requests are dropped.
+    void Shutdown();
+
+    Stats GetStats() const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Waiter {
+        RequestHandle handle{};
+        Callback callback;
+        bool anyThread{};
+        bool cancelled{};
+    };
+
+    struct Request {
+        enum class State : u8 {
+            Queued,
+            Active,
+            Ready,
+        };
+
+        explicit Request(IAllocator& allocator)
+            : waiters{ allocator }
+            , data{ allocator } {}
+
+        Path path;
+        IoPriority priority{};
+        State state{};
+        Clock::time_point submitted{};
+        Clock::time_point deadline{};
+        HybridVector<Waiter, 1> waiters;
+        IoData data;
+        bool success{};
+    };
+
+    // Ordered by deadline, mostly FIFO. Popped with lazy compaction, PopFront of Vector moves whole queue.
+    struct Queue {
+        Vector<Request*> items;
+        size_t head{};
+
+        bool Empty() const { return head == items.Size(); }
+        size_t Size() const { return items.Size() - head; }
+        Request* Front() const { return items[head]; }
+        void Insert(Request* request);
+        Request* PopFront();
+        void Remove(Request* request);
+    };
+
+    Request* Acquire();
+    void Release(Request* request);
+
+    void Enqueue(Request* request, IoPriority priority, Clock::time_point deadline);
+    void Promote(Clock::time_point now);
+    Request* PopRequest();
+
+    void Read(Request* request);
+    // Callbacks of waiters not cancelled, `anyThread` ones run on worker.
+    u32 Deliveries(const Request* request, bool anyThread) const;
+    void UpdatePending();
+
+    AllocatorRef allocator_;
+    Reader reader_;
+
+    mutable Mutex mutex_;
+    CondVar cv_;
+    bool running_{ true };
+
+    Queue queues_[PRIORITY_COUNT];
+    std::unordered_map<Path, Request*> inFlight_; // Queued or active, coalescing target.
+    Vector<Request*> ready_;
+    Vector<UniquePtr<Request>> requests_;
+    Vector<Request*> free_;
+
+    RequestHandle counter_{};
+    Stats stats_{};
+
+    Vector<Thread> threads_;
+};
+
+} // namespace ugine
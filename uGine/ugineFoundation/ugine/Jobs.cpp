@@ -1,6 +1,7 @@
 #include "Jobs.h"
 
 #include "Log.h"
+#include "Metrics.h"
 
 #include <format>
 
@@ -53,7 +54,7 @@ namespace detail {
         static constexpr u32 FIBER_POOL_SIZE{ 128 };
         static constexpr u32 FIBER_STACK_SIZE{ 64 * 1024 };
 
-        using JobQueue = ConcurentRingbuffer<Job, JobScheduler::MAX_PENDING_JOBS, AtomicSpinLock>;
+        using JobQueue = MPMCQueue<Job, JobScheduler::MAX_PENDING_JOBS>;
 
         JobSchedulerImpl(IAllocator& allocator, u8 workers)
             : workers_{ allocator }
@@ -92,6 +93,8 @@ namespace detail {
         }
 
         void AddJob(const Job& job) {
+            UGINE_COUNTER_INC("jobs.added");
+
             jobQueue_[int(job.priority)].PushBack(job);
             workerSemaphore_.Signal();
         }
@@ -145,7 +148,12 @@ namespace detail {
         }
 
         void HandleJob(Job& job) {
-            job.func(job.arg);
+            {
+                // Includes time the job spent suspended in Wait.
+                UGINE_METRIC_SCOPE_TIME("jobs.time");
+                job.func(job.arg);
+            }
+            UGINE_COUNTER_INC("jobs.executed");
 
             if (job.counter == nullptr) {
                 return;
@@ -178,7 +186,7 @@ namespace detail {
         Semaphore workerSemaphore_{ 0, JobScheduler::MAX_PENDING_JOBS };
 
         // Fiber pool.
-        ConcurentRingbuffer<Fiber::Native, FIBER_POOL_SIZE> fiberPool_;
+        MPMCQueue<Fiber::Native, FIBER_POOL_SIZE> fiberPool_;
 
         // Work.
         std::array<JobQueue, int(JobPriority::COUNT)> jobQueue_;
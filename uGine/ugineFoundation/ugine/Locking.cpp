@@ -68,6 +68,10 @@ void CondVar::Notify() {
     WakeConditionVariable(reinterpret_cast<PCONDITION_VARIABLE>(impl_));
 }
 
+void CondVar::NotifyAll() {
+    WakeAllConditionVariable(reinterpret_cast<PCONDITION_VARIABLE>(impl_));
+}
+
 } // namespace ugine
 
 #endif // _WIN32
\ No newline at end of file
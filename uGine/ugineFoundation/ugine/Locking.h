@@ -122,6 +122,7 @@ public:
     }
 
     void Notify();
+    void NotifyAll();
 
 private:
     u8 impl_[8];
@@ -1,13 +1,327 @@
 ﻿#include "Log.h"
 
+#include <ugine/Concurrent.h>
+#include <ugine/Locking.h>
 #include <ugine/String.h>
+#include <ugine/Thread.h>
 
 #include <spdlog/sinks/callback_sink.h>
 #include <spdlog/sinks/sink.h>
 #include <spdlog/sinks/stdout_color_sinks.h>
 
+#include <atomic>
+#include <csignal>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <Windows.h>
+
 namespace ugine {
 
+namespace {
+    constexpr u32 THREAD_BUFFER_SIZE{ 256 * 1024 };
+    constexpr auto IDLE_SLEEP{ std::chrono::milliseconds(1) };
+
+    using LogRing = SPSCByteRing<THREAD_BUFFER_SIZE>;
+
+    struct ThreadBuffer {
+        LogRing ring;
+        std::atomic_uint64_t dropped{};
+        std::atomic_bool closed{}; // Owning thread exited, buffer is released once drained.
+    };
+
+    void LogRecord(spdlog::logger& logger, const logging::RecordHeader& record, std::string& message) {
+        message.clear();
+
+        try {
+            record.formatFunc(record.format, reinterpret_cast<const u8*>(&record + 1), message);
+        } catch (const std::exception& ex) {
+            message = std::format("Invalid log format '{}': {}", record.format, ex.what());
+        }
+
+        logger.log(record.time, spdlog::source_loc{ record.site->file, record.site->line, nullptr },
+            static_cast<spdlog::level::level_enum>(record.site->level), message);
+    }
+
+    class LogBackend {
+    public:
+        ~LogBackend() { Stop(); }
+
+        bool Running() const { return running_.load(); }
+
+        void Start(std::shared_ptr<spdlog::logger> logger) {
+            {
+                Lock lock{ mutex_ };
+                logger_ = std::move(logger);
+            }
+
+            if (!running_.exchange(true)) {
+                stop_.store(false, std::memory_order_relaxed);
+                thread_ = Thread{ "Logger", [this] { Run(); } };
+            }
+        }
+
+        void Stop() {
+            if (running_.exchange(false)) {
+                stop_.store(true, std::memory_order_release);
+                thread_.Join();
+
+                // Flush requested after final drain.
+                flushed_.store(flushRequested_.load());
+                flushed_.notify_all();
+            }
+        }
+
+        void Flush() {
+            const auto ticket{ flushRequested_.fetch_add(1) + 1 };
+
+            auto flushed{ flushed_.load(std::memory_order_acquire) };
+            while (flushed < ticket && Running()) {
+                flushed_.wait(flushed, std::memory_order_acquire);
+                flushed = flushed_.load(std::memory_order_acquire);
+            }
+        }
+
+        // Polls instead of waiting, logger thread may be stuck or gone with the crash.
+        void FlushFor(std::chrono::milliseconds timeout) {
+            if (std::this_thread::get_id() == threadId_.load()) {
+                return;
+            }
+
+            const auto ticket{ flushRequested_.fetch_add(1) + 1 };
+            const auto deadline{ std::chrono::steady_clock::now() + timeout };
+            while (flushed_.load(std::memory_order_acquire) < ticket && Running() && std::chrono::steady_clock::now() < deadline) {
+                std::this_thread::sleep_for(IDLE_SLEEP);
+            }
+        }
+
+        std::shared_ptr<ThreadBuffer> Register() {
+            auto buffer{ std::make_shared<ThreadBuffer>() };
+
+            Lock lock{ mutex_ };
+            buffers_.push_back(buffer);
+            return buffer;
+        }
+
+        LogStats Stats() {
+            Lock lock{ mutex_ };
+
+            LogStats stats{ .written = written_.load(std::memory_order_relaxed), .dropped = closedDropped_, .threads = u32(buffers_.size()) };
+            for (const auto& buffer : buffers_) {
+                stats.dropped += buffer->dropped.load(std::memory_order_relaxed);
+            }
+            return stats;
+        }
+
+    private:
+        struct Cursor {
+            ThreadBuffer* buffer{};
+            u64 end{};
+            const logging::RecordHeader* front{};
+        };
+
+        void Run() {
+            threadId_.store(std::this_thread::get_id());
+
+            while (!stop_.load(std::memory_order_acquire)) {
+                if (!Drain()) {
+                    std::this_thread::sleep_for(IDLE_SLEEP);
+                }
+            }
+
+            Drain();
+        }
+
+        const logging::RecordHeader* Front(Cursor& cursor) {
+            return reinterpret_cast<const logging::RecordHeader*>(cursor.buffer->ring.Front(cursor.end));
+        }
+
+        // Writes records committed so far, merged from all threads by time. Returns false when there was nothing to do.
+        bool Drain() {
+            const auto flushTicket{ flushRequested_.load(std::memory_order_acquire) };
+
+            std::shared_ptr<spdlog::logger> logger;
+            {
+                Lock lock{ mutex_ };
+                logger = logger_;
+
+                cursors_.clear();
+                for (const auto& buffer : buffers_) {
+                    cursors_.push_back(Cursor{ buffer.get(), buffer->ring.CommittedEnd() });
+                }
+            }
+
+            for (auto& cursor : cursors_) {
+                cursor.front = Front(cursor);
+            }
+
+            u64 written{};
+            for (;;) {
+                Cursor* next{};
+                for (auto& cursor : cursors_) {
+                    if (cursor.front && (!next || cursor.front->time < next->front->time)) {
+                        next = &cursor;
+                    }
+                }
+
+                if (!next) {
+                    break;
+                }
+
+                LogRecord(*logger, *next->front, message_);
+                ++written;
+
+                next->buffer->ring.PopFront();
+                next->front = Front(*next);
+            }
+
+            written_.fetch_add(written, std::memory_order_relaxed);
+
+            ReleaseBuffers(*logger);
+
+            const auto flush{ flushTicket != flushed_.load(std::memory_order_relaxed) };
+            if (flush) {
+                logger->flush();
+
+                flushed_.store(flushTicket, std::memory_order_release);
+                flushed_.notify_all();
+            }
+
+            return written > 0 || flush;
+        }
+
+        // Releases buffers of exited threads and reports records dropped since last drain.
+        void ReleaseBuffers(spdlog::logger& logger) {
+            Lock lock{ mutex_ };
+
+            u64 dropped{};
+            for (auto it{ buffers_.begin() }; it != buffers_.end();) {
+                auto& buffer{ **it };
+                if (buffer.closed.load(std::memory_order_acquire) && buffer.ring.Empty()) {
+                    closedDropped_ += buffer.dropped.load(std::memory_order_relaxed);
+                    it = buffers_.erase(it);
+                } else {
+                    dropped += buffer.dropped.load(std::memory_order_relaxed);
+                    ++it;
+                }
+            }
+
+            dropped += closedDropped_;
+            if (dropped > reportedDropped_) {
+                logger.warn("Log buffer full, {} records dropped", dropped - reportedDropped_);
+                reportedDropped_ = dropped;
+            }
+        }
+
+        Mutex mutex_;
+        std::shared_ptr<spdlog::logger> logger_;
+        std::vector<std::shared_ptr<ThreadBuffer>> buffers_;
+        u64 closedDropped_{};
+
+        // Logger thread.
+        Thread thread_;
+        std::vector<Cursor> cursors_;
+        std::string message_;
+        u64 reportedDropped_{};
+
+        std::atomic_bool running_{};
+        std::atomic_bool stop_{};
+        std::atomic<std::thread::id> threadId_{};
+        std::atomic_uint64_t written_{};
+        std::atomic_uint64_t flushRequested_{};
+        std::atomic_uint64_t flushed_{};
+    };
+
+    LogBackend& Backend() {
+        static LogBackend backend;
+        return backend;
+    }
+
+    struct ThreadWriter {
+        ~ThreadWriter() {
+            if (buffer) {
+                buffer->closed.store(true, std::memory_order_release);
+            }
+        }
+
+        std::shared_ptr<ThreadBuffer> buffer;
+        std::vector<u8> scratch; // Records written synchronously.
+        bool synchronous{};
+    };
+
+    thread_local ThreadWriter threadWriter;
+
+    // Crash handlers, records still in thread buffers would be lost with the process.
+    LPTOP_LEVEL_EXCEPTION_FILTER previousExceptionFilter{};
+    std::terminate_handler previousTerminate{};
+
+    LONG WINAPI OnUnhandledException(EXCEPTION_POINTERS* info) {
+        UGINE_ERROR("Unhandled exception {:#x} at {:#x}", u32(info->ExceptionRecord->ExceptionCode),
+            u64(reinterpret_cast<uintptr_t>(info->ExceptionRecord->ExceptionAddress)));
+        FlushLoggerOnCrash();
+        return previousExceptionFilter ? previousExceptionFilter(info) : EXCEPTION_CONTINUE_SEARCH;
+    }
+
+    void OnTerminate() {
+        UGINE_ERROR("std::terminate called");
+        FlushLoggerOnCrash();
+
+        if (previousTerminate) {
+            previousTerminate();
+        }
+        std::abort();
+    }
+
+    void OnAbort(int) {
+        FlushLoggerOnCrash();
+    }
+
+    void InstallCrashHandlers() {
+        previousExceptionFilter = SetUnhandledExceptionFilter(&OnUnhandledException);
+        previousTerminate = std::set_terminate(&OnTerminate);
+        std::signal(SIGABRT, &OnAbort);
+    }
+} // namespace
+
+namespace logging {
+
+    u8* BeginRecord(u32 size) {
+        auto& writer{ threadWriter };
+
+        // Records which don't fit the buffer are written synchronously too.
+        writer.synchronous = !Backend().Running() || size > LogRing::MAX_BLOCK_SIZE;
+        if (writer.synchronous) {
+            writer.scratch.resize(size);
+            return writer.scratch.data();
+        }
+
+        if (!writer.buffer) {
+            writer.buffer = Backend().Register();
+        }
+
+        const auto data{ writer.buffer->ring.Reserve(size) };
+        if (!data) {
+            writer.buffer->dropped.fetch_add(1, std::memory_order_relaxed);
+        }
+        return data;
+    }
+
+    void EndRecord() {
+        auto& writer{ threadWriter };
+
+        if (writer.synchronous) {
+            std::string message;
+            LogRecord(*spdlog::default_logger_raw(), *reinterpret_cast<const RecordHeader*>(writer.scratch.data()), message);
+        } else {
+            writer.buffer->ring.Commit();
+        }
+    }
+
+} // namespace logging
+
 void InitLogger(std::optional<LoggerCallback> delegate) {
     static std::chrono::system_clock::time_point start{ std::chrono::system_clock::now() };
 
@@ -39,6 +353,34 @@ void InitLogger(std::optional<LoggerCallback> delegate) {
 #endif
 
     spdlog::set_default_logger(logger);
+    Backend().Start(logger);
+
+    static std::once_flag crashHandlers;
+    std::call_once(crashHandlers, InstallCrashHandlers);
+}
+
+void FlushLogger() {
+    if (Backend().Running()) {
+        Backend().Flush();
+    } else {
+        spdlog::default_logger_raw()->flush();
+    }
+}
+
+void ShutdownLogger() {
+    Backend().Stop();
+}
+
+void FlushLoggerOnCrash(std::chrono::milliseconds timeout) {
+    if (Backend().Running()) {
+        Backend().FlushFor(timeout);
+    } else {
+        spdlog::default_logger_raw()->flush();
+    }
+}
+
+LogStats GetLogStats() {
+    return Backend().Stats();
 }
 
 } // namespace ugine
@@ -4,7 +4,17 @@
 #include <ugine/Span.h>
 #include <ugine/StringUtils.h>
 
+#include <chrono>
+#include <concepts>
+#include <cstring>
+#include <format>
+#include <iterator>
+#include <new>
 #include <optional>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
 
 #ifdef _DEBUG
 #define SPDLOG_ACTIVE_LEVEL SPDLOG_LEVEL_TRACE
@@ -12,14 +22,49 @@
 
 #include <spdlog/spdlog.h>
 
-#define UGINE_TRACE(...) SPDLOG_TRACE(__VA_ARGS__)
-#define UGINE_DEBUG(...) SPDLOG_DEBUG(__VA_ARGS__)
-#define UGINE_INFO(...) SPDLOG_INFO(__VA_ARGS__)
-#define UGINE_WARN(...) SPDLOG_WARN(__VA_ARGS__)
-#define UGINE_ERROR(...) SPDLOG_ERROR(__VA_ARGS__)
+// Call site only checks level and copies format string id with raw arguments to thread's log buffer, formatting and
+// sinks run on logger thread. Single argument is logged as is (not used as format string), same as spdlog.
+#define UGINE_LOG(level, ...)                                                                                                                                  \
+    do {                                                                                                                                                       \
+        if (::ugine::logging::ShouldLog(level)) {                                                                                                              \
+            static constexpr ::ugine::logging::Site UGINE_LOG_SITE{ level, __FILE__, __LINE__ };                                                               \
+            ::ugine::logging::Write(UGINE_LOG_SITE, __VA_ARGS__);                                                                                              \
+        }                                                                                                                                                      \
+    } while (false)
+
+#if SPDLOG_ACTIVE_LEVEL <= SPDLOG_LEVEL_TRACE
+#define UGINE_TRACE(...) UGINE_LOG(::ugine::LogLevel::Trace, __VA_ARGS__)
+#else
+#define UGINE_TRACE(...) (void)0
+#endif
+
+#if SPDLOG_ACTIVE_LEVEL <= SPDLOG_LEVEL_DEBUG
+#define UGINE_DEBUG(...) UGINE_LOG(::ugine::LogLevel::Debug, __VA_ARGS__)
+#else
+#define UGINE_DEBUG(...) (void)0
+#endif
+
+#if SPDLOG_ACTIVE_LEVEL <= SPDLOG_LEVEL_INFO
+#define UGINE_INFO(...) UGINE_LOG(::ugine::LogLevel::Info, __VA_ARGS__)
+#else
+#define UGINE_INFO(...) (void)0
+#endif
+
+#if SPDLOG_ACTIVE_LEVEL <= SPDLOG_LEVEL_WARN
+#define UGINE_WARN(...) UGINE_LOG(::ugine::LogLevel::Warn, __VA_ARGS__)
+#else
+#define UGINE_WARN(...) (void)0
+#endif
+
+#if SPDLOG_ACTIVE_LEVEL <= SPDLOG_LEVEL_ERROR
+#define UGINE_ERROR(...) UGINE_LOG(::ugine::LogLevel::Error, __VA_ARGS__)
+#else
+#define UGINE_ERROR(...) (void)0
+#endif
 
 namespace ugine {
 
+// Same order as spdlog levels.
 enum class LogLevel {
     Trace,
     Debug,
@@ -30,6 +75,153 @@ enum class LogLevel {
 
 using LoggerCallback = Delegate<void(LogLevel /* level */, u64 /* millis */, Span<const char> /* message */)>;
 
+struct LogStats {
+    u64 written{};
+    u64 dropped{}; // Records lost because thread's log buffer was full.
+    u32 threads{}; // Threads with log buffer.
+};
+
+// Creates sinks and starts logger thread, may be called again to replace sinks. First call installs handlers of unhandled
+// exceptions, std::terminate and abort which write buffered records before the process ends.
 void InitLogger(std::optional<LoggerCallback> logger = std::nullopt);
 
+// Waits until records logged before the call are written and flushes sinks.
+void FlushLogger();
+
+// Writes pending records and stops logger thread, later records are written synchronously by calling thread.
+void ShutdownLogger();
+
+// FlushLogger for a process about to end (failed assert, crash), waits for logger thread at most `timeout`. Does nothing
+// on logger thread itself.
+void FlushLoggerOnCrash(std::chrono::milliseconds timeout = std::chrono::seconds(2));
+
+LogStats GetLogStats();
+
+namespace logging {
+
+    struct Site {
+        LogLevel level;
+        const char* file;
+        int line;
+    };
+
+    using FormatFunc = void (*)(std::string_view format, const u8* args, std::string& out);
+
+    // Followed by encoded arguments: raw bytes of arithmetic, enum and pointer values, u32 length and characters of
+    // strings.
+    struct RecordHeader {
+        const Site* site;
+        std::string_view format;
+        FormatFunc formatFunc;
+        std::chrono::system_clock::time_point time;
+    };
+
+    // Space for record in calling thread's log buffer, null when buffer is full and record is dropped. Before
+    // InitLogger (or after ShutdownLogger) returns scratch memory and EndRecord writes record synchronously.
+    u8* BeginRecord(u32 size);
+    void EndRecord();
+
+    inline bool ShouldLog(LogLevel level) {
+        return spdlog::default_logger_raw()->should_log(static_cast<spdlog::level::level_enum>(level));
+    }
+
+    template <typename T>
+    concept StringArg = std::is_convertible_v<const T&, std::string_view> || requires(const T& t) {
+        { t.Data() } -> std::convertible_to<const char*>;
+        { t.Size() } -> std::convertible_to<size_t>;
+    };
+
+    // Copied by value, anything else which isn't a string is formatted on calling thread as its pointers or
+    // references might not outlive the record.
+    template <typename T>
+    concept RawArg = !StringArg<T> && (std::is_arithmetic_v<T> || std::is_enum_v<T> || std::is_pointer_v<T>);
+
+    // Argument type formatted by logger thread.
+    template <typename T> using Decoded = std::conditional_t<RawArg<std::remove_cvref_t<T>>, std::remove_cvref_t<T>, std::string_view>;
+
+    template <typename T> std::string_view ToStringView(const T& str) {
+        if constexpr (std::is_convertible_v<const T&, std::string_view>) {
+            return str;
+        } else {
+            return { str.Data(), str.Size() };
+        }
+    }
+
+    template <typename T> decltype(auto) Prepare(const T& arg) {
+        if constexpr (RawArg<T> || StringArg<T>) {
+            return (arg);
+        } else {
+            return std::format("{}", arg);
+        }
+    }
+
+    template <typename T> u32 ArgSize(const T& arg) {
+        if constexpr (RawArg<T>) {
+            return u32(sizeof(T));
+        } else {
+            return u32(sizeof(u32) + ToStringView(arg).size());
+        }
+    }
+
+    template <typename T> void EncodeArg(u8*& data, const T& arg) {
+        if constexpr (RawArg<T>) {
+            memcpy(data, &arg, sizeof(T));
+            data += sizeof(T);
+        } else {
+            const auto str{ ToStringView(arg) };
+            const auto length{ u32(str.size()) };
+            memcpy(data, &length, sizeof(u32));
+            memcpy(data + sizeof(u32), str.data(), length);
+            data += sizeof(u32) + length;
+        }
+    }
+
+    template <typename T> T DecodeArg(const u8*& data) {
+        if constexpr (std::is_same_v<T, std::string_view>) {
+            u32 length{};
+            memcpy(&length, data, sizeof(u32));
+            const std::string_view str{ reinterpret_cast<const char*>(data + sizeof(u32)), length };
+            data += sizeof(u32) + length;
+            return str;
+        } else {
+            T value{};
+            memcpy(&value, data, sizeof(T));
+            data += sizeof(T);
+            return value;
+        }
+    }
+
+    template <typename... Ts> void FormatArgs(std::string_view format, const u8* data, std::string& out) {
+        // Braced initialization decodes arguments in order.
+        std::tuple<Ts...> args{ DecodeArg<Ts>(data)... };
+        std::apply([&](auto&... values) { std::vformat_to(std::back_inserter(out), format, std::make_format_args(values...)); }, args);
+    }
+
+    template <typename... Prepared> void WriteRecord(const Site& site, std::string_view format, const Prepared&... args) {
+        const auto size{ u32(sizeof(RecordHeader) + (ArgSize(args) + ... + 0)) };
+
+        auto data{ BeginRecord(size) };
+        if (!data) {
+            return;
+        }
+
+        new (data) RecordHeader{ &site, format, &FormatArgs<Decoded<Prepared>...>, std::chrono::system_clock::now() };
+        data += sizeof(RecordHeader);
+        (EncodeArg(data, args), ...);
+
+        EndRecord();
+    }
+
+    template <typename... Args>
+        requires(sizeof...(Args) > 0)
+    void Write(const Site& site, std::format_string<Decoded<Args>...> format, Args&&... args) {
+        WriteRecord(site, format.get(), Prepare(args)...);
+    }
+
+    template <typename T> void Write(const Site& site, const T& message) {
+        WriteRecord(site, "{}", Prepare(message));
+    }
+
+} // namespace logging
+
 } // namespace ugine
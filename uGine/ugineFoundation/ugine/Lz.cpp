@@ -0,0 +1,216 @@
+#include "Lz.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace ugine::lz {
+
+namespace {
+    constexpr size_t MIN_MATCH{ 4 };
+    constexpr size_t LAST_LITERALS{ 5 };  // Block always ends with literals.
+    constexpr size_t MATCH_LIMIT{ 12 };   // Last match starts at least this far from the end.
+    constexpr size_t MAX_OFFSET{ 65535 };
+    constexpr u32 HASH_BITS{ 12 };
+
+    UGINE_FORCE_INLINE u32 Read32(const u8* ptr) {
+        u32 value;
+        memcpy(&value, ptr, sizeof(value));
+        return value;
+    }
+
+    UGINE_FORCE_INLINE u32 Hash(u32 value) {
+        return (value * 2654435761u) >> (32 - HASH_BITS);
+    }
+
+    UGINE_FORCE_INLINE size_t LengthBytes(size_t length) {
+        return length >= 15 ? (length - 15) / 255 + 1 : 0;
+    }
+
+    UGINE_FORCE_INLINE void WriteLength(u8*& op, size_t length) {
+        for (; length >= 255; length -= 255) {
+            *op++ = 255;
+        }
+        *op++ = u8(length);
+    }
+
+    UGINE_FORCE_INLINE bool ReadLength(const u8*& ip, const u8* end, size_t& length) {
+        u8 value{};
+        do {
+            if (ip >= end) {
+                return false;
+            }
+            value = *ip++;
+            length += value;
+        } while (value == 255);
+
+        return true;
+    }
+
+    // Literals followed by optional match, matchLength == 0 for last sequence.
+    bool WriteSequence(u8*& op, const u8* end, const u8* literals, size_t literalLength, size_t offset, size_t matchLength) {
+        const auto size{ 1 + LengthBytes(literalLength) + literalLength + (matchLength ? 2 + LengthBytes(matchLength - MIN_MATCH) : 0) };
+        if (size > size_t(end - op)) {
+            return false;
+        }
+
+        auto token{ op++ };
+        *token = u8(std::min<size_t>(literalLength, 15) << 4);
+        if (literalLength >= 15) {
+            WriteLength(op, literalLength - 15);
+        }
+
+        if (literalLength) {
+            memcpy(op, literals, literalLength);
+            op += literalLength;
+        }
+
+        if (matchLength) {
+            *op++ = u8(offset);
+            *op++ = u8(offset >> 8);
+
+            const auto length{ matchLength - MIN_MATCH };
+            *token |= u8(std::min<size_t>(length, 15));
+            if (length >= 15) {
+                WriteLength(op, length - 15);
+            }
+        }
+
+        return true;
+    }
+} // namespace
+
+size_t CompressBound(size_t size) {
+    return size + size / 255 + 16;
+}
+
+size_t DecompressBound(size_t size) {
+    return size * 255;
+}
+
+size_t Compress(Span<const u8> src, Span<u8> dst) {
+    const auto begin{ src.Data() };
+    const auto end{ begin + src.Size() };
+
+    auto op{ dst.Data() };
+    const auto opEnd{ op + dst.Size() };
+
+    auto anchor{ begin };
+
+    if (src.Size() > MATCH_LIMIT) {
+        u32 table[1 << HASH_BITS]{};
+
+        const auto matchEnd{ end - LAST_LITERALS };
+        const auto searchEnd{ end - MATCH_LIMIT };
+
+        auto ip{ begin + 1 };
+        while (ip < searchEnd) {
+            const auto value{ Read32(ip) };
+            auto& slot{ table[Hash(value)] };
+            auto ref{ begin + slot };
+            slot = u32(ip - begin);
+
+            if (size_t(ip - ref) > MAX_OFFSET || Read32(ref) != value) {
+                ++ip;
+                continue;
+            }
+
+            while (ip > anchor && ref > begin && ip[-1] == ref[-1]) {
+                --ip;
+                --ref;
+            }
+
+            auto matchIp{ ip + MIN_MATCH };
+            auto matchRef{ ref + MIN_MATCH };
+            while (matchIp < matchEnd && *matchIp == *matchRef) {
+                ++matchIp;
+                ++matchRef;
+            }
+
+            if (!WriteSequence(op, opEnd, anchor, size_t(ip - anchor), size_t(ip - ref), size_t(matchIp - ip))) {
+                return 0;
+            }
+
+            ip = matchIp;
+            anchor = ip;
+
+            // Better ratio for back to back matches.
+            if (ip - 2 > begin) {
+                table[Hash(Read32(ip - 2))] = u32(ip - 2 - begin);
+            }
+        }
+    }
+
+    if (!WriteSequence(op, opEnd, anchor, size_t(end - anchor), 0, 0)) {
+        return 0;
+    }
+
+    return size_t(op - dst.Data());
+}
+
+bool Decompress(Span<const u8> src, Span<u8> dst) {
+    auto ip{ src.Data() };
+    const auto ipEnd{ ip + src.Size() };
+
+    const auto opBegin{ dst.Data() };
+    auto op{ opBegin };
+    const auto opEnd{ op + dst.Size() };
+
+    while (ip < ipEnd) {
+        const auto token{ *ip++ };
+
+        size_t literalLength{ size_t(token >> 4) };
+        if (literalLength == 15 && !ReadLength(ip, ipEnd, literalLength)) {
+            return false;
+        }
+
+        if (literalLength > size_t(ipEnd - ip) || literalLength > size_t(opEnd - op)) {
+            return false;
+        }
+
+        if (literalLength) {
+            memcpy(op, ip, literalLength);
+            ip += literalLength;
+            op += literalLength;
+        }
+
+        if (ip == ipEnd) {
+            break;
+        }
+
+        if (ipEnd - ip < 2) {
+            return false;
+        }
+
+        const size_t offset{ size_t(ip[0]) | size_t(ip[1]) << 8 };
+        ip += 2;
+
+        if (offset == 0 || offset > size_t(op - opBegin)) {
+            return false;
+        }
+
+        size_t matchLength{ size_t(token & 15) };
+        if (matchLength == 15 && !ReadLength(ip, ipEnd, matchLength)) {
+            return false;
+        }
+        matchLength += MIN_MATCH;
+
+        if (matchLength > size_t(opEnd - op)) {
+            return false;
+        }
+
+        const auto ref{ op - offset };
+        if (offset >= matchLength) {
+            memcpy(op, ref, matchLength);
+        } else {
+            // Overlapping match repeats last offset bytes.
+            for (size_t i{}; i < matchLength; ++i) {
+                op[i] = ref[i];
+            }
+        }
+        op += matchLength;
+    }
+
+    return op == opEnd;
+}
+
+} // namespace ugine::lz
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <ugine/Span.h>
+#include <ugine/Ugine.h>
+
+namespace ugine::lz {
+
+// LZ4 block format (no frame, no checksum), greedy single probe compressor tuned for decompression speed.
+
+// Worst case compressed size of incompressible data.
+size_t CompressBound(size_t size);
+
+// Largest size compressed data can expand to, each byte of match length adds at most 255 bytes.
+size_t DecompressBound(size_t size);
+
+// Returns compressed size, 0 if dst is too small.
+size_t Compress(Span<const u8> src, Span<u8> dst);
+
+// Decompressed size has to be known, fails on malformed input or size mismatch.
+bool Decompress(Span<const u8> src, Span<u8> dst);
+
+} // namespace ugine::lz
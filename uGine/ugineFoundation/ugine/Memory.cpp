@@ -13,6 +13,10 @@
 #include <Windows.h>
 #endif
 
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstring>
 #include <iostream>
 
 void* operator new(std::size_t count) {
@@ -26,6 +30,37 @@ namespace ugine {
 
 std::atomic_uint32_t numAllocs{};
 
+#ifdef UGINE_ALLOCATION_STATS
+std::atomic_uint64_t liveBytes{};
+std::atomic_uint64_t peakBytes{};
+
+namespace {
+    void AddLive(void* ptr) {
+        if (!ptr) {
+            return;
+        }
+
+        const auto size{ mi_usable_size(ptr) };
+        const auto live{ liveBytes.fetch_add(size, std::memory_order_relaxed) + size };
+        auto peak{ peakBytes.load(std::memory_order_relaxed) };
+        while (live > peak && !peakBytes.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {
+        }
+    }
+
+    void RemoveLive(void* ptr) {
+        if (ptr) {
+            liveBytes.fetch_sub(mi_usable_size(ptr), std::memory_order_relaxed);
+        }
+    }
+} // namespace
+
+#define STATS_ALLOC(ptr) AddLive(ptr)
+#define STATS_FREE(ptr) RemoveLive(ptr)
+#else // UGINE_ALLOCATION_STATS
+#define STATS_ALLOC(...)
+#define STATS_FREE(...)
+#endif // UGINE_ALLOCATION_STATS
+
 //
 // mimalloc allocator.
 ////////////////////////////////////////////////
@@ -40,6 +75,7 @@ public:
 
         auto ptr{ size <= MI_SMALL_SIZE_MAX ? mi_malloc_small(size) : mi_malloc(size) };
         PROFILE_ALLOC(ptr, size);
+        STATS_ALLOC(ptr);
 
         return ptr;
     }
@@ -49,14 +85,17 @@ public:
 
         UGINE_ASSERT(size > 0);
         PROFILE_FREE(memory);
+        STATS_FREE(memory);
         auto ptr{ mi_realloc(memory, size) };
         PROFILE_ALLOC(ptr, size);
+        STATS_ALLOC(ptr);
 
         return ptr;
     }
 
     void Free(void* memory) override {
         PROFILE_FREE(memory);
+        STATS_FREE(memory);
         mi_free(memory);
     }
 
@@ -65,6 +104,7 @@ public:
 
         auto ptr{ mi_malloc_aligned(size, alignment) };
         PROFILE_ALLOC(ptr, size);
+        STATS_ALLOC(ptr);
 
         return ptr;
     }
@@ -74,14 +114,17 @@ public:
 
         UGINE_ASSERT(size > 0);
         PROFILE_FREE(memory);
+        STATS_FREE(memory);
         auto ptr{ mi_realloc_aligned(memory, size, alignment) };
         PROFILE_ALLOC(ptr, size);
+        STATS_ALLOC(ptr);
 
         return ptr;
     }
 
     void AlignedFree(void* memory) override {
         PROFILE_FREE(memory);
+        STATS_FREE(memory);
         //mi_free_aligned(memory);
         mi_free(memory);
     }
@@ -95,8 +138,14 @@ CountedAllocator::~CountedAllocator() {
     UGINE_ASSERT(counter_ == 0 && ":-(");
 }
 
+void CountedAllocator::Record(size_t size) {
+    const auto bucket{ size <= 1 ? 0u : std::min(u32(std::bit_width(size - 1)), HISTOGRAM_BUCKETS - 1) };
+    histogram_[bucket].fetch_add(1, std::memory_order_relaxed);
+}
+
 void* CountedAllocator::Alloc(size_t size) {
     ++counter_;
+    Record(size);
     return allocator_->Alloc(size);
 }
 
@@ -113,11 +162,15 @@ void* CountedAllocator::Realloc(void* memory, size_t size) {
     } else if (memory == nullptr && size > 0) {
         ++counter_;
     }
+    if (size > 0) {
+        Record(size);
+    }
     return allocator_->Realloc(memory, size);
 }
 
 void* CountedAllocator::AlignedAlloc(size_t size, size_t alignment) {
     ++counter_;
+    Record(size);
     return allocator_->AlignedAlloc(size, alignment);
 }
 
@@ -134,6 +187,9 @@ void* CountedAllocator::AlignedRealloc(void* memory, size_t size, size_t alignme
     } else if (memory == nullptr && size > 0) {
         ++counter_;
     }
+    if (size > 0) {
+        Record(size);
+    }
     return allocator_->AlignedRealloc(memory, size, alignment);
 }
 
@@ -410,6 +466,589 @@ void LinearAllocator::Reset(Checkpoint chk) {
     counter_ = chk.Counter();
 }
 
+//
+// Arena allocator.
+////////////////////////////////////////////////
+
+namespace {
+    // Each allocation is prefixed by its size so it can be reallocated.
+    using ArenaHeader = size_t;
+
+    constexpr size_t ARENA_COMMIT_SIZE{ 256 * 1024 };
+} // namespace
+
+ArenaAllocator::ArenaAllocator(size_t blockSize)
+    : blockSize_{ blockSize } {
+    head_ = NewBlock(blockSize_);
+    current_ = head_;
+}
+
+ArenaAllocator::~ArenaAllocator() {
+    auto block{ head_ };
+    while (block) {
+        const auto next{ block->next };
+        const auto size{ block->size };
+        block->~Block();
+        VirtualRelease(block, size);
+        block = next;
+    }
+}
+
+ArenaAllocator::Block* ArenaAllocator::NewBlock(size_t minSize) {
+    const auto size{ AlignTo(std::max(minSize, blockSize_), GetMemoryLayout().allocationGranularity) };
+
+    auto memory{ VirtualReserve(size) };
+    if (!memory || !VirtualCommit(memory, std::min(size, ARENA_COMMIT_SIZE))) {
+        UGINE_ERROR("Failed to reserve {} B for arena", size);
+        UGINE_FATAL("Out of memory");
+    }
+
+    auto block{ new (memory) Block{} };
+    block->size = size;
+    block->offset = sizeof(Block);
+    block->committed = std::min(size, ARENA_COMMIT_SIZE);
+    return block;
+}
+
+void ArenaAllocator::Commit(Block* block, size_t end) {
+    if (end <= block->committed.load(std::memory_order_acquire)) {
+        return;
+    }
+
+    Lock lock{ mutex_ };
+
+    const auto committed{ block->committed.load(std::memory_order_relaxed) };
+    if (end <= committed) {
+        return;
+    }
+
+    const auto newCommitted{ std::min(block->size, AlignTo(end, ARENA_COMMIT_SIZE)) };
+    if (!VirtualCommit(reinterpret_cast<u8*>(block) + committed, newCommitted - committed)) {
+        UGINE_FATAL("Failed to commit arena memory");
+    }
+
+    block->committed.store(newCommitted, std::memory_order_release);
+}
+
+void* ArenaAllocator::TryAlloc(Block* block, size_t size, size_t alignment) {
+    alignment = std::max(alignment, alignof(ArenaHeader));
+
+    size_t position{};
+    size_t end{ block->offset.load(std::memory_order_relaxed) };
+    for (;;) {
+        position = AlignTo(end + sizeof(ArenaHeader), alignment);
+        if (position + size > block->size) {
+            return nullptr;
+        }
+
+        if (block->offset.compare_exchange_weak(end, position + size, std::memory_order_relaxed)) {
+            break;
+        }
+    }
+
+    Commit(block, position + size);
+
+    auto memory{ reinterpret_cast<u8*>(block) + position };
+    *(reinterpret_cast<ArenaHeader*>(memory) - 1) = size;
+    return memory;
+}
+
+bool ArenaAllocator::TryGrowInPlace(Block* block, void* memory, size_t oldSize, size_t newSize) {
+    const auto address{ reinterpret_cast<uintptr_t>(memory) };
+    const auto base{ reinterpret_cast<uintptr_t>(block) };
+    if (address < base || address >= base + block->size) {
+        return false;
+    }
+
+    const auto position{ size_t(address - base) };
+    if (position + newSize > block->size) {
+        return false;
+    }
+
+    // Only the last allocation of the block can grow.
+    auto end{ position + oldSize };
+    if (!block->offset.compare_exchange_strong(end, position + newSize, std::memory_order_relaxed)) {
+        return false;
+    }
+
+    Commit(block, position + newSize);
+
+    *(reinterpret_cast<ArenaHeader*>(memory) - 1) = newSize;
+    return true;
+}
+
+void* ArenaAllocator::Alloc(size_t size) {
+    return AlignedAlloc(size, alignof(std::max_align_t));
+}
+
+void ArenaAllocator::Free(void* memory) {
+    // NOP.
+}
+
+void* ArenaAllocator::Realloc(void* memory, size_t size) {
+    return AlignedRealloc(memory, size, alignof(std::max_align_t));
+}
+
+void* ArenaAllocator::AlignedAlloc(size_t size, size_t alignment) {
+    for (;;) {
+        const auto block{ current_.load(std::memory_order_acquire) };
+        if (auto memory{ TryAlloc(block, size, alignment) }) {
+            return memory;
+        }
+
+        // Block exhausted, move to the next one (kept from previous frames) or chain a new one.
+        Lock lock{ mutex_ };
+        if (current_.load(std::memory_order_relaxed) != block) {
+            continue;
+        }
+
+        if (!block->next || block->next->size < sizeof(Block) + size + alignment + sizeof(ArenaHeader)) {
+            auto newBlock{ NewBlock(std::max(block->size * 2, sizeof(Block) + size + alignment + sizeof(ArenaHeader))) };
+            newBlock->next = block->next;
+            block->next = newBlock;
+        }
+
+        current_.store(block->next, std::memory_order_release);
+    }
+}
+
+void ArenaAllocator::AlignedFree(void* memory) {
+    // NOP.
+}
+
+void* ArenaAllocator::AlignedRealloc(void* memory, size_t size, size_t alignment) {
+    if (memory == nullptr) {
+        return AlignedAlloc(size, alignment);
+    }
+
+    const auto oldSize{ *(reinterpret_cast<ArenaHeader*>(memory) - 1) };
+    if (size <= oldSize) {
+        return memory;
+    }
+
+    if (TryGrowInPlace(current_.load(std::memory_order_acquire), memory, oldSize, size)) {
+        return memory;
+    }
+
+    auto newMemory{ AlignedAlloc(size, alignment) };
+    memcpy(newMemory, memory, oldSize);
+    return newMemory;
+}
+
+size_t ArenaAllocator::Used() const {
+    size_t used{};
+    const auto current{ current_.load(std::memory_order_acquire) };
+    for (auto block{ head_ }; block; block = block->next) {
+        used += block->offset - sizeof(Block);
+        if (block == current) {
+            break;
+        }
+    }
+    return used;
+}
+
+void ArenaAllocator::Reset() {
+    lastFrame_ = Used();
+    highWater_ = std::max(highWater_, lastFrame_);
+
+    for (auto block{ head_ }; block; block = block->next) {
+        block->offset = sizeof(Block);
+    }
+    current_ = head_;
+}
+
+ArenaAllocator::Stats ArenaAllocator::GetStats() const {
+    Stats stats{
+        .used = Used(),
+        .lastFrame = lastFrame_,
+        .highWater = highWater_,
+    };
+
+    for (auto block{ head_ }; block; block = block->next) {
+        stats.committed += block->committed;
+        stats.reserved += block->size;
+        ++stats.blocks;
+    }
+
+    stats.highWater = std::max(stats.highWater, stats.used);
+    return stats;
+}
+
+//
+// Pool allocator.
+////////////////////////////////////////////////
+
+namespace {
+    // Pools with a thread cache slot, each thread keeps one cache per slot.
+    constexpr u32 MAX_CACHED_POOLS{ 32 };
+    std::atomic_uint32_t poolSlots{};
+    std::array<std::atomic_uint32_t, MAX_CACHED_POOLS> poolGenerations{};
+
+    // 16B steps up to 128B, then 4 classes per power of two.
+    constexpr auto POOL_CLASS_SIZES{ [] {
+        std::array<u32, PoolAllocator::NUM_SIZE_CLASSES> sizes{};
+        u32 index{};
+        for (u32 size{ 16 }; size <= 128; size += 16) {
+            sizes[index++] = size;
+        }
+        for (u32 base{ 128 }; base < PoolAllocator::MAX_SMALL_SIZE; base *= 2) {
+            for (u32 i{ 1 }; i <= 4; ++i) {
+                sizes[index++] = base + i * base / 4;
+            }
+        }
+        return sizes;
+    }() };
+
+    static_assert(POOL_CLASS_SIZES.back() == PoolAllocator::MAX_SMALL_SIZE);
+
+    // Blocks cached per thread and size class, about 16KB per class.
+    u32 MagazineSize(u32 sizeClass) {
+        return std::clamp(16u * 1024 / POOL_CLASS_SIZES[sizeClass], 4u, 128u);
+    }
+} // namespace
+
+struct PoolAllocator::ThreadLocal {
+    struct Entry {
+        PoolAllocator* pool{};
+        ThreadCache* cache{};
+        u32 generation{};
+    };
+
+    ~ThreadLocal() {
+        destroyed = true;
+
+        // Give cached blocks back to pools which are still alive.
+        for (u32 i{}; i < MAX_CACHED_POOLS; ++i) {
+            const auto& entry{ entries[i] };
+            if (entry.cache && poolGenerations[i] == entry.generation) {
+                entry.pool->ReleaseThreadCache(entry.cache);
+            }
+        }
+    }
+
+    std::array<Entry, MAX_CACHED_POOLS> entries{};
+    bool destroyed{};
+};
+
+thread_local PoolAllocator::ThreadLocal PoolAllocator::threadLocal_;
+
+PoolAllocator::PoolAllocator(IAllocator& fallback, size_t reserveSize)
+    : fallback_{ fallback }
+    , reserveSize_{ AlignTo(reserveSize, SLAB_SIZE) } {
+    base_ = static_cast<u8*>(VirtualReserve(reserveSize_));
+    if (!base_) {
+        UGINE_FATAL("Out of memory");
+    }
+
+    slabClasses_ = static_cast<u8*>(fallback_->Alloc(reserveSize_ / SLAB_SIZE));
+
+    // Without a free slot the pool still works, just without thread caches.
+    slot_ = MAX_CACHED_POOLS;
+    auto slots{ poolSlots.load() };
+    while (slots != ~0u) {
+        const auto slot{ u32(std::countr_one(slots)) };
+        if (poolSlots.compare_exchange_weak(slots, slots | (1u << slot))) {
+            slot_ = slot;
+            generation_ = ++poolGenerations[slot];
+            break;
+        }
+    }
+}
+
+PoolAllocator::~PoolAllocator() {
+    if (slot_ < MAX_CACHED_POOLS) {
+        // Invalidates thread caches of all threads.
+        ++poolGenerations[slot_];
+        poolSlots.fetch_and(~(1u << slot_));
+    }
+
+    while (caches_) {
+        auto next{ caches_->next };
+        fallback_->AlignedFree(caches_);
+        caches_ = next;
+    }
+
+    fallback_->Free(slabClasses_);
+    VirtualRelease(base_, reserveSize_);
+}
+
+u32 PoolAllocator::SizeClass(size_t size) {
+    UGINE_ASSERT(size <= MAX_SMALL_SIZE);
+
+    if (size <= 128) {
+        return size == 0 ? 0 : u32((size - 1) / 16);
+    }
+
+    const auto bits{ u32(std::bit_width(size - 1)) };
+    return 8 + (bits - 8) * 4 + u32(((size - 1) >> (bits - 3)) & 3);
+}
+
+size_t PoolAllocator::ClassSize(u32 sizeClass) {
+    return POOL_CLASS_SIZES[sizeClass];
+}
+
+bool PoolAllocator::Owns(const void* memory) const {
+    const auto address{ static_cast<const u8*>(memory) };
+    return address >= base_ && address < base_ + reserveSize_;
+}
+
+u32 PoolAllocator::SizeClassOf(const void* memory) const {
+    return slabClasses_[size_t(static_cast<const u8*>(memory) - base_) / SLAB_SIZE];
+}
+
+void* PoolAllocator::Alloc(size_t size) {
+    if (size <= MAX_SMALL_SIZE) {
+        return AllocSmall(SizeClass(size));
+    }
+    return fallback_->Alloc(size);
+}
+
+void PoolAllocator::Free(void* memory) {
+    if (!memory) {
+        return;
+    }
+
+    if (Owns(memory)) {
+        FreeSmall(memory);
+    } else {
+        fallback_->Free(memory);
+    }
+}
+
+void* PoolAllocator::Realloc(void* memory, size_t size) {
+    if (!memory) {
+        return Alloc(size);
+    }
+
+    UGINE_ASSERT(size > 0);
+    if (!Owns(memory)) {
+        return fallback_->Realloc(memory, size);
+    }
+
+    const auto oldSize{ ClassSize(SizeClassOf(memory)) };
+    if (size <= oldSize) {
+        return memory;
+    }
+
+    auto newMemory{ Alloc(size) };
+    memcpy(newMemory, memory, oldSize);
+    FreeSmall(memory);
+    return newMemory;
+}
+
+void* PoolAllocator::AlignedAlloc(size_t size, size_t alignment) {
+    if (size <= MAX_SMALL_SIZE && alignment <= MIN_ALIGNMENT) {
+        return AllocSmall(SizeClass(size));
+    }
+    return fallback_->AlignedAlloc(size, alignment);
+}
+
+void PoolAllocator::AlignedFree(void* memory) {
+    if (!memory) {
+        return;
+    }
+
+    if (Owns(memory)) {
+        FreeSmall(memory);
+    } else {
+        fallback_->AlignedFree(memory);
+    }
+}
+
+void* PoolAllocator::AlignedRealloc(void* memory, size_t size, size_t alignment) {
+    if (!memory) {
+        return AlignedAlloc(size, alignment);
+    }
+
+    UGINE_ASSERT(size > 0);
+    if (!Owns(memory)) {
+        return fallback_->AlignedRealloc(memory, size, alignment);
+    }
+
+    const auto oldSize{ ClassSize(SizeClassOf(memory)) };
+    if (size <= oldSize && alignment <= MIN_ALIGNMENT) {
+        return memory;
+    }
+
+    auto newMemory{ AlignedAlloc(size, alignment) };
+    memcpy(newMemory, memory, std::min(oldSize, size));
+    FreeSmall(memory);
+    return newMemory;
+}
+
+void* PoolAllocator::AllocSmall(u32 sizeClass) {
+    ++numAllocs;
+
+    FreeBlock* block{};
+    if (auto cache{ GetThreadCache() }) {
+        auto& bin{ cache->bins[sizeClass] };
+        if (!bin.head) {
+            Refill(sizeClass, bin, MagazineSize(sizeClass) / 2);
+        }
+
+        block = bin.head;
+        bin.head = block->next;
+        --bin.count;
+    } else {
+        Bin bin{};
+        Refill(sizeClass, bin, 1);
+        block = bin.head;
+    }
+
+    PROFILE_ALLOC(block, ClassSize(sizeClass));
+    return block;
+}
+
+void PoolAllocator::FreeSmall(void* memory) {
+    PROFILE_FREE(memory);
+
+    const auto sizeClass{ SizeClassOf(memory) };
+    auto block{ static_cast<FreeBlock*>(memory) };
+
+    if (auto cache{ GetThreadCache() }) {
+        auto& bin{ cache->bins[sizeClass] };
+        block->next = bin.head;
+        bin.head = block;
+        ++bin.count;
+
+        if (bin.count > MagazineSize(sizeClass)) {
+            Flush(sizeClass, bin, bin.count / 2);
+        }
+    } else {
+        Bin bin{ block, 1 };
+        block->next = nullptr;
+        Flush(sizeClass, bin, 1);
+    }
+}
+
+void PoolAllocator::Refill(u32 sizeClass, Bin& bin, u32 count) {
+    auto& pool{ classes_[sizeClass] };
+
+    Lock lock{ pool.mutex };
+    for (u32 i{}; i < count; ++i) {
+        if (!pool.free) {
+            pool.free = pool.remote.exchange(nullptr, std::memory_order_acquire);
+        }
+
+        auto block{ pool.free };
+        if (block) {
+            pool.free = block->next;
+        } else {
+            block = Carve(pool, sizeClass);
+        }
+
+        block->next = bin.head;
+        bin.head = block;
+        ++bin.count;
+    }
+}
+
+void PoolAllocator::Flush(u32 sizeClass, Bin& bin, u32 count) {
+    UGINE_ASSERT(count > 0 && count <= bin.count);
+
+    auto first{ bin.head };
+    auto last{ first };
+    for (u32 i{ 1 }; i < count; ++i) {
+        last = last->next;
+    }
+
+    bin.head = last->next;
+    bin.count -= count;
+
+    // Push the whole chain, consumer takes all blocks at once so there is no ABA.
+    auto& remote{ classes_[sizeClass].remote };
+    last->next = remote.load(std::memory_order_relaxed);
+    while (!remote.compare_exchange_weak(last->next, first, std::memory_order_release, std::memory_order_relaxed)) {
+    }
+}
+
+void PoolAllocator::FlushAll(ThreadCache& cache) {
+    for (u32 i{}; i < NUM_SIZE_CLASSES; ++i) {
+        if (cache.bins[i].count > 0) {
+            Flush(i, cache.bins[i], cache.bins[i].count);
+        }
+    }
+}
+
+PoolAllocator::FreeBlock* PoolAllocator::Carve(SizeClassPool& pool, u32 sizeClass) {
+    const auto size{ ClassSize(sizeClass) };
+    if (pool.carve + size > pool.carveEnd) {
+        const auto slab{ slabs_.fetch_add(1) };
+        if (slab >= reserveSize_ / SLAB_SIZE) {
+            UGINE_FATAL("Out of memory");
+        }
+
+        auto memory{ base_ + size_t(slab) * SLAB_SIZE };
+        if (!VirtualCommit(memory, SLAB_SIZE)) {
+            UGINE_FATAL("Out of memory");
+        }
+
+        slabClasses_[slab] = u8(sizeClass);
+        pool.carve = memory;
+        pool.carveEnd = memory + SLAB_SIZE;
+    }
+
+    auto block{ reinterpret_cast<FreeBlock*>(pool.carve) };
+    pool.carve += size;
+    return block;
+}
+
+PoolAllocator::ThreadCache* PoolAllocator::GetThreadCache() {
+    if (slot_ >= MAX_CACHED_POOLS || threadLocal_.destroyed) {
+        return nullptr;
+    }
+
+    auto& entry{ threadLocal_.entries[slot_] };
+    if (entry.cache && entry.generation == generation_) {
+        return entry.cache;
+    }
+
+    entry = ThreadLocal::Entry{
+        .pool = this,
+        .cache = AcquireThreadCache(),
+        .generation = generation_,
+    };
+    return entry.cache;
+}
+
+PoolAllocator::ThreadCache* PoolAllocator::AcquireThreadCache() {
+    Lock lock{ cacheMutex_ };
+
+    if (auto cache{ freeCaches_ }) {
+        freeCaches_ = cache->nextFree;
+        return cache;
+    }
+
+    auto cache{ new (fallback_->AlignedAlloc(sizeof(ThreadCache), alignof(ThreadCache))) ThreadCache{} };
+    cache->next = caches_;
+    caches_ = cache;
+    ++numCaches_;
+    return cache;
+}
+
+void PoolAllocator::ReleaseThreadCache(ThreadCache* cache) {
+    FlushAll(*cache);
+
+    Lock lock{ cacheMutex_ };
+    cache->nextFree = freeCaches_;
+    freeCaches_ = cache;
+}
+
+void PoolAllocator::FlushThreadCache() {
+    if (auto cache{ GetThreadCache() }) {
+        FlushAll(*cache);
+    }
+}
+
+PoolAllocator::Stats PoolAllocator::GetStats() const {
+    const auto slabs{ std::min(slabs_.load(), u32(reserveSize_ / SLAB_SIZE)) };
+    return Stats{
+        .committed = size_t(slabs) * SLAB_SIZE,
+        .slabs = slabs,
+        .threadCaches = numCaches_,
+    };
+}
+
 //
 // IAllocator.
 ////////////////////////////////////////////////
@@ -428,9 +1067,40 @@ MemoryLayout GetMemoryLayout() {
 #endif
 }
 
+void* VirtualReserve(size_t size) {
+#ifdef WIN32
+    return VirtualAlloc(nullptr, size, MEM_RESERVE, PAGE_READWRITE);
+#else
+    static_assert(false, "Not implemented");
+#endif
+}
+
+bool VirtualCommit(void* memory, size_t size) {
+#ifdef WIN32
+    return VirtualAlloc(memory, size, MEM_COMMIT, PAGE_READWRITE) != nullptr;
+#else
+    static_assert(false, "Not implemented");
+#endif
+}
+
+void VirtualRelease(void* memory, size_t size) {
+#ifdef WIN32
+    VirtualFree(memory, 0, MEM_RELEASE);
+#else
+    static_assert(false, "Not implemented");
+#endif
+}
+
 IAllocator& IAllocator::Default() noexcept {
     //static HeapAllocator allocator;
+#ifdef UGINE_POOL_ALLOCATOR
+    // Never destroyed, memory may be freed by other static destructors.
+    static MimallocAllocator fallback;
+    alignas(PoolAllocator) static u8 storage[sizeof(PoolAllocator)];
+    static auto& allocator{ *new (storage) PoolAllocator{ fallback } };
+#else  // UGINE_POOL_ALLOCATOR
     static MimallocAllocator allocator;
+#endif // UGINE_POOL_ALLOCATOR
 
 #ifdef UGINE_TRACE_ALLOCATIONS
     static StackTraceAllocator stAllocator{ allocator, true };
@@ -453,4 +1123,29 @@ void IAllocator::ResetCounter() noexcept {
     numAllocs = 0;
 }
 
+#ifdef UGINE_ALLOCATION_STATS
+u64 IAllocator::LiveBytes() noexcept {
+    return liveBytes;
+}
+
+u64 IAllocator::PeakBytes() noexcept {
+    return peakBytes;
+}
+
+void IAllocator::ResetPeakBytes() noexcept {
+    peakBytes = liveBytes.load();
+}
+#else  // UGINE_ALLOCATION_STATS
+u64 IAllocator::LiveBytes() noexcept {
+    return 0;
+}
+
+u64 IAllocator::PeakBytes() noexcept {
+    return 0;
+}
+
+void IAllocator::ResetPeakBytes() noexcept {
+}
+#endif // UGINE_ALLOCATION_STATS
+
 } // namespace ugine
@@ -27,6 +27,11 @@ struct MemoryLayout {
 
 MemoryLayout GetMemoryLayout();
 
+// Reserves address space only, pages have to be committed before use.
+void* VirtualReserve(size_t size);
+bool VirtualCommit(void* memory, size_t size);
+void VirtualRelease(void* memory, size_t size);
+
 template <typename T> class Ref {
 public:
     using Type = T;
@@ -51,6 +56,11 @@ public:
     static IAllocator& Default() noexcept;
     static u32 NumAllocs() noexcept;
     static void ResetCounter() noexcept;
+    // Bytes held by mimalloc allocations, peak since start or last ResetPeakBytes. Zero unless built with
+    // UGINE_ALLOCATION_STATS, tracking costs atomics on every allocation and free.
+    static u64 LiveBytes() noexcept;
+    static u64 PeakBytes() noexcept;
+    static void ResetPeakBytes() noexcept;
 
     virtual ~IAllocator() = default;
 
@@ -84,9 +94,16 @@ public:
 
     u64 Count() const { return counter_; }
 
+    // Allocation count by size, bucket i holds sizes in (2^(i-1), 2^i].
+    static constexpr u32 HISTOGRAM_BUCKETS{ 32 };
+    u64 Histogram(u32 bucket) const { return histogram_[bucket]; }
+
 private:
+    void Record(size_t size);
+
     AllocatorRef allocator_;
     std::atomic_uint64_t counter_{};
+    std::array<std::atomic_uint64_t, HISTOGRAM_BUCKETS> histogram_{};
 };
 
 class StackTraceAllocator : public IAllocator {
@@ -256,4 +273,162 @@ private:
     std::atomic_size_t counter_{};
 };
 
+// Growable linear allocator for transient (per frame) data, usually one per thread.
+// Blocks reserve address space up front and commit pages on demand, an exhausted block chains a new,
+// twice as large block instead of overflowing. Blocks are kept for reuse after Reset.
+// Allocation is a lock free bump of the current block, the lock is taken only to commit pages or chain blocks.
+class ArenaAllocator final : public IAllocator {
+public:
+    static constexpr size_t DEFAULT_BLOCK_SIZE{ 64 * 1024 * 1024 };
+
+    struct Stats {
+        size_t used{};      // Allocated bytes (with headers and padding) since last reset.
+        size_t lastFrame{}; // Used bytes at last reset.
+        size_t highWater{}; // Max used bytes between two resets.
+        size_t committed{};
+        size_t reserved{};
+        u32 blocks{};
+    };
+
+    explicit ArenaAllocator(size_t blockSize = DEFAULT_BLOCK_SIZE);
+    ~ArenaAllocator();
+
+    ArenaAllocator(const ArenaAllocator&) = delete;
+    ArenaAllocator& operator=(const ArenaAllocator&) = delete;
+
+    void* Alloc(size_t size) override;
+    void Free(void* memory) override;
+    void* Realloc(void* memory, size_t size) override;
+
+    void* AlignedAlloc(size_t size, size_t alignment) override;
+    void AlignedFree(void* memory) override;
+    void* AlignedRealloc(void* memory, size_t size, size_t alignment) override;
+
+    // All memory is released to the arena, no allocation may be in flight.
+    void Reset();
+
+    Stats GetStats() const;
+
+private:
+    struct Block {
+        Block* next{};
+        size_t size{}; // Reserved bytes including this header.
+        std::atomic_size_t offset{};
+        std::atomic_size_t committed{};
+    };
+
+    Block* NewBlock(size_t minSize);
+    void* TryAlloc(Block* block, size_t size, size_t alignment);
+    bool TryGrowInPlace(Block* block, void* memory, size_t oldSize, size_t newSize);
+    void Commit(Block* block, size_t end);
+    size_t Used() const;
+
+    size_t blockSize_{};
+    Block* head_{};
+    std::atomic<Block*> current_{};
+    mutable AtomicSpinLock mutex_;
+
+    size_t lastFrame_{};
+    size_t highWater_{};
+};
+
+// Thread caching small object allocator.
+// Sizes up to MAX_SMALL_SIZE are rounded up to a size class and served from slabs carved out of a single reserved
+// address range. Each thread keeps a magazine of free blocks per size class, so most calls don't touch shared state.
+// Overfull magazines are flushed in batches to a lock free per class queue, which is also how blocks freed on another
+// thread get back to the pool. Larger or over-aligned allocations are forwarded to the fallback allocator.
+// Slabs are returned to the system only when the allocator is destroyed.
+class PoolAllocator final : public IAllocator {
+public:
+    static constexpr size_t MAX_SMALL_SIZE{ 4096 };
+    static constexpr size_t MIN_ALIGNMENT{ 16 };
+    static constexpr size_t SLAB_SIZE{ 64 * 1024 };
+    static constexpr size_t DEFAULT_RESERVE_SIZE{ size_t(4) * 1024 * 1024 * 1024 };
+    static constexpr u32 NUM_SIZE_CLASSES{ 28 };
+
+    struct Stats {
+        size_t committed{};
+        u32 slabs{};
+        u32 threadCaches{};
+    };
+
+    explicit PoolAllocator(IAllocator& fallback = IAllocator::Default(), size_t reserveSize = DEFAULT_RESERVE_SIZE);
+    ~PoolAllocator();
+
+    PoolAllocator(const PoolAllocator&) = delete;
+    PoolAllocator& operator=(const PoolAllocator&) = delete;
+
+    void* Alloc(size_t size) override;
+    void Free(void* memory) override;
+    void* Realloc(void* memory, size_t size) override;
+
+    void* AlignedAlloc(size_t size, size_t alignment) override;
+    void AlignedFree(void* memory) override;
+    void* AlignedRealloc(void* memory, size_t size, size_t alignment) override;
+
+    // Returns blocks cached by the calling thread to the pool.
+    void FlushThreadCache();
+
+    bool Owns(const void* memory) const;
+    Stats GetStats() const;
+
+    static u32 SizeClass(size_t size);
+    static size_t ClassSize(u32 sizeClass);
+
+private:
+    struct FreeBlock {
+        FreeBlock* next{};
+    };
+
+    struct Bin {
+        FreeBlock* head{};
+        u32 count{};
+    };
+
+    struct ThreadCache {
+        std::array<Bin, NUM_SIZE_CLASSES> bins{};
+        ThreadCache* next{};     // All caches.
+        ThreadCache* nextFree{}; // Caches released by exited threads.
+    };
+
+    struct alignas(UGINE_CACHE_LINE_SIZE) SizeClassPool {
+        AtomicSpinLock mutex;
+        FreeBlock* free{};
+        u8* carve{};
+        u8* carveEnd{};
+        std::atomic<FreeBlock*> remote{};
+    };
+
+    struct ThreadLocal;
+    static thread_local ThreadLocal threadLocal_;
+
+    void* AllocSmall(u32 sizeClass);
+    void FreeSmall(void* memory);
+    u32 SizeClassOf(const void* memory) const;
+
+    ThreadCache* GetThreadCache();
+    ThreadCache* AcquireThreadCache();
+    void ReleaseThreadCache(ThreadCache* cache);
+
+    void Refill(u32 sizeClass, Bin& bin, u32 count);
+    void Flush(u32 sizeClass, Bin& bin, u32 count);
+    void FlushAll(ThreadCache& cache);
+    FreeBlock* Carve(SizeClassPool& pool, u32 sizeClass);
+
+    AllocatorRef fallback_;
+    u8* base_{};
+    size_t reserveSize_{};
+    u8* slabClasses_{};
+    std::atomic_uint32_t slabs_{};
+
+    std::array<SizeClassPool, NUM_SIZE_CLASSES> classes_;
+
+    u32 slot_{};
+    u32 generation_{};
+    AtomicSpinLock cacheMutex_;
+    ThreadCache* caches_{};
+    ThreadCache* freeCaches_{};
+    u32 numCaches_{};
+};
+
 } // namespace ugine
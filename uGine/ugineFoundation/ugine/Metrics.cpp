@@ -0,0 +1,327 @@
+#include "Metrics.h"
+
+#include <ugine/Locking.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstring>
+#include <format>
+#include <memory>
+#include <ostream>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace ugine {
+
+namespace {
+    // Index 0 of each kind absorbs updates of metrics registered over capacity.
+    constexpr u32 OVERFLOW_INDEX{ 0 };
+
+    struct HistogramShard {
+        std::array<std::atomic_uint64_t, Metrics::HISTOGRAM_BUCKETS> buckets{};
+        std::atomic_uint64_t sum{};
+        std::atomic_uint64_t max{};
+    };
+
+    // Written only by owning thread, read by Collect.
+    struct Shard {
+        std::array<std::atomic_uint64_t, Metrics::MAX_COUNTERS> counters{};
+        std::array<HistogramShard, Metrics::MAX_HISTOGRAMS> histograms{};
+        std::atomic_bool retired{}; // Owning thread exited.
+    };
+
+    struct Histogram {
+        std::array<u64, Metrics::HISTOGRAM_BUCKETS> buckets{};
+        u64 sum{};
+        u64 max{};
+
+        void Merge(const HistogramShard& shard) {
+            for (u32 i{}; i < Metrics::HISTOGRAM_BUCKETS; ++i) {
+                buckets[i] += shard.buckets[i].load(std::memory_order_relaxed);
+            }
+            sum += shard.sum.load(std::memory_order_relaxed);
+            max = std::max(max, shard.max.load(std::memory_order_relaxed));
+        }
+
+        u64 Percentile(u64 count, f64 percentile) const {
+            const auto rank{ u64(f64(count) * percentile) };
+
+            u64 cumulative{};
+            for (u32 i{}; i < Metrics::HISTOGRAM_BUCKETS; ++i) {
+                cumulative += buckets[i];
+                if (cumulative > rank) {
+                    return std::min(max, i == 0 ? 0 : (u64(1) << i) - 1);
+                }
+            }
+            return max;
+        }
+    };
+
+    struct Definition {
+        const char* name{};
+        const char* unit{};
+        MetricType type{};
+        u32 index{};
+    };
+
+    UGINE_FORCE_INLINE void Increment(std::atomic_uint64_t& value, u64 add) {
+        value.store(value.load(std::memory_order_relaxed) + add, std::memory_order_relaxed);
+    }
+
+    std::atomic_bool enabled{ true };
+
+    class Registry {
+    public:
+        u32 Register(const char* name, const char* unit, MetricType type) {
+            Lock lock{ mutex_ };
+
+            if (const auto it{ byName_.find(name) }; it != byName_.end()) {
+                const auto& definition{ definitions_[it->second] };
+                UGINE_ASSERT(definition.type == type && "Metric registered with different type");
+                return definition.type == type ? definition.index : OVERFLOW_INDEX;
+            }
+
+            auto& next{ nextIndex_[u32(type)] };
+            if (next == Capacity(type)) {
+                UGINE_ASSERT(false && "Too many metrics");
+                return OVERFLOW_INDEX;
+            }
+
+            byName_.emplace(name, u32(definitions_.size()));
+            definitions_.push_back(Definition{ .name = name, .unit = unit, .type = type, .index = next });
+            return next++;
+        }
+
+        std::shared_ptr<Shard> AddShard() {
+            auto shard{ std::make_shared<Shard>() };
+
+            Lock lock{ mutex_ };
+            shards_.push_back(shard);
+            return shard;
+        }
+
+        void SetGauge(u32 index, i64 value) { gauges_[index].store(value, std::memory_order_relaxed); }
+
+        void Collect() {
+            Lock lock{ mutex_ };
+
+            // Values of exited threads are kept in retired sums.
+            std::erase_if(shards_, [this](const auto& shard) {
+                if (!shard->retired.load(std::memory_order_acquire)) {
+                    return false;
+                }
+
+                for (u32 i{}; i < Metrics::MAX_COUNTERS; ++i) {
+                    retiredCounters_[i] += shard->counters[i].load(std::memory_order_relaxed);
+                }
+                for (u32 i{}; i < Metrics::MAX_HISTOGRAMS; ++i) {
+                    retiredHistograms_[i].Merge(shard->histograms[i]);
+                }
+                return true;
+            });
+
+            values_.resize(definitions_.size());
+            previous_.resize(definitions_.size());
+
+            for (size_t d{}; d < definitions_.size(); ++d) {
+                const auto& definition{ definitions_[d] };
+                auto& value{ values_[d] };
+
+                value = MetricValue{ .name = definition.name, .unit = definition.unit, .type = definition.type };
+
+                switch (definition.type) {
+                case MetricType::Counter: {
+                    auto total{ retiredCounters_[definition.index] };
+                    for (const auto& shard : shards_) {
+                        total += shard->counters[definition.index].load(std::memory_order_relaxed);
+                    }
+
+                    value.value = i64(total);
+                    value.frame = i64(total - previous_[d]);
+                    previous_[d] = total;
+                } break;
+                case MetricType::Gauge: value.value = gauges_[definition.index].load(std::memory_order_relaxed); break;
+                case MetricType::Histogram: {
+                    auto histogram{ retiredHistograms_[definition.index] };
+                    for (const auto& shard : shards_) {
+                        histogram.Merge(shard->histograms[definition.index]);
+                    }
+
+                    for (const auto bucket : histogram.buckets) {
+                        value.count += bucket;
+                    }
+
+                    value.frame = i64(value.count - previous_[d]);
+                    previous_[d] = value.count;
+
+                    if (value.count > 0) {
+                        value.mean = f64(histogram.sum) / f64(value.count);
+                        value.p50 = histogram.Percentile(value.count, 0.5);
+                        value.p90 = histogram.Percentile(value.count, 0.9);
+                        value.p99 = histogram.Percentile(value.count, 0.99);
+                        value.max = histogram.max;
+                    }
+                } break;
+                }
+            }
+        }
+
+        Span<const MetricValue> Values() const { return { values_.data(), values_.size() }; }
+
+    private:
+        static u32 Capacity(MetricType type) {
+            switch (type) {
+            case MetricType::Counter: return Metrics::MAX_COUNTERS;
+            case MetricType::Gauge: return Metrics::MAX_GAUGES;
+            default: return Metrics::MAX_HISTOGRAMS;
+            }
+        }
+
+        Mutex mutex_;
+
+        std::vector<Definition> definitions_;
+        std::unordered_map<std::string_view, u32> byName_;
+        std::array<u32, 3> nextIndex_{ OVERFLOW_INDEX + 1, OVERFLOW_INDEX + 1, OVERFLOW_INDEX + 1 };
+
+        std::vector<std::shared_ptr<Shard>> shards_;
+        std::array<std::atomic_int64_t, Metrics::MAX_GAUGES> gauges_{};
+
+        std::array<u64, Metrics::MAX_COUNTERS> retiredCounters_{};
+        std::array<Histogram, Metrics::MAX_HISTOGRAMS> retiredHistograms_{};
+
+        // Collect.
+        std::vector<MetricValue> values_;
+        std::vector<u64> previous_; // Counter total or histogram count of previous Collect.
+    };
+
+    Registry& GetRegistry() {
+        static Registry registry;
+        return registry;
+    }
+
+    struct ThreadShard {
+        ~ThreadShard() {
+            if (shard) {
+                shard->retired.store(true, std::memory_order_release);
+            }
+        }
+
+        std::shared_ptr<Shard> shard;
+    };
+
+    thread_local ThreadShard threadShard;
+
+    Shard& LocalShard() {
+        auto& local{ threadShard };
+        if (!local.shard) {
+            local.shard = GetRegistry().AddShard();
+        }
+        return *local.shard;
+    }
+
+    const char* TypeName(MetricType type) {
+        switch (type) {
+        case MetricType::Counter: return "counter";
+        case MetricType::Gauge: return "gauge";
+        default: return "histogram";
+        }
+    }
+} // namespace
+
+MetricCounter::MetricCounter(const char* name)
+    : index_{ GetRegistry().Register(name, "", MetricType::Counter) } {
+}
+
+void MetricCounter::Add(u64 value) const {
+    if (enabled.load(std::memory_order_relaxed)) {
+        Increment(LocalShard().counters[index_], value);
+    }
+}
+
+MetricGauge::MetricGauge(const char* name)
+    : index_{ GetRegistry().Register(name, "", MetricType::Gauge) } {
+}
+
+void MetricGauge::Set(i64 value) const {
+    if (enabled.load(std::memory_order_relaxed)) {
+        GetRegistry().SetGauge(index_, value);
+    }
+}
+
+MetricHistogram::MetricHistogram(const char* name, const char* unit)
+    : index_{ GetRegistry().Register(name, unit, MetricType::Histogram) } {
+}
+
+void MetricHistogram::Record(u64 value) const {
+    if (enabled.load(std::memory_order_relaxed)) {
+        auto& histogram{ LocalShard().histograms[index_] };
+
+        Increment(histogram.buckets[std::min<u32>(u32(std::bit_width(value)), Metrics::HISTOGRAM_BUCKETS - 1)], 1);
+        Increment(histogram.sum, value);
+        if (value > histogram.max.load(std::memory_order_relaxed)) {
+            histogram.max.store(value, std::memory_order_relaxed);
+        }
+    }
+}
+
+void Metrics::SetEnabled(bool value) {
+    enabled.store(value, std::memory_order_relaxed);
+}
+
+bool Metrics::Enabled() {
+    return enabled.load(std::memory_order_relaxed);
+}
+
+void Metrics::Collect() {
+    GetRegistry().Collect();
+}
+
+Span<const MetricValue> Metrics::Values() {
+    return GetRegistry().Values();
+}
+
+const MetricValue* Metrics::Find(const char* name) {
+    for (const auto& value : Values()) {
+        if (strcmp(value.name, name) == 0) {
+            return &value;
+        }
+    }
+    return nullptr;
+}
+
+void Metrics::WriteCsvHeader(std::ostream& out) {
+    out << "time,name,type,unit,value,frame,count,mean,p50,p90,p99,max\n";
+}
+
+void Metrics::WriteCsv(std::ostream& out, f64 time) {
+    for (const auto& value : Values()) {
+        out << std::format("{:.3f},{},{},{},{},{},{},{:.3f},{},{},{},{}\n", time, value.name, TypeName(value.type), value.unit, value.value, value.frame,
+            value.count, value.mean, value.p50, value.p90, value.p99, value.max);
+    }
+}
+
+void Metrics::WriteJson(std::ostream& out, f64 time) {
+    out << std::format("{{\"time\":{:.3f},\"metrics\":[", time);
+
+    bool first{ true };
+    for (const auto& value : Values()) {
+        out << std::format("{}{{\"name\":\"{}\",\"type\":\"{}\"", first ? "" : ",", value.name, TypeName(value.type));
+        first = false;
+
+        switch (value.type) {
+        case MetricType::Counter: out << std::format(",\"value\":{},\"frame\":{}}}", value.value, value.frame); break;
+        case MetricType::Gauge: out << std::format(",\"value\":{}}}", value.value); break;
+        case MetricType::Histogram:
+            out << std::format(",\"unit\":\"{}\",\"count\":{},\"frame\":{},\"mean\":{:.3f},\"p50\":{},\"p90\":{},\"p99\":{},\"max\":{}}}", value.unit,
+                value.count, value.frame, value.mean, value.p50, value.p90, value.p99, value.max);
+            break;
+        }
+    }
+
+    out << "]}\n";
+}
+
+} // namespace ugine
@@ -0,0 +1,145 @@
+#pragma once
+
+#include <ugine/Span.h>
+#include <ugine/Ugine.h>
+
+#include <chrono>
+#include <iosfwd>
+
+// Always on counters, gauges and histograms cheap enough for hot paths. Handle is registered once per call site, updates
+// only touch calling thread's shard, shards are merged by Metrics::Collect once per frame.
+#define UGINE_COUNTER_ADD(name, value)                                                                                                                         \
+    do {                                                                                                                                                       \
+        static const ::ugine::MetricCounter UGINE_METRIC{ name };                                                                                              \
+        UGINE_METRIC.Add(u64(value));                                                                                                                          \
+    } while (false)
+
+#define UGINE_COUNTER_INC(name) UGINE_COUNTER_ADD(name, 1)
+
+#define UGINE_GAUGE_SET(name, value)                                                                                                                           \
+    do {                                                                                                                                                       \
+        static const ::ugine::MetricGauge UGINE_METRIC{ name };                                                                                                \
+        UGINE_METRIC.Set(i64(value));                                                                                                                          \
+    } while (false)
+
+#define UGINE_HISTOGRAM_RECORD(name, value)                                                                                                                    \
+    do {                                                                                                                                                       \
+        static const ::ugine::MetricHistogram UGINE_METRIC{ name };                                                                                            \
+        UGINE_METRIC.Record(u64(value));                                                                                                                       \
+    } while (false)
+
+#define UGINE_METRIC_CONCAT_(a, b) a##b
+#define UGINE_METRIC_CONCAT(a, b) UGINE_METRIC_CONCAT_(a, b)
+
+// Records microseconds until end of scope to histogram.
+#define UGINE_METRIC_SCOPE_TIME(name)                                                                                                                          \
+    const ::ugine::MetricTimer UGINE_METRIC_CONCAT(metricTimer, __LINE__) {                                                                                    \
+        []() -> const ::ugine::MetricHistogram& {                                                                                                              \
+            static const ::ugine::MetricHistogram histogram{ name, "us" };                                                                                     \
+            return histogram;                                                                                                                                  \
+        }()                                                                                                                                                    \
+    }
+
+namespace ugine {
+
+enum class MetricType {
+    Counter,
+    Gauge,
+    Histogram,
+};
+
+// Handles, registering the same name again returns the same metric.
+class MetricCounter {
+public:
+    explicit MetricCounter(const char* name);
+
+    void Add(u64 value = 1) const;
+
+private:
+    u32 index_{};
+};
+
+class MetricGauge {
+public:
+    explicit MetricGauge(const char* name);
+
+    void Set(i64 value) const;
+
+private:
+    u32 index_{};
+};
+
+// Log2 buckets, percentiles are reported as upper bound of the bucket.
+class MetricHistogram {
+public:
+    explicit MetricHistogram(const char* name, const char* unit = "");
+
+    void Record(u64 value) const;
+
+private:
+    u32 index_{};
+};
+
+class MetricTimer {
+public:
+    explicit MetricTimer(const MetricHistogram& histogram)
+        : histogram_{ histogram } {}
+
+    MetricTimer(const MetricTimer&) = delete;
+    MetricTimer& operator=(const MetricTimer&) = delete;
+
+    ~MetricTimer() { histogram_.Record(u64(std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start_).count())); }
+
+private:
+    using Clock = std::chrono::high_resolution_clock;
+
+    const MetricHistogram& histogram_;
+    Clock::time_point start_{ Clock::now() };
+};
+
+struct MetricValue {
+    const char* name{};
+    const char* unit{};
+    MetricType type{};
+
+    i64 value{}; // Counter total or gauge value.
+    i64 frame{}; // Counter increase or histogram samples since previous Collect.
+
+    // Histogram since start.
+    u64 count{};
+    f64 mean{};
+    u64 p50{};
+    u64 p90{};
+    u64 p99{};
+    u64 max{};
+};
+
+class Metrics {
+public:
+    static constexpr u32 MAX_COUNTERS{ 256 };
+    static constexpr u32 MAX_GAUGES{ 256 };
+    static constexpr u32 MAX_HISTOGRAMS{ 64 };
+
+    // Bucket i holds values of bit width i, last one everything larger.
+    static constexpr u32 HISTOGRAM_BUCKETS{ 40 };
+
+    // Disabled metrics ignore updates, values are kept.
+    static void SetEnabled(bool enabled);
+    static bool Enabled();
+
+    // Merges thread shards into values, called once per frame from one thread.
+    static void Collect();
+
+    // Values of last Collect in registration order, valid until next Collect.
+    static Span<const MetricValue> Values();
+    static const MetricValue* Find(const char* name);
+
+    // One row per metric.
+    static void WriteCsvHeader(std::ostream& out);
+    static void WriteCsv(std::ostream& out, f64 time);
+
+    // One JSON object per line.
+    static void WriteJson(std::ostream& out, f64 time);
+};
+
+} // namespace ugine
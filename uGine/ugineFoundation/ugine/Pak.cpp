@@ -0,0 +1,237 @@
+#include "Pak.h"
+
+#include "Hash.h"
+#include "Log.h"
+#include "Lz.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace ugine {
+
+namespace {
+    using PathBuffer = StaticString<Path::MaxLength>;
+
+    void NormalizePath(StringView path, PathBuffer& out) {
+        out.Clear();
+
+        auto begin{ path.Begin() };
+        const auto end{ path.End() };
+
+        if (end - begin >= 2 && begin[0] == '.' && (begin[1] == '/' || begin[1] == '\\')) {
+            begin += 2;
+        }
+
+        for (; begin != end && *begin != '\0'; ++begin) {
+            auto ch{ *begin };
+            if (ch == '\\') {
+                ch = '/';
+            } else if (ch >= 'A' && ch <= 'Z') {
+                ch = char(ch - 'A' + 'a');
+            }
+
+            if (ch == '/' && out.Empty()) {
+                continue;
+            }
+
+            out.Append(ch);
+        }
+    }
+
+    u64 AlignOffset(u64 offset) {
+        return (offset + PakHeader::ALIGNMENT - 1) & ~u64(PakHeader::ALIGNMENT - 1);
+    }
+} // namespace
+
+u64 PakHashPath(StringView path) {
+    PathBuffer normalized;
+    NormalizePath(path, normalized);
+
+    return fnv1a(normalized.Data(), normalized.Size());
+}
+
+PakWriter::PakWriter(const Path& file, IAllocator& allocator)
+    : file_{ file.Data(), std::ios::binary | std::ios::trunc }
+    , entries_{ allocator }
+    , names_{ allocator }
+    , buffer_{ allocator } {
+
+    // Placeholder, header is written by Finish.
+    const PakHeader header{};
+    file_.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    offset_ = sizeof(header);
+}
+
+bool PakWriter::Add(StringView path, Span<const u8> data, bool compress) {
+    PathBuffer normalized;
+    NormalizePath(path, normalized);
+
+    if (data.Size() > PakHeader::MAX_ENTRY_SIZE) {
+        UGINE_ERROR("Pak entry '{}' is too large ({} B)", normalized.Data(), data.Size());
+        return false;
+    }
+
+    const auto hash{ fnv1a(normalized.Data(), normalized.Size()) };
+    if (!hashes_.insert(hash).second) {
+        UGINE_ERROR("Pak entry '{}' is a duplicate or its hash collides", normalized.Data());
+        return false;
+    }
+
+    PakEntry entry{
+        .hash = hash,
+        .offset = AlignOffset(offset_),
+        .size = data.Size(),
+        .storedSize = data.Size(),
+        .nameOffset = u32(names_.Size()),
+        .nameSize = u32(normalized.Size()),
+        .compression = PakCompression::None,
+    };
+
+    auto stored{ data };
+    if (compress && !data.Empty()) {
+        buffer_.Resize(lz::CompressBound(data.Size()));
+
+        const auto size{ lz::Compress(data, buffer_.ToSpan()) };
+        if (size > 0 && size <= data.Size() - data.Size() / 8) {
+            entry.storedSize = size;
+            entry.compression = PakCompression::Lz4;
+            stored = Span<const u8>{ buffer_.Data(), size };
+        }
+    }
+
+    static constexpr char PADDING[PakHeader::ALIGNMENT]{};
+    file_.write(PADDING, entry.offset - offset_);
+    file_.write(reinterpret_cast<const char*>(stored.Data()), stored.Size());
+    offset_ = entry.offset + entry.storedSize;
+
+    names_.Append(normalized.Data(), normalized.Size());
+    entries_.PushBack(entry);
+
+    return file_.good();
+}
+
+bool PakWriter::Finish() {
+    std::sort(entries_.begin(), entries_.end(), [](const auto& a, const auto& b) { return a.hash < b.hash; });
+
+    PakHeader header{
+        .entryCount = u32(entries_.Size()),
+        .namesSize = u32(names_.Size()),
+        .indexOffset = AlignOffset(offset_),
+    };
+    header.namesOffset = header.indexOffset + entries_.Size() * sizeof(PakEntry);
+
+    static constexpr char PADDING[PakHeader::ALIGNMENT]{};
+    file_.write(PADDING, header.indexOffset - offset_);
+    file_.write(reinterpret_cast<const char*>(entries_.Data()), entries_.Size() * sizeof(PakEntry));
+    file_.write(names_.Data(), names_.Size());
+
+    file_.seekp(0);
+    file_.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file_.close();
+
+    return !file_.fail();
+}
+
+UniquePtr<PakArchive> PakArchive::Open(const Path& file, IAllocator& allocator) {
+    MappedFile mapped{ file };
+    if (!mapped.IsOpen()) {
+        UGINE_ERROR("Failed to map pak '{}'", file.Data());
+        return {};
+    }
+
+    auto archive{ MakeUnique<PakArchive>(allocator, std::move(mapped)) };
+    if (!archive->Validate()) {
+        UGINE_ERROR("Invalid pak '{}'", file.Data());
+        return {};
+    }
+
+    return archive;
+}
+
+PakArchive::PakArchive(MappedFile&& file)
+    : file_{ std::move(file) } {
+    if (file_.Size() >= sizeof(PakHeader)) {
+        memcpy(&header_, file_.Data().Data(), sizeof(header_));
+    }
+}
+
+bool PakArchive::Validate() {
+    const auto size{ file_.Size() };
+    if (size < sizeof(PakHeader) || header_.magic != PakHeader::MAGIC || header_.version != PakHeader::VERSION) {
+        return false;
+    }
+
+    if (header_.indexOffset % alignof(PakEntry) != 0 || header_.indexOffset > size
+        || header_.entryCount > (size - header_.indexOffset) / sizeof(PakEntry)) {
+        return false;
+    }
+
+    if (header_.namesOffset != header_.indexOffset + header_.entryCount * sizeof(PakEntry) || header_.namesSize > size - header_.namesOffset) {
+        return false;
+    }
+
+    const auto entries{ reinterpret_cast<const PakEntry*>(file_.Data().Data() + header_.indexOffset) };
+    for (u32 i{}; i < header_.entryCount; ++i) {
+        const auto& entry{ entries[i] };
+        if (entry.offset > header_.indexOffset || entry.storedSize > header_.indexOffset - entry.offset
+            || u64(entry.nameOffset) + entry.nameSize > header_.namesSize || (i > 0 && entries[i - 1].hash >= entry.hash)) {
+            return false;
+        }
+
+        if (entry.compression == PakCompression::None ? entry.storedSize != entry.size : entry.compression != PakCompression::Lz4) {
+            return false;
+        }
+
+        // Sizes of compressed entries decide allocation, stored bytes can't decode to more than the LZ4 ratio allows.
+        if (entry.size > PakHeader::MAX_ENTRY_SIZE || (entry.compression == PakCompression::Lz4 && entry.size > lz::DecompressBound(entry.storedSize))) {
+            return false;
+        }
+    }
+
+    entries_ = Span<const PakEntry>{ entries, header_.entryCount };
+    names_ = reinterpret_cast<const char*>(file_.Data().Data() + header_.namesOffset);
+
+    return true;
+}
+
+const PakEntry* PakArchive::Find(StringView path) const {
+    PathBuffer normalized;
+    NormalizePath(path, normalized);
+
+    const auto hash{ fnv1a(normalized.Data(), normalized.Size()) };
+
+    const auto it{ std::lower_bound(entries_.Begin(), entries_.End(), hash, [](const PakEntry& entry, u64 hash) { return entry.hash < hash; }) };
+    if (it == entries_.End() || it->hash != hash) {
+        return nullptr;
+    }
+
+    // Hash matches for files missing in archive are possible.
+    if (it->nameSize != normalized.Size() || memcmp(names_ + it->nameOffset, normalized.Data(), normalized.Size()) != 0) {
+        return nullptr;
+    }
+
+    return it;
+}
+
+StringView PakArchive::Name(const PakEntry& entry) const {
+    return StringView{ names_ + entry.nameOffset, entry.nameSize };
+}
+
+Span<const u8> PakArchive::Stored(const PakEntry& entry) const {
+    return Span<const u8>{ file_.Data().Data() + entry.offset, size_t(entry.storedSize) };
+}
+
+bool PakArchive::Read(const PakEntry& entry, Vector<u8>& data) const {
+    const auto stored{ Stored(entry) };
+
+    data.Resize(entry.size);
+
+    switch (entry.compression) {
+    case PakCompression::None: memcpy(data.Data(), stored.Data(), stored.Size()); return true;
+    case PakCompression::Lz4: return lz::Decompress(stored, data.ToSpan());
+    }
+
+    return false;
+}
+
+} // namespace ugine
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <ugine/File.h>
+#include <ugine/Memory.h>
+#include <ugine/Path.h>
+#include <ugine/Span.h>
+#include <ugine/String.h>
+#include <ugine/Vector.h>
+
+#include <fstream>
+#include <unordered_set>
+
+namespace ugine {
+
+// Asset archive: header, entry data aligned to PakHeader::ALIGNMENT, index sorted by path hash, path names. Paths are
+// case insensitive, both separators are accepted.
+struct PakHeader {
+    static constexpr u32 MAGIC{ 0x4b415055 }; // "UPAK"
+    static constexpr u32 VERSION{ 1 };
+    static constexpr u32 ALIGNMENT{ 64 };
+    // Uncompressed, checked before anything is allocated for the entry.
+    static constexpr u64 MAX_ENTRY_SIZE{ u64(2) << 30 };
+
+    u32 magic{ MAGIC };
+    u32 version{ VERSION };
+    u32 entryCount{};
+    u32 namesSize{};
+    u64 indexOffset{};
+    u64 namesOffset{};
+};
+
+enum class PakCompression : u32 {
+    None,
+    Lz4,
+};
+
+struct PakEntry {
+    u64 hash{};
+    u64 offset{};
+    u64 size{};       // Uncompressed.
+    u64 storedSize{}; // In archive.
+    u32 nameOffset{};
+    u32 nameSize{};
+    PakCompression compression{};
+    u32 reserved{};
+};
+
+u64 PakHashPath(StringView path);
+
+// Streams entries to file, index is written by Finish.
+class PakWriter {
+public:
+    explicit PakWriter(const Path& file, IAllocator& allocator = IAllocator::Default());
+
+    bool Good() const { return file_.good(); }
+
+    // Entry is compressed only if it saves at least 1/8 of its size. Fails on duplicate path, hash collision or entry
+    // larger than PakHeader::MAX_ENTRY_SIZE.
+    bool Add(StringView path, Span<const u8> data, bool compress);
+    bool Finish();
+
+    u64 DataSize() const { return offset_; }
+
+private:
+    std::ofstream file_;
+    Vector<PakEntry> entries_;
+    Vector<char> names_;
+    Vector<u8> buffer_;
+    std::unordered_set<u64> hashes_;
+    u64 offset_{};
+};
+
+// Archive mapped to memory, stored data is handed out without copies.
+class PakArchive {
+public:
+    // Null if archive can't be mapped or is malformed.
+    static UniquePtr<PakArchive> Open(const Path& file, IAllocator& allocator = IAllocator::Default());
+
+    explicit PakArchive(MappedFile&& file);
+
+    const PakEntry* Find(StringView path) const;
+
+    Span<const PakEntry> Entries() const { return entries_; }
+    StringView Name(const PakEntry& entry) const;
+
+    // Raw entry bytes, valid for archive lifetime.
+    Span<const u8> Stored(const PakEntry& entry) const;
+
+    // Copies or decompresses entry.
+    bool Read(const PakEntry& entry, Vector<u8>& data) const;
+
+private:
+    bool Validate();
+
+    MappedFile file_;
+    PakHeader header_{};
+    Span<const PakEntry> entries_;
+    const char* names_{};
+};
+
+} // namespace ugine
@@ -83,20 +83,19 @@ void Scheduler::FinishThreads() {
     std::for_each(tasks.Begin(), tasks.End(), [&](auto& t) { scheduler_.WaitforTask(t.Get()); });
 }
 
-void Scheduler::ScheduleStatic(Group& grp, std::function<void()> func) {
-    const auto index{ grp.count.fetch_add(1) };
-    // TODO: Create custom inherited ITaskSet without std::function.
-    auto task = new (reinterpret_cast<void*>(&grp.staticTasks[index])) enki::TaskSet{ [func](enki::TaskSetPartition t, u32 num) { func(); } };
-    scheduler_.AddTaskSetToPipe(task);
-}
-
-void Scheduler::ScheduleStatic(Group& grp, u32 num, std::function<void(u32, u32, u32)> func) {
+void Scheduler::ScheduleStatic(Group& grp, u32 num, TaskFunction func) {
     UGINE_ASSERT(num > 0);
 
     const auto index{ grp.count.fetch_add(1) };
-    // TODO: Create custom inherited ITaskSet without std::function.
-    auto task = new (reinterpret_cast<void*>(&grp.staticTasks[index])) enki::TaskSet{ num, [func](enki::TaskSetPartition t, u32 num) { func(t.start, t.end, num); } };
-    scheduler_.AddTaskSetToPipe(task);
+    UGINE_ASSERT(index < grp.staticTasks.size());
+
+    auto& task{ grp.staticTasks[index] };
+    task.m_SetSize = num;
+    task.m_MinRange = 1;
+    task.func = std::move(func);
+
+    grp.tasks[index] = nullptr;
+    scheduler_.AddTaskSetToPipe(&task);
 }
 
 void Scheduler::Schedule(Group& grp, u32 num, Task* task) {
@@ -119,7 +118,7 @@ u32 Scheduler::Wait(Group& grp) {
         } else {
             // Statically allocated tasks.
             scheduler_.WaitforTask(&grp.staticTasks[cnt]);
-            grp.staticTasks[cnt].~TaskSet();
+            grp.staticTasks[cnt].func.Reset();
         }
     }
     return cnt;
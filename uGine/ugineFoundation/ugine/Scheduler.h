@@ -1,6 +1,7 @@
 ﻿#pragma once
 
 #include <ugine/Delegate.h>
+#include <ugine/InplaceFunction.h>
 #include <ugine/Span.h>
 #include <ugine/String.h>
 #include <ugine/Ugine.h>
@@ -30,10 +31,22 @@ public:
 
 class Scheduler {
 public:
+    // Captures of statically scheduled tasks are stored in the group, larger captures don't compile.
+    static constexpr size_t TASK_CAPTURE_SIZE{ 128 };
+
+    using TaskFunction = InplaceFunction<void(u32 /*start*/, u32 /*end*/, u32 /*threadNum*/), TASK_CAPTURE_SIZE>;
+
+    class StaticTask final : public enki::ITaskSet {
+    public:
+        void ExecuteRange(TaskSetPartition range, u32 threadnum) override { func(range.start, range.end, threadnum); }
+
+        TaskFunction func;
+    };
+
     struct Group {
         std::atomic_uint32_t count;
         std::array<enki::ITaskSet*, 2048> tasks;
-        std::array<enki::TaskSet, 2048> staticTasks;
+        std::array<StaticTask, 2048> staticTasks;
 
         void Reset() { count = 0; }
     };
@@ -43,12 +56,38 @@ public:
     Scheduler(u32 tasks, Span<const String> taskNames = {}, IAllocator& allocator = IAllocator::Default());
     ~Scheduler();
 
-    void ScheduleStatic(Group& grp, std::function<void()> func);
-    void ScheduleStatic(Group& grp, u32 num, std::function<void(u32 /*start*/, u32 /*end*/, u32 /*threadNum*/)> func);
+    template <typename F> void ScheduleStatic(Group& grp, F&& func) {
+        ScheduleStatic(grp, 1, [func = std::forward<F>(func)](u32, u32, u32) mutable { func(); });
+    }
+    void ScheduleStatic(Group& grp, u32 num, TaskFunction func);
     void Schedule(Group& grp, u32 num, Task* task);
     
     u32 Wait(Group& grp);
 
+    // Ranges of items run on workers and the calling thread, which waits for all of them.
+    template <typename F> void ParallelFor(u32 count, F&& func) {
+        if (count < 2) {
+            func(0, count);
+            return;
+        }
+
+        class RangeTask final : public Task {
+        public:
+            RangeTask(u32 count, F& func)
+                : Task{ count, 1 }
+                , func_{ func } {}
+
+            void Run(u32 start, u32 end, u32 threadNum) override { func_(start, end); }
+
+        private:
+            F& func_;
+        };
+
+        RangeTask task{ count, func };
+        Schedule(&task);
+        WaitFor(&task);
+    }
+
     void Schedule(TaskSet* task);
     void SchedulePinned(PinnedTask* task);
     void WaitFor(Completable* task);
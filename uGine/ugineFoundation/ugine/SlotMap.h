@@ -1,13 +1,15 @@
 #pragma once
 
 #include <ugine/Memory.h>
+#include <ugine/Span.h>
 #include <ugine/Ugine.h>
 #include <ugine/Vector.h>
 
-#include <deque>
-
 namespace ugine {
 
+// Generational map with stable value addresses. Values live in fixed size pages, keys encode generation and slot index.
+// Vacant slots form an intrusive free list through the slot table, live slots are additionally tracked in a dense
+// index array for iteration. Emptied pages are kept for reuse up to the retained page count.
 template <typename _ValueType, typename _KeyType = u64, size_t _PageSize = 4096> class SlotMap {
 public:
     using InternalKeyType = u64;
@@ -19,8 +21,11 @@ public:
     using GenerationType = u32;
     using IndexType = u32;
 
-    static constexpr GenerationType MaxGeneration{ GenerationType(-1) };
+    // Top bit of slot generation marks vacant slot, so it never matches generation of a key.
+    static constexpr GenerationType VacantBit{ GenerationType(1) << 31 };
+    static constexpr GenerationType MaxGeneration{ VacantBit - 1 };
     static constexpr IndexType MaxIndex{ IndexType(-1) };
+    static constexpr IndexType InvalidIndex{ MaxIndex };
 
     static constexpr size_t PageSize{ _PageSize };
     static constexpr size_t SlotSize{ sizeof(ValueType) };
@@ -32,13 +37,15 @@ public:
     struct Stats {
         u64 pageAllocations{};
         u64 pageDeallocations{};
+        u64 pageReuses{};
         u64 overflows{};
     };
 
     explicit SlotMap(IAllocator& allocator = IAllocator::Default())
         : allocator_{ allocator }
         , pages_{ allocator }
-        , indices_{ allocator } {}
+        , slots_{ allocator }
+        , live_{ allocator } {}
     ~SlotMap() = default;
 
     // TODO: Allow copy for copyable inner types.
@@ -46,101 +53,105 @@ public:
     SlotMap& operator=(const SlotMap&) = delete;
 
     template <typename... Args> KeyType Emplace(Args&&... args) {
-        if (freeList_.empty()) {
+        if (freeHead_ == InvalidIndex) {
             AddPage();
         }
 
-        ++size_;
-        const auto freeKey{ freeList_.front() };
-        freeList_.pop_front();
-
-        const auto [generation, index] = DecodeKey(freeKey);
+        const auto index{ PopFree() };
+        new (MemoryAt(index)) ValueType(std::forward<Args&&>(args)...);
 
-        indices_[index] = freeKey;
+        return static_cast<KeyType>(EncodeKey(slots_[index].generation, index));
+    }
 
-        const auto pageIndex{ GetPageIndex(index) };
+    // Moves values into the map, keys are written to `keys` in the same order.
+    void EmplaceBatch(Span<ValueType> values, Span<KeyType> keys) {
+        UGINE_ASSERT(keys.Size() >= values.Size());
 
-        auto& page{ pages_[pageIndex] };
-        if (page.usedSlots == 0) {
-            page.Allocate();
-        }
-        ++page.usedSlots;
+        Reserve(size_ + values.Size());
+        live_.Reserve(size_ + values.Size());
 
-        auto memory{ MemoryAt(index) };
-        new (memory) ValueType(std::forward<Args&&>(args)...);
+        for (size_t i{}; i < values.Size(); ++i) {
+            const auto index{ PopFree() };
+            new (MemoryAt(index)) ValueType(std::move(values[i]));
 
-        return static_cast<KeyType>(freeKey);
+            keys[i] = static_cast<KeyType>(EncodeKey(slots_[index].generation, index));
+        }
     }
 
     ValueType* Get(KeyType key) const {
         const auto [generation, index] = DecodeKey(static_cast<InternalKeyType>(key));
-        if (generation == 0) {
-            return nullptr;
-        }
-
-        if (index >= indices_.Size()) {
-            return nullptr;
-        }
-
-        const auto [exGeneration, exIndex] = DecodeKey(indices_[index]);
-
-        if (exGeneration != generation) {
-            return nullptr;
-        }
-
-        return MemoryAt(index);
+        return IsLive(generation, index) ? MemoryAt(index) : nullptr;
     }
 
+    bool Contains(KeyType key) const { return Get(key) != nullptr; }
+
     void Erase(KeyType key) {
         const auto [generation, index] = DecodeKey(static_cast<InternalKeyType>(key));
-        const auto [exGen, exIndex] = DecodeKey(indices_[index]);
-
-        if (exGen != generation) {
-            return;
+        if (IsLive(generation, index)) {
+            EraseAt(index);
         }
+    }
 
-        --size_;
-        const auto pageIndex{ GetPageIndex(index) };
+    // Invalid and already erased keys are skipped.
+    void EraseBatch(Span<const KeyType> keys) {
+        for (size_t i{}; i < keys.Size(); ++i) {
+            Erase(keys[i]);
+        }
+    }
 
-        auto value{ MemoryAt(index) };
-        value->~ValueType();
+    // Iterates live values in dense order, the map must not be modified during iteration.
+    template <typename F> void ForEach(F&& func) {
+        for (const auto index : live_) {
+            func(static_cast<KeyType>(EncodeKey(slots_[index].generation, index)), *MemoryAt(index));
+        }
+    }
 
-        auto& page{ pages_[pageIndex] };
-        if (--page.usedSlots == 0) {
-            page.Free();
+    template <typename F> void ForEach(F&& func) const {
+        for (const auto index : live_) {
+            func(static_cast<KeyType>(EncodeKey(slots_[index].generation, index)), static_cast<const ValueType&>(*MemoryAt(index)));
         }
+    }
 
-        if (generation < MaxGeneration) {
-            indices_[index] = 0;
-            freeList_.push_front(EncodeKey(generation + 1, index));
-        } else {
-            ++stats_.overflows;
+    // Adds pages so that `size` values fit without further growth.
+    void Reserve(size_t size) {
+        while (capacity_ < size) {
+            AddPage();
         }
     }
 
+    // Number of empty pages kept allocated instead of being freed, avoids page churn on alloc/free ping-pong.
+    void SetRetainedPages(u32 pages) {
+        retainedPages_ = pages;
+        ReleaseEmptyPages();
+    }
+
     constexpr size_t Size() const { return size_; }
+    // Slots usable without growth, retired slots are excluded.
     constexpr size_t Capacity() const { return capacity_; }
     constexpr bool Empty() const { return size_ == 0; }
 
     void Clear() {
-        for (auto& key : indices_) {
-            const auto [generation, index] = DecodeKey(key);
-            if (generation > 0) {
-                auto value{ MemoryAt(index) };
-                value->~ValueType();
-            }
+        for (const auto index : live_) {
+            MemoryAt(index)->~ValueType();
         }
 
         pages_.Clear();
-        indices_.Clear();
+        slots_.Clear();
+        live_.Clear();
         size_ = 0;
         capacity_ = 0;
-        freeList_.clear();
+        emptyPages_ = 0;
+        freeHead_ = InvalidIndex;
     }
 
     const Stats& GetStats() const { return stats_; }
 
 private:
+    struct Slot {
+        GenerationType generation{}; // With VacantBit for vacant slots.
+        IndexType next{};            // Next free slot when vacant, position in live_ otherwise.
+    };
+
     struct Page {
         IAllocator& allocator;
         void* rawMemory{};
@@ -174,6 +185,8 @@ private:
 
         ~Page() { Free(); }
 
+        bool Allocated() const { return rawMemorySize != 0; }
+
         void Allocate() {
             UGINE_ASSERT(rawMemorySize == 0);
             UGINE_ASSERT(usedSlots == 0);
@@ -200,12 +213,16 @@ private:
     }
 
     constexpr std::pair<GenerationType, IndexType> DecodeKey(InternalKeyType key) const noexcept {
-        const auto gen{ static_cast<GenerationType>((key >> 32) & MaxGeneration) };
+        const auto gen{ static_cast<GenerationType>((key >> 32) & GenerationType(-1)) };
         const auto idx{ static_cast<IndexType>(key & MaxIndex) };
 
         return std::make_pair(gen, idx);
     }
 
+    bool IsLive(GenerationType generation, IndexType index) const {
+        return generation != 0 && (generation & VacantBit) == 0 && index < slots_.Size() && slots_[index].generation == generation;
+    }
+
     ValueType* MemoryAt(IndexType index) const {
         const auto pageIndex{ GetPageIndex(index) };
         const auto pageRelativeIndex{ GetPageRelativeIndex(index) };
@@ -221,27 +238,112 @@ private:
         return index - (pageIndex * ValuesPerPage);
     }
 
+    // Takes head of the free list, marks the slot live and makes sure its page is allocated.
+    IndexType PopFree() {
+        UGINE_ASSERT(freeHead_ != InvalidIndex);
+
+        const auto index{ freeHead_ };
+        auto& slot{ slots_[index] };
+        freeHead_ = slot.next;
+
+        slot.generation &= ~VacantBit;
+        slot.next = IndexType(live_.Size());
+        live_.PushBack(index);
+        ++size_;
+
+        auto& page{ pages_[GetPageIndex(index)] };
+        if (page.usedSlots == 0) {
+            if (page.Allocated()) {
+                --emptyPages_;
+                ++stats_.pageReuses;
+            } else {
+                page.Allocate();
+            }
+        }
+        ++page.usedSlots;
+
+        return index;
+    }
+
+    void EraseAt(IndexType index) {
+        auto& slot{ slots_[index] };
+
+        MemoryAt(index)->~ValueType();
+        --size_;
+
+        // Swap remove from dense array.
+        const auto position{ slot.next };
+        const auto last{ live_.Back() };
+        live_[position] = last;
+        slots_[last].next = position;
+        live_.PopBack();
+
+        auto& page{ pages_[GetPageIndex(index)] };
+        if (--page.usedSlots == 0) {
+            if (emptyPages_ < retainedPages_) {
+                ++emptyPages_;
+            } else {
+                page.Free();
+            }
+        }
+
+        if (slot.generation < MaxGeneration) {
+            slot.generation = (slot.generation + 1) | VacantBit;
+            slot.next = freeHead_;
+            freeHead_ = index;
+        } else {
+            // Slot is retired, it isn't on the free list and doesn't count to capacity.
+            slot.generation = VacantBit;
+            --capacity_;
+            ++stats_.overflows;
+        }
+    }
+
+    void ReleaseEmptyPages() {
+        for (auto& page : pages_) {
+            if (emptyPages_ <= retainedPages_) {
+                break;
+            }
+
+            if (page.usedSlots == 0 && page.Allocated()) {
+                page.Free();
+                --emptyPages_;
+            }
+        }
+    }
+
     void AddPage() {
         const IndexType startIndex{ static_cast<IndexType>(pages_.Size() * ValuesPerPage) };
         const IndexType endIndex{ startIndex + static_cast<u32>(ValuesPerPage) };
 
-        for (auto begin{ startIndex }; begin < endIndex; ++begin) {
-            freeList_.push_back(EncodeKey(1, begin));
+        slots_.Resize(endIndex);
+
+        // New slots go in front of the free list, in index order.
+        for (auto index{ startIndex }; index < endIndex; ++index) {
+            slots_[index] = Slot{
+                .generation = 1 | VacantBit,
+                .next = index + 1 < endIndex ? index + 1 : freeHead_,
+            };
         }
+        freeHead_ = startIndex;
 
         pages_.EmplaceBack(stats_, allocator_);
-        indices_.Resize(endIndex);
+        capacity_ += ValuesPerPage;
     }
 
     AllocatorRef allocator_;
     Vector<Page> pages_;
-    Vector<InternalKeyType> indices_;
-    std::deque<InternalKeyType> freeList_;
+    Vector<Slot> slots_;
+    Vector<IndexType> live_;
+    IndexType freeHead_{ InvalidIndex };
 
     size_t size_{};
     size_t capacity_{};
 
+    u32 retainedPages_{ 1 };
+    u32 emptyPages_{};
+
     Stats stats_{};
 };
 
-} // namespace ugine
\ No newline at end of file
+} // namespace ugine
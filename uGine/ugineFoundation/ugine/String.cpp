@@ -1,4 +1,5 @@
 ﻿#include "String.h"
+#include "StringTable.h"
 
 #include <ugine/Ugine.h>
 
@@ -211,4 +212,12 @@ bool operator==(StringView a, StringView b) {
     return false;
 }
 
+StringID StringID::Intern(StringView str) {
+    return StringTable::Global().Intern(str);
+}
+
+StringView StringID::Name() const {
+    return StringTable::Global().Lookup(*this);
+}
+
 } // namespace ugine
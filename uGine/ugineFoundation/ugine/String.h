@@ -393,6 +393,12 @@ public:
     explicit constexpr StringID(StringView str) noexcept
         : hash_{ fnv1a(str.Data(), str.Size()) } {}
 
+    // Hashes and stores the string in StringTable::Global(), so Name() can return it.
+    static StringID Intern(StringView str);
+
+    // Text of interned string, empty if the string was only hashed.
+    StringView Name() const;
+
     constexpr HashType Value() const { return hash_; }
     constexpr operator HashType() const { return hash_; }
 
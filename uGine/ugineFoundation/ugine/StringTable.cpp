@@ -0,0 +1,136 @@
+#include "StringTable.h"
+
+#include <ugine/Log.h>
+
+#include <cstring>
+
+namespace ugine {
+
+StringTable& StringTable::Global() {
+    alignas(StringTable) static u8 storage[sizeof(StringTable)];
+    static auto& table{ *new (storage) StringTable{} };
+    return table;
+}
+
+StringTable::StringTable()
+    : arena_{ ARENA_BLOCK_SIZE } {
+    table_.store(NewTable(INITIAL_CAPACITY), std::memory_order_release);
+}
+
+StringID StringTable::Intern(StringView str) {
+    const StringID id{ str };
+
+    auto entry{ Find(id.Value()) };
+    if (!entry) {
+        Lock lock{ mutex_ };
+
+        // Interned by other thread meanwhile.
+        entry = Find(id.Value());
+        if (!entry) {
+            auto table{ table_.load(std::memory_order_relaxed) };
+            if ((size_ + 1) * 2 > table->capacity) {
+                Grow();
+                table = table_.load(std::memory_order_relaxed);
+            }
+
+            auto memory{ static_cast<u8*>(arena_.AlignedAlloc(sizeof(Entry) + str.Size() + 1, alignof(Entry))) };
+            auto newEntry{ new (memory) Entry{ .hash = id.Value(), .size = u32(str.Size()) } };
+            auto text{ reinterpret_cast<char*>(newEntry + 1) };
+            memcpy(text, str.Data(), str.Size());
+            text[str.Size()] = '\0';
+
+            const auto mask{ table->capacity - 1 };
+            auto index{ u32(id.Value()) & mask };
+            while (table->slots[index].load(std::memory_order_relaxed)) {
+                index = (index + 1) & mask;
+            }
+            table->slots[index].store(newEntry, std::memory_order_release);
+
+            ++size_;
+            textBytes_ += str.Size();
+            return id;
+        }
+    }
+
+#ifdef _DEBUG
+    if (entry->size != str.Size() || memcmp(entry->Text(), str.Data(), str.Size()) != 0) {
+        {
+            Lock lock{ mutex_ };
+            ++collisions_;
+        }
+
+        UGINE_ERROR("StringID collision {:#x}: '{}' and '{}'", id.Value(), entry->Text(), std::string_view{ str.Data(), str.Size() });
+        UGINE_ASSERT(false && "StringID collision");
+    }
+#endif
+
+    return id;
+}
+
+StringView StringTable::Lookup(StringID id) const {
+    const auto entry{ Find(id.Value()) };
+    return entry ? StringView{ entry->Text(), entry->size } : StringView{ "", size_t(0) };
+}
+
+StringTable::Stats StringTable::GetStats() const {
+    Lock lock{ mutex_ };
+
+    return Stats{
+        .strings = size_,
+        .capacity = table_.load(std::memory_order_relaxed)->capacity,
+        .collisions = collisions_,
+        .textBytes = textBytes_,
+        .tableBytes = tableBytes_,
+        .committed = arena_.GetStats().committed,
+    };
+}
+
+const StringTable::Entry* StringTable::Find(StringID::HashType hash) const {
+    const auto table{ table_.load(std::memory_order_acquire) };
+    const auto mask{ table->capacity - 1 };
+
+    for (auto index{ u32(hash) & mask };; index = (index + 1) & mask) {
+        const auto entry{ table->slots[index].load(std::memory_order_acquire) };
+        if (!entry || entry->hash == hash) {
+            return entry;
+        }
+    }
+}
+
+StringTable::Table* StringTable::NewTable(u32 capacity) {
+    UGINE_ASSERT((capacity & (capacity - 1)) == 0);
+
+    const auto slotsSize{ sizeof(std::atomic<const Entry*>) * capacity };
+    auto memory{ static_cast<u8*>(arena_.AlignedAlloc(sizeof(Table) + slotsSize, alignof(Table))) };
+
+    auto table{ new (memory) Table{ .capacity = capacity } };
+    table->slots = reinterpret_cast<std::atomic<const Entry*>*>(table + 1);
+    for (u32 i{}; i < capacity; ++i) {
+        new (&table->slots[i]) std::atomic<const Entry*>{ nullptr };
+    }
+
+    tableBytes_ += sizeof(Table) + slotsSize;
+    return table;
+}
+
+void StringTable::Grow() {
+    // Readers may still use the old table, it stays valid in the arena.
+    const auto table{ table_.load(std::memory_order_relaxed) };
+    auto newTable{ NewTable(table->capacity * 2) };
+
+    const auto mask{ newTable->capacity - 1 };
+    for (u32 i{}; i < table->capacity; ++i) {
+        const auto entry{ table->slots[i].load(std::memory_order_relaxed) };
+        if (entry) {
+            auto index{ u32(entry->hash) & mask };
+            while (newTable->slots[index].load(std::memory_order_relaxed)) {
+                index = (index + 1) & mask;
+            }
+            newTable->slots[index].store(entry, std::memory_order_relaxed);
+        }
+    }
+
+    table_.store(newTable, std::memory_order_release);
+}
+
+} // namespace ugine
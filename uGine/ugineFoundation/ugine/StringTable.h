@@ -0,0 +1,74 @@
+#pragma once
+
+#include <ugine/Locking.h>
+#include <ugine/Memory.h>
+#include <ugine/String.h>
+#include <ugine/Ugine.h>
+
+#include <atomic>
+
+namespace ugine {
+
+// Append only table of interned strings, maps StringID back to its text.
+// Strings are stored null terminated in an arena and never move. Lookups are lock free: open addressing table is
+// published atomically, growing builds a new table and retires the old one (kept until the table is destroyed).
+// Interning takes a lock only for strings not interned yet. Debug builds report strings with colliding hashes.
+class StringTable {
+public:
+    static constexpr u32 INITIAL_CAPACITY{ 1024 };
+    static constexpr size_t ARENA_BLOCK_SIZE{ 16 * 1024 * 1024 };
+
+    struct Stats {
+        u32 strings{};
+        u32 capacity{};
+        u32 collisions{};
+        size_t textBytes{};  // Interned characters, without terminators.
+        size_t tableBytes{}; // Current and retired tables.
+        size_t committed{};  // Arena memory.
+    };
+
+    // Never destroyed, interned names may be used by static destructors.
+    static StringTable& Global();
+
+    StringTable();
+    ~StringTable() = default;
+
+    StringTable(const StringTable&) = delete;
+    StringTable& operator=(const StringTable&) = delete;
+
+    StringID Intern(StringView str);
+
+    // Returns empty (still null terminated) view for ids which were not interned.
+    StringView Lookup(StringID id) const;
+    bool Contains(StringID id) const { return Find(id.Value()) != nullptr; }
+
+    Stats GetStats() const;
+
+private:
+    struct Entry {
+        StringID::HashType hash{};
+        u32 size{};
+
+        const char* Text() const { return reinterpret_cast<const char*>(this + 1); }
+    };
+
+    struct Table {
+        u32 capacity{};
+        std::atomic<const Entry*>* slots{};
+    };
+
+    const Entry* Find(StringID::HashType hash) const;
+    Table* NewTable(u32 capacity);
+    void Grow();
+
+    ArenaAllocator arena_;
+    std::atomic<Table*> table_{};
+
+    mutable AtomicSpinLock mutex_;
+    u32 size_{};
+    u32 collisions_{};
+    size_t textBytes_{};
+    size_t tableBytes_{};
+};
+
+} // namespace ugine
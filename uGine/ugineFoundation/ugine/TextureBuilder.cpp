@@ -0,0 +1,285 @@
+#include "TextureBuilder.h"
+
+#include "Assert.h"
+#include "Profile.h"
+#include "Scheduler.h"
+
+#define STB_DXT_IMPLEMENTATION
+#include <stb_dxt.h>
+
+#include <ktx.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <utility>
+
+namespace ugine {
+
+namespace {
+    // Bump when the output of the builder changes, cached textures are rebuilt.
+    constexpr u32 TEXTURE_BUILDER_VERSION{ 1 };
+
+    struct FormatName {
+        Image::Format format;
+        const char* name;
+    };
+
+    constexpr FormatName FORMAT_NAMES[]{
+        { Image::Format::RGBA8, "RGBA8" },
+        { Image::Format::BC1, "BC1" },
+        { Image::Format::BC3, "BC3" },
+        { Image::Format::BC5, "BC5" },
+        { Image::Format::BC7, "BC7" },
+    };
+
+    const std::array<f32, 256>& SrgbToLinearTable() {
+        static const auto table{ [] {
+            std::array<f32, 256> table{};
+            for (u32 i{}; i < 256; ++i) {
+                const auto c{ i / 255.0f };
+                table[i] = c <= 0.04045f ? c / 12.92f : std::pow((c + 0.055f) / 1.055f, 2.4f);
+            }
+            return table;
+        }() };
+        return table;
+    }
+
+    u8 LinearToSrgb(f32 c) {
+        c = c <= 0.0031308f ? c * 12.92f : 1.055f * std::pow(c, 1.0f / 2.4f) - 0.055f;
+        return u8(std::clamp(c, 0.0f, 1.0f) * 255.0f + 0.5f);
+    }
+
+    u8 ToUnorm(f32 c) {
+        return u8(std::clamp(c, 0.0f, 1.0f) * 255.0f + 0.5f);
+    }
+
+    // 2x2 box filter, odd edge texels are clamped.
+    void Downsample(Span<const u8> src, u32 srcWidth, u32 srcHeight, Span<u8> dst, u32 width, u32 height, u32 y0, u32 y1,
+        const TextureBuildSettings& settings) {
+        const auto& toLinear{ SrgbToLinearTable() };
+
+        for (u32 y{ y0 }; y < y1; ++y) {
+            const u32 rows[]{ std::min(2 * y, srcHeight - 1), std::min(2 * y + 1, srcHeight - 1) };
+
+            for (u32 x{}; x < width; ++x) {
+                const u32 cols[]{ std::min(2 * x, srcWidth - 1), std::min(2 * x + 1, srcWidth - 1) };
+
+                f32 sum[4]{};
+                for (const auto row : rows) {
+                    for (const auto col : cols) {
+                        const auto texel{ &src[(size_t(row) * srcWidth + col) * 4] };
+                        for (u32 c{}; c < 3; ++c) {
+                            if (settings.normalMap) {
+                                sum[c] += texel[c] / 255.0f * 2.0f - 1.0f;
+                            } else if (settings.srgb) {
+                                sum[c] += toLinear[texel[c]];
+                            } else {
+                                sum[c] += texel[c] / 255.0f;
+                            }
+                        }
+                        sum[3] += texel[3] / 255.0f;
+                    }
+                }
+
+                auto out{ &dst[(size_t(y) * width + x) * 4] };
+                if (settings.normalMap) {
+                    // Averaged normals get shorter, lighting expects unit ones.
+                    const auto length{ std::sqrt(sum[0] * sum[0] + sum[1] * sum[1] + sum[2] * sum[2]) };
+                    const f32 normal[]{ length > 0.0f ? sum[0] / length : 0.0f, length > 0.0f ? sum[1] / length : 0.0f,
+                        length > 0.0f ? sum[2] / length : 1.0f };
+                    for (u32 c{}; c < 3; ++c) {
+                        out[c] = ToUnorm(normal[c] * 0.5f + 0.5f);
+                    }
+                } else {
+                    for (u32 c{}; c < 3; ++c) {
+                        out[c] = settings.srgb ? LinearToSrgb(sum[c] * 0.25f) : ToUnorm(sum[c] * 0.25f);
+                    }
+                }
+                out[3] = ToUnorm(sum[3] * 0.25f);
+            }
+        }
+    }
+
+    void CompressBlocks(Span<const u8> src, u32 width, u32 height, Span<u8> dst, Image::Format format, u32 blockY0, u32 blockY1) {
+        const auto blocksX{ (width + 3) / 4 };
+        const auto blockBytes{ Image::BlockBytes(format) };
+
+        u8 rgba[16 * 4];
+        u8 rg[16 * 2];
+
+        for (u32 by{ blockY0 }; by < blockY1; ++by) {
+            for (u32 bx{}; bx < blocksX; ++bx) {
+                // Blocks over the edge repeat the last texels.
+                for (u32 i{}; i < 16; ++i) {
+                    const auto x{ std::min(bx * 4 + i % 4, width - 1) };
+                    const auto y{ std::min(by * 4 + i / 4, height - 1) };
+                    memcpy(&rgba[i * 4], &src[(size_t(y) * width + x) * 4], 4);
+                    rg[i * 2] = rgba[i * 4];
+                    rg[i * 2 + 1] = rgba[i * 4 + 1];
+                }
+
+                auto block{ &dst[(size_t(by) * blocksX + bx) * blockBytes] };
+                switch (format) {
+                case Image::Format::BC1: stb_compress_dxt_block(block, rgba, 0, STB_DXT_HIGHQUAL); break;
+                case Image::Format::BC3: stb_compress_dxt_block(block, rgba, 1, STB_DXT_HIGHQUAL); break;
+                case Image::Format::BC5: stb_compress_bc5_block(block, rg); break;
+                default: UGINE_ASSERT(false); break;
+                }
+            }
+        }
+    }
+
+    // No BC7 encoder in stb, UASTC is encoded by libktx (on its own threads) and transcoded to BC7.
+    bool CompressBC7(Image& image, const Image& source, Scheduler* scheduler) {
+        PROFILE_EVENT();
+
+        const auto texture{ source.ToKtx() };
+        if (!texture) {
+            return false;
+        }
+
+        const auto result{ [&] {
+            ktxBasisParams params{};
+            params.structSize = sizeof(params);
+            params.uastc = KTX_TRUE;
+            params.uastcFlags = KTX_PACK_UASTC_LEVEL_DEFAULT;
+            params.threadCount = scheduler ? scheduler->NumThreads() : 1;
+
+            if (ktxTexture2_CompressBasisEx(texture, &params) != KTX_SUCCESS || ktxTexture2_TranscodeBasis(texture, KTX_TTF_BC7_RGBA, 0) != KTX_SUCCESS) {
+                return false;
+            }
+
+            for (u32 mip{}; mip < image.Mips(); ++mip) {
+                for (u32 layer{}; layer < image.Layers(); ++layer) {
+                    // Cubemap layers are faces.
+                    ktx_size_t offset{};
+                    if (ktxTexture_GetImageOffset(ktxTexture(texture), mip, source.IsCubemap() ? 0 : layer, source.IsCubemap() ? layer : 0, &offset)
+                        != KTX_SUCCESS) {
+                        return false;
+                    }
+
+                    auto data{ image.GetMip(layer, mip) };
+                    memcpy(data.Data(), ktxTexture_GetData(ktxTexture(texture)) + offset, data.Size());
+                }
+            }
+
+            return true;
+        }() };
+
+        ktxTexture_Destroy(ktxTexture(texture));
+        return result;
+    }
+} // namespace
+
+const char* ToString(Image::Format format) {
+    for (const auto& [value, name] : FORMAT_NAMES) {
+        if (value == format) {
+            return name;
+        }
+    }
+    return "Unknown";
+}
+
+bool FormatFromString(std::string_view name, Image::Format& format) {
+    for (const auto& [value, formatName] : FORMAT_NAMES) {
+        if (name == formatName) {
+            format = value;
+            return true;
+        }
+    }
+    return false;
+}
+
+u32 FullMipCount(u32 width, u32 height) {
+    return u32(std::floor(std::log2(std::max(width, height)))) + 1;
+}
+
+bool GenerateMips(Image& image, const TextureBuildSettings& settings, Scheduler* scheduler) {
+    PROFILE_EVENT();
+
+    if (image.IsCompressed() || image.PixelSize() != 4 || image.BaseMip() != 0) {
+        return false;
+    }
+
+    // Mip 0 is kept, storage of the rest is reallocated.
+    Vector<Vector<u8>> base;
+    for (u32 layer{}; layer < image.Layers(); ++layer) {
+        base.PushBack(Vector<u8>{ image.GetLayer(layer) });
+    }
+
+    const auto mips{ settings.mips ? FullMipCount(image.Width(), image.Height()) : 1 };
+    image.Allocate(Image::Format::RGBA8, mips);
+
+    for (u32 layer{}; layer < image.Layers(); ++layer) {
+        auto data{ image.GetMip(layer, 0) };
+        memcpy(data.Data(), base[layer].Data(), data.Size());
+
+        for (u32 mip{ 1 }; mip < mips; ++mip) {
+            const auto src{ std::as_const(image).GetMip(layer, mip - 1) };
+            auto dst{ image.GetMip(layer, mip) };
+
+            const auto downsample{ [&](u32 start, u32 end) {
+                Downsample(src, image.MipWidth(mip - 1), image.MipHeight(mip - 1), dst, image.MipWidth(mip), image.MipHeight(mip), start, end, settings);
+            } };
+            if (scheduler) {
+                scheduler->ParallelFor(image.MipHeight(mip), downsample);
+            } else {
+                downsample(0, image.MipHeight(mip));
+            }
+        }
+    }
+
+    return true;
+}
+
+bool CompressImage(Image& image, Image::Format format, Scheduler* scheduler) {
+    PROFILE_EVENT();
+
+    if (image.IsCompressed() || image.PixelSize() != 4) {
+        return false;
+    }
+
+    if (format == Image::Format::RGBA8) {
+        return true;
+    }
+
+    const Image source{ image };
+    image.Allocate(format, source.Mips());
+
+    if (format == Image::Format::BC7) {
+        return CompressBC7(image, source, scheduler);
+    }
+
+    for (u32 mip{}; mip < source.Mips(); ++mip) {
+        for (u32 layer{}; layer < source.Layers(); ++layer) {
+            const auto src{ source.GetMip(layer, mip) };
+            auto dst{ image.GetMip(layer, mip) };
+
+            const auto width{ source.MipWidth(mip) };
+            const auto height{ source.MipHeight(mip) };
+
+            const auto compress{ [&](u32 start, u32 end) { CompressBlocks(src, width, height, dst, format, start, end); } };
+            if (scheduler) {
+                scheduler->ParallelFor((height + 3) / 4, compress);
+            } else {
+                compress(0, (height + 3) / 4);
+            }
+        }
+    }
+
+    return true;
+}
+
+bool BuildTexture(Image& image, const TextureBuildSettings& settings, Scheduler* scheduler) {
+    return GenerateMips(image, settings, scheduler) && CompressImage(image, settings.format, scheduler);
+}
+
+DerivedDataCache::KeyBuilder TextureCacheKey(const TextureBuildSettings& settings) {
+    DerivedDataCache::KeyBuilder key{ "texture", TEXTURE_BUILDER_VERSION };
+    key.AddValue(settings.format).AddValue(settings.mips).AddValue(settings.srgb).AddValue(settings.normalMap);
+    return key;
+}
+
+} // namespace ugine
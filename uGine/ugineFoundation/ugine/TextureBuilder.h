@@ -0,0 +1,38 @@
+#pragma once
+
+#include <ugine/DerivedDataCache.h>
+#include <ugine/Image.h>
+#include <ugine/Ugine.h>
+
+#include <string_view>
+
+namespace ugine {
+
+class Scheduler;
+
+// Offline processing of imported textures: mip chain and block compression. Work is split over scheduler workers when
+// one is given, otherwise it runs on the calling thread.
+struct TextureBuildSettings {
+    Image::Format format{ Image::Format::RGBA8 };
+    bool mips{ true };
+    bool srgb{ true };      // Color data, mips are filtered in linear space and stored encoded again.
+    bool normalMap{};       // Mips are renormalized, BC5 keeps xy only and z is reconstructed by shaders.
+};
+
+const char* ToString(Image::Format format);
+bool FormatFromString(std::string_view name, Image::Format& format);
+
+u32 FullMipCount(u32 width, u32 height);
+
+// Replaces mips of RGBA8 image with chain generated from mip 0.
+bool GenerateMips(Image& image, const TextureBuildSettings& settings, Scheduler* scheduler = nullptr);
+
+// Compresses all mips of RGBA8 image.
+bool CompressImage(Image& image, Image::Format format, Scheduler* scheduler = nullptr);
+
+bool BuildTexture(Image& image, const TextureBuildSettings& settings, Scheduler* scheduler = nullptr);
+
+// Cache key of texture built with given settings, callers add content of the sources.
+DerivedDataCache::KeyBuilder TextureCacheKey(const TextureBuildSettings& settings);
+
+} // namespace ugine
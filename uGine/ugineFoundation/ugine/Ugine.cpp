@@ -1,5 +1,7 @@
 #include "Ugine.h"
 
+#include <ugine/Log.h>
+
 #include <Windows.h>
 
 namespace ugine {
@@ -10,4 +12,9 @@ void Break() {
     }
 }
 
+void AssertFailed(const char* expression, const char* file, int line) {
+    UGINE_ERROR("Assertion failed: {} ({}:{})", expression, file, line);
+    FlushLoggerOnCrash();
+}
+
 } // namespace ugine
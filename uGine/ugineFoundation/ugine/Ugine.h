@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cassert>
+#include <cstddef>
 
 #include <stdint.h>
 
@@ -19,8 +20,15 @@ using f64 = double;
 
 static constexpr u32 UGINE_MIN_THREADS{ 4 };
 static constexpr u32 UGINE_MAX_THREADS{ 32 };
+static constexpr size_t UGINE_CACHE_LINE_SIZE{ 64 };
 
-#define UGINE_ASSERT(x) assert(x)
+#ifdef NDEBUG
+#define UGINE_ASSERT(x) ((void)0)
+#else
+// Same as assert, failure is logged and buffered log records written before CRT reports it.
+#define UGINE_ASSERT(x)                                                                                                                                        \
+    (void)((!!(x)) || (::ugine::AssertFailed(#x, __FILE__, __LINE__), _wassert(_CRT_WIDE(#x), _CRT_WIDE(__FILE__), unsigned(__LINE__)), 0))
+#endif
 #define UGINE_FATAL(msg) abort()
 
 #ifdef _DEBUG
@@ -37,4 +45,5 @@ static_assert(false, "Platform not implemented");
 
 namespace ugine {
 void Break();
+void AssertFailed(const char* expression, const char* file, int line);
 }
\ No newline at end of file
@@ -125,6 +125,15 @@ public:
     [[nodiscard]] BufferHandle CreateIndexBuffer(ugine::ArrayProxy<u16> indices) { return CreateIndexBuffer(indices.data(), 2 * indices.size()); }
     [[nodiscard]] BufferHandle CreateIndexBuffer(ugine::ArrayProxy<u32> indices) { return CreateIndexBuffer(indices.data(), 4 * indices.size()); }
 
+    // Uploads. Data is copied before return, resource must not be used by GPU before the ticket completes. Copies are
+    // batched and submitted by FlushUploads, at most budget bytes per call (always at least one upload). Texture data is
+    // one subresource per layer of mip 0 (rest is generated if desc.generateMips) or per layer of each mip, mip major.
+    [[nodiscard]] virtual UploadTicket UploadBuffer(BufferHandle buffer, const void* data, size_t size, size_t offset = 0) = 0;
+    [[nodiscard]] virtual UploadTicket UploadTexture(TextureHandle texture, TextureLayout finalLayout, ugine::ArrayProxy<SubresourceData> data) = 0;
+    [[nodiscard]] virtual bool IsUploadComplete(UploadTicket ticket) = 0;
+    virtual void FlushUploads(u64 budget) = 0;
+    [[nodiscard]] virtual UploadStats GetUploadStats() const = 0;
+
     virtual void DestroySemaphore(SemaphoreHandle handle) = 0;
     virtual void DestroyFence(FenceHandle handle) = 0;
 
@@ -99,6 +99,10 @@ NLOHMANN_JSON_SERIALIZE_ENUM(Format,
         { Format::R16G16B16A16_Float, "R16G16B16A16_Float" },
         { Format::D24_Unorm_S8_Uint, "D24_Unorm_S8_Uint" },
         { Format::D32_Float, "D32_Float" },
+        { Format::BC1_Unorm, "BC1_Unorm" },
+        { Format::BC3_Unorm, "BC3_Unorm" },
+        { Format::BC5_Unorm, "BC5_Unorm" },
+        { Format::BC7_Unorm, "BC7_Unorm" },
         { Format::COUNT, "COUNT" },
     });
 NLOHMANN_JSON_SERIALIZE_ENUM(ComparisonFunc,
@@ -144,6 +144,10 @@ enum class Format : u8 {
     D16_Unorm_S8_Uint,
     D16_Unorm,
     D32_Float_S8_Uint,
+    BC1_Unorm,
+    BC3_Unorm,
+    BC5_Unorm,
+    BC7_Unorm,
 
     COUNT,
 };
@@ -574,6 +578,18 @@ struct BufferCopy {
     u64 size{};
 };
 
+// Asynchronous upload, complete once ticket is done. Zero ticket is always complete.
+using UploadTicket = u64;
+
+struct UploadStats {
+    u64 pendingBytes{};   // Waiting for budget.
+    u64 inFlightBytes{};  // Submitted, not finished.
+    u64 submittedBytes{}; // Last FlushUploads.
+    u32 pending{};
+    u32 inFlight{};
+    u32 batchesInFlight{};
+};
+
 //struct BufferViewDesc {
 //    BufferHandle buffer{};
 //    Format format{};
@@ -27,6 +27,7 @@ public:
         std::string entryPoint;
         std::filesystem::path sourceFile;
         bool preprocess{ true };
+        bool preprocessOnly{}; // Stops after preprocessing, output is Preprocessed().
         bool warningsAsErrors{};
         bool debugInfo{};
         Optimization optimizationLevel{};
@@ -88,6 +88,10 @@ public:
             //UGINE_DEBUG("PREPROCESSED: {}", preprocessed_);
         }
 
+        if (options.preprocessOnly) {
+            return true;
+        }
+
         const auto result{ compiler_.CompileGlslToSpv(preprocessed_, kind, fileName.string().c_str(), options.entryPoint.c_str(), options_) };
 
         if (result.GetNumErrors()) {
@@ -9,6 +9,7 @@
 
 #include <filesystem>
 #include <iostream>
+#include <mutex>
 #include <regex>
 
 namespace ugine::gfxapi {
@@ -29,6 +30,7 @@ public:
 class CustomIncludeHandler : public IDxcIncludeHandler {
 public:
     inline static DxcUtils Utils{};
+    inline static std::mutex UtilsMutex{}; // Compilers of separate threads share the utils.
 
     CustomIncludeHandler(const std::filesystem::path& shaderPath, const std::vector<std::filesystem::path>& systemDirs)
         : shaderPath_{ shaderPath }
@@ -54,6 +56,7 @@ public:
 
         // Return empty string blob if this file has been included before
         Microsoft::WRL::ComPtr<IDxcBlobEncoding> pEncoding;
+        std::unique_lock lock{ UtilsMutex };
         HRESULT hr = Utils.pUtils->LoadFile(can.c_str(), nullptr, &pEncoding);
         if (SUCCEEDED(hr)) {
             *ppIncludeSource = pEncoding.Detach();
@@ -224,6 +227,10 @@ public:
             preprocessed_ = options.source;
         }
 
+        if (options.preprocessOnly) {
+            return true;
+        }
+
         auto pCompileResult{ Run(dxcCompiler.Get(), {}, options) };
         if (!pCompileResult) {
             return false;
@@ -253,6 +253,10 @@ Format FromVulkan(vk::Format format) {
         { vk::Format::eD16UnormS8Uint, Format::D16_Unorm_S8_Uint },
         { vk::Format::eD16Unorm, Format::D16_Unorm },
         { vk::Format::eD32SfloatS8Uint, Format::D32_Float_S8_Uint },
+        { vk::Format::eBc1RgbaUnormBlock, Format::BC1_Unorm },
+        { vk::Format::eBc3UnormBlock, Format::BC3_Unorm },
+        { vk::Format::eBc5UnormBlock, Format::BC5_Unorm },
+        { vk::Format::eBc7UnormBlock, Format::BC7_Unorm },
 
     };
 
@@ -288,6 +292,10 @@ vk::Format ToVulkan(Format format) {
         { Format::D16_Unorm_S8_Uint, vk::Format::eD16UnormS8Uint },
         { Format::D16_Unorm, vk::Format::eD16Unorm },
         { Format::D32_Float_S8_Uint, vk::Format::eD32SfloatS8Uint },
+        { Format::BC1_Unorm, vk::Format::eBc1RgbaUnormBlock },
+        { Format::BC3_Unorm, vk::Format::eBc3UnormBlock },
+        { Format::BC5_Unorm, vk::Format::eBc5UnormBlock },
+        { Format::BC7_Unorm, vk::Format::eBc7UnormBlock },
     };
 
     // TODO: Static assert.
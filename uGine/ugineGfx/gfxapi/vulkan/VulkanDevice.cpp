@@ -3,6 +3,7 @@
 #include "VulkanInitializers.h"
 #include "VulkanInstance.h"
 #include "VulkanSwapchain.h"
+#include "VulkanUploadQueue.h"
 
 #include <gfxapi/Error.h>
 #include <gfxapi/Swapchain.h>
@@ -260,6 +261,8 @@ VulkanDevice::VulkanDevice(const DeviceCreateInfo& info, IAllocator& allocator)
     InitBindings();
     InitBindless();
 
+    uploads_ = MakeUnique<VulkanUploadQueue>(allocator_, *this, allocator_);
+
     const std::vector<Format> depthFormatCandidates{
         Format::D32_Float,
         Format::D24_Unorm_S8_Uint,
@@ -295,6 +298,7 @@ VulkanDevice::~VulkanDevice() {
 
     WaitIdle();
 
+    uploads_ = nullptr;
     swapchain_ = nullptr;
 
     imguiDescriptorPool_ = {};
@@ -953,7 +957,8 @@ BufferHandle VulkanDevice::CreateBuffer(const BufferDesc& desc, const void* init
         usage |= vk::BufferUsageFlagBits::eIndirectBuffer;
     }
 
-    if (initialData) {
+    // Device local buffers may be filled by upload queue later.
+    if (initialData || desc.cpuAccess == CpuAccessFlags::None) {
         usage |= vk::BufferUsageFlagBits::eTransferDst;
     }
 
@@ -975,6 +980,10 @@ void VulkanDevice::DestroyBuffer(BufferHandle handle) {
     UGINE_ASSERT(handle);
     UGINE_ASSERT(storage_->GetBuffer(handle));
 
+    if (uploads_) {
+        uploads_->Cancel(handle);
+    }
+
     perFrameGraveyard_[ActiveFrame()].buffers.push_back(handle);
 }
 
@@ -1100,6 +1109,10 @@ void VulkanDevice::DestroyTexture(TextureHandle handle) {
     UGINE_ASSERT(handle);
     UGINE_ASSERT(storage_->GetTexture(handle)->vkImage);
 
+    if (uploads_) {
+        uploads_->Cancel(handle);
+    }
+
     perFrameGraveyard_[ActiveFrame()].textures.push_back(handle);
 }
 
@@ -1259,6 +1272,26 @@ BufferHandle VulkanDevice::CreateIndexBuffer(const void* indices, size_t indices
     return indexBufferHandle;
 }
 
+UploadTicket VulkanDevice::UploadBuffer(BufferHandle buffer, const void* data, size_t size, size_t offset) {
+    return uploads_->UploadBuffer(buffer, data, size, offset);
+}
+
+UploadTicket VulkanDevice::UploadTexture(TextureHandle texture, TextureLayout finalLayout, ArrayProxy<SubresourceData> data) {
+    return uploads_->UploadTexture(texture, finalLayout, data);
+}
+
+bool VulkanDevice::IsUploadComplete(UploadTicket ticket) {
+    return uploads_->IsComplete(ticket);
+}
+
+void VulkanDevice::FlushUploads(u64 budget) {
+    uploads_->Flush(budget);
+}
+
+UploadStats VulkanDevice::GetUploadStats() const {
+    return uploads_->GetStats();
+}
+
 VulkanBuffer VulkanDevice::CopyBufferData(vk::CommandBuffer cmd, VulkanBuffer& dstBuffer, const void* srcData, vk::DeviceSize size, vk::DeviceSize offset) {
     UGINE_ASSERT(dstBuffer.size >= size);
 
@@ -26,6 +26,7 @@ struct ShaderParsedData;
 class VulkanInstance;
 class VulkanSwapchain;
 class VulkanBindlessPool;
+class VulkanUploadQueue;
 
 struct ParsedShaderInfo {
     vk::PipelineLayout pipelineLayout;
@@ -79,6 +80,8 @@ public:
     [[nodiscard]] vk::Device GetDevice() const { return device_; }
     [[nodiscard]] const QueueFamilies& GetQueues() const { return queueFamilies_; }
     [[nodiscard]] vk::Queue GetPresentQueue() const { return presentQueue_; }
+    [[nodiscard]] vk::Queue GetGraphicsQueue() const { return graphicsQueue_; }
+    [[nodiscard]] vk::Queue GetTransferQueue() const { return transferQueue_; } // Null without dedicated transfer queue.
     [[nodiscard]] SemaphoreHandle CreateSemaphore(const vk::SemaphoreCreateInfo& info);
 
     template <typename... Args> [[nodiscard]] SemaphoreHandleUnique CreateSemaphoreUnique(Args&&... args) {
@@ -169,6 +172,12 @@ public:
     BufferHandle CreateIndexBuffer(const void* indices, size_t size) override;
     BufferHandle CreateVertexBuffer(const void* data, size_t elementSize, size_t elementCount) override;
 
+    UploadTicket UploadBuffer(BufferHandle buffer, const void* data, size_t size, size_t offset) override;
+    UploadTicket UploadTexture(TextureHandle texture, TextureLayout finalLayout, ArrayProxy<SubresourceData> data) override;
+    bool IsUploadComplete(UploadTicket ticket) override;
+    void FlushUploads(u64 budget) override;
+    UploadStats GetUploadStats() const override;
+
     void DestroySemaphore(SemaphoreHandle handle) override;
     void DestroyFence(FenceHandle handle) override;
 
@@ -282,6 +291,9 @@ private:
     UniquePtr<VulkanBindlessPool> bindlessSamplers_;
     //UniquePtr<VulkanBindlessPool> bindlessBuffers_;
 
+    // Streaming uploads.
+    UniquePtr<VulkanUploadQueue> uploads_;
+
     // TODO:
     vk::UniqueDescriptorPool imguiDescriptorPool_;
 
@@ -0,0 +1,587 @@
+#include "VulkanUploadQueue.h"
+#include "VulkanDevice.h"
+
+#include <ugine/Align.h>
+#include <ugine/Metrics.h>
+#include <ugine/Profile.h>
+
+#include <algorithm>
+
+namespace ugine::gfxapi {
+
+VulkanUploadQueue::VulkanUploadQueue(VulkanDevice& device, IAllocator& allocator)
+    : device_{ device }
+    , allocator_{ allocator }
+    , pending_{ allocator }
+    , inFlight_{ allocator }
+    , requests_{ allocator }
+    , freeRequests_{ allocator }
+    , batches_{ allocator }
+    , freeBatches_{ allocator } {
+
+    const auto& queues{ device_.GetQueues() };
+    graphicsFamily_ = queues.graphics;
+    transferFamily_ = queues.transfer;
+    graphicsQueue_ = device_.GetGraphicsQueue();
+    transferQueue_ = device_.GetTransferQueue();
+    async_ = bool(transferQueue_);
+
+    graphicsPool_ = device_.GetDevice().createCommandPoolUnique(vk::CommandPoolCreateInfo{
+        .flags = vk::CommandPoolCreateFlagBits::eResetCommandBuffer,
+        .queueFamilyIndex = graphicsFamily_,
+    });
+
+    if (async_) {
+        transferPool_ = device_.GetDevice().createCommandPoolUnique(vk::CommandPoolCreateInfo{
+            .flags = vk::CommandPoolCreateFlagBits::eResetCommandBuffer,
+            .queueFamilyIndex = transferFamily_,
+        });
+    }
+
+    alignment_ = std::max<u64>(16, device_.Properties().limits.optimalBufferCopyOffsetAlignment);
+
+    ring_ = device_.CreateBuffer(
+        RING_SIZE, vk::BufferUsageFlagBits::eTransferSrc, vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent);
+    device_.SetDebugName(ring_.vkBuffer, "UploadRing");
+}
+
+VulkanUploadQueue::~VulkanUploadQueue() {
+    auto vkDevice{ device_.GetDevice() };
+
+    for (auto batch : inFlight_) {
+        const vk::Fence fences[]{ batch->state == Batch::State::Copying ? batch->copyFence : batch->finishFence };
+        auto result{ vkDevice.waitForFences(fences, VK_TRUE, UINT64_MAX) };
+
+        for (auto& staging : batch->staging) {
+            device_.DestroyBuffer(std::move(staging));
+        }
+    }
+
+    for (auto& batch : batches_) {
+        vkDevice.destroyFence(batch->copyFence);
+        vkDevice.destroyFence(batch->finishFence);
+    }
+
+    device_.DestroyBuffer(std::move(ring_));
+}
+
+UploadTicket VulkanUploadQueue::UploadBuffer(BufferHandle buffer, const void* data, size_t size, size_t offset) {
+    UGINE_ASSERT(buffer);
+    UGINE_ASSERT(data && size > 0);
+
+    auto request{ AcquireRequest() };
+    request->buffer = buffer;
+    request->dstOffset = offset;
+
+    const SubresourceData subresource{ .data = data, .size = size };
+    return Enqueue(request, subresource);
+}
+
+UploadTicket VulkanUploadQueue::UploadTexture(TextureHandle texture, TextureLayout finalLayout, ArrayProxy<SubresourceData> data) {
+    UGINE_ASSERT(texture);
+    UGINE_ASSERT(!data.empty());
+
+    auto request{ AcquireRequest() };
+    request->texture = texture;
+    request->finalLayout = finalLayout;
+
+    return Enqueue(request, data);
+}
+
+void VulkanUploadQueue::Flush(u64 budget) {
+    PROFILE_EVENT_N("Flush uploads");
+
+    Retire();
+
+    submittedBytes_ = 0;
+    if (!pending_.Empty()) {
+        Submit(budget);
+    }
+
+    UGINE_GAUGE_SET("gfx.upload.pending", pending_.Size());
+    UGINE_GAUGE_SET("gfx.upload.batchesInFlight", inFlight_.Size());
+}
+
+void VulkanUploadQueue::Cancel(BufferHandle buffer) {
+    CancelIf([buffer](const Request* request) { return request->buffer == buffer; });
+}
+
+void VulkanUploadQueue::Cancel(TextureHandle texture) {
+    CancelIf([texture](const Request* request) { return request->texture == texture; });
+}
+
+UploadStats VulkanUploadQueue::GetStats() const {
+    UploadStats stats{
+        .submittedBytes = submittedBytes_,
+        .pending = u32(pending_.Size()),
+        .batchesInFlight = u32(inFlight_.Size()),
+    };
+
+    for (const auto request : pending_) {
+        stats.pendingBytes += request->size;
+    }
+
+    for (const auto batch : inFlight_) {
+        stats.inFlightBytes += batch->bytes;
+        stats.inFlight += u32(batch->requests.Size());
+    }
+
+    return stats;
+}
+
+UploadTicket VulkanUploadQueue::Enqueue(Request* request, ArrayProxy<SubresourceData> data) {
+    request->size = 0;
+    for (const auto& subresource : data) {
+        request->layers.PushBack(subresource.size);
+        request->size += subresource.size;
+    }
+
+    // Ring is released in batch order, once something waits on heap everything else does too.
+    u8* dst{};
+    if (heapPending_ == 0 && Allocate(request->size, request->ringStart)) {
+        request->inRing = true;
+        dst = static_cast<u8*>(ring_.mappedData) + request->ringStart % RING_SIZE;
+    } else {
+        request->data.Resize(request->size);
+        dst = request->data.Data();
+        ++heapPending_;
+    }
+
+    for (const auto& subresource : data) {
+        memcpy(dst, subresource.data, subresource.size);
+        dst += subresource.size;
+    }
+
+    request->ticket = ++counter_;
+    request->submitted = Clock::now();
+    pending_.PushBack(request);
+
+    UGINE_COUNTER_ADD("gfx.upload.bytes", request->size);
+
+    return request->ticket;
+}
+
+bool VulkanUploadQueue::Allocate(u64 size, u64& start) {
+    if (size > RING_SIZE) {
+        return false;
+    }
+
+    start = AlignTo(head_, alignment_);
+    if (start % RING_SIZE + size > RING_SIZE) {
+        // Doesn't fit before the end, skipped space is released with this allocation.
+        start = AlignTo(start, RING_SIZE);
+    }
+
+    if (start + size - tail_ > RING_SIZE) {
+        return false;
+    }
+
+    head_ = start + size;
+    return true;
+}
+
+bool VulkanUploadQueue::Stage(Request* request, Batch& batch) {
+    if (!request->inRing) {
+        if (request->size > RING_SIZE) {
+            auto staging{ device_.CreateBuffer(request->size, vk::BufferUsageFlagBits::eTransferSrc,
+                vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent) };
+            memcpy(staging.mappedData, request->data.Data(), request->size);
+
+            request->src = staging.vkBuffer;
+            request->srcOffset = 0;
+            batch.staging.PushBack(staging);
+        } else if (Allocate(request->size, request->ringStart)) {
+            memcpy(static_cast<u8*>(ring_.mappedData) + request->ringStart % RING_SIZE, request->data.Data(), request->size);
+            request->inRing = true;
+        } else {
+            // Wait for batches in flight to release the ring.
+            return false;
+        }
+
+        Vector<u8> data{ allocator_ };
+        request->data.Swap(data);
+        --heapPending_;
+    }
+
+    if (request->inRing) {
+        request->src = ring_.vkBuffer;
+        request->srcOffset = request->ringStart % RING_SIZE;
+        batch.ringEnd = request->ringStart + request->size;
+    }
+
+    return true;
+}
+
+void VulkanUploadQueue::Retire() {
+    auto vkDevice{ device_.GetDevice() };
+
+    // Finished copies move to graphics queue in order, copies don't overtake each other on single queue.
+    for (auto batch : inFlight_) {
+        if (batch->state != Batch::State::Copying) {
+            continue;
+        }
+        if (vkDevice.getFenceStatus(batch->copyFence) != vk::Result::eSuccess) {
+            break;
+        }
+
+        tail_ = std::max(tail_, batch->ringEnd);
+        SubmitFinish(*batch);
+    }
+
+    u32 retired{};
+    for (; retired < inFlight_.Size(); ++retired) {
+        auto batch{ inFlight_[retired] };
+        if (batch->state != Batch::State::Finishing || vkDevice.getFenceStatus(batch->finishFence) != vk::Result::eSuccess) {
+            break;
+        }
+
+        Complete(batch);
+    }
+
+    inFlight_.EraseFront(retired);
+}
+
+void VulkanUploadQueue::Submit(u64 budget) {
+    auto batch{ AcquireBatch() };
+
+    u32 count{};
+    while (count < pending_.Size() && (count == 0 || batch->bytes < budget)) {
+        auto request{ pending_[count] };
+        if (!Stage(request, *batch)) {
+            break;
+        }
+
+        batch->requests.PushBack(request);
+        batch->bytes += request->size;
+        ++count;
+    }
+
+    pending_.EraseFront(count);
+
+    if (batch->requests.Empty()) {
+        freeBatches_.PushBack(batch);
+        return;
+    }
+
+    batch->last = batch->requests.Back()->ticket;
+    submittedBytes_ = batch->bytes;
+
+    if (async_) {
+        batch->copy.begin(vk::CommandBufferBeginInfo{ .flags = vk::CommandBufferUsageFlagBits::eOneTimeSubmit });
+        RecordCopies(batch->copy, *batch);
+        RecordOwnership(batch->copy, *batch, true);
+        batch->copy.end();
+
+        device_.GetDevice().resetFences(batch->copyFence);
+        transferQueue_.submit(
+            vk::SubmitInfo{
+                .commandBufferCount = 1,
+                .pCommandBuffers = &batch->copy,
+            },
+            batch->copyFence);
+
+        batch->state = Batch::State::Copying;
+    } else {
+        batch->finish.begin(vk::CommandBufferBeginInfo{ .flags = vk::CommandBufferUsageFlagBits::eOneTimeSubmit });
+        RecordCopies(batch->finish, *batch);
+        RecordFinish(batch->finish, *batch);
+        batch->finish.end();
+
+        device_.GetDevice().resetFences(batch->finishFence);
+        graphicsQueue_.submit(
+            vk::SubmitInfo{
+                .commandBufferCount = 1,
+                .pCommandBuffers = &batch->finish,
+            },
+            batch->finishFence);
+
+        batch->state = Batch::State::Finishing;
+    }
+
+    inFlight_.PushBack(batch);
+}
+
+void VulkanUploadQueue::RecordCopies(vk::CommandBuffer cmd, Batch& batch) {
+    PROFILE_EVENT_N("Record uploads");
+
+    auto& storage{ device_.GetStorage() };
+
+    Vector<vk::BufferImageCopy> regions{ allocator_ };
+
+    for (auto request : batch.requests) {
+        if (request->buffer) {
+            auto buffer{ storage.GetBuffer(request->buffer) };
+            UGINE_ASSERT(buffer);
+            UGINE_ASSERT(request->dstOffset + request->size <= buffer->size);
+
+            cmd.copyBuffer(request->src, buffer->vkBuffer,
+                vk::BufferCopy{
+                    .srcOffset = request->srcOffset,
+                    .dstOffset = request->dstOffset,
+                    .size = request->size,
+                });
+        } else if (request->texture) {
+            auto image{ storage.GetTexture(request->texture) };
+            UGINE_ASSERT(image);
+
+            // Subresources are mip major, partial mip 0 upload may skip trailing layers.
+            const auto& desc{ image->desc };
+            const auto layers{ std::min<u32>(u32(request->layers.Size()), desc.arrayLayers) };
+            UGINE_ASSERT(request->layers.Size() % layers == 0);
+            UGINE_ASSERT(request->layers.Size() / layers <= desc.mipLevels);
+
+            regions.Resize(request->layers.Size());
+            u64 offset{ request->srcOffset };
+            for (u32 i{}; i < regions.Size(); ++i) {
+                const auto mip{ i / layers };
+                regions[i] = vk::BufferImageCopy{
+                    .bufferOffset = offset,
+                    .bufferRowLength = 0,
+                    .bufferImageHeight = 0,
+                    .imageSubresource = {
+                        .aspectMask = vk::ImageAspectFlagBits::eColor,
+                        .mipLevel = mip,
+                        .baseArrayLayer = i % layers,
+                        .layerCount = 1,
+                    },
+                    .imageExtent = vk::Extent3D{ std::max(desc.extent.width >> mip, 1u), std::max(desc.extent.height >> mip, 1u), 1 },
+                };
+                offset += request->layers[i];
+            }
+
+            device_.Transition(cmd, *image, vk::ImageLayout::eUndefined, vk::ImageLayout::eTransferDstOptimal);
+            cmd.copyBufferToImage(request->src, image->vkImage, vk::ImageLayout::eTransferDstOptimal, u32(regions.Size()), regions.Data());
+        }
+    }
+}
+
+void VulkanUploadQueue::RecordOwnership(vk::CommandBuffer cmd, Batch& batch, bool release) {
+    auto& storage{ device_.GetStorage() };
+
+    Vector<vk::BufferMemoryBarrier2> bufferBarriers{ allocator_ };
+    Vector<vk::ImageMemoryBarrier2> imageBarriers{ allocator_ };
+
+    // Release on transfer queue and acquire on graphics queue have to match, stages of the other queue are ignored.
+    const vk::PipelineStageFlags2 srcStage{ release ? vk::PipelineStageFlagBits2::eTransfer : vk::PipelineStageFlagBits2::eNone };
+    const vk::AccessFlags2 srcAccess{ release ? vk::AccessFlagBits2::eTransferWrite : vk::AccessFlagBits2::eNone };
+    const vk::PipelineStageFlags2 dstStage{ release ? vk::PipelineStageFlagBits2::eNone : vk::PipelineStageFlagBits2::eAllCommands };
+    const vk::AccessFlags2 dstAccess{ release ? vk::AccessFlags2{} : vk::AccessFlagBits2::eMemoryRead | vk::AccessFlagBits2::eTransferWrite };
+
+    for (auto request : batch.requests) {
+        if (request->buffer) {
+            auto buffer{ storage.GetBuffer(request->buffer) };
+            UGINE_ASSERT(buffer);
+
+            bufferBarriers.PushBack(vk::BufferMemoryBarrier2{
+                .srcStageMask = srcStage,
+                .srcAccessMask = srcAccess,
+                .dstStageMask = dstStage,
+                .dstAccessMask = dstAccess,
+                .srcQueueFamilyIndex = transferFamily_,
+                .dstQueueFamilyIndex = graphicsFamily_,
+                .buffer = buffer->vkBuffer,
+                .offset = 0,
+                .size = VK_WHOLE_SIZE,
+            });
+        } else if (request->texture) {
+            auto image{ storage.GetTexture(request->texture) };
+            UGINE_ASSERT(image);
+
+            imageBarriers.PushBack(vk::ImageMemoryBarrier2{
+                .srcStageMask = srcStage,
+                .srcAccessMask = srcAccess,
+                .dstStageMask = dstStage,
+                .dstAccessMask = dstAccess,
+                .oldLayout = vk::ImageLayout::eTransferDstOptimal,
+                .newLayout = vk::ImageLayout::eTransferDstOptimal,
+                .srcQueueFamilyIndex = transferFamily_,
+                .dstQueueFamilyIndex = graphicsFamily_,
+                .image = image->vkImage,
+                .subresourceRange = {
+                    .aspectMask = image->vkAspect,
+                    .baseMipLevel = 0,
+                    .levelCount = image->desc.mipLevels,
+                    .baseArrayLayer = 0,
+                    .layerCount = image->desc.arrayLayers,
+                },
+            });
+        }
+    }
+
+    if (bufferBarriers.Empty() && imageBarriers.Empty()) {
+        return;
+    }
+
+    cmd.pipelineBarrier2(vk::DependencyInfo{
+        .bufferMemoryBarrierCount = u32(bufferBarriers.Size()),
+        .pBufferMemoryBarriers = bufferBarriers.Data(),
+        .imageMemoryBarrierCount = u32(imageBarriers.Size()),
+        .pImageMemoryBarriers = imageBarriers.Data(),
+    });
+}
+
+void VulkanUploadQueue::RecordFinish(vk::CommandBuffer cmd, Batch& batch) {
+    auto& storage{ device_.GetStorage() };
+
+    // Buffer copies are visible to everything submitted later on graphics queue.
+    const vk::MemoryBarrier2 barrier{
+        .srcStageMask = vk::PipelineStageFlagBits2::eTransfer,
+        .srcAccessMask = vk::AccessFlagBits2::eTransferWrite,
+        .dstStageMask = vk::PipelineStageFlagBits2::eAllCommands,
+        .dstAccessMask = vk::AccessFlagBits2::eMemoryRead,
+    };
+
+    cmd.pipelineBarrier2(vk::DependencyInfo{
+        .memoryBarrierCount = 1,
+        .pMemoryBarriers = &barrier,
+    });
+
+    for (auto request : batch.requests) {
+        if (!request->texture) {
+            continue;
+        }
+
+        auto image{ storage.GetTexture(request->texture) };
+        UGINE_ASSERT(image);
+
+        const auto& desc{ image->desc };
+        const auto finalLayout{ ToVulkan(request->finalLayout) };
+
+        if (desc.generateMips && desc.mipLevels > 1) {
+            device_.GenerateMipMaps(cmd, image->vkImage, desc.arrayLayers, desc.mipLevels, desc.extent.width, desc.extent.height,
+                vk::ImageLayout::eTransferDstOptimal, finalLayout);
+        } else if (finalLayout != vk::ImageLayout::eTransferDstOptimal) {
+            device_.Transition(cmd, *image, vk::ImageLayout::eTransferDstOptimal, finalLayout);
+        }
+    }
+}
+
+void VulkanUploadQueue::SubmitFinish(Batch& batch) {
+    batch.finish.begin(vk::CommandBufferBeginInfo{ .flags = vk::CommandBufferUsageFlagBits::eOneTimeSubmit });
+    RecordOwnership(batch.finish, batch, false);
+    RecordFinish(batch.finish, batch);
+    batch.finish.end();
+
+    // Copy already finished, in order submission is enough for frames using the data.
+    device_.GetDevice().resetFences(batch.finishFence);
+    graphicsQueue_.submit(
+        vk::SubmitInfo{
+            .commandBufferCount = 1,
+            .pCommandBuffers = &batch.finish,
+        },
+        batch.finishFence);
+
+    batch.state = Batch::State::Finishing;
+}
+
+void VulkanUploadQueue::Complete(Batch* batch) {
+    tail_ = std::max(tail_, batch->ringEnd);
+    completed_ = std::max(completed_, batch->last);
+
+    const auto now{ Clock::now() };
+    for (auto request : batch->requests) {
+        UGINE_HISTOGRAM_RECORD("gfx.upload.latency", u64(std::chrono::duration_cast<std::chrono::microseconds>(now - request->submitted).count()));
+        ReleaseRequest(request);
+    }
+
+    for (auto& staging : batch->staging) {
+        device_.DestroyBuffer(std::move(staging));
+    }
+
+    batch->requests.Clear();
+    batch->staging.Clear();
+    batch->ringEnd = 0;
+    batch->bytes = 0;
+
+    freeBatches_.PushBack(batch);
+}
+
+template <typename Pred> void VulkanUploadQueue::CancelIf(Pred pred) {
+    for (size_t i{}; i < pending_.Size();) {
+        auto request{ pending_[i] };
+        if (!pred(request)) {
+            ++i;
+            continue;
+        }
+
+        // Ring space stays allocated until the batch around it is released, it only holds no data.
+        if (!request->inRing) {
+            --heapPending_;
+        }
+
+        pending_.EraseAt(i);
+        ReleaseRequest(request);
+    }
+
+    for (auto batch : inFlight_) {
+        for (auto& request : batch->requests) {
+            if (!pred(request)) {
+                continue;
+            }
+
+            const vk::Fence fences[]{ batch->state == Batch::State::Copying ? batch->copyFence : batch->finishFence };
+            auto result{ device_.GetDevice().waitForFences(fences, VK_TRUE, UINT64_MAX) };
+
+            // Finish of copied batch skips it.
+            request->buffer = {};
+            request->texture = {};
+        }
+    }
+}
+
+VulkanUploadQueue::Request* VulkanUploadQueue::AcquireRequest() {
+    if (!freeRequests_.Empty()) {
+        auto request{ freeRequests_.Back() };
+        freeRequests_.PopBack();
+        return request;
+    }
+
+    requests_.PushBack(MakeUnique<Request>(allocator_, allocator_));
+    return requests_.Back().Get();
+}
+
+void VulkanUploadQueue::ReleaseRequest(Request* request) {
+    request->buffer = {};
+    request->texture = {};
+    request->layers.Clear();
+    request->inRing = false;
+    request->src = vk::Buffer{};
+
+    Vector<u8> data{ allocator_ };
+    request->data.Swap(data);
+
+    freeRequests_.PushBack(request);
+}
+
+VulkanUploadQueue::Batch* VulkanUploadQueue::AcquireBatch() {
+    if (!freeBatches_.Empty()) {
+        auto batch{ freeBatches_.Back() };
+        freeBatches_.PopBack();
+        return batch;
+    }
+
+    auto vkDevice{ device_.GetDevice() };
+
+    batches_.PushBack(MakeUnique<Batch>(allocator_, allocator_));
+    auto batch{ batches_.Back().Get() };
+
+    batch->finish = vkDevice.allocateCommandBuffers(vk::CommandBufferAllocateInfo{
+        .commandPool = *graphicsPool_,
+        .level = vk::CommandBufferLevel::ePrimary,
+        .commandBufferCount = 1,
+    })[0];
+    batch->finishFence = vkDevice.createFence(vk::FenceCreateInfo{});
+
+    if (async_) {
+        batch->copy = vkDevice.allocateCommandBuffers(vk::CommandBufferAllocateInfo{
+            .commandPool = *transferPool_,
+            .level = vk::CommandBufferLevel::ePrimary,
+            .commandBufferCount = 1,
+        })[0];
+        batch->copyFence = vkDevice.createFence(vk::FenceCreateInfo{});
+    }
+
+    return batch;
+}
+
+} // namespace ugine::gfxapi
@@ -0,0 +1,139 @@
+#pragma once
+
+#include <gfxapi/Device.h>
+#include <gfxapi/vulkan/Vulkan.h>
+
+#include "VulkanResources.h"
+
+#include <ugine/Memory.h>
+#include <ugine/Vector.h>
+
+#include <chrono>
+
+namespace ugine::gfxapi {
+
+class VulkanDevice;
+
+// Streams buffer and texture data through persistently mapped staging ring. Copies are recorded in batches on transfer
+// queue (graphics queue if there is no dedicated one), graphics queue then acquires ownership, generates mips and moves
+// images to final layout. Batches are tracked by fences polled in Flush, tickets complete in submission order.
+class VulkanUploadQueue {
+public:
+    static constexpr u64 RING_SIZE{ 64 * 1024 * 1024 };
+
+    UGINE_NO_COPY(VulkanUploadQueue);
+
+    VulkanUploadQueue(VulkanDevice& device, IAllocator& allocator);
+    ~VulkanUploadQueue();
+
+    UploadTicket UploadBuffer(BufferHandle buffer, const void* data, size_t size, size_t offset);
+    UploadTicket UploadTexture(TextureHandle texture, TextureLayout finalLayout, ArrayProxy<SubresourceData> data);
+
+    bool IsComplete(UploadTicket ticket) const { return ticket <= completed_; }
+
+    // Retires finished batches and submits pending uploads up to budget bytes. Must run on thread submitting frames.
+    void Flush(u64 budget);
+
+    // Drops uploads to destroyed resource, waits if its batch is still running.
+    void Cancel(BufferHandle buffer);
+    void Cancel(TextureHandle texture);
+
+    UploadStats GetStats() const;
+
+private:
+    using Clock = std::chrono::high_resolution_clock;
+
+    struct Request {
+        explicit Request(IAllocator& allocator)
+            : layers{ allocator }
+            , data{ allocator } {}
+
+        UploadTicket ticket{};
+        BufferHandle buffer{};
+        TextureHandle texture{};
+        TextureLayout finalLayout{};
+        u64 dstOffset{};
+        u64 size{};
+        Vector<u64> layers; // Texture layer sizes, tightly packed.
+        Clock::time_point submitted{};
+
+        // Staging source. Ring position is virtual (never wraps), heap data waits for ring space.
+        bool inRing{};
+        u64 ringStart{};
+        Vector<u8> data;
+        vk::Buffer src{};
+        u64 srcOffset{};
+    };
+
+    struct Batch {
+        enum class State : u8 {
+            Copying,
+            Finishing,
+        };
+
+        explicit Batch(IAllocator& allocator)
+            : requests{ allocator }
+            , staging{ allocator } {}
+
+        State state{};
+        UploadTicket last{};
+        u64 ringEnd{};
+        u64 bytes{};
+        Vector<Request*> requests;
+        Vector<VulkanBuffer> staging; // Dedicated buffers for uploads larger than ring.
+
+        vk::CommandBuffer copy{}; // Transfer queue, only with async transfer.
+        vk::Fence copyFence{};
+        vk::CommandBuffer finish{}; // Graphics queue.
+        vk::Fence finishFence{};
+    };
+
+    UploadTicket Enqueue(Request* request, ArrayProxy<SubresourceData> data);
+    bool Allocate(u64 size, u64& start);
+    bool Stage(Request* request, Batch& batch);
+
+    void Retire();
+    void Submit(u64 budget);
+    void RecordCopies(vk::CommandBuffer cmd, Batch& batch);
+    void RecordOwnership(vk::CommandBuffer cmd, Batch& batch, bool release);
+    void RecordFinish(vk::CommandBuffer cmd, Batch& batch);
+    void SubmitFinish(Batch& batch);
+    void Complete(Batch* batch);
+
+    template <typename Pred> void CancelIf(Pred pred);
+
+    Request* AcquireRequest();
+    void ReleaseRequest(Request* request);
+    Batch* AcquireBatch();
+
+    VulkanDevice& device_;
+    AllocatorRef allocator_;
+
+    bool async_{};
+    u32 graphicsFamily_{};
+    u32 transferFamily_{};
+    vk::Queue graphicsQueue_{};
+    vk::Queue transferQueue_{};
+    vk::UniqueCommandPool graphicsPool_;
+    vk::UniqueCommandPool transferPool_;
+
+    VulkanBuffer ring_{};
+    u64 alignment_{};
+    u64 head_{};
+    u64 tail_{};
+
+    UploadTicket counter_{};
+    UploadTicket completed_{};
+    u32 heapPending_{};
+    u64 submittedBytes_{};
+
+    Vector<Request*> pending_;
+    Vector<Batch*> inFlight_;
+
+    Vector<UniquePtr<Request>> requests_;
+    Vector<Request*> freeRequests_;
+    Vector<UniquePtr<Batch>> batches_;
+    Vector<Batch*> freeBatches_;
+};
+
+} // namespace ugine::gfxapi